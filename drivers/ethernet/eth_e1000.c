@@ -47,6 +47,7 @@ static const char *e1000_reg_to_string(enum e1000_reg_t r)
 	_(ICR);
 	_(ICS);
 	_(IMS);
+	_(IMC);
 	_(RCTL);
 	_(TCTL);
 	_(RDBAL);
@@ -130,29 +131,43 @@ static int e1000_send(const struct device *ddev, struct net_pkt *pkt)
 	return e1000_tx(dev, dev->txb, len);
 }
 
-static struct net_pkt *e1000_rx(struct e1000_dev *dev)
+static struct net_pkt *e1000_rx_pkt(struct e1000_dev *dev,
+				     volatile struct e1000_rx *desc)
 {
 	struct net_pkt *pkt = NULL;
+#if defined(CONFIG_ETH_E1000_RX_ZERO_COPY)
+	void *new_buf;
+#endif
 	void *buf;
 	ssize_t len;
 
-	LOG_DBG("rx.sta: 0x%02hx", dev->rx.sta);
-
-	if (!(dev->rx.sta & RDESC_STA_DD)) {
-		LOG_ERR("RX descriptor not ready");
-		goto out;
-	}
+	LOG_DBG("rx.sta: 0x%02hx", desc->sta);
 
-	buf = INT_TO_POINTER((uint32_t)dev->rx.addr);
-	len = dev->rx.len - 4;
+	buf = INT_TO_POINTER((uint32_t)desc->addr);
+	len = desc->len - 4;
 
 	if (len <= 0) {
-		LOG_ERR("Invalid RX descriptor length: %hu", dev->rx.len);
+		LOG_ERR("Invalid RX descriptor length: %hu", desc->len);
 		goto out;
 	}
 
 	hexdump(buf, len, "%zd byte(s)", len);
 
+#if defined(CONFIG_ETH_E1000_RX_ZERO_COPY)
+	/* The buffer goes up the stack if the descriptor can get another one */
+	new_buf = net_eth_rx_pool_get(dev->rx_pool);
+	if (new_buf) {
+		pkt = net_eth_rx_pool_wrap(dev->rx_pool, dev->iface, buf, len,
+					   K_NO_WAIT);
+		if (pkt) {
+			desc->addr = POINTER_TO_INT(new_buf);
+			goto out;
+		}
+
+		net_eth_rx_pool_put(dev->rx_pool, new_buf);
+	}
+#endif
+
 	pkt = net_pkt_rx_alloc_with_buffer(dev->iface, len, AF_UNSPEC, 0,
 					   K_NO_WAIT);
 	if (!pkt) {
@@ -170,6 +185,60 @@ out:
 	return pkt;
 }
 
+/* Receive at most budget frames from the ring, giving each descriptor back
+ * to the device once its frame is copied or its buffer replaced.
+ */
+static int e1000_rx(struct e1000_dev *dev, int budget)
+{
+	int count = 0;
+
+	while (count < budget) {
+		volatile struct e1000_rx *desc = &dev->rx[dev->rx_next];
+		struct net_pkt *pkt;
+
+		if (!(desc->sta & RDESC_STA_DD)) {
+			break;
+		}
+
+		pkt = e1000_rx_pkt(dev, desc);
+		if (!pkt) {
+			eth_stats_update_errors_rx(get_iface(dev));
+		} else {
+#if defined(CONFIG_NET_L2_ETHERNET_NAPI)
+			(void)net_eth_napi_receive(&dev->napi, pkt);
+#else
+			if (net_recv_data(get_iface(dev), pkt) < 0) {
+				net_pkt_unref(pkt);
+			}
+#endif
+		}
+
+		desc->sta = 0;
+		iow32(dev, RDT, dev->rx_next);
+		dev->rx_next = (dev->rx_next + 1) % CONFIG_ETH_E1000_RX_DESC_COUNT;
+		count++;
+	}
+
+	return count;
+}
+
+#if defined(CONFIG_NET_L2_ETHERNET_NAPI)
+static int e1000_poll(struct net_eth_napi *napi, int budget)
+{
+	struct e1000_dev *dev = CONTAINER_OF(napi, struct e1000_dev, napi);
+	int count = e1000_rx(dev, budget);
+
+	if (count < budget) {
+		/* The ring is empty, a frame received meanwhile raises the
+		 * interrupt as soon as it is unmasked.
+		 */
+		iow32(dev, IMS, IMS_RXT0 | IMS_RXO);
+	}
+
+	return count;
+}
+#endif
+
 static void e1000_isr(const struct device *ddev)
 {
 	struct e1000_dev *dev = ddev->data;
@@ -177,16 +246,16 @@ static void e1000_isr(const struct device *ddev)
 
 	icr &= ~(ICR_TXDW | ICR_TXQE);
 
-	if (icr & ICR_RXO) {
-		struct net_pkt *pkt = e1000_rx(dev);
+	if (icr & (ICR_RXT0 | ICR_RXO)) {
+		icr &= ~(ICR_RXT0 | ICR_RXO);
 
-		icr &= ~ICR_RXO;
-
-		if (pkt) {
-			net_recv_data(get_iface(dev), pkt);
-		} else {
-			eth_stats_update_errors_rx(get_iface(dev));
-		}
+#if defined(CONFIG_NET_L2_ETHERNET_NAPI)
+		/* Poll the ring until it is empty */
+		iow32(dev, IMC, IMS_RXT0 | IMS_RXO);
+		net_eth_napi_schedule(&dev->napi);
+#else
+		(void)e1000_rx(dev, CONFIG_ETH_E1000_RX_DESC_COUNT);
+#endif
 	}
 
 	if (icr) {
@@ -224,19 +293,31 @@ int e1000_probe(const struct device *ddev)
 
 	iow32(dev, TCTL, TCTL_EN);
 
-	/* Setup RX descriptor */
+	/* Setup RX descriptor ring, the device owns all but the last one */
 
-	dev->rx.addr = POINTER_TO_INT(dev->rxb);
-	dev->rx.len = sizeof(dev->rxb);
+#if defined(CONFIG_ETH_E1000_RX_ZERO_COPY)
+	net_eth_rx_pool_init(dev->rx_pool);
+#endif
+
+	for (int i = 0; i < CONFIG_ETH_E1000_RX_DESC_COUNT; i++) {
+#if defined(CONFIG_ETH_E1000_RX_ZERO_COPY)
+		dev->rx[i].addr = POINTER_TO_INT(net_eth_rx_pool_get(dev->rx_pool));
+#else
+		dev->rx[i].addr = POINTER_TO_INT(dev->rxb[i]);
+#endif
+		dev->rx[i].sta = 0;
+	}
+
+	dev->rx_next = 0;
 
 	iow32(dev, RDBAL, (uint32_t)POINTER_TO_UINT(&dev->rx));
 	iow32(dev, RDBAH, (uint32_t)((POINTER_TO_UINT(&dev->rx) >> 16) >> 16));
-	iow32(dev, RDLEN, 1*16);
+	iow32(dev, RDLEN, sizeof(dev->rx));
 
 	iow32(dev, RDH, 0);
-	iow32(dev, RDT, 1);
+	iow32(dev, RDT, CONFIG_ETH_E1000_RX_DESC_COUNT - 1);
 
-	iow32(dev, IMS, IMS_RXO);
+	iow32(dev, IMS, IMS_RXT0 | IMS_RXO);
 
 	ral = ior32(dev, RAL);
 	rah = ior32(dev, RAH);
@@ -250,6 +331,23 @@ int e1000_probe(const struct device *ddev)
 BUILD_ASSERT(DT_INST_IRQN(0) != PCIE_IRQ_DETECT,
 	     "Dynamic IRQ allocation is not supported");
 
+BUILD_ASSERT((CONFIG_ETH_E1000_RX_DESC_COUNT % 8) == 0,
+	     "The RX ring length must be a multiple of 128 bytes");
+
+#if defined(CONFIG_ETH_E1000_RX_ZERO_COPY)
+BUILD_ASSERT(CONFIG_ETH_E1000_RX_BUF_COUNT > CONFIG_ETH_E1000_RX_DESC_COUNT,
+	     "The RX buffers must outnumber the RX descriptors");
+
+#define E1000_RX_POOL_DEFINE(inst)					\
+	NET_ETH_RX_POOL_DEFINE(rx_pool_##inst,				\
+			       CONFIG_ETH_E1000_RX_BUF_COUNT,		\
+			       E1000_RX_BUF_SIZE, 16);
+#define E1000_RX_POOL_INIT(inst) .rx_pool = &rx_pool_##inst,
+#else
+#define E1000_RX_POOL_DEFINE(inst)
+#define E1000_RX_POOL_INIT(inst)
+#endif
+
 static void e1000_iface_init(struct net_if *iface)
 {
 	struct e1000_dev *dev = net_if_get_device(iface)->data;
@@ -258,6 +356,10 @@ static void e1000_iface_init(struct net_if *iface)
 	if (dev->iface == NULL) {
 		dev->iface = iface;
 
+#if defined(CONFIG_NET_L2_ETHERNET_NAPI)
+		net_eth_napi_init(&dev->napi, iface, e1000_poll);
+#endif
+
 		/* Do the phy link up only once */
 		config->config_func(dev);
 	}
@@ -286,9 +388,11 @@ static const struct ethernet_api e1000_api = {
 
 #define E1000_PCI_INIT(inst)						\
 	DEVICE_PCIE_INST_DECLARE(inst);					\
+	E1000_RX_POOL_DEFINE(inst)					\
 									\
 	static struct e1000_dev dev_##inst = {				\
 		DEVICE_PCIE_INST_INIT(inst, pcie),			\
+		E1000_RX_POOL_INIT(inst)				\
 	};								\
 									\
 	static void e1000_config_##inst(const struct e1000_dev *dev)	\
@@ -170,6 +170,18 @@ static const struct flash_parameters flash_sim_parameters = {
 	},
 };
 
+#ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+static void flash_sim_wait(uint32_t usec)
+{
+	if (IS_ENABLED(CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING_SLEEP) &&
+	    !k_is_pre_kernel() && !k_is_in_isr()) {
+		k_usleep(usec);
+	} else {
+		k_busy_wait(usec);
+	}
+}
+#endif
+
 static int flash_range_is_valid(const struct device *dev, off_t offset,
 				size_t len)
 {
@@ -206,7 +218,7 @@ static int flash_sim_read(const struct device *dev, const off_t offset,
 	FLASH_SIM_STATS_INCN(flash_sim_stats, bytes_read, len);
 
 #ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
-	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US);
+	flash_sim_wait(CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US);
 	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_read_time_us,
 		   CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US);
 #endif
@@ -289,7 +301,7 @@ static int flash_sim_write(const struct device *dev, const off_t offset,
 
 #ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
 	/* wait before returning */
-	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US);
+	flash_sim_wait(CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US);
 	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_write_time_us,
 		   CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US);
 #endif
@@ -341,7 +353,7 @@ static int flash_sim_erase(const struct device *dev, const off_t offset,
 
 #ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
 	/* wait before returning */
-	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US);
+	flash_sim_wait(CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US);
 	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_erase_time_us,
 		   CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US);
 #endif
@@ -16,6 +16,7 @@ LOG_MODULE_REGISTER(i2c_rtio);
 
 const struct rtio_iodev_api i2c_iodev_api = {
 	.submit = i2c_iodev_submit,
+	.submit_batch = i2c_iodev_submit_batch,
 };
 
 struct rtio_sqe *i2c_rtio_copy(struct rtio *r, struct rtio_iodev *iodev, const struct i2c_msg *msgs,
@@ -149,3 +149,37 @@ void i2c_iodev_submit_fallback(const struct device *dev, struct rtio_iodev_sqe *
 
 	rtio_work_req_submit(req, iodev_sqe, i2c_iodev_submit_work_handler);
 }
+
+static void i2c_iodev_submit_batch_work_handler(struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct rtio_iodev_sqe *next;
+
+	do {
+		next = rtio_iodev_sqe_batch_next(iodev_sqe);
+		i2c_iodev_submit_work_handler(iodev_sqe);
+		iodev_sqe = next;
+	} while (iodev_sqe != NULL);
+}
+
+void i2c_iodev_submit_batch(struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct i2c_dt_spec *dt_spec = (const struct i2c_dt_spec *)iodev_sqe->sqe.iodev->data;
+	const struct i2c_driver_api *api = (const struct i2c_driver_api *)dt_spec->bus->api;
+	struct rtio_iodev_sqe *next;
+
+	/* The fallback runs the whole batch in a single work item */
+	if (api->iodev_submit == i2c_iodev_submit_fallback) {
+		struct rtio_work_req *req = rtio_work_req_alloc();
+
+		if (req != NULL) {
+			rtio_work_req_submit(req, iodev_sqe, i2c_iodev_submit_batch_work_handler);
+			return;
+		}
+	}
+
+	do {
+		next = rtio_iodev_sqe_batch_next(iodev_sqe);
+		i2c_iodev_submit(iodev_sqe);
+		iodev_sqe = next;
+	} while (iodev_sqe != NULL);
+}
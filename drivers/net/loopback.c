@@ -95,6 +95,101 @@ int loopback_get_num_dropped_packets(void)
 
 #endif
 
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DELAY
+struct loopback_delayed_pkt {
+	struct net_pkt *pkt;
+	int64_t due;
+};
+
+static uint32_t loopback_packet_delay_ms;
+static struct loopback_delayed_pkt
+	loopback_delayed[CONFIG_NET_LOOPBACK_DELAY_QUEUE_SIZE];
+static size_t loopback_delayed_head;
+static size_t loopback_delayed_count;
+static struct k_spinlock loopback_delay_lock;
+
+static void loopback_delayed_recv(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(loopback_delay_work, loopback_delayed_recv);
+
+int loopback_set_packet_delay(uint32_t delay_ms)
+{
+	loopback_packet_delay_ms = delay_ms;
+	return 0;
+}
+
+/* The delay is the same for all the packets, so they are due in the order
+ * they were sent.
+ */
+static void loopback_delayed_recv(struct k_work *work)
+{
+	struct loopback_delayed_pkt *delayed;
+	k_spinlock_key_t key;
+	struct net_pkt *pkt;
+	int64_t now;
+
+	ARG_UNUSED(work);
+
+	while (true) {
+		key = k_spin_lock(&loopback_delay_lock);
+
+		if (loopback_delayed_count == 0) {
+			k_spin_unlock(&loopback_delay_lock, key);
+			break;
+		}
+
+		delayed = &loopback_delayed[loopback_delayed_head];
+		now = k_uptime_get();
+		if (delayed->due > now) {
+			k_work_reschedule(&loopback_delay_work,
+					  K_MSEC(delayed->due - now));
+			k_spin_unlock(&loopback_delay_lock, key);
+			break;
+		}
+
+		pkt = delayed->pkt;
+		loopback_delayed_head = (loopback_delayed_head + 1) %
+					ARRAY_SIZE(loopback_delayed);
+		loopback_delayed_count--;
+
+		k_spin_unlock(&loopback_delay_lock, key);
+
+		if (net_recv_data(net_pkt_iface(pkt), pkt) < 0) {
+			LOG_ERR("Data receive failed.");
+			net_pkt_unref(pkt);
+		}
+	}
+}
+
+static int loopback_delay(struct net_pkt *pkt)
+{
+	struct loopback_delayed_pkt *delayed;
+	k_spinlock_key_t key;
+	int ret = 0;
+
+	key = k_spin_lock(&loopback_delay_lock);
+
+	if (loopback_delayed_count == ARRAY_SIZE(loopback_delayed)) {
+		ret = -ENOBUFS;
+		goto out;
+	}
+
+	delayed = &loopback_delayed[(loopback_delayed_head + loopback_delayed_count) %
+				    ARRAY_SIZE(loopback_delayed)];
+	delayed->pkt = pkt;
+	delayed->due = k_uptime_get() + loopback_packet_delay_ms;
+
+	if (loopback_delayed_count++ == 0) {
+		k_work_reschedule(&loopback_delay_work,
+				  K_MSEC(loopback_packet_delay_ms));
+	}
+
+out:
+	k_spin_unlock(&loopback_delay_lock, key);
+
+	return ret;
+}
+#endif
+
 static int loopback_send(const struct device *dev, struct net_pkt *pkt)
 {
 	struct net_pkt *cloned;
@@ -151,6 +246,19 @@ static int loopback_send(const struct device *dev, struct net_pkt *pkt)
 		}
 	}
 
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DELAY
+	if (loopback_packet_delay_ms > 0) {
+		if (loopback_delay(cloned) < 0) {
+			/* The queue is full, the packet is lost */
+			LOG_DBG("Delay queue full, dropping packet");
+			net_pkt_unref(cloned);
+		}
+
+		res = 0;
+		goto out;
+	}
+#endif
+
 	res = net_recv_data(net_pkt_iface(cloned), cloned);
 	if (res < 0) {
 		LOG_ERR("Data receive failed.");
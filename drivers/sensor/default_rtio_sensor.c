@@ -528,6 +528,70 @@ static int decode(const uint8_t *buffer, struct sensor_chan_spec chan_spec,
 	return count;
 }
 
+/* Number of readings sensor_decode_bulk() decodes per call when falling back to decode() */
+#define DECODE_BULK_CHUNK 16
+
+int sensor_decode_bulk(const struct sensor_decoder_api *decoder, const uint8_t *buffer,
+		       struct sensor_chan_spec channel, struct sensor_three_axis_bulk_data *out)
+{
+	uint8_t chunk_buf[sizeof(struct sensor_three_axis_data) +
+			  (DECODE_BULK_CHUNK - 1) * sizeof(struct sensor_three_axis_sample_data)]
+		__aligned(sizeof(uint64_t));
+	struct sensor_three_axis_data *chunk = (struct sensor_three_axis_data *)chunk_buf;
+	size_t base_size;
+	size_t frame_size;
+	uint32_t fit = 0;
+	uint16_t count = 0;
+	int rc;
+
+	__ASSERT_NO_MSG(out->x != NULL && out->y != NULL && out->z != NULL);
+
+	if (decoder->decode_bulk != NULL) {
+		rc = decoder->decode_bulk(buffer, channel, out);
+		if (rc != -ENOTSUP) {
+			return rc;
+		}
+	}
+
+	rc = decoder->get_size_info(channel, &base_size, &frame_size);
+	if (rc != 0 || base_size != sizeof(struct sensor_three_axis_data) ||
+	    frame_size != sizeof(struct sensor_three_axis_sample_data)) {
+		return -ENOTSUP;
+	}
+
+	while (count < out->capacity) {
+		rc = decoder->decode(buffer, channel, &fit,
+				     MIN(out->capacity - count, DECODE_BULK_CHUNK), chunk);
+		if (rc <= 0) {
+			break;
+		}
+
+		if (count == 0) {
+			out->header.base_timestamp_ns = chunk->header.base_timestamp_ns;
+			out->shift = chunk->shift;
+		}
+
+		for (int i = 0; i < rc; i++) {
+			out->x[count + i] = chunk->readings[i].x;
+			out->y[count + i] = chunk->readings[i].y;
+			out->z[count + i] = chunk->readings[i].z;
+			if (out->timestamp_delta != NULL) {
+				out->timestamp_delta[count + i] = chunk->readings[i].timestamp_delta;
+			}
+		}
+
+		count += rc;
+	}
+
+	if (rc < 0 && count == 0) {
+		return rc;
+	}
+
+	out->header.reading_count = count;
+
+	return count;
+}
+
 const struct sensor_decoder_api __sensor_default_decoder = {
 	.get_frame_count = get_frame_count,
 	.get_size_info = sensor_natively_supported_channel_size_info,
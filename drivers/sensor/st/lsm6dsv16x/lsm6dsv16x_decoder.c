@@ -9,6 +9,7 @@
 #include "lsm6dsv16x.h"
 #include "lsm6dsv16x_decoder.h"
 #include <zephyr/dt-bindings/sensor/lsm6dsv16x.h>
+#include <zephyr/sys/byteorder.h>
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(LSM6DSV16X_DECODER, CONFIG_SENSOR_LOG_LEVEL);
@@ -541,6 +542,92 @@ static int lsm6dsv16x_decode_fifo(const uint8_t *buffer, struct sensor_chan_spec
 
 	return count;
 }
+
+/*
+ * Convert raw readings to q31_t in place. This gives the same result as Q31_SHIFT_MICROVAL()
+ * on each reading, but the multiplier is computed once and the division is by a constant, so
+ * the loop has no branches and the compiler is free to unroll and vectorize it.
+ */
+static void lsm6dsv16x_scale_q31(q31_t *values, uint16_t count, int32_t scale, int8_t shift)
+{
+	const int64_t mult = (int64_t)scale * ((int64_t)1 << (31 - shift));
+
+	for (uint16_t i = 0; i < count; i++) {
+		values[i] = (q31_t)(values[i] * mult / 1000000LL);
+	}
+}
+
+static int lsm6dsv16x_decode_fifo_bulk(const uint8_t *buffer, struct sensor_chan_spec chan_spec,
+				       struct sensor_three_axis_bulk_data *data_out)
+{
+	const struct lsm6dsv16x_fifo_data *edata = (const struct lsm6dsv16x_fifo_data *)buffer;
+	const struct lsm6dsv16x_decoder_header *header = &edata->header;
+	const uint8_t *buffer_end;
+	uint16_t tot_chan_fifo_words = 0;
+	uint16_t count = 0;
+	uint32_t period_ns;
+	uint8_t chan_tag;
+	int32_t scale;
+
+	if (chan_spec.chan_idx != 0) {
+		return -ENOTSUP;
+	}
+
+	switch (chan_spec.chan_type) {
+	case SENSOR_CHAN_ACCEL_XYZ:
+		chan_tag = LSM6DSV16X_XL_NC_TAG;
+		scale = accel_scaler[header->accel_fs];
+		data_out->shift = accel_range[header->accel_fs];
+		period_ns = accel_period_ns[edata->accel_batch_odr];
+		break;
+	case SENSOR_CHAN_GYRO_XYZ:
+		chan_tag = LSM6DSV16X_GY_NC_TAG;
+		scale = gyro_scaler[header->gyro_fs];
+		data_out->shift = gyro_range[header->gyro_fs];
+		period_ns = gyro_period_ns[edata->gyro_batch_odr];
+		break;
+	default:
+		return -ENOTSUP;
+	}
+
+	buffer += sizeof(struct lsm6dsv16x_fifo_data);
+	buffer_end = buffer + LSM6DSV16X_FIFO_SIZE(edata->fifo_count);
+
+	/* Gather the raw readings of the channel, the other tags are interleaved with them */
+	for (; buffer < buffer_end; buffer += LSM6DSV16X_FIFO_ITEM_LEN) {
+		if ((buffer[0] >> 3) != chan_tag) {
+			continue;
+		}
+
+		if (count < data_out->capacity) {
+			data_out->x[count] = (int16_t)sys_get_le16(&buffer[1]);
+			data_out->y[count] = (int16_t)sys_get_le16(&buffer[3]);
+			data_out->z[count] = (int16_t)sys_get_le16(&buffer[5]);
+			count++;
+		}
+		tot_chan_fifo_words++;
+	}
+
+	for (uint8_t axis = 0; axis < 3; axis++) {
+		lsm6dsv16x_scale_q31(data_out->values[axis], count, scale, data_out->shift);
+	}
+
+	/* As in lsm6dsv16x_decode_fifo(), the header timestamp is the one of the last word */
+	data_out->header.base_timestamp_ns = edata->header.timestamp;
+	if (tot_chan_fifo_words > 0) {
+		data_out->header.base_timestamp_ns -= (tot_chan_fifo_words - 1) * period_ns;
+	}
+
+	if (data_out->timestamp_delta != NULL) {
+		for (uint16_t i = 0; i < count; i++) {
+			data_out->timestamp_delta[i] = i * period_ns;
+		}
+	}
+
+	data_out->header.reading_count = count;
+
+	return count;
+}
 #endif /* CONFIG_LSM6DSV16X_STREAM */
 
 static int lsm6dsv16x_decode_sample(const uint8_t *buffer, struct sensor_chan_spec chan_spec,
@@ -646,6 +733,22 @@ static int lsm6dsv16x_decoder_decode(const uint8_t *buffer, struct sensor_chan_s
 	return lsm6dsv16x_decode_sample(buffer, chan_spec, fit, max_count, data_out);
 }
 
+static int lsm6dsv16x_decoder_decode_bulk(const uint8_t *buffer,
+					  struct sensor_chan_spec chan_spec,
+					  struct sensor_three_axis_bulk_data *data_out)
+{
+#ifdef CONFIG_LSM6DSV16X_STREAM
+	const struct lsm6dsv16x_decoder_header *header =
+		(const struct lsm6dsv16x_decoder_header *)buffer;
+
+	if (header->is_fifo) {
+		return lsm6dsv16x_decode_fifo_bulk(buffer, chan_spec, data_out);
+	}
+#endif
+
+	return -ENOTSUP;
+}
+
 static int lsm6dsv16x_decoder_get_size_info(struct sensor_chan_spec chan_spec, size_t *base_size,
 					    size_t *frame_size)
 {
@@ -680,6 +783,7 @@ SENSOR_DECODER_API_DT_DEFINE() = {
 	.get_size_info = lsm6dsv16x_decoder_get_size_info,
 	.decode = lsm6dsv16x_decoder_decode,
 	.has_trigger = lsm6dsv16x_decoder_has_trigger,
+	.decode_bulk = lsm6dsv16x_decoder_decode_bulk,
 };
 
 int lsm6dsv16x_get_decoder(const struct device *dev, const struct sensor_decoder_api **decoder)
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT st_lsm6dsv16x
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/i2c_emul.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+#include "lsm6dsv16x.h"
+#include "lsm6dsv16x_emul.h"
+
+LOG_MODULE_DECLARE(LSM6DSV16X, CONFIG_SENSOR_LOG_LEVEL);
+
+#define NUM_REGS (UINT8_MAX >> 1)
+
+/* Software power-on reset bit of FUNC_CFG_ACCESS and software reset bit of CTRL3 */
+#define FUNC_CFG_ACCESS_SW_POR BIT(2)
+#define CTRL3_SW_RESET         BIT(0)
+
+struct lsm6dsv16x_emul_data {
+	uint8_t reg[NUM_REGS];
+};
+
+struct lsm6dsv16x_emul_cfg {
+};
+
+void lsm6dsv16x_emul_set_reg(const struct emul *target, uint8_t reg_addr, const uint8_t *val,
+			     size_t count)
+{
+	struct lsm6dsv16x_emul_data *data = target->data;
+
+	__ASSERT_NO_MSG(reg_addr + count < NUM_REGS);
+	memcpy(data->reg + reg_addr, val, count);
+}
+
+void lsm6dsv16x_emul_get_reg(const struct emul *target, uint8_t reg_addr, uint8_t *val,
+			     size_t count)
+{
+	struct lsm6dsv16x_emul_data *data = target->data;
+
+	__ASSERT_NO_MSG(reg_addr + count < NUM_REGS);
+	memcpy(val, data->reg + reg_addr, count);
+}
+
+static void lsm6dsv16x_emul_reset(const struct emul *target)
+{
+	struct lsm6dsv16x_emul_data *data = target->data;
+
+	memset(data->reg, 0, NUM_REGS);
+	data->reg[LSM6DSV16X_WHO_AM_I] = LSM6DSV16X_ID;
+}
+
+static void lsm6dsv16x_emul_handle_write(const struct emul *target, uint8_t regn,
+					 const uint8_t *buf, size_t len)
+{
+	struct lsm6dsv16x_emul_data *data = target->data;
+
+	for (size_t i = 0; i < len && regn + i < NUM_REGS; i++) {
+		switch (regn + i) {
+		case LSM6DSV16X_WHO_AM_I:
+			/* Read only */
+			break;
+		case LSM6DSV16X_FUNC_CFG_ACCESS:
+			if ((buf[i] & FUNC_CFG_ACCESS_SW_POR) != 0) {
+				lsm6dsv16x_emul_reset(target);
+				break;
+			}
+			data->reg[regn + i] = buf[i];
+			break;
+		case LSM6DSV16X_CTRL3:
+			/* The reset completes immediately */
+			data->reg[regn + i] = buf[i] & ~CTRL3_SW_RESET;
+			break;
+		default:
+			data->reg[regn + i] = buf[i];
+			break;
+		}
+	}
+}
+
+static int lsm6dsv16x_emul_transfer_i2c(const struct emul *target, struct i2c_msg *msgs,
+					int num_msgs, int addr)
+{
+	struct lsm6dsv16x_emul_data *data = target->data;
+	uint8_t regn;
+
+	i2c_dump_msgs_rw(target->dev, msgs, num_msgs, addr, false);
+
+	if (num_msgs < 1 || FIELD_GET(I2C_MSG_READ, msgs->flags) || msgs->len < 1) {
+		LOG_ERR("Expected a register address first");
+		return -EIO;
+	}
+
+	/* Registers auto-increment, the address bit requesting it is ignored */
+	regn = msgs->buf[0] & GENMASK(6, 0);
+	lsm6dsv16x_emul_handle_write(target, regn, &msgs->buf[1], msgs->len - 1);
+	regn += msgs->len - 1;
+
+	for (int i = 1; i < num_msgs; i++) {
+		msgs++;
+
+		if (FIELD_GET(I2C_MSG_READ, msgs->flags)) {
+			for (uint32_t n = 0; n < msgs->len; n++) {
+				msgs->buf[n] = (regn + n < NUM_REGS) ? data->reg[regn + n] : 0;
+			}
+		} else {
+			lsm6dsv16x_emul_handle_write(target, regn, msgs->buf, msgs->len);
+		}
+		regn += msgs->len;
+	}
+
+	return 0;
+}
+
+static int lsm6dsv16x_emul_init(const struct emul *target, const struct device *parent)
+{
+	ARG_UNUSED(parent);
+
+	lsm6dsv16x_emul_reset(target);
+
+	return 0;
+}
+
+static const struct i2c_emul_api lsm6dsv16x_emul_api_i2c = {
+	.transfer = lsm6dsv16x_emul_transfer_i2c,
+};
+
+#define LSM6DSV16X_EMUL(n)                                                                         \
+	static const struct lsm6dsv16x_emul_cfg lsm6dsv16x_emul_cfg_##n;                           \
+	static struct lsm6dsv16x_emul_data lsm6dsv16x_emul_data_##n;                               \
+	EMUL_DT_INST_DEFINE(n, lsm6dsv16x_emul_init, &lsm6dsv16x_emul_data_##n,                    \
+			    &lsm6dsv16x_emul_cfg_##n, &lsm6dsv16x_emul_api_i2c, NULL)
+
+#define LSM6DSV16X_EMUL_I2C(n) COND_CODE_1(DT_INST_ON_BUS(n, i2c), (LSM6DSV16X_EMUL(n)), ())
+
+DT_INST_FOREACH_STATUS_OKAY(LSM6DSV16X_EMUL_I2C)
@@ -14,8 +14,11 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(spi_rtio, CONFIG_SPI_LOG_LEVEL);
 
+static void spi_iodev_submit_batch(struct rtio_iodev_sqe *iodev_sqe);
+
 const struct rtio_iodev_api spi_iodev_api = {
 	.submit = spi_iodev_submit,
+	.submit_batch = spi_iodev_submit_batch,
 };
 
 static void spi_rtio_iodev_default_submit_sync(struct rtio_iodev_sqe *iodev_sqe)
@@ -151,6 +154,41 @@ void spi_rtio_iodev_default_submit(const struct device *dev,
 	rtio_work_req_submit(req, iodev_sqe, spi_rtio_iodev_default_submit_sync);
 }
 
+static void spi_rtio_iodev_default_submit_batch_sync(struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct rtio_iodev_sqe *next;
+
+	do {
+		next = rtio_iodev_sqe_batch_next(iodev_sqe);
+		spi_rtio_iodev_default_submit_sync(iodev_sqe);
+		iodev_sqe = next;
+	} while (iodev_sqe != NULL);
+}
+
+static void spi_iodev_submit_batch(struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct spi_dt_spec *dt_spec = (const struct spi_dt_spec *)iodev_sqe->sqe.iodev->data;
+	const struct spi_driver_api *api = (const struct spi_driver_api *)dt_spec->bus->api;
+	struct rtio_iodev_sqe *next;
+
+	/* The default handler runs the whole batch in a single work item */
+	if (api->iodev_submit == spi_rtio_iodev_default_submit) {
+		struct rtio_work_req *req = rtio_work_req_alloc();
+
+		if (req != NULL) {
+			rtio_work_req_submit(req, iodev_sqe,
+					     spi_rtio_iodev_default_submit_batch_sync);
+			return;
+		}
+	}
+
+	do {
+		next = rtio_iodev_sqe_batch_next(iodev_sqe);
+		spi_iodev_submit(iodev_sqe);
+		iodev_sqe = next;
+	} while (iodev_sqe != NULL);
+}
+
 /**
  * @brief Copy the tx_bufs and rx_bufs into a set of RTIO requests
  *
@@ -16,6 +16,9 @@
 #define ZEPHYR_INCLUDE_DFU_FLASH_IMG_H_
 
 #include <zephyr/storage/stream_flash.h>
+#if defined(CONFIG_IMG_INCREMENTAL_HASH)
+#include <mbedtls/sha256.h>
+#endif
 
 /**
  * @brief Abstraction layer to write firmware images to flash
@@ -29,10 +32,75 @@
 extern "C" {
 #endif
 
+/** Magic number of a compressed image header */
+#define FLASH_IMG_COMPRESSED_MAGIC      0x4d4f435aU
+
+/** Compressed with LZ4, as blocks of the LZ4 frame format */
+#define FLASH_IMG_COMPRESSED_LZ4        1
+/** Compressed with heatshrink */
+#define FLASH_IMG_COMPRESSED_HEATSHRINK 2
+
+/**
+ * @brief Header of a compressed image, all fields little endian
+ *
+ * The first @a stored bytes of the image follow the header uncompressed, then
+ * the rest of the image compressed.
+ *
+ * LZ4 compressed data is a sequence of blocks, as in the LZ4 frame format
+ * without block checksums: a 32-bit size, with the most significant bit set
+ * if the block is not compressed, and the block data. Blocks may refer to the
+ * data of the previous blocks. A size of zero ends the data.
+ *
+ * heatshrink compressed data is a single heatshrink stream, with the window
+ * and lookahead sizes given in the header.
+ *
+ * The data must not refer further back than 2^@a window_bits bytes.
+ */
+struct flash_img_compressed_header {
+	uint32_t magic;			/** FLASH_IMG_COMPRESSED_MAGIC */
+	uint8_t format;			/** FLASH_IMG_COMPRESSED_LZ4 or _HEATSHRINK */
+	uint8_t window_bits;		/** log2 of the farthest distance referred to */
+	uint8_t lookahead_bits;		/** heatshrink lookahead size, 0 for LZ4 */
+	uint8_t reserved;
+	uint32_t size;			/** Size of the decompressed image */
+	uint32_t stored;		/** Bytes of the image not compressed */
+	uint8_t sha256[32];		/** SHA-256 hash of the decompressed image */
+} __packed;
+
+#if defined(CONFIG_IMG_DECOMPRESS)
+/** State of decompressing an image, used by flash_img_decompress_write() */
+struct flash_img_decompress {
+	struct flash_img_compressed_header hdr;
+	uint32_t size;			/* Size of the decompressed image */
+	uint32_t out;			/* Bytes decompressed */
+	uint32_t flushed;		/* Bytes passed on to be written */
+	uint32_t run;			/* Literal or stored bytes left */
+	uint32_t block;			/* Bytes left in the LZ4 block */
+	uint32_t match;			/* Length of the match */
+	uint32_t dist;			/* Distance of the match */
+	uint32_t value;			/* Field being read */
+	uint8_t have;			/* Bytes or bits of the field read */
+	uint8_t need;			/* Bits of the heatshrink field */
+	uint8_t state;
+	uint8_t window[1U << CONFIG_IMG_DECOMPRESS_WINDOW_BITS];
+};
+#endif
+
 struct flash_img_context {
 	uint8_t buf[CONFIG_IMG_BLOCK_BUF_SIZE];
 	const struct flash_area *flash_area;
 	struct stream_flash_ctx stream;
+#if defined(CONFIG_IMG_WRITE_ASYNC)
+	uint8_t async_buf[CONFIG_IMG_BLOCK_BUF_SIZE];
+#endif
+#if defined(CONFIG_IMG_INCREMENTAL_HASH)
+	mbedtls_sha256_context hash;	/* Hash of the image written so far */
+	size_t hashed;			/* Number of bytes in hash */
+	uint8_t hash_digest[32];	/* Hash of the image once flushed */
+#endif
+#if defined(CONFIG_IMG_DECOMPRESS)
+	struct flash_img_decompress decompress;
+#endif
 };
 
 /**
@@ -94,6 +162,47 @@ size_t flash_img_bytes_written(struct flash_img_context *ctx);
 int flash_img_buffered_write(struct flash_img_context *ctx, const uint8_t *data,
 		    size_t len, bool flush);
 
+/**
+ * @brief Check whether data starts with a compressed image header that can
+ * be decompressed.
+ *
+ * The format and the window size must be supported by the configuration.
+ *
+ * The function is enabled via CONFIG_IMG_DECOMPRESS Kconfig option.
+ *
+ * @param data data to check
+ * @param len length of @p data
+ *
+ * @return the header at the start of @p data, NULL if there is none or if it
+ *         cannot be decompressed
+ */
+const struct flash_img_compressed_header *flash_img_compressed_header(const void *data,
+								      size_t len);
+
+/**
+ * @brief Process input buffers of a compressed image, and write the image
+ * decompressed as flash_img_buffered_write() does.
+ *
+ * The input starts with a struct flash_img_compressed_header and can be split
+ * in any way. Decompressing only uses the context, whatever the size of the
+ * image, so the hash computed with CONFIG_IMG_INCREMENTAL_HASH is the hash of
+ * the decompressed image.
+ *
+ * The function is enabled via CONFIG_IMG_DECOMPRESS Kconfig option.
+ *
+ * @param ctx context
+ * @param data compressed data to write
+ * @param len Number of bytes of @p data
+ * @param flush when true, this is the end of the compressed image; buffered
+ * data is written to flash
+ *
+ * @return  0 on success, -EILSEQ if the data is not a valid compressed image
+ *          or does not decompress to the size in its header, other negative
+ *          errno code on fail
+ */
+int flash_img_decompress_write(struct flash_img_context *ctx, const uint8_t *data,
+			       size_t len, bool flush);
+
 /**
  * @brief  Verify flash memory length bytes integrity from a flash area. The
  * start point is indicated by an offset value.
@@ -111,6 +220,71 @@ int flash_img_check(struct flash_img_context *ctx,
 		    const struct flash_img_check *fic,
 		    uint8_t area_id);
 
+/**
+ * @brief Verify the image written through a context with the hash computed
+ * while writing it.
+ *
+ * Unlike flash_img_check(), this does not read the image back from flash,
+ * except the data written since the last call to flash_img_buffered_write().
+ *
+ * The function is enabled via CONFIG_IMG_INCREMENTAL_HASH Kconfig option.
+ *
+ * @param[in] ctx context the image was written with.
+ * @param[in] fic flash img check data.
+ *
+ * @return  0 on success, -EINVAL on invalid parameters, -ERANGE if @p fic
+ *          covers another number of bytes than written, -EILSEQ if the hash
+ *          does not match, other negative errno code on fail
+ */
+int flash_img_hash_check(struct flash_img_context *ctx,
+			 const struct flash_img_check *fic);
+
+/**
+ * @brief Load the write progress and the image hash stored with key
+ *        @p settings_key.
+ *
+ * As stream_flash_progress_load(), which must not be used on the stream of
+ * @p ctx. The hash state is stored under "<settings_key>/hash"; if it is
+ * missing or does not match the progress, the written data is hashed again
+ * from flash by the next write or check.
+ *
+ * The function is enabled via CONFIG_IMG_INCREMENTAL_HASH and
+ * CONFIG_STREAM_FLASH_PROGRESS Kconfig options.
+ *
+ * @param ctx context
+ * @param settings_key key to use with the settings module for loading
+ *                     the write progress
+ *
+ * @return  0 on success, negative errno code on fail
+ */
+int flash_img_progress_load(struct flash_img_context *ctx,
+			    const char *settings_key);
+
+/**
+ * @brief Save the write progress and the image hash using key
+ *        @p settings_key.
+ *
+ * @param ctx context
+ * @param settings_key key to use with the settings module for storing
+ *                     the write progress
+ *
+ * @return  0 on success, negative errno code on fail
+ */
+int flash_img_progress_save(const struct flash_img_context *ctx,
+			    const char *settings_key);
+
+/**
+ * @brief Clear the write progress and the image hash stored with key
+ *        @p settings_key.
+ *
+ * @param ctx context
+ * @param settings_key key previously used for storing the write progress
+ *
+ * @return  0 on success, negative errno code on fail
+ */
+int flash_img_progress_clear(const struct flash_img_context *ctx,
+			     const char *settings_key);
+
 /**
  * @brief Get the flash area id for the image upload slot.
  *
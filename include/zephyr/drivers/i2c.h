@@ -1044,6 +1044,15 @@ static inline void i2c_iodev_submit(struct rtio_iodev_sqe *iodev_sqe)
 	api->iodev_submit(dt_spec->bus, iodev_sqe);
 }
 
+/**
+ * @brief Submit a batch of requests to an I2C device with RTIO
+ *
+ * With the default handler, the whole batch runs in a single work item.
+ *
+ * @param iodev_sqe First submission of the batch, see rtio_iodev_sqe_batch_next()
+ */
+void i2c_iodev_submit_batch(struct rtio_iodev_sqe *iodev_sqe);
+
 extern const struct rtio_iodev_api i2c_iodev_api;
 
 /**
@@ -536,6 +536,24 @@ struct sensor_decoder_api {
 	 * @return Whether the trigger is present in the buffer
 	 */
 	bool (*has_trigger)(const uint8_t *buffer, enum sensor_trigger_type trigger);
+
+	/**
+	 * @brief Decode every reading of a three axis channel at once (optional)
+	 *
+	 * Converts the frames of @p buffer into one @ref q31_t array per axis, with a single
+	 * shift for all of them. Decoders implement this for FIFO buffers, where converting
+	 * whole runs of frames in tight loops is much cheaper than one frame at a time.
+	 *
+	 * @param[in]     buffer The buffer provided on the @ref rtio context
+	 * @param[in]     channel The three axis channel to decode
+	 * @param[in,out] data_out The decoded data, see @ref sensor_three_axis_bulk_data
+	 * @return >=0 the number of decoded readings
+	 * @return -ENOTSUP if the buffer or channel is not supported, @ref sensor_decode_bulk
+	 *         then falls back to @ref sensor_decoder_api.decode
+	 * @return <0 on other errors
+	 */
+	int (*decode_bulk)(const uint8_t *buffer, struct sensor_chan_spec channel,
+			   struct sensor_three_axis_bulk_data *data_out);
 };
 
 /**
@@ -593,6 +611,24 @@ static inline int sensor_decode(struct sensor_decode_context *ctx, void *out, ui
 	return ctx->decoder->decode(ctx->buffer, ctx->channel, &ctx->fit, max_count, out);
 }
 
+/**
+ * @brief Decode every reading of a three axis channel into one array per axis
+ *
+ * Uses the decoder's @ref sensor_decoder_api.decode_bulk when it supports the buffer, and
+ * otherwise decodes the frames in chunks with @ref sensor_decoder_api.decode. At most
+ * @p out->capacity readings are decoded.
+ *
+ * @param[in]     decoder The decoder of the sensor that produced @p buffer
+ * @param[in]     buffer The buffer provided on the @ref rtio context
+ * @param[in]     channel The three axis channel to decode
+ * @param[in,out] out The decoded data, with the arrays and capacity set by the caller
+ * @return >=0 the number of decoded readings
+ * @return -ENOTSUP if the channel is not a three axis channel
+ * @return <0 on other errors from the decoder
+ */
+int sensor_decode_bulk(const struct sensor_decoder_api *decoder, const uint8_t *buffer,
+		       struct sensor_chan_spec channel, struct sensor_three_axis_bulk_data *out);
+
 int sensor_natively_supported_channel_size_info(struct sensor_chan_spec channel, size_t *base_size,
 						size_t *frame_size);
 
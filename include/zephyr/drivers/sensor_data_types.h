@@ -74,6 +74,31 @@ struct sensor_three_axis_data {
 		PRIq_arg((data_).readings[(readings_offset_)].y, 6, (data_).shift),                \
 		PRIq_arg((data_).readings[(readings_offset_)].z, 6, (data_).shift)
 
+/**
+ * Data for a sensor channel which reports on three axes, decoded in bulk. Unlike
+ * :c:struct:`sensor_three_axis_data`, the readings are laid out as one array per axis so that
+ * they can be handed to vector DSP functions as they are.
+ *
+ * The caller provides the arrays, each holding at least ``capacity`` elements. The
+ * ``timestamp_delta`` array is optional and may be NULL.
+ */
+struct sensor_three_axis_bulk_data {
+	struct sensor_data_header header;
+	int8_t shift;
+	/** The number of elements in each of the caller provided arrays */
+	uint16_t capacity;
+	/** Time of each reading relative to ``header.base_timestamp_ns``, or NULL */
+	uint32_t *timestamp_delta;
+	union {
+		q31_t *values[3];
+		struct {
+			q31_t *x;
+			q31_t *y;
+			q31_t *z;
+		};
+	};
+};
+
 /**
  * Data for a sensor channel which reports game rotation vector data. This is used by:
  * - :c:enum:`SENSOR_CHAN_GAME_ROTATION_VECTOR`
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief RTIO IO device for files
+ */
+
+#ifndef ZEPHYR_INCLUDE_FS_FS_RTIO_H_
+#define ZEPHYR_INCLUDE_FS_FS_RTIO_H_
+
+#include <zephyr/fs/fs.h>
+#include <zephyr/rtio/rtio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief File RTIO IO device
+ * @defgroup fs_rtio File RTIO IO device
+ * @ingroup file_system_api
+ * @{
+ */
+
+/**
+ * @brief Data of a file RTIO IO device
+ *
+ * Reads (@ref RTIO_OP_RX) run fs_read() and writes (@ref RTIO_OP_TX,
+ * @ref RTIO_OP_TINY_TX) run fs_write() on the file, from its current
+ * position, in the RTIO work queue. The result of a completion is the
+ * number of bytes read or written, or a negative error code.
+ *
+ * Submissions that are not chained may run concurrently when the work
+ * queue has several threads, chain them to keep their order. The parts
+ * of a transaction run back to back, and complete with the total number
+ * of bytes transferred.
+ */
+struct fs_rtio_data {
+	/** Opened file the IO device reads from and writes to */
+	struct fs_file_t *file;
+	/** Largest buffer taken from the RTIO context memory pool by a read */
+	uint32_t read_max;
+};
+
+/** @cond INTERNAL_HIDDEN */
+extern const struct rtio_iodev_api fs_rtio_iodev_api;
+/** @endcond */
+
+/**
+ * @brief Statically define a file RTIO IO device
+ *
+ * @param name Name of the IO device
+ * @param _file Pointer to the @ref fs_file_t to operate on
+ * @param _read_max Largest buffer taken from the RTIO context memory pool
+ *        by a read, see rtio_sqe_prep_read_with_pool()
+ */
+#define FS_RTIO_IODEV_DEFINE(name, _file, _read_max)				\
+	static struct fs_rtio_data _fs_rtio_data_##name = {			\
+		.file = (_file),						\
+		.read_max = (_read_max),					\
+	};									\
+	RTIO_IODEV_DEFINE(name, &fs_rtio_iodev_api, &_fs_rtio_data_##name)
+
+/**
+ * @brief Initialize a file RTIO IO device at runtime
+ *
+ * @param iodev IO device to initialize
+ * @param data Data of the IO device, must outlive it
+ * @param file Pointer to the @ref fs_file_t to operate on
+ * @param read_max Largest buffer taken from the RTIO context memory pool
+ *        by a read
+ */
+static inline void fs_rtio_iodev_init(struct rtio_iodev *iodev,
+				      struct fs_rtio_data *data,
+				      struct fs_file_t *file, uint32_t read_max)
+{
+	data->file = file;
+	data->read_max = read_max;
+	iodev->api = &fs_rtio_iodev_api;
+	iodev->data = data;
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_FS_FS_RTIO_H_ */
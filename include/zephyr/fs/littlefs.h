@@ -49,12 +49,94 @@ struct fs_littlefs {
 	 */
 	uint32_t *lookahead_buffer[CONFIG_FS_LITTLEFS_LOOKAHEAD_SIZE / sizeof(uint32_t)];
 
+#ifdef CONFIG_FS_LITTLEFS_FMP_CACHE
+	/* Read-ahead cache shared by all accesses to a flash partition.
+	 * Must be fmp_read_cache_size bytes, rounded down to a multiple of
+	 * cfg.read_size at mount.  NULL or 0 reads flash directly.
+	 */
+	uint8_t *fmp_read_cache;
+	size_t fmp_read_cache_size;
+
+	/* Buffer coalescing consecutive programs of a flash partition.
+	 * Must be fmp_prog_buffer_size bytes, rounded down to a multiple of
+	 * cfg.prog_size at mount.  NULL or 0 programs flash directly.
+	 */
+	uint8_t *fmp_prog_buffer;
+	size_t fmp_prog_buffer_size;
+#endif /* CONFIG_FS_LITTLEFS_FMP_CACHE */
+
 	/* These structures are filled automatically at mount. */
 	struct lfs lfs;
 	void *backend;
 	struct k_mutex mutex;
+#ifdef CONFIG_FS_LITTLEFS_FMP_CACHE
+	off_t fmp_read_cache_off;
+	size_t fmp_read_cache_len;
+	off_t fmp_read_next;
+	off_t fmp_prog_buffer_off;
+	size_t fmp_prog_buffer_len;
+#endif /* CONFIG_FS_LITTLEFS_FMP_CACHE */
 };
 
+/** @cond INTERNAL_HIDDEN */
+#ifdef CONFIG_FS_LITTLEFS_FMP_CACHE
+#define Z_FS_LITTLEFS_FMP_READ_CACHE_SIZE CONFIG_FS_LITTLEFS_FMP_READ_CACHE_SIZE
+#define Z_FS_LITTLEFS_FMP_PROG_BUFFER_SIZE CONFIG_FS_LITTLEFS_FMP_PROG_BUFFER_SIZE
+
+#define Z_FS_LITTLEFS_FMP_CACHE_DEFINE(name, alignment, read_cache_sz, prog_buffer_sz)  \
+	static uint8_t __aligned(alignment) name ## _fmp_read_cache[MAX(read_cache_sz, 1)];	  \
+	static uint8_t __aligned(alignment) name ## _fmp_prog_buffer[MAX(prog_buffer_sz, 1)];
+
+#define Z_FS_LITTLEFS_FMP_CACHE_INIT(name, read_cache_sz, prog_buffer_sz)		  \
+	.fmp_read_cache = (read_cache_sz) > 0 ? name ## _fmp_read_cache : NULL,		  \
+	.fmp_read_cache_size = (read_cache_sz),						  \
+	.fmp_prog_buffer = (prog_buffer_sz) > 0 ? name ## _fmp_prog_buffer : NULL,	  \
+	.fmp_prog_buffer_size = (prog_buffer_sz),
+#else
+#define Z_FS_LITTLEFS_FMP_READ_CACHE_SIZE 0
+#define Z_FS_LITTLEFS_FMP_PROG_BUFFER_SIZE 0
+#define Z_FS_LITTLEFS_FMP_CACHE_DEFINE(name, alignment, read_cache_sz, prog_buffer_sz)
+#define Z_FS_LITTLEFS_FMP_CACHE_INIT(name, read_cache_sz, prog_buffer_sz)
+#endif /* CONFIG_FS_LITTLEFS_FMP_CACHE */
+/** @endcond */
+
+/** @brief Define a littlefs configuration with customized size
+ * characteristics and flash caches.
+ *
+ * As @ref FS_LITTLEFS_DECLARE_CUSTOM_CONFIG, with the sizes of the
+ * read-ahead cache and of the program buffer used on flash partitions
+ * when @kconfig{CONFIG_FS_LITTLEFS_FMP_CACHE} is enabled.  A size of 0
+ * disables the corresponding cache for this file system.
+ *
+ * @param name the name for the structure.  The defined object has
+ * file scope.
+ * @param alignment needed alignment for read/prog buffer for specific device
+ * @param read_sz see @kconfig{CONFIG_FS_LITTLEFS_READ_SIZE}
+ * @param prog_sz see @kconfig{CONFIG_FS_LITTLEFS_PROG_SIZE}
+ * @param cache_sz see @kconfig{CONFIG_FS_LITTLEFS_CACHE_SIZE}
+ * @param lookahead_sz see @kconfig{CONFIG_FS_LITTLEFS_LOOKAHEAD_SIZE}
+ * @param read_cache_sz see @kconfig{CONFIG_FS_LITTLEFS_FMP_READ_CACHE_SIZE}
+ * @param prog_buffer_sz see @kconfig{CONFIG_FS_LITTLEFS_FMP_PROG_BUFFER_SIZE}
+ */
+#define FS_LITTLEFS_DECLARE_CACHED_CONFIG(name, alignment, read_sz, prog_sz, cache_sz,	  \
+					  lookahead_sz, read_cache_sz, prog_buffer_sz)	  \
+	static uint8_t __aligned(alignment) name ## _read_buffer[cache_sz];		  \
+	static uint8_t __aligned(alignment) name ## _prog_buffer[cache_sz];		  \
+	static uint32_t name ## _lookahead_buffer[(lookahead_sz) / sizeof(uint32_t)];	  \
+	Z_FS_LITTLEFS_FMP_CACHE_DEFINE(name, alignment, read_cache_sz, prog_buffer_sz)	  \
+	static struct fs_littlefs name = {						  \
+		.cfg = {								  \
+			.read_size = (read_sz),						  \
+			.prog_size = (prog_sz),						  \
+			.cache_size = (cache_sz),					  \
+			.lookahead_size = (lookahead_sz),				  \
+			.read_buffer = name ## _read_buffer,				  \
+			.prog_buffer = name ## _prog_buffer,				  \
+			.lookahead_buffer = name ## _lookahead_buffer,			  \
+		},									  \
+		Z_FS_LITTLEFS_FMP_CACHE_INIT(name, read_cache_sz, prog_buffer_sz)	  \
+	}
+
 /** @brief Define a littlefs configuration with customized size
  * characteristics.
  *
@@ -85,20 +167,10 @@ struct fs_littlefs {
  */
 #define FS_LITTLEFS_DECLARE_CUSTOM_CONFIG(name, alignment, read_sz, prog_sz, cache_sz,	  \
 					  lookahead_sz)					  \
-	static uint8_t __aligned(alignment) name ## _read_buffer[cache_sz];		  \
-	static uint8_t __aligned(alignment) name ## _prog_buffer[cache_sz];		  \
-	static uint32_t name ## _lookahead_buffer[(lookahead_sz) / sizeof(uint32_t)];	  \
-	static struct fs_littlefs name = {						  \
-		.cfg = {								  \
-			.read_size = (read_sz),						  \
-			.prog_size = (prog_sz),						  \
-			.cache_size = (cache_sz),					  \
-			.lookahead_size = (lookahead_sz),				  \
-			.read_buffer = name ## _read_buffer,				  \
-			.prog_buffer = name ## _prog_buffer,				  \
-			.lookahead_buffer = name ## _lookahead_buffer,			  \
-		},									  \
-	}
+	FS_LITTLEFS_DECLARE_CACHED_CONFIG(name, alignment, read_sz, prog_sz, cache_sz,	  \
+					  lookahead_sz,					  \
+					  Z_FS_LITTLEFS_FMP_READ_CACHE_SIZE,		  \
+					  Z_FS_LITTLEFS_FMP_PROG_BUFFER_SIZE)
 
 /** @brief Define a littlefs configuration with default characteristics.
  *
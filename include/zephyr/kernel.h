@@ -948,6 +948,42 @@ __syscall void k_thread_priority_set(k_tid_t thread, int prio);
 __syscall void k_thread_deadline_set(k_tid_t thread, int deadline);
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+/**
+ * @brief Set the runtime budget of a deadline thread
+ *
+ * This attaches a constant bandwidth server to the thread: it may run
+ * for @p budget cycles every @p period cycles.  Its deadline is set
+ * one period ahead whenever it wakes up with too little budget left
+ * to fit its bandwidth, and postponed by one period each time it uses
+ * up its budget, which is then replenished.  A thread overrunning its
+ * budget thus loses precedence to the other deadline threads of its
+ * priority instead of starving them.
+ *
+ * The budget is only granted if the sum of the budget / period ratios
+ * of all the threads stays within
+ * @kconfig{CONFIG_SCHED_DEADLINE_CBS_UTILIZATION} percent of the CPUs.
+ * A zero @p budget removes the server and releases its share.
+ *
+ * @note Budgets are enforced with tick granularity, and the deadline
+ * set here replaces any one set with k_thread_deadline_set().
+ *
+ * @note You should enable @kconfig{CONFIG_SCHED_DEADLINE_CBS} in your
+ * project configuration.
+ *
+ * @param thread A thread on which to set the budget
+ * @param budget Runtime per period, in cycle units
+ * @param period Server period, in cycle units
+ *
+ * @retval 0 On success
+ * @retval -EINVAL The budget is larger than the period or the period
+ *         is out of range
+ * @retval -ENOSPC The utilization bound would be exceeded
+ */
+__syscall int k_thread_deadline_budget_set(k_tid_t thread, uint32_t budget,
+					   uint32_t period);
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 /**
  * @brief Invoke the scheduler
  *
@@ -6437,6 +6473,39 @@ void k_sys_runtime_stats_enable(void);
  */
 void k_sys_runtime_stats_disable(void);
 
+#if defined(CONFIG_SCHED_LATENCY_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Get the scheduling latency statistics of a thread
+ *
+ * Requires CONFIG_SCHED_LATENCY_STATS.
+ *
+ * @param thread ID of thread.
+ * @param stats Pointer to struct to copy statistics into.
+ * @return -EINVAL if null pointers, otherwise 0
+ */
+int k_thread_sched_latency_get(k_tid_t thread,
+			       struct k_sched_latency_stats *stats);
+
+/**
+ * @brief Get the scheduler statistics
+ *
+ * This routine gets the run queue statistics and the scheduling latency
+ * statistics of every priority level. Requires CONFIG_SCHED_LATENCY_STATS.
+ *
+ * @param stats Pointer to struct to copy statistics into.
+ * @return -EINVAL if null pointer, otherwise 0
+ */
+int k_sched_stats_get(struct k_sched_stats *stats);
+
+/**
+ * @brief Reset the scheduler statistics
+ *
+ * This routine resets the statistics reported by k_sched_stats_get(). The
+ * statistics of individual threads are not affected.
+ */
+void k_sched_stats_reset(void);
+#endif /* CONFIG_SCHED_LATENCY_STATS */
+
 #ifdef __cplusplus
 }
 #endif
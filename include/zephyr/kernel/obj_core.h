@@ -51,6 +51,8 @@
 #define K_OBJ_TYPE_MUTEX_ID      K_OBJ_TYPE_ID_GEN("MUTX")
 /** Pipe object type */
 #define K_OBJ_TYPE_PIPE_ID       K_OBJ_TYPE_ID_GEN("PIPE")
+/** Scheduler object type */
+#define K_OBJ_TYPE_SCHED_ID      K_OBJ_TYPE_ID_GEN("SCHD")
 /** Semaphore object type */
 #define K_OBJ_TYPE_SEM_ID        K_OBJ_TYPE_ID_GEN("SEM4")
 /** Stack object type */
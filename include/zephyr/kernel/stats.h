@@ -30,4 +30,51 @@ struct k_cycle_stats {
 	bool      track_usage;  /**< true if gathering usage stats */
 };
 
+#if defined(CONFIG_SCHED_LATENCY_STATS) || defined(__DOXYGEN__)
+/** Number of priority levels tracked in struct k_sched_stats */
+#define K_SCHED_STATS_NUM_PRIO \
+	(CONFIG_NUM_COOP_PRIORITIES + CONFIG_NUM_PREEMPT_PRIORITIES + 1)
+
+/**
+ * Structure used to track the scheduling latency of a thread or of
+ * a priority level.
+ *
+ * The wakeup latency is the time from a thread being made ready to it
+ * being switched in. Bucket n of the histogram counts latencies from 2^n
+ * up to 2^(n+1) - 1 cycles (bucket 0 also counts zero), the last bucket
+ * also counts all longer latencies.
+ */
+struct k_sched_latency_stats {
+	uint64_t  total;        /**< sum of wakeup latencies in cycles */
+	uint64_t  ready;        /**< \# of cycles ready but not running */
+	uint32_t  count;        /**< \# of wakeup latencies measured */
+	uint32_t  max;          /**< longest wakeup latency in cycles */
+	uint32_t  preemptions;  /**< \# of switches out while still ready */
+	/** wakeup latency histogram */
+	uint32_t  hist[CONFIG_SCHED_LATENCY_STATS_BUCKETS];
+};
+
+/**
+ * Structure used to track the run queue and scheduler IPIs.
+ */
+struct k_sched_runq_stats {
+	uint64_t  depth_sum;    /**< sum of depth sampled at every switch */
+	uint64_t  ipi_cycles;   /**< \# of cycles spent signaling IPIs */
+	uint32_t  depth;        /**< \# of threads in the run queue */
+	uint32_t  max_depth;    /**< largest \# of threads in the run queue */
+	uint32_t  switches;     /**< \# of context switches */
+	uint32_t  ipis;         /**< \# of scheduler IPIs signaled */
+};
+
+/**
+ * Structure used to report the scheduler statistics.
+ */
+struct k_sched_stats {
+	/** Run queue statistics */
+	struct k_sched_runq_stats  runq;
+	/** Latency statistics, indexed by priority - K_HIGHEST_THREAD_PRIO */
+	struct k_sched_latency_stats  prio[K_SCHED_STATS_NUM_PRIO];
+};
+#endif /* CONFIG_SCHED_LATENCY_STATS */
+
 #endif /* ZEPHYR_INCLUDE_KERNEL_STATS_H_ */
@@ -105,6 +105,15 @@ struct _thread_base {
 	int prio_deadline;
 #endif /* CONFIG_SCHED_DEADLINE */
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	/* Constant bandwidth server, in k_cycle_get_32() units */
+	uint32_t cbs_budget;
+	uint32_t cbs_period;
+	uint32_t cbs_remaining;
+	/* CPU share reserved by admission control, in 1/65536 units */
+	uint32_t cbs_util;
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 #if defined(CONFIG_SCHED_SCALABLE) || defined(CONFIG_WAITQ_SCALABLE)
 	uint32_t order_key;
 #endif
@@ -116,6 +125,11 @@ struct _thread_base {
 	/* CPU index on which thread was last run */
 	uint8_t cpu;
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* CPU index of the run queue holding the thread */
+	uint8_t runq_cpu;
+#endif /* CONFIG_SCHED_CPU_RUNQ */
+
 	/* Recursive count of irq_lock() calls */
 	uint8_t global_lock_count;
 
@@ -147,6 +161,14 @@ struct _thread_base {
 #ifdef CONFIG_SCHED_THREAD_USAGE
 	struct k_cycle_stats  usage;   /* Track thread usage statistics */
 #endif /* CONFIG_SCHED_THREAD_USAGE */
+
+#ifdef CONFIG_SCHED_LATENCY_STATS
+	/* Cycle count when made ready, 0 when not waiting to run */
+	uint32_t ready_stamp;
+	/* Made ready by a wakeup rather than by a preemption */
+	bool ready_woken;
+	struct k_sched_latency_stats  latency;
+#endif /* CONFIG_SCHED_LATENCY_STATS */
 };
 
 typedef struct _thread_base _thread_base_t;
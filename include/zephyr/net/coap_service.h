@@ -46,6 +46,21 @@ struct coap_service_data {
 	int sock_fd;
 	struct coap_observer observers[CONFIG_COAP_SERVICE_OBSERVERS];
 	struct coap_pending pending[CONFIG_COAP_SERVICE_PENDING_MESSAGES];
+	/* Resource each observer is registered with */
+	struct coap_resource *observer_resource[CONFIG_COAP_SERVICE_OBSERVERS];
+	/* Hash chains of the observers by token and of the pending messages by
+	 * message ID. Entries are 1-based indexes, 0 ends a chain.
+	 */
+	uint16_t observer_index[CONFIG_COAP_SERVICE_OBSERVERS];
+	uint16_t observer_next[CONFIG_COAP_SERVICE_OBSERVERS];
+	uint16_t pending_index[CONFIG_COAP_SERVICE_PENDING_MESSAGES];
+	uint16_t pending_next[CONFIG_COAP_SERVICE_PENDING_MESSAGES];
+	/* Timer wheel of the pending messages, chained in the same way */
+	uint16_t retransmit_wheel[CONFIG_COAP_SERVER_RETRANSMIT_SLOTS];
+	uint16_t retransmit_next[CONFIG_COAP_SERVICE_PENDING_MESSAGES];
+	uint16_t retransmit_slot[CONFIG_COAP_SERVICE_PENDING_MESSAGES];
+	/* First tick of the wheel not entirely processed */
+	int64_t retransmit_tick;
 };
 
 struct coap_service {
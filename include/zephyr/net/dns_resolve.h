@@ -658,6 +658,42 @@ static inline int dns_cancel_addr_info(uint16_t dns_id)
 	return dns_resolve_cancel(dns_resolve_get_default(), dns_id);
 }
 
+/**
+ * @brief DNS resolver cache statistics
+ */
+struct dns_resolve_cache_stats {
+	/** Number of lookups answered with addresses from the cache */
+	uint32_t hits;
+	/** Number of lookups answered with a negative answer from the cache */
+	uint32_t negative_hits;
+	/** Number of lookups not found in the cache */
+	uint32_t misses;
+	/** Number of entries replaced before they expired */
+	uint32_t evictions;
+	/** Number of entries resolved again before they expired */
+	uint32_t prefetches;
+	/** Number of entries in use */
+	uint16_t entries;
+	/** Number of entries the cache can hold */
+	uint16_t size;
+};
+
+/**
+ * @brief Get the statistics of the DNS resolver cache.
+ *
+ * @param stats Filled with the statistics.
+ *
+ * @return 0 if ok, <0 if error.
+ */
+int dns_resolve_cache_stats_get(struct dns_resolve_cache_stats *stats);
+
+/**
+ * @brief Remove all the entries of the DNS resolver cache.
+ *
+ * @return 0 if ok, <0 if error.
+ */
+int dns_resolve_cache_flush(void);
+
 /**
  * @}
  */
@@ -214,6 +214,11 @@ enum ethernet_hw_caps {
 
 	/** 5 Gbits link supported */
 	ETHERNET_LINK_5000BASE_T	= BIT(22),
+
+	/** TCP segmentation offload, the device cuts the packets having a
+	 *  net_pkt_tso_size() into segments of that size.
+	 */
+	ETHERNET_HW_TX_TSO		= BIT(23),
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -1296,6 +1301,183 @@ void net_eth_carrier_on(struct net_if *iface);
  */
 void net_eth_carrier_off(struct net_if *iface);
 
+#if defined(CONFIG_NET_L2_ETHERNET_NAPI) || defined(__DOXYGEN__)
+
+struct net_eth_napi;
+
+/**
+ * @brief Poll function of a driver receiving frames in batches.
+ *
+ * Called from the Ethernet RX poll work queue. The driver passes at most
+ * @p budget frames to net_eth_napi_receive(). If it had fewer frames than
+ * that, its ring is empty and it enables its RX interrupt again before
+ * returning. Otherwise it is polled again later.
+ *
+ * @param napi Poll context of the driver
+ * @param budget Largest number of frames to receive
+ *
+ * @return Number of frames received.
+ */
+typedef int (*net_eth_napi_poll_t)(struct net_eth_napi *napi, int budget);
+
+/**
+ * @brief Poll context of a driver receiving frames in batches.
+ */
+struct net_eth_napi {
+	/** @cond INTERNAL_HIDDEN */
+	struct k_work work;
+	struct net_if *iface;
+	net_eth_napi_poll_t poll;
+	/** @endcond */
+};
+
+/**
+ * @brief Initialize the poll context of a driver.
+ *
+ * @param napi Poll context of the driver
+ * @param iface Network interface the frames are received on
+ * @param poll Function receiving the frames
+ */
+void net_eth_napi_init(struct net_eth_napi *napi, struct net_if *iface,
+		       net_eth_napi_poll_t poll);
+
+/**
+ * @brief Schedule a poll of the driver.
+ *
+ * Called from the RX interrupt handler of the driver, after it masked
+ * its RX interrupt.
+ *
+ * @param napi Poll context of the driver
+ */
+void net_eth_napi_schedule(struct net_eth_napi *napi);
+
+/**
+ * @brief Hand a received frame over to the network stack.
+ *
+ * Called from the poll function of the driver. The packet is released if
+ * it cannot be received.
+ *
+ * @param napi Poll context of the driver
+ * @param pkt Received frame
+ *
+ * @return 0 if ok, <0 if the packet was dropped.
+ */
+int net_eth_napi_receive(struct net_eth_napi *napi, struct net_pkt *pkt);
+
+#endif /* CONFIG_NET_L2_ETHERNET_NAPI */
+
+#if defined(CONFIG_NET_L2_ETHERNET_RX_POOL) || defined(__DOXYGEN__)
+
+/**
+ * @brief Pool of DMA buffers a driver receives frames into.
+ *
+ * The buffers are handed over to the network stack as the data of the
+ * received packets, and return to the pool when the packets are released.
+ * The driver gives a descriptor a new buffer from the pool each time the
+ * one it filled goes up the stack.
+ */
+struct net_eth_rx_pool {
+	/** @cond INTERNAL_HIDDEN */
+	struct net_buf_pool *bufs;
+	struct k_stack *free;
+	uint8_t *data;
+	size_t buf_size;
+	size_t count;
+	/** @endcond */
+};
+
+/** @cond INTERNAL_HIDDEN */
+void net_eth_rx_pool_release(struct net_eth_rx_pool *pool, struct net_buf *buf);
+/** @endcond */
+
+/**
+ * @brief Define a pool of DMA buffers a driver receives frames into.
+ *
+ * @param _name Name of the pool.
+ * @param _count Number of buffers, larger than the number of RX descriptors
+ *        so that frames can be held by the stack while the ring is full.
+ * @param _size Size of each buffer.
+ * @param _align Alignment of each buffer, as required by the DMA.
+ */
+#define NET_ETH_RX_POOL_DEFINE(_name, _count, _size, _align)		\
+	static uint8_t _name##_data[_count][ROUND_UP(_size, _align)]	\
+		__aligned(_align);					\
+	K_STACK_DEFINE(_name##_free, _count);				\
+	static struct net_eth_rx_pool _name;				\
+	static void _name##_destroy(struct net_buf *buf)		\
+	{								\
+		net_eth_rx_pool_release(&_name, buf);			\
+	}								\
+	NET_BUF_POOL_FIXED_DEFINE(_name##_bufs, _count, 0, 0,		\
+				  _name##_destroy);			\
+	static struct net_eth_rx_pool _name = {				\
+		.bufs = &_name##_bufs,					\
+		.free = &_name##_free,					\
+		.data = &_name##_data[0][0],				\
+		.buf_size = ROUND_UP(_size, _align),			\
+		.count = _count,					\
+	}
+
+/**
+ * @brief Put all the buffers of a pool in its free list.
+ *
+ * @param pool Pool of DMA buffers
+ */
+void net_eth_rx_pool_init(struct net_eth_rx_pool *pool);
+
+/**
+ * @brief Get a free buffer for an RX descriptor.
+ *
+ * Safe to call from an interrupt handler.
+ *
+ * @param pool Pool of DMA buffers
+ *
+ * @return Buffer of the pool, NULL if they are all in use.
+ */
+void *net_eth_rx_pool_get(struct net_eth_rx_pool *pool);
+
+/**
+ * @brief Give a buffer that is not used any more back to its pool.
+ *
+ * Safe to call from an interrupt handler.
+ *
+ * @param pool Pool of DMA buffers
+ * @param data Buffer got from net_eth_rx_pool_get()
+ */
+void net_eth_rx_pool_put(struct net_eth_rx_pool *pool, void *data);
+
+/**
+ * @brief Size of the buffers of a pool.
+ *
+ * @param pool Pool of DMA buffers
+ *
+ * @return Size of each buffer in bytes.
+ */
+static inline size_t net_eth_rx_pool_buf_size(struct net_eth_rx_pool *pool)
+{
+	return pool->buf_size;
+}
+
+/**
+ * @brief Make a packet of a frame received into a buffer of a pool.
+ *
+ * The buffer becomes the data of the packet, and goes back to the pool
+ * when the packet is released. On failure the driver still owns it.
+ *
+ * @param pool Pool the buffer comes from
+ * @param iface Network interface the frame was received on
+ * @param data Buffer holding the frame
+ * @param len Length of the frame
+ * @param timeout Time to wait for a packet
+ *
+ * @return Packet holding the frame, NULL if none is available.
+ */
+struct net_pkt *net_eth_rx_pool_wrap(struct net_eth_rx_pool *pool,
+				     struct net_if *iface, void *data,
+				     size_t len, k_timeout_t timeout);
+
+#endif /* CONFIG_NET_L2_ETHERNET_RX_POOL */
+
 /**
  * @brief Set promiscuous mode either ON or OFF.
  *
@@ -33,6 +33,20 @@ int loopback_set_packet_drop_ratio(float ratio);
 int loopback_get_num_dropped_packets(void);
 #endif
 
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DELAY
+/**
+ * @brief Set the delay of the packets
+ *
+ * Each packet is delivered this long after it was sent, so the round trip
+ * time is twice the delay.
+ *
+ * @param[in] delay_ms Delay in milliseconds, 0 to deliver packets at once
+ *
+ * @return 0 on success, otherwise a negative integer.
+ */
+int loopback_set_packet_delay(uint32_t delay_ms);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
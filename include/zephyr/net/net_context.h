@@ -74,6 +74,9 @@ enum net_context_state {
 /** Context is bound to a specific interface */
 #define NET_CONTEXT_BOUND_TO_IFACE BIT(11)
 
+/** Receiver verifies the UDP checksum while it copies the data */
+#define NET_CONTEXT_CHKSUM_ON_COPY BIT(12)
+
 struct net_context;
 
 /**
@@ -518,6 +521,40 @@ static inline void net_context_set_closing(struct net_context *context,
 	}
 }
 
+/**
+ * @brief Does the receiver of this context verify the UDP checksum.
+ *
+ * @param context Network context.
+ *
+ * @return True if the checksum is verified while the data is copied,
+ * False if the stack verifies it before delivering the packet.
+ */
+static inline bool net_context_is_chksum_on_copy(struct net_context *context)
+{
+	NET_ASSERT(context);
+
+	return context->flags & NET_CONTEXT_CHKSUM_ON_COPY;
+}
+
+/**
+ * @brief Set the receiver of this context to verify the UDP checksum.
+ *
+ * @param context Network context.
+ * @param on_copy True if the receiver verifies it while copying the data,
+ * False if not
+ */
+static inline void net_context_set_chksum_on_copy(struct net_context *context,
+						  bool on_copy)
+{
+	NET_ASSERT(context);
+
+	if (on_copy) {
+		context->flags |= NET_CONTEXT_CHKSUM_ON_COPY;
+	} else {
+		context->flags &= (uint16_t)~NET_CONTEXT_CHKSUM_ON_COPY;
+	}
+}
+
 /** @cond INTERNAL_HIDDEN */
 
 #define NET_CONTEXT_STATE_SHIFT 1
@@ -2873,6 +2873,17 @@ bool net_if_need_calc_rx_checksum(struct net_if *iface,
 bool net_if_need_calc_tx_checksum(struct net_if *iface,
 				  enum net_if_checksum_type chksum_type);
 
+/**
+ * @brief Check if the TCP packets having a net_pkt_tso_size() must be cut
+ * into segments before they are given to the device, or if the device
+ * segments them itself.
+ *
+ * @param iface Network interface
+ *
+ * @return True if the packets need to be segmented, false otherwise.
+ */
+bool net_if_need_tx_segmentation(struct net_if *iface);
+
 /**
  * @brief Get interface according to index
  *
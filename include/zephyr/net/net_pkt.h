@@ -227,6 +227,12 @@ struct net_pkt {
 #if defined(CONFIG_NET_IP_FRAGMENT)
 	uint8_t ip_reassembled : 1; /* Packet is a reassembled IP packet. */
 #endif
+#if defined(CONFIG_NET_CHKSUM_COPY)
+	uint8_t chksum_pending : 1; /* The UDP checksum of a received packet
+				     * is verified by the receiver, while
+				     * it copies the data.
+				     */
+#endif
 #if defined(CONFIG_NET_PKT_TIMESTAMP)
 	uint8_t tx_timestamping : 1; /** Timestamp transmitted packet */
 	uint8_t rx_timestamping : 1; /** Timestamp received packet */
@@ -294,6 +300,21 @@ struct net_pkt {
 #endif /* CONFIG_NET_IP_DSCP_ECN */
 #endif /* CONFIG_NET_IP */
 
+#if defined(CONFIG_NET_CHKSUM_COPY)
+	/* Checksum of the last chksum_partial_len bytes of the packet, summed
+	 * while they were copied.
+	 */
+	uint16_t chksum_partial;
+	uint16_t chksum_partial_len;
+#endif /* CONFIG_NET_CHKSUM_COPY */
+
+#if defined(CONFIG_NET_TCP_TSO)
+	/* Payload length of the segments a TCP packet is cut into when it is
+	 * sent, 0 if the packet is a single segment.
+	 */
+	uint16_t tso_size;
+#endif /* CONFIG_NET_TCP_TSO */
+
 #if defined(CONFIG_NET_VLAN)
 	/* VLAN TCI (Tag Control Information). This contains the Priority
 	 * Code Point (PCP), Drop Eligible Indicator (DEI) and VLAN
@@ -516,6 +537,84 @@ static inline void net_pkt_set_chksum_done(struct net_pkt *pkt,
 	pkt->chksum_done = is_chksum_done;
 }
 
+static inline bool net_pkt_is_chksum_pending(struct net_pkt *pkt)
+{
+#if defined(CONFIG_NET_CHKSUM_COPY)
+	return !!(pkt->chksum_pending);
+#else
+	ARG_UNUSED(pkt);
+
+	return false;
+#endif
+}
+
+static inline void net_pkt_set_chksum_pending(struct net_pkt *pkt,
+					      bool is_chksum_pending)
+{
+#if defined(CONFIG_NET_CHKSUM_COPY)
+	pkt->chksum_pending = is_chksum_pending;
+#else
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(is_chksum_pending);
+#endif
+}
+
+static inline uint16_t net_pkt_chksum_partial(struct net_pkt *pkt)
+{
+#if defined(CONFIG_NET_CHKSUM_COPY)
+	return pkt->chksum_partial;
+#else
+	ARG_UNUSED(pkt);
+
+	return 0;
+#endif
+}
+
+static inline uint16_t net_pkt_chksum_partial_len(struct net_pkt *pkt)
+{
+#if defined(CONFIG_NET_CHKSUM_COPY)
+	return pkt->chksum_partial_len;
+#else
+	ARG_UNUSED(pkt);
+
+	return 0;
+#endif
+}
+
+static inline void net_pkt_set_chksum_partial(struct net_pkt *pkt,
+					      uint16_t sum, uint16_t len)
+{
+#if defined(CONFIG_NET_CHKSUM_COPY)
+	pkt->chksum_partial = sum;
+	pkt->chksum_partial_len = len;
+#else
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(sum);
+	ARG_UNUSED(len);
+#endif
+}
+
+static inline uint16_t net_pkt_tso_size(struct net_pkt *pkt)
+{
+#if defined(CONFIG_NET_TCP_TSO)
+	return pkt->tso_size;
+#else
+	ARG_UNUSED(pkt);
+
+	return 0;
+#endif
+}
+
+static inline void net_pkt_set_tso_size(struct net_pkt *pkt, uint16_t size)
+{
+#if defined(CONFIG_NET_TCP_TSO)
+	pkt->tso_size = size;
+#else
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(size);
+#endif
+}
+
 static inline uint8_t net_pkt_ip_hdr_len(struct net_pkt *pkt)
 {
 #if defined(CONFIG_NET_IP)
@@ -2254,6 +2353,23 @@ int net_pkt_copy(struct net_pkt *pkt_dst,
 		 struct net_pkt *pkt_src,
 		 size_t length);
 
+/**
+ * @brief Copy data from a packet into another one, summing it.
+ *
+ * @details Same as net_pkt_copy(), the Internet checksum of the copied data
+ *          is added to the partial checksum of pkt_dst. The data is expected
+ *          to end pkt_dst, see net_pkt_write_chksum().
+ *
+ * @param pkt_dst Destination network packet.
+ * @param pkt_src Source network packet.
+ * @param length  Length of data to be copied.
+ *
+ * @return 0 on success, negative errno code otherwise.
+ */
+int net_pkt_copy_chksum(struct net_pkt *pkt_dst,
+			struct net_pkt *pkt_src,
+			size_t length);
+
 /**
  * @brief Clone pkt and its buffer. The cloned packet will be allocated on
  *        the same pool as the original one.
@@ -2302,6 +2418,23 @@ struct net_pkt *net_pkt_shallow_clone(struct net_pkt *pkt,
  */
 int net_pkt_read(struct net_pkt *pkt, void *data, size_t length);
 
+/**
+ * @brief Read some data from a net_pkt, summing it.
+ *
+ * @details Same as net_pkt_read(), the Internet checksum of the data is
+ *          added to the partial checksum of the packet. The reads are
+ *          expected to go on until the end of the packet, so that the
+ *          partial checksum covers its last bytes.
+ *
+ * @param pkt    The network packet from where to read some data
+ * @param data   The destination buffer where to copy the data, or NULL
+ *               to only sum it
+ * @param length The amount of data to copy
+ *
+ * @return 0 on success, negative errno code otherwise.
+ */
+int net_pkt_read_chksum(struct net_pkt *pkt, void *data, size_t length);
+
 /**
  * @brief Read a byte (uint8_t) from a net_pkt
  *
@@ -2376,6 +2509,22 @@ int net_pkt_read_be32(struct net_pkt *pkt, uint32_t *data);
  */
 int net_pkt_write(struct net_pkt *pkt, const void *data, size_t length);
 
+/**
+ * @brief Write data into a net_pkt, summing it.
+ *
+ * @details Same as net_pkt_write(), the Internet checksum of the data is
+ *          added to the partial checksum of the packet. The data must be
+ *          the last one written to the packet, for instance its payload,
+ *          the transport checksum then only needs to sum the headers.
+ *
+ * @param pkt    The network packet where to write
+ * @param data   Data to be written
+ * @param length Length of the data to be written
+ *
+ * @return 0 on success, negative errno code otherwise.
+ */
+int net_pkt_write_chksum(struct net_pkt *pkt, const void *data, size_t length);
+
 /**
  * @brief Write a byte (uint8_t) data to a net_pkt
  *
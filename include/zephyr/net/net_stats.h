@@ -172,6 +172,25 @@ struct net_stats_tcp {
 
 	/** Number of connection attempts for closed ports, triggering a RST. */
 	net_stats_t connrst;
+
+	/** Number of fast retransmits, after duplicate acknowledgments. */
+	net_stats_t fast_rexmit;
+
+	/** Number of retransmission timeouts. */
+	net_stats_t rto;
+
+	/**
+	 * Congestion window of the connection updating it last, in bytes.
+	 * This and the next two are not aggregated over the connections of
+	 * the interface, use TCP_INFO for the values of a given connection.
+	 */
+	net_stats_t cwnd;
+
+	/** Slow start threshold of the connection updating it last, in bytes. */
+	net_stats_t ssthresh;
+
+	/** Smoothed round trip time of the connection updating it last, in ms. */
+	net_stats_t rtt;
 };
 
 /**
@@ -1161,7 +1180,42 @@ NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_STATS_RESET_WIFI);
 		"packet_count",						\
 		NET_STATS_GET_COLLECTOR_NAME(dev_id, sfx),		\
 		NET_STATS_GET_VAR(dev_id, sfx, tcp_connrst),		\
-		&(iface)->stats.tcp.connrst)
+		&(iface)->stats.tcp.connrst);				\
+	NET_STATS_PROMETHEUS_COUNTER_DEFINE(				\
+		"TCP fast retransmits",					\
+		NET_STATS_GET_INSTANCE(dev_id, sfx, tcp_fast_rexmit),	\
+		"packet_count",						\
+		NET_STATS_GET_COLLECTOR_NAME(dev_id, sfx),		\
+		NET_STATS_GET_VAR(dev_id, sfx, tcp_fast_rexmit),	\
+		&(iface)->stats.tcp.fast_rexmit);			\
+	NET_STATS_PROMETHEUS_COUNTER_DEFINE(				\
+		"TCP retransmission timeouts",				\
+		NET_STATS_GET_INSTANCE(dev_id, sfx, tcp_rto),		\
+		"timeout_count",					\
+		NET_STATS_GET_COLLECTOR_NAME(dev_id, sfx),		\
+		NET_STATS_GET_VAR(dev_id, sfx, tcp_rto),		\
+		&(iface)->stats.tcp.rto);				\
+	NET_STATS_PROMETHEUS_GAUGE_DEFINE(				\
+		"TCP congestion window",				\
+		NET_STATS_GET_INSTANCE(dev_id, sfx, tcp_cwnd),		\
+		"byte_count",						\
+		NET_STATS_GET_COLLECTOR_NAME(dev_id, sfx),		\
+		NET_STATS_GET_VAR(dev_id, sfx, tcp_cwnd),		\
+		&(iface)->stats.tcp.cwnd);				\
+	NET_STATS_PROMETHEUS_GAUGE_DEFINE(				\
+		"TCP slow start threshold",				\
+		NET_STATS_GET_INSTANCE(dev_id, sfx, tcp_ssthresh),	\
+		"byte_count",						\
+		NET_STATS_GET_COLLECTOR_NAME(dev_id, sfx),		\
+		NET_STATS_GET_VAR(dev_id, sfx, tcp_ssthresh),		\
+		&(iface)->stats.tcp.ssthresh);				\
+	NET_STATS_PROMETHEUS_GAUGE_DEFINE(				\
+		"TCP round trip time in milliseconds",		\
+		NET_STATS_GET_INSTANCE(dev_id, sfx, tcp_rtt),		\
+		"time",							\
+		NET_STATS_GET_COLLECTOR_NAME(dev_id, sfx),		\
+		NET_STATS_GET_VAR(dev_id, sfx, tcp_rtt),		\
+		&(iface)->stats.tcp.rtt)
 #else
 #define NET_STATS_PROMETHEUS_TCP(iface, dev_id, sfx)
 #endif
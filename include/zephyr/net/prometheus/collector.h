@@ -116,6 +116,15 @@ int prometheus_collector_register_metric(struct prometheus_collector *collector,
 const void *prometheus_collector_get_metric(struct prometheus_collector *collector,
 					    const char *name);
 
+#if defined(CONFIG_PROMETHEUS_SCHED_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Collector exporting the kernel scheduler statistics
+ *
+ * Available with CONFIG_PROMETHEUS_SCHED_STATS, see k_sched_stats_get().
+ */
+extern struct prometheus_collector prometheus_sched_collector;
+#endif
+
 /** @cond INTERNAL_HIDDEN */
 
 enum prometheus_walk_state {
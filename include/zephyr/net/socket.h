@@ -922,6 +922,29 @@ struct ifreq {
 #define TCP_KEEPINTVL 3
 /** Number of keepalives before dropping connection */
 #define TCP_KEEPCNT 4
+/** Get the state of the connection, a struct tcp_info (read only) */
+#define TCP_INFO 11
+/** Congestion control algorithm of the connection, a string such as "cubic" */
+#define TCP_CONGESTION 13
+
+/** Longest TCP_CONGESTION name, with its terminating NUL */
+#define TCP_CA_NAME_MAX 16
+
+/** State of a TCP connection, returned by the TCP_INFO socket option */
+struct tcp_info {
+	uint8_t tcpi_state;         /**< TCP state, enum tcp_state */
+	uint8_t tcpi_retransmits;   /**< Retransmission timeouts in a row */
+	uint16_t tcpi_snd_mss;      /**< Largest segment sent */
+	uint32_t tcpi_rto;          /**< Retransmission timeout (us) */
+	uint32_t tcpi_rtt;          /**< Smoothed round trip time (us) */
+	uint32_t tcpi_rttvar;       /**< Round trip time variation (us) */
+	uint32_t tcpi_snd_cwnd;     /**< Congestion window (bytes) */
+	uint32_t tcpi_snd_ssthresh; /**< Slow start threshold (bytes) */
+	uint32_t tcpi_snd_wnd;      /**< Window advertised by the peer (bytes) */
+	uint32_t tcpi_rcv_wnd;      /**< Window advertised to the peer (bytes) */
+	uint32_t tcpi_unacked;      /**< Data sent and not acknowledged (bytes) */
+	uint32_t tcpi_notsent;      /**< Data queued and not sent yet (bytes) */
+};
 
 /** @} */
 
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief RTIO IO device for sockets
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_SOCKET_RTIO_H_
+#define ZEPHYR_INCLUDE_NET_SOCKET_RTIO_H_
+
+#include <zephyr/rtio/rtio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Socket RTIO IO device
+ * @defgroup socket_rtio Socket RTIO IO device
+ * @ingroup bsd_sockets
+ * @{
+ */
+
+/**
+ * @brief Data of a socket RTIO IO device
+ *
+ * Reads (@ref RTIO_OP_RX) run zsock_recv() and writes (@ref RTIO_OP_TX,
+ * @ref RTIO_OP_TINY_TX) run zsock_send() on the socket. The result of a
+ * completion is the number of bytes received or sent, or a negative
+ * error code. A read completing with 0 means the peer closed the
+ * connection.
+ *
+ * Reads are first tried without blocking when submitted. When no data is
+ * pending, they are polled for by the socket service thread, so that many
+ * connections can wait for data without a thread each. Writes run in the
+ * RTIO work queue and send all of their data, which requires the socket
+ * to be left in blocking mode.
+ *
+ * Multishot reads from the RTIO context memory pool, see
+ * rtio_sqe_prep_read_multishot(), keep receiving from a connection with
+ * a single submission. They end with the first completion reporting
+ * the connection closed or an error.
+ *
+ * A canceled read waiting for data completes with -ECANCELED the next
+ * time data arrives on a socket or a read starts waiting. The socket
+ * should be closed with socket_rtio_iodev_close(), which completes the
+ * reads still waiting on it with -ECANCELED. Reads left waiting on a
+ * socket closed with zsock_close() complete with -EBADF, unless its
+ * descriptor is reused first.
+ */
+struct socket_rtio_data {
+	/** Socket the IO device receives from and sends to */
+	int sock;
+	/** Largest buffer taken from the RTIO context memory pool by a read */
+	uint32_t recv_max;
+};
+
+/** @cond INTERNAL_HIDDEN */
+extern const struct rtio_iodev_api socket_rtio_iodev_api;
+/** @endcond */
+
+/**
+ * @brief Statically define a socket RTIO IO device
+ *
+ * The socket is attached later with socket_rtio_iodev_sock_set().
+ *
+ * @param name Name of the IO device
+ * @param _recv_max Largest buffer taken from the RTIO context memory pool
+ *        by a read, see rtio_sqe_prep_read_with_pool()
+ */
+#define SOCKET_RTIO_IODEV_DEFINE(name, _recv_max)				\
+	static struct socket_rtio_data _socket_rtio_data_##name = {		\
+		.sock = -1,							\
+		.recv_max = (_recv_max),					\
+	};									\
+	RTIO_IODEV_DEFINE(name, &socket_rtio_iodev_api, &_socket_rtio_data_##name)
+
+/**
+ * @brief Initialize a socket RTIO IO device at runtime
+ *
+ * @param iodev IO device to initialize
+ * @param data Data of the IO device, must outlive it
+ * @param sock Socket to operate on
+ * @param recv_max Largest buffer taken from the RTIO context memory pool
+ *        by a read
+ */
+static inline void socket_rtio_iodev_init(struct rtio_iodev *iodev,
+					  struct socket_rtio_data *data,
+					  int sock, uint32_t recv_max)
+{
+	data->sock = sock;
+	data->recv_max = recv_max;
+	iodev->api = &socket_rtio_iodev_api;
+	iodev->data = data;
+}
+
+/**
+ * @brief Attach a socket to a socket RTIO IO device
+ *
+ * @param iodev IO device, with no submission pending
+ * @param sock Socket to operate on
+ */
+static inline void socket_rtio_iodev_sock_set(const struct rtio_iodev *iodev,
+					      int sock)
+{
+	((struct socket_rtio_data *)iodev->data)->sock = sock;
+}
+
+/**
+ * @brief Close the socket of a socket RTIO IO device
+ *
+ * The reads waiting for data on the socket complete with -ECANCELED, and
+ * the socket is detached from the IO device and closed.
+ *
+ * @param iodev IO device
+ *
+ * @retval 0 on success
+ * @retval -EBADF if no socket is attached
+ * @retval <0 error code of zsock_close()
+ */
+int socket_rtio_iodev_close(const struct rtio_iodev *iodev);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_NET_SOCKET_RTIO_H_ */
@@ -409,6 +409,14 @@ struct rtio {
 	 * them from the completion queue
 	 */
 	struct k_sem *consume_sem;
+
+	/* A wait semaphore given once, when the number of completions
+	 * awaited by rtio_cqe_wait() are in the completion queue
+	 */
+	struct k_sem *wait_sem;
+
+	/* Number of completions awaited by rtio_cqe_wait(), 0 if none */
+	atomic_t wait_count;
 #endif
 
 	/* Total number of completions */
@@ -509,6 +517,19 @@ struct rtio_iodev_api {
 	 * @param iodev_sqe Submission queue entry
 	 */
 	void (*submit)(struct rtio_iodev_sqe *iodev_sqe);
+
+	/**
+	 * @brief Submit to the iodev a batch of entries to work on (optional)
+	 *
+	 * Called instead of submit with consecutive submissions to the same
+	 * iodev, so that they can be queued to the hardware or a work queue
+	 * at once. Each of them may be the head of a transaction or chain.
+	 * The batch is walked with rtio_iodev_sqe_batch_next(), which must be
+	 * called on a submission before it is queued elsewhere or completed.
+	 *
+	 * @param iodev_sqe First submission queue entry of the batch
+	 */
+	void (*submit_batch)(struct rtio_iodev_sqe *iodev_sqe);
 };
 
 /**
@@ -885,10 +906,14 @@ static inline void rtio_block_pool_free(struct rtio *r, void *buf, uint32_t buf_
 		   (static K_SEM_DEFINE(CONCAT(_submit_sem_, name), 0, K_SEM_MAX_LIMIT)))          \
 	IF_ENABLED(CONFIG_RTIO_CONSUME_SEM,                                                        \
 		   (static K_SEM_DEFINE(CONCAT(_consume_sem_, name), 0, K_SEM_MAX_LIMIT)))         \
+	IF_ENABLED(CONFIG_RTIO_CONSUME_SEM,                                                        \
+		   (static K_SEM_DEFINE(CONCAT(_wait_sem_, name), 0, 1)))                         \
 	STRUCT_SECTION_ITERABLE(rtio, name) = {                                                    \
 		IF_ENABLED(CONFIG_RTIO_SUBMIT_SEM, (.submit_sem = &CONCAT(_submit_sem_, name),))   \
 		IF_ENABLED(CONFIG_RTIO_SUBMIT_SEM, (.submit_count = 0,))                           \
 		IF_ENABLED(CONFIG_RTIO_CONSUME_SEM, (.consume_sem = &CONCAT(_consume_sem_, name),))\
+		IF_ENABLED(CONFIG_RTIO_CONSUME_SEM, (.wait_sem = &CONCAT(_wait_sem_, name),))      \
+		IF_ENABLED(CONFIG_RTIO_CONSUME_SEM, (.wait_count = ATOMIC_INIT(0),))               \
 		.cq_count = ATOMIC_INIT(0),                                                        \
 		.xcqcnt = ATOMIC_INIT(0),                                                          \
 		.sqe_pool = _sqe_pool,                                                             \
@@ -991,6 +1016,24 @@ static inline struct rtio_iodev_sqe *rtio_iodev_sqe_next(const struct rtio_iodev
 	return iodev_sqe->next;
 }
 
+/**
+ * @brief Get the next submission in a batch given to rtio_iodev_api::submit_batch
+ *
+ * Submissions in a batch are linked through their queue node, which is
+ * free to reuse once this returned.
+ *
+ * @param iodev_sqe Submission queue entry
+ *
+ * @retval NULL if current sqe is last in the batch
+ * @retval struct rtio_iodev_sqe * if available
+ */
+static inline struct rtio_iodev_sqe *rtio_iodev_sqe_batch_next(struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct mpsc_node *next = mpsc_ptr_get(iodev_sqe->q.next);
+
+	return next == NULL ? NULL : CONTAINER_OF(next, struct rtio_iodev_sqe, q);
+}
+
 /**
  * @brief Acquire a single submission queue event if available
  *
@@ -1112,6 +1155,58 @@ static inline struct rtio_cqe *rtio_cqe_consume_block(struct rtio *r)
 	return cqe;
 }
 
+#if defined(CONFIG_RTIO_CONSUME_SEM) || defined(__DOXYGEN__)
+/**
+ * @brief Wait for a number of completion queue events
+ *
+ * Unlike consuming them one at a time with rtio_cqe_consume_block(), the
+ * calling thread is woken up once, when all of them are available. They
+ * can then be consumed with rtio_cqe_consume() without waiting.
+ *
+ * Only one thread may wait on an RTIO context at a time.
+ *
+ * @param r RTIO context
+ * @param count Number of completion queue events to wait for, at most the
+ *        size of the completion queue
+ * @param timeout Maximum time to wait
+ *
+ * @retval 0 At least @p count completion queue events are available
+ * @retval -EAGAIN Waiting timed out
+ * @retval -EINVAL @p count exceeds the size of the completion queue
+ */
+static inline int rtio_cqe_wait(struct rtio *r, uint32_t count, k_timeout_t timeout)
+{
+	if (count > r->cqe_pool->pool_size) {
+		return -EINVAL;
+	}
+
+	if (k_sem_count_get(r->consume_sem) >= count) {
+		return 0;
+	}
+
+	k_sem_reset(r->wait_sem);
+	atomic_set(&r->wait_count, (atomic_val_t)count);
+
+	/* Completions produced before the count was set did not check it */
+	if ((k_sem_count_get(r->consume_sem) >= count) &&
+	    atomic_cas(&r->wait_count, (atomic_val_t)count, 0)) {
+		return 0;
+	}
+
+	if (k_sem_take(r->wait_sem, timeout) == 0) {
+		return 0;
+	}
+
+	/* The last completion may have raced with the timeout */
+	if (!atomic_cas(&r->wait_count, (atomic_val_t)count, 0)) {
+		(void)k_sem_take(r->wait_sem, K_NO_WAIT);
+		return 0;
+	}
+
+	return -EAGAIN;
+}
+#endif /* CONFIG_RTIO_CONSUME_SEM || __DOXYGEN__ */
+
 /**
  * @brief Release consumed completion queue event
  *
@@ -1279,6 +1374,16 @@ static inline void rtio_cqe_submit(struct rtio *r, int result, void *userdata, u
 #endif
 #ifdef CONFIG_RTIO_CONSUME_SEM
 	k_sem_give(r->consume_sem);
+
+	/* Wake up a consumer waiting for a number of completions only once
+	 * they are all there
+	 */
+	atomic_val_t wait_count = atomic_get(&r->wait_count);
+
+	if ((wait_count > 0) && (k_sem_count_get(r->consume_sem) >= wait_count) &&
+	    atomic_cas(&r->wait_count, wait_count, 0)) {
+		k_sem_give(r->wait_sem);
+	}
 #endif
 }
 
@@ -1380,6 +1485,7 @@ static inline void rtio_access_grant(struct rtio *r, struct k_thread *t)
 
 #ifdef CONFIG_RTIO_CONSUME_SEM
 	k_object_access_grant(r->consume_sem, t);
+	k_object_access_grant(r->wait_sem, t);
 #endif
 }
 
@@ -1497,6 +1603,13 @@ static inline int z_impl_rtio_cqe_copy_out(struct rtio *r,
 	struct rtio_cqe *cqe;
 	k_timepoint_t end = sys_timepoint_calc(timeout);
 
+#ifdef CONFIG_RTIO_CONSUME_SEM
+	/* Sleep until all the completions are there, rather than being woken
+	 * up for each of them
+	 */
+	(void)rtio_cqe_wait(r, MIN(cqe_count, r->cqe_pool->pool_size), timeout);
+#endif
+
 	do {
 		cqe = K_TIMEOUT_EQ(timeout, K_FOREVER) ? rtio_cqe_consume_block(r)
 						       : rtio_cqe_consume(r);
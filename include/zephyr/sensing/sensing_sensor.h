@@ -91,6 +91,15 @@ struct sensing_connection {
 	/** Next consume time of the connection. Unit is micro seconds. */
 	uint64_t next_consume_time;
 	struct sensing_callback_list *callback_list; /**< Callback list of the connection. */
+#if defined(CONFIG_SENSING_BATCHING) || defined(__DOXYGEN__)
+	/** Maximum time readings are held back before delivery. Unit is micro seconds. */
+	uint64_t latency;
+	void *batch;          /**< Readings not delivered yet, allocated on first use. */
+	uint64_t batch_last;  /**< Timestamp of the last reading in the batch. */
+	uint16_t batch_count; /**< Number of readings in the batch. */
+	/** Time the batch is delivered at the latest. Unit is micro seconds. */
+	uint64_t batch_deadline;
+#endif
 };
 
 /**
@@ -119,6 +128,14 @@ struct sensing_sensor {
 	struct rtio_sqe *stream_sqe;      /**< Sqe for streaming mode. */
 	atomic_t flag;                    /**< Sensor flag of the sensor instance. */
 	struct sensing_connection *conns; /**< Pointer to sensor connections. */
+#if defined(CONFIG_SENSING_BATCHING) || defined(__DOXYGEN__)
+	uint64_t latency;                 /**< Arbitrated latency in micro seconds. */
+	/** Timestamp of the last reading, shared by the rate matching of all clients. */
+	uint64_t last_timestamp;
+	int32_t last_value[3];            /**< Values of the last reading. */
+	int8_t last_shift;                /**< Shift of the last reading values. */
+	bool has_last;                    /**< Whether the last reading is valid. */
+#endif
 };
 
 /**
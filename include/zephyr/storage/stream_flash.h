@@ -24,6 +24,7 @@
  */
 
 #include <stdbool.h>
+#include <zephyr/kernel.h>
 #include <zephyr/drivers/flash.h>
 
 #ifdef __cplusplus
@@ -47,6 +48,24 @@ extern "C" {
  */
 typedef int (*stream_flash_callback_t)(uint8_t *buf, size_t len, size_t offset);
 
+struct stream_flash_ctx;
+
+/**
+ * @typedef stream_flash_async_callback_t
+ *
+ * @brief Signature for callback invoked when an asynchronous write completes.
+ *
+ * @details Functions of this type are invoked from the stream flash work queue
+ * each time a buffer handed over by stream_flash_buffered_write() has been
+ * written, or has failed to be written, to flash.
+ *
+ * @param ctx The context the buffer was written for.
+ * @param result 0 on success, negative errno code on fail.
+ * @param user_data User data given to stream_flash_async_init().
+ */
+typedef void (*stream_flash_async_callback_t)(struct stream_flash_ctx *ctx, int result,
+					      void *user_data);
+
 /**
  * @brief Structure for stream flash context
  *
@@ -71,6 +90,16 @@ struct stream_flash_ctx {
 #endif
 	size_t write_block_size;	/* Offset/size device write alignment */
 	uint8_t erase_value;
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	struct k_work async_work;	/* Writes async_buf from the work queue */
+	stream_flash_async_callback_t async_cb; /* Invoked after each write */
+	void *async_user_data;
+	uint8_t *async_buf;		/* Buffer being written, or spare */
+	size_t async_buf_bytes;		/* Number of bytes to write from async_buf */
+	size_t async_queued;		/* Number of bytes handed to the work queue */
+	int async_result;		/* First error of the work queue */
+	bool async_enabled;
+#endif
 };
 
 /**
@@ -127,6 +156,36 @@ size_t stream_flash_bytes_written(const struct stream_flash_ctx *ctx);
 int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *data,
 				size_t len, bool flush);
 
+/**
+ * @brief Switch a context to asynchronous, double buffered writes.
+ *
+ * Once enabled, stream_flash_buffered_write() hands each full buffer over to
+ * the stream flash work queue and continues with @p buf, swapping buffers
+ * again when that one is full. It only waits when the previous buffer is
+ * still being written. Errors of the work queue are returned by the next
+ * call. A call which flushes, or which fails, returns once no write is in
+ * progress anymore.
+ *
+ * The post write callback given to stream_flash_init() is then invoked from
+ * the work queue, and stream_flash_bytes_written() only counts the bytes which
+ * have been written.
+ *
+ * This function must be called after stream_flash_init(), and after
+ * stream_flash_progress_load() if progress is restored, before any write.
+ * A context which has writes in progress must not be initialized again; flush
+ * it first.
+ *
+ * @param ctx context
+ * @param buf Second write buffer, of the length given to stream_flash_init()
+ * @param cb Callback invoked after each write, can be NULL
+ * @param user_data User data passed to @p cb
+ *
+ * @return 0 on success, -EFAULT if @p ctx or @p buf is NULL, -EBUSY if the
+ *         context already holds buffered data.
+ */
+int stream_flash_async_init(struct stream_flash_ctx *ctx, uint8_t *buf,
+			    stream_flash_async_callback_t cb, void *user_data);
+
 /**
  * @brief Erase the flash page to which a given offset belongs.
  *
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_TRACING_TRACING_RAM_H_
+#define ZEPHYR_INCLUDE_TRACING_TRACING_RAM_H_
+
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief RAM tracing backend flight recorder APIs
+ * @defgroup subsys_tracing_ram_apis RAM tracing backend APIs
+ * @ingroup subsys_tracing
+ * @{
+ */
+
+/**
+ * @brief Flight recorder dump callback.
+ *
+ * Concatenating all chunks passed to the callback, in order, yields the
+ * recorded tracing stream (e.g. CTF). A packet that wraps around the end
+ * of the ring is passed in two chunks.
+ *
+ * @param data      Chunk of recorded tracing data.
+ * @param length    Chunk length.
+ * @param user_data User data passed to tracing_ram_dump().
+ */
+typedef void (*tracing_ram_dump_cb_t)(const uint8_t *data, uint32_t length,
+				      void *user_data);
+
+/**
+ * @brief Dump the content of the RAM flight recorder.
+ *
+ * Packets are passed to @p cb from the oldest to the newest. Tracing
+ * packets produced while the dump is in progress are discarded. This may
+ * be called from a fatal error handler to retrieve the events which
+ * preceded the fault.
+ *
+ * @param window_ms Only dump packets recorded in the last @p window_ms
+ *                  milliseconds, 0 to dump the whole ring.
+ * @param cb        Callback receiving the recorded data.
+ * @param user_data User data passed to @p cb.
+ *
+ * @return Number of dumped packets or -EBUSY if a dump is already running.
+ */
+int tracing_ram_dump(uint32_t window_ms, tracing_ram_dump_cb_t cb,
+		     void *user_data);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_TRACING_TRACING_RAM_H_ */
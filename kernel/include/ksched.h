@@ -338,6 +338,66 @@ void z_sched_cpu_usage(uint8_t core_id, struct k_thread_runtime_stats *stats);
 void z_sched_thread_usage(struct k_thread *thread,
 			  struct k_thread_runtime_stats *stats);
 
+#ifdef CONFIG_SCHED_LATENCY_STATS
+extern struct k_sched_stats z_sched_stats;
+
+/*
+ * Scheduling latency bookkeeping. Except for z_sched_stats_ipi(), these
+ * are called with _sched_spinlock held, which the context switch hooks of
+ * !USE_SWITCH platforms take themselves.
+ */
+void z_sched_stats_ready(struct k_thread *thread);
+
+void z_sched_stats_switched_out(struct k_thread *thread);
+
+void z_sched_stats_switched_in(struct k_thread *thread);
+
+void z_sched_stats_ipi(uint32_t cycles);
+
+static inline void z_sched_stats_runq_add(void)
+{
+	z_sched_stats.runq.depth++;
+	if (z_sched_stats.runq.depth > z_sched_stats.runq.max_depth) {
+		z_sched_stats.runq.max_depth = z_sched_stats.runq.depth;
+	}
+}
+
+static inline void z_sched_stats_runq_remove(void)
+{
+	z_sched_stats.runq.depth--;
+}
+#else
+#define z_sched_stats_ready(thread)
+#define z_sched_stats_runq_add()
+#define z_sched_stats_runq_remove()
+#endif /* CONFIG_SCHED_LATENCY_STATS */
+
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+/*
+ * Constant bandwidth server bookkeeping, see timeslicing.c. These are
+ * called with _sched_spinlock held.
+ */
+void z_sched_cbs_ready(struct k_thread *thread);
+
+void z_sched_cbs_release(struct k_thread *thread);
+
+void z_thread_deadline_update(struct k_thread *thread, int deadline);
+
+static inline bool thread_has_budget(struct k_thread *thread)
+{
+	return thread->base.cbs_period != 0U;
+}
+#else
+#define z_sched_cbs_ready(thread)
+#define z_sched_cbs_release(thread)
+
+static inline bool thread_has_budget(struct k_thread *thread)
+{
+	ARG_UNUSED(thread);
+	return false;
+}
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 static inline void z_sched_usage_switch(struct k_thread *thread)
 {
 	ARG_UNUSED(thread);
@@ -345,6 +405,12 @@ static inline void z_sched_usage_switch(struct k_thread *thread)
 	z_sched_usage_stop();
 	z_sched_usage_start(thread);
 #endif /* CONFIG_SCHED_THREAD_USAGE */
+#ifdef CONFIG_SCHED_LATENCY_STATS
+	if (thread != _current) {
+		z_sched_stats_switched_out(_current);
+		z_sched_stats_switched_in(thread);
+	}
+#endif /* CONFIG_SCHED_LATENCY_STATS */
 }
 
 #endif /* ZEPHYR_KERNEL_INCLUDE_KSCHED_H_ */
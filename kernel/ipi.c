@@ -81,10 +81,16 @@ void signal_pending_ipi(void)
 
 		cpu_bitmap = (uint32_t)atomic_clear(&_kernel.pending_ipi);
 		if (cpu_bitmap != 0) {
+#ifdef CONFIG_SCHED_LATENCY_STATS
+			uint32_t start = k_cycle_get_32();
+#endif
 #ifdef CONFIG_ARCH_HAS_DIRECTED_IPIS
 			arch_sched_directed_ipi(cpu_bitmap);
 #else
 			arch_sched_broadcast_ipi();
+#endif
+#ifdef CONFIG_SCHED_LATENCY_STATS
+			z_sched_stats_ipi(k_cycle_get_32() - start);
 #endif
 		}
 	}
@@ -101,7 +107,7 @@ void z_sched_ipi(void)
 #endif /* CONFIG_TRACE_SCHED_IPI */
 
 #ifdef CONFIG_TIMESLICING
-	if (thread_is_sliceable(_current)) {
+	if (thread_is_sliceable(_current) || thread_has_budget(_current)) {
 		z_time_slice();
 	}
 #endif /* CONFIG_TIMESLICING */
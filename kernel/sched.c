@@ -45,6 +45,18 @@ BUILD_ASSERT(CONFIG_NUM_COOP_PRIORITIES >= CONFIG_NUM_METAIRQ_PRIORITIES,
 	     "CONFIG_NUM_METAIRQ_PRIORITIES as Meta IRQs are just a special class of cooperative "
 	     "threads.");
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+/* Run queue of the threads no CPU is allowed to run, see runq_cpu_select() */
+#define RUNQ_CPU_PARKED CONFIG_MP_MAX_NUM_CPUS
+
+static struct _ready_q parked_ready_q;
+
+static ALWAYS_INLINE struct _ready_q *runq_cpu_ready_q(unsigned int cpu)
+{
+	return (cpu == RUNQ_CPU_PARKED) ? &parked_ready_q : &_kernel.cpus[cpu].ready_q;
+}
+#endif /* CONFIG_SCHED_CPU_RUNQ */
+
 static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 {
 #ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
@@ -59,6 +71,8 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 	cpu = m == 0 ? 0 : u32_count_trailing_zeros(m);
 
 	return &_kernel.cpus[cpu].ready_q.runq;
+#elif defined(CONFIG_SCHED_CPU_RUNQ)
+	return &runq_cpu_ready_q(thread->base.runq_cpu)->runq;
 #else
 	ARG_UNUSED(thread);
 	return &_kernel.ready_q.runq;
@@ -67,25 +81,168 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_CPU_RUNQ)
 	return &arch_curr_cpu()->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY || CONFIG_SCHED_CPU_RUNQ */
+}
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+static ALWAYS_INLINE bool runq_cpu_allowed(struct k_thread *thread,
+					   unsigned int cpu)
+{
+#ifdef CONFIG_SCHED_CPU_MASK
+	return (thread->base.cpu_mask & BIT(cpu)) != 0;
+#else
+	ARG_UNUSED(thread);
+	ARG_UNUSED(cpu);
+	return true;
+#endif /* CONFIG_SCHED_CPU_MASK */
+}
+
+/* True if @a thread would preempt @a cpu_thread right away */
+static ALWAYS_INLINE bool runq_cpu_preempts(struct k_thread *thread,
+					   struct k_thread *cpu_thread)
+{
+	return ((z_sched_prio_cmp(thread, cpu_thread) > 0) &&
+		thread_is_preemptible(cpu_thread)) ||
+	       thread_is_metairq(thread);
+}
+
+/* Push on wake: queue @a thread on the CPU it last ran on if it can
+ * run there right away, keeping its cache warm. Otherwise pick an idle
+ * allowed CPU, or the one running the lowest priority thread. A CPU
+ * which is not started yet only gets threads no other CPU can run.
+ *
+ * Every thread of a CPU's queue is thus allowed on that CPU. A thread
+ * with an empty mask goes to the parked queue, which no CPU looks at,
+ * instead of hiding the threads queued behind it.
+ */
+static unsigned int runq_cpu_select(struct k_thread *thread)
+{
+	unsigned int last = thread->base.cpu;
+	unsigned int num_cpus = arch_num_cpus();
+	struct k_thread *lowest = NULL;
+	unsigned int target = RUNQ_CPU_PARKED;
+
+	if (runq_cpu_allowed(thread, last) &&
+	    (_kernel.cpus[last].current != NULL) &&
+	    runq_cpu_preempts(thread, _kernel.cpus[last].current)) {
+		return last;
+	}
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		struct k_thread *cpu_thread = _kernel.cpus[i].current;
+
+		if (!runq_cpu_allowed(thread, i)) {
+			continue;
+		}
+
+		if (cpu_thread == NULL) {
+			if (target == RUNQ_CPU_PARKED) {
+				target = i;
+			}
+			continue;
+		}
+
+		if (z_is_idle_thread_object(cpu_thread)) {
+			return i;
+		}
+
+		if ((lowest == NULL) || (z_sched_prio_cmp(lowest, cpu_thread) > 0)) {
+			lowest = cpu_thread;
+			target = i;
+		}
+	}
+
+	return target;
+}
+
+/* The queues, like the runq_cpu field of the queued threads, are
+ * protected by _sched_spinlock.
+ */
+static ALWAYS_INLINE void runq_cpu_add(struct k_thread *thread, unsigned int cpu)
+{
+	thread->base.runq_cpu = cpu;
+	_priq_run_add(&runq_cpu_ready_q(cpu)->runq, thread);
+}
+
+static ALWAYS_INLINE void runq_cpu_remove(struct k_thread *thread)
+{
+	_priq_run_remove(&runq_cpu_ready_q(thread->base.runq_cpu)->runq, thread);
+}
+
+static ALWAYS_INLINE struct k_thread *runq_cpu_peek(unsigned int cpu)
+{
+	return _priq_run_best(&runq_cpu_ready_q(cpu)->runq);
+}
+
+/* Pull: a CPU runs the best of the head of its own queue and the heads
+ * of the other CPUs' queues which it is allowed to run, so that a lower
+ * priority local thread never runs while a better one waits elsewhere.
+ * A remote head is left to its own CPU if that CPU is about to run it.
+ * The thread stays queued until next_up() dequeues it, _sched_spinlock
+ * being held all along. When nothing is found, next_up() falls back to
+ * the idle thread.
+ */
+static struct k_thread *runq_cpu_best(void)
+{
+	unsigned int id = _current_cpu->id;
+	unsigned int num_cpus = arch_num_cpus();
+	struct k_thread *best = runq_cpu_peek(id);
+
+	__ASSERT((best == NULL) || runq_cpu_allowed(best, id),
+		 "thread queued on a masked CPU");
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		struct k_thread *cpu_thread = _kernel.cpus[i].current;
+		struct k_thread *thread;
+
+		if (i == id) {
+			continue;
+		}
+
+		thread = runq_cpu_peek(i);
+		if ((thread == NULL) || !runq_cpu_allowed(thread, id) ||
+		    ((best != NULL) && (z_sched_prio_cmp(thread, best) <= 0))) {
+			continue;
+		}
+
+		/* Leave it to its own CPU if that one is about to run it */
+		if ((cpu_thread != NULL) && runq_cpu_preempts(thread, cpu_thread)) {
+			continue;
+		}
+
+		best = thread;
+	}
+
+	return best;
 }
+#endif /* CONFIG_SCHED_CPU_RUNQ */
 
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
 {
 	__ASSERT_NO_MSG(!z_is_idle_thread_object(thread));
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	runq_cpu_add(thread, runq_cpu_select(thread));
+#else
 	_priq_run_add(thread_runq(thread), thread);
+#endif /* CONFIG_SCHED_CPU_RUNQ */
+	z_sched_stats_runq_add();
 }
 
 static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
 {
 	__ASSERT_NO_MSG(!z_is_idle_thread_object(thread));
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	runq_cpu_remove(thread);
+#else
 	_priq_run_remove(thread_runq(thread), thread);
+#endif /* CONFIG_SCHED_CPU_RUNQ */
+	z_sched_stats_runq_remove();
 }
 
 static ALWAYS_INLINE void runq_yield(void)
@@ -95,7 +252,24 @@ static ALWAYS_INLINE void runq_yield(void)
 
 static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	return runq_cpu_best();
+#else
 	return _priq_run_best(curr_cpu_runq());
+#endif /* CONFIG_SCHED_CPU_RUNQ */
+}
+
+/* Add a thread which was running on this CPU back to the run queue */
+static ALWAYS_INLINE void runq_add_local(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	__ASSERT_NO_MSG(!z_is_idle_thread_object(thread));
+
+	runq_cpu_add(thread, _current_cpu->id);
+	z_sched_stats_runq_add();
+#else
+	runq_add(thread);
+#endif /* CONFIG_SCHED_CPU_RUNQ */
 }
 
 /* _current is never in the run queue until context switch on
@@ -137,7 +311,7 @@ static ALWAYS_INLINE void dequeue_thread(struct k_thread *thread)
 void z_requeue_current(struct k_thread *thread)
 {
 	if (z_is_thread_queued(thread)) {
-		runq_add(thread);
+		runq_add_local(thread);
 	}
 	signal_pending_ipi();
 }
@@ -347,6 +521,8 @@ static void ready_thread(struct k_thread *thread)
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
 
+		z_sched_stats_ready(thread);
+		z_sched_cbs_ready(thread);
 		queue_thread(thread);
 		update_cache(0);
 
@@ -889,13 +1065,13 @@ void *z_get_next_switch_handle(void *interrupted)
 			 * will not return into it.
 			 */
 			if (z_is_thread_queued(old_thread)) {
+				runq_add_local(old_thread);
 #ifdef CONFIG_SCHED_IPI_CASCADE
 				if ((new_thread->base.cpu_mask != -1) &&
 				    (old_thread->base.cpu_mask != BIT(cpu_id))) {
 					flag_ipi(ipi_mask_create(old_thread));
 				}
 #endif
-				runq_add(old_thread);
 			}
 		}
 		old_thread->switch_handle = interrupted;
@@ -937,13 +1113,16 @@ void init_ready_q(struct _ready_q *ready_q)
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_CPU_RUNQ)
 	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
 		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	init_ready_q(&parked_ready_q);
+#endif /* CONFIG_SCHED_CPU_RUNQ */
 #else
 	init_ready_q(&_kernel.ready_q);
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY || CONFIG_SCHED_CPU_RUNQ */
 }
 
 void z_impl_k_thread_priority_set(k_tid_t thread, int prio)
@@ -979,6 +1158,34 @@ static inline void z_vrfy_k_thread_priority_set(k_tid_t thread, int prio)
 #endif /* CONFIG_USERSPACE */
 
 #ifdef CONFIG_SCHED_DEADLINE
+static void deadline_update(struct k_thread *thread, int deadline)
+{
+	/* The prio_deadline field changes the sorting order, so can't
+	 * change it while the thread is in the run queue (dlists
+	 * actually are benign as long as we requeue it before we
+	 * release the lock, but an rbtree will blow up if we break
+	 * sorting!)
+	 */
+	if (z_is_thread_queued(thread)) {
+		dequeue_thread(thread);
+		thread->base.prio_deadline = deadline;
+		queue_thread(thread);
+	} else {
+		thread->base.prio_deadline = deadline;
+	}
+}
+
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+/* Unlike k_thread_deadline_set(), this lets the scheduler pick again,
+ * as a server's deadline moves on budget exhaustion.
+ */
+void z_thread_deadline_update(struct k_thread *thread, int deadline)
+{
+	deadline_update(thread, deadline);
+	update_cache(thread == _current);
+}
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 void z_impl_k_thread_deadline_set(k_tid_t tid, int deadline)
 {
 
@@ -987,20 +1194,8 @@ void z_impl_k_thread_deadline_set(k_tid_t tid, int deadline)
 	struct k_thread *thread = tid;
 	int32_t newdl = k_cycle_get_32() + deadline;
 
-	/* The prio_deadline field changes the sorting order, so can't
-	 * change it while the thread is in the run queue (dlists
-	 * actually are benign as long as we requeue it before we
-	 * release the lock, but an rbtree will blow up if we break
-	 * sorting!)
-	 */
 	K_SPINLOCK(&_sched_spinlock) {
-		if (z_is_thread_queued(thread)) {
-			dequeue_thread(thread);
-			thread->base.prio_deadline = newdl;
-			queue_thread(thread);
-		} else {
-			thread->base.prio_deadline = newdl;
-		}
+		deadline_update(thread, newdl);
 	}
 }
 
@@ -1242,6 +1437,7 @@ static ALWAYS_INLINE void halt_thread(struct k_thread *thread, uint8_t new_state
 			}
 			z_abort_thread_timeout(thread);
 			unpend_all(&thread->join_queue);
+			z_sched_cbs_release(thread);
 
 			/* Edge case: aborting _current from within an
 			 * ISR that preempted it requires clearing the
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/sys/math_extras.h>
+#include <ksched.h>
+#include <string.h>
+
+struct k_sched_stats z_sched_stats;
+
+/* signal_pending_ipi() runs outside of the scheduler lock, so IPIs are
+ * accounted per CPU and summed up, without locking, when the statistics
+ * are read.
+ */
+static struct {
+	uint64_t  cycles;
+	uint32_t  count;
+} ipi_stats[CONFIG_MP_MAX_NUM_CPUS];
+
+static inline struct k_sched_latency_stats *prio_stats(struct k_thread *thread)
+{
+	return &z_sched_stats.prio[thread->base.prio - K_HIGHEST_THREAD_PRIO];
+}
+
+static inline uint32_t ready_stamp(void)
+{
+	/* Zero means "not waiting", being one cycle off does not matter */
+	return k_cycle_get_32() | 1U;
+}
+
+static void latency_record(struct k_sched_latency_stats *stats,
+			   uint32_t latency)
+{
+	uint32_t bucket = 0U;
+
+	if (latency != 0U) {
+		bucket = 31U - u32_count_leading_zeros(latency);
+	}
+
+	stats->hist[MIN(bucket, CONFIG_SCHED_LATENCY_STATS_BUCKETS - 1)]++;
+	stats->total += latency;
+	stats->count++;
+	if (latency > stats->max) {
+		stats->max = latency;
+	}
+}
+
+void z_sched_stats_ready(struct k_thread *thread)
+{
+	/* Every path making a thread runnable again ends up here, so any
+	 * stale stamp of a wakeup that never got to run is overwritten.
+	 */
+	thread->base.ready_stamp = ready_stamp();
+	thread->base.ready_woken = true;
+}
+
+void z_sched_stats_switched_out(struct k_thread *thread)
+{
+	z_sched_stats.runq.switches++;
+	z_sched_stats.runq.depth_sum += z_sched_stats.runq.depth;
+
+	if ((thread == NULL) || !z_is_thread_queued(thread)) {
+		return;
+	}
+
+	/* Still runnable: preempted or yielded. The time until it runs
+	 * again counts as ready time, but not as a wakeup latency.
+	 */
+	thread->base.latency.preemptions++;
+	prio_stats(thread)->preemptions++;
+	thread->base.ready_stamp = ready_stamp();
+	thread->base.ready_woken = false;
+}
+
+void z_sched_stats_switched_in(struct k_thread *thread)
+{
+	struct k_sched_latency_stats *prio;
+	uint32_t latency;
+
+	if (thread->base.ready_stamp == 0U) {
+		return;
+	}
+
+	latency = k_cycle_get_32() - thread->base.ready_stamp;
+	thread->base.ready_stamp = 0U;
+
+	prio = prio_stats(thread);
+	thread->base.latency.ready += latency;
+	prio->ready += latency;
+
+	if (thread->base.ready_woken) {
+		latency_record(&thread->base.latency, latency);
+		latency_record(prio, latency);
+	}
+}
+
+void z_sched_stats_ipi(uint32_t cycles)
+{
+	unsigned int key = arch_irq_lock();
+	unsigned int id = arch_curr_cpu()->id;
+
+	ipi_stats[id].count++;
+	ipi_stats[id].cycles += cycles;
+
+	arch_irq_unlock(key);
+}
+
+int k_thread_sched_latency_get(k_tid_t thread,
+			       struct k_sched_latency_stats *stats)
+{
+	if ((thread == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	K_SPINLOCK(&_sched_spinlock) {
+		*stats = thread->base.latency;
+	}
+
+	return 0;
+}
+
+int k_sched_stats_get(struct k_sched_stats *stats)
+{
+	if (stats == NULL) {
+		return -EINVAL;
+	}
+
+	K_SPINLOCK(&_sched_spinlock) {
+		*stats = z_sched_stats;
+	}
+
+	stats->runq.ipis = 0U;
+	stats->runq.ipi_cycles = 0U;
+	for (unsigned int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		stats->runq.ipis += ipi_stats[i].count;
+		stats->runq.ipi_cycles += ipi_stats[i].cycles;
+	}
+
+	return 0;
+}
+
+void k_sched_stats_reset(void)
+{
+	K_SPINLOCK(&_sched_spinlock) {
+		uint32_t depth = z_sched_stats.runq.depth;
+
+		(void)memset(&z_sched_stats, 0, sizeof(z_sched_stats));
+		z_sched_stats.runq.depth = depth;
+		z_sched_stats.runq.max_depth = depth;
+	}
+
+	(void)memset(ipi_stats, 0, sizeof(ipi_stats));
+}
+
+#ifdef CONFIG_OBJ_CORE_STATS_SCHED
+struct z_sched_obj {
+	struct k_obj_core  obj_core;
+};
+
+static struct k_obj_type  obj_type_sched;
+static struct z_sched_obj  sched_obj;
+
+static int sched_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	ARG_UNUSED(obj_core);
+
+	return k_sched_stats_get(stats);
+}
+
+static int sched_stats_reset(struct k_obj_core *obj_core)
+{
+	ARG_UNUSED(obj_core);
+
+	k_sched_stats_reset();
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc  sched_stats_desc = {
+	.raw_size = sizeof(struct k_sched_stats),
+	.query_size = sizeof(struct k_sched_stats),
+	.raw   = sched_stats_raw,
+	.query = sched_stats_raw,
+	.reset = sched_stats_reset,
+	.disable = NULL,
+	.enable  = NULL,
+};
+
+static int init_sched_obj_core_list(void)
+{
+	/* Initialize scheduler object type */
+
+	z_obj_type_init(&obj_type_sched, K_OBJ_TYPE_SCHED_ID,
+			offsetof(struct z_sched_obj, obj_core));
+	k_obj_type_stats_init(&obj_type_sched, &sched_stats_desc);
+
+	k_obj_core_init_and_link(K_OBJ_CORE(&sched_obj), &obj_type_sched);
+	k_obj_core_stats_register(K_OBJ_CORE(&sched_obj), &z_sched_stats,
+				  sizeof(z_sched_stats));
+
+	return 0;
+}
+
+SYS_INIT(init_sched_obj_core_list, PRE_KERNEL_1,
+	 CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+#endif /* CONFIG_OBJ_CORE_STATS_SCHED */
@@ -761,6 +761,18 @@ void z_init_thread_base(struct _thread_base *thread_base, int priority,
 	thread_base->slice_expired = NULL;
 #endif /* CONFIG_TIMESLICE_PER_THREAD */
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	thread_base->cbs_budget = 0U;
+	thread_base->cbs_period = 0U;
+	thread_base->cbs_remaining = 0U;
+	thread_base->cbs_util = 0U;
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
+#ifdef CONFIG_SCHED_LATENCY_STATS
+	thread_base->ready_stamp = 0U;
+	(void)memset(&thread_base->latency, 0, sizeof(thread_base->latency));
+#endif /* CONFIG_SCHED_LATENCY_STATS */
+
 	/* swap_data does not need to be initialized */
 
 	z_init_thread_timeout(thread_base);
@@ -920,6 +932,12 @@ void z_thread_mark_switched_in(void)
 	z_sched_usage_start(_current);
 #endif /* CONFIG_SCHED_THREAD_USAGE && !CONFIG_USE_SWITCH */
 
+#if defined(CONFIG_SCHED_LATENCY_STATS) && !defined(CONFIG_USE_SWITCH)
+	K_SPINLOCK(&_sched_spinlock) {
+		z_sched_stats_switched_in(_current);
+	}
+#endif /* CONFIG_SCHED_LATENCY_STATS && !CONFIG_USE_SWITCH */
+
 #ifdef CONFIG_TRACING
 	SYS_PORT_TRACING_FUNC(k_thread, switched_in);
 #endif /* CONFIG_TRACING */
@@ -931,6 +949,12 @@ void z_thread_mark_switched_out(void)
 	z_sched_usage_stop();
 #endif /*CONFIG_SCHED_THREAD_USAGE && !CONFIG_USE_SWITCH */
 
+#if defined(CONFIG_SCHED_LATENCY_STATS) && !defined(CONFIG_USE_SWITCH)
+	K_SPINLOCK(&_sched_spinlock) {
+		z_sched_stats_switched_out(_current);
+	}
+#endif /* CONFIG_SCHED_LATENCY_STATS && !CONFIG_USE_SWITCH */
+
 #ifdef CONFIG_TRACING
 #ifdef CONFIG_THREAD_LOCAL_STORAGE
 	/* Dummy thread won't have TLS set up to run arbitrary code */
@@ -7,6 +7,7 @@
 #include <kswap.h>
 #include <ksched.h>
 #include <ipi.h>
+#include <zephyr/internal/syscall_handler.h>
 
 static int slice_ticks = DIV_ROUND_UP(CONFIG_TIMESLICE_SIZE * Z_HZ_ticks, Z_HZ_ms);
 static int slice_max_prio = CONFIG_TIMESLICE_PRIORITY;
@@ -22,6 +23,21 @@ static bool slice_expired[CONFIG_MP_MAX_NUM_CPUS];
 struct k_thread *pending_current;
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+/* CPU shares are fixed point numbers, this is a full CPU */
+#define CBS_UTIL_ONE BIT(16)
+
+static struct _timeout cbs_timeouts[CONFIG_MP_MAX_NUM_CPUS];
+static bool cbs_expired[CONFIG_MP_MAX_NUM_CPUS];
+
+/* Budgeted thread last switched in on each CPU, and when */
+static struct k_thread *cbs_threads[CONFIG_MP_MAX_NUM_CPUS];
+static uint32_t cbs_stamps[CONFIG_MP_MAX_NUM_CPUS];
+
+/* Sum of the CPU shares of all the servers */
+static uint32_t cbs_utilization;
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 static inline int slice_time(struct k_thread *thread)
 {
 	int ret = slice_ticks;
@@ -65,6 +81,163 @@ static void slice_timeout(struct _timeout *timeout)
 	}
 }
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+static void cbs_timeout(struct _timeout *timeout)
+{
+	int cpu = ARRAY_INDEX(cbs_timeouts, timeout);
+
+	cbs_expired[cpu] = true;
+
+	if (cpu != _current_cpu->id) {
+		flag_ipi(IPI_CPU_MASK(cpu));
+	}
+}
+
+/* Charge the time elapsed since the last switch to the budget of the
+ * thread running on this CPU.
+ */
+static void cbs_charge(int cpu)
+{
+	struct k_thread *thread = cbs_threads[cpu];
+	uint32_t now = k_cycle_get_32();
+	uint32_t used = now - cbs_stamps[cpu];
+
+	cbs_stamps[cpu] = now;
+	if (thread != NULL) {
+		thread->base.cbs_remaining -= MIN(used, thread->base.cbs_remaining);
+	}
+}
+
+static void cbs_reset(int cpu, struct k_thread *thread)
+{
+	cbs_charge(cpu);
+
+	z_abort_timeout(&cbs_timeouts[cpu]);
+	cbs_expired[cpu] = false;
+	cbs_threads[cpu] = thread_has_budget(thread) ? thread : NULL;
+	if (cbs_threads[cpu] != NULL) {
+		z_add_timeout(&cbs_timeouts[cpu], cbs_timeout,
+			      K_TICKS(k_cyc_to_ticks_ceil32(thread->base.cbs_remaining)));
+	}
+}
+
+/* Budget used up: replenish it and postpone the server deadline by one
+ * period, which may let other deadline threads run first.
+ */
+static void cbs_budget_expired(int cpu, struct k_thread *curr)
+{
+	cbs_charge(cpu);
+
+	/* Timeouts have tick granularity, anything left below one tick
+	 * would expire right away.
+	 */
+	if ((curr == cbs_threads[cpu]) &&
+	    (curr->base.cbs_remaining < k_ticks_to_cyc_ceil32(1))) {
+		curr->base.cbs_remaining = curr->base.cbs_budget;
+		z_thread_deadline_update(curr, curr->base.prio_deadline +
+					 (int)curr->base.cbs_period);
+	}
+
+	/* Unless another thread was picked on the way, keep enforcing */
+	if (curr == cbs_threads[cpu]) {
+		cbs_reset(cpu, curr);
+	}
+}
+
+void z_sched_cbs_ready(struct k_thread *thread)
+{
+	uint32_t now;
+	int32_t left;
+
+	if (!thread_has_budget(thread)) {
+		return;
+	}
+
+	now = k_cycle_get_32();
+	left = thread->base.prio_deadline - (int32_t)now;
+
+	/* CBS wakeup rule: the current deadline is kept only if serving
+	 * the remaining budget before it stays within the server's
+	 * bandwidth, i.e. remaining / left < budget / period.
+	 */
+	if ((left <= 0) ||
+	    ((uint64_t)thread->base.cbs_remaining * thread->base.cbs_period >=
+	     (uint64_t)left * thread->base.cbs_budget)) {
+		thread->base.cbs_remaining = thread->base.cbs_budget;
+		thread->base.prio_deadline = now + thread->base.cbs_period;
+	}
+}
+
+void z_sched_cbs_release(struct k_thread *thread)
+{
+	cbs_utilization -= thread->base.cbs_util;
+	thread->base.cbs_util = 0U;
+	thread->base.cbs_budget = 0U;
+	thread->base.cbs_period = 0U;
+
+	for (unsigned int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		if (cbs_threads[i] == thread) {
+			cbs_threads[i] = NULL;
+		}
+	}
+}
+
+int z_impl_k_thread_deadline_budget_set(k_tid_t thread, uint32_t budget,
+					uint32_t period)
+{
+	uint32_t util = 0U;
+	int ret = 0;
+
+	if (budget != 0U) {
+		if ((period == 0U) || (budget > period) || (period > INT_MAX)) {
+			return -EINVAL;
+		}
+
+		util = (uint32_t)DIV_ROUND_UP((uint64_t)budget * CBS_UTIL_ONE,
+					      period);
+	}
+
+	K_SPINLOCK(&_sched_spinlock) {
+		uint32_t bound = (CBS_UTIL_ONE *
+				  CONFIG_SCHED_DEADLINE_CBS_UTILIZATION / 100U) *
+				 arch_num_cpus();
+		uint32_t total = cbs_utilization - thread->base.cbs_util + util;
+
+		if (total > bound) {
+			ret = -ENOSPC;
+			K_SPINLOCK_BREAK;
+		}
+
+		cbs_utilization = total;
+		thread->base.cbs_util = util;
+		thread->base.cbs_budget = budget;
+		thread->base.cbs_period = (budget != 0U) ? period : 0U;
+		thread->base.cbs_remaining = budget;
+
+		if (budget != 0U) {
+			z_thread_deadline_update(thread, k_cycle_get_32() + period);
+		}
+
+		if (thread == _current) {
+			cbs_reset(_current_cpu->id, thread);
+		}
+	}
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_thread_deadline_budget_set(k_tid_t thread, uint32_t budget,
+						      uint32_t period)
+{
+	K_OOPS(K_SYSCALL_OBJ(thread, K_OBJ_THREAD));
+
+	return z_impl_k_thread_deadline_budget_set(thread, budget, period);
+}
+#include <zephyr/syscalls/k_thread_deadline_budget_set_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 void z_reset_time_slice(struct k_thread *thread)
 {
 	int cpu = _current_cpu->id;
@@ -75,6 +248,10 @@ void z_reset_time_slice(struct k_thread *thread)
 		z_add_timeout(&slice_timeouts[cpu], slice_timeout,
 			      K_TICKS(slice_time(thread) - 1));
 	}
+
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	cbs_reset(cpu, thread);
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
 }
 
 void k_sched_time_slice_set(int32_t slice, int prio)
@@ -114,6 +291,12 @@ void z_time_slice(void)
 	pending_current = NULL;
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	if (cbs_expired[_current_cpu->id]) {
+		cbs_budget_expired(_current_cpu->id, curr);
+	}
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 	if (slice_expired[_current_cpu->id] && thread_is_sliceable(curr)) {
 #ifdef CONFIG_TIMESLICE_PER_THREAD
 		if (curr->base.slice_expired) {
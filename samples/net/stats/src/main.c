@@ -117,6 +117,13 @@ static void print_stats(struct net_if *iface, struct net_stats *data)
 	printk("TCP conn drop  %d\tconnrst\t%d\n",
 	       GET_STAT(iface, tcp.conndrop),
 	       GET_STAT(iface, tcp.connrst));
+	printk("TCP fast rexmt %d\trto\t%d\n",
+	       GET_STAT(iface, tcp.fast_rexmit),
+	       GET_STAT(iface, tcp.rto));
+	printk("TCP last cwnd  %u\tssthresh %u\trtt\t%u ms\n",
+	       GET_STAT(iface, tcp.cwnd),
+	       GET_STAT(iface, tcp.ssthresh),
+	       GET_STAT(iface, tcp.rtt));
 #endif
 
 	printk("Bytes received %u\n", GET_STAT(iface, bytes.received));
@@ -68,7 +68,11 @@ def main():
 
         dt = datetime.datetime.fromtimestamp(ns_from_origin / 1e9)
 
-        if event.name in [
+        # Compact scheduling events (CONFIG_TRACING_CTF_COMPACT) only differ
+        # by carrying no thread name.
+        event_name = event.name.removesuffix('_compact')
+
+        if event_name in [
                 'thread_switched_out',
                 'thread_switched_in',
                 'thread_pending',
@@ -84,19 +88,19 @@ def main():
             thread_name = event.payload_field.get("name", None)
 
             th = {}
-            if event.name in ['thread_switched_out', 'thread_switched_in'] and cpu is not None:
+            if event_name in ['thread_switched_out', 'thread_switched_in'] and cpu is not None:
                 cpu_string = f"(cpu: {cpu})"
             else:
                 cpu_string = ""
 
             if thread_name:
-                print(f"{dt} (+{diff_s:.6f} s): {event.name}: {thread_name} {cpu_string}")
+                print(f"{dt} (+{diff_s:.6f} s): {event_name}: {thread_name} {cpu_string}")
             elif thread_id:
-                print(f"{dt} (+{diff_s:.6f} s): {event.name}: {thread_id} {cpu_string}")
+                print(f"{dt} (+{diff_s:.6f} s): {event_name}: {thread_id} {cpu_string}")
             else:
-                print(f"{dt} (+{diff_s:.6f} s): {event.name}")
+                print(f"{dt} (+{diff_s:.6f} s): {event_name}")
 
-            if event.name in ['thread_switched_out', 'thread_switched_in']:
+            if event_name in ['thread_switched_out', 'thread_switched_in']:
                 if thread_name:
                     th = get_thread(thread_name)
                     if not th:
@@ -106,43 +110,43 @@ def main():
                     if not th:
                         th['name'] = thread_id
 
-                if event.name in ['thread_switched_out']:
+                if event_name in ['thread_switched_out']:
                     th['out'] = ns_from_origin
                     tin = th.get('in', None)
                     tout = th.get('out', None)
                     if tout is not None and tin is not None:
                         diff = tout - tin
                         th['runtime'] = diff
-                elif event.name in ['thread_switched_in']:
+                elif event_name in ['thread_switched_in']:
                     th['in'] = ns_from_origin
 
                     timeline.append(th)
 
-        elif event.name in ['thread_info']:
+        elif event_name in ['thread_info']:
             stack_size = event.payload_field['stack_size']
-            print(f"{dt} (+{diff_s:.6f} s): {event.name} (Stack size: {stack_size})")
-        elif event.name in ['start_call', 'end_call']:
+            print(f"{dt} (+{diff_s:.6f} s): {event_name} (Stack size: {stack_size})")
+        elif event_name in ['start_call', 'end_call']:
             if event.payload_field['id'] == 39:
                 c = Fore.GREEN
             elif event.payload_field['id'] in [37, 38]:
                 c = Fore.CYAN
             else:
                 c = Fore.YELLOW
-            print(c + f"{dt} (+{diff_s:.6f} s): {event.name} {event.payload_field['id']}" + Fore.RESET)
-        elif event.name in ['semaphore_init', 'semaphore_take', 'semaphore_give']:
+            print(c + f"{dt} (+{diff_s:.6f} s): {event_name} {event.payload_field['id']}" + Fore.RESET)
+        elif event_name in ['semaphore_init', 'semaphore_take', 'semaphore_give']:
             c = Fore.CYAN
-            print(c + f"{dt} (+{diff_s:.6f} s): {event.name} ({event.payload_field['id']})" + Fore.RESET)
-        elif event.name in ['mutex_init', 'mutex_take', 'mutex_give']:
+            print(c + f"{dt} (+{diff_s:.6f} s): {event_name} ({event.payload_field['id']})" + Fore.RESET)
+        elif event_name in ['mutex_init', 'mutex_take', 'mutex_give']:
             c = Fore.MAGENTA
-            print(c + f"{dt} (+{diff_s:.6f} s): {event.name} ({event.payload_field['id']})" + Fore.RESET)
+            print(c + f"{dt} (+{diff_s:.6f} s): {event_name} ({event.payload_field['id']})" + Fore.RESET)
 
-        elif event.name in ['named_event']:
+        elif event_name in ['named_event']:
             name = event.payload_field['name']
             arg0 = event.payload_field['arg0']
             arg1 = event.payload_field['arg1']
-            print(f"{dt} (+{diff_s:.6f} s): {event.name} (name: {name}, arg0: {arg0} arg1: {arg1})")
+            print(f"{dt} (+{diff_s:.6f} s): {event_name} (name: {name}, arg0: {arg0} arg1: {arg1})")
         else:
-            print(f"{dt} (+{diff_s:.6f} s): {event.name}")
+            print(f"{dt} (+{diff_s:.6f} s): {event_name}")
 
         last_event_ns_from_origin = ns_from_origin
 
@@ -0,0 +1,230 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2025 The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Compress a firmware image for flash_img_decompress_write(), and so for the
+MCUmgr image upload with CONFIG_MCUMGR_GRP_IMG_DECOMPRESS.
+
+The output starts with a struct flash_img_compressed_header, see
+include/zephyr/dfu/flash_img.h. The MCUboot image header is left uncompressed,
+so that the image can be inspected before it is decompressed.
+
+The window must not be larger than the CONFIG_IMG_DECOMPRESS_WINDOW_BITS of
+the device, and the format must be the one of its CONFIG_IMG_DECOMPRESS_FORMAT.
+
+Example:
+
+    compress_image.py --format heatshrink --window-bits 10 \\
+        zephyr.signed.bin zephyr.signed.bin.hs
+"""
+
+import argparse
+import hashlib
+import struct
+import sys
+
+MAGIC = 0x4D4F435A
+FORMATS = {'lz4': 1, 'heatshrink': 2}
+HEADER = struct.Struct('<IBBBBII32s')
+
+MCUBOOT_MAGIC = 0x96F3B83D
+
+LZ4_MIN_MATCH = 4
+LZ4_LAST_LITERALS = 5
+LZ4_MF_LIMIT = 12
+LZ4_BLOCK_SIZE = 4096
+LZ4_BLOCK_STORED = 1 << 31
+
+CHAIN_LEN = 16
+
+
+def stored_len(image):
+    """Length of the MCUboot image header, which is left uncompressed"""
+    if len(image) >= 12:
+        magic, _, hdr_size = struct.unpack_from('<IIH', image)
+        if magic == MCUBOOT_MAGIC:
+            return min(hdr_size, len(image))
+    return 0
+
+
+class Matcher:
+    """Finds the longest earlier match, from a few candidates per prefix"""
+
+    def __init__(self, data, prefix, max_dist):
+        self.data = data
+        self.prefix = prefix
+        self.max_dist = max_dist
+        self.chains = {}
+
+    def insert(self, pos):
+        key = self.data[pos:pos + self.prefix]
+        chain = self.chains.setdefault(key, [])
+        chain.append(pos)
+        if len(chain) > CHAIN_LEN:
+            del chain[0]
+
+    def find(self, pos, max_len):
+        data = self.data
+        best_len, best_dist = 0, 0
+        for cand in reversed(self.chains.get(data[pos:pos + self.prefix], [])):
+            if pos - cand > self.max_dist:
+                break
+            length = 0
+            while length < max_len and data[cand + length] == data[pos + length]:
+                length += 1
+            if length > best_len:
+                best_len, best_dist = length, pos - cand
+        return best_len, best_dist
+
+
+def lz4_len(out, length):
+    while length >= 255:
+        out.append(255)
+        length -= 255
+    out.append(length)
+
+
+def lz4_sequence(out, literals, match_len=None, dist=0):
+    lit = min(len(literals), 15)
+    mat = 0 if match_len is None else min(match_len - LZ4_MIN_MATCH, 15)
+    out.append(lit << 4 | mat)
+    if lit == 15:
+        lz4_len(out, len(literals) - 15)
+    out += literals
+    if match_len is not None:
+        out += struct.pack('<H', dist)
+        if mat == 15:
+            lz4_len(out, match_len - LZ4_MIN_MATCH - 15)
+
+
+def compress_lz4(data, start, window_bits):
+    matcher = Matcher(data, LZ4_MIN_MATCH, min(1 << window_bits, 0xFFFF))
+    out = bytearray()
+
+    for pos in range(0, start):
+        matcher.insert(pos)
+
+    for block_start in range(start, len(data), LZ4_BLOCK_SIZE):
+        block_end = min(block_start + LZ4_BLOCK_SIZE, len(data))
+        block = bytearray()
+        anchor = pos = block_start
+
+        while pos < block_end - LZ4_MF_LIMIT:
+            length, dist = matcher.find(pos, block_end - LZ4_LAST_LITERALS - pos)
+            if length < LZ4_MIN_MATCH:
+                matcher.insert(pos)
+                pos += 1
+                continue
+            lz4_sequence(block, data[anchor:pos], length, dist)
+            for i in range(pos, pos + length):
+                matcher.insert(i)
+            pos = anchor = pos + length
+
+        for i in range(pos, block_end):
+            matcher.insert(i)
+        lz4_sequence(block, data[anchor:block_end])
+
+        if len(block) < block_end - block_start:
+            out += struct.pack('<I', len(block)) + block
+        else:
+            out += struct.pack('<I', (block_end - block_start) | LZ4_BLOCK_STORED)
+            out += data[block_start:block_end]
+
+    return out + struct.pack('<I', 0)
+
+
+class BitWriter:
+    def __init__(self):
+        self.out = bytearray()
+        self.bits = 0
+        self.count = 0
+
+    def put(self, value, count):
+        for bit in reversed(range(count)):
+            self.bits = self.bits << 1 | (value >> bit) & 1
+            self.count += 1
+            if self.count == 8:
+                self.out.append(self.bits)
+                self.bits = self.count = 0
+
+    def finish(self):
+        if self.count:
+            self.out.append(self.bits << (8 - self.count))
+        return self.out
+
+
+def compress_heatshrink(data, start, window_bits, lookahead_bits):
+    matcher = Matcher(data, 2, 1 << window_bits)
+    writer = BitWriter()
+    # A backref is worth it when it is shorter than the literals it replaces
+    min_len = (1 + window_bits + lookahead_bits) // 9 + 1
+    max_len = 1 << lookahead_bits
+
+    for pos in range(0, start):
+        matcher.insert(pos)
+
+    pos = start
+    while pos < len(data):
+        length, dist = 0, 0
+        if pos + 2 <= len(data):
+            length, dist = matcher.find(pos, min(max_len, len(data) - pos))
+        if length < min_len:
+            writer.put(1, 1)
+            writer.put(data[pos], 8)
+            length = 1
+        else:
+            writer.put(0, 1)
+            writer.put(dist - 1, window_bits)
+            writer.put(length - 1, lookahead_bits)
+        for i in range(pos, pos + length):
+            matcher.insert(i)
+        pos += length
+
+    return writer.finish()
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter
+    )
+    parser.add_argument('--format', choices=FORMATS, default='heatshrink')
+    parser.add_argument('--window-bits', type=int, default=None,
+                        help='log2 of the window, 12 for LZ4 and 10 for heatshrink by default')
+    parser.add_argument('--lookahead-bits', type=int, default=4,
+                        help='log2 of the longest heatshrink match')
+    parser.add_argument('--stored', type=int, default=None,
+                        help='bytes left uncompressed, the MCUboot image header by default')
+    parser.add_argument('input', type=argparse.FileType('rb'))
+    parser.add_argument('output', type=argparse.FileType('wb'))
+    args = parser.parse_args()
+
+    image = args.input.read()
+    stored = stored_len(image) if args.stored is None else min(args.stored, len(image))
+
+    if args.format == 'lz4':
+        window_bits = 12 if args.window_bits is None else args.window_bits
+        lookahead_bits = 0
+        if not 4 <= window_bits <= 16:
+            sys.exit('LZ4 window bits must be between 4 and 16')
+        compressed = compress_lz4(image, stored, window_bits)
+    else:
+        window_bits = 10 if args.window_bits is None else args.window_bits
+        lookahead_bits = args.lookahead_bits
+        if not 4 <= window_bits <= 15 or not 3 <= lookahead_bits < window_bits:
+            sys.exit('heatshrink window bits must be between 4 and 15, '
+                     'lookahead bits between 3 and the window bits')
+        compressed = compress_heatshrink(image, stored, window_bits, lookahead_bits)
+
+    args.output.write(HEADER.pack(MAGIC, FORMATS[args.format], window_bits, lookahead_bits, 0,
+                                  len(image), stored, hashlib.sha256(image).digest()))
+    args.output.write(image[:stored])
+    args.output.write(compressed)
+
+    print(f'{len(image)} bytes compressed to {HEADER.size + stored + len(compressed)} bytes')
+
+
+if __name__ == '__main__':
+    main()
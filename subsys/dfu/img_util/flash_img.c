@@ -56,6 +56,78 @@ BUILD_ASSERT((CONFIG_IMG_BLOCK_BUF_SIZE % FLASH_WRITE_BLOCK_SIZE == 0),
 #define FLASH_CHECK_ERASED_BUFFER_SIZE 16
 #define ERASED_VAL_32(x) (((x) << 24) | ((x) << 16) | ((x) << 8) | (x))
 
+#if defined(CONFIG_IMG_INCREMENTAL_HASH)
+#include <mbedtls/sha256.h>
+
+#define HASH_READ_BUFFER_SIZE 64
+#define HASH_SIZE 32
+
+/* Number of bytes hashed once hashing failed and the hash was freed */
+#define HASH_FAILED SIZE_MAX
+
+static int hash_start(struct flash_img_context *ctx)
+{
+	mbedtls_sha256_init(&ctx->hash);
+	ctx->hashed = 0;
+
+	if (mbedtls_sha256_starts(&ctx->hash, false) != 0) {
+		mbedtls_sha256_free(&ctx->hash);
+		ctx->hashed = HASH_FAILED;
+		return -ESRCH;
+	}
+
+	return 0;
+}
+
+/* Hash what has been written to flash since the last call, as read back */
+static int hash_written(struct flash_img_context *ctx)
+{
+	uint8_t buf[HASH_READ_BUFFER_SIZE];
+	size_t written = stream_flash_bytes_written(&ctx->stream);
+	size_t len;
+	int rc;
+
+	while (ctx->hashed < written) {
+		len = MIN(sizeof(buf), written - ctx->hashed);
+
+		rc = flash_read(ctx->stream.fdev, ctx->stream.offset + ctx->hashed, buf, len);
+		if (rc != 0) {
+			return rc;
+		}
+
+		if (mbedtls_sha256_update(&ctx->hash, buf, len) != 0) {
+			mbedtls_sha256_free(&ctx->hash);
+			ctx->hashed = HASH_FAILED;
+			return -ESRCH;
+		}
+
+		ctx->hashed += len;
+	}
+
+	return 0;
+}
+
+/* Hash the rest of a complete image, and keep only its digest */
+static int hash_finish(struct flash_img_context *ctx)
+{
+	int rc = hash_written(ctx);
+
+	if (rc != 0) {
+		return rc;
+	}
+
+	rc = mbedtls_sha256_finish(&ctx->hash, ctx->hash_digest);
+	mbedtls_sha256_free(&ctx->hash);
+
+	if (rc != 0) {
+		ctx->hashed = HASH_FAILED;
+		return -ESRCH;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_IMG_INCREMENTAL_HASH */
+
 static int scramble_mcuboot_trailer(struct flash_img_context *ctx)
 {
 	int rc = 0;
@@ -125,6 +197,11 @@ int flash_img_buffered_write(struct flash_img_context *ctx, const uint8_t *data,
 	 * ensures that stream_flash erases flash progresively.
 	 */
 	rc = stream_flash_buffered_write(&ctx->stream, data, len, flush);
+#if defined(CONFIG_IMG_INCREMENTAL_HASH)
+	if (rc == 0) {
+		rc = flush ? hash_finish(ctx) : hash_written(ctx);
+	}
+#endif
 	if (!flush) {
 		return rc;
 	}
@@ -238,14 +315,32 @@ int flash_img_init_id(struct flash_img_context *ctx, uint8_t area_id)
 		}
 	}
 
-	return stream_flash_init(&ctx->stream, flash_dev, ctx->buf, CONFIG_IMG_BLOCK_BUF_SIZE,
-				 (ctx->flash_area->fa_off + sector_data.fs_size),
-				 (ctx->flash_area->fa_size - sector_data.fs_size), NULL);
+	rc = stream_flash_init(&ctx->stream, flash_dev, ctx->buf, CONFIG_IMG_BLOCK_BUF_SIZE,
+			       (ctx->flash_area->fa_off + sector_data.fs_size),
+			       (ctx->flash_area->fa_size - sector_data.fs_size), NULL);
 #else
-	return stream_flash_init(&ctx->stream, flash_dev, ctx->buf,
+	rc = stream_flash_init(&ctx->stream, flash_dev, ctx->buf,
 			CONFIG_IMG_BLOCK_BUF_SIZE, ctx->flash_area->fa_off,
 			ctx->flash_area->fa_size, NULL);
 #endif
+
+#if defined(CONFIG_IMG_WRITE_ASYNC)
+	if (rc == 0) {
+		/* Receive the next block while the previous one is written */
+		rc = stream_flash_async_init(&ctx->stream, ctx->async_buf, NULL, NULL);
+	}
+#endif
+#if defined(CONFIG_IMG_INCREMENTAL_HASH)
+	if (rc == 0) {
+		rc = hash_start(ctx);
+	}
+#endif
+#if defined(CONFIG_IMG_DECOMPRESS)
+	/* heatshrink refers to the zeroed window before the start of the image */
+	memset(&ctx->decompress, 0, sizeof(ctx->decompress));
+#endif
+
+	return rc;
 }
 
 #ifdef CONFIG_MCUBOOT_BOOTLOADER_MODE_RAM_LOAD
@@ -304,3 +399,165 @@ int flash_img_check(struct flash_img_context *ctx,
 	return rc;
 }
 #endif
+
+#if defined(CONFIG_IMG_INCREMENTAL_HASH)
+int flash_img_hash_check(struct flash_img_context *ctx,
+			 const struct flash_img_check *fic)
+{
+	mbedtls_sha256_context hash;
+	uint8_t digest[HASH_SIZE];
+	int rc;
+
+	if (!ctx || !fic || !fic->match) {
+		return -EINVAL;
+	}
+
+	if (ctx->hashed == HASH_FAILED) {
+		return -ESRCH;
+	}
+
+	/* Once flushed, only the digest of the image is left */
+	if (ctx->flash_area == NULL) {
+		if (fic->clen != ctx->hashed) {
+			return -ERANGE;
+		}
+
+		return memcmp(ctx->hash_digest, fic->match, HASH_SIZE) == 0 ? 0 : -EILSEQ;
+	}
+
+	rc = hash_written(ctx);
+	if (rc != 0) {
+		return rc;
+	}
+
+	if (fic->clen != ctx->hashed) {
+		return -ERANGE;
+	}
+
+	/* Finish a copy, the image may still be appended to */
+	mbedtls_sha256_init(&hash);
+	mbedtls_sha256_clone(&hash, &ctx->hash);
+	rc = mbedtls_sha256_finish(&hash, digest);
+	mbedtls_sha256_free(&hash);
+
+	if (rc != 0) {
+		return -ESRCH;
+	}
+
+	return memcmp(digest, fic->match, sizeof(digest)) == 0 ? 0 : -EILSEQ;
+}
+
+#if defined(CONFIG_STREAM_FLASH_PROGRESS)
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/printk.h>
+
+/* Hash state as saved; software SHA-256 contexts are plain data */
+struct hash_progress {
+	size_t hashed;
+	mbedtls_sha256_context hash;
+};
+
+static int hash_settings_key(char *key, size_t size, const char *settings_key)
+{
+	int len = snprintk(key, size, "%s/hash", settings_key);
+
+	return (len < 0 || len >= size) ? -ENAMETOOLONG : 0;
+}
+
+static int hash_settings_loader(const char *key, size_t len,
+				settings_read_cb read_cb, void *cb_arg,
+				void *param)
+{
+	struct flash_img_context *ctx = param;
+	struct hash_progress progress;
+
+	/* Handle the subtree if it is an exact key match. */
+	if (settings_name_next(key, NULL) != 0) {
+		return 0;
+	}
+
+	if (read_cb(cb_arg, &progress, sizeof(progress)) != sizeof(progress)) {
+		LOG_WRN("Unable to read image hash, hashing from flash");
+		return 0;
+	}
+
+	/* A hash behind the write progress catches up from flash */
+	if (progress.hashed <= stream_flash_bytes_written(&ctx->stream)) {
+		ctx->hashed = progress.hashed;
+		ctx->hash = progress.hash;
+	} else {
+		LOG_WRN("Image hash ahead of progress %zu > %zu, hashing from flash",
+			progress.hashed, stream_flash_bytes_written(&ctx->stream));
+	}
+
+	return 0;
+}
+
+int flash_img_progress_load(struct flash_img_context *ctx,
+			    const char *settings_key)
+{
+	char key[SETTINGS_MAX_NAME_LEN + 1];
+	int rc;
+
+	if (!ctx || !settings_key) {
+		return -EFAULT;
+	}
+
+	rc = stream_flash_progress_load(&ctx->stream, settings_key);
+	if (rc == 0) {
+		rc = hash_settings_key(key, sizeof(key), settings_key);
+	}
+	if (rc == 0) {
+		rc = settings_load_subtree_direct(key, hash_settings_loader, ctx);
+	}
+
+	return rc;
+}
+
+int flash_img_progress_save(const struct flash_img_context *ctx,
+			    const char *settings_key)
+{
+	char key[SETTINGS_MAX_NAME_LEN + 1];
+	struct hash_progress progress;
+	int rc;
+
+	if (!ctx || !settings_key) {
+		return -EFAULT;
+	}
+
+	progress.hashed = ctx->hashed;
+	progress.hash = ctx->hash;
+
+	rc = hash_settings_key(key, sizeof(key), settings_key);
+	if (rc == 0) {
+		rc = settings_save_one(key, &progress, sizeof(progress));
+	}
+	if (rc == 0) {
+		rc = stream_flash_progress_save(&ctx->stream, settings_key);
+	}
+
+	return rc;
+}
+
+int flash_img_progress_clear(const struct flash_img_context *ctx,
+			     const char *settings_key)
+{
+	char key[SETTINGS_MAX_NAME_LEN + 1];
+	int rc;
+
+	if (!ctx || !settings_key) {
+		return -EFAULT;
+	}
+
+	rc = stream_flash_progress_clear(&ctx->stream, settings_key);
+	if (rc == 0) {
+		rc = hash_settings_key(key, sizeof(key), settings_key);
+	}
+	if (rc == 0) {
+		rc = settings_delete(key);
+	}
+
+	return rc;
+}
+#endif /* CONFIG_STREAM_FLASH_PROGRESS */
+#endif /* CONFIG_IMG_INCREMENTAL_HASH */
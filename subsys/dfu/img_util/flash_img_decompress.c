@@ -0,0 +1,408 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/dfu/flash_img.h>
+
+#define WINDOW_SIZE BIT(CONFIG_IMG_DECOMPRESS_WINDOW_BITS)
+#define WINDOW_MASK (WINDOW_SIZE - 1)
+
+#if defined(CONFIG_IMG_DECOMPRESS_LZ4)
+#define FORMAT               FLASH_IMG_COMPRESSED_LZ4
+#define LZ4_MIN_MATCH        4
+#define LZ4_RUN_MASK         0xf
+#define LZ4_BLOCK_STORED     BIT(31)
+#else
+#define FORMAT               FLASH_IMG_COMPRESSED_HEATSHRINK
+#define HEATSHRINK_MIN_BITS  4
+#define HEATSHRINK_MAX_BITS  15
+#define HEATSHRINK_MIN_LOOKAHEAD_BITS 3
+#endif
+
+enum {
+	DEC_HEADER,
+	DEC_STORED,
+#if defined(CONFIG_IMG_DECOMPRESS_LZ4)
+	DEC_BLOCK_SIZE,
+	DEC_BLOCK_STORED,
+	DEC_TOKEN,
+	DEC_LITERAL_LEN,
+	DEC_LITERALS,
+	DEC_OFFSET,
+	DEC_MATCH_LEN,
+#else
+	DEC_TAG,
+	DEC_LITERAL,
+	DEC_INDEX,
+	DEC_COUNT,
+#endif
+	DEC_END,
+	DEC_FAILED,
+};
+
+const struct flash_img_compressed_header *flash_img_compressed_header(const void *data,
+								      size_t len)
+{
+	const struct flash_img_compressed_header *hdr = data;
+
+	if (len < sizeof(*hdr) || sys_le32_to_cpu(hdr->magic) != FLASH_IMG_COMPRESSED_MAGIC ||
+	    hdr->format != FORMAT || hdr->window_bits > CONFIG_IMG_DECOMPRESS_WINDOW_BITS ||
+	    sys_le32_to_cpu(hdr->stored) > sys_le32_to_cpu(hdr->size)) {
+		return NULL;
+	}
+
+#if defined(CONFIG_IMG_DECOMPRESS_HEATSHRINK)
+	if (hdr->window_bits < HEATSHRINK_MIN_BITS || hdr->window_bits > HEATSHRINK_MAX_BITS ||
+	    hdr->lookahead_bits < HEATSHRINK_MIN_LOOKAHEAD_BITS ||
+	    hdr->lookahead_bits >= hdr->window_bits) {
+		return NULL;
+	}
+#endif
+
+	return hdr;
+}
+
+/* Passes the window on to be written, up to what has been decompressed */
+static int flush_window(struct flash_img_context *ctx, bool flush)
+{
+	struct flash_img_decompress *d = &ctx->decompress;
+	int rc;
+
+	rc = flash_img_buffered_write(ctx, &d->window[d->flushed & WINDOW_MASK],
+				      d->out - d->flushed, flush);
+	if (rc == 0) {
+		d->flushed = d->out;
+	}
+
+	return rc;
+}
+
+/* The window is written out each time it wraps, so that it is never overwritten before */
+static inline int put(struct flash_img_context *ctx, uint8_t b)
+{
+	struct flash_img_decompress *d = &ctx->decompress;
+
+	if (d->out == d->size) {
+		return -EILSEQ;
+	}
+
+	d->window[d->out & WINDOW_MASK] = b;
+	d->out++;
+
+	return (d->out & WINDOW_MASK) == 0 ? flush_window(ctx, false) : 0;
+}
+
+static int copy_literals(struct flash_img_context *ctx, const uint8_t **p, const uint8_t *end)
+{
+	struct flash_img_decompress *d = &ctx->decompress;
+	int rc = 0;
+
+	while (d->run > 0 && *p < end && rc == 0) {
+		size_t len = MIN(MIN(d->run, end - *p), WINDOW_SIZE - (d->out & WINDOW_MASK));
+
+		if (len > d->size - d->out) {
+			return -EILSEQ;
+		}
+
+		memcpy(&d->window[d->out & WINDOW_MASK], *p, len);
+		*p += len;
+		d->run -= len;
+		d->out += len;
+
+		if ((d->out & WINDOW_MASK) == 0) {
+			rc = flush_window(ctx, false);
+		}
+	}
+
+	return rc;
+}
+
+static int copy_match(struct flash_img_context *ctx)
+{
+	struct flash_img_decompress *d = &ctx->decompress;
+	int rc = 0;
+
+	if (d->dist == 0 || d->dist > WINDOW_SIZE || d->match > d->size - d->out) {
+		return -EILSEQ;
+	}
+
+#if defined(CONFIG_IMG_DECOMPRESS_LZ4)
+	if (d->dist > d->out) {
+		return -EILSEQ;
+	}
+#endif
+
+	/* Byte by byte, the match may overlap what it produces */
+	for (; d->match > 0 && rc == 0; d->match--) {
+		rc = put(ctx, d->window[(d->out - d->dist) & WINDOW_MASK]);
+	}
+
+	return rc;
+}
+
+static int read_header(struct flash_img_context *ctx, const uint8_t **p, const uint8_t *end)
+{
+	struct flash_img_decompress *d = &ctx->decompress;
+	size_t len = MIN(sizeof(d->hdr) - d->have, end - *p);
+
+	memcpy((uint8_t *)&d->hdr + d->have, *p, len);
+	*p += len;
+	d->have += len;
+
+	if (d->have < sizeof(d->hdr)) {
+		return 0;
+	}
+
+	if (flash_img_compressed_header(&d->hdr, sizeof(d->hdr)) == NULL) {
+		return -EILSEQ;
+	}
+
+	d->size = sys_le32_to_cpu(d->hdr.size);
+	d->run = sys_le32_to_cpu(d->hdr.stored);
+	d->have = 0;
+	d->need = 1;
+	d->state = DEC_STORED;
+
+	return 0;
+}
+
+#if defined(CONFIG_IMG_DECOMPRESS_LZ4)
+static int decode(struct flash_img_context *ctx, const uint8_t *p, const uint8_t *end)
+{
+	struct flash_img_decompress *d = &ctx->decompress;
+	const uint8_t *start;
+	int rc = 0;
+
+	while (p < end && rc == 0) {
+		switch (d->state) {
+		case DEC_HEADER:
+			rc = read_header(ctx, &p, end);
+			break;
+		case DEC_STORED:
+		case DEC_BLOCK_STORED:
+			rc = copy_literals(ctx, &p, end);
+			if (d->run == 0) {
+				d->state = DEC_BLOCK_SIZE;
+			}
+			break;
+		case DEC_BLOCK_SIZE:
+			d->value |= (uint32_t)*p++ << (8 * d->have);
+			if (++d->have < sizeof(uint32_t)) {
+				break;
+			}
+
+			if (d->value == 0) {
+				d->state = DEC_END;
+			} else if (d->value & LZ4_BLOCK_STORED) {
+				d->run = d->value & ~LZ4_BLOCK_STORED;
+				d->state = DEC_BLOCK_STORED;
+			} else {
+				d->block = d->value;
+				d->state = DEC_TOKEN;
+			}
+
+			d->value = 0;
+			d->have = 0;
+			break;
+		case DEC_TOKEN:
+			if (d->block == 0) {
+				d->state = DEC_BLOCK_SIZE;
+				break;
+			}
+
+			d->block--;
+			d->run = *p >> 4;
+			d->match = *p++ & LZ4_RUN_MASK;
+			d->state = d->run == LZ4_RUN_MASK ? DEC_LITERAL_LEN : DEC_LITERALS;
+			break;
+		case DEC_LITERAL_LEN:
+			if (d->block == 0) {
+				rc = -EILSEQ;
+				break;
+			}
+
+			d->block--;
+			d->run += *p;
+			if (*p++ != UINT8_MAX) {
+				d->state = DEC_LITERALS;
+			}
+			break;
+		case DEC_LITERALS:
+			start = p;
+			rc = copy_literals(ctx, &p, p + MIN((size_t)(end - p), d->block));
+			d->block -= p - start;
+
+			if (d->run == 0) {
+				/* The last sequence of a block has no match */
+				d->state = d->block == 0 ? DEC_BLOCK_SIZE : DEC_OFFSET;
+			} else if (d->block == 0) {
+				rc = -EILSEQ;
+			}
+			break;
+		case DEC_OFFSET:
+			if (d->block == 0) {
+				rc = -EILSEQ;
+				break;
+			}
+
+			d->block--;
+			d->dist |= (uint32_t)*p++ << (8 * d->have);
+			if (++d->have < sizeof(uint16_t)) {
+				break;
+			}
+
+			d->have = 0;
+			if (d->match == LZ4_RUN_MASK) {
+				d->state = DEC_MATCH_LEN;
+				break;
+			}
+
+			d->match += LZ4_MIN_MATCH;
+			rc = copy_match(ctx);
+			d->dist = 0;
+			d->state = DEC_TOKEN;
+			break;
+		case DEC_MATCH_LEN:
+			if (d->block == 0) {
+				rc = -EILSEQ;
+				break;
+			}
+
+			d->block--;
+			d->match += *p;
+			if (*p++ == UINT8_MAX) {
+				break;
+			}
+
+			d->match += LZ4_MIN_MATCH;
+			rc = copy_match(ctx);
+			d->dist = 0;
+			d->state = DEC_TOKEN;
+			break;
+		case DEC_END:
+			/* Anything after the end mark, such as a checksum, is ignored */
+			p = end;
+			break;
+		default:
+			rc = -EILSEQ;
+			break;
+		}
+	}
+
+	return rc;
+}
+#else
+/* Handles a complete field of the heatshrink stream */
+static int decode_field(struct flash_img_context *ctx)
+{
+	struct flash_img_decompress *d = &ctx->decompress;
+	int rc = 0;
+
+	switch (d->state) {
+	case DEC_TAG:
+		d->state = d->value ? DEC_LITERAL : DEC_INDEX;
+		d->need = d->value ? BITS_PER_BYTE : d->hdr.window_bits;
+		break;
+	case DEC_LITERAL:
+		rc = put(ctx, d->value);
+		d->state = DEC_TAG;
+		d->need = 1;
+		break;
+	case DEC_INDEX:
+		d->dist = d->value + 1;
+		d->state = DEC_COUNT;
+		d->need = d->hdr.lookahead_bits;
+		break;
+	case DEC_COUNT:
+		d->match = d->value + 1;
+		rc = copy_match(ctx);
+		d->state = DEC_TAG;
+		d->need = 1;
+		break;
+	default:
+		rc = -EILSEQ;
+		break;
+	}
+
+	d->value = 0;
+	d->have = 0;
+
+	return rc;
+}
+
+static int decode(struct flash_img_context *ctx, const uint8_t *p, const uint8_t *end)
+{
+	struct flash_img_decompress *d = &ctx->decompress;
+	int rc = 0;
+
+	while (p < end && rc == 0) {
+		switch (d->state) {
+		case DEC_HEADER:
+			rc = read_header(ctx, &p, end);
+			break;
+		case DEC_STORED:
+			rc = copy_literals(ctx, &p, end);
+			if (d->run == 0) {
+				d->state = DEC_TAG;
+			}
+			break;
+		case DEC_TAG:
+		case DEC_LITERAL:
+		case DEC_INDEX:
+		case DEC_COUNT:
+			/* Fields are packed most significant bit first */
+			for (int bit = BITS_PER_BYTE - 1; bit >= 0 && rc == 0; bit--) {
+				d->value = (d->value << 1) | ((*p >> bit) & 1);
+				if (++d->have == d->need) {
+					rc = decode_field(ctx);
+				}
+
+				if (d->out == d->size) {
+					/* The rest of the stream is padding */
+					d->state = DEC_END;
+					break;
+				}
+			}
+			p++;
+			break;
+		case DEC_END:
+			p = end;
+			break;
+		default:
+			rc = -EILSEQ;
+			break;
+		}
+	}
+
+	return rc;
+}
+#endif
+
+int flash_img_decompress_write(struct flash_img_context *ctx, const uint8_t *data,
+			       size_t len, bool flush)
+{
+	struct flash_img_decompress *d = &ctx->decompress;
+	int rc;
+
+	rc = decode(ctx, data, data + len);
+
+	if (rc == 0 && flush) {
+		if (d->state == DEC_HEADER || d->out != d->size) {
+			rc = -EILSEQ;
+		} else {
+			rc = flush_window(ctx, true);
+		}
+	}
+
+	if (rc != 0) {
+		d->state = DEC_FAILED;
+	}
+
+	return rc;
+}
@@ -72,6 +72,63 @@ int32_t ext2_bitmap_find_free(uint8_t *bm, uint32_t size)
 	return -ENOSPC;
 }
 
+static inline bool bit_is_set(const uint8_t *bm, uint32_t index)
+{
+	return (bm[index / 8] & BIT(index % 8)) != 0;
+}
+
+static int32_t find_zero(const uint8_t *bm, uint32_t from, uint32_t to)
+{
+	uint32_t i = from;
+
+	while (i < to) {
+		if ((i % 8) == 0 && bm[i / 8] == UINT8_MAX) {
+			/* skip whole bytes of used blocks */
+			i += 8;
+			continue;
+		}
+		if (!bit_is_set(bm, i)) {
+			return i;
+		}
+		i++;
+	}
+	return -ENOSPC;
+}
+
+int32_t ext2_bitmap_find_free_run(uint8_t *bm, uint32_t size, uint32_t goal, uint32_t *len)
+{
+	int32_t start;
+	uint32_t end;
+
+	if (goal >= size) {
+		goal = 0;
+	}
+
+	start = find_zero(bm, goal, size);
+	if (start < 0) {
+		start = find_zero(bm, 0, goal);
+	}
+	if (start < 0) {
+		return -ENOSPC;
+	}
+
+	end = start + 1;
+	while (end < size && end - start < *len) {
+		if ((end % 8) == 0 && bm[end / 8] == 0 && end + 8 <= size &&
+		    end - start + 8 <= *len) {
+			end += 8;
+		} else if (!bit_is_set(bm, end)) {
+			end++;
+		} else {
+			break;
+		}
+	}
+
+	LOG_DBG("Free run %d-%d (goal: %d)", start, end - 1, goal);
+	*len = end - start;
+	return start;
+}
+
 uint32_t ext2_bitmap_count_set(uint8_t *bm, uint32_t size)
 {
 	int32_t count = 0;
@@ -51,6 +51,23 @@ int ext2_bitmap_unset(uint8_t *bm, uint32_t index, uint32_t size);
  */
 int32_t ext2_bitmap_find_free(uint8_t *bm, uint32_t size);
 
+/**
+ * @brief Find a run of bits set to zero in bitmap
+ *
+ * The search starts at the goal and wraps around to the beginning of the bitmap
+ * if there is no bit set to zero after the goal. The run found may be shorter
+ * than requested.
+ *
+ * @param bm Pointer to bitmap
+ * @param size Size of bitmap in bits
+ * @param goal Index where the search starts
+ * @param len Requested length of the run; set to the length of the run found
+ *
+ * @retval >=0 index of the first bit of the run;
+ * @retval -ENOSPC when not found;
+ */
+int32_t ext2_bitmap_find_free_run(uint8_t *bm, uint32_t size, uint32_t goal, uint32_t *len);
+
 /**
  * @brief Helper function to count bits set in bitmap
  *
@@ -476,6 +476,160 @@ int ext2_fetch_inode_block(struct ext2_inode *inode, uint32_t block)
 	return 0;
 }
 
+/* Allocate indirect blocks on the path to the current block that are not allocated yet. */
+static int alloc_indirect_blocks(struct ext2_inode *inode, int max_lvl)
+{
+	int ret;
+	struct ext2_block *b;
+	struct ext2_data *fs = inode->i_fs;
+
+	for (int lvl = 0; lvl < max_lvl; ++lvl) {
+		b = inode->blocks[lvl];
+		if (b->flags & EXT2_BLOCK_ASSIGNED) {
+			continue;
+		}
+
+		ret = ext2_assign_block_num(fs, b);
+		if (ret < 0) {
+			return ret;
+		}
+
+		/* Empty block must be written, it holds no block numbers yet. */
+		ret = ext2_write_block(fs, b);
+		if (ret < 0) {
+			return ret;
+		}
+		inode->i_blocks += fs->block_size / 512;
+
+		if (lvl == 0) {
+			inode->i_block[inode->offsets[0]] = b->num;
+			ret = ext2_commit_inode(inode);
+		} else {
+			((uint32_t *)inode->blocks[lvl - 1]->data)[inode->offsets[lvl]] =
+				sys_cpu_to_le32(b->num);
+			ret = ext2_write_block(fs, inode->blocks[lvl - 1]);
+		}
+		if (ret < 0) {
+			return ret;
+		}
+		LOG_DBG("Alloc lvl:%d (num: %d) indirect", lvl, b->num);
+	}
+	return 0;
+}
+
+static inline uint32_t get_block_entry(const uint32_t *list, uint32_t i, int lvl)
+{
+	/* Block numbers in inode are already converted, the ones in indirect blocks are not. */
+	return lvl == 0 ? list[i] : sys_le32_to_cpu(list[i]);
+}
+
+int ext2_inode_map_blocks(struct ext2_inode *inode, uint32_t block, uint32_t count, bool alloc,
+		uint32_t *phys)
+{
+	struct ext2_data *fs = inode->i_fs;
+	uint32_t offsets[MAX_OFFSETS_SIZE];
+	uint32_t *list, first, len, goal;
+	int max_lvl, ret;
+	int64_t num;
+
+	max_lvl = get_level_offsets(fs, block, offsets);
+	if (max_lvl < 0) {
+		return max_lvl;
+	}
+
+	/* Only indirect blocks are fetched, data blocks are accessed directly by the caller. */
+	if (max_lvl > 0) {
+		ret = fetch_level_blocks(inode, offsets, 0, max_lvl - 1,
+				inode->flags & INODE_FETCHED_BLOCK);
+		if (ret < 0) {
+			ext2_inode_drop_blocks(inode);
+			return ret;
+		}
+	}
+
+	/* Cached data block could become stale, the next fetch reads it again. */
+	ext2_drop_block(inode->blocks[max_lvl]);
+	inode->blocks[max_lvl] = NULL;
+	memcpy(inode->offsets, offsets, MAX_OFFSETS_SIZE * sizeof(uint32_t));
+	inode->offsets[max_lvl] = UINT32_MAX;
+	inode->block_lvl = max_lvl;
+	inode->block_num = UINT32_MAX;
+	inode->flags |= INODE_FETCHED_BLOCK;
+
+	if (alloc) {
+		ret = alloc_indirect_blocks(inode, max_lvl);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	if (max_lvl == 0) {
+		list = inode->i_block;
+		count = MIN(count, EXT2_INODE_BLOCK_DIRECT - offsets[0]);
+	} else {
+		list = (uint32_t *)inode->blocks[max_lvl - 1]->data;
+		count = MIN(count, fs->block_size / EXT2_BLOCK_NUM_SIZE - offsets[max_lvl]);
+	}
+
+	first = offsets[max_lvl];
+	*phys = get_block_entry(list, first, max_lvl);
+
+	if (*phys != 0) {
+		/* Count blocks that lie one after another on the disk. */
+		for (len = 1; len < count; ++len) {
+			if (get_block_entry(list, first + len, max_lvl) != *phys + len) {
+				break;
+			}
+		}
+		return len;
+	}
+
+	for (len = 1; len < count; ++len) {
+		if (get_block_entry(list, first + len, max_lvl) != 0) {
+			break;
+		}
+	}
+	if (!alloc) {
+		/* Hole in the file */
+		return len;
+	}
+
+	/* Place new blocks right after the previous block of the file if possible. */
+	if (first > 0) {
+		goal = get_block_entry(list, first - 1, max_lvl) + 1;
+	} else if (max_lvl > 0) {
+		goal = inode->blocks[max_lvl - 1]->num + 1;
+	} else {
+		goal = 0;
+	}
+
+	num = ext2_alloc_blocks(fs, goal, &len);
+	if (num < 0) {
+		return num;
+	}
+
+	LOG_DBG("Alloc lvl:%d (num: %lld, count: %d) data", max_lvl, num, len);
+
+	for (uint32_t i = 0; i < len; ++i) {
+		list[first + i] = max_lvl == 0 ? (uint32_t)(num + i) : sys_cpu_to_le32(num + i);
+	}
+	inode->i_blocks += len * (fs->block_size / 512);
+
+	if (max_lvl > 0) {
+		ret = ext2_write_block(fs, inode->blocks[max_lvl - 1]);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+	ret = ext2_commit_inode(inode);
+	if (ret < 0) {
+		return ret;
+	}
+
+	*phys = num;
+	return len;
+}
+
 static bool all_zero(const uint32_t *offsets, int lvl)
 {
 	for (int i = 0; i < lvl; ++i) {
@@ -865,28 +1019,37 @@ int ext2_clear_inode(struct ext2_data *fs, uint32_t ino)
 	return ret;
 }
 
-int64_t ext2_alloc_block(struct ext2_data *fs)
+int64_t ext2_alloc_blocks(struct ext2_data *fs, uint32_t goal, uint32_t *count)
 {
-	int rc, bitmap_slot;
-	uint32_t group = 0, set;
-	int32_t total;
+	int rc;
+	int32_t bitmap_slot;
+	uint32_t ngroups = get_ngroups(fs);
+	uint32_t group = 0, slot = 0, nbits, set;
+	int64_t total;
 
-	rc = ext2_fetch_block_group(fs, group);
-	if (rc < 0) {
-		return rc;
+	/* In bitmap blocks are counted from s_first_data_block hence we have to subtract it. */
+	if (goal >= fs->sblock.s_first_data_block && goal < fs->sblock.s_blocks_count) {
+		goal -= fs->sblock.s_first_data_block;
+		group = goal / fs->sblock.s_blocks_per_group;
+		slot = goal % fs->sblock.s_blocks_per_group;
 	}
 
-	LOG_DBG("Free blocks: %d", fs->bgroup.bg_free_blocks_count);
-	while ((rc >= 0) && (fs->bgroup.bg_free_blocks_count == 0)) {
-		group++;
+	/* Start in the group of the goal and wrap around to the first group. */
+	for (uint32_t i = 0; i < ngroups; ++i, ++group, slot = 0) {
+		group %= ngroups;
+
 		rc = ext2_fetch_block_group(fs, group);
-		if (rc == -ERANGE) {
-			/* reached last group */
-			return -ENOSPC;
+		if (rc < 0) {
+			return rc;
+		}
+
+		LOG_DBG("Free blocks: %d in group %d", fs->bgroup.bg_free_blocks_count, group);
+		if (fs->bgroup.bg_free_blocks_count > 0) {
+			break;
 		}
 	}
-	if (rc < 0) {
-		return rc;
+	if (fs->bgroup.bg_free_blocks_count == 0) {
+		return -ENOSPC;
 	}
 
 	rc = ext2_fetch_bg_bbitmap(&fs->bgroup);
@@ -894,24 +1057,32 @@ int64_t ext2_alloc_block(struct ext2_data *fs)
 		return rc;
 	}
 
-	bitmap_slot = ext2_bitmap_find_free(BGROUP_BLOCK_BITMAP(&fs->bgroup), fs->block_size);
+	nbits = MIN(fs->sblock.s_blocks_per_group, fs->sblock.s_blocks_count -
+			fs->sblock.s_first_data_block - group * fs->sblock.s_blocks_per_group);
+
+	bitmap_slot = ext2_bitmap_find_free_run(BGROUP_BLOCK_BITMAP(&fs->bgroup), nbits, slot,
+			count);
 	if (bitmap_slot < 0) {
 		LOG_WRN("Cannot find free block in group %d (rc: %d)", group, bitmap_slot);
 		return bitmap_slot;
 	}
 
-	/* In bitmap blocks are counted from s_first_data_block hence we have to add this offset. */
-	total = group * fs->sblock.s_blocks_per_group + bitmap_slot + fs->sblock.s_first_data_block;
+	total = (int64_t)group * fs->sblock.s_blocks_per_group + bitmap_slot +
+		fs->sblock.s_first_data_block;
 
-	LOG_DBG("Found free block %d in group %d (total: %d)", bitmap_slot, group, total);
+	LOG_DBG("Found %d free blocks at %d in group %d (total: %lld)", *count, bitmap_slot,
+			group, total);
 
-	rc = ext2_bitmap_set(BGROUP_BLOCK_BITMAP(&fs->bgroup), bitmap_slot, fs->block_size);
-	if (rc < 0) {
-		return rc;
+	for (uint32_t i = 0; i < *count; ++i) {
+		rc = ext2_bitmap_set(BGROUP_BLOCK_BITMAP(&fs->bgroup), bitmap_slot + i,
+				fs->block_size);
+		if (rc < 0) {
+			return rc;
+		}
 	}
 
-	fs->bgroup.bg_free_blocks_count -= 1;
-	fs->sblock.s_free_blocks_count -= 1;
+	fs->bgroup.bg_free_blocks_count -= *count;
+	fs->sblock.s_free_blocks_count -= *count;
 
 	set = ext2_bitmap_count_set(BGROUP_BLOCK_BITMAP(&fs->bgroup), fs->sblock.s_blocks_count);
 
@@ -938,6 +1109,13 @@ int64_t ext2_alloc_block(struct ext2_data *fs)
 	return total;
 }
 
+int64_t ext2_alloc_block(struct ext2_data *fs)
+{
+	uint32_t count = 1;
+
+	return ext2_alloc_blocks(fs, 0, &count);
+}
+
 static int check_zero_inode(struct ext2_data *fs, uint32_t ino)
 {
 	int32_t itable_offset = get_itable_entry(fs, ino);
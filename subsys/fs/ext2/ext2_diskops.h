@@ -41,6 +41,29 @@ int ext2_fetch_inode(struct ext2_data *fs, uint32_t ino, struct ext2_inode *inod
  */
 int ext2_fetch_inode_block(struct ext2_inode *inode, uint32_t block);
 
+/**
+ * @brief Map blocks of inode to blocks on the disk.
+ *
+ * Finds where the inode block lies on the disk and how many of the following inode
+ * blocks lie right after it, so that they can be read or written at once. Only the
+ * indirect blocks are fetched, the data block cached in the inode is dropped.
+ *
+ * When there are no blocks on the disk for the inode block, then it is a hole and
+ * @p phys is set to 0, unless @p alloc is true. In that case blocks are allocated,
+ * next to the previous block of the inode if possible.
+ *
+ * @param inode Inode structure
+ * @param block Number of the first inode block to map
+ * @param count Number of inode blocks to map
+ * @param alloc Allocate blocks for holes
+ * @param phys Number of the first block on the disk, or 0 for a hole
+ *
+ * @retval >0 number of blocks mapped (at most @p count)
+ * @retval <0 error
+ */
+int ext2_inode_map_blocks(struct ext2_inode *inode, uint32_t block, uint32_t count, bool alloc,
+		uint32_t *phys);
+
 /**
  * @brief Fetch block group into buffer in fs structure.
  *
@@ -176,6 +199,22 @@ int ext2_commit_bg(struct ext2_data *fs);
  */
 int64_t ext2_alloc_block(struct ext2_data *fs);
 
+/**
+ * @brief Reserve contiguous blocks for future use.
+ *
+ * Search for a run of free blocks, starting at the goal. Proper fields in superblock
+ * and block group are updated once for the whole run and blocks are marked as used
+ * in block bitmap.
+ *
+ * @param fs File system data
+ * @param goal Preferred number of the first block (0 - no preference)
+ * @param count Number of requested blocks; set to the number of allocated blocks
+ *
+ * @retval >0 number of first allocated block
+ * @retval <0 error
+ */
+int64_t ext2_alloc_blocks(struct ext2_data *fs, uint32_t goal, uint32_t *count);
+
 /**
  * @brief Reserve an inode for future use.
  *
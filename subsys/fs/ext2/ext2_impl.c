@@ -606,6 +606,58 @@ success:
 
 /* Inode operations --------------------------------------------------------- */
 
+/* Whole blocks are transferred directly between the disk and the caller's buffer,
+ * as many at once as lie one after another on the disk.
+ */
+static ssize_t read_whole_blocks(struct ext2_inode *inode, uint8_t *buf, uint32_t block,
+		uint32_t count)
+{
+	int rc;
+	uint32_t phys;
+	struct ext2_data *fs = inode->i_fs;
+
+	rc = ext2_inode_map_blocks(inode, block, count, false, &phys);
+	if (rc < 0) {
+		return rc;
+	}
+
+	LOG_DBG("inode:%d Read blocks %d-%d from %d", inode->i_id, block, block + rc - 1, phys);
+
+	if (phys == 0) {
+		memset(buf, 0, rc * fs->block_size);
+		return rc;
+	}
+
+	count = rc;
+	rc = fs->backend_ops->read_blocks(fs, buf, phys, count);
+	if (rc < 0) {
+		return rc;
+	}
+	return count;
+}
+
+static ssize_t write_whole_blocks(struct ext2_inode *inode, const uint8_t *buf, uint32_t block,
+		uint32_t count)
+{
+	int rc;
+	uint32_t phys;
+	struct ext2_data *fs = inode->i_fs;
+
+	rc = ext2_inode_map_blocks(inode, block, count, true, &phys);
+	if (rc < 0) {
+		return rc;
+	}
+
+	LOG_DBG("inode:%d Write blocks %d-%d to %d", inode->i_id, block, block + rc - 1, phys);
+
+	count = rc;
+	rc = fs->backend_ops->write_blocks(fs, buf, phys, count);
+	if (rc < 0) {
+		return rc;
+	}
+	return count;
+}
+
 ssize_t ext2_inode_read(struct ext2_inode *inode, void *buf, uint32_t offset, size_t nbytes)
 {
 	int rc = 0;
@@ -617,6 +669,23 @@ ssize_t ext2_inode_read(struct ext2_inode *inode, void *buf, uint32_t offset, si
 
 		uint32_t block = offset / block_size;
 		uint32_t block_off = offset % block_size;
+		uint32_t left_in_file = inode->i_size - offset;
+
+		if (IS_ENABLED(CONFIG_EXT2_MULTI_BLOCK_IO) && block_off == 0 &&
+		    MIN(nbytes_to_read, left_in_file) >= block_size) {
+			ssize_t blocks = read_whole_blocks(inode, (uint8_t *)buf + read, block,
+					MIN(nbytes_to_read, left_in_file) / block_size);
+
+			if (blocks < 0) {
+				rc = blocks;
+				break;
+			}
+
+			read += blocks * block_size;
+			nbytes_to_read -= blocks * block_size;
+			offset += blocks * block_size;
+			continue;
+		}
 
 		rc = ext2_fetch_inode_block(inode, block);
 		if (rc < 0) {
@@ -624,7 +693,6 @@ ssize_t ext2_inode_read(struct ext2_inode *inode, void *buf, uint32_t offset, si
 		}
 
 		uint32_t left_on_blk = block_size - block_off;
-		uint32_t left_in_file = inode->i_size - offset;
 		size_t to_read = MIN(nbytes_to_read, MIN(left_on_blk, left_in_file));
 
 		memcpy((uint8_t *)buf + read, inode_current_block_mem(inode) + block_off, to_read);
@@ -647,18 +715,33 @@ ssize_t ext2_inode_write(struct ext2_inode *inode, const void *buf, uint32_t off
 	uint32_t block_size = inode->i_fs->block_size;
 
 	while (written < nbytes) {
-		uint32_t block = offset / block_size;
-		uint32_t block_off = offset % block_size;
+		uint32_t pos = offset + written;
+		uint32_t block = pos / block_size;
+		uint32_t block_off = pos % block_size;
 
 		LOG_DBG("inode:%d Write to block %d (offset: %d-%zd/%d)",
-				inode->i_id, block, offset, offset + nbytes, inode->i_size);
+				inode->i_id, block, pos, offset + nbytes, inode->i_size);
+
+		if (IS_ENABLED(CONFIG_EXT2_MULTI_BLOCK_IO) && block_off == 0 &&
+		    nbytes - written >= block_size) {
+			ssize_t blocks = write_whole_blocks(inode, (const uint8_t *)buf + written,
+					block, (nbytes - written) / block_size);
+
+			if (blocks < 0) {
+				rc = blocks;
+				break;
+			}
+
+			written += blocks * block_size;
+			continue;
+		}
 
 		rc = ext2_fetch_inode_block(inode, block);
 		if (rc < 0) {
 			break;
 		}
 
-		size_t to_write = MIN(nbytes, block_size - block_off);
+		size_t to_write = MIN(nbytes - written, block_size - block_off);
 
 		memcpy(inode_current_block_mem(inode) + block_off, (uint8_t *)buf + written,
 				to_write);
@@ -752,6 +835,9 @@ int ext2_inode_trunc(struct ext2_inode *inode, off_t length)
 		LOG_DBG("Removed blocks: %lld (%lld)",
 				removed_blocks, removed_blocks * (block_size / 512));
 		inode->i_blocks -= removed_blocks * (block_size / 512);
+
+		/* Fetched blocks may refer to removed ones. */
+		ext2_inode_drop_blocks(inode);
 	}
 
 	inode->i_size = new_size;
@@ -1542,6 +1628,7 @@ void ext2_inode_drop_blocks(struct ext2_inode *inode)
 {
 	for (int i = 0; i < 4; ++i) {
 		ext2_drop_block(inode->blocks[i]);
+		inode->blocks[i] = NULL;
 	}
 	inode->flags &= ~INODE_FETCHED_BLOCK;
 }
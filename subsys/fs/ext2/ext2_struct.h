@@ -220,6 +220,8 @@ struct ext2_backend_ops {
 	int64_t (*get_write_size)(struct ext2_data *fs);
 	int (*read_block)(struct ext2_data *fs, void *buf, uint32_t num);
 	int (*write_block)(struct ext2_data *fs, const void *buf, uint32_t num);
+	int (*read_blocks)(struct ext2_data *fs, void *buf, uint32_t num, uint32_t count);
+	int (*write_blocks)(struct ext2_data *fs, const void *buf, uint32_t num, uint32_t count);
 	int (*read_superblock)(struct ext2_data *fs, struct ext2_disk_superblock *sb);
 	int (*sync)(struct ext2_data *fs);
 };
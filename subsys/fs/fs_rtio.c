@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/fs_rtio.h>
+#include <zephyr/rtio/work.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(fs);
+
+static ssize_t fs_rtio_op(const struct fs_rtio_data *data,
+			  struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct rtio_sqe *sqe = &iodev_sqe->sqe;
+	uint8_t *buf;
+	uint32_t len;
+	int rc;
+
+	switch (sqe->op) {
+	case RTIO_OP_NOP:
+		return 0;
+	case RTIO_OP_RX:
+		rc = rtio_sqe_rx_buf(iodev_sqe, 1, data->read_max, &buf, &len);
+		if (rc != 0) {
+			return rc;
+		}
+
+		return fs_read(data->file, buf, len);
+	case RTIO_OP_TX:
+		return fs_write(data->file, sqe->tx.buf, sqe->tx.buf_len);
+	case RTIO_OP_TINY_TX:
+		return fs_write(data->file, sqe->tiny_tx.buf, sqe->tiny_tx.buf_len);
+	default:
+		LOG_DBG("Unsupported op %u", sqe->op);
+		return -ENOTSUP;
+	}
+}
+
+/* Runs in the RTIO work queue, where blocking is fine */
+static void fs_rtio_work(struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct fs_rtio_data *data = iodev_sqe->sqe.iodev->data;
+	struct rtio_iodev_sqe *txn_curr = iodev_sqe;
+	int total = 0;
+	ssize_t rc;
+
+	do {
+		rc = fs_rtio_op(data, txn_curr);
+		if (rc < 0) {
+			rtio_iodev_sqe_err(iodev_sqe, (int)rc);
+			return;
+		}
+
+		total += (int)rc;
+		txn_curr = rtio_txn_next(txn_curr);
+	} while (txn_curr != NULL);
+
+	rtio_iodev_sqe_ok(iodev_sqe, total);
+}
+
+static void fs_rtio_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct rtio_work_req *req = rtio_work_req_alloc();
+
+	if (req == NULL) {
+		LOG_ERR("RTIO work item allocation failed. Consider to increase "
+			"CONFIG_RTIO_WORKQ_POOL_ITEMS.");
+		rtio_iodev_sqe_err(iodev_sqe, -ENOMEM);
+		return;
+	}
+
+	rtio_work_req_submit(req, iodev_sqe, fs_rtio_work);
+}
+
+const struct rtio_iodev_api fs_rtio_iodev_api = {
+	.submit = fs_rtio_submit,
+};
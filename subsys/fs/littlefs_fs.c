@@ -171,6 +171,192 @@ static int errno_to_lfs(int error)
 
 #ifdef CONFIG_FS_LITTLEFS_FMP_DEV
 
+#ifdef CONFIG_FS_LITTLEFS_FMP_CACHE
+#define LFS_FS(c) CONTAINER_OF(c, struct fs_littlefs, cfg)
+
+static inline bool fmp_overlaps(off_t a, size_t a_len, off_t b, size_t b_len)
+{
+	return (a_len > 0) && (b_len > 0) && (a < b + (off_t)b_len) && (b < a + (off_t)a_len);
+}
+
+static int fmp_prog_flush(struct fs_littlefs *fs)
+{
+	const struct flash_area *fa = fs->backend;
+	int rc = 0;
+
+	if (fs->fmp_prog_buffer_len > 0) {
+		/* Nothing read ahead may hide what reaches flash now */
+		if (fmp_overlaps(fs->fmp_prog_buffer_off, fs->fmp_prog_buffer_len,
+				 fs->fmp_read_cache_off, fs->fmp_read_cache_len)) {
+			fs->fmp_read_cache_len = 0;
+		}
+
+		rc = flash_area_write(fa, fs->fmp_prog_buffer_off, fs->fmp_prog_buffer,
+				      fs->fmp_prog_buffer_len);
+		fs->fmp_prog_buffer_len = 0;
+	}
+
+	return rc;
+}
+
+static int fmp_read(struct fs_littlefs *fs, off_t offset, void *buffer, size_t size)
+{
+	const struct flash_area *fa = fs->backend;
+	bool sequential;
+	size_t len;
+	int rc;
+
+	/* Buffered programs must reach flash before being read back */
+	if (fmp_overlaps(offset, size, fs->fmp_prog_buffer_off, fs->fmp_prog_buffer_len)) {
+		rc = fmp_prog_flush(fs);
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	if ((fs->fmp_read_cache == NULL) || (fs->fmp_read_cache_size == 0)) {
+		return flash_area_read(fa, offset, buffer, size);
+	}
+
+	sequential = (offset == fs->fmp_read_next);
+	fs->fmp_read_next = offset + size;
+
+	if ((offset >= fs->fmp_read_cache_off) &&
+	    (offset + size <= fs->fmp_read_cache_off + fs->fmp_read_cache_len)) {
+		memcpy(buffer, fs->fmp_read_cache + (offset - fs->fmp_read_cache_off), size);
+		return 0;
+	}
+
+	/* Random reads go straight to flash, not to evict what is cached */
+	if (!sequential || (size >= fs->fmp_read_cache_size)) {
+		return flash_area_read(fa, offset, buffer, size);
+	}
+
+	/* Nor can they be read ahead */
+	len = MIN(fs->fmp_read_cache_size, fa->fa_size - offset);
+	if (fmp_overlaps(offset, len, fs->fmp_prog_buffer_off, fs->fmp_prog_buffer_len)) {
+		rc = fmp_prog_flush(fs);
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	fs->fmp_read_cache_off = offset;
+	fs->fmp_read_cache_len = len;
+
+	rc = flash_area_read(fa, offset, fs->fmp_read_cache, fs->fmp_read_cache_len);
+	if (rc < 0) {
+		fs->fmp_read_cache_len = 0;
+		return rc;
+	}
+
+	memcpy(buffer, fs->fmp_read_cache, size);
+
+	return 0;
+}
+
+static int fmp_prog(struct fs_littlefs *fs, off_t offset, const void *buffer, size_t size)
+{
+	const struct flash_area *fa = fs->backend;
+	int rc;
+
+	if (fmp_overlaps(offset, size, fs->fmp_read_cache_off, fs->fmp_read_cache_len)) {
+		fs->fmp_read_cache_len = 0;
+	}
+
+	if ((fs->fmp_prog_buffer == NULL) || (fs->fmp_prog_buffer_size == 0)) {
+		return flash_area_write(fa, offset, buffer, size);
+	}
+
+	/* Only programs following each other are merged */
+	if ((fs->fmp_prog_buffer_len > 0) &&
+	    ((offset != fs->fmp_prog_buffer_off + fs->fmp_prog_buffer_len) ||
+	     (fs->fmp_prog_buffer_len + size > fs->fmp_prog_buffer_size))) {
+		rc = fmp_prog_flush(fs);
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	if (fs->fmp_prog_buffer_len == 0) {
+		if (size >= fs->fmp_prog_buffer_size) {
+			return flash_area_write(fa, offset, buffer, size);
+		}
+
+		fs->fmp_prog_buffer_off = offset;
+	}
+
+	memcpy(fs->fmp_prog_buffer + fs->fmp_prog_buffer_len, buffer, size);
+	fs->fmp_prog_buffer_len += size;
+
+	if (fs->fmp_prog_buffer_len == fs->fmp_prog_buffer_size) {
+		return fmp_prog_flush(fs);
+	}
+
+	return 0;
+}
+
+static int fmp_erase(struct fs_littlefs *fs, off_t offset, size_t size)
+{
+	const struct flash_area *fa = fs->backend;
+	int rc;
+
+	/* Keep programs in order with the erase */
+	rc = fmp_prog_flush(fs);
+	if (rc < 0) {
+		return rc;
+	}
+
+	if (fmp_overlaps(offset, size, fs->fmp_read_cache_off, fs->fmp_read_cache_len)) {
+		fs->fmp_read_cache_len = 0;
+	}
+
+	return flash_area_flatten(fa, offset, size);
+}
+
+static void fmp_cache_reset(struct fs_littlefs *fs)
+{
+	fs->fmp_read_cache_len = 0;
+	fs->fmp_read_next = 0;
+	fs->fmp_prog_buffer_len = 0;
+}
+
+static int lfs_api_read(const struct lfs_config *c, lfs_block_t block,
+			lfs_off_t off, void *buffer, lfs_size_t size)
+{
+	size_t offset = block * c->block_size + off;
+
+	int rc = fmp_read(LFS_FS(c), offset, buffer, size);
+
+	return errno_to_lfs(rc);
+}
+
+static int lfs_api_prog(const struct lfs_config *c, lfs_block_t block,
+			lfs_off_t off, const void *buffer, lfs_size_t size)
+{
+	size_t offset = block * c->block_size + off;
+
+	int rc = fmp_prog(LFS_FS(c), offset, buffer, size);
+
+	return errno_to_lfs(rc);
+}
+
+static int lfs_api_erase(const struct lfs_config *c, lfs_block_t block)
+{
+	size_t offset = block * c->block_size;
+
+	int rc = fmp_erase(LFS_FS(c), offset, c->block_size);
+
+	return errno_to_lfs(rc);
+}
+
+static int lfs_api_sync_fmp(const struct lfs_config *c)
+{
+	int rc = fmp_prog_flush(LFS_FS(c));
+
+	return errno_to_lfs(rc);
+}
+#else
 static int lfs_api_read(const struct lfs_config *c, lfs_block_t block,
 			lfs_off_t off, void *buffer, lfs_size_t size)
 {
@@ -202,6 +388,7 @@ static int lfs_api_erase(const struct lfs_config *c, lfs_block_t block)
 
 	return errno_to_lfs(rc);
 }
+#endif /* CONFIG_FS_LITTLEFS_FMP_CACHE */
 #endif /* CONFIG_FS_LITTLEFS_FMP_DEV */
 
 #ifdef CONFIG_FS_LITTLEFS_BLK_DEV
@@ -254,10 +441,12 @@ static int lfs_api_erase_blk(const struct lfs_config *c, lfs_block_t block)
 	return 0;
 }
 
+#ifndef CONFIG_FS_LITTLEFS_FMP_CACHE
 static int lfs_api_sync(const struct lfs_config *c)
 {
 	return LFS_ERR_OK;
 }
+#endif
 
 static void release_file_data(struct fs_file_t *fp)
 {
@@ -878,7 +1067,22 @@ static int littlefs_init_cfg(struct fs_littlefs *fs, int flags)
 		lcp->prog_size = prog_size;
 		lcp->cache_size = cache_size;
 		lcp->lookahead_size = lookahead_size;
+#ifdef CONFIG_FS_LITTLEFS_FMP_CACHE
+		if (((fs->fmp_read_cache_size % read_size) != 0) ||
+		    ((fs->fmp_prog_buffer_size % prog_size) != 0)) {
+			LOG_WRN("Flash cache sizes %zu, %zu not multiples of rd %u, pr %u",
+				fs->fmp_read_cache_size, fs->fmp_prog_buffer_size,
+				read_size, prog_size);
+		}
+		fs->fmp_read_cache_size = ROUND_DOWN(fs->fmp_read_cache_size, read_size);
+		fs->fmp_prog_buffer_size = ROUND_DOWN(fs->fmp_prog_buffer_size, prog_size);
+		fmp_cache_reset(fs);
+		LOG_INF("flash cache sizes: rd %zu ; pr %zu", fs->fmp_read_cache_size,
+			fs->fmp_prog_buffer_size);
+		lcp->sync = lfs_api_sync_fmp;
+#else
 		lcp->sync = lfs_api_sync;
+#endif /* CONFIG_FS_LITTLEFS_FMP_CACHE */
 	}
 
 #ifdef CONFIG_FS_LITTLEFS_DISK_VERSION
@@ -1021,6 +1225,10 @@ static int littlefs_unmount(struct fs_mount_t *mountp)
 
 #ifdef CONFIG_FS_LITTLEFS_FMP_DEV
 	if (!littlefs_on_blkdev(mountp->flags)) {
+#ifdef CONFIG_FS_LITTLEFS_FMP_CACHE
+		/* Programs of files left open are not synced */
+		(void)fmp_prog_flush(fs);
+#endif
 		flash_area_close(fs->backend);
 	}
 #endif /* CONFIG_FS_LITTLEFS_FMP_DEV */
@@ -1067,7 +1275,30 @@ static const struct fs_file_system_t littlefs_fs = {
 #define FS_DISK_VERSION(inst)
 #endif
 
+#ifdef CONFIG_FS_LITTLEFS_FMP_CACHE
+#define FS_FMP_READ_CACHE_SIZE(inst) \
+	DT_INST_PROP_OR(inst, flash_read_cache_size, CONFIG_FS_LITTLEFS_FMP_READ_CACHE_SIZE)
+#define FS_FMP_PROG_BUFFER_SIZE(inst) \
+	DT_INST_PROP_OR(inst, flash_prog_buffer_size, CONFIG_FS_LITTLEFS_FMP_PROG_BUFFER_SIZE)
+#define FS_FMP_CACHE_DEFINE(inst) \
+static uint8_t __aligned(4) \
+	fmp_read_cache_##inst[MAX(FS_FMP_READ_CACHE_SIZE(inst), 1)]; \
+static uint8_t __aligned(4) \
+	fmp_prog_buffer_##inst[MAX(FS_FMP_PROG_BUFFER_SIZE(inst), 1)];
+#define FS_FMP_CACHE(inst) \
+	.fmp_read_cache = FS_FMP_READ_CACHE_SIZE(inst) > 0 ? \
+		fmp_read_cache_##inst : NULL, \
+	.fmp_read_cache_size = FS_FMP_READ_CACHE_SIZE(inst), \
+	.fmp_prog_buffer = FS_FMP_PROG_BUFFER_SIZE(inst) > 0 ? \
+		fmp_prog_buffer_##inst : NULL, \
+	.fmp_prog_buffer_size = FS_FMP_PROG_BUFFER_SIZE(inst),
+#else
+#define FS_FMP_CACHE_DEFINE(inst)
+#define FS_FMP_CACHE(inst)
+#endif
+
 #define DEFINE_FS(inst) \
+FS_FMP_CACHE_DEFINE(inst) \
 static uint8_t __aligned(4) \
 	read_buffer_##inst[DT_INST_PROP(inst, cache_size)]; \
 static uint8_t __aligned(4) \
@@ -1095,6 +1326,7 @@ static struct fs_littlefs fs_data_##inst = { \
 		.lookahead_buffer = lookahead_buffer_##inst, \
 		FS_DISK_VERSION(inst) \
 	}, \
+	FS_FMP_CACHE(inst) \
 }; \
 struct fs_mount_t FS_FSTAB_ENTRY(DT_DRV_INST(inst)) = { \
 	.type = FS_LITTLEFS, \
@@ -148,6 +148,25 @@ int img_mgmt_get_next_boot_slot(int image, enum img_mgmt_next_boot_type *type);
  */
 uint8_t img_mgmt_state_flags(int query_slot);
 
+/**
+ * Gets the hash and the size the image written by the current upload is to be
+ * checked against: those sent with the upload, or those in the compressed
+ * image header of a compressed upload.
+ *
+ * @param size		Set to the size of the image.
+ *
+ * @return the SHA-256 hash of the image.
+ */
+const uint8_t *img_mgmt_image_data_hash(size_t *size);
+
+/**
+ * Checks the image data written by the last upload against the hash sent with
+ * it, using the hash computed while the image was written.
+ *
+ * @return 0 if the hash matches, negative errno code otherwise.
+ */
+int img_mgmt_check_image_data(void);
+
 /**
  * Erases image data at given offset
  *
@@ -189,6 +208,59 @@ int img_mgmt_erase_if_needed(uint32_t off, uint32_t len);
 int img_mgmt_upload_inspect(const struct img_mgmt_upload_req *req,
 			    struct img_mgmt_upload_action *action);
 
+#if defined(CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW)
+/**
+ * Checks whether an upload chunk ahead of the expected offset can be kept
+ * until the image has been written up to it.
+ *
+ * @param off		Offset of the chunk in the image.
+ * @param len		Length of the chunk.
+ *
+ * @return true if img_mgmt_upload_window_store() may be called for the chunk.
+ */
+bool img_mgmt_upload_window_accepts(size_t off, size_t len);
+
+/**
+ * Keeps a chunk accepted by img_mgmt_upload_window_accepts(), replacing one
+ * kept earlier for the same offset.
+ *
+ * @param off		Offset of the chunk in the image.
+ * @param data		Chunk data.
+ * @param len		Length of the chunk.
+ */
+void img_mgmt_upload_window_store(size_t off, const uint8_t *data, size_t len);
+
+/**
+ * Takes the kept chunk starting at the offset the image has been written up
+ * to, if any. The data remains valid until the next chunk is stored.
+ *
+ * @param data		On success, set to the chunk data.
+ * @param len		On success, set to the length of the chunk.
+ *
+ * @return true if a chunk has been taken.
+ */
+bool img_mgmt_upload_window_next(const uint8_t **data, size_t *len);
+
+/**
+ * Drops all kept chunks.
+ */
+void img_mgmt_upload_window_reset(void);
+#else
+static inline bool img_mgmt_upload_window_accepts(size_t off, size_t len)
+{
+	return false;
+}
+
+static inline bool img_mgmt_upload_window_next(const uint8_t **data, size_t *len)
+{
+	return false;
+}
+
+static inline void img_mgmt_upload_window_reset(void)
+{
+}
+#endif
+
 /**
  * @brief	Takes the image management lock (if enabled) to prevent other
  *		threads interfering with an ongoing operation.
@@ -404,6 +404,7 @@ static void img_mgmt_reset_upload(void)
 	img_mgmt_take_lock();
 	memset(&g_img_mgmt_state, 0, sizeof(g_img_mgmt_state));
 	g_img_mgmt_state.area_id = -1;
+	img_mgmt_upload_window_reset();
 	img_mgmt_release_lock();
 }
 
@@ -843,6 +844,7 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 #endif
 
 		g_img_mgmt_state.off = 0;
+		img_mgmt_upload_window_reset();
 
 #if defined(CONFIG_MCUMGR_GRP_IMG_STATUS_HOOKS)
 		(void)mgmt_callback_notify(MGMT_EVT_OP_IMG_MGMT_DFU_STARTED, NULL, 0, &err_rc,
@@ -909,47 +911,66 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 #endif
 	}
 
+#if defined(CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW)
+	if (req.off != g_img_mgmt_state.off) {
+		/* Ahead of what has been written, keep it until the gap is filled */
+		img_mgmt_upload_window_store(req.off, req.img_data.value, action.write_bytes);
+		goto end;
+	}
+#endif
+
 	/* Write the image data to flash. */
 	if (req.img_data.len != 0) {
-		/* If this is the last chunk */
-		if (g_img_mgmt_state.off + req.img_data.len == g_img_mgmt_state.size) {
-			last = true;
-		}
+		const uint8_t *data = req.img_data.value;
+		size_t len = action.write_bytes;
 
-		rc = img_mgmt_write_image_data(req.off, req.img_data.value, action.write_bytes,
-						    last);
-		if (rc == 0) {
-			g_img_mgmt_state.off += action.write_bytes;
-		} else {
-			/* Write failed, currently not able to recover from this */
+		/* Followed by the chunks received ahead of this one, if any */
+		do {
+			/* If this is the last chunk */
+			if (g_img_mgmt_state.off + len == g_img_mgmt_state.size) {
+				last = true;
+			}
+
+			rc = img_mgmt_write_image_data(g_img_mgmt_state.off, data, len, last);
+			if (rc == 0) {
+				g_img_mgmt_state.off += len;
+			} else {
+				/* Write failed, currently not able to recover from this */
 #if defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
-			cmd_status_arg.status = IMG_MGMT_ID_UPLOAD_STATUS_COMPLETE;
+				cmd_status_arg.status = IMG_MGMT_ID_UPLOAD_STATUS_COMPLETE;
 #endif
 
-			IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(&action,
-				img_mgmt_err_str_flash_write_failed);
-			reset = true;
-			IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(&action,
-				img_mgmt_err_str_flash_write_failed);
+				IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(&action,
+					img_mgmt_err_str_flash_write_failed);
+				reset = true;
+				IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(&action,
+					img_mgmt_err_str_flash_write_failed);
 
-			LOG_ERR("Irrecoverable error: flash write failed: %d", rc);
+				LOG_ERR("Irrecoverable error: flash write failed: %d", rc);
 
-			ok = smp_add_cmd_err(zse, MGMT_GROUP_ID_IMAGE, rc);
-			goto end;
-		}
+				ok = smp_add_cmd_err(zse, MGMT_GROUP_ID_IMAGE, rc);
+				goto end;
+			}
+		} while (!last && img_mgmt_upload_window_next(&data, &len));
 
 		if (g_img_mgmt_state.off == g_img_mgmt_state.size) {
 			/* Done */
 			reset = true;
 
-#ifdef CONFIG_IMG_ENABLE_IMAGE_CHECK
+#if defined(CONFIG_IMG_INCREMENTAL_HASH)
+			/* Hashed while written, no need to read the image again */
+			if (img_mgmt_check_image_data() == 0) {
+				data_match = true;
+			} else {
+				LOG_ERR("Uploaded image sha256 hash verification failed");
+			}
+#elif defined(CONFIG_IMG_ENABLE_IMAGE_CHECK)
 			static struct flash_img_context ctx;
 
 			if (flash_img_init_id(&ctx, g_img_mgmt_state.area_id) == 0) {
-				struct flash_img_check fic = {
-					.match = g_img_mgmt_state.data_sha,
-					.clen = g_img_mgmt_state.size,
-				};
+				struct flash_img_check fic;
+
+				fic.match = img_mgmt_image_data_hash(&fic.clen);
 
 				if (flash_img_check(&ctx, &fic, g_img_mgmt_state.area_id) == 0) {
 					data_match = true;
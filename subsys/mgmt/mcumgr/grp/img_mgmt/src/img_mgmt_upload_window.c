@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Reassembly of image upload chunks received ahead of the expected offset.
+ *
+ * Clients keeping several upload requests in flight may have chunks arrive
+ * after later ones, when a request is lost and retransmitted or when the
+ * transport reorders them. Such chunks are kept here until the image has been
+ * written up to their offset, a bitmap tracking which slots are in use.
+ */
+
+#include <string.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/mgmt/mcumgr/grp/img_mgmt/img_mgmt.h>
+
+#include <mgmt/mcumgr/grp/img_mgmt/img_mgmt_priv.h>
+
+#define SLOTS     CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW_SLOTS
+#define SLOT_SIZE CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW_SLOT_SIZE
+
+BUILD_ASSERT(SLOTS <= 32, "Slots are tracked in a 32-bit bitmap");
+
+struct window_slot {
+	size_t off;
+	size_t len;
+};
+
+static struct window_slot slots[SLOTS];
+static uint8_t slot_data[SLOTS][SLOT_SIZE];
+static uint32_t slots_used;
+
+static int find_slot(size_t off)
+{
+	for (int i = 0; i < SLOTS; i++) {
+		if ((slots_used & BIT(i)) && slots[i].off == off) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+bool img_mgmt_upload_window_accepts(size_t off, size_t len)
+{
+	if (g_img_mgmt_state.area_id == -1 || off <= g_img_mgmt_state.off ||
+	    len == 0 || len > SLOT_SIZE) {
+		return false;
+	}
+
+	/* Only keep what the client may have in flight, not the whole image */
+	if (off - g_img_mgmt_state.off >= (size_t)SLOTS * SLOT_SIZE) {
+		return false;
+	}
+
+	return find_slot(off) >= 0 || slots_used != GENMASK(SLOTS - 1, 0);
+}
+
+void img_mgmt_upload_window_store(size_t off, const uint8_t *data, size_t len)
+{
+	int i = find_slot(off);
+
+	if (i < 0) {
+		/* A free slot exists, img_mgmt_upload_window_accepts() checked */
+		i = 0;
+		while (slots_used & BIT(i)) {
+			i++;
+		}
+		slots_used |= BIT(i);
+	}
+
+	slots[i].off = off;
+	slots[i].len = len;
+	memcpy(slot_data[i], data, len);
+}
+
+bool img_mgmt_upload_window_next(const uint8_t **data, size_t *len)
+{
+	int next = -1;
+
+	for (int i = 0; i < SLOTS; i++) {
+		if (!(slots_used & BIT(i))) {
+			continue;
+		}
+
+		if (slots[i].off == g_img_mgmt_state.off) {
+			next = i;
+		} else if (slots[i].off < g_img_mgmt_state.off) {
+			/* Overlaps what has been written, the client sent other chunk sizes */
+			slots_used &= ~BIT(i);
+		}
+	}
+
+	if (next < 0) {
+		return false;
+	}
+
+	/* The data stays in place until the next chunk is stored */
+	slots_used &= ~BIT(next);
+	*data = slot_data[next];
+	*len = slots[next].len;
+
+	return true;
+}
+
+void img_mgmt_upload_window_reset(void)
+{
+	slots_used = 0;
+}
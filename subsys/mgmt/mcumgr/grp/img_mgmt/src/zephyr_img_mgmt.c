@@ -11,6 +11,7 @@
 #include <zephyr/dfu/mcuboot.h>
 #include <zephyr/dfu/flash_img.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/sys/byteorder.h>
 #include <bootutil/bootutil_public.h>
 #include <assert.h>
 
@@ -369,6 +370,75 @@ int img_mgmt_read(int slot, unsigned int offset, void *dst, unsigned int num_byt
 	return 0;
 }
 
+#if defined(CONFIG_MCUMGR_GRP_IMG_DECOMPRESS)
+/* Header of the current upload, if compressed */
+static struct flash_img_compressed_header upload_compressed;
+static bool upload_is_compressed;
+
+static void upload_compressed_check(const void *data, unsigned int num_bytes)
+{
+	const struct flash_img_compressed_header *hdr;
+
+	hdr = flash_img_compressed_header(data, num_bytes);
+	upload_is_compressed = (hdr != NULL);
+
+	if (upload_is_compressed) {
+		memcpy(&upload_compressed, hdr, sizeof(upload_compressed));
+	}
+}
+
+static int upload_write(struct flash_img_context *ctx, const void *data, unsigned int num_bytes,
+			bool last)
+{
+	if (upload_is_compressed) {
+		return flash_img_decompress_write(ctx, data, num_bytes, last);
+	}
+
+	return flash_img_buffered_write(ctx, data, num_bytes, last);
+}
+#else
+static inline void upload_compressed_check(const void *data, unsigned int num_bytes)
+{
+}
+
+static inline int upload_write(struct flash_img_context *ctx, const void *data,
+			       unsigned int num_bytes, bool last)
+{
+	return flash_img_buffered_write(ctx, data, num_bytes, last);
+}
+#endif
+
+const uint8_t *img_mgmt_image_data_hash(size_t *size)
+{
+#if defined(CONFIG_MCUMGR_GRP_IMG_DECOMPRESS)
+	if (upload_is_compressed) {
+		*size = sys_le32_to_cpu(upload_compressed.size);
+		return upload_compressed.sha256;
+	}
+#endif
+
+	*size = g_img_mgmt_state.size;
+	return g_img_mgmt_state.data_sha;
+}
+
+#if defined(CONFIG_IMG_INCREMENTAL_HASH)
+/* Result of checking the last upload against its hash */
+static int upload_check_rc = -ENODATA;
+
+static void check_upload(struct flash_img_context *ctx)
+{
+	struct flash_img_check fic;
+
+	fic.match = img_mgmt_image_data_hash(&fic.clen);
+	upload_check_rc = flash_img_hash_check(ctx, &fic);
+}
+
+int img_mgmt_check_image_data(void)
+{
+	return upload_check_rc;
+}
+#endif
+
 #if defined(CONFIG_MCUMGR_GRP_IMG_USE_HEAP_FOR_FLASH_IMG_CONTEXT)
 int img_mgmt_write_image_data(unsigned int offset, const void *data, unsigned int num_bytes,
 			      bool last)
@@ -402,13 +472,21 @@ int img_mgmt_write_image_data(unsigned int offset, const void *data, unsigned in
 			rc = IMG_MGMT_ERR_FLASH_OPEN_FAILED;
 			goto out;
 		}
+
+		upload_compressed_check(data, num_bytes);
 	}
 
-	if (flash_img_buffered_write(ctx, data, num_bytes, last) != 0) {
+	if (upload_write(ctx, data, num_bytes, last) != 0) {
 		rc = IMG_MGMT_ERR_FLASH_WRITE_FAILED;
 		goto out;
 	}
 
+#if defined(CONFIG_IMG_INCREMENTAL_HASH)
+	if (last) {
+		check_upload(ctx);
+	}
+#endif
+
 out:
 	if (last || rc != MGMT_ERR_EOK) {
 		k_free(ctx);
@@ -427,12 +505,20 @@ int img_mgmt_write_image_data(unsigned int offset, const void *data, unsigned in
 		if (flash_img_init_id(&ctx, g_img_mgmt_state.area_id) != 0) {
 			return IMG_MGMT_ERR_FLASH_OPEN_FAILED;
 		}
+
+		upload_compressed_check(data, num_bytes);
 	}
 
-	if (flash_img_buffered_write(&ctx, data, num_bytes, last) != 0) {
+	if (upload_write(&ctx, data, num_bytes, last) != 0) {
 		return IMG_MGMT_ERR_FLASH_WRITE_FAILED;
 	}
 
+#if defined(CONFIG_IMG_INCREMENTAL_HASH)
+	if (last) {
+		check_upload(&ctx);
+	}
+#endif
+
 	return IMG_MGMT_ERR_OK;
 }
 #endif
@@ -570,6 +656,10 @@ int img_mgmt_upload_inspect(const struct img_mgmt_upload_req *req,
 	if (req->off == 0) {
 		/* First upload chunk. */
 		const struct flash_area *fa;
+		size_t image_size;
+#if defined(CONFIG_MCUMGR_GRP_IMG_DECOMPRESS)
+		const struct flash_img_compressed_header *chdr;
+#endif
 #if defined(CONFIG_MCUMGR_GRP_IMG_TOO_LARGE_SYSBUILD) &&			\
 	(defined(CONFIG_MCUBOOT_BOOTLOADER_MODE_SWAP_WITHOUT_SCRATCH) ||	\
 	 defined(CONFIG_MCUBOOT_BOOTLOADER_MODE_SWAP_USING_OFFSET) ||		\
@@ -602,8 +692,26 @@ int img_mgmt_upload_inspect(const struct img_mgmt_upload_req *req,
 		}
 
 		action->size = req->size;
+		image_size = req->size;
 
 		hdr = (struct image_header *)req->img_data.value;
+
+#if defined(CONFIG_MCUMGR_GRP_IMG_DECOMPRESS)
+		chdr = flash_img_compressed_header(req->img_data.value, req->img_data.len);
+		if (chdr != NULL) {
+			/* The image header follows the compressed image header uncompressed */
+			if (req->img_data.len < sizeof(*chdr) + sizeof(*hdr) ||
+			    sys_le32_to_cpu(chdr->stored) < sizeof(*hdr)) {
+				IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(action,
+					img_mgmt_err_str_hdr_malformed);
+				LOG_DBG("Compressed image without image header");
+				return IMG_MGMT_ERR_INVALID_IMAGE_HEADER;
+			}
+
+			hdr = (const struct image_header *)(chdr + 1);
+			image_size = sys_le32_to_cpu(chdr->size);
+		}
+#endif
 		if (hdr->ih_magic != IMAGE_MAGIC) {
 			IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(action, img_mgmt_err_str_magic_mismatch);
 			LOG_DBG("Magic mismatch: %08X != %08X", hdr->ih_magic, IMAGE_MAGIC);
@@ -646,11 +754,11 @@ int img_mgmt_upload_inspect(const struct img_mgmt_upload_req *req,
 		}
 
 		/* Check that the area is of sufficient size to store the new image */
-		if (req->size > fa->fa_size) {
+		if (image_size > fa->fa_size) {
 			IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(action,
 				img_mgmt_err_str_image_too_large);
 			flash_area_close(fa);
-			LOG_DBG("Upload too large for slot: %u > %u", req->size,
+			LOG_DBG("Upload too large for slot: %u > %u", image_size,
 				fa->fa_size);
 			return IMG_MGMT_ERR_INVALID_IMAGE_TOO_LARGE;
 		}
@@ -699,11 +807,11 @@ int img_mgmt_upload_inspect(const struct img_mgmt_upload_req *req,
 			goto skip_size_check;
 		}
 
-		if (req->size > (fa->fa_size - CONFIG_MCUBOOT_UPDATE_FOOTER_SIZE)) {
+		if (image_size > (fa->fa_size - CONFIG_MCUBOOT_UPDATE_FOOTER_SIZE)) {
 			IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(action,
 				img_mgmt_err_str_image_too_large);
 			flash_area_close(fa);
-			LOG_DBG("Upload too large for slot (with end offset): %u > %u", req->size,
+			LOG_DBG("Upload too large for slot (with end offset): %u > %u", image_size,
 				(fa->fa_size - CONFIG_MCUBOOT_UPDATE_FOOTER_SIZE));
 			return IMG_MGMT_ERR_INVALID_IMAGE_TOO_LARGE;
 		}
@@ -714,12 +822,12 @@ skip_size_check:
 				   sizeof(max_image_size));
 
 		if (rc == sizeof(max_image_size) && max_image_size > 0 &&
-		    req->size > max_image_size) {
+		    image_size > max_image_size) {
 			IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(action,
 				img_mgmt_err_str_image_too_large);
 			flash_area_close(fa);
 			LOG_DBG("Upload too large for slot (with max image size): %u > %u",
-				req->size, max_image_size);
+				image_size, max_image_size);
 			return IMG_MGMT_ERR_INVALID_IMAGE_TOO_LARGE;
 		}
 #endif
@@ -775,7 +883,8 @@ skip_size_check:
 		action->area_id = g_img_mgmt_state.area_id;
 		action->size = g_img_mgmt_state.size;
 
-		if (req->off != g_img_mgmt_state.off) {
+		if (req->off != g_img_mgmt_state.off &&
+		    !img_mgmt_upload_window_accepts(req->off, req->img_data.len)) {
 			/*
 			 * Invalid offset. Drop the data, and respond with the offset we're
 			 * expecting data for.
@@ -218,6 +218,63 @@ end:
 	return rc;
 }
 
+#if CONFIG_MCUMGR_GRP_IMG_CLIENT_UPLOAD_WINDOW > 1
+/* Given once per response to an upload request in flight */
+static K_SEM_DEFINE(upload_window_sem, 0, CONFIG_MCUMGR_GRP_IMG_CLIENT_UPLOAD_WINDOW);
+/* Offset the data passed to img_mgmt_client_upload() starts at */
+static size_t upload_window_start;
+
+static int image_upload_window_res_fn(struct net_buf *nb, void *user_data)
+{
+	zcbor_state_t zsd[CONFIG_MCUMGR_SMP_CBOR_MAX_DECODING_LEVELS + 2];
+	size_t decoded;
+	size_t offset = SIZE_MAX;
+	int rc;
+	int32_t res_rc = MGMT_ERR_EOK;
+
+	struct zcbor_map_decode_key_val upload_res_decode[] = {
+		ZCBOR_MAP_DECODE_KEY_DECODER("off", zcbor_size_decode, &offset),
+		ZCBOR_MAP_DECODE_KEY_DECODER("rc", zcbor_int32_decode, &res_rc)};
+
+	if (!nb) {
+		/* Not an error of the upload, the window is sent again from the
+		 * last acknowledged offset once the other requests are done
+		 */
+		LOG_WRN("Upload request timed out at %zu", active_client->upload.offset);
+		k_sem_give(user_data);
+		return MGMT_ERR_ETIMEOUT;
+	}
+
+	zcbor_new_decode_state(zsd, ARRAY_SIZE(zsd), nb->data, nb->len, 1, NULL, 0);
+
+	rc = zcbor_map_decode_bulk(zsd, upload_res_decode, ARRAY_SIZE(upload_res_decode), &decoded);
+	if (rc || offset == SIZE_MAX) {
+		rc = MGMT_ERR_EINVAL;
+		goto end;
+	}
+	rc = res_rc;
+
+	if (rc == MGMT_ERR_EOK) {
+		image_upload_buf->image_upload_offset = offset;
+
+		/* Offsets acknowledge all data before them, late responses carry older ones */
+		if (offset > active_client->upload.offset) {
+			active_client->upload.offset = offset;
+		} else if (offset < upload_window_start) {
+			LOG_ERR("Upload restarted by server at %zu", offset);
+			rc = MGMT_ERR_EBADSTATE;
+		}
+	}
+end:
+	/* Keep the first error, the other requests in flight fail with it */
+	if (rc && image_upload_buf->status == MGMT_ERR_EOK) {
+		image_upload_buf->status = rc;
+	}
+	k_sem_give(user_data);
+	return rc;
+}
+#endif
+
 static int erase_res_fn(struct net_buf *nb, void *user_data)
 {
 	zcbor_state_t zsd[CONFIG_MCUMGR_SMP_CBOR_MAX_DECODING_LEVELS + 2];
@@ -293,6 +350,50 @@ static size_t upload_message_header_size(struct img_gr_upload *upload_state)
 	return cbor_length + (CONFIG_MCUMGR_GRP_IMG_UPLOAD_DATA_ALIGNMENT_SIZE - 1);
 }
 
+/* Encode an upload request for the chunk of @p length bytes at @p offset */
+static bool upload_request_encode(struct img_gr_upload *upload_state, struct net_buf *nb,
+				  const uint8_t *data, size_t length, size_t offset)
+{
+	zcbor_state_t zse[CONFIG_MCUMGR_SMP_CBOR_MAX_DECODING_LEVELS + 2];
+	uint32_t map_count;
+	bool ok;
+
+	zcbor_new_encode_state(zse, ARRAY_SIZE(zse), nb->data + nb->len, net_buf_tailroom(nb), 0);
+	if (offset) {
+		map_count = 6;
+	} else if (upload_state->hash_initialized) {
+		map_count = 12;
+	} else {
+		map_count = 10;
+	}
+
+	/* Init map start and write image info, data and offset */
+	ok = zcbor_map_start_encode(zse, map_count) && zcbor_tstr_put_lit(zse, "image") &&
+	     zcbor_uint32_put(zse, upload_state->image_num) && zcbor_tstr_put_lit(zse, "data") &&
+	     zcbor_bstr_encode_ptr(zse, data, length) && zcbor_tstr_put_lit(zse, "off") &&
+	     zcbor_size_put(zse, offset);
+	/* Write Len and configured hash when offset is zero */
+	if (ok && !offset) {
+		ok = zcbor_tstr_put_lit(zse, "len") &&
+		     zcbor_size_put(zse, upload_state->image_size);
+		if (ok && upload_state->hash_initialized) {
+			ok = zcbor_tstr_put_lit(zse, "sha") &&
+			     zcbor_bstr_encode_ptr(zse, upload_state->sha256,
+						   IMG_MGMT_DATA_SHA_LEN);
+		}
+	}
+
+	if (ok) {
+		ok = zcbor_map_end_encode(zse, map_count);
+	}
+
+	if (ok) {
+		nb->len = zse->payload - nb->data;
+	}
+
+	return ok;
+}
+
 void img_mgmt_client_init(struct img_mgmt_client *client, struct smp_client_object *smp_client,
 			  int image_list_size, struct mcumgr_image_data *image_list)
 {
@@ -328,16 +429,106 @@ int img_mgmt_client_upload_init(struct img_mgmt_client *client, size_t image_siz
 	return rc;
 }
 
+#if CONFIG_MCUMGR_GRP_IMG_CLIENT_UPLOAD_WINDOW > 1
+/* Upload with up to CONFIG_MCUMGR_GRP_IMG_CLIENT_UPLOAD_WINDOW requests in flight */
+static void upload_windowed(const uint8_t *data, size_t length, size_t max_data_length)
+{
+	struct img_gr_upload *upload = &active_client->upload;
+	struct net_buf *nb;
+	size_t start = upload->offset;
+	size_t end = start + length;
+	size_t send_off = start;
+	size_t rewind_off = SIZE_MAX;
+	size_t write_length;
+	int in_flight = 0;
+	int window;
+	int rc;
+
+	upload_window_start = start;
+	image_upload_buf->status = MGMT_ERR_EOK;
+	image_upload_buf->image_upload_offset = start;
+	k_sem_reset(&upload_window_sem);
+
+	while (true) {
+		/* The first chunk starts the upload on the server, nothing can go before it */
+		window = upload->offset ? CONFIG_MCUMGR_GRP_IMG_CLIENT_UPLOAD_WINDOW : 1;
+
+		while (in_flight < window && send_off < end &&
+		       image_upload_buf->status == MGMT_ERR_EOK) {
+			write_length = MIN(max_data_length, end - send_off);
+
+			nb = smp_client_buf_allocation(active_client->smp_client,
+						       MGMT_GROUP_ID_IMAGE, IMG_MGMT_ID_UPLOAD,
+						       MGMT_OP_WRITE, SMP_MCUMGR_VERSION_1);
+			if (!nb) {
+				image_upload_buf->status = MGMT_ERR_ENOMEM;
+				break;
+			}
+
+			if (!upload_request_encode(upload, nb, data + (send_off - start),
+						   write_length, send_off)) {
+				LOG_ERR("Failed to encode Image Upload packet");
+				smp_packet_free(nb);
+				image_upload_buf->status = MGMT_ERR_ENOMEM;
+				break;
+			}
+
+			rc = smp_client_send_cmd(active_client->smp_client, nb,
+						 image_upload_window_res_fn, &upload_window_sem,
+						 CONFIG_MCUMGR_GRP_IMG_FLASH_OPERATION_TIMEOUT);
+			if (rc) {
+				LOG_ERR("Failed to send SMP Upload packet, err: %d", rc);
+				smp_packet_free(nb);
+				image_upload_buf->status = rc;
+				break;
+			}
+
+			in_flight++;
+			send_off += write_length;
+		}
+
+		if (in_flight == 0) {
+			/* Done, failed or nothing left to send */
+			break;
+		}
+
+		k_sem_take(&upload_window_sem, K_FOREVER);
+		in_flight--;
+
+		if (upload->offset >= end) {
+			/* Done, or further than expected which indicates upload session resume */
+			send_off = end;
+		} else if (upload->offset > send_off) {
+			send_off = upload->offset;
+		} else if (in_flight == 0 && upload->offset < send_off) {
+			/* The server dropped chunks or requests timed out, send again
+			 * from the acknowledged offset
+			 */
+			if (upload->offset == rewind_off) {
+				LOG_ERR("Upload stalled at %zu", rewind_off);
+				image_upload_buf->status = MGMT_ERR_EBADSTATE;
+			}
+			rewind_off = upload->offset;
+			send_off = upload->offset;
+		}
+	}
+
+	if (image_upload_buf->status) {
+		LOG_ERR("Upload Fail: %d", image_upload_buf->status);
+	} else {
+		image_upload_buf->image_upload_offset = upload->offset;
+	}
+}
+#endif
+
 int img_mgmt_client_upload(struct img_mgmt_client *client, const uint8_t *data, size_t length,
 			   struct mcumgr_image_upload *res_buf)
 {
 	struct net_buf *nb;
 	const uint8_t *write_ptr;
 	int rc;
-	uint32_t map_count;
 	bool ok;
 	size_t write_length, max_data_length, offset_before_send, request_length, wrote_length;
-	zcbor_state_t zse[CONFIG_MCUMGR_SMP_CBOR_MAX_DECODING_LEVELS + 2];
 
 	k_mutex_lock(&mcumgr_img_client_grp_mutex, K_FOREVER);
 	active_client = client;
@@ -356,6 +547,11 @@ int img_mgmt_client_upload(struct img_mgmt_client *client, const uint8_t *data,
 			(max_data_length % CONFIG_MCUMGR_GRP_IMG_UPLOAD_DATA_ALIGNMENT_SIZE);
 	}
 
+#if CONFIG_MCUMGR_GRP_IMG_CLIENT_UPLOAD_WINDOW > 1
+	upload_windowed(data, length, max_data_length);
+	goto end;
+#endif
+
 	while (request_length != wrote_length) {
 		write_ptr = data + wrote_length;
 		write_length = request_length - wrote_length;
@@ -371,38 +567,8 @@ int img_mgmt_client_upload(struct img_mgmt_client *client, const uint8_t *data,
 			goto end;
 		}
 
-		zcbor_new_encode_state(zse, ARRAY_SIZE(zse), nb->data + nb->len,
-				       net_buf_tailroom(nb), 0);
-		if (active_client->upload.offset) {
-			map_count = 6;
-		} else if (active_client->upload.hash_initialized) {
-			map_count = 12;
-		} else {
-			map_count = 10;
-		}
-
-		/* Init map start and write image info, data and offset */
-		ok = zcbor_map_start_encode(zse, map_count) && zcbor_tstr_put_lit(zse, "image") &&
-		     zcbor_uint32_put(zse, active_client->upload.image_num) &&
-		     zcbor_tstr_put_lit(zse, "data") &&
-		     zcbor_bstr_encode_ptr(zse, write_ptr, write_length) &&
-		     zcbor_tstr_put_lit(zse, "off") &&
-		     zcbor_size_put(zse, active_client->upload.offset);
-		/* Write Len and configured hash when offset is zero */
-		if (ok && !active_client->upload.offset) {
-			ok = zcbor_tstr_put_lit(zse, "len") &&
-			     zcbor_size_put(zse, active_client->upload.image_size);
-			if (ok && active_client->upload.hash_initialized) {
-				ok = zcbor_tstr_put_lit(zse, "sha") &&
-				     zcbor_bstr_encode_ptr(zse, active_client->upload.sha256,
-							   IMG_MGMT_DATA_SHA_LEN);
-			}
-		}
-
-		if (ok) {
-			ok = zcbor_map_end_encode(zse, map_count);
-		}
-
+		ok = upload_request_encode(&active_client->upload, nb, write_ptr, write_length,
+					   active_client->upload.offset);
 		if (!ok) {
 			LOG_ERR("Failed to encode Image Upload packet");
 			smp_packet_free(nb);
@@ -411,7 +577,6 @@ int img_mgmt_client_upload(struct img_mgmt_client *client, const uint8_t *data,
 		}
 
 		offset_before_send = active_client->upload.offset;
-		nb->len = zse->payload - nb->data;
 		k_sem_reset(&mcumgr_img_client_grp_sem);
 
 		image_upload_buf->status = MGMT_ERR_EINVAL;
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Internet checksum computed while the data is copied, so that the payload
+ * of a packet is read only once when it is moved between the application
+ * buffers and the network buffers.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/toolchain.h>
+#include <zephyr/sys/util.h>
+#include <string.h>
+
+#include "net_private.h"
+
+#ifdef CONFIG_LITTLE_ENDIAN
+#define CHECKSUM_BIG_ENDIAN 0
+#else
+#define CHECKSUM_BIG_ENDIAN 1
+#endif
+
+static uint16_t offset_based_swap8(const uint8_t *data)
+{
+	uint16_t data16 = (uint16_t)*data;
+
+	if (((uintptr_t)(data) & 1) == CHECKSUM_BIG_ENDIAN) {
+		return data16;
+	} else {
+		return data16 << 8;
+	}
+}
+
+/* Add a ones' complement sum of 64-bit words to a sum of 32-bit words */
+static inline uint64_t chksum_add64(uint64_t sum, uint64_t sum64)
+{
+	sum64 = (sum64 & 0xffffffff) + (sum64 >> 32);
+
+	return sum + sum64;
+}
+
+#if defined(CONFIG_X86_64)
+/* Copy and sum 64 bytes per iteration. The carry stays chained through CF
+ * over the whole loop, neither lea nor dec touch it, and goes back into the
+ * sum once at the end, which gives the ones' complement sum of the 64-bit
+ * words.
+ */
+static size_t chksum_copy_words(uint8_t *dst, const uint8_t *src, size_t len,
+				uint64_t *sum)
+{
+	size_t blocks = len / 64;
+	uint64_t sum64 = 0;
+
+	if (blocks == 0) {
+		return 0;
+	}
+
+	__asm__ volatile(
+		"clc\n\t"
+		"1:\n\t"
+		"movq 0(%[src]), %%r8\n\t"
+		"movq 8(%[src]), %%r9\n\t"
+		"movq 16(%[src]), %%r10\n\t"
+		"movq 24(%[src]), %%r11\n\t"
+		"adcq %%r8, %[sum]\n\t"
+		"adcq %%r9, %[sum]\n\t"
+		"adcq %%r10, %[sum]\n\t"
+		"adcq %%r11, %[sum]\n\t"
+		"movq %%r8, 0(%[dst])\n\t"
+		"movq %%r9, 8(%[dst])\n\t"
+		"movq %%r10, 16(%[dst])\n\t"
+		"movq %%r11, 24(%[dst])\n\t"
+		"movq 32(%[src]), %%r8\n\t"
+		"movq 40(%[src]), %%r9\n\t"
+		"movq 48(%[src]), %%r10\n\t"
+		"movq 56(%[src]), %%r11\n\t"
+		"adcq %%r8, %[sum]\n\t"
+		"adcq %%r9, %[sum]\n\t"
+		"adcq %%r10, %[sum]\n\t"
+		"adcq %%r11, %[sum]\n\t"
+		"movq %%r8, 32(%[dst])\n\t"
+		"movq %%r9, 40(%[dst])\n\t"
+		"movq %%r10, 48(%[dst])\n\t"
+		"movq %%r11, 56(%[dst])\n\t"
+		"leaq 64(%[src]), %[src]\n\t"
+		"leaq 64(%[dst]), %[dst]\n\t"
+		"decq %[blocks]\n\t"
+		"jnz 1b\n\t"
+		"adcq $0, %[sum]\n\t"
+		"adcq $0, %[sum]\n\t"
+		: [sum] "+r" (sum64), [src] "+r" (src), [dst] "+r" (dst),
+		  [blocks] "+r" (blocks)
+		:
+		: "r8", "r9", "r10", "r11", "cc", "memory");
+
+	*sum = chksum_add64(*sum, sum64);
+
+	return len & ~(size_t)63;
+}
+#elif defined(CONFIG_ARMV7_M_ARMV8_M_MAINLINE)
+/* Copy and sum 16 bytes per iteration. Single word loads and stores do not
+ * need to be aligned on these cores, the destination alignment does not
+ * matter. The loop ends on teq, which leaves C alone, so the carry stays
+ * chained over the whole loop and goes back into the sum once at the end.
+ */
+static size_t chksum_copy_words(uint8_t *dst, const uint8_t *src, size_t len,
+				uint64_t *sum)
+{
+	size_t blocks = len / 16;
+	const uint8_t *end = src + blocks * 16;
+	uint32_t sum32 = 0;
+	uint32_t a, b, c, d;
+
+	if (blocks == 0) {
+		return 0;
+	}
+
+	__asm__ volatile(
+		"cmn %[sum], #0\n\t"
+		"1:\n\t"
+		"ldr %[a], [%[src]], #4\n\t"
+		"ldr %[b], [%[src]], #4\n\t"
+		"ldr %[c], [%[src]], #4\n\t"
+		"ldr %[d], [%[src]], #4\n\t"
+		"adcs %[sum], %[sum], %[a]\n\t"
+		"adcs %[sum], %[sum], %[b]\n\t"
+		"adcs %[sum], %[sum], %[c]\n\t"
+		"adcs %[sum], %[sum], %[d]\n\t"
+		"str %[a], [%[dst]], #4\n\t"
+		"str %[b], [%[dst]], #4\n\t"
+		"str %[c], [%[dst]], #4\n\t"
+		"str %[d], [%[dst]], #4\n\t"
+		"teq %[src], %[end]\n\t"
+		"bne 1b\n\t"
+		"adcs %[sum], %[sum], #0\n\t"
+		"adc %[sum], %[sum], #0\n\t"
+		: [sum] "+r" (sum32), [src] "+r" (src), [dst] "+r" (dst),
+		  [a] "=&r" (a), [b] "=&r" (b), [c] "=&r" (c), [d] "=&r" (d)
+		: [end] "r" (end)
+		: "cc", "memory");
+
+	*sum += sum32;
+
+	return len & ~(size_t)15;
+}
+#else
+/* Copy and sum 16 bytes per iteration, in two independent sums */
+static size_t chksum_copy_words(uint8_t *dst, const uint8_t *src, size_t len,
+				uint64_t *sum)
+{
+	const uint32_t *p = (const uint32_t *)src;
+	size_t done = 0;
+
+	while (len - done >= sizeof(uint32_t) * 4) {
+		uint32_t w0 = p[0];
+		uint32_t w1 = p[1];
+		uint32_t w2 = p[2];
+		uint32_t w3 = p[3];
+		uint64_t sum_a = (uint64_t)w0 + w2;
+		uint64_t sum_b = (uint64_t)w1 + w3;
+
+		UNALIGNED_PUT(w0, (uint32_t *)(dst + done));
+		UNALIGNED_PUT(w1, (uint32_t *)(dst + done + 4));
+		UNALIGNED_PUT(w2, (uint32_t *)(dst + done + 8));
+		UNALIGNED_PUT(w3, (uint32_t *)(dst + done + 12));
+
+		*sum += sum_a + sum_b;
+		p += 4;
+		done += sizeof(uint32_t) * 4;
+	}
+
+	return done;
+}
+#endif
+
+/* Same as calc_chksum(), the bytes being copied to dst while they are summed.
+ * The work is aligned on the source, the destination can have any alignment.
+ */
+uint16_t calc_chksum_copy(uint16_t sum_in, uint8_t *dst, const uint8_t *src, size_t len)
+{
+	int odd_start = ((uintptr_t)src & 0x01);
+	size_t pending = len;
+	uint64_t sum;
+	size_t done;
+
+	/* Sum in is in host endianness, working order endianness is both dependent on endianness
+	 * and the offset of starting
+	 */
+	if (odd_start == CHECKSUM_BIG_ENDIAN) {
+		sum = BSWAP_16(sum_in);
+	} else {
+		sum = sum_in;
+	}
+
+	if ((((uintptr_t)src & 0x01) != 0) && (pending >= 1)) {
+		sum += offset_based_swap8(src);
+		*dst++ = *src++;
+		pending--;
+	}
+	if ((((uintptr_t)src & 0x02) != 0) && (pending >= sizeof(uint16_t))) {
+		uint16_t w = *(const uint16_t *)src;
+
+		sum += w;
+		UNALIGNED_PUT(w, (uint16_t *)dst);
+		src += sizeof(uint16_t);
+		dst += sizeof(uint16_t);
+		pending -= sizeof(uint16_t);
+	}
+
+	done = chksum_copy_words(dst, src, pending, &sum);
+	src += done;
+	dst += done;
+	pending -= done;
+
+	while (pending >= sizeof(uint32_t)) {
+		uint32_t w = *(const uint32_t *)src;
+
+		sum += w;
+		UNALIGNED_PUT(w, (uint32_t *)dst);
+		src += sizeof(uint32_t);
+		dst += sizeof(uint32_t);
+		pending -= sizeof(uint32_t);
+	}
+	if (pending >= 2) {
+		uint16_t w = *(const uint16_t *)src;
+
+		sum += w;
+		UNALIGNED_PUT(w, (uint16_t *)dst);
+		src += sizeof(uint16_t);
+		dst += sizeof(uint16_t);
+		pending -= sizeof(uint16_t);
+	}
+	if (pending == 1) {
+		sum += offset_based_swap8(src);
+		*dst = *src;
+	}
+
+	/* Fold sum into 16-bit word. */
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	if (odd_start == CHECKSUM_BIG_ENDIAN) {
+		return BSWAP_16((uint16_t)sum);
+	} else {
+		return sum;
+	}
+}
@@ -691,6 +691,7 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 	struct net_conn *conn;
 	net_conn_cb_t cb = NULL;
 	void *user_data = NULL;
+	bool chksum_on_copy = false;
 
 	if (IS_ENABLED(CONFIG_NET_IP)) {
 		/* If we receive a packet with multicast destination address, we might
@@ -708,6 +709,14 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
+	/* The packet may be delivered to several connections, the checksum
+	 * left to the receiver is verified once, here.
+	 */
+	if (net_pkt_is_chksum_pending(pkt) && (is_mcast_pkt || is_bcast_pkt) &&
+	    net_udp_verify_pending_chksum(pkt) < 0) {
+		goto drop;
+	}
+
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
 	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
@@ -881,10 +890,18 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 	if (best_match) {
 		cb = best_match->cb;
 		user_data = best_match->user_data;
+		chksum_on_copy = best_match->context != NULL &&
+				 net_context_is_chksum_on_copy(best_match->context);
 	}
 
 	k_mutex_unlock(&conn_lock);
 
+	/* Only a socket verifies the checksum while it reads the data */
+	if (net_pkt_is_chksum_pending(pkt) && !chksum_on_copy &&
+	    net_udp_verify_pending_chksum(pkt) < 0) {
+		goto drop;
+	}
+
 	if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) && pkt_family == AF_PACKET) {
 		if (raw_pkt_continue) {
 			/* When there is open connection different than
@@ -442,6 +442,10 @@ enum net_verdict net_ipv4_input(struct net_pkt *pkt, bool is_loopback)
 
 	ip.ipv4 = hdr;
 
+	if (hdr->proto == IPPROTO_TCP && net_tcp_gro_receive(pkt)) {
+		return NET_OK;
+	}
+
 	verdict = net_conn_input(pkt, &ip, hdr->proto, &proto_hdr);
 	if (verdict != NET_DROP) {
 		return verdict;
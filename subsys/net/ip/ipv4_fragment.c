@@ -624,9 +624,9 @@ enum net_verdict net_ipv4_prepare_for_send_fragment(struct net_pkt *pkt)
 	}
 
 	/* If we have already fragmented the packet, the ID field will contain a non-zero value
-	 * and we can skip other checks.
+	 * and we can skip other checks. A TSO packet is cut into segments fitting the MTU.
 	 */
-	if (ip_hdr->id[0] == 0 && ip_hdr->id[1] == 0) {
+	if (ip_hdr->id[0] == 0 && ip_hdr->id[1] == 0 && net_pkt_tso_size(pkt) == 0) {
 		size_t pkt_len = net_pkt_get_len(pkt);
 		uint16_t mtu;
 
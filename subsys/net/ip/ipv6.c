@@ -818,6 +818,10 @@ enum net_verdict net_ipv6_input(struct net_pkt *pkt, bool is_loopback)
 
 	ip.ipv6 = hdr;
 
+	if (current_hdr == IPPROTO_TCP && net_tcp_gro_receive(pkt)) {
+		return NET_OK;
+	}
+
 	verdict = net_conn_input(pkt, &ip, current_hdr, &proto_hdr);
 
 	NET_DBG("%s verdict %s", "Connection", net_verdict2str(verdict));
@@ -2034,11 +2034,15 @@ static int get_context_local_port_range(struct net_context *context,
 }
 
 /* If buf is not NULL, then use it. Otherwise read the data to be written
- * to net_pkt from msghdr.
+ * to net_pkt from msghdr. With chksum, the data is summed while it is
+ * written, for the transport checksum.
  */
 static int context_write_data(struct net_pkt *pkt, const void *buf,
-			      int buf_len, const struct msghdr *msghdr)
+			      int buf_len, const struct msghdr *msghdr,
+			      bool chksum)
 {
+	int (*pkt_write)(struct net_pkt *pkt, const void *data, size_t length) =
+		chksum ? net_pkt_write_chksum : net_pkt_write;
 	int ret = 0;
 
 	if (msghdr) {
@@ -2047,8 +2051,7 @@ static int context_write_data(struct net_pkt *pkt, const void *buf,
 		for (i = 0; i < msghdr->msg_iovlen; i++) {
 			int len = MIN(msghdr->msg_iov[i].iov_len, buf_len);
 
-			ret = net_pkt_write(pkt, msghdr->msg_iov[i].iov_base,
-					    len);
+			ret = pkt_write(pkt, msghdr->msg_iov[i].iov_base, len);
 			if (ret < 0) {
 				break;
 			}
@@ -2059,7 +2062,7 @@ static int context_write_data(struct net_pkt *pkt, const void *buf,
 			}
 		}
 	} else {
-		ret = net_pkt_write(pkt, buf, buf_len);
+		ret = pkt_write(pkt, buf, buf_len);
 	}
 
 	return ret;
@@ -2110,7 +2113,8 @@ static int context_setup_udp_packet(struct net_context *context,
 		return ret;
 	}
 
-	ret = context_write_data(pkt, buf, len, msg);
+	ret = context_write_data(pkt, buf, len, msg,
+				 IS_ENABLED(CONFIG_NET_CHKSUM_COPY));
 	if (ret) {
 		return ret;
 	}
@@ -2519,7 +2523,7 @@ static int context_sendto(struct net_context *context,
 skip_alloc:
 	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
 	    net_if_is_ip_offloaded(net_context_get_iface(context))) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, false);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2557,7 +2561,7 @@ skip_alloc:
 
 		ret = net_tcp_send_data(context, cb, user_data);
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) && family == AF_PACKET) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, false);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2613,7 +2617,7 @@ skip_alloc:
 		}
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_CAN) && family == AF_CAN &&
 		   net_context_get_proto(context) == CAN_RAW) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, false);
 		if (ret < 0) {
 			goto fail;
 		}
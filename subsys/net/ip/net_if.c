@@ -35,6 +35,7 @@ LOG_MODULE_REGISTER(net_if, CONFIG_NET_IF_LOG_LEVEL);
 #include "net_private.h"
 #include "ipv4.h"
 #include "ipv6.h"
+#include "tcp_internal.h"
 
 #include "net_stats.h"
 
@@ -213,6 +214,10 @@ static void update_txtime_stats_detail(struct net_pkt *pkt,
 	}
 }
 
+#if defined(CONFIG_NET_TCP_TSO)
+static bool net_if_tx_segments(struct net_if *iface, struct net_pkt *pkt);
+#endif
+
 static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 {
 	struct net_linkaddr ll_dst = { 0 };
@@ -227,6 +232,12 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 		return false;
 	}
 
+#if defined(CONFIG_NET_TCP_TSO)
+	if (net_pkt_tso_size(pkt) > 0 && net_if_need_tx_segmentation(iface)) {
+		return net_if_tx_segments(iface, pkt);
+	}
+#endif
+
 	create_time = net_pkt_create_time(pkt);
 
 	debug_check_packet(pkt);
@@ -322,6 +333,35 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 	return true;
 }
 
+#if defined(CONFIG_NET_TCP_TSO)
+/* Send a TCP packet carrying several segments one segment at a time, the
+ * device not being able to cut it itself.
+ */
+static bool net_if_tx_segments(struct net_if *iface, struct net_pkt *pkt)
+{
+	struct net_pkt *seg;
+	size_t offset = 0;
+	int ret;
+
+	do {
+		ret = net_tcp_tso_segment(pkt, &offset, &seg);
+		if (seg != NULL) {
+			(void)net_if_tx(iface, seg);
+		}
+	} while (seg != NULL);
+
+	if (ret < 0) {
+		/* The segments not sent are lost, TCP sends them again */
+		NET_DBG("iface %p cannot segment pkt %p (%d)", iface, pkt, ret);
+		net_context_send_cb(net_pkt_context(pkt), ret);
+	}
+
+	net_pkt_unref(pkt);
+
+	return true;
+}
+#endif /* CONFIG_NET_TCP_TSO */
+
 void net_process_tx_packet(struct net_pkt *pkt)
 {
 	struct net_if *iface;
@@ -5508,6 +5548,28 @@ bool net_if_need_calc_rx_checksum(struct net_if *iface, enum net_if_checksum_typ
 	return need_calc_checksum(iface, ETHERNET_HW_RX_CHKSUM_OFFLOAD, chksum_type);
 }
 
+bool net_if_need_tx_segmentation(struct net_if *iface)
+{
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET)) {
+		if (IS_ENABLED(CONFIG_NET_VLAN) && net_eth_is_vlan_interface(iface)) {
+			iface = net_eth_get_vlan_main(iface);
+			if (iface == NULL) {
+				return true;
+			}
+		} else {
+			return true;
+		}
+	}
+
+	return !(net_eth_get_hw_capabilities(iface) & ETHERNET_HW_TX_TSO);
+#else
+	ARG_UNUSED(iface);
+
+	return true;
+#endif
+}
+
 int net_if_get_by_iface(struct net_if *iface)
 {
 	if (!(iface >= _net_if_list_start && iface < _net_if_list_end)) {
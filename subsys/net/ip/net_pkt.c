@@ -1886,6 +1886,91 @@ static int net_pkt_cursor_operate(struct net_pkt *pkt,
 	return 0;
 }
 
+#if defined(CONFIG_NET_CHKSUM_COPY)
+/* Add the checksum of the len bytes at src to the partial checksum of the
+ * packet, copying them to dst unless it is NULL.
+ */
+static void pkt_chksum_add(struct net_pkt *pkt, uint8_t *dst, const uint8_t *src,
+			   size_t len)
+{
+	bool odd = (pkt->chksum_partial_len & 0x01) != 0;
+	uint16_t sum = pkt->chksum_partial;
+
+	/* Bytes starting at an odd offset are swapped in the 16-bit words */
+	if (odd) {
+		sum = BSWAP_16(sum);
+	}
+
+	if (dst != NULL) {
+		sum = calc_chksum_copy(sum, dst, src, len);
+	} else {
+		sum = calc_chksum(sum, src, len);
+	}
+
+	if (odd) {
+		sum = BSWAP_16(sum);
+	}
+
+	pkt->chksum_partial = sum;
+	pkt->chksum_partial_len += len;
+}
+
+static int net_pkt_cursor_chksum_operate(struct net_pkt *pkt,
+					 void *data, size_t length,
+					 bool write)
+{
+	struct net_pkt_cursor *c_op = &pkt->cursor;
+
+	while (c_op->buf && length) {
+		size_t d_len, len;
+
+		pkt_cursor_advance(pkt, net_pkt_is_being_overwritten(pkt) ?
+				   false : write);
+		if (c_op->buf == NULL) {
+			break;
+		}
+
+		if (write && !net_pkt_is_being_overwritten(pkt)) {
+			d_len = net_buf_max_len(c_op->buf) -
+				(c_op->pos - c_op->buf->data);
+		} else {
+			d_len = c_op->buf->len - (c_op->pos - c_op->buf->data);
+		}
+
+		if (!d_len) {
+			break;
+		}
+
+		len = MIN(length, d_len);
+
+		if (write) {
+			pkt_chksum_add(pkt, c_op->pos, data, len);
+		} else {
+			pkt_chksum_add(pkt, data, c_op->pos, len);
+		}
+
+		if (write && !net_pkt_is_being_overwritten(pkt)) {
+			net_buf_add(c_op->buf, len);
+		}
+
+		pkt_cursor_update(pkt, len, write);
+
+		if (data) {
+			data = (uint8_t *) data + len;
+		}
+
+		length -= len;
+	}
+
+	if (length) {
+		NET_DBG("Still some length to go %zu", length);
+		return -ENOBUFS;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_NET_CHKSUM_COPY */
+
 int net_pkt_skip(struct net_pkt *pkt, size_t skip)
 {
 	NET_DBG("pkt %p skip %zu", pkt, skip);
@@ -1907,6 +1992,17 @@ int net_pkt_read(struct net_pkt *pkt, void *data, size_t length)
 	return net_pkt_cursor_operate(pkt, data, length, true, false);
 }
 
+int net_pkt_read_chksum(struct net_pkt *pkt, void *data, size_t length)
+{
+	NET_DBG("pkt %p data %p length %zu", pkt, data, length);
+
+#if defined(CONFIG_NET_CHKSUM_COPY)
+	return net_pkt_cursor_chksum_operate(pkt, data, length, false);
+#else
+	return net_pkt_read(pkt, data, length);
+#endif
+}
+
 int net_pkt_read_be16(struct net_pkt *pkt, uint16_t *data)
 {
 	uint8_t d16[2];
@@ -1954,6 +2050,17 @@ int net_pkt_write(struct net_pkt *pkt, const void *data, size_t length)
 	return net_pkt_cursor_operate(pkt, (void *)data, length, true, true);
 }
 
+int net_pkt_write_chksum(struct net_pkt *pkt, const void *data, size_t length)
+{
+	NET_DBG("pkt %p data %p length %zu", pkt, data, length);
+
+#if defined(CONFIG_NET_CHKSUM_COPY)
+	return net_pkt_cursor_chksum_operate(pkt, (void *)data, length, true);
+#else
+	return net_pkt_write(pkt, data, length);
+#endif
+}
+
 int net_pkt_copy(struct net_pkt *pkt_dst,
 		 struct net_pkt *pkt_src,
 		 size_t length)
@@ -2007,6 +2114,55 @@ int net_pkt_copy(struct net_pkt *pkt_dst,
 	return 0;
 }
 
+int net_pkt_copy_chksum(struct net_pkt *pkt_dst,
+			struct net_pkt *pkt_src,
+			size_t length)
+{
+#if defined(CONFIG_NET_CHKSUM_COPY)
+	struct net_pkt_cursor *c_dst = &pkt_dst->cursor;
+	struct net_pkt_cursor *c_src = &pkt_src->cursor;
+
+	while (c_dst->buf && c_src->buf && length) {
+		size_t s_len, d_len, len;
+
+		pkt_cursor_advance(pkt_dst, true);
+		pkt_cursor_advance(pkt_src, false);
+
+		if (!c_dst->buf || !c_src->buf) {
+			break;
+		}
+
+		s_len = c_src->buf->len - (c_src->pos - c_src->buf->data);
+		d_len = net_buf_max_len(c_dst->buf) - (c_dst->pos - c_dst->buf->data);
+		len = MIN(length, MIN(s_len, d_len));
+
+		if (!len) {
+			break;
+		}
+
+		pkt_chksum_add(pkt_dst, c_dst->pos, c_src->pos, len);
+
+		if (!net_pkt_is_being_overwritten(pkt_dst)) {
+			net_buf_add(c_dst->buf, len);
+		}
+
+		pkt_cursor_update(pkt_dst, len, true);
+		pkt_cursor_update(pkt_src, len, false);
+
+		length -= len;
+	}
+
+	if (length) {
+		NET_DBG("Still some length to go %zu", length);
+		return -ENOBUFS;
+	}
+
+	return 0;
+#else
+	return net_pkt_copy(pkt_dst, pkt_src, length);
+#endif
+}
+
 #if defined(NET_PKT_HAS_CONTROL_BLOCK)
 static inline void clone_pkt_cb(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 {
@@ -2041,6 +2197,7 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_rx_timestamping(clone_pkt, net_pkt_is_rx_timestamping(pkt));
 	net_pkt_set_forwarding(clone_pkt, net_pkt_forwarding(pkt));
 	net_pkt_set_chksum_done(clone_pkt, net_pkt_is_chksum_done(pkt));
+	net_pkt_set_tso_size(clone_pkt, net_pkt_tso_size(pkt));
 	net_pkt_set_ip_reassembled(pkt, net_pkt_is_ip_reassembled(pkt));
 	net_pkt_set_cooked_mode(clone_pkt, net_pkt_is_cooked_mode(pkt));
 	net_pkt_set_ipv4_pmtu(clone_pkt, net_pkt_ipv4_pmtu(pkt));
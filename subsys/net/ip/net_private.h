@@ -279,6 +279,10 @@ extern char *net_byte_to_hex(char *ptr, uint8_t byte, char base, bool pad);
 extern char *net_sprint_ll_addr_buf(const uint8_t *ll, uint8_t ll_len,
 				    char *buf, int buflen);
 extern uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len);
+#if defined(CONFIG_NET_CHKSUM_COPY)
+extern uint16_t calc_chksum_copy(uint16_t sum_in, uint8_t *dst, const uint8_t *src,
+				 size_t len);
+#endif
 extern uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto);
 
 /**
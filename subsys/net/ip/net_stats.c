@@ -170,6 +170,13 @@ static inline void stats(struct net_if *iface)
 		NET_INFO("TCP conn drop  %d\tconnrst\t%d",
 			 GET_STAT(iface, tcp.conndrop),
 			 GET_STAT(iface, tcp.connrst));
+		NET_INFO("TCP fast rexmt %d\trto\t%d",
+			 GET_STAT(iface, tcp.fast_rexmit),
+			 GET_STAT(iface, tcp.rto));
+		NET_INFO("TCP last cwnd  %u\tssthresh %u\trtt\t%u ms",
+			 GET_STAT(iface, tcp.cwnd),
+			 GET_STAT(iface, tcp.ssthresh),
+			 GET_STAT(iface, tcp.rtt));
 #endif
 
 		NET_INFO("Bytes received %u", GET_STAT(iface, bytes.received));
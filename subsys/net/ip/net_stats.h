@@ -304,6 +304,24 @@ static inline void net_stats_update_tcp_seg_rexmit(struct net_if *iface)
 {
 	UPDATE_STAT(iface, stats.tcp.rexmit++);
 }
+
+static inline void net_stats_update_tcp_fast_rexmit(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.tcp.fast_rexmit++);
+}
+
+static inline void net_stats_update_tcp_rto(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.tcp.rto++);
+}
+
+static inline void net_stats_update_tcp_ca(struct net_if *iface, uint32_t cwnd,
+					   uint32_t ssthresh, uint32_t rtt)
+{
+	UPDATE_STAT(iface, stats.tcp.cwnd = cwnd);
+	UPDATE_STAT(iface, stats.tcp.ssthresh = ssthresh);
+	UPDATE_STAT(iface, stats.tcp.rtt = rtt);
+}
 #else
 #define net_stats_update_tcp_sent(iface, bytes)
 #define net_stats_update_tcp_resent(iface, bytes)
@@ -319,6 +337,9 @@ static inline void net_stats_update_tcp_seg_rexmit(struct net_if *iface)
 #define net_stats_update_tcp_seg_ackerr(iface)
 #define net_stats_update_tcp_seg_rsterr(iface)
 #define net_stats_update_tcp_seg_rexmit(iface)
+#define net_stats_update_tcp_fast_rexmit(iface)
+#define net_stats_update_tcp_rto(iface)
+#define net_stats_update_tcp_ca(iface, cwnd, ssthresh, rtt)
 #endif /* CONFIG_NET_STATISTICS_TCP */
 
 static inline void net_stats_update_per_proto_recv(struct net_if *iface,
@@ -12,6 +12,7 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #include <stdlib.h>
 #include <zephyr/kernel.h>
 #include <zephyr/random/random.h>
+#include <zephyr/sys/byteorder.h>
 
 #if defined(CONFIG_NET_TCP_ISN_RFC6528)
 #include <psa/crypto.h>
@@ -19,6 +20,7 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_context.h>
 #include <zephyr/net/udp.h>
+#include <zephyr/net/socket.h>
 #include "ipv4.h"
 #include "ipv6.h"
 #include "connection.h"
@@ -59,14 +61,18 @@ static int tcp_tx_window =
 	CONFIG_NET_PKT_BUF_TX_DATA_POOL_SIZE / 3;
 #endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
 #endif
-#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_TIMESTAMPS)
 #define TCP_RTO_MS (conn->rto)
 #else
 #define TCP_RTO_MS (tcp_rto)
 #endif
+#define TCP_RTO_MAX_MS 60000
+
+/* Length of the timestamps option with the NOPs aligning it */
+#define TCP_TS_OPT_LEN (2 * NET_TCP_NOP_SIZE + NET_TCP_TIMESTAMP_SIZE)
 
 /* Define the number of MSS sections the congestion window is initialized at */
-#define TCP_CONGESTION_INITIAL_WIN 1
+#define TCP_CONGESTION_INITIAL_WIN CONFIG_NET_TCP_CONGESTION_INITIAL_WINDOW
 #define TCP_CONGESTION_INITIAL_SSTHRESH 3
 
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
@@ -421,11 +427,23 @@ out:
 
 static void tcp_derive_rto(struct tcp *conn)
 {
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_TIMESTAMPS)
+	uint32_t rto = (uint32_t)tcp_rto;
 #ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
-	/* Compute a randomized rto 1 and 1.5 times tcp_rto */
 	uint32_t gain;
 	uint8_t gain8;
-	uint32_t rto;
+#endif
+
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	if (conn->srtt != 0) {
+		/* RFC 6298, SRTT + 4 * RTTVAR but not less than tcp_rto */
+		rto = CLAMP((conn->srtt >> 3) + conn->rttvar, (uint32_t)tcp_rto,
+			    TCP_RTO_MAX_MS);
+	}
+#endif
+
+#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
+	/* Compute a randomized rto 1 and 1.5 times rto */
 
 	/* Getting random is computational expensive, so only use 8 bits */
 	sys_rand_get(&gain8, sizeof(uint8_t));
@@ -433,33 +451,139 @@ static void tcp_derive_rto(struct tcp *conn)
 	gain = (uint32_t)gain8;
 	gain += 1 << 9;
 
-	rto = (uint32_t)tcp_rto;
 	rto = (gain * rto) >> 9;
-	conn->rto = (uint16_t)rto;
+#endif
+	conn->rto = (uint16_t)MIN(rto, UINT16_MAX);
 #else
 	ARG_UNUSED(conn);
 #endif
 }
 
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+
+static uint32_t tcp_ts_now(struct tcp *conn)
+{
+	return k_uptime_get_32() + conn->ts_offset;
+}
+
+/* Keep the timestamp to echo, RFC 7323 ch 4.3 */
+static void tcp_ts_recent_update(struct tcp *conn, struct tcphdr *th)
+{
+	if (conn->ts_ok && conn->recv_options.ts_found &&
+	    !net_tcp_seq_greater(th_seq(th), conn->ack)) {
+		conn->ts_recent = conn->recv_options.tsval;
+	}
+}
+
+#else /* CONFIG_NET_TCP_TIMESTAMPS */
+
+#define tcp_ts_recent_update(...)
+
+#endif /* CONFIG_NET_TCP_TIMESTAMPS */
+
+#ifdef CONFIG_NET_TCP_RTT_ESTIMATION
+
+/* Smooth the round trip times measured, as described in RFC 6298 */
+static void tcp_rtt_sample(struct tcp *conn, int32_t rtt)
+{
+	int32_t delta;
+
+	if (rtt < 0 || rtt > TCP_RTO_MAX_MS) {
+		/* Not a time of ours */
+		return;
+	}
+
+	rtt = MAX(rtt, 1);
+
+	if (conn->srtt == 0) {
+		conn->srtt = rtt << 3;
+		conn->rttvar = rtt << 1;
+	} else {
+		delta = rtt - (int32_t)(conn->srtt >> 3);
+		conn->srtt += delta;
+		if (delta < 0) {
+			delta = -delta;
+		}
+		conn->rttvar += delta - (conn->rttvar >> 2);
+	}
+
+	NET_DBG("conn: %p rtt=%d, srtt=%u, rttvar=%u", conn, rtt,
+		conn->srtt >> 3, conn->rttvar >> 2);
+
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	if (conn->ca.ops->rtt_sample != NULL) {
+		conn->ca.ops->rtt_sample(conn, rtt);
+	}
+#endif
 
-/* Implementation according to RFC6582 */
+	tcp_derive_rto(conn);
+}
 
-static void tcp_new_reno_log(struct tcp *conn, char *step)
+/* Without timestamps, time one segment per round trip. A retransmission
+ * cancels the measurement, as its acknowledgment may be for either
+ * transmission (Karn's algorithm).
+ */
+static void tcp_rtt_start(struct tcp *conn, uint32_t end)
 {
-	NET_DBG("conn: %p, ca %s, cwnd=%d, ssthres=%d, fast_pend=%i",
-		conn, step, conn->ca.cwnd, conn->ca.ssthresh,
-		conn->ca.pending_fast_retransmit_bytes);
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	if (conn->ts_ok) {
+		return;
+	}
+#endif
+
+	if (!conn->rtt_timing) {
+		conn->rtt_timing = true;
+		conn->rtt_seq = end;
+		conn->rtt_start = k_uptime_get_32();
+	}
 }
 
-static void tcp_new_reno_init(struct tcp *conn)
+static void tcp_rtt_cancel(struct tcp *conn)
 {
-	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
-	conn->ca.ssthresh = conn_mss(conn) * TCP_CONGESTION_INITIAL_SSTHRESH;
-	conn->ca.pending_fast_retransmit_bytes = 0;
-	tcp_new_reno_log(conn, "init");
+	conn->rtt_timing = false;
+}
+
+/* Take a round trip time measurement when data up to ack is acknowledged,
+ * from the timestamp echoed by the peer if there is one, RFC 7323 ch 4.
+ */
+static void tcp_rtt_update(struct tcp *conn, uint32_t ack)
+{
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	if (conn->ts_ok) {
+		if (conn->recv_options.ts_found && conn->recv_options.tsecr != 0) {
+			tcp_rtt_sample(conn, (int32_t)(tcp_ts_now(conn) -
+						      conn->recv_options.tsecr));
+		}
+
+		return;
+	}
+#endif
+
+	if (conn->rtt_timing && !net_tcp_seq_greater(conn->rtt_seq, ack)) {
+		conn->rtt_timing = false;
+		tcp_rtt_sample(conn, (int32_t)(k_uptime_get_32() - conn->rtt_start));
+	}
 }
 
+/* Smoothed round trip time, 0 until one was measured */
+static uint32_t tcp_srtt(struct tcp *conn)
+{
+	return conn->srtt >> 3;
+}
+
+#else /* CONFIG_NET_TCP_RTT_ESTIMATION */
+
+#define tcp_rtt_start(...)
+#define tcp_rtt_cancel(...)
+#define tcp_rtt_update(...)
+#define tcp_srtt(...) 0
+
+#endif /* CONFIG_NET_TCP_RTT_ESTIMATION */
+
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+
+/* Implementation according to RFC6582 */
+
 static void tcp_new_reno_fast_retransmit(struct tcp *conn)
 {
 	if (conn->ca.pending_fast_retransmit_bytes == 0) {
@@ -467,7 +591,6 @@ static void tcp_new_reno_fast_retransmit(struct tcp *conn)
 		/* Account for the lost segments */
 		conn->ca.cwnd = conn_mss(conn) * 3 + conn->ca.ssthresh;
 		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
-		tcp_new_reno_log(conn, "fast_retransmit");
 	}
 }
 
@@ -475,17 +598,34 @@ static void tcp_new_reno_timeout(struct tcp *conn)
 {
 	conn->ca.ssthresh = MAX(conn_mss(conn) * 2, conn->unacked_len / 2);
 	conn->ca.cwnd = conn_mss(conn);
-	tcp_new_reno_log(conn, "timeout");
 }
 
 /* For every duplicate ack increment the cwnd by mss */
-static void tcp_new_reno_dup_ack(struct tcp *conn)
+void tcp_new_reno_dup_ack(struct tcp *conn)
 {
 	int32_t new_win = conn->ca.cwnd;
 
 	new_win += conn_mss(conn);
-	conn->ca.cwnd = MIN(new_win, UINT16_MAX);
-	tcp_new_reno_log(conn, "dup_ack");
+	conn->ca.cwnd = MIN(new_win, TCP_WIN_MAX);
+}
+
+bool tcp_new_reno_recovery(struct tcp *conn, uint32_t acked_len)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		return false;
+	}
+
+	/* Check if it is still in fast recovery mode */
+	if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
+		conn->ca.pending_fast_retransmit_bytes = 0;
+		conn->ca.cwnd = conn->ca.ssthresh;
+	} else {
+		conn->ca.pending_fast_retransmit_bytes -= acked_len;
+		/* Deflate the window, but keep one segment in flight */
+		conn->ca.cwnd -= MIN(acked_len, conn->ca.cwnd - MIN(conn->ca.cwnd, conn_mss(conn)));
+	}
+
+	return true;
 }
 
 static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
@@ -493,51 +633,152 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 	int32_t new_win = conn->ca.cwnd;
 	int32_t win_inc = MIN(acked_len, conn_mss(conn));
 
-	if (conn->ca.pending_fast_retransmit_bytes == 0) {
-		if (conn->ca.cwnd < conn->ca.ssthresh) {
-			new_win += win_inc;
-		} else {
-			/* Implement a div_ceil	to avoid rounding to 0 */
-			new_win += ((win_inc * win_inc) + conn->ca.cwnd - 1) / conn->ca.cwnd;
-		}
-		conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+	if (tcp_new_reno_recovery(conn, acked_len)) {
+		return;
+	}
+
+	if (conn->ca.cwnd < conn->ca.ssthresh) {
+		new_win += win_inc;
 	} else {
-		/* Check if it is still in fast recovery mode */
-		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
-			conn->ca.pending_fast_retransmit_bytes = 0;
-			conn->ca.cwnd = conn->ca.ssthresh;
-		} else {
-			conn->ca.pending_fast_retransmit_bytes -= acked_len;
-			conn->ca.cwnd -= acked_len;
-		}
+		/* Implement a div_ceil	to avoid rounding to 0 */
+		new_win += ((win_inc * win_inc) + conn->ca.cwnd - 1) / conn->ca.cwnd;
 	}
-	tcp_new_reno_log(conn, "pkts_acked");
+	conn->ca.cwnd = MIN(new_win, TCP_WIN_MAX);
+}
+
+static const struct tcp_ca_ops tcp_new_reno_ops = {
+	.name = "reno",
+	.fast_retransmit = tcp_new_reno_fast_retransmit,
+	.timeout = tcp_new_reno_timeout,
+	.dup_ack = tcp_new_reno_dup_ack,
+	.pkts_acked = tcp_new_reno_pkts_acked,
+};
+
+/* The algorithms TCP_CONGESTION can select */
+static const struct tcp_ca_ops *const tcp_ca_list[] = {
+	&tcp_new_reno_ops,
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+	&tcp_cubic_ops,
+#endif
+#ifdef CONFIG_NET_TCP_CONGESTION_BBR
+	&tcp_bbr_ops,
+#endif
+};
+
+#if defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_CUBIC)
+#define TCP_CA_DEFAULT (&tcp_cubic_ops)
+#elif defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_BBR)
+#define TCP_CA_DEFAULT (&tcp_bbr_ops)
+#else
+#define TCP_CA_DEFAULT (&tcp_new_reno_ops)
+#endif
+
+static void tcp_ca_log(struct tcp *conn, char *step)
+{
+	NET_DBG("conn: %p, ca %s %s, cwnd=%u, ssthres=%u, fast_pend=%u",
+		conn, conn->ca.ops->name, step, conn->ca.cwnd,
+		conn->ca.ssthresh, conn->ca.pending_fast_retransmit_bytes);
+
+	net_stats_update_tcp_ca(conn->iface, conn->ca.cwnd, conn->ca.ssthresh,
+				tcp_srtt(conn));
 }
 
 static void tcp_ca_init(struct tcp *conn)
 {
-	tcp_new_reno_init(conn);
+	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
+	conn->ca.ssthresh = conn_mss(conn) * MAX(TCP_CONGESTION_INITIAL_SSTHRESH,
+						 TCP_CONGESTION_INITIAL_WIN);
+	conn->ca.pending_fast_retransmit_bytes = 0;
+
+	if (conn->ca.ops->init != NULL) {
+		conn->ca.ops->init(conn);
+	}
+
+	tcp_ca_log(conn, "init");
 }
 
 static void tcp_ca_fast_retransmit(struct tcp *conn)
 {
-	tcp_new_reno_fast_retransmit(conn);
+	net_stats_update_tcp_fast_rexmit(conn->iface);
+	conn->ca.ops->fast_retransmit(conn);
+	tcp_ca_log(conn, "fast_retransmit");
 }
 
 static void tcp_ca_timeout(struct tcp *conn)
 {
-	tcp_new_reno_timeout(conn);
+	net_stats_update_tcp_rto(conn->iface);
+	conn->ca.ops->timeout(conn);
+	tcp_ca_log(conn, "timeout");
 }
 
 static void tcp_ca_dup_ack(struct tcp *conn)
 {
-	tcp_new_reno_dup_ack(conn);
+	if (conn->ca.ops->dup_ack != NULL) {
+		conn->ca.ops->dup_ack(conn);
+		tcp_ca_log(conn, "dup_ack");
+	}
 }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len)
 {
-	tcp_new_reno_pkts_acked(conn, acked_len);
+	conn->ca.ops->pkts_acked(conn, acked_len);
+	tcp_ca_log(conn, "pkts_acked");
+}
+
+/* An accepted connection uses the algorithm of the listening one */
+static void tcp_ca_param_copy(struct tcp *to, struct tcp *from)
+{
+	to->ca.ops = from->ca.ops;
+}
+
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
+{
+	size_t name_len;
+
+	if (value == NULL || len == 0) {
+		return -EINVAL;
+	}
+
+	name_len = strnlen(value, MIN(len, TCP_CA_NAME_MAX));
+
+	ARRAY_FOR_EACH(tcp_ca_list, i) {
+		const struct tcp_ca_ops *ops = tcp_ca_list[i];
+
+		if (strlen(ops->name) != name_len ||
+		    strncmp(ops->name, value, name_len) != 0) {
+			continue;
+		}
+
+		conn->ca.ops = ops;
+
+		/* Carry on from the current window when switching algorithm
+		 * on an established connection.
+		 */
+		if (conn->state >= TCP_ESTABLISHED && ops->init != NULL) {
+			ops->init(conn);
+		}
+
+		NET_DBG("conn: %p congestion control %s", conn, ops->name);
+
+		return 0;
+	}
+
+	return -ENOENT;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
+{
+	if (value == NULL || len == NULL || *len == 0) {
+		return -EINVAL;
+	}
+
+	*len = MIN(*len, strlen(conn->ca.ops->name) + 1);
+	memcpy(value, conn->ca.ops->name, *len - 1);
+	((char *)value)[*len - 1] = '\0';
+
+	return 0;
 }
+
 #else
 
 static void tcp_ca_init(struct tcp *conn) { }
@@ -550,6 +791,10 @@ static void tcp_ca_dup_ack(struct tcp *conn) { }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len) { }
 
+#define tcp_ca_param_copy(...)
+#define set_tcp_congestion(...) (-ENOPROTOOPT)
+#define get_tcp_congestion(...) (-ENOPROTOOPT)
+
 #endif
 
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
@@ -1087,10 +1332,19 @@ static uint8_t *tcp_options_get(struct net_pkt *pkt, int tcp_options_len,
 	return buf;
 }
 
+/* Forget the options that only apply to the segment they were received in */
+static void tcp_options_segment_reset(struct tcp_options *recv_options)
+{
+	recv_options->ts_found = false;
+#ifdef CONFIG_NET_TCP_SACK
+	recv_options->sack_count = 0;
+#endif
+}
+
 static bool tcp_options_check(struct tcp_options *recv_options,
 			      struct net_pkt *pkt, ssize_t len)
 {
-	uint8_t options_buf[40]; /* TCP header max options size is 40 */
+	uint8_t options_buf[NET_TCP_MAX_OPT_SIZE];
 	bool result = len > 0 && ((len % 4) == 0) ? true : false;
 	uint8_t *options = tcp_options_get(pkt, len, options_buf,
 					   sizeof(options_buf));
@@ -1098,9 +1352,9 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
-
+	/* The options negotiated in the SYN are kept, as later segments
+	 * normally only carry the timestamps and the SACK blocks.
+	 */
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
 
@@ -1145,9 +1399,48 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
-			recv_options->window = opt;
+			recv_options->window = MIN(options[2],
+						   NET_TCP_MAX_WINDOW_SCALE);
 			recv_options->wnd_found = true;
 			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm_found = true;
+			break;
+#ifdef CONFIG_NET_TCP_SACK
+		case NET_TCP_SACK_OPT:
+			if (((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) != 0) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_count = MIN((opt_len - 2) / NET_TCP_SACK_BLOCK_SIZE,
+						       NET_TCP_MAX_SACK_BLOCKS);
+
+			for (int i = 0; i < recv_options->sack_count; i++) {
+				uint8_t *block = options + 2 + i * NET_TCP_SACK_BLOCK_SIZE;
+
+				recv_options->sack[i].left = sys_get_be32(block);
+				recv_options->sack[i].right = sys_get_be32(block + 4);
+			}
+			break;
+#endif
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+		case NET_TCP_TIMESTAMP_OPT:
+			if (opt_len != NET_TCP_TIMESTAMP_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->tsval = sys_get_be32(options + 2);
+			recv_options->tsecr = sys_get_be32(options + 6);
+			recv_options->ts_found = true;
+			break;
+#endif
 		default:
 			continue;
 		}
@@ -1220,65 +1513,57 @@ static int tcp_update_recv_wnd(struct tcp *conn, int32_t delta)
 	return 0;
 }
 
+/* Append the queued data that follows the in-order data of pkt, up to the
+ * first hole in the queue.
+ */
 static size_t tcp_check_pending_data(struct tcp *conn, struct net_pkt *pkt,
 				     size_t len)
 {
+	uint32_t expected_seq = conn->ack + len;
 	size_t pending_len = 0;
+	struct net_buf *buf;
+	uint32_t seq;
 
-	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT &&
-	    !net_pkt_is_empty(conn->queue_recv_data)) {
-		/* Some potentential cases:
-		 * Note: MI = MAX_INT
-		 * Packet | Queued| End off   | Gap size | Required handling
-		 * Seq|Len|Seq|Len|           |          |
-		 *  3 | 3 | 6 | 4 | 3+3-6=  0 | 6-3-3=0  | Append
-		 *  3 | 4 | 6 | 4 | 3+4-6 = 1 | 6-3-4=-1 | Append, pull from queue
-		 *  3 | 7 | 6 | 4 | 3+7-6 = 4 | 6-3-7=-4 | Drop queued data
-		 *  3 | 8 | 6 | 4 | 3+8-6 = 5 | 6-3-8=-5 | Drop queued data
-		 *  6 | 5 | 6 | 4 | 6+5-6 = 5 | 6-6-5=-5 | Drop queued data
-		 *  6 | 4 | 6 | 4 | 6+4-6 = 4 | 6-6-4=-4 | Drop queued data / packet
-		 * 10 | 2 | 6 | 4 | 10+2-6= 6 | 6-10-2=-6| Should not happen, dropping queue
-		 *  7 | 4 | 6 | 4 | 7+4-6 = 5 | 6-7-4=-5 | Should not happen, dropping queue
-		 * 11 | 2 | 6 | 4 | 11+2-6= 7 | 6-11-2=-7| Should not happen, dropping queue
-		 *  2 | 3 | 6 | 4 | 2+3-6= MI | 6-2-3=1  | Keep queued data
-		 */
-		struct tcphdr *th = th_get(pkt);
-		uint32_t expected_seq = th_seq(th) + len;
-		uint32_t pending_seq;
-		int32_t gap_size;
-		uint32_t end_offset;
-
-		pending_seq = tcp_get_seq(conn->queue_recv_data->buffer);
-		end_offset = expected_seq - pending_seq;
-		gap_size = (int32_t)(pending_seq - th_seq(th) - ((uint32_t)len));
-		pending_len = net_pkt_get_len(conn->queue_recv_data);
-		if (end_offset < pending_len) {
-			if (end_offset) {
-				net_pkt_remove_tail(pkt, end_offset);
-				pending_len -= end_offset;
-			}
-
-			NET_DBG("Found pending data seq %u len %zd",
-				expected_seq, pending_len);
+	if (!CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT ||
+	    conn->queue_recv_data->buffer == NULL) {
+		return 0;
+	}
 
-			net_buf_frag_add(pkt->buffer,
-					 conn->queue_recv_data->buffer);
-			conn->queue_recv_data->buffer = NULL;
+	while (conn->queue_recv_data->buffer != NULL) {
+		buf = conn->queue_recv_data->buffer;
+		seq = tcp_get_seq(buf);
 
-			k_work_cancel_delayable(&conn->recv_queue_timer);
-		} else {
-			/* Check if the queued data is just a section of the incoming data */
-			if (gap_size <= 0) {
-				net_buf_unref(conn->queue_recv_data->buffer);
-				conn->queue_recv_data->buffer = NULL;
+		if (net_tcp_seq_greater(seq, expected_seq)) {
+			break;
+		}
 
-				k_work_cancel_delayable(&conn->recv_queue_timer);
-			}
+		conn->queue_recv_data->buffer = buf->frags;
+		buf->frags = NULL;
 
-			pending_len = 0;
+		if (!net_tcp_seq_greater(seq + buf->len, expected_seq)) {
+			/* Already received */
+			net_buf_unref(buf);
+			continue;
 		}
+
+		net_buf_pull(buf, expected_seq - seq);
+		expected_seq += buf->len;
+		pending_len += buf->len;
+
+		net_buf_frag_add(pkt->buffer, buf);
+	}
+
+	if (pending_len > 0) {
+		NET_DBG("Found pending data seq %u len %zd",
+			conn->ack + len, pending_len);
+	}
+
+	if (conn->queue_recv_data->buffer == NULL) {
+		k_work_cancel_delayable(&conn->recv_queue_timer);
 	}
 
+	net_pkt_cursor_init(conn->queue_recv_data);
+
 	return pending_len;
 }
 
@@ -1338,8 +1623,22 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+/* The receive window to advertise, scaled unless in a SYN, RFC 7323 ch 2.2 */
+static uint16_t tcp_recv_win_field(struct tcp *conn, uint8_t flags)
+{
+	uint32_t win = conn->recv_win;
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+	if (!(flags & SYN)) {
+		win >>= conn->rcv_wscale;
+	}
+#endif
+
+	return MIN(win, UINT16_MAX);
+}
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t options_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
@@ -1353,14 +1652,10 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, &th->th_sport);
 	UNALIGNED_PUT(conn->dst.sin.sin_port, &th->th_dport);
-	th->th_off = 5;
-
-	if (conn->send_options.mss_found) {
-		th->th_off++;
-	}
+	th->th_off = 5 + options_len / 4;
 
 	UNALIGNED_PUT(flags, &th->th_flags);
-	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
+	UNALIGNED_PUT(htons(tcp_recv_win_field(conn, flags)), &th->th_win);
 	UNALIGNED_PUT(htonl(seq), &th->th_seq);
 
 	if (ACK & flags) {
@@ -1418,23 +1713,228 @@ static int get_tcp_nodelay(struct tcp *conn, void *value, size_t *len)
 	return 0;
 }
 
-static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
+static int get_tcp_info(struct tcp *conn, void *value, size_t *len)
 {
-	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
-	struct tcp_mss_option *mss;
-	uint32_t recv_mss;
+	struct tcp_info info = { 0 };
 
-	mss = net_pkt_get_data(pkt, &mss_opt_access);
-	if (!mss) {
-		return -ENOBUFS;
+	if (value == NULL || len == NULL) {
+		return -EINVAL;
+	}
+
+	info.tcpi_state = conn->state;
+	info.tcpi_retransmits = conn->send_data_retries;
+	info.tcpi_snd_mss = conn_mss(conn);
+	info.tcpi_rto = TCP_RTO_MS * USEC_PER_MSEC;
+	info.tcpi_rtt = tcp_srtt(conn) * USEC_PER_MSEC;
+#ifdef CONFIG_NET_TCP_RTT_ESTIMATION
+	info.tcpi_rttvar = (conn->rttvar >> 2) * USEC_PER_MSEC;
+#endif
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	info.tcpi_snd_cwnd = conn->ca.cwnd;
+	info.tcpi_snd_ssthresh = conn->ca.ssthresh;
+#endif
+	info.tcpi_snd_wnd = conn->send_win;
+	info.tcpi_rcv_wnd = conn->recv_win;
+	info.tcpi_unacked = conn->unacked_len;
+	info.tcpi_notsent = conn->send_data_total - conn->unacked_len;
+
+	/* A shorter structure gets what fits, as on other systems */
+	*len = MIN(*len, sizeof(info));
+	memcpy(value, &info, *len);
+
+	return 0;
+}
+
+#ifdef CONFIG_NET_TCP_SACK
+/* Report the out-of-order data queued in SACK blocks, the one received last
+ * first, RFC 2018 ch 4. Returns the length of the option.
+ */
+static size_t tcp_sack_option_add(struct tcp *conn, uint8_t *options,
+				  size_t max_blocks)
+{
+	struct tcp_sack_block blocks[NET_TCP_MAX_SACK_BLOCKS];
+	struct net_buf *buf = conn->queue_recv_data->buffer;
+	struct tcp_sack_block block;
+	size_t count = 0;
+	size_t len = 0;
+
+	max_blocks = MIN(max_blocks, NET_TCP_MAX_SACK_BLOCKS);
+	if (max_blocks == 0) {
+		return 0;
+	}
+
+	while (buf != NULL) {
+		block.left = tcp_get_seq(buf);
+		block.right = block.left + buf->len;
+
+		for (buf = buf->frags; buf != NULL && tcp_get_seq(buf) == block.right;
+		     buf = buf->frags) {
+			block.right += buf->len;
+		}
+
+		if (!net_tcp_seq_greater(block.left, conn->sack_last) &&
+		    net_tcp_seq_greater(block.right, conn->sack_last)) {
+			memmove(&blocks[1], &blocks[0],
+				MIN(count, max_blocks - 1) * sizeof(blocks[0]));
+			blocks[0] = block;
+			count = MIN(count + 1, max_blocks);
+		} else if (count < max_blocks) {
+			blocks[count++] = block;
+		}
+	}
+
+	if (count == 0) {
+		return 0;
+	}
+
+	options[len++] = NET_TCP_NOP_OPT;
+	options[len++] = NET_TCP_NOP_OPT;
+	options[len++] = NET_TCP_SACK_OPT;
+	options[len++] = 2 + count * NET_TCP_SACK_BLOCK_SIZE;
+
+	for (size_t i = 0; i < count; i++) {
+		sys_put_be32(blocks[i].left, &options[len]);
+		sys_put_be32(blocks[i].right, &options[len + 4]);
+		len += NET_TCP_SACK_BLOCK_SIZE;
+	}
+
+	return len;
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
+/* Fill in the options of a segment, returns their length */
+static size_t tcp_options_add(struct tcp *conn, uint8_t flags, uint8_t *options)
+{
+	size_t len = 0;
+
+	if (conn->send_options.mss_found) {
+		options[len++] = NET_TCP_MSS_OPT;
+		options[len++] = NET_TCP_MSS_SIZE;
+		sys_put_be16(net_tcp_get_supported_mss(conn), &options[len]);
+		len += sizeof(uint16_t);
+	}
+
+	if ((flags & SYN) && conn->send_options.sack_perm_found) {
+		options[len++] = NET_TCP_NOP_OPT;
+		options[len++] = NET_TCP_NOP_OPT;
+		options[len++] = NET_TCP_SACK_PERM_OPT;
+		options[len++] = NET_TCP_SACK_PERM_SIZE;
+	}
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+	if ((flags & SYN) && conn->send_options.wnd_found) {
+		options[len++] = NET_TCP_NOP_OPT;
+		options[len++] = NET_TCP_WINDOW_SCALE_OPT;
+		options[len++] = NET_TCP_WINDOW_SCALE_SIZE;
+		options[len++] = conn->rcv_wscale;
+	}
+#endif
+
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	if (!(flags & RST) && (conn->ts_ok ||
+			       ((flags & SYN) && conn->send_options.ts_found))) {
+		options[len++] = NET_TCP_NOP_OPT;
+		options[len++] = NET_TCP_NOP_OPT;
+		options[len++] = NET_TCP_TIMESTAMP_OPT;
+		options[len++] = NET_TCP_TIMESTAMP_SIZE;
+		sys_put_be32(tcp_ts_now(conn), &options[len]);
+		sys_put_be32(conn->ts_recent, &options[len + 4]);
+		len += 2 * sizeof(uint32_t);
+	}
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+	if (conn->sack_ok && (flags & ACK) && !(flags & (SYN | RST)) &&
+	    conn->queue_recv_data->buffer != NULL) {
+		len += tcp_sack_option_add(conn, &options[len],
+					   (NET_TCP_MAX_OPT_SIZE - len - 4) /
+					   NET_TCP_SACK_BLOCK_SIZE);
+	}
+#endif
+
+	return len;
+}
+
+/* Length of the options of data segments, which the MSS does not include */
+static int tcp_data_options_len(struct tcp *conn)
+{
+	int len = 0;
+
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	if (conn->ts_ok) {
+		len += TCP_TS_OPT_LEN;
+	}
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+	if (conn->sack_ok && conn->queue_recv_data->buffer != NULL) {
+		/* Leave room for all the blocks that fit */
+		len = NET_TCP_MAX_OPT_SIZE;
+	}
+#endif
+
+	return len;
+}
+
+/* Select the options of a SYN. When answering a SYN, the options are only
+ * sent if the peer sent them too.
+ */
+static void tcp_syn_options_set(struct tcp *conn, bool answer)
+{
+	conn->send_options.mss_found = true;
+
+#ifdef CONFIG_NET_TCP_SACK
+	conn->send_options.sack_perm_found = !answer || conn->sack_ok;
+#endif
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+	conn->send_options.wnd_found = !answer || conn->recv_options.wnd_found;
+	conn->rcv_wscale = 0;
+
+	while (conn->send_options.wnd_found &&
+	       (conn->recv_win_max >> conn->rcv_wscale) > UINT16_MAX &&
+	       conn->rcv_wscale < NET_TCP_MAX_WINDOW_SCALE) {
+		conn->rcv_wscale++;
 	}
+#endif
 
-	recv_mss = net_tcp_get_supported_mss(conn);
-	recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	conn->send_options.ts_found = !answer || conn->ts_ok;
+#endif
+}
+
+static void tcp_syn_options_clear(struct tcp *conn)
+{
+	conn->send_options.mss_found = false;
+	conn->send_options.sack_perm_found = false;
+	conn->send_options.wnd_found = false;
+	conn->send_options.ts_found = false;
+}
 
-	UNALIGNED_PUT(htonl(recv_mss), (uint32_t *)mss);
+/* Use the options that both sides sent in their SYN */
+static void tcp_syn_options_negotiate(struct tcp *conn)
+{
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+	if (conn->recv_options.wnd_found) {
+		conn->snd_wscale = conn->recv_options.window;
+	} else {
+		conn->snd_wscale = 0;
+		conn->rcv_wscale = 0;
+	}
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+	conn->sack_ok = conn->recv_options.sack_perm_found;
+#endif
+
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	conn->ts_ok = conn->recv_options.ts_found;
+	if (conn->ts_ok) {
+		conn->ts_recent = conn->recv_options.tsval;
+	}
+#endif
 
-	return net_pkt_set_data(pkt, &mss_opt_access);
+	ARG_UNUSED(conn);
 }
 
 static bool is_destination_local(struct net_pkt *pkt)
@@ -1541,14 +2041,12 @@ err:
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
-	size_t alloc_len = sizeof(struct tcphdr);
+	uint8_t options[NET_TCP_MAX_OPT_SIZE];
+	size_t options_len = tcp_options_add(conn, flags, options);
+	size_t alloc_len = sizeof(struct tcphdr) + options_len;
 	struct net_pkt *pkt;
 	int ret = 0;
 
-	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
-	}
-
 	pkt = tcp_pkt_alloc(conn, alloc_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
@@ -1556,8 +2054,11 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 	}
 
 	if (data) {
-		/* Append the data buffer to the pkt */
+		/* Append the data buffer to the pkt, with its checksum */
 		net_pkt_append_buffer(pkt, data->buffer);
+		net_pkt_set_chksum_partial(pkt, net_pkt_chksum_partial(data),
+					   net_pkt_chksum_partial_len(data));
+		net_pkt_set_tso_size(pkt, net_pkt_tso_size(data));
 		data->buffer = NULL;
 	}
 
@@ -1567,14 +2068,14 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, options_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
 	}
 
-	if (conn->send_options.mss_found) {
-		ret = net_tcp_set_mss_opt(conn, pkt);
+	if (options_len > 0) {
+		ret = net_pkt_write(pkt, options, options_len);
 		if (ret < 0) {
 			tcp_pkt_unref(pkt);
 			goto out;
@@ -1646,7 +2147,7 @@ static int tcp_pkt_peek(struct net_pkt *to, struct net_pkt *from, size_t pos,
 		net_pkt_skip(from, pos);
 	}
 
-	return net_pkt_copy(to, from, len);
+	return net_pkt_copy_chksum(to, from, len);
 }
 
 static int tcp_pkt_append(struct net_pkt *pkt, const uint8_t *data, size_t len)
@@ -1736,45 +2237,72 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
-static int tcp_send_data(struct tcp *conn)
+/* Largest amount of data in a segment, leaving room for its options */
+static int tcp_segment_len(struct tcp *conn)
 {
-	int ret = 0;
-	int len;
-	struct net_pkt *pkt;
+	return conn_mss(conn) - tcp_data_options_len(conn);
+}
 
-	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
-	if (len < 0) {
-		ret = len;
-		goto out;
+/* Largest amount of data sent at once, several segments with TSO. Data is
+ * retransmitted one segment at a time.
+ */
+static int tcp_send_len(struct tcp *conn)
+{
+	int seg_len = tcp_segment_len(conn);
+
+#ifdef CONFIG_NET_TCP_TSO
+	if (conn->data_mode == TCP_DATA_MODE_SEND) {
+		return MAX((int)ROUND_DOWN(CONFIG_NET_TCP_TSO_MAX_SIZE, seg_len), seg_len);
 	}
-	if (len == 0) {
-		NET_DBG("conn: %p no data to send", conn);
-		ret = -ENODATA;
-		goto out;
+#endif
+
+	return seg_len;
+}
+
+/* Send len bytes of the send_data queue, starting offset bytes after seq */
+static int tcp_send_segment(struct tcp *conn, uint32_t offset, int len,
+			    bool resend)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	if (IS_ENABLED(CONFIG_NET_TCP_TSO) && len > tcp_segment_len(conn)) {
+		/* Several segments, cut by the interface. Their data does
+		 * not fit in an MTU sized packet.
+		 */
+		pkt = tcp_pkt_alloc(conn, 0);
+		if (pkt && net_pkt_alloc_buffer_raw(pkt, len,
+						    TCP_PKT_ALLOC_TIMEOUT) < 0) {
+			tcp_pkt_unref(pkt);
+			pkt = NULL;
+		}
+
+		if (pkt) {
+			net_pkt_set_tso_size(pkt, tcp_segment_len(conn));
+		}
+	} else {
+		pkt = tcp_pkt_alloc(conn, len);
 	}
 
-	pkt = tcp_pkt_alloc(conn, len);
 	if (!pkt) {
 		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
-		ret = -ENOBUFS;
-		goto out;
+		return -ENOBUFS;
 	}
 
-	ret = tcp_pkt_peek(pkt, conn->send_data, conn->unacked_len, len);
+	ret = tcp_pkt_peek(pkt, conn->send_data, offset, len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
-		ret = -ENOBUFS;
-		goto out;
+		return -ENOBUFS;
 	}
 
-	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + offset);
 	if (ret == 0) {
-		conn->unacked_len += len;
-
-		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
+		if (resend) {
+			tcp_rtt_cancel(conn);
 			net_stats_update_tcp_resent(conn->iface, len);
 			net_stats_update_tcp_seg_rexmit(conn->iface);
 		} else {
+			tcp_rtt_start(conn, conn->seq + offset + len);
 			net_stats_update_tcp_sent(conn->iface, len);
 			net_stats_update_tcp_seg_sent(conn->iface);
 		}
@@ -1786,6 +2314,262 @@ static int tcp_send_data(struct tcp *conn)
 	 */
 	tcp_pkt_unref(pkt);
 
+	return ret;
+}
+
+#ifdef CONFIG_NET_TCP_SACK
+/* Add a block to the scoreboard, merging it with the blocks it touches. When
+ * the scoreboard is full, the highest block is forgotten.
+ */
+static void tcp_sack_insert(struct tcp *conn, uint32_t left, uint32_t right)
+{
+	struct tcp_sack_block *sacked = conn->sacked;
+	int i = 0;
+	int j;
+
+	while (i < conn->sacked_count &&
+	       net_tcp_seq_greater(left, sacked[i].right)) {
+		i++;
+	}
+
+	for (j = i; j < conn->sacked_count &&
+		    !net_tcp_seq_greater(sacked[j].left, right); j++) {
+		if (net_tcp_seq_greater(left, sacked[j].left)) {
+			left = sacked[j].left;
+		}
+
+		if (net_tcp_seq_greater(sacked[j].right, right)) {
+			right = sacked[j].right;
+		}
+	}
+
+	if (j == i) {
+		if (conn->sacked_count == NET_TCP_SACK_SCOREBOARD_SIZE) {
+			if (i == conn->sacked_count) {
+				return;
+			}
+
+			conn->sacked_count--;
+		}
+
+		memmove(&sacked[i + 1], &sacked[i],
+			(conn->sacked_count - i) * sizeof(sacked[0]));
+		conn->sacked_count++;
+	} else if (j > i + 1) {
+		memmove(&sacked[i + 1], &sacked[j],
+			(conn->sacked_count - j) * sizeof(sacked[0]));
+		conn->sacked_count -= j - i - 1;
+	}
+
+	sacked[i].left = left;
+	sacked[i].right = right;
+}
+
+/* Record the SACK blocks of a segment that cover unacknowledged data */
+static void tcp_sack_update(struct tcp *conn)
+{
+	uint32_t end = conn->seq + conn->send_data_total;
+
+	if (!conn->sack_ok) {
+		return;
+	}
+
+	for (int i = 0; i < conn->recv_options.sack_count; i++) {
+		struct tcp_sack_block *block = &conn->recv_options.sack[i];
+
+		if (!net_tcp_seq_greater(block->right, block->left) ||
+		    !net_tcp_seq_greater(block->left, conn->seq) ||
+		    net_tcp_seq_greater(block->right, end)) {
+			continue;
+		}
+
+		NET_DBG("conn: %p SACK %u-%u", conn, block->left, block->right);
+
+		tcp_sack_insert(conn, block->left, block->right);
+	}
+}
+
+/* Find the first hole from *start up to the highest SACKed data */
+static bool tcp_sack_next_hole(struct tcp *conn, uint32_t *start, uint32_t *len)
+{
+	uint32_t seq = *start;
+
+	for (int i = 0; i < conn->sacked_count; i++) {
+		if (net_tcp_seq_greater(conn->sacked[i].left, seq)) {
+			*start = seq;
+			*len = conn->sacked[i].left - seq;
+			return true;
+		}
+
+		if (net_tcp_seq_greater(conn->sacked[i].right, seq)) {
+			seq = conn->sacked[i].right;
+		}
+	}
+
+	return false;
+}
+
+/* Resend the next hole in the SACKed data, RFC 6675 ch 5 */
+static int tcp_sack_retransmit(struct tcp *conn)
+{
+	uint32_t start = conn->seq;
+	uint32_t len;
+	int ret;
+
+	if (net_tcp_seq_greater(conn->sack_rexmit, start)) {
+		start = conn->sack_rexmit;
+	}
+
+	if (!tcp_sack_next_hole(conn, &start, &len)) {
+		return -ENODATA;
+	}
+
+	len = MIN(len, (uint32_t)tcp_segment_len(conn));
+
+	NET_DBG("conn: %p SACK retransmit %u len %u", conn, start, len);
+
+	ret = tcp_send_segment(conn, start - conn->seq, len, true);
+	if (ret == 0) {
+		conn->sack_rexmit = start + len;
+	}
+
+	return ret;
+}
+
+/* Start the SACK based loss recovery, instead of resending all the
+ * unacknowledged data.
+ */
+static bool tcp_sack_recover(struct tcp *conn)
+{
+	if (!conn->sack_ok || conn->sacked_count == 0) {
+		return false;
+	}
+
+	if (!conn->sack_recovery) {
+		conn->sack_recovery = true;
+		conn->sack_recover = conn->seq + conn->unacked_len;
+		conn->sack_rexmit = conn->seq;
+	}
+
+	(void)tcp_sack_retransmit(conn);
+
+	return true;
+}
+
+/* Forget the acknowledged blocks, continue or end the recovery */
+static void tcp_sack_acked(struct tcp *conn)
+{
+	int i = 0;
+
+	while (i < conn->sacked_count &&
+	       !net_tcp_seq_greater(conn->sacked[i].right, conn->seq)) {
+		i++;
+	}
+
+	conn->sacked_count -= i;
+	memmove(&conn->sacked[0], &conn->sacked[i],
+		conn->sacked_count * sizeof(conn->sacked[0]));
+
+	if (conn->sacked_count > 0 &&
+	    net_tcp_seq_greater(conn->seq, conn->sacked[0].left)) {
+		conn->sacked[0].left = conn->seq;
+	}
+
+	if (!conn->sack_recovery) {
+		return;
+	}
+
+	if (net_tcp_seq_greater(conn->sack_recover, conn->seq)) {
+		/* Partial acknowledgment, the next hole is lost too */
+		(void)tcp_sack_retransmit(conn);
+	} else {
+		conn->sack_recovery = false;
+	}
+}
+
+/* Skip the SACKed data when resending after a timeout */
+static void tcp_sack_skip(struct tcp *conn)
+{
+	uint32_t next = conn->seq + conn->unacked_len;
+
+	for (int i = 0; i < conn->sacked_count; i++) {
+		if (net_tcp_seq_greater(conn->sacked[i].left, next)) {
+			break;
+		}
+
+		if (net_tcp_seq_greater(conn->sacked[i].right, next)) {
+			next = conn->sacked[i].right;
+		}
+	}
+
+	conn->unacked_len = next - conn->seq;
+}
+
+/* End a segment starting offset bytes after seq where SACKed data starts */
+static int tcp_sack_clip(struct tcp *conn, uint32_t offset, int len)
+{
+	uint32_t start = conn->seq + offset;
+
+	for (int i = 0; i < conn->sacked_count; i++) {
+		if (net_tcp_seq_greater(conn->sacked[i].left, start)) {
+			return MIN(len, (int)(conn->sacked[i].left - start));
+		}
+	}
+
+	return len;
+}
+
+/* The first retransmission timeout keeps skipping the SACKed data. If another
+ * one is needed, the peer may have dropped it (RFC 2018 ch 8), so send it all.
+ */
+static void tcp_sack_timeout(struct tcp *conn)
+{
+	conn->sack_recovery = false;
+
+	if (conn->send_data_retries > 0) {
+		conn->sacked_count = 0;
+	}
+}
+#else
+#define tcp_sack_update(...)
+#define tcp_sack_recover(...) false
+#define tcp_sack_acked(...)
+#define tcp_sack_skip(...)
+#define tcp_sack_clip(conn, offset, len) (len)
+#define tcp_sack_timeout(...)
+#endif /* CONFIG_NET_TCP_SACK */
+
+static int tcp_send_data(struct tcp *conn)
+{
+	int ret = 0;
+	int len;
+
+	tcp_sack_skip(conn);
+
+	len = MIN(tcp_unsent_len(conn), tcp_send_len(conn));
+	if (len < 0) {
+		ret = len;
+		goto out;
+	}
+	if (len == 0) {
+		NET_DBG("conn: %p no data to send", conn);
+		ret = -ENODATA;
+		goto out;
+	}
+
+	if (len > tcp_segment_len(conn)) {
+		/* Only full segments, a small tail is subject to Nagle */
+		len = (int)ROUND_DOWN(len, tcp_segment_len(conn));
+	}
+
+	len = tcp_sack_clip(conn, conn->unacked_len, len);
+
+	ret = tcp_send_segment(conn, conn->unacked_len, len,
+			       conn->data_mode == TCP_DATA_MODE_RESEND);
+	if (ret == 0) {
+		conn->unacked_len += len;
+	}
+
 	conn_send_data_dump(conn);
 
  out:
@@ -1885,6 +2669,7 @@ static void tcp_resend_data(struct k_work *work)
 
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
+	tcp_sack_timeout(conn);
 
 	ret = tcp_send_data(conn);
 	conn->send_data_retries++;
@@ -2139,7 +2924,8 @@ static struct tcp *tcp_conn_alloc(void)
 	/* Initially set the congestion window at its max size, since only the MSS
 	 * is available as soon as the connection is established
 	 */
-	conn->ca.cwnd = UINT16_MAX;
+	conn->ca.cwnd = TCP_WIN_MAX;
+	conn->ca.ops = TCP_CA_DEFAULT;
 #endif
 
 	/* The ISN value will be set when we get the connection attempt or
@@ -2147,6 +2933,11 @@ static struct tcp *tcp_conn_alloc(void)
 	 */
 	conn->seq = 0U;
 
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	/* Do not disclose the uptime in the timestamps, RFC 7323 ch 7.1 */
+	conn->ts_offset = sys_rand32_get();
+#endif
+
 	sys_slist_init(&conn->send_queue);
 
 	k_work_init_delayable(&conn->send_timer, tcp_send_process);
@@ -2548,166 +3339,110 @@ static enum tcp_state tcp_enter_time_wait(struct tcp *conn)
 	return TCP_TIME_WAIT;
 }
 
-static bool check_seq_list(struct net_buf *buf)
-{
-	struct net_buf *last = NULL;
-	struct net_buf *tmp = buf;
-	uint32_t seq;
-	uint32_t next_seq = 0;
-	bool result = true;
-
-	while (tmp) {
-		seq = tcp_get_seq(tmp);
-
-		NET_DBG("buf %p seq %u len %d", tmp, seq, tmp->len);
-
-		if (last != NULL) {
-			if (next_seq != seq) {
-				result = false;
-			}
-		}
-
-		next_seq = seq + tmp->len;
-		last = tmp;
-		tmp = tmp->frags;
-	}
-	return result;
-}
-
+/* Queue out-of-order data. The queue is sorted and the data in it does not
+ * overlap, but there can be holes between the segments received so far.
+ * Offsets are relative to conn->ack, so that comparing them is not affected
+ * by the sequence numbers wrapping around.
+ */
 static void tcp_queue_recv_data(struct tcp *conn, struct net_pkt *pkt,
 				size_t len, uint32_t seq)
 {
-	uint32_t seq_start = seq;
-	bool inserted = false;
+	struct net_buf *next = conn->queue_recv_data->buffer;
+	struct net_buf *prev = NULL;
 	struct net_buf *tmp;
+	uint32_t start = seq - conn->ack;
+	uint32_t end = start + len;
+	uint32_t offset;
 
 	NET_DBG("conn: %p len %zd seq %u ack %u", conn, len, seq, conn->ack);
 
-	tmp = pkt->buffer;
+	/* Drop what has been received in order since it was queued */
+	while (next != NULL &&
+	       !net_tcp_seq_greater(tcp_get_seq(next) + next->len, conn->ack)) {
+		tmp = next->frags;
+		next->frags = NULL;
+		net_buf_unref(next);
+		next = tmp;
+	}
 
-	tcp_set_seq(tmp, seq);
-	seq += tmp->len;
-	tmp = tmp->frags;
+	conn->queue_recv_data->buffer = next;
 
-	while (tmp) {
-		tcp_set_seq(tmp, seq);
-		seq += tmp->len;
-		tmp = tmp->frags;
+	while (next != NULL && tcp_get_seq(next) - conn->ack < start) {
+		prev = next;
+		next = next->frags;
 	}
 
-	if (IS_ENABLED(CONFIG_NET_TCP_LOG_LEVEL_DBG)) {
-		NET_DBG("Queuing data: conn %p", conn);
+	if (prev != NULL) {
+		offset = tcp_get_seq(prev) - conn->ack + prev->len;
+		if (offset >= end) {
+			NET_DBG("Data already queued");
+			return;
+		}
+
+		if (offset > start) {
+			/* Keep the part after the previous data */
+			if (tcp_pkt_pull(pkt, offset - start) < 0) {
+				return;
+			}
+
+			start = offset;
+		}
 	}
 
-	if (!net_pkt_is_empty(conn->queue_recv_data)) {
-		/* Place the data to correct place in the list. If the data
-		 * would not be sequential, then drop this packet.
-		 *
-		 * Only work with subtractions between sequence numbers in uint32_t format
-		 * to proper handle cases that are around the wrapping point.
-		 */
+	/* Replace the queued data covered by the new data */
+	while (next != NULL &&
+	       tcp_get_seq(next) - conn->ack + next->len <= end) {
+		tmp = next->frags;
+		next->frags = NULL;
+		net_buf_unref(next);
+		next = tmp;
+	}
 
-		/* Some potentential cases:
-		 * Note: MI = MAX_INT
-		 * Packet | Queued| End off1  | Start off| End off2    | Required handling
-		 * Seq|Len|Seq|Len|           |          |             |
-		 *  3 | 3 | 6 | 4 | 3+3-6=  0 | NA       | NA          | Prepend
-		 *  3 | 4 | 6 | 4 | 3+4-6 = 1 | NA       | NA          | Prepend, pull from buffer
-		 *  3 | 7 | 6 | 4 | 3+7-6 = 4 | 6-3=3    | 6+4-3=7     | Drop queued data
-		 *  3 | 8 | 6 | 4 | 3+8-6 = 5 | 6-3=3    | 6+4-3=7     | Drop queued data
-		 *  6 | 5 | 6 | 4 | 6+5-6 = 5 | 6-6=0    | 6+4-6=4     | Drop queued data
-		 *  6 | 4 | 6 | 4 | 6+4-6 = 4 | 6-6=0    | 6+4-6=4     | Drop queued data / packet
-		 *  7 | 2 | 6 | 4 | 7+2-6 = 3 | 6-7=MI   | 6+4-7=3     | Drop packet
-		 * 10 | 2 | 6 | 4 | 10+2-6= 6 | 6-10=MI-3| 6+4-10=0    | Append
-		 *  7 | 4 | 6 | 4 | 7+4-6 = 5 | 6-7 =MI  | 6+4-7 =3    | Append, pull from packet
-		 * 11 | 2 | 6 | 4 | 11+2-6= 7 | 6-11=MI-6| 6+4-11=MI-1 | Drop incoming packet
-		 *  2 | 3 | 6 | 4 | 2+3-6= MI | 6-2=4    | 6+4-2=8     | Drop incoming packet
-		 */
+	if (next != NULL) {
+		offset = tcp_get_seq(next) - conn->ack;
+		if (offset == start) {
+			NET_DBG("Data already queued");
+			goto link;
+		}
 
-		uint32_t pending_seq;
-		uint32_t start_offset;
-		uint32_t end_offset;
-		size_t pending_len;
-
-		pending_seq = tcp_get_seq(conn->queue_recv_data->buffer);
-		end_offset = seq - pending_seq;
-		pending_len = net_pkt_get_len(conn->queue_recv_data);
-		if (end_offset < pending_len) {
-			if (end_offset < len) {
-				if (end_offset) {
-					net_pkt_remove_tail(pkt, end_offset);
-				}
+		if (offset < end) {
+			/* Keep the part before the next data */
+			net_pkt_remove_tail(pkt, end - offset);
+			end = offset;
+		}
+	}
 
-				/* Put new data before the pending data */
-				net_buf_frag_add(pkt->buffer,
-						 conn->queue_recv_data->buffer);
-				NET_DBG("Adding at before queue, end_offset %i, pending_len %zu",
-					end_offset, pending_len);
-				conn->queue_recv_data->buffer = pkt->buffer;
-				inserted = true;
-			}
-		} else {
-			struct net_buf *last;
+	seq = conn->ack + start;
+	for (tmp = pkt->buffer; tmp->frags != NULL; tmp = tmp->frags) {
+		tcp_set_seq(tmp, seq);
+		seq += tmp->len;
+	}
 
-			last = net_buf_frag_last(conn->queue_recv_data->buffer);
-			pending_seq = tcp_get_seq(last);
+	tcp_set_seq(tmp, seq);
+	tmp->frags = next;
+	next = pkt->buffer;
 
-			start_offset = pending_seq - seq_start;
-			/* Compute the offset w.r.t. the start point of the new packet */
-			end_offset = (pending_seq + last->len) - seq_start;
+	/* We need to keep the received data but free the pkt */
+	pkt->buffer = NULL;
 
-			/* Check if queue start with within the within the new packet */
-			if ((start_offset < len) && (end_offset <= len)) {
-				/* The queued data is irrelevant since the new packet overlaps the
-				 * new packet, take the new packet as contents
-				 */
-				net_buf_unref(conn->queue_recv_data->buffer);
-				conn->queue_recv_data->buffer = pkt->buffer;
-				inserted = true;
-			} else {
-				if (end_offset < len) {
-					if (end_offset) {
-						net_pkt_remove_tail(conn->queue_recv_data,
-								    end_offset);
-					}
+#ifdef CONFIG_NET_TCP_SACK
+	conn->sack_last = conn->ack + start;
+#endif
 
-					/* Put new data after pending data */
-					NET_DBG("Adding at end of queue, start %i, end %i, len %zu",
-						start_offset, end_offset, len);
-					net_buf_frag_add(conn->queue_recv_data->buffer,
-							 pkt->buffer);
-					inserted = true;
-				}
-			}
-		}
+	if (!k_work_delayable_is_pending(&conn->recv_queue_timer)) {
+		k_work_reschedule_for_queue(
+			&tcp_work_q, &conn->recv_queue_timer,
+			K_MSEC(CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT));
+	}
 
-		if (inserted) {
-			NET_DBG("All pending data: conn %p", conn);
-			if (check_seq_list(conn->queue_recv_data->buffer) == false) {
-				NET_ERR("Incorrect order in out of order sequence for conn %p",
-					conn);
-				/* error in sequence list, drop it */
-				net_buf_unref(conn->queue_recv_data->buffer);
-				conn->queue_recv_data->buffer = NULL;
-			}
-		} else {
-			NET_DBG("Cannot add new data to queue");
-		}
+link:
+	if (prev != NULL) {
+		prev->frags = next;
 	} else {
-		net_pkt_append_buffer(conn->queue_recv_data, pkt->buffer);
-		inserted = true;
+		conn->queue_recv_data->buffer = next;
 	}
 
-	if (inserted) {
-		/* We need to keep the received data but free the pkt */
-		pkt->buffer = NULL;
-
-		if (!k_work_delayable_is_pending(&conn->recv_queue_timer)) {
-			k_work_reschedule_for_queue(
-				&tcp_work_q, &conn->recv_queue_timer,
-				K_MSEC(CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT));
-		}
-	}
+	net_pkt_cursor_init(conn->queue_recv_data);
 }
 
 static enum net_verdict tcp_data_received(struct tcp *conn, struct net_pkt *pkt,
@@ -2870,6 +3605,8 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
+	tcp_options_segment_reset(&conn->recv_options);
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
 						  tcp_options_len)) {
 		NET_DBG("DROP: Invalid TCP option list");
@@ -2879,6 +3616,10 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
+	if (th) {
+		tcp_ts_recent_update(conn, th);
+	}
+
 	if (th && (conn->state != TCP_LISTEN) && (conn->state != TCP_SYN_SENT) &&
 	    tcp_validate_seq(conn, th) && FL(&fl, &, SYN)) {
 		/* According to RFC 793, ch 3.9 Event Processing, receiving SYN
@@ -2896,6 +3637,12 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 
 	if (th) {
 		conn->send_win = ntohs(th_win(th));
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+		/* The window of a SYN is never scaled, RFC 7323 ch 2.2 */
+		if (!FL(&fl, &, SYN)) {
+			conn->send_win <<= conn->snd_wscale;
+		}
+#endif
 		if (conn->send_win > conn->send_win_max) {
 			NET_DBG("Lowering send window from %u to %u",
 				conn->send_win, conn->send_win_max);
@@ -2927,11 +3674,14 @@ next_state:
 	switch (conn->state) {
 	case TCP_LISTEN:
 		if (FL(&fl, ==, SYN)) {
-			/* Make sure our MSS is also sent in the ACK */
-			conn->send_options.mss_found = true;
+			/* Make sure our MSS and the options the peer offered
+			 * are also sent in the ACK
+			 */
+			tcp_syn_options_negotiate(conn);
+			tcp_syn_options_set(conn, true);
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
 			tcp_out(conn, SYN | ACK);
-			conn->send_options.mss_found = false;
+			tcp_syn_options_clear(conn);
 			conn_seq(conn, + 1);
 			next = TCP_SYN_RECEIVED;
 
@@ -2942,13 +3692,13 @@ next_state:
 						    ACK_TIMEOUT);
 			verdict = NET_OK;
 		} else {
-			conn->send_options.mss_found = true;
+			tcp_syn_options_set(conn, false);
 			ret = tcp_out_ext(conn, SYN, NULL /* no data */, conn->seq);
 			if (ret < 0) {
 				do_close = true;
 				close_status = ret;
 			} else {
-				conn->send_options.mss_found = false;
+				tcp_syn_options_clear(conn);
 				conn_seq(conn, + 1);
 				next = TCP_SYN_SENT;
 				tcp_conn_ref(conn);
@@ -2965,6 +3715,7 @@ next_state:
 				accept_cb = conn->accepted_conn->accept_cb;
 				context = conn->accepted_conn->context;
 				keep_alive_param_copy(conn, conn->accepted_conn);
+				tcp_ca_param_copy(conn, conn->accepted_conn);
 			}
 
 			k_work_cancel_delayable(&conn->establish_timer);
@@ -3054,6 +3805,8 @@ next_state:
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
+			tcp_syn_options_negotiate(conn);
+			tcp_rtt_update(conn, th_ack(th));
 			conn_ack(conn, th_seq(th) + 1);
 			if (len) {
 				verdict = tcp_data_get(conn, pkt, &len);
@@ -3137,6 +3890,8 @@ next_state:
 		 */
 		keep_alive_timer_restart(conn);
 
+		tcp_sack_update(conn);
+
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 		if (th && (net_tcp_seq_cmp(th_ack(th), conn->seq) == 0)) {
 			/* Only if there is pending data, increment the duplicate ack count */
@@ -3157,20 +3912,33 @@ next_state:
 			/* Only do fast retransmit when not already in a resend state */
 			if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
 			    (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
-				/* Apply a fast retransmit */
-				int temp_unacked_len = conn->unacked_len;
+				/* Apply a fast retransmit, of the holes in the
+				 * data the peer has SACKed if it did
+				 */
+				if (!tcp_sack_recover(conn)) {
+					int temp_unacked_len = conn->unacked_len;
 
-				conn->unacked_len = 0;
+					conn->unacked_len = 0;
 
-				(void)tcp_send_data(conn);
+					(void)tcp_send_data(conn);
 
-				/* Restore the current transmission */
-				conn->unacked_len = temp_unacked_len;
+					/* Restore the current transmission */
+					conn->unacked_len = temp_unacked_len;
+				}
 
+				tcp_rtt_cancel(conn);
 				tcp_ca_fast_retransmit(conn);
 				if (tcp_window_full(conn)) {
 					(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
 				}
+#ifdef CONFIG_NET_TCP_SACK
+			} else if (conn->sack_recovery && len == 0) {
+				/* Each duplicate ACK in the recovery means a
+				 * segment has left the network, resend the
+				 * next hole.
+				 */
+				(void)tcp_sack_retransmit(conn);
+#endif
 			}
 		}
 #endif
@@ -3201,6 +3969,7 @@ next_state:
 			/* New segment, reset duplicate ack counter */
 			conn->dup_ack_cnt = 0;
 #endif
+			tcp_rtt_update(conn, th_ack(th));
 			tcp_ca_pkts_acked(conn, len_acked);
 
 			conn->send_data_total -= len_acked;
@@ -3215,6 +3984,7 @@ next_state:
 			}
 
 			conn_seq(conn, + len_acked);
+			tcp_sack_acked(conn);
 			net_stats_update_tcp_seg_recv(conn->iface);
 
 			/* Receipt of an acknowledgment that covers a sequence number
@@ -3280,6 +4050,19 @@ next_state:
 					/* ACK, no data */
 					verdict = NET_OK;
 				}
+			} else if (net_tcp_seq_greater(conn->ack, th_seq(th)) &&
+				   net_tcp_seq_greater(th_seq(th) + len, conn->ack)) {
+				/* Partially retransmitted data, keep only the new
+				 * part, which is at the end of the packet.
+				 */
+				len -= conn->ack - th_seq(th);
+
+				verdict = tcp_data_received(conn, pkt, &len,
+							    FL(&fl, &, PSH));
+				if (verdict == NET_OK) {
+					/* net_pkt owned by the recv fifo now */
+					pkt = NULL;
+				}
 			} else if (net_tcp_seq_greater(conn->ack, th_seq(th))) {
 				/* This should handle the acknowledgements of keep alive
 				 * packets and retransmitted data.
@@ -4102,7 +4885,9 @@ int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 
 	tcp_hdr->chksum = 0U;
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt), type) || force_chksum) {
+	/* The segments of a TSO packet get their checksum when it is cut */
+	if (net_pkt_tso_size(pkt) == 0U &&
+	    (net_if_need_calc_tx_checksum(net_pkt_iface(pkt), type) || force_chksum)) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 		net_pkt_set_chksum_done(pkt, true);
 	}
@@ -4563,6 +5348,12 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = set_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = set_tcp_congestion(conn, value, len);
+		break;
+	default:
+		ret = -ENOPROTOOPT;
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4600,6 +5391,15 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = get_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = get_tcp_congestion(conn, value, len);
+		break;
+	case TCP_OPT_INFO:
+		ret = get_tcp_info(conn, value, len);
+		break;
+	default:
+		ret = -ENOPROTOOPT;
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
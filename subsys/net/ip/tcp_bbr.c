@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* A simplified BBR congestion control. The path is modeled from the largest
+ * delivery rate measured over the last round trips and the smallest round
+ * trip time of the last seconds. There is no pacing, the congestion window
+ * alone follows the startup, drain, bandwidth probing and round trip time
+ * probing of BBR, with its gains applied to the bandwidth-delay product.
+ * Losses do not shrink the model, only a retransmission timeout restarts
+ * the window from one segment.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_context.h>
+#include "tcp_internal.h"
+
+enum bbr_mode {
+	BBR_STARTUP,
+	BBR_DRAIN,
+	BBR_PROBE_BW,
+	BBR_PROBE_RTT,
+};
+
+/* Gains, in thousandths. The startup one is 2 / ln(2), to double the
+ * delivery rate each round trip.
+ */
+#define BBR_UNIT        1000
+#define BBR_HIGH_GAIN   2885
+
+/* A delivery rate growing by less than 25% for 3 round trips fills the pipe */
+#define BBR_FULL_BW_GROWTH 1250
+#define BBR_FULL_BW_ROUNDS 3
+
+#define BBR_BW_ROUNDS       10    /* Round trips the largest rate is kept */
+#define BBR_MIN_RTT_MS      10000 /* Time the smallest round trip is kept */
+#define BBR_PROBE_RTT_MS    200   /* Time the window is kept small to probe it */
+#define BBR_MIN_CWND_SEGS   4
+
+static const uint16_t bbr_cycle_gain[] = {
+	1250, 750, 1000, 1000, 1000, 1000, 1000, 1000,
+};
+
+static bool tcp_bbr_full_bw_reached(struct tcp_bbr *bbr)
+{
+	return bbr->full_bw_count >= BBR_FULL_BW_ROUNDS;
+}
+
+static uint32_t tcp_bbr_min_cwnd(struct tcp *conn)
+{
+	return BBR_MIN_CWND_SEGS * conn_mss(conn);
+}
+
+/* Bandwidth-delay product times gain, 0 until the path has been measured */
+static uint32_t tcp_bbr_bdp(struct tcp *conn, uint32_t gain)
+{
+	struct tcp_bbr *bbr = &conn->ca.bbr;
+	uint64_t bdp;
+
+	if (bbr->max_bw == 0 || bbr->min_rtt == UINT32_MAX) {
+		return 0;
+	}
+
+	bdp = (uint64_t)bbr->max_bw * bbr->min_rtt * gain / BBR_UNIT;
+
+	return (uint32_t)CLAMP(bdp, tcp_bbr_min_cwnd(conn), (uint64_t)TCP_WIN_MAX);
+}
+
+static void tcp_bbr_init(struct tcp *conn)
+{
+	struct tcp_bbr *bbr = &conn->ca.bbr;
+	uint32_t now = k_uptime_get_32();
+
+	bbr->max_bw = 0;
+	bbr->min_rtt = UINT32_MAX;
+	bbr->min_rtt_stamp = now;
+	bbr->full_bw = 0;
+	bbr->round_start = now;
+	bbr->round_end = conn->seq + conn->unacked_len;
+	bbr->round_delivered = 0;
+	bbr->probe_rtt_end = 0;
+	bbr->round_count = 0;
+	bbr->max_bw_round = 0;
+	bbr->mode = BBR_STARTUP;
+	bbr->cycle = 0;
+	bbr->full_bw_count = 0;
+}
+
+static void tcp_bbr_rtt_sample(struct tcp *conn, uint32_t rtt)
+{
+	struct tcp_bbr *bbr = &conn->ca.bbr;
+	uint32_t now = k_uptime_get_32();
+
+	if (rtt <= bbr->min_rtt || now - bbr->min_rtt_stamp > BBR_MIN_RTT_MS) {
+		bbr->min_rtt = rtt;
+		bbr->min_rtt_stamp = now;
+	}
+}
+
+/* Measure the delivery rate of the round trip that ended */
+static void tcp_bbr_round_end(struct tcp *conn, uint32_t now)
+{
+	struct tcp_bbr *bbr = &conn->ca.bbr;
+	uint32_t bw = bbr->round_delivered / MAX(now - bbr->round_start, 1U);
+	bool app_limited = conn->send_data_total <= conn->unacked_len;
+
+	bbr->round_count++;
+
+	/* A lower rate replaces an old maximum, unless the application did
+	 * not have data to send.
+	 */
+	if (bw >= bbr->max_bw ||
+	    ((uint16_t)(bbr->round_count - bbr->max_bw_round) > BBR_BW_ROUNDS &&
+	     !app_limited)) {
+		bbr->max_bw = bw;
+		bbr->max_bw_round = bbr->round_count;
+	}
+
+	switch (bbr->mode) {
+	case BBR_STARTUP:
+		if ((uint64_t)bbr->max_bw * BBR_UNIT >=
+		    (uint64_t)bbr->full_bw * BBR_FULL_BW_GROWTH) {
+			bbr->full_bw = bbr->max_bw;
+			bbr->full_bw_count = 0;
+		} else if (!app_limited && ++bbr->full_bw_count >= BBR_FULL_BW_ROUNDS) {
+			bbr->mode = BBR_DRAIN;
+		}
+		break;
+	case BBR_PROBE_BW:
+		bbr->cycle = (bbr->cycle + 1) % ARRAY_SIZE(bbr_cycle_gain);
+		break;
+	default:
+		break;
+	}
+
+	bbr->round_start = now;
+	bbr->round_end = conn->seq + conn->unacked_len;
+	bbr->round_delivered = 0;
+}
+
+static void tcp_bbr_update_mode(struct tcp *conn, uint32_t now)
+{
+	struct tcp_bbr *bbr = &conn->ca.bbr;
+
+	if (bbr->mode == BBR_DRAIN &&
+	    conn->unacked_len <= tcp_bbr_bdp(conn, BBR_UNIT)) {
+		/* Start cruising, the up and down probing comes later */
+		bbr->mode = BBR_PROBE_BW;
+		bbr->cycle = 2;
+	}
+
+	if (bbr->mode != BBR_PROBE_RTT && bbr->min_rtt != UINT32_MAX &&
+	    now - bbr->min_rtt_stamp > BBR_MIN_RTT_MS) {
+		/* Empty the queues to measure the round trip time again */
+		bbr->mode = BBR_PROBE_RTT;
+		bbr->probe_rtt_end = now + MAX(BBR_PROBE_RTT_MS, bbr->min_rtt);
+	}
+
+	if (bbr->mode == BBR_PROBE_RTT &&
+	    (int32_t)(now - bbr->probe_rtt_end) >= 0) {
+		bbr->min_rtt_stamp = now;
+		bbr->mode = tcp_bbr_full_bw_reached(bbr) ? BBR_PROBE_BW : BBR_STARTUP;
+		bbr->cycle = 2;
+	}
+}
+
+static void tcp_bbr_pkts_acked(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_bbr *bbr = &conn->ca.bbr;
+	uint32_t now = k_uptime_get_32();
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t target;
+
+	if (conn->ca.pending_fast_retransmit_bytes > 0) {
+		conn->ca.pending_fast_retransmit_bytes -=
+			MIN(conn->ca.pending_fast_retransmit_bytes, acked_len);
+	}
+
+	bbr->round_delivered += acked_len;
+	if (!net_tcp_seq_greater(bbr->round_end, conn->seq + acked_len)) {
+		tcp_bbr_round_end(conn, now);
+	}
+
+	tcp_bbr_update_mode(conn, now);
+
+	switch (bbr->mode) {
+	case BBR_STARTUP:
+		target = tcp_bbr_bdp(conn, BBR_HIGH_GAIN);
+		break;
+	case BBR_DRAIN:
+		target = tcp_bbr_bdp(conn, BBR_UNIT);
+		break;
+	case BBR_PROBE_BW:
+		target = tcp_bbr_bdp(conn, bbr_cycle_gain[bbr->cycle]);
+		break;
+	default:
+		target = tcp_bbr_min_cwnd(conn);
+		break;
+	}
+
+	if (target == 0) {
+		/* Nothing measured yet, grow as in slow start */
+		target = TCP_WIN_MAX;
+	}
+
+	/* Grow towards the target as data is delivered, shrink at once */
+	cwnd = MIN(cwnd + acked_len, target);
+	conn->ca.cwnd = MAX(cwnd, MIN(tcp_bbr_min_cwnd(conn), target));
+
+	NET_DBG("conn: %p bbr mode=%u, max_bw=%u B/ms, min_rtt=%u, cycle=%u",
+		conn, bbr->mode, bbr->max_bw, bbr->min_rtt, bbr->cycle);
+}
+
+/* The model is not changed by the loss of a few segments */
+static void tcp_bbr_fast_retransmit(struct tcp *conn)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
+	}
+}
+
+static void tcp_bbr_timeout(struct tcp *conn)
+{
+	conn->ca.pending_fast_retransmit_bytes = 0;
+	conn->ca.cwnd = conn_mss(conn);
+}
+
+const struct tcp_ca_ops tcp_bbr_ops = {
+	.name = "bbr",
+	.init = tcp_bbr_init,
+	.fast_retransmit = tcp_bbr_fast_retransmit,
+	.timeout = tcp_bbr_timeout,
+	.pkts_acked = tcp_bbr_pkts_acked,
+	.rtt_sample = tcp_bbr_rtt_sample,
+};
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* CUBIC congestion control, RFC 9438. The fast recovery is NewReno's. */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_context.h>
+#include "tcp_internal.h"
+
+/* Multiplicative decrease factor and cubic constant, in thousandths */
+#define CUBIC_BETA 700
+#define CUBIC_C    400
+
+/* Additive increase of the Reno friendly window, 3 * (1 - beta) / (1 + beta) */
+#define CUBIC_ALPHA 529
+
+/* Times farther from K are not worth computing, the window is at its max */
+#define CUBIC_MAX_T_MS 30000
+
+static uint32_t cubic_root(uint64_t a)
+{
+	uint64_t x = 0;
+
+	for (int shift = 63; shift >= 0; shift -= 3) {
+		x <<= 1;
+
+		/* Try the next bit, (x + 1)^3 - x^3 = 3x(x + 1) + 1 */
+		if ((a >> shift) >= 3 * x * (x + 1) + 1) {
+			a -= (3 * x * (x + 1) + 1) << shift;
+			x++;
+		}
+	}
+
+	return (uint32_t)x;
+}
+
+static void tcp_cubic_init(struct tcp *conn)
+{
+	struct tcp_cubic *cubic = &conn->ca.cubic;
+
+	cubic->w_max = 0;
+	cubic->w_est = 0;
+	cubic->k = 0;
+	cubic->epoch_start = 0;
+}
+
+/* Reduce the window by beta, remembering where the loss happened */
+static void tcp_cubic_loss(struct tcp *conn)
+{
+	struct tcp_cubic *cubic = &conn->ca.cubic;
+	uint32_t flight = conn->unacked_len;
+
+	/* Fast convergence, leave room to the newer flows */
+	if (flight < cubic->w_max) {
+		cubic->w_max = (uint32_t)((uint64_t)flight * (1000 + CUBIC_BETA) / 2000);
+	} else {
+		cubic->w_max = flight;
+	}
+
+	conn->ca.ssthresh = MAX((uint32_t)((uint64_t)flight * CUBIC_BETA / 1000),
+				2U * conn_mss(conn));
+	cubic->epoch_start = 0;
+}
+
+static void tcp_cubic_fast_retransmit(struct tcp *conn)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		tcp_cubic_loss(conn);
+		/* Account for the lost segments */
+		conn->ca.cwnd = conn_mss(conn) * 3 + conn->ca.ssthresh;
+		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
+	}
+}
+
+static void tcp_cubic_timeout(struct tcp *conn)
+{
+	tcp_cubic_loss(conn);
+	conn->ca.cwnd = conn_mss(conn);
+}
+
+/* Window at t ms of the epoch, W_cubic(t) = C * (t - K)^3 + W_max */
+static uint32_t tcp_cubic_window(struct tcp *conn, uint32_t t)
+{
+	struct tcp_cubic *cubic = &conn->ca.cubic;
+	uint64_t dt = t > cubic->k ? t - cubic->k : cubic->k - t;
+	uint64_t delta;
+
+	dt = MIN(dt, CUBIC_MAX_T_MS);
+
+	/* In bytes, the times are in ms and C is in segments per s^3 */
+	delta = dt * dt * dt * CUBIC_C / 1000 * conn_mss(conn) / 1000000000ULL;
+
+	if (t > cubic->k) {
+		return (uint32_t)MIN(cubic->w_max + delta, (uint64_t)TCP_WIN_MAX);
+	}
+
+	return delta < cubic->w_max ? cubic->w_max - (uint32_t)delta : 0;
+}
+
+static void tcp_cubic_pkts_acked(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_cubic *cubic = &conn->ca.cubic;
+	uint32_t mss = conn_mss(conn);
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t now = k_uptime_get_32();
+	uint32_t target;
+	uint64_t inc;
+
+	if (tcp_new_reno_recovery(conn, acked_len)) {
+		return;
+	}
+
+	if (cwnd < conn->ca.ssthresh) {
+		conn->ca.cwnd = MIN(cwnd + MIN(acked_len, mss), TCP_WIN_MAX);
+		return;
+	}
+
+	if (cubic->epoch_start == 0) {
+		/* A new congestion avoidance epoch, 0 means none */
+		cubic->epoch_start = now != 0 ? now : 1;
+		cubic->w_est = cwnd;
+
+		if (cwnd < cubic->w_max) {
+			/* K = cbrt((W_max - cwnd) / C), in ms */
+			cubic->k = cubic_root((uint64_t)(cubic->w_max - cwnd) * 1000U / mss *
+					      1000000000ULL / CUBIC_C);
+		} else {
+			cubic->k = 0;
+			cubic->w_max = cwnd;
+		}
+	}
+
+	/* The window Reno would have, not to do worse than it, RFC 9438 ch 4.3 */
+	cubic->w_est += (uint32_t)((uint64_t)CUBIC_ALPHA * mss * acked_len / 1000 / cwnd);
+
+	/* Aim at the window one round trip ahead, RFC 9438 ch 4.2 */
+	target = tcp_cubic_window(conn, now - cubic->epoch_start +
+				  (conn->srtt >> 3));
+	target = CLAMP(target, cwnd, cwnd + cwnd / 2);
+	target = MAX(target, cubic->w_est);
+
+	if (target > cwnd) {
+		inc = (uint64_t)(target - cwnd) * acked_len / cwnd;
+	} else {
+		/* Plateau, grow very slowly */
+		inc = (uint64_t)mss * acked_len / 100 / cwnd;
+	}
+
+	conn->ca.cwnd = (uint32_t)MIN(cwnd + MAX(inc, 1), (uint64_t)TCP_WIN_MAX);
+
+	NET_DBG("conn: %p cubic w_max=%u, k=%u, w_est=%u, target=%u", conn,
+		cubic->w_max, cubic->k, cubic->w_est, target);
+}
+
+const struct tcp_ca_ops tcp_cubic_ops = {
+	.name = "cubic",
+	.init = tcp_cubic_init,
+	.fast_retransmit = tcp_cubic_fast_retransmit,
+	.timeout = tcp_cubic_timeout,
+	.dup_ack = tcp_new_reno_dup_ack,
+	.pkts_acked = tcp_cubic_pkts_acked,
+};
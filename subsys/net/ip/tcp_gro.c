@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Coalescing of received TCP segments. While the RX queue has packets
+ * waiting, the in-order data segments of a connection are appended to the
+ * first one, which is handed to TCP once the queue is empty. Only segments
+ * acknowledging the same data with the same window and options are merged,
+ * so that TCP sees what it would have seen from the last one of them.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/net/net_pkt.h>
+#include <string.h>
+
+#include "ipv4.h"
+#include "ipv6.h"
+#include "connection.h"
+#include "net_private.h"
+#include "net_stats.h"
+#include "tcp_internal.h"
+
+struct tcp_gro_flow {
+	struct net_pkt *pkt;	/* Segments merged so far, NULL if free */
+	uint32_t next_seq;	/* Sequence number of the segment to append */
+};
+
+static struct tcp_gro_flow gro_flows[CONFIG_NET_TCP_GRO_FLOWS];
+static uint8_t gro_evict;
+static K_MUTEX_DEFINE(gro_lock);
+
+static size_t gro_ip_len(struct net_pkt *pkt)
+{
+	return net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+}
+
+static struct net_tcp_hdr *gro_tcp_hdr(struct net_pkt *pkt)
+{
+	return (struct net_tcp_hdr *)(pkt->buffer->data + gro_ip_len(pkt));
+}
+
+/* Length of the IP and TCP headers, 0 if they are not all in the first
+ * buffer. The headers of the packets merged are accessed in place.
+ */
+static size_t gro_hdr_len(struct net_pkt *pkt)
+{
+	size_t ip_len = gro_ip_len(pkt);
+	size_t len;
+
+	if (pkt->buffer == NULL ||
+	    pkt->buffer->len < ip_len + sizeof(struct net_tcp_hdr)) {
+		return 0;
+	}
+
+	len = ip_len + (gro_tcp_hdr(pkt)->offset >> 4) * 4U;
+
+	return len <= pkt->buffer->len ? len : 0;
+}
+
+/* Data segments only acknowledging and maybe pushing data, in a packet
+ * without IP options which was not reassembled.
+ */
+static bool gro_can_merge(struct net_pkt *pkt, size_t hdr_len)
+{
+	if (net_pkt_ip_opts_len(pkt) > 0 || net_pkt_is_ip_reassembled(pkt)) {
+		return false;
+	}
+
+	if ((gro_tcp_hdr(pkt)->flags & ~PSH) != ACK) {
+		return false;
+	}
+
+	return net_pkt_get_len(pkt) > hdr_len;
+}
+
+static bool gro_same_flow(struct net_pkt *held, struct net_pkt *pkt)
+{
+	struct net_tcp_hdr *held_hdr = gro_tcp_hdr(held);
+	struct net_tcp_hdr *tcp_hdr = gro_tcp_hdr(pkt);
+
+	if (net_pkt_iface(held) != net_pkt_iface(pkt) ||
+	    net_pkt_family(held) != net_pkt_family(pkt) ||
+	    held_hdr->src_port != tcp_hdr->src_port ||
+	    held_hdr->dst_port != tcp_hdr->dst_port) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		return memcmp(NET_IPV4_HDR(held)->src, NET_IPV4_HDR(pkt)->src,
+			      2 * sizeof(struct in_addr)) == 0;
+	}
+
+	return memcmp(NET_IPV6_HDR(held)->src, NET_IPV6_HDR(pkt)->src,
+		      2 * sizeof(struct in6_addr)) == 0;
+}
+
+/* The segment follows the held ones and has the same headers, apart from
+ * the sequence number, the flags and the lengths.
+ */
+static bool gro_can_append(struct tcp_gro_flow *flow, struct net_pkt *pkt,
+			   size_t hdr_len)
+{
+	struct net_pkt *held = flow->pkt;
+	struct net_tcp_hdr *held_hdr = gro_tcp_hdr(held);
+	struct net_tcp_hdr *tcp_hdr = gro_tcp_hdr(pkt);
+	size_t opts_len = hdr_len - gro_ip_len(pkt) - sizeof(struct net_tcp_hdr);
+
+	if (gro_hdr_len(held) != hdr_len ||
+	    sys_get_be32(tcp_hdr->seq) != flow->next_seq ||
+	    memcmp(held_hdr->ack, tcp_hdr->ack, sizeof(tcp_hdr->ack)) != 0 ||
+	    memcmp(held_hdr->wnd, tcp_hdr->wnd, sizeof(tcp_hdr->wnd)) != 0 ||
+	    memcmp(held_hdr->optdata, tcp_hdr->optdata, opts_len) != 0) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		if (NET_IPV4_HDR(held)->tos != NET_IPV4_HDR(pkt)->tos ||
+		    NET_IPV4_HDR(held)->ttl != NET_IPV4_HDR(pkt)->ttl) {
+			return false;
+		}
+	} else if (memcmp(NET_IPV6_HDR(held), NET_IPV6_HDR(pkt), 4) != 0 ||
+		   NET_IPV6_HDR(held)->hop_limit != NET_IPV6_HDR(pkt)->hop_limit) {
+		/* Traffic class and flow label */
+		return false;
+	}
+
+	return net_pkt_get_len(held) + net_pkt_get_len(pkt) - 2 * hdr_len <=
+	       CONFIG_NET_TCP_GRO_MAX_SIZE;
+}
+
+/* Move the data of the segment at the end of the held packet */
+static void gro_append(struct tcp_gro_flow *flow, struct net_pkt *pkt,
+		       size_t hdr_len)
+{
+	struct net_pkt *held = flow->pkt;
+
+	gro_tcp_hdr(held)->flags |= gro_tcp_hdr(pkt)->flags & PSH;
+	flow->next_seq += net_pkt_get_len(pkt) - hdr_len;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_pull(pkt, hdr_len);
+	net_pkt_trim_buffer(pkt);
+
+	net_pkt_append_buffer(held, pkt->buffer);
+	pkt->buffer = NULL;
+
+	net_pkt_unref(pkt);
+}
+
+/* The IP length covers the merged data. The TCP checksum is left as it is,
+ * it was verified for each segment.
+ */
+static void gro_deliver(struct net_pkt *pkt)
+{
+	union net_proto_header proto_hdr;
+	union net_ip_header ip_hdr;
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		ip_hdr.ipv4 = NET_IPV4_HDR(pkt);
+		ip_hdr.ipv4->len = htons(net_pkt_get_len(pkt));
+		ip_hdr.ipv4->chksum = 0U;
+		ip_hdr.ipv4->chksum = net_calc_chksum_ipv4(pkt);
+	} else {
+		ip_hdr.ipv6 = NET_IPV6_HDR(pkt);
+		ip_hdr.ipv6->len = htons(net_pkt_get_len(pkt) -
+					 sizeof(struct net_ipv6_hdr));
+	}
+
+	proto_hdr.tcp = gro_tcp_hdr(pkt);
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_conn_input(pkt, &ip_hdr, IPPROTO_TCP, &proto_hdr) == NET_DROP) {
+		if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+			net_stats_update_ipv4_drop(net_pkt_iface(pkt));
+		} else {
+			net_stats_update_ipv6_drop(net_pkt_iface(pkt));
+		}
+
+		net_pkt_unref(pkt);
+	}
+}
+
+bool net_tcp_gro_receive(struct net_pkt *pkt)
+{
+	size_t hdr_len = gro_hdr_len(pkt);
+	struct tcp_gro_flow *flow = NULL;
+	struct tcp_gro_flow *free_flow = NULL;
+	struct net_pkt *flush = NULL;
+	bool taken = false;
+	uint8_t flags;
+
+	if (hdr_len == 0) {
+		/* Cannot tell the connection, keep the order of all of them */
+		net_tcp_gro_flush();
+		return false;
+	}
+
+	flags = gro_tcp_hdr(pkt)->flags;
+
+	k_mutex_lock(&gro_lock, K_FOREVER);
+
+	ARRAY_FOR_EACH_PTR(gro_flows, f) {
+		if (f->pkt == NULL) {
+			if (free_flow == NULL) {
+				free_flow = f;
+			}
+		} else if (gro_same_flow(f->pkt, pkt)) {
+			flow = f;
+			break;
+		}
+	}
+
+	if (flow != NULL) {
+		if (gro_can_merge(pkt, hdr_len) &&
+		    gro_can_append(flow, pkt, hdr_len)) {
+			gro_append(flow, pkt, hdr_len);
+			taken = true;
+
+			if (!(flags & PSH)) {
+				goto out;
+			}
+		}
+
+		/* The merged segments go first, then this one if it was
+		 * not appended.
+		 */
+		flush = flow->pkt;
+		flow->pkt = NULL;
+		goto out;
+	}
+
+	if (!gro_can_merge(pkt, hdr_len) || (flags & PSH)) {
+		goto out;
+	}
+
+	if (free_flow == NULL) {
+		free_flow = &gro_flows[gro_evict];
+		gro_evict = (gro_evict + 1) % ARRAY_SIZE(gro_flows);
+		flush = free_flow->pkt;
+	}
+
+	free_flow->pkt = pkt;
+	free_flow->next_seq = sys_get_be32(gro_tcp_hdr(pkt)->seq) +
+			      net_pkt_get_len(pkt) - hdr_len;
+	taken = true;
+
+out:
+	k_mutex_unlock(&gro_lock);
+
+	if (flush != NULL) {
+		gro_deliver(flush);
+	}
+
+	return taken;
+}
+
+void net_tcp_gro_flush(void)
+{
+	struct net_pkt *held[CONFIG_NET_TCP_GRO_FLOWS];
+	size_t count = 0;
+
+	k_mutex_lock(&gro_lock, K_FOREVER);
+
+	ARRAY_FOR_EACH_PTR(gro_flows, f) {
+		if (f->pkt != NULL) {
+			held[count++] = f->pkt;
+			f->pkt = NULL;
+		}
+	}
+
+	k_mutex_unlock(&gro_lock);
+
+	for (size_t i = 0; i < count; i++) {
+		gro_deliver(held[i]);
+	}
+}
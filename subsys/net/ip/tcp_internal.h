@@ -36,6 +36,8 @@ enum tcp_conn_option {
 	TCP_OPT_KEEPIDLE = 3,
 	TCP_OPT_KEEPINTVL = 4,
 	TCP_OPT_KEEPCNT = 5,
+	TCP_OPT_CONGESTION = 6,
+	TCP_OPT_INFO = 7,
 };
 
 /**
@@ -286,6 +288,54 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 }
 #endif
 
+/**
+ * @brief Cut the next segment out of a TCP packet built for segmentation
+ *        offload, see net_pkt_tso_size().
+ *
+ * @param pkt TCP packet carrying several segments
+ * @param offset Offset of the next segment in the payload, updated
+ * @param seg The segment, NULL once the whole payload has been segmented
+ *        or on error
+ *
+ * @return 0 on success, negative errno otherwise
+ */
+#if defined(CONFIG_NET_TCP_TSO)
+int net_tcp_tso_segment(struct net_pkt *pkt, size_t *offset,
+			struct net_pkt **seg);
+#endif
+
+/**
+ * @brief Merge a received TCP segment with the previous ones of its
+ *        connection, see net_tcp_gro_flush().
+ *
+ * @param pkt Received TCP packet, its checksum verified
+ *
+ * @return True if the packet was taken, false if it must be handed to
+ *         net_conn_input() now.
+ */
+#if defined(CONFIG_NET_TCP_GRO)
+bool net_tcp_gro_receive(struct net_pkt *pkt);
+#else
+static inline bool net_tcp_gro_receive(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return false;
+}
+#endif
+
+/**
+ * @brief Hand the segments merged so far to the connections. Called once
+ *        the received packets waiting to be processed have all been.
+ */
+#if defined(CONFIG_NET_TCP_GRO)
+void net_tcp_gro_flush(void);
+#else
+static inline void net_tcp_gro_flush(void)
+{
+}
+#endif
+
 /**
  * @brief Enqueue data for transmission
  *
@@ -146,7 +146,7 @@
 #define conn_send_data_dump(_conn)                                             \
 	({                                                                     \
 		NET_DBG("conn: %p total=%zd, unacked_len=%d, "                 \
-			"send_win=%hu, mss=%hu",                               \
+			"send_win=%u, mss=%hu",                                \
 			(_conn), net_pkt_get_len((_conn)->send_data),          \
 			_conn->unacked_len, _conn->send_win,                   \
 			(uint16_t)conn_mss((_conn)));                          \
@@ -192,10 +192,6 @@ enum th_flags {
 	CWR = BIT(7),
 };
 
-struct tcp_mss_option {
-	uint32_t option;
-};
-
 enum tcp_state {
 	TCP_UNUSED = 0,
 	TCP_LISTEN,
@@ -227,31 +223,133 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
+#define NET_TCP_TIMESTAMP_OPT    8
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+#define NET_TCP_TIMESTAMP_SIZE    10
+
+/* TCP header max options size */
+#define NET_TCP_MAX_OPT_SIZE      40
+
+/* Largest window scale shift, RFC 7323 ch 2.3 */
+#define NET_TCP_MAX_WINDOW_SCALE  14
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+#define TCP_WIN_MAX (UINT16_MAX << NET_TCP_MAX_WINDOW_SCALE)
+#else
+#define TCP_WIN_MAX UINT16_MAX
+#endif
+
+/* Most SACK blocks that fit in the options */
+#define NET_TCP_MAX_SACK_BLOCKS   4
+
+/* Blocks of data reported by the peer the sender keeps track of */
+#define NET_TCP_SACK_SCOREBOARD_SIZE 8
+
+struct tcp_sack_block {
+	uint32_t left;  /* First sequence number of the block */
+	uint32_t right; /* Sequence number following the block */
+};
 
 struct tcp_options {
 	uint16_t mss;
-	uint16_t window;
+	uint16_t window; /* Window scale shift */
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	uint32_t tsval;
+	uint32_t tsecr;
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_block sack[NET_TCP_MAX_SACK_BLOCKS];
+	uint8_t sack_count;
+#endif
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
+	bool ts_found : 1;
 };
 
+struct tcp;
+typedef void (*net_tcp_closed_cb_t)(struct tcp *conn, void *user_data);
+
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
-struct tcp_collision_avoidance_reno {
-	uint16_t cwnd;
-	uint16_t ssthresh;
-	uint16_t pending_fast_retransmit_bytes;
+/* A congestion control algorithm, called with the connection locked */
+struct tcp_ca_ops {
+	const char *name;
+	/* The connection is established, cwnd and ssthresh are initialized */
+	void (*init)(struct tcp *conn);
+	/* Three duplicate ACKs were received and the data retransmitted */
+	void (*fast_retransmit)(struct tcp *conn);
+	/* The retransmission timer expired */
+	void (*timeout)(struct tcp *conn);
+	/* A duplicate ACK was received, optional */
+	void (*dup_ack)(struct tcp *conn);
+	/* New data was acknowledged */
+	void (*pkts_acked)(struct tcp *conn, uint32_t acked_len);
+	/* A round trip time in ms was measured, optional */
+	void (*rtt_sample)(struct tcp *conn, uint32_t rtt);
+};
+
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+extern const struct tcp_ca_ops tcp_cubic_ops;
+
+struct tcp_cubic {
+	uint32_t w_max;       /* Window when the last loss happened */
+	uint32_t w_est;       /* Window Reno would have reached */
+	uint32_t k;           /* Time to grow back to w_max, in ms */
+	uint32_t epoch_start; /* Start of the growth in ms, 0 until the next ACK */
 };
 #endif
 
-struct tcp;
-typedef void (*net_tcp_closed_cb_t)(struct tcp *conn, void *user_data);
+#ifdef CONFIG_NET_TCP_CONGESTION_BBR
+extern const struct tcp_ca_ops tcp_bbr_ops;
+
+struct tcp_bbr {
+	uint32_t max_bw;          /* Largest delivery rate, in bytes per ms */
+	uint32_t min_rtt;         /* Smallest round trip time, in ms */
+	uint32_t min_rtt_stamp;   /* When min_rtt was measured */
+	uint32_t full_bw;         /* Delivery rate the startup last grew from */
+	uint32_t round_start;     /* When the round trip started */
+	uint32_t round_end;       /* Sequence number ending the round trip */
+	uint32_t round_delivered; /* Data acknowledged in the round trip */
+	uint32_t probe_rtt_end;   /* When the probe of the round trip time ends */
+	uint16_t round_count;
+	uint16_t max_bw_round;    /* Round trip max_bw was measured in */
+	uint8_t mode;
+	uint8_t cycle;            /* Phase of the bandwidth probing */
+	uint8_t full_bw_count;    /* Round trips the startup did not grow */
+};
+#endif
+
+struct tcp_congestion {
+	const struct tcp_ca_ops *ops;
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	uint32_t pending_fast_retransmit_bytes;
+	union {
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+		struct tcp_cubic cubic;
+#endif
+#ifdef CONFIG_NET_TCP_CONGESTION_BBR
+		struct tcp_bbr bbr;
+#endif
+	};
+};
+
+/* NewReno fast recovery (RFC 6582), shared with the other loss based
+ * algorithms. tcp_new_reno_recovery() returns true while it lasts.
+ */
+void tcp_new_reno_dup_ack(struct tcp *conn);
+bool tcp_new_reno_recovery(struct tcp *conn, uint32_t acked_len);
+#endif /* CONFIG_NET_TCP_CONGESTION_AVOIDANCE */
 
 struct tcp { /* TCP connection */
 	sys_snode_t next;
@@ -314,16 +412,38 @@ struct tcp { /* TCP connection */
 	uint32_t keep_cnt;
 	uint32_t keep_cur;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
-	uint16_t recv_win_sent;
-	uint16_t recv_win_max;
-	uint16_t recv_win;
-	uint16_t send_win_max;
-	uint16_t send_win;
-#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
+	uint32_t recv_win_sent;
+	uint32_t recv_win_max;
+	uint32_t recv_win;
+	uint32_t send_win_max;
+	uint32_t send_win;
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	uint32_t ts_offset; /* Offset of the timestamps we send */
+	uint32_t ts_recent; /* Timestamp to echo to the peer */
+#endif
+#if defined(CONFIG_NET_TCP_RTT_ESTIMATION)
+	uint32_t srtt;      /* Smoothed round trip time in ms, times 8 */
+	uint32_t rttvar;    /* Round trip time variation in ms, times 4 */
+	uint32_t rtt_seq;   /* Sequence number the timed segment ends at */
+	uint32_t rtt_start; /* When the timed segment was sent */
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	/* Scoreboard of the data the peer has reported, sorted */
+	struct tcp_sack_block sacked[NET_TCP_SACK_SCOREBOARD_SIZE];
+	uint32_t sack_recover; /* Data sent when the recovery started */
+	uint32_t sack_rexmit;  /* Next data to retransmit in the recovery */
+	uint32_t sack_last;    /* Last out-of-order data queued */
+	uint8_t sacked_count;
+#endif
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_TIMESTAMPS)
 	uint16_t rto;
 #endif
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	uint8_t snd_wscale; /* Shift of the windows the peer advertises */
+	uint8_t rcv_wscale; /* Shift of the windows we advertise */
+#endif
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
-	struct tcp_collision_avoidance_reno ca;
+	struct tcp_congestion ca;
 #endif
 	uint8_t send_data_retries;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
@@ -339,6 +459,16 @@ struct tcp { /* TCP connection */
 	bool tcp_nodelay : 1;
 	bool addr_ref_done : 1;
 	bool rst_received : 1;
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	bool ts_ok : 1;
+#endif
+#if defined(CONFIG_NET_TCP_RTT_ESTIMATION)
+	bool rtt_timing : 1; /* A segment ending at rtt_seq is timed */
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	bool sack_ok : 1;
+	bool sack_recovery : 1;
+#endif
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
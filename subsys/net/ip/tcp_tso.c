@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* TCP segmentation offload done in software. TCP sends packets carrying
+ * several segments worth of data, the network interface cuts them just
+ * before they are given to a device which cannot do it itself.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/net/net_pkt.h>
+#include <string.h>
+
+#include "ipv4.h"
+#include "ipv6.h"
+#include "tcp_internal.h"
+
+#define TSO_ALLOC_TIMEOUT K_MSEC(CONFIG_NET_TCP_PKT_ALLOC_TIMEOUT)
+
+static void tso_copy_attributes(struct net_pkt *pkt, struct net_pkt *seg)
+{
+	net_pkt_set_family(seg, net_pkt_family(pkt));
+	net_pkt_set_context(seg, net_pkt_context(pkt));
+	net_pkt_set_ip_hdr_len(seg, net_pkt_ip_hdr_len(pkt));
+	net_pkt_set_ip_dscp(seg, net_pkt_ip_dscp(pkt));
+	net_pkt_set_ip_ecn(seg, net_pkt_ip_ecn(pkt));
+	net_pkt_set_vlan_tag(seg, net_pkt_vlan_tag(pkt));
+	net_pkt_set_priority(seg, net_pkt_priority(pkt));
+	net_pkt_set_ll_proto_type(seg, net_pkt_ll_proto_type(pkt));
+
+	memcpy(net_pkt_lladdr_src(seg), net_pkt_lladdr_src(pkt),
+	       sizeof(struct net_linkaddr));
+	memcpy(net_pkt_lladdr_dst(seg), net_pkt_lladdr_dst(pkt),
+	       sizeof(struct net_linkaddr));
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		net_pkt_set_ipv4_ttl(seg, net_pkt_ipv4_ttl(pkt));
+		net_pkt_set_ipv4_opts_len(seg, net_pkt_ipv4_opts_len(pkt));
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
+		net_pkt_set_ipv6_hop_limit(seg, net_pkt_ipv6_hop_limit(pkt));
+		net_pkt_set_ipv6_ext_len(seg, net_pkt_ipv6_ext_len(pkt));
+		net_pkt_set_ipv6_next_hdr(seg, net_pkt_ipv6_next_hdr(pkt));
+	}
+}
+
+/* Give the segment its sequence number and flags, only the last segment
+ * pushes the data and only the first one carries CWR.
+ */
+static int tso_update_header(struct net_pkt *seg, size_t ip_len, uint32_t seq,
+			     uint8_t flags)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	struct net_tcp_hdr *tcp_hdr;
+
+	net_pkt_cursor_init(seg);
+	net_pkt_set_overwrite(seg, true);
+
+	if (net_pkt_skip(seg, ip_len)) {
+		return -ENOBUFS;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(seg, &tcp_access);
+	if (!tcp_hdr) {
+		return -ENOBUFS;
+	}
+
+	sys_put_be32(seq, tcp_hdr->seq);
+	tcp_hdr->flags = flags;
+
+	return net_pkt_set_data(seg, &tcp_access);
+}
+
+int net_tcp_tso_segment(struct net_pkt *pkt, size_t *offset,
+			struct net_pkt **seg)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	struct net_tcp_hdr *tcp_hdr;
+	size_t hdr_len, data_len, len;
+	struct net_pkt *s;
+	uint8_t flags;
+	uint32_t seq;
+	int ret;
+
+	*seg = NULL;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, ip_len)) {
+		return -EINVAL;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (!tcp_hdr) {
+		return -ENOBUFS;
+	}
+
+	hdr_len = ip_len + (tcp_hdr->offset >> 4) * 4U;
+	flags = tcp_hdr->flags;
+	seq = sys_get_be32(tcp_hdr->seq);
+
+	if (net_pkt_get_len(pkt) < hdr_len) {
+		return -EINVAL;
+	}
+
+	data_len = net_pkt_get_len(pkt) - hdr_len;
+	if (*offset >= data_len) {
+		return 0;
+	}
+
+	len = MIN(net_pkt_tso_size(pkt), data_len - *offset);
+
+	s = net_pkt_alloc_with_buffer(net_pkt_iface(pkt), hdr_len + len,
+				      AF_UNSPEC, 0, TSO_ALLOC_TIMEOUT);
+	if (!s) {
+		return -ENOBUFS;
+	}
+
+	tso_copy_attributes(pkt, s);
+
+	/* The headers, then this segment of the data with its checksum */
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_copy(s, pkt, hdr_len) ||
+	    net_pkt_skip(pkt, *offset) ||
+	    net_pkt_copy_chksum(s, pkt, len)) {
+		ret = -ENOBUFS;
+		goto fail;
+	}
+
+	if (*offset + len < data_len) {
+		flags &= ~(PSH | FIN);
+	}
+
+	if (*offset > 0) {
+		flags &= ~CWR;
+	}
+
+	ret = tso_update_header(s, ip_len, seq + *offset, flags);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(s);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(s) == AF_INET) {
+		/* The header checksum copied is the one of the whole packet */
+		NET_IPV4_HDR(s)->chksum = 0U;
+		ret = net_ipv4_finalize(s, IPPROTO_TCP);
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(s) == AF_INET6) {
+		ret = net_ipv6_finalize(s, IPPROTO_TCP);
+	} else {
+		ret = -EINVAL;
+	}
+
+	if (ret < 0) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(s);
+
+	NET_DBG("pkt %p segment %p seq %u len %zu", pkt, s, seq + *offset, len);
+
+	*offset += len;
+	*seg = s;
+
+	return 0;
+
+fail:
+	net_pkt_unref(s);
+
+	return ret;
+}
@@ -179,6 +179,15 @@ struct net_udp_hdr *net_udp_input(struct net_pkt *pkt,
 			goto drop;
 		}
 
+		if (IS_ENABLED(CONFIG_NET_CHKSUM_COPY)) {
+			/* The connection decides who verifies it, a socket
+			 * does it while it copies the data.
+			 */
+			net_pkt_set_chksum_pending(pkt, true);
+			net_pkt_set_chksum_partial(pkt, 0U, 0U);
+			goto out;
+		}
+
 		if (net_calc_verify_chksum_udp(pkt) != 0U) {
 			NET_DBG("DROP: checksum mismatch");
 			goto drop;
@@ -190,3 +199,18 @@ drop:
 	net_stats_update_udp_chkerr(net_pkt_iface(pkt));
 	return NULL;
 }
+
+#if defined(CONFIG_NET_CHKSUM_COPY) && defined(CONFIG_NET_NATIVE_UDP)
+int net_udp_verify_pending_chksum(struct net_pkt *pkt)
+{
+	net_pkt_set_chksum_pending(pkt, false);
+
+	if (net_calc_verify_chksum_udp(pkt) != 0U) {
+		NET_DBG("DROP: checksum mismatch");
+		net_stats_update_udp_chkerr(net_pkt_iface(pkt));
+		return -EBADMSG;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_NET_CHKSUM_COPY */
@@ -97,6 +97,27 @@ struct net_udp_hdr *net_udp_input(struct net_pkt *pkt,
 }
 #endif
 
+/**
+ * @brief Verify the UDP checksum that net_udp_input() left to the receiver
+ *
+ * @details The payload bytes already summed by net_pkt_read_chksum() are
+ * not read again. The packet is no longer pending afterwards.
+ *
+ * @param pkt Network packet, its checksum pending
+ *
+ * @return 0 if the checksum is valid, -EBADMSG otherwise.
+ */
+#if defined(CONFIG_NET_CHKSUM_COPY) && defined(CONFIG_NET_NATIVE_UDP)
+int net_udp_verify_pending_chksum(struct net_pkt *pkt);
+#else
+static inline int net_udp_verify_pending_chksum(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+#endif
+
 /**
  * @brief Register a callback to be called when UDP packet
  * is received corresponding to received packet.
@@ -637,7 +637,8 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 }
 
 #if defined(CONFIG_NET_NATIVE_IP)
-static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
+/* Sum count bytes from the cursor, or up to the end of the packet */
+static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum, size_t count)
 {
 	struct net_pkt_cursor *cur = &pkt->cursor;
 	size_t len;
@@ -649,8 +650,14 @@ static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 	len = cur->buf->len - (cur->pos - cur->buf->data);
 
 	while (cur->buf) {
+		len = MIN(len, count);
 		sum = calc_chksum(sum, cur->pos, len);
 
+		count -= len;
+		if (count == 0) {
+			break;
+		}
+
 		cur->buf = cur->buf->frags;
 		if (!cur->buf || !cur->buf->len) {
 			break;
@@ -665,6 +672,7 @@ static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 			}
 
 			cur->pos++;
+			count--;
 			len = cur->buf->len - 1;
 		} else {
 			len = cur->buf->len;
@@ -674,27 +682,59 @@ static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 	return sum;
 }
 
+#if defined(CONFIG_NET_CHKSUM_COPY)
+/* Sum the transport data, the checksum of the end of the packet may already
+ * be known from the copy of its payload.
+ */
+static uint16_t pkt_calc_chksum_partial(struct net_pkt *pkt, uint16_t sum, size_t len)
+{
+	size_t partial_len = net_pkt_chksum_partial_len(pkt);
+	uint16_t partial = net_pkt_chksum_partial(pkt);
+	uint32_t total;
+
+	if (partial_len == 0 || partial_len > len) {
+		return pkt_calc_chksum(pkt, sum, SIZE_MAX);
+	}
+
+	sum = pkt_calc_chksum(pkt, sum, len - partial_len);
+
+	/* The partial sum starts at an odd offset, its bytes are swapped */
+	if ((len - partial_len) % 2) {
+		partial = BSWAP_16(partial);
+	}
+
+	total = (uint32_t)sum + partial;
+
+	return (uint16_t)((total & 0xffff) + (total >> 16));
+}
+#else
+#define pkt_calc_chksum_partial(pkt, sum, len) pkt_calc_chksum(pkt, sum, SIZE_MAX)
+#endif /* CONFIG_NET_CHKSUM_COPY */
+
 uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto)
 {
 	size_t len = 0U;
+	size_t data_len;
 	uint16_t sum = 0U;
 	struct net_pkt_cursor backup;
 	bool ow;
 
 	if (IS_ENABLED(CONFIG_NET_IPV4) &&
 	    net_pkt_family(pkt) == AF_INET) {
+		data_len = net_pkt_get_len(pkt) -
+			net_pkt_ip_hdr_len(pkt) -
+			net_pkt_ipv4_opts_len(pkt);
 		if (proto != IPPROTO_ICMP && proto != IPPROTO_IGMP) {
 			len = 2 * sizeof(struct in_addr);
-			sum = net_pkt_get_len(pkt) -
-				net_pkt_ip_hdr_len(pkt) -
-				net_pkt_ipv4_opts_len(pkt) + proto;
+			sum = data_len + proto;
 		}
 	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
 		   net_pkt_family(pkt) == AF_INET6) {
 		len = 2 * sizeof(struct in6_addr);
-		sum =  net_pkt_get_len(pkt) -
+		data_len = net_pkt_get_len(pkt) -
 			net_pkt_ip_hdr_len(pkt) -
-			net_pkt_ipv6_ext_len(pkt) + proto;
+			net_pkt_ipv6_ext_len(pkt);
+		sum = data_len + proto;
 	} else {
 		NET_DBG("Unknown protocol family %d", net_pkt_family(pkt));
 		return 0;
@@ -711,7 +751,7 @@ uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto)
 	sum = calc_chksum(sum, pkt->cursor.pos, len);
 	net_pkt_skip(pkt, len + net_pkt_ip_opts_len(pkt));
 
-	sum = pkt_calc_chksum(pkt, sum);
+	sum = pkt_calc_chksum_partial(pkt, sum, data_len);
 
 	sum = (sum == 0U) ? 0xffff : htons(sum);
 
@@ -935,6 +935,127 @@ void net_eth_carrier_off(struct net_if *iface)
 	}
 }
 
+#if defined(CONFIG_NET_L2_ETHERNET_NAPI)
+#if defined(CONFIG_NET_TC_THREAD_COOPERATIVE)
+#define NAPI_THREAD_PRIORITY K_PRIO_COOP(CONFIG_NET_L2_ETHERNET_NAPI_PRIO)
+#else
+#define NAPI_THREAD_PRIORITY K_PRIO_PREEMPT(CONFIG_NET_L2_ETHERNET_NAPI_PRIO)
+#endif
+
+static struct k_work_q napi_work_q;
+static K_KERNEL_STACK_DEFINE(napi_stack, CONFIG_NET_L2_ETHERNET_NAPI_STACK_SIZE);
+
+static void napi_poll(struct k_work *work)
+{
+	struct net_eth_napi *napi = CONTAINER_OF(work, struct net_eth_napi, work);
+	int count;
+
+	count = napi->poll(napi, CONFIG_NET_L2_ETHERNET_NAPI_BUDGET);
+
+	NET_DBG("iface %p received %d frame(s)", napi->iface, count);
+
+	if (count >= CONFIG_NET_L2_ETHERNET_NAPI_BUDGET) {
+		/* More frames are waiting, let the other drivers go first */
+		k_work_submit_to_queue(&napi_work_q, &napi->work);
+	}
+}
+
+void net_eth_napi_init(struct net_eth_napi *napi, struct net_if *iface,
+		       net_eth_napi_poll_t poll)
+{
+	napi->iface = iface;
+	napi->poll = poll;
+	k_work_init(&napi->work, napi_poll);
+}
+
+void net_eth_napi_schedule(struct net_eth_napi *napi)
+{
+	k_work_submit_to_queue(&napi_work_q, &napi->work);
+}
+
+int net_eth_napi_receive(struct net_eth_napi *napi, struct net_pkt *pkt)
+{
+	int ret;
+
+	ret = net_recv_data(napi->iface, pkt);
+	if (ret < 0) {
+		NET_DBG("iface %p dropped pkt %p (%d)", napi->iface, pkt, ret);
+		eth_stats_update_errors_rx(napi->iface);
+		net_pkt_unref(pkt);
+	}
+
+	return ret;
+}
+
+static int napi_init(void)
+{
+	k_work_queue_start(&napi_work_q, napi_stack,
+			   K_KERNEL_STACK_SIZEOF(napi_stack), NAPI_THREAD_PRIORITY,
+			   NULL);
+	k_thread_name_set(&napi_work_q.thread, "eth_napi");
+
+	return 0;
+}
+
+SYS_INIT(napi_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif /* CONFIG_NET_L2_ETHERNET_NAPI */
+
+#if defined(CONFIG_NET_L2_ETHERNET_RX_POOL)
+void net_eth_rx_pool_init(struct net_eth_rx_pool *pool)
+{
+	for (size_t i = 0; i < pool->count; i++) {
+		net_eth_rx_pool_put(pool, pool->data + i * pool->buf_size);
+	}
+}
+
+void *net_eth_rx_pool_get(struct net_eth_rx_pool *pool)
+{
+	stack_data_t data;
+
+	if (k_stack_pop(pool->free, &data, K_NO_WAIT) != 0) {
+		return NULL;
+	}
+
+	return UINT_TO_POINTER(data);
+}
+
+void net_eth_rx_pool_put(struct net_eth_rx_pool *pool, void *data)
+{
+	(void)k_stack_push(pool->free, POINTER_TO_UINT(data));
+}
+
+/* Destroy callback of the net_buf pool, the buffer is free again */
+void net_eth_rx_pool_release(struct net_eth_rx_pool *pool, struct net_buf *buf)
+{
+	net_eth_rx_pool_put(pool, buf->__buf);
+
+	net_buf_destroy(buf);
+}
+
+struct net_pkt *net_eth_rx_pool_wrap(struct net_eth_rx_pool *pool,
+				     struct net_if *iface, void *data,
+				     size_t len, k_timeout_t timeout)
+{
+	struct net_pkt *pkt;
+	struct net_buf *buf;
+
+	pkt = net_pkt_rx_alloc_on_iface(iface, timeout);
+	if (!pkt) {
+		return NULL;
+	}
+
+	buf = net_buf_alloc_with_data(pool->bufs, data, len, K_NO_WAIT);
+	if (!buf) {
+		net_pkt_unref(pkt);
+		return NULL;
+	}
+
+	net_pkt_append_buffer(pkt, buf);
+
+	return pkt;
+}
+#endif /* CONFIG_NET_L2_ETHERNET_RX_POOL */
+
 const struct device *net_eth_get_phy(struct net_if *iface)
 {
 	const struct device *dev = net_if_get_device(iface);
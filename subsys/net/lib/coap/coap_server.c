@@ -34,11 +34,32 @@ LOG_MODULE_DECLARE(net_coap, CONFIG_COAP_LOG_LEVEL);
 #define MAX_PENDINGS   CONFIG_COAP_SERVICE_PENDING_MESSAGES
 #define MAX_OBSERVERS  CONFIG_COAP_SERVICE_OBSERVERS
 #define MAX_POLL_FD    CONFIG_ZVFS_POLL_MAX
+#define NUM_WORKERS    CONFIG_COAP_SERVER_WORKERS
+#define WHEEL_SLOTS    CONFIG_COAP_SERVER_RETRANSMIT_SLOTS
+#define WHEEL_TICK     CONFIG_COAP_SERVER_RETRANSMIT_TICK
 
 BUILD_ASSERT(CONFIG_ZVFS_POLL_MAX > 0, "CONFIG_ZVFS_POLL_MAX can't be 0");
+BUILD_ASSERT(MAX_PENDINGS < UINT16_MAX && MAX_OBSERVERS < UINT16_MAX,
+	     "Pending messages and observers are indexed on 16 bits");
+
+struct coap_server_worker {
+	/* Socket pair to wake zsock_poll */
+	int control_socks[2];
+	uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+};
 
 static K_MUTEX_DEFINE(lock);
-static int control_socks[2];
+static struct coap_server_worker workers[NUM_WORKERS] = {
+	[0 ... NUM_WORKERS - 1] = {
+		.control_socks = { -1, -1 },
+	},
+};
+
+#if NUM_WORKERS > 1
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, NUM_WORKERS - 1,
+				   CONFIG_COAP_SERVER_STACK_SIZE);
+static struct k_thread worker_threads[NUM_WORKERS - 1];
+#endif
 
 #if defined(CONFIG_COAP_SERVER_PENDING_ALLOCATOR_STATIC)
 K_MEM_SLAB_DEFINE_STATIC(pending_data, CONFIG_COAP_SERVER_MESSAGE_SIZE,
@@ -81,20 +102,160 @@ static inline void coap_server_free(void *ptr)
 #endif
 }
 
+/* Chains of entries, as 1-based indexes of the entries in the head and in
+ * the array of the next ones.
+ */
+static void coap_chain_push(uint16_t *head, uint16_t *next, size_t i)
+{
+	next[i] = *head;
+	*head = i + 1;
+}
+
+static void coap_chain_remove(uint16_t *head, uint16_t *next, size_t i)
+{
+	for (uint16_t *link = head; *link != 0; link = &next[*link - 1]) {
+		if (*link == i + 1) {
+			*link = next[i];
+			next[i] = 0;
+			return;
+		}
+	}
+}
+
+static size_t coap_observer_bucket(const uint8_t *token, uint8_t tkl)
+{
+	uint32_t hash = 2166136261U;
+
+	/* FNV-1a */
+	for (uint8_t i = 0; i < tkl; i++) {
+		hash = (hash ^ token[i]) * 16777619U;
+	}
+
+	return hash % MAX_OBSERVERS;
+}
+
+static void coap_service_index_observer(const struct coap_service *service,
+					struct coap_resource *resource,
+					struct coap_observer *observer)
+{
+	struct coap_service_data *data = service->data;
+	size_t i = observer - data->observers;
+
+	data->observer_resource[i] = resource;
+	coap_chain_push(&data->observer_index[coap_observer_bucket(observer->token,
+								    observer->tkl)],
+			data->observer_next, i);
+}
+
+static void coap_service_unindex_observer(const struct coap_service *service,
+					  struct coap_observer *observer)
+{
+	struct coap_service_data *data = service->data;
+	size_t i = observer - data->observers;
+
+	coap_chain_remove(&data->observer_index[coap_observer_bucket(observer->token,
+								      observer->tkl)],
+			  data->observer_next, i);
+	data->observer_resource[i] = NULL;
+}
+
+/* Observer registered with the token, and from the address if not NULL */
+static struct coap_observer *coap_service_find_observer(const struct coap_service *service,
+							const struct sockaddr *addr,
+							const uint8_t *token, uint8_t tkl)
+{
+	struct coap_service_data *data = service->data;
+	struct coap_observer *obs;
+
+	if (tkl == 0U || tkl > COAP_TOKEN_MAX_LEN) {
+		return NULL;
+	}
+
+	for (uint16_t i = data->observer_index[coap_observer_bucket(token, tkl)]; i != 0;
+	     i = data->observer_next[i - 1]) {
+		obs = &data->observers[i - 1];
+
+		if (addr != NULL ? coap_find_observer(obs, 1, addr, token, tkl) != NULL :
+				   coap_find_observer_by_token(obs, 1, token, tkl) != NULL) {
+			return obs;
+		}
+	}
+
+	return NULL;
+}
+
+static inline int64_t coap_pending_expiry(const struct coap_pending *pending)
+{
+	return pending->t0 + pending->timeout;
+}
+
+static struct coap_pending *coap_service_find_pending(const struct coap_service *service,
+						      uint16_t id)
+{
+	struct coap_service_data *data = service->data;
+	struct coap_pending *pending;
+
+	for (uint16_t i = data->pending_index[id % MAX_PENDINGS]; i != 0;
+	     i = data->pending_next[i - 1]) {
+		pending = &data->pending[i - 1];
+
+		if (pending->timeout != 0 && pending->id == id) {
+			return pending;
+		}
+	}
+
+	return NULL;
+}
+
+/* Put the pending message in the slot of the wheel of its expiry, or in the
+ * first slot to process if it already expired.
+ */
+static void coap_service_schedule_pending(const struct coap_service *service, size_t i)
+{
+	struct coap_service_data *data = service->data;
+	int64_t tick = MAX(coap_pending_expiry(&data->pending[i]) / WHEEL_TICK,
+			   data->retransmit_tick);
+
+	data->retransmit_slot[i] = tick % WHEEL_SLOTS;
+	coap_chain_push(&data->retransmit_wheel[data->retransmit_slot[i]],
+			data->retransmit_next, i);
+}
+
+static void coap_service_track_pending(const struct coap_service *service,
+				       struct coap_pending *pending)
+{
+	struct coap_service_data *data = service->data;
+	size_t i = pending - data->pending;
+
+	coap_chain_push(&data->pending_index[pending->id % MAX_PENDINGS], data->pending_next, i);
+	coap_service_schedule_pending(service, i);
+}
+
+static void coap_service_clear_pending(const struct coap_service *service,
+				       struct coap_pending *pending)
+{
+	struct coap_service_data *data = service->data;
+	size_t i = pending - data->pending;
+
+	coap_chain_remove(&data->pending_index[pending->id % MAX_PENDINGS], data->pending_next, i);
+	coap_chain_remove(&data->retransmit_wheel[data->retransmit_slot[i]],
+			  data->retransmit_next, i);
+
+	coap_server_free(pending->data);
+	coap_pending_clear(pending);
+}
+
 static int coap_service_remove_observer(const struct coap_service *service,
 					struct coap_resource *resource,
 					const struct sockaddr *addr,
 					const uint8_t *token, uint8_t tkl)
 {
 	struct coap_observer *obs;
+	struct coap_resource *registered;
 
-	if (tkl > 0 && addr != NULL) {
-		/* Prefer addr+token to find the observer */
-		obs = coap_find_observer(service->data->observers, MAX_OBSERVERS, addr, token, tkl);
-	} else if (tkl > 0) {
-		/* Then try to find the observer by token */
-		obs = coap_find_observer_by_token(service->data->observers, MAX_OBSERVERS, token,
-						  tkl);
+	if (tkl > 0) {
+		/* Prefer addr+token to find the observer, or the token alone */
+		obs = coap_service_find_observer(service, addr, token, tkl);
 	} else if (addr != NULL) {
 		obs = coap_find_observer_by_addr(service->data->observers, MAX_OBSERVERS, addr);
 	} else {
@@ -106,25 +267,32 @@ static int coap_service_remove_observer(const struct coap_service *service,
 		return 0;
 	}
 
-	if (resource == NULL) {
-		COAP_SERVICE_FOREACH_RESOURCE(service, it) {
-			if (coap_remove_observer(it, obs)) {
-				memset(obs, 0, sizeof(*obs));
-				return 1;
-			}
-		}
-	} else if (coap_remove_observer(resource, obs)) {
-		memset(obs, 0, sizeof(*obs));
-		return 1;
+	registered = service->data->observer_resource[obs - service->data->observers];
+	if (registered == NULL || (resource != NULL && resource != registered)) {
+		return 0;
 	}
 
-	return 0;
+	if (!coap_remove_observer(registered, obs)) {
+		return 0;
+	}
+
+	coap_service_unindex_observer(service, obs);
+	memset(obs, 0, sizeof(*obs));
+
+	return 1;
 }
 
-static int coap_server_process(int sock_fd)
+/* Services are shared out between the workers in the order of their section */
+static inline int coap_service_worker(const struct coap_service *service)
 {
-	static uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	STRUCT_SECTION_START_EXTERN(coap_service);
+
+	return (service - STRUCT_SECTION_START(coap_service)) % NUM_WORKERS;
+}
 
+static int coap_server_process(struct coap_server_worker *worker, int sock_fd)
+{
+	uint8_t *buf = worker->buf;
 	struct sockaddr client_addr;
 	socklen_t client_addr_len = sizeof(client_addr);
 	struct coap_service *service = NULL;
@@ -141,7 +309,8 @@ static int coap_server_process(int sock_fd)
 		flags |= ZSOCK_MSG_TRUNC;
 	}
 
-	received = zsock_recvfrom(sock_fd, buf, sizeof(buf), flags, &client_addr, &client_addr_len);
+	received = zsock_recvfrom(sock_fd, buf, sizeof(worker->buf), flags, &client_addr,
+				  &client_addr_len);
 
 	if (received < 0) {
 		if (errno == EWOULDBLOCK) {
@@ -152,7 +321,8 @@ static int coap_server_process(int sock_fd)
 		return -errno;
 	}
 
-	ret = coap_packet_parse(&request, buf, MIN(received, sizeof(buf)), options, opt_num);
+	ret = coap_packet_parse(&request, buf, MIN(received, sizeof(worker->buf)), options,
+				opt_num);
 	if (ret < 0) {
 		LOG_ERR("Failed To parse coap message (%d)", ret);
 		return ret;
@@ -167,49 +337,50 @@ static int coap_server_process(int sock_fd)
 		}
 	}
 	if (service == NULL) {
-		ret = -ENOENT;
-		goto unlock;
+		(void)k_mutex_unlock(&lock);
+		return -ENOENT;
 	}
 
 	type = coap_header_get_type(&request);
 
-	if (received > sizeof(buf)) {
+	if (received > sizeof(worker->buf)) {
 		/* The message was truncated and can't be processed further */
 		struct coap_packet response;
 		uint8_t token[COAP_TOKEN_MAX_LEN];
 		uint8_t tkl = coap_header_get_token(&request, token);
 		uint16_t id = coap_header_get_id(&request);
 
+		(void)k_mutex_unlock(&lock);
+
 		if (type == COAP_TYPE_CON) {
 			type = COAP_TYPE_ACK;
 		} else {
 			type = COAP_TYPE_NON_CON;
 		}
 
-		ret = coap_packet_init(&response, buf, sizeof(buf), COAP_VERSION_1, type, tkl,
-				       token, COAP_RESPONSE_CODE_REQUEST_TOO_LARGE, id);
+		ret = coap_packet_init(&response, buf, sizeof(worker->buf), COAP_VERSION_1, type,
+				       tkl, token, COAP_RESPONSE_CODE_REQUEST_TOO_LARGE, id);
 		if (ret < 0) {
 			LOG_ERR("Failed to init response (%d)", ret);
-			goto unlock;
+			return ret;
 		}
 
 		ret = coap_append_option_int(&response, COAP_OPTION_SIZE1,
 					     CONFIG_COAP_SERVER_MESSAGE_SIZE);
 		if (ret < 0) {
 			LOG_ERR("Failed to add SIZE1 option (%d)", ret);
-			goto unlock;
+			return ret;
 		}
 
 		ret = coap_service_send(service, &response, &client_addr, client_addr_len, NULL);
 		if (ret < 0) {
 			LOG_ERR("Failed to reply \"Request Entity Too Large\" (%d)", ret);
-			goto unlock;
 		}
 
-		goto unlock;
+		return ret;
 	}
 
-	pending = coap_pending_received(&request, service->data->pending, MAX_PENDINGS);
+	pending = coap_service_find_pending(service, coap_header_get_id(&request));
 	if (pending) {
 		uint8_t token[COAP_TOKEN_MAX_LEN];
 		uint8_t tkl;
@@ -220,20 +391,27 @@ static int coap_server_process(int sock_fd)
 			coap_service_remove_observer(service, NULL, &client_addr, token, tkl);
 			__fallthrough;
 		case COAP_TYPE_ACK:
-			coap_server_free(pending->data);
-			coap_pending_clear(pending);
+			coap_service_clear_pending(service, pending);
 			break;
 		default:
 			LOG_WRN("Unexpected pending type %d", type);
 			ret = -EINVAL;
-			goto unlock;
+			break;
 		}
 
-		goto unlock;
-	} else if (type == COAP_TYPE_ACK || type == COAP_TYPE_RESET) {
+		(void)k_mutex_unlock(&lock);
+
+		return ret;
+	}
+
+	/* The handlers take the lock themselves when they need it, so that the
+	 * other workers are not held up by them.
+	 */
+	(void)k_mutex_unlock(&lock);
+
+	if (type == COAP_TYPE_ACK || type == COAP_TYPE_RESET) {
 		LOG_WRN("Unexpected type %d without pending packet", type);
-		ret = -EINVAL;
-		goto unlock;
+		return -EINVAL;
 	}
 
 	if (IS_ENABLED(CONFIG_COAP_SERVER_WELL_KNOWN_CORE) &&
@@ -248,7 +426,7 @@ static int coap_server_process(int sock_fd)
 						   well_known_buf, sizeof(well_known_buf));
 		if (ret < 0) {
 			LOG_ERR("Failed to build well known core for %s (%d)", service->name, ret);
-			goto unlock;
+			return ret;
 		}
 
 		ret = coap_service_send(service, &response, &client_addr, client_addr_len, NULL);
@@ -279,98 +457,158 @@ static int coap_server_process(int sock_fd)
 			ret = coap_ack_init(&ack, &request, ack_buf, sizeof(ack_buf), (uint8_t)ret);
 			if (ret < 0) {
 				LOG_ERR("Failed to init ACK (%d)", ret);
-				goto unlock;
+				return ret;
 			}
 
 			ret = coap_service_send(service, &ack, &client_addr, client_addr_len, NULL);
 		}
 	}
 
-unlock:
-	(void)k_mutex_unlock(&lock);
-
 	return ret;
 }
 
-static void coap_server_retransmit(void)
+static void coap_service_retransmit_pending(const struct coap_service *service, size_t i)
 {
-	struct coap_pending *pending;
-	int64_t remaining;
-	int64_t now = k_uptime_get();
+	struct coap_pending *pending = &service->data->pending[i];
 	int ret;
 
+	if (coap_pending_cycle(pending)) {
+		ret = zsock_sendto(service->data->sock_fd, pending->data, pending->len, 0,
+				   &pending->addr, ADDRLEN(&pending->addr));
+		if (ret < 0) {
+			LOG_ERR("Failed to send pending retransmission for %s (%d)",
+				service->name, ret);
+		}
+		__ASSERT_NO_MSG(ret == pending->len);
+
+		coap_service_schedule_pending(service, i);
+	} else {
+		LOG_WRN("Packet retransmission failed for %s", service->name);
+
+		coap_service_remove_observer(service, NULL, &pending->addr, NULL, 0U);
+		coap_service_clear_pending(service, pending);
+	}
+}
+
+/* Turn the wheel up to the current tick. Only the slots of the ticks elapsed
+ * since the last turn are looked at, at most all of them once.
+ */
+static void coap_service_retransmit(const struct coap_service *service, int64_t now)
+{
+	struct coap_service_data *data = service->data;
+	int64_t now_tick = now / WHEEL_TICK;
+	uint16_t *slot;
+	uint16_t next;
+	size_t i;
+
+	data->retransmit_tick = MAX(data->retransmit_tick, now_tick - (WHEEL_SLOTS - 1));
+
+	for (; data->retransmit_tick <= now_tick; data->retransmit_tick++) {
+		slot = &data->retransmit_wheel[data->retransmit_tick % WHEEL_SLOTS];
+		next = *slot;
+		*slot = 0;
+
+		while (next != 0) {
+			i = next - 1;
+			next = data->retransmit_next[i];
+
+			if (coap_pending_expiry(&data->pending[i]) > now) {
+				/* Later in this tick or in a later turn of the wheel */
+				coap_chain_push(slot, data->retransmit_next, i);
+				continue;
+			}
+
+			coap_service_retransmit_pending(service, i);
+		}
+	}
+
+	/* The current tick is processed again next time */
+	data->retransmit_tick = now_tick;
+}
+
+static void coap_server_retransmit(int worker)
+{
+	int64_t now = k_uptime_get();
+
 	(void)k_mutex_lock(&lock, K_FOREVER);
 
 	COAP_SERVICE_FOREACH(service) {
-		if (service->data->sock_fd < 0) {
+		if (service->data->sock_fd < 0 || coap_service_worker(service) != worker) {
 			continue;
 		}
 
-		pending = coap_pending_next_to_expire(service->data->pending, MAX_PENDINGS);
-		if (pending == NULL) {
-			/* No work to be done */
-			continue;
-		}
+		coap_service_retransmit(service, now);
+	}
 
-		/* Check if the pending request has expired */
-		remaining = pending->t0 + pending->timeout - now;
-		if (remaining > 0) {
-			continue;
-		}
+	(void)k_mutex_unlock(&lock);
+}
 
-		if (coap_pending_cycle(pending)) {
-			ret = zsock_sendto(service->data->sock_fd, pending->data, pending->len, 0,
-					   &pending->addr, ADDRLEN(&pending->addr));
-			if (ret < 0) {
-				LOG_ERR("Failed to send pending retransmission for %s (%d)",
-					service->name, ret);
+/* Expiry of the first slot of the wheel with a message expiring in its tick,
+ * or of the first message to expire if they all are a turn or more away.
+ */
+static int64_t coap_service_next_expiry(const struct coap_service *service)
+{
+	const struct coap_service_data *data = service->data;
+	int64_t result = INT64_MAX;
+	int64_t tick;
+	int64_t expiry;
+
+	for (int s = 0; s < WHEEL_SLOTS; s++) {
+		tick = data->retransmit_tick + s;
+
+		for (uint16_t i = data->retransmit_wheel[tick % WHEEL_SLOTS]; i != 0;
+		     i = data->retransmit_next[i - 1]) {
+			expiry = coap_pending_expiry(&data->pending[i - 1]);
+			if (result > expiry) {
+				result = expiry;
 			}
-			__ASSERT_NO_MSG(ret == pending->len);
-		} else {
-			LOG_WRN("Packet retransmission failed for %s", service->name);
+		}
 
-			coap_service_remove_observer(service, NULL, &pending->addr, NULL, 0U);
-			coap_server_free(pending->data);
-			coap_pending_clear(pending);
+		if (result < (tick + 1) * WHEEL_TICK) {
+			break;
 		}
 	}
 
-	(void)k_mutex_unlock(&lock);
+	return result;
 }
 
-static int coap_server_poll_timeout(void)
+static int coap_server_poll_timeout(int worker)
 {
-	struct coap_pending *pending;
 	int64_t result = INT64_MAX;
-	int64_t remaining;
-	int64_t now = k_uptime_get();
+	int64_t expiry;
 
-	COAP_SERVICE_FOREACH(svc) {
-		if (svc->data->sock_fd < -1) {
-			continue;
-		}
+	(void)k_mutex_lock(&lock, K_FOREVER);
 
-		pending = coap_pending_next_to_expire(svc->data->pending, MAX_PENDINGS);
-		if (pending == NULL) {
+	COAP_SERVICE_FOREACH(svc) {
+		if (svc->data->sock_fd < 0 || coap_service_worker(svc) != worker) {
 			continue;
 		}
 
-		remaining = pending->t0 + pending->timeout - now;
-		if (result > remaining) {
-			result = remaining;
+		expiry = coap_service_next_expiry(svc);
+		if (result > expiry) {
+			result = expiry;
 		}
 	}
 
+	(void)k_mutex_unlock(&lock);
+
 	if (result == INT64_MAX) {
 		return -1;
 	}
 
-	return MAX(result, 0);
+	return MAX(result - k_uptime_get(), 0);
 }
 
-static void coap_server_update_services(void)
+static void coap_server_update_services(const struct coap_service *service)
 {
-	if (zsock_send(control_socks[1], &(char){0}, 1, 0) < 0) {
+	int sock = workers[coap_service_worker(service)].control_socks[1];
+
+	/* The worker polls the services once started */
+	if (sock < 0) {
+		return;
+	}
+
+	if (zsock_send(sock, &(char){0}, 1, 0) < 0) {
 		LOG_ERR("Failed to notify server thread (%d)", errno);
 	}
 }
@@ -498,7 +736,7 @@ int coap_service_start(const struct coap_service *service)
 end:
 	k_mutex_unlock(&lock);
 
-	coap_server_update_services();
+	coap_server_update_services(service);
 
 	coap_service_raise_event(service, NET_EVENT_COAP_SERVICE_STARTED);
 
@@ -605,9 +843,10 @@ int coap_service_send(const struct coap_service *service, const struct coap_pack
 		memcpy(pending->data, cpkt->data, pending->len);
 
 		coap_pending_cycle(pending);
+		coap_service_track_pending(service, pending);
 
 		/* Trigger event in receive loop to schedule retransmit */
-		coap_server_update_services();
+		coap_server_update_services(service);
 	}
 
 send:
@@ -677,8 +916,7 @@ int coap_resource_parse_observe(struct coap_resource *resource, const struct coa
 		struct coap_observer *observer;
 
 		/* RFC7641 section 4.1 - Check if the current observer already exists */
-		observer = coap_find_observer(service->data->observers, MAX_OBSERVERS, addr, token,
-					      tkl);
+		observer = coap_service_find_observer(service, addr, token, tkl);
 		if (observer != NULL) {
 			/* Client refresh */
 			goto unlock;
@@ -693,6 +931,7 @@ int coap_resource_parse_observe(struct coap_resource *resource, const struct coa
 
 		coap_observer_init(observer, request, addr);
 		coap_register_observer(resource, observer);
+		coap_service_index_observer(service, resource, observer);
 	} else if (ret == 1) {
 		ret = coap_service_remove_observer(service, resource, addr, token, tkl);
 		if (ret < 0) {
@@ -753,40 +992,80 @@ int coap_resource_remove_observer_by_token(struct coap_resource *resource,
 	return coap_resource_remove_observer(resource, NULL, token, token_len);
 }
 
+static void coap_server_thread(void *p1, void *p2, void *p3);
+
+static int coap_server_start_workers(void)
+{
+	int ret;
+
+	for (int w = 0; w < NUM_WORKERS; w++) {
+		int *control_socks = workers[w].control_socks;
+
+		/* Create a socket pair to wake zsock_poll */
+		ret = zsock_socketpair(AF_UNIX, SOCK_STREAM, 0, control_socks);
+		if (ret < 0) {
+			LOG_ERR("Failed to create socket pair (%d)", ret);
+			return ret;
+		}
+
+		for (int i = 0; i < 2; ++i) {
+			ret = zsock_fcntl(control_socks[i], F_SETFL, O_NONBLOCK);
+
+			if (ret < 0) {
+				zsock_close(control_socks[0]);
+				zsock_close(control_socks[1]);
+				control_socks[0] = -1;
+				control_socks[1] = -1;
+
+				LOG_ERR("Failed to set socket pair [%d] non-blocking (%d)", i, ret);
+				return ret;
+			}
+		}
+	}
+
+#if NUM_WORKERS > 1
+	for (int w = 1; w < NUM_WORKERS; w++) {
+		char name[sizeof("coap_server_") + 1];
+		k_tid_t tid;
+
+		tid = k_thread_create(&worker_threads[w - 1], worker_stacks[w - 1],
+				      K_THREAD_STACK_SIZEOF(worker_stacks[w - 1]),
+				      coap_server_thread, INT_TO_POINTER(w), NULL, NULL,
+				      THREAD_PRIORITY, 0, K_NO_WAIT);
+
+		snprintk(name, sizeof(name), "coap_server_%d", w);
+		(void)k_thread_name_set(tid, name);
+	}
+#endif
+
+	return 0;
+}
+
 static void coap_server_thread(void *p1, void *p2, void *p3)
 {
+	int worker_id = POINTER_TO_INT(p1);
+	struct coap_server_worker *worker = &workers[worker_id];
 	struct zsock_pollfd sock_fds[MAX_POLL_FD];
 	int sock_nfds;
 	int ret;
 
-	ARG_UNUSED(p1);
 	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
-	/* Create a socket pair to wake zsock_poll */
-	ret = zsock_socketpair(AF_UNIX, SOCK_STREAM, 0, control_socks);
-	if (ret < 0) {
-		LOG_ERR("Failed to create socket pair (%d)", ret);
-		return;
-	}
-
-	for (int i = 0; i < 2; ++i) {
-		ret = zsock_fcntl(control_socks[i], F_SETFL, O_NONBLOCK);
-
+	if (worker_id == 0) {
+		/* The first worker starts the others */
+		ret = coap_server_start_workers();
 		if (ret < 0) {
-			zsock_close(control_socks[0]);
-			zsock_close(control_socks[1]);
-
-			LOG_ERR("Failed to set socket pair [%d] non-blocking (%d)", i, ret);
 			return;
 		}
-	}
 
-	COAP_SERVICE_FOREACH(svc) {
-		if (svc->flags & COAP_SERVICE_AUTOSTART) {
-			ret = coap_service_start(svc);
-			if (ret < 0) {
-				LOG_ERR("Failed to autostart service %s (%d)", svc->name, ret);
+		COAP_SERVICE_FOREACH(svc) {
+			if (svc->flags & COAP_SERVICE_AUTOSTART) {
+				ret = coap_service_start(svc);
+				if (ret < 0) {
+					LOG_ERR("Failed to autostart service %s (%d)", svc->name,
+						ret);
+				}
 			}
 		}
 	}
@@ -794,7 +1073,7 @@ static void coap_server_thread(void *p1, void *p2, void *p3)
 	while (true) {
 		sock_nfds = 0;
 		COAP_SERVICE_FOREACH(svc) {
-			if (svc->data->sock_fd < 0) {
+			if (svc->data->sock_fd < 0 || coap_service_worker(svc) != worker_id) {
 				continue;
 			}
 			if (sock_nfds >= MAX_POLL_FD) {
@@ -812,7 +1091,7 @@ static void coap_server_thread(void *p1, void *p2, void *p3)
 
 		/* Add socket pair FD to allow wake up */
 		if (sock_nfds < MAX_POLL_FD) {
-			sock_fds[sock_nfds].fd = control_socks[0];
+			sock_fds[sock_nfds].fd = worker->control_socks[0];
 			sock_fds[sock_nfds].events = ZSOCK_POLLIN;
 			sock_fds[sock_nfds].revents = 0;
 			sock_nfds++;
@@ -820,7 +1099,7 @@ static void coap_server_thread(void *p1, void *p2, void *p3)
 
 		__ASSERT_NO_MSG(sock_nfds > 0);
 
-		ret = zsock_poll(sock_fds, sock_nfds, coap_server_poll_timeout());
+		ret = zsock_poll(sock_fds, sock_nfds, coap_server_poll_timeout(worker_id));
 		if (ret < 0) {
 			LOG_ERR("Poll error (%d)", -errno);
 			k_msleep(10);
@@ -828,7 +1107,7 @@ static void coap_server_thread(void *p1, void *p2, void *p3)
 
 		for (int i = 0; i < sock_nfds; ++i) {
 			/* Check the wake up event */
-			if (sock_fds[i].fd == control_socks[0] &&
+			if (sock_fds[i].fd == worker->control_socks[0] &&
 			    sock_fds[i].revents & ZSOCK_POLLIN) {
 				char tmp;
 
@@ -838,7 +1117,7 @@ static void coap_server_thread(void *p1, void *p2, void *p3)
 
 			/* Check if socket can receive/was closed first */
 			if (sock_fds[i].revents & ZSOCK_POLLIN) {
-				coap_server_process(sock_fds[i].fd);
+				coap_server_process(worker, sock_fds[i].fd);
 				continue;
 			}
 
@@ -854,7 +1133,7 @@ static void coap_server_thread(void *p1, void *p2, void *p3)
 		}
 
 		/* Process retransmits */
-		coap_server_retransmit();
+		coap_server_retransmit(worker_id);
 	}
 }
 
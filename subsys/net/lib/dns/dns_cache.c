@@ -6,18 +6,176 @@
 
 #include <zephyr/net/dns_resolve.h>
 #include <zephyr/net/net_ip.h>
+#include <zephyr/sys/crc.h>
 #include "dns_cache.h"
 
 LOG_MODULE_REGISTER(net_dns_cache, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 
-static void dns_cache_clean(struct dns_cache const *cache);
+static sys_slist_t *dns_cache_bucket(struct dns_cache const *cache, const char *query)
+{
+	return &cache->buckets[crc16_ansi((const uint8_t *)query, strlen(query)) % cache->size];
+}
+
+static sa_family_t dns_cache_family(enum dns_query_type type)
+{
+	if (type == DNS_QUERY_TYPE_A) {
+		return AF_INET;
+	} else if (type == DNS_QUERY_TYPE_AAAA) {
+		return AF_INET6;
+	}
+
+	return AF_UNSPEC;
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_unlink(struct dns_cache *cache, struct dns_cache_entry *entry)
+{
+	(void)sys_slist_find_and_remove(dns_cache_bucket(cache, entry->query), &entry->node);
+	sys_dlist_remove(&entry->lru);
+	entry->in_use = false;
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_release(struct dns_cache *cache, struct dns_cache_entry *entry)
+{
+	dns_cache_unlink(cache, entry);
+	sys_slist_prepend(&cache->free, &entry->node);
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_clean(struct dns_cache *cache)
+{
+	for (size_t i = 0; i < cache->size; i++) {
+		if (!cache->entries[i].in_use) {
+			continue;
+		}
+
+		if (sys_timepoint_expired(cache->entries[i].expiry)) {
+			NET_DBG("Remove \"%s\"", cache->entries[i].query);
+			dns_cache_release(cache, &cache->entries[i]);
+		}
+	}
+}
+
+/* Removes the entries of the query and family which a new answer replaces:
+ * all of them for a negative answer, otherwise the negative ones and the
+ * ones being refreshed.
+ * Needs to be called when lock is already acquired
+ */
+static void dns_cache_replace(struct dns_cache *cache, char const *query, sa_family_t family,
+			      bool negative)
+{
+	struct dns_cache_entry *entry, *next;
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(dns_cache_bucket(cache, query), entry, next, node) {
+		if (entry->data.ai_family != family || strcmp(entry->query, query) != 0) {
+			continue;
+		}
+
+		if (negative || entry->status != 0 || entry->prefetching) {
+			dns_cache_release(cache, entry);
+		}
+	}
+}
+
+/* A free entry, or the least recently used one if the cache is full.
+ * Needs to be called when lock is already acquired
+ */
+static struct dns_cache_entry *dns_cache_get_entry(struct dns_cache *cache)
+{
+	struct dns_cache_entry *entry;
+	sys_snode_t *node;
+
+	if (sys_slist_is_empty(&cache->free) && cache->unused == cache->size) {
+		dns_cache_clean(cache);
+	}
+
+	node = sys_slist_get(&cache->free);
+	if (node != NULL) {
+		return CONTAINER_OF(node, struct dns_cache_entry, node);
+	}
+
+	if (cache->unused < cache->size) {
+		return &cache->entries[cache->unused++];
+	}
+
+	entry = CONTAINER_OF(sys_dlist_peek_tail(&cache->lru), struct dns_cache_entry, lru);
+
+	NET_DBG("Overwrite \"%s\"", entry->query);
+
+	cache->stats.evictions++;
+	dns_cache_unlink(cache, entry);
+
+	return entry;
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_insert(struct dns_cache *cache, char const *query,
+			     struct dns_addrinfo const *addrinfo, int status, uint32_t ttl)
+{
+	struct dns_cache_entry *entry = dns_cache_get_entry(cache);
+
+	strncpy(entry->query, query, CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
+	entry->data = *addrinfo;
+	entry->expiry = sys_timepoint_calc(K_SECONDS(ttl));
+	entry->ttl = ttl;
+	entry->hits = 0U;
+	entry->status = status;
+	entry->prefetching = false;
+	entry->in_use = true;
+
+	sys_slist_append(dns_cache_bucket(cache, query), &entry->node);
+	sys_dlist_prepend(&cache->lru, &entry->lru);
+}
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE_PREFETCH)
+/* Found often enough and in the last part of its TTL */
+static bool dns_cache_prefetch_due(struct dns_cache_entry const *entry)
+{
+	uint64_t left_ms;
+
+	if (entry->prefetching || entry->status != 0 ||
+	    entry->hits < CONFIG_DNS_RESOLVER_CACHE_PREFETCH_HITS) {
+		return false;
+	}
+
+	left_ms = k_ticks_to_ms_floor64(sys_timepoint_timeout(entry->expiry).ticks);
+
+	return left_ms * 100U <
+	       (uint64_t)entry->ttl * MSEC_PER_SEC * CONFIG_DNS_RESOLVER_CACHE_PREFETCH_PERCENT;
+}
+#else
+static bool dns_cache_prefetch_due(struct dns_cache_entry const *entry)
+{
+	ARG_UNUSED(entry);
+
+	return false;
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PREFETCH */
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_set_prefetching(struct dns_cache *cache, const char *query,
+				      sa_family_t family, bool prefetching)
+{
+	struct dns_cache_entry *entry;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(dns_cache_bucket(cache, query), entry, node) {
+		if (entry->data.ai_family == family && strcmp(entry->query, query) == 0) {
+			entry->prefetching = prefetching;
+		}
+	}
+}
 
 int dns_cache_flush(struct dns_cache *cache)
 {
 	k_mutex_lock(cache->lock, K_FOREVER);
 	for (size_t i = 0; i < cache->size; i++) {
 		cache->entries[i].in_use = false;
+		sys_slist_init(&cache->buckets[i]);
 	}
+	sys_dlist_init(&cache->lru);
+	sys_slist_init(&cache->free);
+	cache->unused = 0;
 	k_mutex_unlock(cache->lock);
 
 	return 0;
@@ -26,10 +184,6 @@ int dns_cache_flush(struct dns_cache *cache)
 int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
 		  uint32_t ttl)
 {
-	k_timepoint_t closest_to_expiry = sys_timepoint_calc(K_FOREVER);
-	size_t index_to_replace = 0;
-	bool found_empty = false;
-
 	if (cache == NULL || query == NULL || addrinfo == NULL || ttl == 0) {
 		return -EINVAL;
 	}
@@ -45,28 +199,39 @@ int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinf
 
 	NET_DBG("Add \"%s\" with TTL %" PRIu32, query, ttl);
 
-	dns_cache_clean(cache);
+	dns_cache_replace(cache, query, addrinfo->ai_family, false);
+	dns_cache_insert(cache, query, addrinfo, 0, ttl);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			index_to_replace = i;
-			found_empty = true;
-			break;
-		} else if (sys_timepoint_cmp(closest_to_expiry, cache->entries[i].expiry) > 0) {
-			index_to_replace = i;
-			closest_to_expiry = cache->entries[i].expiry;
-		}
+	k_mutex_unlock(cache->lock);
+
+	return 0;
+}
+
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, enum dns_query_type type,
+			   int status, uint32_t ttl)
+{
+	struct dns_addrinfo info = {
+		.ai_family = dns_cache_family(type),
+	};
+
+	if (cache == NULL || query == NULL || ttl == 0 || info.ai_family == AF_UNSPEC ||
+	    (status != DNS_EAI_NONAME && status != DNS_EAI_NODATA)) {
+		return -EINVAL;
 	}
 
-	if (!found_empty) {
-		NET_DBG("Overwrite \"%s\"", cache->entries[index_to_replace].query);
+	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
+		NET_WARN("Query string to big to be processed %u >= "
+			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
+			 strlen(query));
+		return -EINVAL;
 	}
 
-	strncpy(cache->entries[index_to_replace].query, query,
-		CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
-	cache->entries[index_to_replace].data = *addrinfo;
-	cache->entries[index_to_replace].expiry = sys_timepoint_calc(K_SECONDS(ttl));
-	cache->entries[index_to_replace].in_use = true;
+	k_mutex_lock(cache->lock, K_FOREVER);
+
+	NET_DBG("Add negative \"%s\" status %d with TTL %" PRIu32, query, status, ttl);
+
+	dns_cache_replace(cache, query, info.ai_family, true);
+	dns_cache_insert(cache, query, &info, status, ttl);
 
 	k_mutex_unlock(cache->lock);
 
@@ -75,6 +240,8 @@ int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinf
 
 int dns_cache_remove(struct dns_cache *cache, char const *query)
 {
+	struct dns_cache_entry *entry, *next;
+
 	NET_DBG("Remove all entries with query \"%s\"", query);
 	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
 		NET_WARN("Query string to big to be processed %u >= "
@@ -85,11 +252,9 @@ int dns_cache_remove(struct dns_cache *cache, char const *query)
 
 	k_mutex_lock(cache->lock, K_FOREVER);
 
-	dns_cache_clean(cache);
-
-	for (size_t i = 0; i < cache->size; i++) {
-		if (cache->entries[i].in_use && strcmp(cache->entries[i].query, query) == 0) {
-			cache->entries[i].in_use = false;
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(dns_cache_bucket(cache, query), entry, next, node) {
+		if (strcmp(entry->query, query) == 0) {
+			dns_cache_release(cache, entry);
 		}
 	}
 
@@ -98,21 +263,21 @@ int dns_cache_remove(struct dns_cache *cache, char const *query)
 	return 0;
 }
 
-int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_query_type type,
+int dns_cache_find(struct dns_cache *cache, const char *query, enum dns_query_type type,
 		   struct dns_addrinfo *addrinfo, size_t addrinfo_array_len)
 {
+	struct dns_cache_entry *entry, *next;
+	bool prefetch = false;
 	size_t found = 0;
 	sa_family_t family;
+	int status = 0;
 
 	NET_DBG("Find \"%s\"", query);
 	if (cache == NULL || query == NULL || addrinfo == NULL || addrinfo_array_len <= 0) {
 		return -EINVAL;
 	}
-	if (type == DNS_QUERY_TYPE_A) {
-		family = AF_INET;
-	} else if (type == DNS_QUERY_TYPE_AAAA) {
-		family = AF_INET6;
-	} else {
+	family = dns_cache_family(type);
+	if (family == AF_UNSPEC) {
 		return -EINVAL;
 	}
 	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
@@ -124,51 +289,115 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_qu
 
 	k_mutex_lock(cache->lock, K_FOREVER);
 
-	dns_cache_clean(cache);
-
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(dns_cache_bucket(cache, query), entry, next, node) {
+		if (sys_timepoint_expired(entry->expiry)) {
+			NET_DBG("Remove \"%s\"", entry->query);
+			dns_cache_release(cache, entry);
 			continue;
 		}
-		if (strcmp(cache->entries[i].query, query) != 0) {
+		if (strcmp(entry->query, query) != 0) {
 			continue;
 		}
-		if (cache->entries[i].data.ai_family != family) {
+		if (entry->data.ai_family != family) {
 			continue;
 		}
+
+		sys_dlist_remove(&entry->lru);
+		sys_dlist_prepend(&cache->lru, &entry->lru);
+
+		if (entry->hits < UINT16_MAX) {
+			entry->hits++;
+		}
+
+		if (entry->status != 0) {
+			status = entry->status;
+			continue;
+		}
+
+		prefetch = prefetch || dns_cache_prefetch_due(entry);
+
 		if (found >= addrinfo_array_len) {
 			NET_WARN("Found \"%s\" but not enough space in provided buffer.", query);
 			found++;
 		} else {
-			addrinfo[found] = cache->entries[i].data;
+			addrinfo[found] = entry->data;
 			found++;
 			NET_DBG("Found \"%s\"", query);
 		}
 	}
 
+	if (prefetch && cache->prefetch != NULL) {
+		/* The entries are replaced when the answer arrives */
+		dns_cache_set_prefetching(cache, query, family, true);
+	} else {
+		prefetch = false;
+	}
+
+	if (found > 0) {
+		cache->stats.hits++;
+	} else if (status != 0) {
+		cache->stats.negative_hits++;
+	} else {
+		cache->stats.misses++;
+	}
+
 	k_mutex_unlock(cache->lock);
 
+	if (prefetch) {
+		NET_DBG("Refresh \"%s\"", query);
+		prefetch = cache->prefetch(query, type) == 0;
+
+		k_mutex_lock(cache->lock, K_FOREVER);
+		if (prefetch) {
+			cache->stats.prefetches++;
+		} else {
+			dns_cache_set_prefetching(cache, query, family, false);
+		}
+		k_mutex_unlock(cache->lock);
+	}
+
 	if (found > addrinfo_array_len) {
 		return -ENOSR;
 	}
 
+	if (found == 0 && status != 0) {
+		NET_DBG("Negative answer for \"%s\"", query);
+		return status;
+	}
+
 	if (found == 0) {
 		NET_DBG("Could not find \"%s\"", query);
 	}
 	return found;
 }
 
-/* Needs to be called when lock is already acquired */
-static void dns_cache_clean(struct dns_cache const *cache)
+void dns_cache_prefetch_done(struct dns_cache *cache, const char *query,
+			     enum dns_query_type type)
 {
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			continue;
-		}
+	sa_family_t family = dns_cache_family(type);
 
-		if (sys_timepoint_expired(cache->entries[i].expiry)) {
-			NET_DBG("Remove \"%s\"", cache->entries[i].query);
-			cache->entries[i].in_use = false;
-		}
+	if (cache == NULL || query == NULL || family == AF_UNSPEC) {
+		return;
+	}
+
+	k_mutex_lock(cache->lock, K_FOREVER);
+	dns_cache_set_prefetching(cache, query, family, false);
+	k_mutex_unlock(cache->lock);
+}
+
+int dns_cache_stats_get(struct dns_cache *cache, struct dns_resolve_cache_stats *stats)
+{
+	if (cache == NULL || stats == NULL) {
+		return -EINVAL;
 	}
+
+	k_mutex_lock(cache->lock, K_FOREVER);
+
+	*stats = cache->stats;
+	stats->entries = sys_dlist_len(&cache->lru);
+	stats->size = cache->size;
+
+	k_mutex_unlock(cache->lock);
+
+	return 0;
 }
@@ -17,34 +17,86 @@
 #include <zephyr/net/dns_resolve.h>
 #include <zephyr/kernel.h>
 #include <zephyr/sys_clock.h>
+#include <zephyr/sys/slist.h>
+#include <zephyr/sys/dlist.h>
 
 struct dns_cache_entry {
 	char query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
 	struct dns_addrinfo data;
 	k_timepoint_t expiry;
+	/* In the bucket of the hash of the query */
+	sys_snode_t node;
+	/* In the LRU list, the most recently used entry first */
+	sys_dnode_t lru;
+	/* TTL given when the entry was added, in seconds */
+	uint32_t ttl;
+	/* Number of times the entry was found */
+	uint16_t hits;
+	/* 0 for an address, DNS_EAI_NONAME or DNS_EAI_NODATA for a
+	 * negative answer. Only the family of the data is set then.
+	 */
+	int8_t status;
+	/* A query refreshing the entry was started */
+	bool prefetching;
 	bool in_use;
 };
 
+/**
+ * @brief Called when an entry found often is about to expire, so that the
+ * query can be resolved again in the background.
+ *
+ * @param query Query of the entry.
+ * @param type Query type of the entry.
+ * @retval 0 if the query is being resolved again, see dns_cache_prefetch_done().
+ * @retval On error, a negative value is returned. The entry is refreshed on a later find.
+ */
+typedef int (*dns_cache_prefetch_cb_t)(const char *query, enum dns_query_type type);
+
 struct dns_cache {
 	size_t size;
 	struct dns_cache_entry *entries;
+	/* One bucket per entry, indexed by the hash of the query */
+	sys_slist_t *buckets;
+	sys_dlist_t lru;
+	/* Entries released, then the ones never used from this index */
+	sys_slist_t free;
+	size_t unused;
 	struct k_mutex *lock;
+	dns_cache_prefetch_cb_t prefetch;
+	struct dns_resolve_cache_stats stats;
 };
 
 /**
- * @brief Statically define and initialize a DNS queue.
+ * @brief Statically define and initialize a DNS queue, entries close to
+ * their expiry being refreshed in the background.
  *
  * The cache can be accessed outside the module where it is defined using:
  *
  * @code extern struct dns_cache <name>; @endcode
  *
  * @param name Name of the cache.
+ * @param cache_size Number of entries of the cache.
+ * @param prefetch_cb Callback resolving a query again, or NULL.
  */
-#define DNS_CACHE_DEFINE(name, cache_size)                                                         \
+#define DNS_CACHE_DEFINE_PREFETCH(name, cache_size, prefetch_cb)                                   \
 	static K_MUTEX_DEFINE(name##_mutex);                                                       \
 	static struct dns_cache_entry name##_entries[cache_size];                                  \
+	static sys_slist_t name##_buckets[cache_size];                                             \
 	static struct dns_cache name = {                                                           \
-		.entries = name##_entries, .size = cache_size, .lock = &name##_mutex};
+		.entries = name##_entries, .size = cache_size, .buckets = name##_buckets,          \
+		.lru = SYS_DLIST_STATIC_INIT(&name.lru), .lock = &name##_mutex,                    \
+		.prefetch = prefetch_cb};
+
+/**
+ * @brief Statically define and initialize a DNS queue.
+ *
+ * The cache can be accessed outside the module where it is defined using:
+ *
+ * @code extern struct dns_cache <name>; @endcode
+ *
+ * @param name Name of the cache.
+ */
+#define DNS_CACHE_DEFINE(name, cache_size) DNS_CACHE_DEFINE_PREFETCH(name, cache_size, NULL)
 
 /**
  * @brief Flushes the dns cache removing all its entries.
@@ -56,8 +108,8 @@ struct dns_cache {
 int dns_cache_flush(struct dns_cache *cache);
 
 /**
- * @brief Adds a new entry to the dns cache removing the one closest to expiry
- * if no free space is available.
+ * @brief Adds a new entry to the dns cache removing the least recently used
+ * one if no free space is available.
  *
  * @param cache Cache where the entry should be added.
  * @param query Query which should be persisted in the cache.
@@ -71,6 +123,23 @@ int dns_cache_flush(struct dns_cache *cache);
 int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
 		  uint32_t ttl);
 
+/**
+ * @brief Adds a negative answer to the dns cache, see RFC 2308. It replaces
+ * the entries of the query with the same type.
+ *
+ * @param cache Cache where the entry should be added.
+ * @param query Query which got the negative answer.
+ * @param type Query type which got the negative answer.
+ * @param status DNS_EAI_NONAME if the name does not exist, DNS_EAI_NODATA
+ * if it has no address of this type.
+ * @param ttl Time to live for the entry in seconds, from the SOA record of
+ * the answer.
+ * @retval 0 on success
+ * @retval On error, a negative value is returned.
+ */
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, enum dns_query_type type,
+			   int status, uint32_t ttl);
+
 /**
  * @brief Removes all entries with the given query
  *
@@ -91,11 +160,33 @@ int dns_cache_remove(struct dns_cache *cache, char const *query);
  * @param addrinfo_array_len Array size of the dns_addrinfo array
  * @retval on success the amount of dns_addrinfo written into the addrinfo array will be returned.
  * A cache miss will therefore return a 0.
+ * @retval DNS_EAI_NONAME or DNS_EAI_NODATA if a negative answer was cached for the query.
  * @retval On error a negative value is returned.
  * -ENOSR means there was not enough space in the addrinfo array to accommodate all cache hits the
  * array will however be filled with valid data.
  */
-int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_query_type type,
+int dns_cache_find(struct dns_cache *cache, const char *query, enum dns_query_type type,
 		   struct dns_addrinfo *addrinfo, size_t addrinfo_array_len);
 
+/**
+ * @brief Ends the refresh of the entries of a query started by the prefetch
+ * callback. Once the refresh failed, they can be refreshed again.
+ *
+ * @param cache Cache of the entries.
+ * @param query Query which was resolved again.
+ * @param type Query type which was resolved again.
+ */
+void dns_cache_prefetch_done(struct dns_cache *cache, const char *query,
+			     enum dns_query_type type);
+
+/**
+ * @brief Gets the statistics of the cache.
+ *
+ * @param cache Cache whose statistics are wanted.
+ * @param stats Filled with the statistics.
+ * @retval 0 on success
+ * @retval On error, a negative value is returned.
+ */
+int dns_cache_stats_get(struct dns_cache *cache, struct dns_resolve_cache_stats *stats);
+
 #endif /* ZEPHYR_INCLUDE_NET_DNS_CACHE_H_ */
@@ -364,6 +364,59 @@ int dns_unpack_response_query(struct dns_msg_t *dns_msg)
 	return 0;
 }
 
+int dns_unpack_negative_ttl(struct dns_msg_t *dns_msg, uint32_t *ttl)
+{
+	/* type + class + ttl + rdlength */
+	const int rr_len = DNS_COMMON_UINT_SIZE + DNS_COMMON_UINT_SIZE +
+			   DNS_TTL_LEN + DNS_RDLENGTH_LEN;
+	int nscount = dns_header_nscount(dns_msg->msg);
+	int offset = dns_msg->answer_offset;
+
+	for (int i = 0; i < nscount; i++) {
+		uint8_t *rr = dns_msg->msg + offset;
+		int rem_size = dns_msg->msg_size - offset;
+		uint32_t minimum;
+		int rdlength;
+		int dname_len;
+
+		dname_len = skip_fqdn(rr, rem_size);
+		if (dname_len < 0) {
+			return dname_len;
+		}
+
+		if (rem_size - dname_len < rr_len) {
+			return -EINVAL;
+		}
+
+		rdlength = dns_answer_rdlength(dname_len, rr);
+		if (rem_size - dname_len - rr_len < rdlength) {
+			return -EINVAL;
+		}
+
+		if (dns_answer_type(dname_len, rr) != DNS_RR_TYPE_SOA ||
+		    dns_answer_class(dname_len, rr) != DNS_CLASS_IN) {
+			offset += dname_len + rr_len + rdlength;
+			continue;
+		}
+
+		/* MNAME and RNAME, then SERIAL, REFRESH, RETRY, EXPIRE and
+		 * MINIMUM. See RFC 1035 chapter 3.3.13.
+		 */
+		if (rdlength < 2 * DNS_LABEL_MIN_SIZE + 5 * DNS_TTL_LEN) {
+			return -EINVAL;
+		}
+
+		minimum = ntohl(UNALIGNED_GET((uint32_t *)(rr + dname_len + rr_len +
+							    rdlength - DNS_TTL_LEN)));
+
+		*ttl = MIN((uint32_t)dns_answer_ttl(dname_len, rr), minimum);
+
+		return 0;
+	}
+
+	return -ENOENT;
+}
+
 int dns_copy_qname(uint8_t *buf, uint16_t *len, uint16_t size,
 		   struct dns_msg_t *dns_msg, uint16_t pos)
 {
@@ -89,6 +89,7 @@ enum dns_rr_type {
 	DNS_RR_TYPE_INVALID = 0,
 	DNS_RR_TYPE_A	= 1,		/* IPv4  */
 	DNS_RR_TYPE_CNAME = 5,		/* CNAME */
+	DNS_RR_TYPE_SOA = 6,		/* SOA   */
 	DNS_RR_TYPE_PTR = 12,		/* PTR   */
 	DNS_RR_TYPE_TXT = 16,		/* TXT   */
 	DNS_RR_TYPE_AAAA = 28,		/* IPv6  */
@@ -401,6 +402,22 @@ int dns_msg_pack_query(uint8_t *buf, uint16_t *len, uint16_t size,
  */
 int dns_unpack_response_query(struct dns_msg_t *dns_msg);
 
+/**
+ * @brief Finds how long a negative response can be cached.
+ *
+ * @details RFC 2308 chapter 5: the TTL of a negative response is the
+ *          minimum of the TTL of the SOA record in the authority section
+ *          and of its MINIMUM field. The response must have no answer and
+ *          its query must have been unpacked by dns_unpack_response_query.
+ *
+ * @param dns_msg Structure containing the message.
+ * @param ttl TTL of the negative response in seconds.
+ * @retval 0 on success
+ * @retval -ENOENT if there is no SOA record in the authority section
+ * @retval -EINVAL if a record of the authority section is malformed
+ */
+int dns_unpack_negative_ttl(struct dns_msg_t *dns_msg, uint32_t *ttl);
+
 /**
  * @brief Copies the qname from dns_msg to buf
  *
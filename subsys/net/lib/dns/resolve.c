@@ -77,7 +77,28 @@ NET_BUF_POOL_DEFINE(dns_qname_pool, DNS_RESOLVER_BUF_CTR,
 		    CONFIG_DNS_RESOLVER_MAX_QUERY_LEN,
 		    0, NULL);
 
-#ifdef CONFIG_DNS_RESOLVER_CACHE
+#if defined(CONFIG_DNS_RESOLVER_CACHE_PREFETCH)
+#define DNS_PREFETCH_TIMEOUT (MSEC_PER_SEC * 2) /* ms */
+
+/* Query of a cache entry being resolved again */
+struct dns_prefetch {
+	struct k_work work;
+	char query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
+	enum dns_query_type type;
+	atomic_t busy;
+};
+
+static void dns_prefetch_work(struct k_work *work);
+static int dns_cache_prefetch(const char *query, enum dns_query_type type);
+
+static struct dns_prefetch dns_prefetches[CONFIG_DNS_RESOLVER_CACHE_PREFETCH_QUERIES] = {
+	[0 ... (CONFIG_DNS_RESOLVER_CACHE_PREFETCH_QUERIES - 1)] = {
+		.work = Z_WORK_INITIALIZER(dns_prefetch_work),
+	},
+};
+
+DNS_CACHE_DEFINE_PREFETCH(dns_cache, CONFIG_DNS_RESOLVER_CACHE_MAX_ENTRIES, dns_cache_prefetch);
+#elif defined(CONFIG_DNS_RESOLVER_CACHE)
 DNS_CACHE_DEFINE(dns_cache, CONFIG_DNS_RESOLVER_CACHE_MAX_ENTRIES);
 #endif /* CONFIG_DNS_RESOLVER_CACHE */
 
@@ -823,6 +844,86 @@ static inline int get_slot_by_id(struct dns_resolve_context *ctx,
 	return -ENOENT;
 }
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE_NEGATIVE)
+/* Answer without any record telling that the name does not exist (NXDOMAIN)
+ * or that it has no address of the type asked (NODATA), see RFC 2308.
+ * Only answers to unicast queries are considered.
+ */
+static bool is_negative_response(struct dns_msg_t *dns_msg, uint16_t dns_id)
+{
+	int rcode;
+
+	if (dns_id == 0 || dns_msg->msg_size < DNS_MSG_HEADER_SIZE) {
+		return false;
+	}
+
+	rcode = dns_header_rcode(dns_msg->msg);
+
+	return (rcode == DNS_HEADER_NAMEERROR || rcode == DNS_HEADER_NOERROR) &&
+	       dns_header_opcode(dns_msg->msg) == DNS_QUERY &&
+	       dns_header_qdcount(dns_msg->msg) == 1 &&
+	       dns_header_ancount(dns_msg->msg) == 0;
+}
+
+/* Finds the query of a negative answer and caches the answer for the TTL
+ * of the SOA record of the authority section. Without one, the answer is
+ * not cached.
+ */
+static int dns_validate_negative(struct dns_resolve_context *ctx,
+				 struct dns_msg_t *dns_msg,
+				 uint16_t dns_id,
+				 int *query_idx,
+				 uint16_t *query_hash)
+{
+	char *query_name;
+	int query_name_len;
+	uint32_t ttl;
+	int status;
+	int ret;
+
+	if (dns_header_rcode(dns_msg->msg) == DNS_HEADER_NAMEERROR) {
+		status = DNS_EAI_NONAME;
+	} else {
+		status = DNS_EAI_NODATA;
+	}
+
+	ret = dns_unpack_response_query(dns_msg);
+	if (ret < 0) {
+		errno = -ret;
+		return DNS_EAI_SYSTEM;
+	}
+
+	query_name = dns_msg->msg + dns_msg->query_offset;
+	query_name_len = strlen(query_name);
+
+	/* Same hash as the one of the query, see dns_validate_msg() */
+	for (int i = 0; i < query_name_len; i++) {
+		query_name[i] = tolower(query_name[i]);
+	}
+
+	*query_hash = crc16_ansi(query_name, query_name_len + 1 + 2);
+
+	*query_idx = get_slot_by_id(ctx, dns_id, *query_hash);
+	if (*query_idx < 0) {
+		errno = ENOENT;
+		return DNS_EAI_SYSTEM;
+	}
+
+	ret = dns_unpack_negative_ttl(dns_msg, &ttl);
+	if (ret < 0 || ttl == 0) {
+		NET_DBG("Negative answer for \"%s\" not cached (%d)",
+			ctx->queries[*query_idx].query, ret);
+		return status;
+	}
+
+	(void)dns_cache_add_negative(&dns_cache, ctx->queries[*query_idx].query,
+				     ctx->queries[*query_idx].query_type, status,
+				     MIN(ttl, CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_MAX_TTL));
+
+	return status;
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE_NEGATIVE */
+
 /* Unit test needs to be able to call this function */
 #if !defined(CONFIG_NET_TEST)
 static
@@ -872,6 +973,14 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 		goto quit;
 	}
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE_NEGATIVE)
+	if (is_negative_response(dns_msg, *dns_id)) {
+		ret = dns_validate_negative(ctx, dns_msg, *dns_id, query_idx,
+					    query_hash);
+		goto quit;
+	}
+#endif /* CONFIG_DNS_RESOLVER_CACHE_NEGATIVE */
+
 	ret = dns_unpack_response_header(dns_msg, *dns_id);
 	if (ret < 0) {
 		errno = -ret;
@@ -1577,6 +1686,13 @@ try_resolve:
 
 			return 0;
 		}
+
+		if (ret == DNS_EAI_NONAME || ret == DNS_EAI_NODATA) {
+			/* A negative answer was cached */
+			cb(ret, NULL, user_data);
+
+			return 0;
+		}
 	}
 #else
 	ARG_UNUSED(use_cache);
@@ -1739,6 +1855,79 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 					 user_data, timeout, true);
 }
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE_PREFETCH)
+static void dns_prefetch_cb(enum dns_resolve_status status,
+			    struct dns_addrinfo *info,
+			    void *user_data)
+{
+	struct dns_prefetch *prefetch = user_data;
+
+	ARG_UNUSED(info);
+
+	/* The cache was updated while the answer was read */
+	if (status == DNS_EAI_INPROGRESS) {
+		return;
+	}
+
+	NET_DBG("Refreshed \"%s\" (%d)", prefetch->query, status);
+
+	/* Entries not replaced by the answer can be refreshed again */
+	dns_cache_prefetch_done(&dns_cache, prefetch->query, prefetch->type);
+	atomic_clear(&prefetch->busy);
+}
+
+static void dns_prefetch_work(struct k_work *work)
+{
+	struct dns_prefetch *prefetch = CONTAINER_OF(work, struct dns_prefetch, work);
+	int ret;
+
+	ret = dns_resolve_name_internal(dns_resolve_get_default(), prefetch->query,
+					prefetch->type, NULL, dns_prefetch_cb, prefetch,
+					DNS_PREFETCH_TIMEOUT, false);
+	if (ret < 0) {
+		NET_DBG("Cannot refresh \"%s\" (%d)", prefetch->query, ret);
+		dns_cache_prefetch_done(&dns_cache, prefetch->query, prefetch->type);
+		atomic_clear(&prefetch->busy);
+	}
+}
+
+/* Called by the cache without its lock held, from the thread looking up
+ * the query. The query is resolved again from the system work queue.
+ */
+static int dns_cache_prefetch(const char *query, enum dns_query_type type)
+{
+	ARRAY_FOR_EACH_PTR(dns_prefetches, prefetch) {
+		if (!atomic_cas(&prefetch->busy, 0, 1)) {
+			continue;
+		}
+
+		strncpy(prefetch->query, query, sizeof(prefetch->query) - 1);
+		prefetch->query[sizeof(prefetch->query) - 1] = '\0';
+		prefetch->type = type;
+
+		k_work_submit(&prefetch->work);
+
+		return 0;
+	}
+
+	NET_DBG("No room to refresh \"%s\"", query);
+
+	return -EBUSY;
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PREFETCH */
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+int dns_resolve_cache_stats_get(struct dns_resolve_cache_stats *stats)
+{
+	return dns_cache_stats_get(&dns_cache, stats);
+}
+
+int dns_resolve_cache_flush(void)
+{
+	return dns_cache_flush(&dns_cache);
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
 /* Must be invoked with context lock held */
 static int dns_resolve_close_locked(struct dns_resolve_context *ctx)
 {
@@ -72,11 +72,6 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 
 #define ENGINE_SLEEP_MS 500
 
-#ifdef CONFIG_LWM2M_VERSION_1_1
-#define LWM2M_ENGINE_MAX_OBSERVER_PATH CONFIG_LWM2M_ENGINE_MAX_OBSERVER * 3
-#else
-#define LWM2M_ENGINE_MAX_OBSERVER_PATH CONFIG_LWM2M_ENGINE_MAX_OBSERVER
-#endif
 static struct lwm2m_obj_path_list observe_paths[LWM2M_ENGINE_MAX_OBSERVER_PATH];
 #define MAX_PERIODIC_SERVICE 10
 
@@ -591,14 +586,86 @@ void lwm2m_socket_del(struct lwm2m_ctx *ctx)
 	lwm2m_engine_wake_up();
 }
 
+#if defined(CONFIG_LWM2M_NOTIFY_COALESCE)
+/* Once a change is due, notify it with all the other changes which can already be
+ * notified. Observations due to their pmax are left to the regular path. Return the
+ * number of observations notified or a negative error code, in which case they are
+ * notified one by one, except for -ENOMEM.
+ */
+static int check_coalesced_notifications(struct lwm2m_ctx *ctx, const int64_t timestamp)
+{
+	struct observe_node *batch[CONFIG_LWM2M_ENGINE_MAX_OBSERVER];
+	struct observe_node *obs;
+	bool due = false;
+	int count = 0;
+	int rc;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->observer, obs, node) {
+		if (!obs->resource_update || obs->active_notify != NULL ||
+		    count == ARRAY_SIZE(batch) ||
+		    !engine_observe_between_periods(obs, ctx->srv_obj_inst, timestamp)) {
+			continue;
+		}
+
+		if (obs->event_timestamp && obs->event_timestamp <= timestamp) {
+			due = true;
+		}
+
+		batch[count++] = obs;
+	}
+
+	if (!due) {
+		return 0;
+	}
+
+#if defined(CONFIG_LWM2M_NOTIFY_COALESCE_SEND)
+	rc = generate_coalesced_notify_message(ctx, batch, count);
+	if (rc <= 0) {
+		return rc;
+	}
+
+	count = rc;
+#else
+	/* Each observation is notified on its own token */
+	for (int i = 0; i < count; i++) {
+		rc = generate_notify_message(ctx, batch[i], NULL);
+		if (rc == -ENOMEM) {
+			/* the others wait for the next message */
+			count = i;
+			break;
+		}
+	}
+
+	if (count == 0) {
+		return -ENOMEM;
+	}
+#endif
+
+	for (int i = 0; i < count; i++) {
+		batch[i]->event_timestamp =
+			engine_observe_shedule_next_event(batch[i], ctx->srv_obj_inst, timestamp);
+		batch[i]->last_timestamp = timestamp;
+		batch[i]->resource_update = false;
+	}
+
+	return count;
+}
+#endif /* CONFIG_LWM2M_NOTIFY_COALESCE */
+
 /* Generate notify messages. Return timestamp of next Notify event */
 static int64_t check_notifications(struct lwm2m_ctx *ctx, const int64_t timestamp)
 {
 	struct observe_node *obs;
 	int rc;
 	int64_t next = INT64_MAX;
+	bool notified = false;
 
 	lwm2m_registry_lock();
+#if defined(CONFIG_LWM2M_NOTIFY_COALESCE)
+	rc = check_coalesced_notifications(ctx, timestamp);
+	/* After a message, or without any left, only look for the next event */
+	notified = rc > 0 || rc == -ENOMEM;
+#endif
 	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->observer, obs, node) {
 		if (!obs->event_timestamp) {
 			continue;
@@ -608,7 +675,7 @@ static int64_t check_notifications(struct lwm2m_ctx *ctx, const int64_t timestam
 			next = obs->event_timestamp;
 		}
 
-		if (timestamp < obs->event_timestamp) {
+		if (notified || timestamp < obs->event_timestamp) {
 			continue;
 		}
 		/* Check That There is not pending process*/
@@ -3680,3 +3680,96 @@ cleanup:
 	return -ENOTSUP;
 #endif
 }
+
+#if defined(CONFIG_LWM2M_NOTIFY_COALESCE_SEND)
+int generate_coalesced_notify_message(struct lwm2m_ctx *ctx, struct observe_node *obs[],
+				      int count)
+{
+	struct lwm2m_obj_path_list lwm2m_path_list_buf[CONFIG_LWM2M_COMPOSITE_PATH_LIST_SIZE];
+	struct lwm2m_obj_path_list *entry;
+	sys_slist_t lwm2m_path_list;
+	sys_slist_t lwm2m_path_free_list;
+	struct lwm2m_message *msg;
+	size_t paths = 0;
+	int included;
+	int ret;
+
+	if (lwm2m_server_get_mute_send(ctx->srv_obj_inst)) {
+		return -EPERM;
+	}
+
+	lwm2m_engine_path_list_init(&lwm2m_path_list, &lwm2m_path_free_list, lwm2m_path_list_buf,
+				    CONFIG_LWM2M_COMPOSITE_PATH_LIST_SIZE);
+
+	/* The observations which do not fit wait for the next message */
+	for (included = 0; included < count; included++) {
+		size_t len = sys_slist_len(&obs[included]->path_list);
+
+		if (paths + len > CONFIG_LWM2M_COMPOSITE_PATH_LIST_SIZE) {
+			break;
+		}
+
+		SYS_SLIST_FOR_EACH_CONTAINER(&obs[included]->path_list, entry, node) {
+			ret = lwm2m_engine_add_path_to_list(&lwm2m_path_list,
+							    &lwm2m_path_free_list, &entry->path);
+			if (ret < 0) {
+				return ret;
+			}
+		}
+
+		paths += len;
+	}
+
+	if (included == 0) {
+		return -E2BIG;
+	}
+
+	lwm2m_engine_clear_duplicate_path(&lwm2m_path_list, &lwm2m_path_free_list);
+
+	msg = lwm2m_get_message(ctx);
+	if (!msg) {
+		LOG_ERR("Unable to get a lwm2m message!");
+		return -ENOMEM;
+	}
+
+	msg->type = COAP_TYPE_CON;
+	msg->reply_cb = do_send_reply_cb;
+	msg->message_timeout_cb = do_send_timeout_cb;
+	msg->code = COAP_METHOD_POST;
+	msg->mid = coap_next_id();
+	msg->tkl = LWM2M_MSG_TOKEN_GENERATE_NEW;
+	msg->out.out_cpkt = &msg->cpkt;
+
+	ret = lwm2m_init_message(msg);
+	if (ret < 0) {
+		LOG_ERR("Unable to init lwm2m message! (err: %d)", ret);
+		goto cleanup;
+	}
+
+	ret = select_writer(&msg->out, LWM2M_FORMAT_APP_SENML_CBOR);
+	if (ret < 0) {
+		goto cleanup;
+	}
+
+	ret = coap_packet_append_option(&msg->cpkt, COAP_OPTION_URI_PATH, LWM2M_DP_CLIENT_URI,
+					strlen(LWM2M_DP_CLIENT_URI));
+	if (ret < 0) {
+		goto cleanup;
+	}
+
+	ret = do_send_op_senml_cbor_direct(msg, &lwm2m_path_list);
+	if (ret < 0) {
+		LOG_ERR("Coalesced notification (err:%d)", ret);
+		goto cleanup;
+	}
+
+	LOG_DBG("NOTIFY MSG: %d observations sent to /dp", included);
+	lwm2m_information_interface_send(msg);
+
+	return included;
+
+cleanup:
+	lwm2m_reset_message(msg, true);
+	return ret;
+}
+#endif /* CONFIG_LWM2M_NOTIFY_COALESCE_SEND */
@@ -53,6 +53,13 @@ void lwm2m_udp_receive(struct lwm2m_ctx *client_ctx, uint8_t *buf, uint16_t buf_
 		       struct sockaddr *from_addr);
 
 int generate_notify_message(struct lwm2m_ctx *ctx, struct observe_node *obs, void *user_data);
+#if defined(CONFIG_LWM2M_NOTIFY_COALESCE_SEND)
+/* Send the values of @p count observations in one Send operation, return how many of
+ * them, the first ones, could be sent.
+ */
+int generate_coalesced_notify_message(struct lwm2m_ctx *ctx, struct observe_node *obs[],
+				      int count);
+#endif
 /* Notification and Send operation */
 int lwm2m_information_interface_send(struct lwm2m_message *msg);
 int lwm2m_send_empty_ack(struct lwm2m_ctx *client_ctx, uint16_t mid);
@@ -191,6 +191,8 @@ typedef struct lwm2m_engine_obj_inst *
 struct lwm2m_engine_obj {
 	/* object list */
 	sys_snode_t node;
+	/* object index bucket */
+	sys_snode_t index_node;
 
 	/* object field definitions */
 	struct lwm2m_engine_obj_field *fields;
@@ -213,6 +215,9 @@ struct lwm2m_engine_obj {
 
 	/* Object is a core object (defined in the official LwM2M spec.) */
 	bool is_core : 1;
+
+	/* Field definitions are sorted by resource id */
+	bool fields_sorted : 1;
 };
 
 /* Resource instances with this value are considered "not created" yet */
@@ -411,6 +416,8 @@ struct lwm2m_engine_res {
 struct lwm2m_engine_obj_inst {
 	/* instance list */
 	sys_snode_t node;
+	/* instance index bucket */
+	sys_snode_t index_node;
 
 	struct lwm2m_engine_obj *obj;
 	struct lwm2m_engine_res *resources;
@@ -418,6 +425,9 @@ struct lwm2m_engine_obj_inst {
 	/* object instance member data */
 	uint16_t obj_inst_id;
 	uint16_t resource_count;
+
+	/* Resources are sorted by resource id */
+	bool resources_sorted;
 };
 
 /* Initialize resource instances prior to use */
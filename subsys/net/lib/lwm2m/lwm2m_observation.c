@@ -65,6 +65,24 @@ static sys_slist_t obs_obj_path_list;
 
 static struct observe_node observe_node_data[CONFIG_LWM2M_ENGINE_MAX_OBSERVER];
 
+/* Observed paths hashed by object id and object instance id, or by object id alone when a
+ * whole object is observed, so that a notification only looks at the paths it may match.
+ */
+#define OBSERVE_INDEX_SIZE CONFIG_LWM2M_ENGINE_OBSERVER_INDEX_SIZE
+BUILD_ASSERT(IS_POWER_OF_TWO(OBSERVE_INDEX_SIZE),
+	     "LWM2M_ENGINE_OBSERVER_INDEX_SIZE must be a power of two");
+
+struct observe_index_entry {
+	sys_snode_t node;
+	struct lwm2m_obj_path_list *o_p; /* Observed path, NULL if the entry is free */
+	struct observe_node *obs;
+	struct lwm2m_ctx *ctx;
+};
+
+static struct observe_index_entry observe_index_data[LWM2M_ENGINE_MAX_OBSERVER_PATH];
+static sys_slist_t observe_index[OBSERVE_INDEX_SIZE];
+static uint32_t observe_index_seq;
+
 /* External resources */
 struct lwm2m_ctx **lwm2m_sock_ctx(void);
 
@@ -203,6 +221,116 @@ static bool lwm2m_notify_observer_list(sys_slist_t *path_list, const struct lwm2
 	return false;
 }
 
+static sys_slist_t *observe_index_bucket(const struct lwm2m_obj_path *path)
+{
+	uint32_t hash = path->obj_id * 31U;
+
+	if (path->level >= LWM2M_PATH_LEVEL_OBJECT_INST) {
+		hash += path->obj_inst_id + 1U;
+	}
+
+	return &observe_index[hash & (OBSERVE_INDEX_SIZE - 1)];
+}
+
+static void observe_index_add(struct lwm2m_ctx *ctx, struct observe_node *obs,
+			      struct lwm2m_obj_path_list *o_p)
+{
+	ARRAY_FOR_EACH_PTR(observe_index_data, entry) {
+		if (entry->o_p == NULL) {
+			entry->o_p = o_p;
+			entry->obs = obs;
+			entry->ctx = ctx;
+			sys_slist_append(observe_index_bucket(&o_p->path), &entry->node);
+			return;
+		}
+	}
+
+	LOG_ERR("No free observer index entry");
+}
+
+static void observe_index_remove(struct lwm2m_obj_path_list *o_p)
+{
+	sys_slist_t *bucket = observe_index_bucket(&o_p->path);
+	struct observe_index_entry *entry;
+	sys_snode_t *prev_node = NULL;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(bucket, entry, node) {
+		if (entry->o_p == o_p) {
+			sys_slist_remove(bucket, prev_node, &entry->node);
+			(void)memset(entry, 0, sizeof(*entry));
+			return;
+		}
+
+		prev_node = &entry->node;
+	}
+}
+
+/* Returns 0 to look for more observers, anything else stops the lookup and is returned */
+typedef int (*observe_index_cb_t)(struct lwm2m_ctx *ctx, struct observe_node *obs,
+				  void *user_data);
+
+static int observe_index_scan(sys_slist_t *bucket, const struct lwm2m_obj_path *path,
+			      uint32_t seq, observe_index_cb_t cb, void *user_data)
+{
+	struct observe_index_entry *entry;
+	int ret;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(bucket, entry, node) {
+		/* An observer matching through several paths is only reported once */
+		if (entry->obs->index_seq == seq ||
+		    !lwm2m_observer_path_compare(&entry->o_p->path, path)) {
+			continue;
+		}
+
+		entry->obs->index_seq = seq;
+
+		ret = cb(entry->ctx, entry->obs, user_data);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+/* Call @p cb for each observer with a path matching @p path */
+static int observe_index_foreach(const struct lwm2m_obj_path *path, observe_index_cb_t cb,
+				 void *user_data)
+{
+	struct lwm2m_obj_path obj_path = LWM2M_OBJ(path->obj_id);
+	sys_slist_t *bucket, *obj_bucket;
+	uint32_t seq;
+	int ret;
+
+	seq = ++observe_index_seq;
+	if (seq == 0) {
+		/* Observers never looked at have 0 */
+		seq = ++observe_index_seq;
+	}
+
+	if (path->level < LWM2M_PATH_LEVEL_OBJECT_INST) {
+		/* Instances of the object are observed in any of the buckets */
+		ARRAY_FOR_EACH(observe_index, i) {
+			ret = observe_index_scan(&observe_index[i], path, seq, cb, user_data);
+			if (ret != 0) {
+				return ret;
+			}
+		}
+
+		return 0;
+	}
+
+	bucket = observe_index_bucket(path);
+	obj_bucket = observe_index_bucket(&obj_path);
+
+	ret = observe_index_scan(bucket, path, seq, cb, user_data);
+	if (ret == 0 && obj_bucket != bucket) {
+		ret = observe_index_scan(obj_bucket, path, seq, cb, user_data);
+	}
+
+	return ret;
+}
+
 int lwm2m_notify_observer(uint16_t obj_id, uint16_t obj_inst_id, uint16_t res_id)
 {
 	struct lwm2m_obj_path path;
@@ -221,8 +349,9 @@ static int engine_observe_get_attributes(const struct lwm2m_obj_path *path,
 	struct lwm2m_engine_obj *obj;
 	struct lwm2m_engine_obj_field *obj_field = NULL;
 	struct lwm2m_engine_obj_inst *obj_inst = NULL;
+	struct lwm2m_engine_res *res;
 	struct lwm2m_engine_res_inst *res_inst = NULL;
-	int ret, i;
+	int ret;
 
 	/* defaults from server object */
 	attrs->pmin = lwm2m_server_get_pmin(srv_obj_inst);
@@ -258,20 +387,15 @@ static int engine_observe_get_attributes(const struct lwm2m_obj_path *path,
 
 	/* check if resource exists */
 	if (path->level >= LWM2M_PATH_LEVEL_RESOURCE) {
-		for (i = 0; i < obj_inst->resource_count; i++) {
-			if (obj_inst->resources[i].res_id == path->res_id) {
-				break;
-			}
-		}
-
-		if (i == obj_inst->resource_count) {
+		res = lwm2m_get_engine_obj_inst_res(obj_inst, path->res_id);
+		if (!res) {
 			LOG_ERR("unable to find res_id: %u/%u/%u", path->obj_id, path->obj_inst_id,
 				path->res_id);
 			return -ENOENT;
 		}
 
 		/* load object field data */
-		obj_field = lwm2m_get_engine_obj_field(obj, obj_inst->resources[i].res_id);
+		obj_field = lwm2m_get_engine_obj_field(obj, res->res_id);
 		if (!obj_field) {
 			LOG_ERR("unable to find obj_field: %u/%u/%u", path->obj_id,
 				path->obj_inst_id, path->res_id);
@@ -283,7 +407,7 @@ static int engine_observe_get_attributes(const struct lwm2m_obj_path *path,
 			return -EPERM;
 		}
 
-		ret = update_attrs(&obj_inst->resources[i], attrs);
+		ret = update_attrs(res, attrs);
 		if (ret < 0) {
 			return ret;
 		}
@@ -351,52 +475,72 @@ int engine_observe_attribute_list_get(sys_slist_t *path_list, struct notificatio
 	return 0;
 }
 
-int lwm2m_notify_observer_path(const struct lwm2m_obj_path *path)
+struct notify_observer_data {
+	const struct lwm2m_obj_path *path;
+	int count;
+};
+
+static int notify_observer(struct lwm2m_ctx *ctx, struct observe_node *obs, void *user_data)
 {
-	struct observe_node *obs;
+	struct notify_observer_data *data = user_data;
+	const struct lwm2m_obj_path *path = data->path;
 	struct notification_attrs nattrs = {0};
 	int64_t timestamp;
-	int ret = 0;
-	int i;
-	struct lwm2m_ctx **sock_ctx = lwm2m_sock_ctx();
+	int ret;
 
-	if (path->level < LWM2M_PATH_LEVEL_OBJECT) {
-		return 0;
+	/* update the event time for this observer */
+	ret = engine_observe_attribute_list_get(&obs->path_list, &nattrs, ctx->srv_obj_inst);
+	if (ret < 0) {
+		return ret;
 	}
 
-	/* look for observers which match our resource */
-	for (i = 0; i < lwm2m_sock_nfds(); ++i) {
-		SYS_SLIST_FOR_EACH_CONTAINER(&sock_ctx[i]->observer, obs, node) {
-			if (lwm2m_notify_observer_list(&obs->path_list, path)) {
-				/* update the event time for this observer */
-				ret = engine_observe_attribute_list_get(&obs->path_list, &nattrs,
-									sock_ctx[i]->srv_obj_inst);
-				if (ret < 0) {
-					return ret;
-				}
+	if (nattrs.pmin) {
+		timestamp = obs->last_timestamp + MSEC_PER_SEC * nattrs.pmin;
+	} else {
+		/* Trig immediately */
+		timestamp = k_uptime_get();
+	}
 
-				if (nattrs.pmin) {
-					timestamp =
-						obs->last_timestamp + MSEC_PER_SEC * nattrs.pmin;
-				} else {
-					/* Trig immediately */
-					timestamp = k_uptime_get();
-				}
+#if defined(CONFIG_LWM2M_NOTIFY_COALESCE)
+	/* Give other changes a chance to be sent with this one, until pmax. A
+	 * notification already due at pmax sends the change to the observation.
+	 */
+	timestamp = MAX(timestamp, k_uptime_get() + CONFIG_LWM2M_NOTIFY_COALESCE_WINDOW);
+	if (nattrs.pmax) {
+		timestamp = MIN(timestamp, obs->last_timestamp + MSEC_PER_SEC * nattrs.pmax);
+	}
+#endif
 
-				if (!obs->event_timestamp || obs->event_timestamp > timestamp) {
-					obs->resource_update = true;
-					obs->event_timestamp = timestamp;
-				}
+	if (!obs->event_timestamp || obs->event_timestamp > timestamp) {
+		obs->resource_update = true;
+		obs->event_timestamp = timestamp;
+	}
 
-				LOG_DBG("NOTIFY EVENT %u/%u/%u", path->obj_id, path->obj_inst_id,
-					path->res_id);
-				ret++;
-				lwm2m_engine_wake_up();
-			}
-		}
+	LOG_DBG("NOTIFY EVENT %u/%u/%u", path->obj_id, path->obj_inst_id, path->res_id);
+	data->count++;
+	lwm2m_engine_wake_up();
+
+	return 0;
+}
+
+int lwm2m_notify_observer_path(const struct lwm2m_obj_path *path)
+{
+	struct notify_observer_data data = {
+		.path = path,
+	};
+	int ret;
+
+	if (path->level < LWM2M_PATH_LEVEL_OBJECT) {
+		return 0;
 	}
 
-	return ret;
+	/* look for observers which match our resource */
+	ret = observe_index_foreach(path, notify_observer, &data);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return data.count;
 }
 
 static struct observe_node *engine_allocate_observer(sys_slist_t *path_list, bool composite)
@@ -465,6 +609,8 @@ static void engine_observe_node_init(struct observe_node *obs, const uint8_t *to
 		LOG_DBG("OBSERVER ADDED %u/%u/%u/%u(%u)", tmp->path.obj_id, tmp->path.obj_inst_id,
 			tmp->path.res_id, tmp->path.res_inst_id, tmp->path.level);
 
+		observe_index_add(ctx, obs, tmp);
+
 		if (ctx->observe_cb) {
 			ctx->observe_cb(LWM2M_OBSERVE_EVENT_OBSERVER_ADDED, &tmp->path, ctx);
 		}
@@ -483,6 +629,7 @@ static void remove_observer_path_from_list(struct lwm2m_ctx *ctx, struct observe
 	if (ctx->observe_cb) {
 		ctx->observe_cb(LWM2M_OBSERVE_EVENT_OBSERVER_REMOVED, &o_p->path, NULL);
 	}
+	observe_index_remove(o_p);
 	/* Remove from the list and add to free list */
 	sys_slist_remove(&obs->path_list, prev_node, &o_p->node);
 	sys_slist_append(&obs_obj_path_list, &o_p->node);
@@ -1366,21 +1513,18 @@ int lwm2m_write_attr_handler(struct lwm2m_engine_obj *obj, struct lwm2m_message
 	return 0;
 }
 
-bool lwm2m_path_is_observed(const struct lwm2m_obj_path *path)
+static int path_observed(struct lwm2m_ctx *ctx, struct observe_node *obs, void *user_data)
 {
-	int i;
-	struct observe_node *obs;
-	struct lwm2m_ctx **sock_ctx = lwm2m_sock_ctx();
+	ARG_UNUSED(ctx);
+	ARG_UNUSED(obs);
+	ARG_UNUSED(user_data);
 
-	for (i = 0; i < lwm2m_sock_nfds(); ++i) {
-		SYS_SLIST_FOR_EACH_CONTAINER(&sock_ctx[i]->observer, obs, node) {
+	return 1;
+}
 
-			if (lwm2m_notify_observer_list(&obs->path_list, path)) {
-				return true;
-			}
-		}
-	}
-	return false;
+bool lwm2m_path_is_observed(const struct lwm2m_obj_path *path)
+{
+	return observe_index_foreach(path, path_observed, NULL) > 0;
 }
 
 int lwm2m_engine_observation_handler(struct lwm2m_message *msg, int observe, uint16_t accept,
@@ -1449,6 +1593,24 @@ int64_t engine_observe_shedule_next_event(struct observe_node *obs, uint16_t srv
 	return t_s;
 }
 
+#if defined(CONFIG_LWM2M_NOTIFY_COALESCE)
+bool engine_observe_between_periods(struct observe_node *obs, uint16_t srv_obj_inst,
+				    const int64_t timestamp)
+{
+	struct notification_attrs attrs;
+
+	if (engine_observe_attribute_list_get(&obs->path_list, &attrs, srv_obj_inst) < 0) {
+		return false;
+	}
+
+	if (attrs.pmax && timestamp >= obs->last_timestamp + MSEC_PER_SEC * attrs.pmax) {
+		return false;
+	}
+
+	return timestamp >= obs->last_timestamp + MSEC_PER_SEC * attrs.pmin;
+}
+#endif
+
 struct lwm2m_obj_path_list *lwm2m_engine_get_from_list(sys_slist_t *path_list)
 {
 	sys_snode_t *path_node = sys_slist_get(path_list);
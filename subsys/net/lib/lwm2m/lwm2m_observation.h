@@ -12,6 +12,12 @@ int lwm2m_notify_observer_path(const struct lwm2m_obj_path *path);
 
 #define MAX_TOKEN_LEN 8
 
+#ifdef CONFIG_LWM2M_VERSION_1_1
+#define LWM2M_ENGINE_MAX_OBSERVER_PATH CONFIG_LWM2M_ENGINE_MAX_OBSERVER * 3
+#else
+#define LWM2M_ENGINE_MAX_OBSERVER_PATH CONFIG_LWM2M_ENGINE_MAX_OBSERVER
+#endif
+
 struct observe_node {
 	sys_snode_t node;
 	sys_slist_t path_list;               /* List of Observation path */
@@ -20,6 +26,7 @@ struct observe_node {
 	int64_t last_timestamp;	             /* Timestamp from last Notify */
 	struct lwm2m_message *active_notify; /* Currently active notification */
 	uint32_t counter;
+	uint32_t index_seq;                  /* Last lookup of the observed paths index */
 	uint16_t format;
 	uint8_t tkl;
 	bool resource_update : 1;            /* Resource is updated */
@@ -37,6 +44,14 @@ void clear_attrs(void *ref);
 int64_t engine_observe_shedule_next_event(struct observe_node *obs, uint16_t srv_obj_inst,
 					  const int64_t timestamp);
 
+#if defined(CONFIG_LWM2M_NOTIFY_COALESCE)
+/* Whether the minimum period of the observation is over at @p timestamp and its
+ * maximum period is not, a notification being due to the observation then.
+ */
+bool engine_observe_between_periods(struct observe_node *obs, uint16_t srv_obj_inst,
+				    const int64_t timestamp);
+#endif
+
 void remove_observer_from_list(struct lwm2m_ctx *ctx, sys_snode_t *prev_node,
 			       struct observe_node *obs);
 
@@ -89,6 +89,27 @@ static const struct default_obj_version default_obj_versions[] = {
 static sys_slist_t engine_obj_list;
 static sys_slist_t engine_obj_inst_list;
 
+/* Hash tables of the registered objects and object instances, the lists above keep the
+ * order of registration.
+ */
+#define REGISTRY_INDEX_SIZE CONFIG_LWM2M_ENGINE_REGISTRY_INDEX_SIZE
+BUILD_ASSERT(IS_POWER_OF_TWO(REGISTRY_INDEX_SIZE),
+	     "LWM2M_ENGINE_REGISTRY_INDEX_SIZE must be a power of two");
+
+static sys_slist_t engine_obj_index[REGISTRY_INDEX_SIZE];
+static sys_slist_t engine_obj_inst_index[REGISTRY_INDEX_SIZE];
+
+static sys_slist_t *obj_index_bucket(uint32_t obj_id)
+{
+	return &engine_obj_index[obj_id & (REGISTRY_INDEX_SIZE - 1)];
+}
+
+static sys_slist_t *obj_inst_index_bucket(uint32_t obj_id, uint32_t obj_inst_id)
+{
+	/* Instances of an object usually have consecutive ids, keep them in different buckets */
+	return &engine_obj_inst_index[(obj_id * 31U + obj_inst_id) & (REGISTRY_INDEX_SIZE - 1)];
+}
+
 /* Resource wrappers */
 sys_slist_t *lwm2m_engine_obj_list(void) { return &engine_obj_list; }
 
@@ -101,9 +122,21 @@ static void lwm2m_engine_cache_write(const struct lwm2m_engine_obj_field *obj_fi
 #endif
 /* Engine object */
 
+static bool obj_fields_sorted(const struct lwm2m_engine_obj *obj)
+{
+	for (int i = 1; i < obj->field_count; i++) {
+		if (obj->fields[i - 1].res_id >= obj->fields[i].res_id) {
+			return false;
+		}
+	}
+
+	return obj->fields != NULL;
+}
+
 void lwm2m_register_obj(struct lwm2m_engine_obj *obj)
 {
 	k_mutex_lock(&registry_lock, K_FOREVER);
+	obj->fields_sorted = obj_fields_sorted(obj);
 #if defined(CONFIG_LWM2M_ACCESS_CONTROL_ENABLE)
 	/* If bootstrap, then bootstrap server should create the ac obj instances */
 #if !defined(CONFIG_LWM2M_RD_CLIENT_SUPPORT_BOOTSTRAP)
@@ -113,6 +146,7 @@ void lwm2m_register_obj(struct lwm2m_engine_obj *obj)
 #endif /* CONFIG_LWM2M_RD_CLIENT_SUPPORT_BOOTSTRAP */
 #endif /* CONFIG_LWM2M_ACCESS_CONTROL_ENABLE */
 	sys_slist_append(&engine_obj_list, &obj->node);
+	sys_slist_append(obj_index_bucket(obj->obj_id), &obj->index_node);
 	k_mutex_unlock(&registry_lock);
 }
 
@@ -124,6 +158,7 @@ void lwm2m_unregister_obj(struct lwm2m_engine_obj *obj)
 #endif
 	engine_remove_observer_by_id(obj->obj_id, -1);
 	sys_slist_find_and_remove(&engine_obj_list, &obj->node);
+	sys_slist_find_and_remove(obj_index_bucket(obj->obj_id), &obj->index_node);
 	k_mutex_unlock(&registry_lock);
 }
 
@@ -131,7 +166,7 @@ struct lwm2m_engine_obj *get_engine_obj(int obj_id)
 {
 	struct lwm2m_engine_obj *obj;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_list, obj, node) {
+	SYS_SLIST_FOR_EACH_CONTAINER(obj_index_bucket(obj_id), obj, index_node) {
 		if (obj->obj_id == obj_id) {
 			return obj;
 		}
@@ -142,14 +177,35 @@ struct lwm2m_engine_obj *get_engine_obj(int obj_id)
 
 struct lwm2m_engine_obj_field *lwm2m_get_engine_obj_field(struct lwm2m_engine_obj *obj, int res_id)
 {
-	int i;
+	int i, low, high;
+
+	if (!obj || !obj->fields || obj->field_count == 0) {
+		return NULL;
+	}
 
-	if (obj && obj->fields && obj->field_count > 0) {
+	if (!obj->fields_sorted) {
 		for (i = 0; i < obj->field_count; i++) {
 			if (obj->fields[i].res_id == res_id) {
 				return &obj->fields[i];
 			}
 		}
+
+		return NULL;
+	}
+
+	low = 0;
+	high = obj->field_count - 1;
+
+	while (low <= high) {
+		i = low + (high - low) / 2;
+
+		if (obj->fields[i].res_id == res_id) {
+			return &obj->fields[i];
+		} else if (obj->fields[i].res_id < res_id) {
+			low = i + 1;
+		} else {
+			high = i - 1;
+		}
 	}
 
 	return NULL;
@@ -165,8 +221,20 @@ struct lwm2m_engine_obj *lwm2m_engine_get_obj(const struct lwm2m_obj_path *path)
 }
 /* Engine object instance */
 
+static bool obj_inst_resources_sorted(const struct lwm2m_engine_obj_inst *obj_inst)
+{
+	for (int i = 1; i < obj_inst->resource_count; i++) {
+		if (obj_inst->resources[i - 1].res_id >= obj_inst->resources[i].res_id) {
+			return false;
+		}
+	}
+
+	return obj_inst->resources != NULL;
+}
+
 static void engine_register_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 {
+	obj_inst->resources_sorted = obj_inst_resources_sorted(obj_inst);
 #if defined(CONFIG_LWM2M_ACCESS_CONTROL_ENABLE)
 	/* If bootstrap, then bootstrap server should create the ac obj instances */
 #if !defined(CONFIG_LWM2M_RD_CLIENT_SUPPORT_BOOTSTRAP)
@@ -176,6 +244,8 @@ static void engine_register_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 #endif /* CONFIG_LWM2M_RD_CLIENT_SUPPORT_BOOTSTRAP */
 #endif /* CONFIG_LWM2M_ACCESS_CONTROL_ENABLE */
 	sys_slist_append(&engine_obj_inst_list, &obj_inst->node);
+	sys_slist_append(obj_inst_index_bucket(obj_inst->obj->obj_id, obj_inst->obj_inst_id),
+			 &obj_inst->index_node);
 }
 
 static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
@@ -185,13 +255,17 @@ static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 #endif
 	engine_remove_observer_by_id(obj_inst->obj->obj_id, obj_inst->obj_inst_id);
 	sys_slist_find_and_remove(&engine_obj_inst_list, &obj_inst->node);
+	sys_slist_find_and_remove(obj_inst_index_bucket(obj_inst->obj->obj_id,
+							obj_inst->obj_inst_id),
+				  &obj_inst->index_node);
 }
 
 struct lwm2m_engine_obj_inst *get_engine_obj_inst(int obj_id, int obj_inst_id)
 {
 	struct lwm2m_engine_obj_inst *obj_inst;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list, obj_inst, node) {
+	SYS_SLIST_FOR_EACH_CONTAINER(obj_inst_index_bucket(obj_id, obj_inst_id), obj_inst,
+				     index_node) {
 		if (obj_inst->obj->obj_id == obj_id && obj_inst->obj_inst_id == obj_inst_id) {
 			return obj_inst;
 		}
@@ -204,6 +278,12 @@ struct lwm2m_engine_obj_inst *next_engine_obj_inst(int obj_id, int obj_inst_id)
 {
 	struct lwm2m_engine_obj_inst *obj_inst, *next = NULL;
 
+	/* Instance ids are usually consecutive, no other instance can come before this one */
+	next = get_engine_obj_inst(obj_id, obj_inst_id + 1);
+	if (next) {
+		return next;
+	}
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list, obj_inst, node) {
 		if (obj_inst->obj->obj_id == obj_id && obj_inst->obj_inst_id > obj_inst_id &&
 		    (!next || next->obj_inst_id > obj_inst->obj_inst_id)) {
@@ -364,13 +444,50 @@ struct lwm2m_engine_obj_inst *lwm2m_engine_get_obj_inst(const struct lwm2m_obj_p
 	return get_engine_obj_inst(path->obj_id, path->obj_inst_id);
 }
 
+struct lwm2m_engine_res *lwm2m_get_engine_obj_inst_res(struct lwm2m_engine_obj_inst *obj_inst,
+						      int res_id)
+{
+	int i, low, high;
+
+	if (!obj_inst || !obj_inst->resources || obj_inst->resource_count == 0) {
+		return NULL;
+	}
+
+	if (!obj_inst->resources_sorted) {
+		for (i = 0; i < obj_inst->resource_count; i++) {
+			if (obj_inst->resources[i].res_id == res_id) {
+				return &obj_inst->resources[i];
+			}
+		}
+
+		return NULL;
+	}
+
+	low = 0;
+	high = obj_inst->resource_count - 1;
+
+	while (low <= high) {
+		i = low + (high - low) / 2;
+
+		if (obj_inst->resources[i].res_id == res_id) {
+			return &obj_inst->resources[i];
+		} else if (obj_inst->resources[i].res_id < res_id) {
+			low = i + 1;
+		} else {
+			high = i - 1;
+		}
+	}
+
+	return NULL;
+}
+
 int path_to_objs(const struct lwm2m_obj_path *path, struct lwm2m_engine_obj_inst **obj_inst,
 		 struct lwm2m_engine_obj_field **obj_field, struct lwm2m_engine_res **res,
 		 struct lwm2m_engine_res_inst **res_inst)
 {
 	struct lwm2m_engine_obj_inst *oi;
 	struct lwm2m_engine_obj_field *of;
-	struct lwm2m_engine_res *r = NULL;
+	struct lwm2m_engine_res *r;
 	struct lwm2m_engine_res_inst *ri = NULL;
 	int i;
 
@@ -395,13 +512,7 @@ int path_to_objs(const struct lwm2m_obj_path *path, struct lwm2m_engine_obj_inst
 		return -ENOENT;
 	}
 
-	for (i = 0; i < oi->resource_count; i++) {
-		if (oi->resources[i].res_id == path->res_id) {
-			r = &oi->resources[i];
-			break;
-		}
-	}
-
+	r = lwm2m_get_engine_obj_inst_res(oi, path->res_id);
 	if (!r) {
 		if (LWM2M_HAS_PERM(of, BIT(LWM2M_FLAG_OPTIONAL))) {
 			LOG_DBG("resource %d not found", path->res_id);
@@ -191,6 +191,16 @@ void lwm2m_engine_get_queue_mode(char *queue);
  */
 struct lwm2m_engine_obj_field *lwm2m_get_engine_obj_field(struct lwm2m_engine_obj *obj, int res_id);
 
+/**
+ * @brief Returns the resource with resource id @p res_id of the object instance @p obj_inst.
+ *
+ * @param[in] obj_inst lwm2m engine object instance of the resource.
+ * @param[in] res_id Resource id of the resource.
+ * @return Pointer to an engine resource, or NULL if it does not exist
+ */
+struct lwm2m_engine_res *lwm2m_get_engine_obj_inst_res(struct lwm2m_engine_obj_inst *obj_inst,
+						      int res_id);
+
 size_t lwm2m_engine_get_opaque_more(struct lwm2m_input_context *in, uint8_t *buf, size_t buflen,
 				    struct lwm2m_opaque_context *opaque, bool *last_block);
 
@@ -1074,6 +1074,234 @@ int do_send_op_senml_cbor(struct lwm2m_message *msg, sys_slist_t *lwm2m_path_lis
 	return ret;
 }
 
+#if defined(CONFIG_LWM2M_NOTIFY_COALESCE_SEND)
+/* Resource of the registry which can be encoded without the formatter data:
+ * readable, with a single instance.
+ */
+static struct lwm2m_engine_res *direct_res_get(const struct lwm2m_obj_path *path,
+					       uint8_t *data_type)
+{
+	struct lwm2m_engine_obj_inst *obj_inst;
+	struct lwm2m_engine_obj_field *obj_field;
+	struct lwm2m_engine_res *res;
+
+	if (path->level != LWM2M_PATH_LEVEL_RESOURCE) {
+		return NULL;
+	}
+
+	obj_inst = get_engine_obj_inst(path->obj_id, path->obj_inst_id);
+	if (!obj_inst) {
+		return NULL;
+	}
+
+	res = lwm2m_get_engine_obj_inst_res(obj_inst, path->res_id);
+	if (!res || res->multi_res_inst || res->res_inst_count != 1 ||
+	    res->res_instances[0].res_inst_id == RES_INSTANCE_NOT_CREATED) {
+		return NULL;
+	}
+
+	obj_field = lwm2m_get_engine_obj_field(obj_inst->obj, path->res_id);
+	if (!obj_field || !LWM2M_HAS_PERM(obj_field, LWM2M_PERM_R)) {
+		return NULL;
+	}
+
+	*data_type = obj_field->data_type;
+
+	return res;
+}
+
+/* Same keys and value types as the records of the writer */
+static bool put_direct_value(zcbor_state_t *state, uint8_t data_type, void *data_ptr,
+			     size_t data_len)
+{
+	struct lwm2m_objlnk *objlnk;
+	char objlnk_buf[sizeof("65535:65535")];
+	int len;
+
+	switch (data_type) {
+	case LWM2M_RES_TYPE_OPAQUE:
+		return zcbor_uint32_put(state, 8) &&
+		       zcbor_bstr_encode_ptr(state, data_ptr, data_len);
+
+	case LWM2M_RES_TYPE_STRING:
+		return zcbor_uint32_put(state, 3) &&
+		       zcbor_tstr_encode_ptr(state, data_ptr, data_len ? data_len - 1 : 0);
+
+	case LWM2M_RES_TYPE_U32:
+		return zcbor_uint32_put(state, 2) &&
+		       zcbor_int64_put(state, *(uint32_t *)data_ptr);
+
+	case LWM2M_RES_TYPE_U16:
+		return zcbor_uint32_put(state, 2) &&
+		       zcbor_int64_put(state, *(uint16_t *)data_ptr);
+
+	case LWM2M_RES_TYPE_U8:
+		return zcbor_uint32_put(state, 2) &&
+		       zcbor_int64_put(state, *(uint8_t *)data_ptr);
+
+	case LWM2M_RES_TYPE_S64:
+		return zcbor_uint32_put(state, 2) &&
+		       zcbor_int64_put(state, *(int64_t *)data_ptr);
+
+	case LWM2M_RES_TYPE_S32:
+		return zcbor_uint32_put(state, 2) &&
+		       zcbor_int64_put(state, *(int32_t *)data_ptr);
+
+	case LWM2M_RES_TYPE_S16:
+		return zcbor_uint32_put(state, 2) &&
+		       zcbor_int64_put(state, *(int16_t *)data_ptr);
+
+	case LWM2M_RES_TYPE_S8:
+		return zcbor_uint32_put(state, 2) &&
+		       zcbor_int64_put(state, *(int8_t *)data_ptr);
+
+	case LWM2M_RES_TYPE_TIME:
+		if (data_len == sizeof(time_t)) {
+			return zcbor_uint32_put(state, 2) &&
+			       zcbor_int64_put(state, *(time_t *)data_ptr);
+		}
+
+		return data_len == sizeof(uint32_t) && zcbor_uint32_put(state, 2) &&
+		       zcbor_int64_put(state, *(uint32_t *)data_ptr);
+
+	case LWM2M_RES_TYPE_BOOL:
+		return zcbor_uint32_put(state, 4) && zcbor_bool_put(state, *(bool *)data_ptr);
+
+	case LWM2M_RES_TYPE_FLOAT:
+		return zcbor_uint32_put(state, 2) &&
+		       zcbor_float64_put(state, *(double *)data_ptr);
+
+	case LWM2M_RES_TYPE_OBJLNK:
+		objlnk = data_ptr;
+		len = snprintk(objlnk_buf, sizeof(objlnk_buf), "%u:%u", objlnk->obj_id,
+			       objlnk->obj_inst);
+
+		return len > 0 && zcbor_tstr_put_lit(state, "vlo") &&
+		       zcbor_tstr_encode_ptr(state, objlnk_buf, len);
+
+	default:
+		return false;
+	}
+}
+
+/* One record with the basename, the name and the value of the resource, as the
+ * composite read of the writer makes for a path to a resource.
+ */
+static int put_direct_record(zcbor_state_t *state, const struct lwm2m_obj_path *path,
+			     struct lwm2m_engine_res *res, uint8_t data_type)
+{
+	struct lwm2m_engine_res_inst *res_inst = &res->res_instances[0];
+	char basename[SENML_MAX_NAME_SIZE];
+	char name[sizeof("65535")];
+	size_t data_len = res_inst->data_len;
+	void *data_ptr = res_inst->data_ptr;
+	int bn_len, n_len;
+
+	if (res->read_cb) {
+		data_ptr = res->read_cb(path->obj_inst_id, path->res_id, res_inst->res_inst_id,
+					&data_len);
+	}
+
+	if (!data_ptr && data_len) {
+		return -ENOENT;
+	}
+
+	if (!data_len) {
+		if (data_type != LWM2M_RES_TYPE_OPAQUE && data_type != LWM2M_RES_TYPE_STRING) {
+			return -ENOENT;
+		}
+
+		data_ptr = "";
+	}
+
+	bn_len = path_to_string(basename, sizeof(basename), path, LWM2M_PATH_LEVEL_OBJECT_INST);
+	if (bn_len < 0) {
+		return bn_len;
+	}
+
+	n_len = snprintk(name, sizeof(name), "%" PRIu16 "", path->res_id);
+
+	if (!zcbor_map_start_encode(state, 3) ||
+	    !zcbor_int32_put(state, -2) ||
+	    !zcbor_tstr_encode_ptr(state, basename, bn_len) ||
+	    !zcbor_uint32_put(state, 0) ||
+	    !zcbor_tstr_encode_ptr(state, name, n_len) ||
+	    !put_direct_value(state, data_type, data_ptr, data_len) ||
+	    !zcbor_map_end_encode(state, 3)) {
+		return -ENOMEM;
+	}
+
+	return 0;
+}
+
+int do_send_op_senml_cbor_direct(struct lwm2m_message *msg, sys_slist_t *lwm2m_path_list)
+{
+	struct coap_packet *cpkt = msg->out.out_cpkt;
+	struct lwm2m_obj_path_list *entry;
+	struct lwm2m_engine_res *res;
+	zcbor_state_t states[5];
+	uint8_t data_type;
+	size_t count = 0;
+	int records = 0;
+	int ret;
+
+	/* Anything else than single resources takes the way of the writer */
+	SYS_SLIST_FOR_EACH_CONTAINER(lwm2m_path_list, entry, node) {
+		if (!direct_res_get(&entry->path, &data_type)) {
+			return do_send_op_senml_cbor(msg, lwm2m_path_list);
+		}
+
+		count++;
+	}
+
+	ret = coap_append_option_int(cpkt, COAP_OPTION_CONTENT_FORMAT,
+				     LWM2M_FORMAT_APP_SENML_CBOR);
+	if (ret < 0) {
+		LOG_ERR("Error setting response content-format: %d", ret);
+		return ret;
+	}
+
+	ret = coap_packet_append_payload_marker(cpkt);
+	if (ret < 0) {
+		LOG_ERR("Error appending payload marker: %d", ret);
+		return ret;
+	}
+
+	zcbor_new_encode_state(states, ARRAY_SIZE(states), CPKT_BUF_W_REGION(cpkt), 1);
+
+	if (!zcbor_list_start_encode(states, count)) {
+		return -ENOMEM;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(lwm2m_path_list, entry, node) {
+		res = direct_res_get(&entry->path, &data_type);
+
+		ret = put_direct_record(states, &entry->path, res, data_type);
+		if (ret == -ENOMEM) {
+			LOG_ERR("unable to encode senml cbor msg");
+			return ret;
+		} else if (ret < 0) {
+			/* Left out, as a composite read does */
+			continue;
+		}
+
+		records++;
+	}
+
+	if (records == 0) {
+		return -ENOENT;
+	}
+
+	if (!zcbor_list_end_encode(states, count)) {
+		return -ENOMEM;
+	}
+
+	cpkt->offset = states[0].payload - cpkt->data;
+
+	return 0;
+}
+#endif /* CONFIG_LWM2M_NOTIFY_COALESCE_SEND */
+
 static int path_to_string(char *buf, size_t buf_size, const struct lwm2m_obj_path *input,
 			 int level_max)
 {
@@ -24,4 +24,9 @@ int do_composite_observe_parse_path_senml_cbor(struct lwm2m_message *msg,
 
 int do_send_op_senml_cbor(struct lwm2m_message *msg, sys_slist_t *lwm2m_path_list);
 
+#if defined(CONFIG_LWM2M_NOTIFY_COALESCE_SEND)
+/* Encode the resources of the list straight from the registry into the payload */
+int do_send_op_senml_cbor_direct(struct lwm2m_message *msg, sys_slist_t *lwm2m_path_list);
+#endif
+
 #endif /* LWM2M_RW_SENML_CBOR_H_ */
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/net/prometheus/collector.h>
+#include <zephyr/net/prometheus/counter.h>
+#include <zephyr/net/prometheus/gauge.h>
+#include <zephyr/net/prometheus/histogram.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(pm_sched_stats, CONFIG_PROMETHEUS_LOG_LEVEL);
+
+static int sched_stats_scrape(struct prometheus_collector *collector,
+			      struct prometheus_metric *metric,
+			      void *user_data);
+
+PROMETHEUS_COLLECTOR_DEFINE(prometheus_sched_collector, sched_stats_scrape);
+
+PROMETHEUS_HISTOGRAM_DEFINE(sched_wakeup_latency_seconds,
+			    "Time from a thread being made ready to it running",
+			    ({ .key = "scheduler", .value = "kernel" }),
+			    &prometheus_sched_collector);
+
+PROMETHEUS_COUNTER_DEFINE(sched_preemptions_total,
+			  "Threads switched out while still ready",
+			  ({ .key = "scheduler", .value = "kernel" }),
+			  &prometheus_sched_collector);
+
+PROMETHEUS_COUNTER_DEFINE(sched_context_switches_total,
+			  "Context switches",
+			  ({ .key = "scheduler", .value = "kernel" }),
+			  &prometheus_sched_collector);
+
+PROMETHEUS_COUNTER_DEFINE(sched_ipis_total,
+			  "Scheduler IPIs signaled",
+			  ({ .key = "scheduler", .value = "kernel" }),
+			  &prometheus_sched_collector);
+
+PROMETHEUS_GAUGE_DEFINE(sched_runq_depth,
+			"Threads in the run queue",
+			({ .key = "scheduler", .value = "kernel" }),
+			&prometheus_sched_collector);
+
+PROMETHEUS_GAUGE_DEFINE(sched_runq_max_depth,
+			"Largest number of threads in the run queue",
+			({ .key = "scheduler", .value = "kernel" }),
+			&prometheus_sched_collector);
+
+static struct prometheus_histogram_bucket
+	latency_buckets[CONFIG_SCHED_LATENCY_STATS_BUCKETS];
+
+/* Scrapes are serialized by the collector lock */
+static struct k_sched_stats stats;
+
+static void latency_histogram_update(struct prometheus_histogram *histogram)
+{
+	double hz = (double)sys_clock_hw_cycles_per_sec();
+	unsigned long count = 0U;
+	uint64_t total = 0U;
+
+	/* Prometheus buckets are cumulative, the kernel ones are not */
+	for (size_t i = 0; i < ARRAY_SIZE(latency_buckets); i++) {
+		for (size_t prio = 0; prio < ARRAY_SIZE(stats.prio); prio++) {
+			count += stats.prio[prio].hist[i];
+		}
+
+		latency_buckets[i].count = count;
+	}
+
+	for (size_t prio = 0; prio < ARRAY_SIZE(stats.prio); prio++) {
+		total += stats.prio[prio].total;
+	}
+
+	histogram->count = count;
+	histogram->sum = (double)total / hz;
+}
+
+static int sched_stats_scrape(struct prometheus_collector *collector,
+			      struct prometheus_metric *metric,
+			      void *user_data)
+{
+	ARG_UNUSED(collector);
+	ARG_UNUSED(user_data);
+
+	uint64_t preemptions = 0U;
+	int ret;
+
+	ret = k_sched_stats_get(&stats);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (metric == &sched_wakeup_latency_seconds.base) {
+		latency_histogram_update(&sched_wakeup_latency_seconds);
+	} else if (metric == &sched_preemptions_total.base) {
+		for (size_t prio = 0; prio < ARRAY_SIZE(stats.prio); prio++) {
+			preemptions += stats.prio[prio].preemptions;
+		}
+
+		prometheus_counter_set(&sched_preemptions_total, preemptions);
+	} else if (metric == &sched_context_switches_total.base) {
+		prometheus_counter_set(&sched_context_switches_total,
+				       stats.runq.switches);
+	} else if (metric == &sched_ipis_total.base) {
+		prometheus_counter_set(&sched_ipis_total, stats.runq.ipis);
+	} else if (metric == &sched_runq_depth.base) {
+		prometheus_gauge_set(&sched_runq_depth, stats.runq.depth);
+	} else if (metric == &sched_runq_max_depth.base) {
+		prometheus_gauge_set(&sched_runq_max_depth, stats.runq.max_depth);
+	} else {
+		LOG_DBG("Unknown metric %s", metric->name);
+	}
+
+	return 0;
+}
+
+static int sched_stats_prometheus_init(void)
+{
+	double hz = (double)sys_clock_hw_cycles_per_sec();
+
+	/* Bucket n of the kernel histogram holds latencies below 2^(n+1)
+	 * cycles, except the last one which holds everything above.
+	 */
+	for (size_t i = 0; i < ARRAY_SIZE(latency_buckets); i++) {
+		latency_buckets[i].upper_bound = (double)(1ULL << (i + 1)) / hz;
+	}
+
+	latency_buckets[ARRAY_SIZE(latency_buckets) - 1].upper_bound =
+		__builtin_inf();
+
+	sched_wakeup_latency_seconds.buckets = latency_buckets;
+	sched_wakeup_latency_seconds.num_buckets = ARRAY_SIZE(latency_buckets);
+
+	prometheus_collector_register_metric(&prometheus_sched_collector,
+					     &sched_wakeup_latency_seconds.base);
+	prometheus_collector_register_metric(&prometheus_sched_collector,
+					     &sched_preemptions_total.base);
+	prometheus_collector_register_metric(&prometheus_sched_collector,
+					     &sched_context_switches_total.base);
+	prometheus_collector_register_metric(&prometheus_sched_collector,
+					     &sched_ipis_total.base);
+	prometheus_collector_register_metric(&prometheus_sched_collector,
+					     &sched_runq_depth.base);
+	prometheus_collector_register_metric(&prometheus_sched_collector,
+					     &sched_runq_max_depth.base);
+
+	return 0;
+}
+
+SYS_INIT(sched_stats_prometheus_init, APPLICATION,
+	 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -52,11 +52,16 @@ static void dns_result_cb(enum dns_resolve_status status,
 		return;
 	}
 
-	if (status == DNS_EAI_FAIL) {
+	if (status == DNS_EAI_FAIL || status == DNS_EAI_NONAME) {
 		PR_WARNING("dns: No such name found.\n");
 		return;
 	}
 
+	if (status == DNS_EAI_NODATA) {
+		PR_WARNING("dns: No address of this type found.\n");
+		return;
+	}
+
 	PR_WARNING("dns: Unhandled status %d received\n", status);
 }
 
@@ -179,6 +184,51 @@ static int cmd_net_dns_cancel(const struct shell *sh, size_t argc, char *argv[])
 	return 0;
 }
 
+static int cmd_net_dns_cache(const struct shell *sh, size_t argc, char *argv[])
+{
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	struct dns_resolve_cache_stats stats;
+	int ret;
+
+	if (argc > 1) {
+		if (strcmp(argv[1], "flush") != 0) {
+			PR_WARNING("Unknown argument '%s'\n", argv[1]);
+			return -ENOEXEC;
+		}
+
+		ret = dns_resolve_cache_flush();
+		if (ret < 0) {
+			PR_WARNING("Cannot flush the DNS cache (%d)\n", ret);
+			return -ENOEXEC;
+		}
+
+		PR("DNS cache flushed.\n");
+		return 0;
+	}
+
+	ret = dns_resolve_cache_stats_get(&stats);
+	if (ret < 0) {
+		PR_WARNING("Cannot get the DNS cache statistics (%d)\n", ret);
+		return -ENOEXEC;
+	}
+
+	PR("Entries      : %u/%u\n", stats.entries, stats.size);
+	PR("Hits         : %u\n", stats.hits);
+	PR("Negative hits: %u\n", stats.negative_hits);
+	PR("Misses       : %u\n", stats.misses);
+	PR("Evictions    : %u\n", stats.evictions);
+	PR("Prefetches   : %u\n", stats.prefetches);
+#else
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	PR_INFO("Set %s to enable %s support.\n", "CONFIG_DNS_RESOLVER_CACHE",
+		"DNS resolver cache");
+#endif
+
+	return 0;
+}
+
 static int cmd_net_dns_query(const struct shell *sh, size_t argc, char *argv[])
 {
 
@@ -259,6 +309,10 @@ static int cmd_net_dns(const struct shell *sh, size_t argc, char *argv[])
 SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_dns,
 	SHELL_CMD(cancel, NULL, "Cancel all pending requests.",
 		  cmd_net_dns_cancel),
+	SHELL_CMD_ARG(cache, NULL,
+		      "'net dns cache [flush]' shows the statistics of the DNS "
+		      "cache, or removes all its entries.",
+		      cmd_net_dns_cache, 1, 1),
 	SHELL_CMD(query, NULL,
 		  "'net dns <hostname> [A or AAAA]' queries IPv4 address "
 		  "(default) or IPv6 address for a host name.",
@@ -552,6 +552,13 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 	   GET_STAT(iface, tcp.conndrop),
 	   GET_STAT(iface, tcp.connrst));
 	PR("TCP pkt drop   %d\n", GET_STAT(iface, tcp.drop));
+	PR("TCP fast rexmt %d\trto\t%d\n",
+	   GET_STAT(iface, tcp.fast_rexmit),
+	   GET_STAT(iface, tcp.rto));
+	PR("TCP last cwnd  %u\tssthresh %u\trtt\t%u ms\n",
+	   GET_STAT(iface, tcp.cwnd),
+	   GET_STAT(iface, tcp.ssthresh),
+	   GET_STAT(iface, tcp.rtt));
 #endif
 #if defined(CONFIG_NET_STATISTICS_DNS)
 	PR("DNS recv       %d\tsent\t%d\tdrop\t%d\n",
@@ -33,6 +33,7 @@ LOG_MODULE_DECLARE(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
 #include "sockets_internal.h"
 #include "../../ip/tcp_internal.h"
+#include "../../ip/udp_internal.h"
 #include "../../ip/net_private.h"
 
 const struct socket_op_vtable sock_fd_op_vtable;
@@ -112,6 +113,12 @@ static int zsock_socket_internal(int family, int type, int proto)
 	/* Initialize user_data, all other calls will preserve it */
 	ctx->user_data = NULL;
 
+	/* recv() verifies the UDP checksum while it copies the data */
+	if (IS_ENABLED(CONFIG_NET_CHKSUM_COPY) && type == SOCK_DGRAM &&
+	    proto == IPPROTO_UDP) {
+		net_context_set_chksum_on_copy(ctx, true);
+	}
+
 	/* The socket flags are stored here */
 	ctx->socket_data = NULL;
 
@@ -1060,18 +1067,28 @@ static ssize_t zsock_recv_dgram(struct net_context *ctx,
 				struct sockaddr *src_addr,
 				socklen_t *addrlen)
 {
-	k_timeout_t timeout = K_FOREVER;
+	int (*pkt_read)(struct net_pkt *pkt, void *data, size_t length);
+	k_timeout_t timeout;
 	size_t recv_len = 0;
 	size_t read_len;
 	struct net_pkt_cursor backup;
 	struct net_pkt *pkt;
+	k_timepoint_t end;
+	bool chksum;
+
+	timeout = K_FOREVER;
+	net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
 
+	/* Datagrams dropped for a bad checksum do not restart the timeout */
+	end = sys_timepoint_calc(timeout);
+
+again:
 	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
 		timeout = K_NO_WAIT;
 	} else {
 		int ret;
 
-		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+		timeout = sys_timepoint_timeout(end);
 
 		ret = zsock_wait_data(ctx, &timeout);
 		if (ret < 0) {
@@ -1100,6 +1117,21 @@ static ssize_t zsock_recv_dgram(struct net_context *ctx,
 		return -1;
 	}
 
+	if (net_pkt_is_chksum_pending(pkt) && (flags & ZSOCK_MSG_PEEK) &&
+	    net_udp_verify_pending_chksum(pkt) < 0) {
+		/* Nothing to peek at, the datagram is dropped */
+		if (k_fifo_peek_head(&ctx->recv_q) == pkt) {
+			(void)k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+			net_pkt_unref(pkt);
+		}
+
+		goto bad_chksum;
+	}
+
+	/* The checksum left by the stack is computed while the data is read */
+	chksum = net_pkt_is_chksum_pending(pkt);
+	pkt_read = chksum ? net_pkt_read_chksum : net_pkt_read;
+
 	net_pkt_cursor_backup(pkt, &backup);
 
 	if (src_addr && addrlen) {
@@ -1162,7 +1194,7 @@ static ssize_t zsock_recv_dgram(struct net_context *ctx,
 
 			len = MIN(tmp_read_len, msg->msg_iov[iovec].iov_len);
 
-			if (net_pkt_read(pkt, buf, len)) {
+			if (pkt_read(pkt, buf, len)) {
 				errno = ENOBUFS;
 				goto fail;
 			}
@@ -1184,12 +1216,21 @@ static ssize_t zsock_recv_dgram(struct net_context *ctx,
 		recv_len = net_pkt_remaining_data(pkt);
 		read_len = MIN(recv_len, max_len);
 
-		if (net_pkt_read(pkt, buf, read_len)) {
+		if (pkt_read(pkt, buf, read_len)) {
 			errno = ENOBUFS;
 			goto fail;
 		}
 	}
 
+	if (chksum) {
+		/* The end of a truncated datagram is summed too */
+		if (net_pkt_read_chksum(pkt, NULL, recv_len - read_len) < 0 ||
+		    net_udp_verify_pending_chksum(pkt) < 0) {
+			net_pkt_unref(pkt);
+			goto bad_chksum;
+		}
+	}
+
 	if (msg != NULL) {
 		if (msg->msg_control != NULL) {
 			if (msg->msg_controllen > 0) {
@@ -1233,6 +1274,15 @@ static ssize_t zsock_recv_dgram(struct net_context *ctx,
 
 	return (flags & ZSOCK_MSG_TRUNC) ? recv_len : read_len;
 
+bad_chksum:
+	/* Wait for the next datagram as if this one never came */
+	if (!(flags & ZSOCK_MSG_DONTWAIT) && !sock_is_nonblock(ctx)) {
+		goto again;
+	}
+
+	errno = EAGAIN;
+	return -1;
+
 fail:
 	if (!(flags & ZSOCK_MSG_PEEK)) {
 		net_pkt_unref(pkt);
@@ -1606,6 +1656,10 @@ static enum tcp_conn_option get_tcp_option(int optname)
 		return TCP_OPT_KEEPINTVL;
 	case TCP_KEEPCNT:
 		return TCP_OPT_KEEPCNT;
+	case TCP_CONGESTION:
+		return TCP_OPT_CONGESTION;
+	case TCP_INFO:
+		return TCP_OPT_INFO;
 	}
 
 	return -EINVAL;
@@ -1891,6 +1945,22 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 			}
 
 			break;
+
+		case TCP_CONGESTION:
+			if (!IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				break;
+			}
+
+			__fallthrough;
+		case TCP_INFO:
+			ret = net_tcp_get_option(ctx, get_tcp_option(optname),
+						 optval, optlen);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+
+			return 0;
 		}
 
 		break;
@@ -2495,6 +2565,20 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_set_option(ctx, TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 		break;
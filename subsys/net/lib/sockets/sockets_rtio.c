@@ -0,0 +1,356 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_sock_rtio, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_rtio.h>
+#include <zephyr/net/socket_service.h>
+#include <zephyr/rtio/work.h>
+
+#define WAITING_MAX CONFIG_NET_SOCKETS_RTIO_WAITING_MAX
+
+static void socket_rtio_service_handler(struct net_socket_service_event *pev);
+
+NET_SOCKET_SERVICE_SYNC_DEFINE_STATIC(socket_rtio_service, socket_rtio_service_handler,
+				      WAITING_MAX);
+
+/* Reads waiting for data, and the socket each of them waits on */
+static struct rtio_iodev_sqe *waiting[WAITING_MAX];
+static int waiting_socks[WAITING_MAX];
+
+/* Sockets polled by the socket service thread, one entry for each socket
+ * reads wait on. The service is only registered again when this changes.
+ */
+static struct zsock_pollfd waiting_fds[WAITING_MAX] = {
+	[0 ... (WAITING_MAX - 1)] = { .fd = -1 },
+};
+static bool waiting_sync_deferred;
+static K_MUTEX_DEFINE(waiting_lock);
+
+static int socket_rtio_recv(const struct socket_rtio_data *data,
+			    struct rtio_iodev_sqe *iodev_sqe, int flags)
+{
+	uint8_t *buf;
+	uint32_t len;
+	ssize_t rc;
+
+	/* A read left waiting for data keeps the buffer it got here */
+	rc = rtio_sqe_rx_buf(iodev_sqe, 1, data->recv_max, &buf, &len);
+	if (rc != 0) {
+		return (int)rc;
+	}
+
+	rc = zsock_recv(data->sock, buf, len, flags);
+
+	return rc < 0 ? -errno : (int)rc;
+}
+
+static int socket_rtio_send(const struct socket_rtio_data *data,
+			    const uint8_t *buf, uint32_t len)
+{
+	uint32_t sent = 0U;
+	ssize_t rc;
+
+	/* A blocking stream socket may still send less than asked */
+	while (sent < len) {
+		rc = zsock_send(data->sock, buf + sent, len - sent, 0);
+		if (rc < 0) {
+			return -errno;
+		}
+
+		sent += rc;
+	}
+
+	return (int)sent;
+}
+
+static int socket_rtio_op(const struct socket_rtio_data *data,
+			  struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct rtio_sqe *sqe = &iodev_sqe->sqe;
+
+	switch (sqe->op) {
+	case RTIO_OP_NOP:
+		return 0;
+	case RTIO_OP_RX:
+		return socket_rtio_recv(data, iodev_sqe, 0);
+	case RTIO_OP_TX:
+		return socket_rtio_send(data, sqe->tx.buf, sqe->tx.buf_len);
+	case RTIO_OP_TINY_TX:
+		return socket_rtio_send(data, sqe->tiny_tx.buf, sqe->tiny_tx.buf_len);
+	default:
+		LOG_DBG("Unsupported op %u", sqe->op);
+		return -ENOTSUP;
+	}
+}
+
+static void socket_rtio_done(struct rtio_iodev_sqe *iodev_sqe, int rc)
+{
+	/* A multishot read ends with the connection, instead of completing
+	 * with 0 or the error again and again.
+	 */
+	if (rc <= 0) {
+		iodev_sqe->sqe.flags &= ~RTIO_SQE_MULTISHOT;
+	}
+
+	if (rc < 0) {
+		rtio_iodev_sqe_err(iodev_sqe, rc);
+	} else {
+		rtio_iodev_sqe_ok(iodev_sqe, rc);
+	}
+}
+
+/* Complete the waiting reads matching a socket, or the canceled ones when
+ * sock is -1. Called with the lock held.
+ */
+static void waiting_flush(int sock, int rc)
+{
+	struct rtio_iodev_sqe *iodev_sqe;
+
+	for (int i = 0; i < WAITING_MAX; i++) {
+		iodev_sqe = waiting[i];
+		if (iodev_sqe == NULL) {
+			continue;
+		}
+
+		if ((sock >= 0) ? (waiting_socks[i] != sock) :
+				  !FIELD_GET(RTIO_SQE_CANCELED, iodev_sqe->sqe.flags)) {
+			continue;
+		}
+
+		waiting[i] = NULL;
+		socket_rtio_done(iodev_sqe, rc);
+	}
+}
+
+static bool waiting_used(int sock)
+{
+	for (int i = 0; i < WAITING_MAX; i++) {
+		if ((waiting[i] != NULL) && (waiting_socks[i] == sock)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool waiting_polled(int sock)
+{
+	for (int i = 0; i < WAITING_MAX; i++) {
+		if (waiting_fds[i].fd == sock) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Poll the sockets reads wait on, and only those. Called with the lock
+ * held. Registering makes the service thread rebuild its poll array, so
+ * it is only done when the first read waits on a socket or the last one
+ * stops waiting, not for every read.
+ */
+static void waiting_sync(void)
+{
+	bool changed = false;
+
+	if (waiting_sync_deferred) {
+		return;
+	}
+
+	for (int i = 0; i < WAITING_MAX; i++) {
+		if ((waiting_fds[i].fd >= 0) && !waiting_used(waiting_fds[i].fd)) {
+			waiting_fds[i].fd = -1;
+			changed = true;
+		}
+	}
+
+	/* There are never more sockets than reads waiting on them */
+	for (int i = 0; i < WAITING_MAX; i++) {
+		if ((waiting[i] == NULL) || waiting_polled(waiting_socks[i])) {
+			continue;
+		}
+
+		for (int j = 0; j < WAITING_MAX; j++) {
+			if (waiting_fds[j].fd < 0) {
+				waiting_fds[j].fd = waiting_socks[i];
+				waiting_fds[j].events = ZSOCK_POLLIN;
+				changed = true;
+				break;
+			}
+		}
+	}
+
+	if (changed) {
+		(void)net_socket_service_register(&socket_rtio_service, waiting_fds,
+						  WAITING_MAX, NULL);
+	}
+}
+
+static bool waiting_add(struct rtio_iodev_sqe *iodev_sqe, int sock)
+{
+	bool added = false;
+
+	k_mutex_lock(&waiting_lock, K_FOREVER);
+
+	/* Canceled reads are only noticed here and when data arrives */
+	waiting_flush(-1, -ECANCELED);
+
+	for (int i = 0; i < WAITING_MAX; i++) {
+		if (waiting[i] == NULL) {
+			waiting[i] = iodev_sqe;
+			waiting_socks[i] = sock;
+			added = true;
+			break;
+		}
+	}
+
+	waiting_sync();
+
+	k_mutex_unlock(&waiting_lock);
+
+	return added;
+}
+
+static struct rtio_iodev_sqe *waiting_take(int sock)
+{
+	struct rtio_iodev_sqe *iodev_sqe;
+
+	for (int i = 0; i < WAITING_MAX; i++) {
+		if ((waiting[i] != NULL) && (waiting_socks[i] == sock)) {
+			iodev_sqe = waiting[i];
+			waiting[i] = NULL;
+			return iodev_sqe;
+		}
+	}
+
+	return NULL;
+}
+
+/* Runs in the RTIO work queue, where blocking is fine */
+static void socket_rtio_work(struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct socket_rtio_data *data = iodev_sqe->sqe.iodev->data;
+	struct rtio_iodev_sqe *txn_curr = iodev_sqe;
+	int total = 0;
+	int rc;
+
+	do {
+		rc = socket_rtio_op(data, txn_curr);
+		if (rc < 0) {
+			socket_rtio_done(iodev_sqe, rc);
+			return;
+		}
+
+		total += rc;
+		txn_curr = rtio_txn_next(txn_curr);
+	} while (txn_curr != NULL);
+
+	socket_rtio_done(iodev_sqe, total);
+}
+
+static void socket_rtio_work_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct rtio_work_req *req = rtio_work_req_alloc();
+
+	if (req == NULL) {
+		LOG_ERR("RTIO work item allocation failed. Consider to increase "
+			"CONFIG_RTIO_WORKQ_POOL_ITEMS.");
+		rtio_iodev_sqe_err(iodev_sqe, -ENOMEM);
+		return;
+	}
+
+	rtio_work_req_submit(req, iodev_sqe, socket_rtio_work);
+}
+
+/* Try a read without blocking, and leave it to the socket service thread
+ * if there is no data yet. Returns false if it has to block instead.
+ */
+static bool socket_rtio_recv_async(struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct socket_rtio_data *data = iodev_sqe->sqe.iodev->data;
+	int rc;
+
+	rc = socket_rtio_recv(data, iodev_sqe, ZSOCK_MSG_DONTWAIT);
+	if ((rc == -EAGAIN) || (rc == -EWOULDBLOCK)) {
+		return waiting_add(iodev_sqe, data->sock);
+	}
+
+	socket_rtio_done(iodev_sqe, rc);
+
+	return true;
+}
+
+static void socket_rtio_service_handler(struct net_socket_service_event *pev)
+{
+	int sock = pev->event.fd;
+	struct rtio_iodev_sqe *iodev_sqe;
+
+	k_mutex_lock(&waiting_lock, K_FOREVER);
+
+	/* A read taken here and still without data, such as a multishot
+	 * one, waits again on the same socket, which stays polled.
+	 */
+	waiting_sync_deferred = true;
+
+	waiting_flush(-1, -ECANCELED);
+
+	if ((pev->event.revents & ZSOCK_POLLNVAL) != 0) {
+		/* Closed without socket_rtio_iodev_close() */
+		waiting_flush(sock, -EBADF);
+	} else {
+		iodev_sqe = waiting_take(sock);
+		if ((iodev_sqe != NULL) && !socket_rtio_recv_async(iodev_sqe)) {
+			socket_rtio_work_submit(iodev_sqe);
+		}
+	}
+
+	waiting_sync_deferred = false;
+	waiting_sync();
+
+	k_mutex_unlock(&waiting_lock);
+}
+
+static void socket_rtio_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	/* Reads are polled for instead of blocking a work queue thread each.
+	 * Everything else, and reads beyond CONFIG_NET_SOCKETS_RTIO_WAITING_MAX,
+	 * block in the work queue.
+	 */
+	if ((iodev_sqe->sqe.op == RTIO_OP_RX) && (rtio_txn_next(iodev_sqe) == NULL) &&
+	    !k_is_in_isr() && socket_rtio_recv_async(iodev_sqe)) {
+		return;
+	}
+
+	socket_rtio_work_submit(iodev_sqe);
+}
+
+int socket_rtio_iodev_close(const struct rtio_iodev *iodev)
+{
+	struct socket_rtio_data *data = iodev->data;
+	int sock = data->sock;
+
+	if (sock < 0) {
+		return -EBADF;
+	}
+
+	k_mutex_lock(&waiting_lock, K_FOREVER);
+	waiting_flush(sock, -ECANCELED);
+	waiting_sync();
+	k_mutex_unlock(&waiting_lock);
+
+	data->sock = -1;
+
+	return zsock_close(sock) < 0 ? -errno : 0;
+}
+
+const struct rtio_iodev_api socket_rtio_iodev_api = {
+	.submit = socket_rtio_submit,
+};
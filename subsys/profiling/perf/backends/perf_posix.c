@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include "perf_posix_bottom.h"
+
+/* Frames of perf_posix_backtrace_bottom() and of this function */
+#define PERF_POSIX_SKIP_FRAMES 2
+#define PERF_POSIX_MAX_FRAMES 64
+
+/*
+ * On the POSIX architecture interrupts are handled synchronously on the
+ * host thread of the interrupted Zephyr thread, when it lets the simulated
+ * CPU run (idle, busy wait, interrupt unlock). The trace therefore covers
+ * both the interrupt handling path and the interrupted thread call chain.
+ */
+size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size)
+{
+	void *frames[PERF_POSIX_SKIP_FRAMES + PERF_POSIX_MAX_FRAMES];
+	int count;
+
+	count = perf_posix_backtrace_bottom(frames, ARRAY_SIZE(frames));
+	if (count <= PERF_POSIX_SKIP_FRAMES) {
+		return 0;
+	}
+
+	count -= PERF_POSIX_SKIP_FRAMES;
+	if ((size_t)count > size) {
+		return 0;
+	}
+
+	for (int i = 0; i < count; i++) {
+		buf[i] = (uintptr_t)frames[PERF_POSIX_SKIP_FRAMES + i];
+	}
+
+	return count;
+}
+
+static int perf_posix_init(void)
+{
+	void *frame;
+
+	/* The first call of the host unwinder may allocate memory, do not let
+	 * it happen in interrupt context.
+	 */
+	(void)perf_posix_backtrace_bottom(&frame, 1);
+
+	return 0;
+}
+
+SYS_INIT(perf_posix_init, APPLICATION, 0);
@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <execinfo.h>
+#include "perf_posix_bottom.h"
+
+int perf_posix_backtrace_bottom(void **buf, int size)
+{
+	/* The host unwinder relies on unwind tables, so this also works when
+	 * the host C library is built without frame pointers.
+	 */
+	return backtrace(buf, size);
+}
@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * "Bottom" of the perf backend for the native/hosted targets.
+ * When built with the native_simulator this will be built in the runner context,
+ * that is, with the host C library, and with the host include paths.
+ *
+ * Note: None of these functions are public interfaces. But internal to this perf backend.
+ */
+
+#ifndef SUBSYS_PROFILING_PERF_BACKENDS_PERF_POSIX_BOTTOM_H
+#define SUBSYS_PROFILING_PERF_BACKENDS_PERF_POSIX_BOTTOM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int perf_posix_backtrace_bottom(void **buf, int size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SUBSYS_PROFILING_PERF_BACKENDS_PERF_POSIX_BOTTOM_H */
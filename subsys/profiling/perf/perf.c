@@ -12,9 +12,31 @@
 #include <zephyr/shell/shell_uart.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#ifdef CONFIG_SYMTAB
+#include <zephyr/debug/symtab.h>
+#endif
+#ifdef CONFIG_FILE_SYSTEM
+#include <zephyr/fs/fs.h>
+#endif
 
 size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size);
 
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+#define PERF_THREAD_NAME_LEN 16
+
+/* One distinct (thread, stack trace) pair and the number of its samples */
+struct perf_stack {
+	uint32_t hash;
+	uint32_t count;
+	k_tid_t thread;
+	size_t depth;
+	char thread_name[PERF_THREAD_NAME_LEN];
+	uintptr_t pcs[CONFIG_PROFILING_PERF_MAX_DEPTH];
+};
+#endif
+
 struct perf_data_t {
 	struct k_timer timer;
 
@@ -22,9 +44,20 @@ struct perf_data_t {
 
 	struct k_work_delayable dwork;
 
+	bool running;
+
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+	struct k_spinlock lock;
+	size_t stacks_used;
+	uint32_t samples;
+	uint32_t dropped;
+	uint32_t unwind_failed;
+	struct perf_stack stacks[CONFIG_PROFILING_PERF_AGGREGATE_STACKS];
+#else
 	size_t idx;
 	uintptr_t buf[CONFIG_PROFILING_PERF_BUFFER_SIZE];
 	bool buf_full;
+#endif
 };
 
 static void perf_tracer(struct k_timer *timer);
@@ -34,6 +67,77 @@ static struct perf_data_t perf_data = {
 	.dwork = Z_WORK_DELAYABLE_INITIALIZER(perf_dwork_handler),
 };
 
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+static uint32_t perf_stack_hash(k_tid_t thread, const uintptr_t *pcs, size_t depth)
+{
+	/* FNV-1a over the thread pointer and the return addresses */
+	uint32_t hash = 2166136261U ^ (uint32_t)(uintptr_t)thread;
+
+	for (size_t i = 0; i < depth; i++) {
+		hash = (hash ^ (uint32_t)pcs[i]) * 16777619U;
+	}
+
+	return hash;
+}
+
+static void perf_tracer(struct k_timer *timer)
+{
+	struct perf_data_t *perf_data_ptr =
+		(struct perf_data_t *)k_timer_user_data_get(timer);
+	uintptr_t pcs[CONFIG_PROFILING_PERF_MAX_DEPTH];
+	k_tid_t thread = k_current_get();
+	k_spinlock_key_t key;
+	size_t depth;
+	uint32_t hash;
+
+	depth = arch_perf_current_stack_trace(pcs, ARRAY_SIZE(pcs));
+	hash = perf_stack_hash(thread, pcs, depth);
+
+	key = k_spin_lock(&perf_data_ptr->lock);
+
+	perf_data_ptr->samples++;
+
+	if (depth == 0) {
+		/* The backend could not unwind the stack */
+		perf_data_ptr->unwind_failed++;
+		goto out;
+	}
+
+	/* Open addressing with linear probing, entries are never removed
+	 * while recording.
+	 */
+	for (size_t i = 0; i < ARRAY_SIZE(perf_data_ptr->stacks); i++) {
+		struct perf_stack *stack = &perf_data_ptr->stacks[
+				(hash + i) % ARRAY_SIZE(perf_data_ptr->stacks)];
+
+		if (stack->count == 0U) {
+			stack->hash = hash;
+			stack->count = 1U;
+			stack->thread = thread;
+			stack->depth = depth;
+			memcpy(stack->pcs, pcs, depth * sizeof(pcs[0]));
+#ifdef CONFIG_THREAD_NAME
+			strncpy(stack->thread_name, k_thread_name_get(thread),
+				sizeof(stack->thread_name) - 1);
+#endif
+			perf_data_ptr->stacks_used++;
+			goto out;
+		}
+
+		if (stack->hash == hash && stack->thread == thread &&
+		    stack->depth == depth &&
+		    memcmp(stack->pcs, pcs, depth * sizeof(pcs[0])) == 0) {
+			stack->count++;
+			goto out;
+		}
+	}
+
+	perf_data_ptr->dropped++;
+
+out:
+	k_spin_unlock(&perf_data_ptr->lock, key);
+}
+#else
 static void perf_tracer(struct k_timer *timer)
 {
 	struct perf_data_t *perf_data_ptr =
@@ -56,6 +160,7 @@ static void perf_tracer(struct k_timer *timer)
 		k_work_reschedule(&perf_data_ptr->dwork, K_NO_WAIT);
 	}
 }
+#endif /* CONFIG_PROFILING_PERF_AGGREGATE */
 
 static void perf_dwork_handler(struct k_work *work)
 {
@@ -63,59 +168,243 @@ static void perf_dwork_handler(struct k_work *work)
 	struct perf_data_t *perf_data_ptr = CONTAINER_OF(dwork, struct perf_data_t, dwork);
 
 	k_timer_stop(&perf_data_ptr->timer);
+	perf_data_ptr->running = false;
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+	if (perf_data_ptr->dropped != 0U || perf_data_ptr->unwind_failed != 0U) {
+		shell_warn(perf_data_ptr->sh,
+			   "Perf done, %u/%u samples dropped, %u/%u unwinding failed",
+			   perf_data_ptr->dropped, perf_data_ptr->samples,
+			   perf_data_ptr->unwind_failed, perf_data_ptr->samples);
+		return;
+	}
+#else
 	if (perf_data_ptr->buf_full) {
 		shell_error(perf_data_ptr->sh, "Perf buf overflow!");
-	} else {
-		shell_print(perf_data_ptr->sh, "Perf done!");
+		return;
 	}
+#endif
+	shell_print(perf_data_ptr->sh, "Perf done!");
 }
 
 static int cmd_perf_record(const struct shell *sh, size_t argc, char **argv)
 {
-	if (k_work_delayable_is_pending(&perf_data.dwork)) {
+	if (perf_data.running) {
 		shell_warn(sh, "Perf is running");
 		return -EINPROGRESS;
 	}
 
+#ifndef CONFIG_PROFILING_PERF_AGGREGATE
 	if (perf_data.buf_full) {
 		shell_warn(sh, "Perf buffer is full");
 		return -ENOBUFS;
 	}
+#endif
+
+	long long duration_ms = strtoll(argv[1], NULL, 10);
+	long long frequency = strtoll(argv[2], NULL, 10);
+
+	if (duration_ms < 0 || frequency <= 0) {
+		shell_error(sh, "Invalid duration or frequency");
+		return -EINVAL;
+	}
 
-	k_timeout_t duration = K_MSEC(strtoll(argv[1], NULL, 10));
-	k_timeout_t period = K_NSEC(1000000000 / strtoll(argv[2], NULL, 10));
+	k_timeout_t period = K_NSEC(1000000000 / frequency);
 
 	perf_data.sh = sh;
+	perf_data.running = true;
 
 	k_timer_user_data_set(&perf_data.timer, &perf_data);
 	k_timer_start(&perf_data.timer, K_NO_WAIT, period);
 
-	k_work_schedule(&perf_data.dwork, duration);
+	/* A duration of 0 records until "perf stop" */
+	if (duration_ms > 0) {
+		k_work_schedule(&perf_data.dwork, K_MSEC(duration_ms));
+	}
 
 	shell_print(sh, "Enabled perf");
 
 	return 0;
 }
 
+static int cmd_perf_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	if (!perf_data.running) {
+		shell_warn(sh, "Perf is not running");
+		return -EALREADY;
+	}
+
+	k_work_reschedule(&perf_data.dwork, K_NO_WAIT);
+
+	return 0;
+}
+
 static int cmd_perf_clear(const struct shell *sh, size_t argc, char **argv)
 {
 	if (sh != NULL) {
-		if (k_work_delayable_is_pending(&perf_data.dwork)) {
+		if (perf_data.running) {
 			shell_warn(sh, "Perf is running");
 			return -EINPROGRESS;
 		}
 		shell_print(sh, "Perf buffer cleared");
 	}
 
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+	memset(perf_data.stacks, 0, sizeof(perf_data.stacks));
+	perf_data.stacks_used = 0;
+	perf_data.samples = 0;
+	perf_data.dropped = 0;
+	perf_data.unwind_failed = 0;
+#else
 	perf_data.idx = 0;
 	perf_data.buf_full = false;
+#endif
+
+	return 0;
+}
+
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+static int cmd_perf_info(const struct shell *sh, size_t argc, char **argv)
+{
+	if (perf_data.running) {
+		shell_print(sh, "Perf is running");
+	}
+
+	shell_print(sh, "Perf stacks: %zu/%d, samples: %u, dropped: %u, unwinding failed: %u",
+		    perf_data.stacks_used, CONFIG_PROFILING_PERF_AGGREGATE_STACKS,
+		    perf_data.samples, perf_data.dropped, perf_data.unwind_failed);
+
+	return 0;
+}
+
+typedef int (*perf_line_cb_t)(const char *line, void *user_data);
+
+/*
+ * Format one aggregated stack in the collapsed format used by FlameGraph:
+ * "thread;outermost_frame;...;innermost_frame count". Consecutive identical
+ * frames (e.g. unresolved ones) are merged.
+ */
+static int perf_stack_collapse(const struct perf_stack *stack, char *line, size_t size)
+{
+	const char *prev = NULL;
+	int len;
+
+	if (stack->thread_name[0] != '\0') {
+		len = snprintk(line, size, "%s", stack->thread_name);
+	} else {
+		len = snprintk(line, size, "thread_%p", stack->thread);
+	}
+
+	for (size_t i = stack->depth; i > 0 && (size_t)len < size; i--) {
+		uintptr_t pc = stack->pcs[i - 1];
+#ifdef CONFIG_SYMTAB
+		const char *name = symtab_find_symbol_name(pc, NULL);
+
+		if (prev != NULL && strcmp(prev, name) == 0) {
+			continue;
+		}
+		prev = name;
+		len += snprintk(line + len, size - len, ";%s", name);
+#else
+		ARG_UNUSED(prev);
+		len += snprintk(line + len, size - len, ";0x%lx", (unsigned long)pc);
+#endif
+	}
+
+	if ((size_t)len < size) {
+		len += snprintk(line + len, size - len, " %u", stack->count);
+	}
+
+	return (size_t)len < size ? 0 : -ENOMEM;
+}
+
+static int perf_collapse(perf_line_cb_t cb, void *user_data)
+{
+	static char line[CONFIG_PROFILING_PERF_LINE_SIZE];
+	struct perf_stack stack;
+	k_spinlock_key_t key;
+	int ret;
+
+	for (size_t i = 0; i < ARRAY_SIZE(perf_data.stacks); i++) {
+		/* Samples keep being aggregated while the profiler runs, take
+		 * a consistent snapshot of each entry.
+		 */
+		key = k_spin_lock(&perf_data.lock);
+		stack = perf_data.stacks[i];
+		k_spin_unlock(&perf_data.lock, key);
+
+		if (stack.count == 0U) {
+			continue;
+		}
+
+		if (perf_stack_collapse(&stack, line, sizeof(line)) < 0) {
+			/* Truncated line, still worth to output */
+			line[sizeof(line) - 1] = '\0';
+		}
+
+		ret = cb(line, user_data);
+		if (ret < 0) {
+			return ret;
+		}
+	}
 
 	return 0;
 }
 
+static int perf_shell_line(const char *line, void *user_data)
+{
+	shell_print((const struct shell *)user_data, "%s", line);
+
+	return 0;
+}
+
+static int cmd_perf_collapsed(const struct shell *sh, size_t argc, char **argv)
+{
+	return perf_collapse(perf_shell_line, (void *)sh);
+}
+
+#ifdef CONFIG_FILE_SYSTEM
+static int perf_file_line(const char *line, void *user_data)
+{
+	struct fs_file_t *file = user_data;
+	ssize_t ret;
+
+	ret = fs_write(file, line, strlen(line));
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = fs_write(file, "\n", 1);
+
+	return ret < 0 ? ret : 0;
+}
+
+static int cmd_perf_save(const struct shell *sh, size_t argc, char **argv)
+{
+	struct fs_file_t file;
+	int ret;
+
+	fs_file_t_init(&file);
+
+	ret = fs_open(&file, argv[1], FS_O_CREATE | FS_O_WRITE | FS_O_TRUNC);
+	if (ret < 0) {
+		shell_error(sh, "Cannot open %s (%d)", argv[1], ret);
+		return ret;
+	}
+
+	ret = perf_collapse(perf_file_line, &file);
+	if (ret < 0) {
+		shell_error(sh, "Write failed (%d)", ret);
+	}
+
+	fs_close(&file);
+
+	return ret;
+}
+#endif /* CONFIG_FILE_SYSTEM */
+#else
 static int cmd_perf_info(const struct shell *sh, size_t argc, char **argv)
 {
-	if (k_work_delayable_is_pending(&perf_data.dwork)) {
+	if (perf_data.running) {
 		shell_print(sh, "Perf is running");
 	}
 
@@ -127,7 +416,7 @@ static int cmd_perf_info(const struct shell *sh, size_t argc, char **argv)
 
 static int cmd_perf_print(const struct shell *sh, size_t argc, char **argv)
 {
-	if (k_work_delayable_is_pending(&perf_data.dwork)) {
+	if (perf_data.running) {
 		shell_warn(sh, "Perf is running");
 		return -EINPROGRESS;
 	}
@@ -141,14 +430,26 @@ static int cmd_perf_print(const struct shell *sh, size_t argc, char **argv)
 
 	return 0;
 }
+#endif /* CONFIG_PROFILING_PERF_AGGREGATE */
 
 #define CMD_HELP_RECORD                                                                            \
 	"Start recording for <duration> ms on <frequency> Hz\n"                                    \
+	"A <duration> of 0 records until \"perf stop\"\n"                                          \
 	"Usage: record <duration> <frequency>"
 
 SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_perf,
 	SHELL_CMD_ARG(record, NULL, CMD_HELP_RECORD, cmd_perf_record, 3, 0),
+	SHELL_CMD_ARG(stop, NULL, "Stop recording", cmd_perf_stop, 0, 0),
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+	SHELL_CMD_ARG(collapsed, NULL, "Print the samples in collapsed stack format",
+		      cmd_perf_collapsed, 0, 0),
+#ifdef CONFIG_FILE_SYSTEM
+	SHELL_CMD_ARG(save, NULL, "Save the samples in collapsed stack format\n"
+		      "Usage: save <file>", cmd_perf_save, 2, 0),
+#endif
+#else
 	SHELL_CMD_ARG(printbuf, NULL, "Print the perf buffer", cmd_perf_print, 0, 0),
+#endif
 	SHELL_CMD_ARG(clear, NULL, "Clear the perf buffer", cmd_perf_clear, 0, 0),
 	SHELL_CMD_ARG(info, NULL, "Print the perf info", cmd_perf_info, 0, 0),
 	SHELL_SUBCMD_SET_END
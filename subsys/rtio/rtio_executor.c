@@ -51,6 +51,19 @@ static inline void rtio_iodev_submit(struct rtio_iodev_sqe *iodev_sqe)
 	iodev_sqe->sqe.iodev->api->submit(iodev_sqe);
 }
 
+/**
+ * @brief Check whether a submission can be given to its iodev in a batch
+ *
+ * @param iodev_sqe Submission to work on
+ */
+static inline bool rtio_iodev_batchable(const struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct rtio_iodev *iodev = iodev_sqe->sqe.iodev;
+
+	return (iodev != NULL) && (iodev->api->submit_batch != NULL) &&
+	       !FIELD_GET(RTIO_SQE_CANCELED, iodev_sqe->sqe.flags);
+}
+
 /**
  * @brief Submit operations in the queue to iodevs
  *
@@ -62,6 +75,7 @@ void rtio_executor_submit(struct rtio *r)
 {
 	const uint16_t cancel_no_response = (RTIO_SQE_CANCELED | RTIO_SQE_NO_RESPONSE);
 	struct mpsc_node *node = mpsc_pop(&r->sq);
+	struct rtio_iodev_sqe *batch = NULL, *batch_tail = NULL;
 
 	while (node != NULL) {
 		struct rtio_iodev_sqe *iodev_sqe = CONTAINER_OF(node, struct rtio_iodev_sqe, q);
@@ -108,10 +122,33 @@ void rtio_executor_submit(struct rtio *r)
 		curr->next = NULL;
 		curr->r = r;
 
-		rtio_iodev_submit(iodev_sqe);
+		/* Consecutive submissions to an iodev able to take them at once are
+		 * linked through their queue nodes, which are free once popped.
+		 */
+		if (batch != NULL && (!rtio_iodev_batchable(iodev_sqe) ||
+				      iodev_sqe->sqe.iodev != batch->sqe.iodev)) {
+			batch->sqe.iodev->api->submit_batch(batch);
+			batch = NULL;
+		}
+
+		if (rtio_iodev_batchable(iodev_sqe)) {
+			mpsc_ptr_set(iodev_sqe->q.next, NULL);
+			if (batch == NULL) {
+				batch = iodev_sqe;
+			} else {
+				mpsc_ptr_set(batch_tail->q.next, &iodev_sqe->q);
+			}
+			batch_tail = iodev_sqe;
+		} else {
+			rtio_iodev_submit(iodev_sqe);
+		}
 
 		node = mpsc_pop(&r->sq);
 	}
+
+	if (batch != NULL) {
+		batch->sqe.iodev->api->submit_batch(batch);
+	}
 }
 
 /**
@@ -7,6 +7,7 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/rtio/rtio.h>
 #include <zephyr/sensing/sensing_sensor.h>
+#include <stdlib.h>
 #include "sensor_mgmt.h"
 
 LOG_MODULE_DECLARE(sensing, CONFIG_SENSING_LOG_LEVEL);
@@ -71,6 +72,298 @@ static int send_data_to_clients(struct sensing_sensor *sensor,
 	return 0;
 }
 
+#ifdef CONFIG_SENSING_BATCHING
+/*
+ * All sensing value structures are a header followed by readings, each made of
+ * a timestamp delta and one or three 32 bit values. The layout of a sensor's
+ * samples is looked up from the sample size it registered.
+ */
+struct sample_layout {
+	uint16_t size;
+	uint8_t readings_offset;
+	uint8_t shift_offset;
+	uint8_t value_count;
+	bool has_shift;
+};
+
+#define SAMPLE_LAYOUT(type, count, shift_offset_)				\
+	{									\
+		.size = sizeof(struct type),					\
+		.readings_offset = offsetof(struct type, readings),		\
+		.shift_offset = shift_offset_,					\
+		.value_count = count,						\
+		.has_shift = shift_offset_ != 0,				\
+	}
+
+static const struct sample_layout sample_layouts[] = {
+	SAMPLE_LAYOUT(sensing_sensor_value_3d_q31, 3,
+		      offsetof(struct sensing_sensor_value_3d_q31, shift)),
+	SAMPLE_LAYOUT(sensing_sensor_value_q31, 1,
+		      offsetof(struct sensing_sensor_value_q31, shift)),
+	SAMPLE_LAYOUT(sensing_sensor_value_uint32, 1, 0),
+};
+
+/* Single reading delivered without batching */
+union sample_buf {
+	struct sensing_sensor_value_3d_q31 v3d_q31;
+	struct sensing_sensor_value_q31 q31;
+	struct sensing_sensor_value_uint32 uint32;
+};
+
+static inline size_t reading_size(const struct sample_layout *layout)
+{
+	return sizeof(uint32_t) * (1 + layout->value_count);
+}
+
+static inline uint32_t *get_reading(void *buf, const struct sample_layout *layout, int idx)
+{
+	return (uint32_t *)((uint8_t *)buf + layout->readings_offset +
+			    idx * reading_size(layout));
+}
+
+static const struct sample_layout *get_sample_layout(struct sensing_sensor *sensor)
+{
+	if (sensor->register_info == NULL) {
+		return NULL;
+	}
+
+	ARRAY_FOR_EACH_PTR(sample_layouts, layout) {
+		if (layout->size == sensor->register_info->sample_size) {
+			return layout;
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * Decide whether a reading at time t is due for the connection. Clients get
+ * readings on a grid of multiples of their interval, so that clients with the
+ * same interval, such as the reporters of a virtual sensor, see the same
+ * timestamps. The value at a grid point is interpolated from the last reading
+ * of the source, which is kept once per source for all of its clients.
+ */
+static bool rate_match(struct sensing_sensor *sensor, struct sensing_connection *conn,
+		       const struct sample_layout *layout, uint64_t t, int8_t shift,
+		       const uint32_t *value, uint64_t *out_t, int32_t *out_value)
+{
+	uint64_t due = conn->next_consume_time;
+	uint64_t span;
+
+	/* first reading, or the source paused for more than an interval */
+	if (due == EXEC_TIME_INIT || t >= due + conn->interval) {
+		due = DIV_ROUND_UP(t, conn->interval) * conn->interval;
+	}
+
+	if (t < due) {
+		conn->next_consume_time = due;
+		return false;
+	}
+
+	conn->next_consume_time = due + conn->interval;
+
+	span = t - sensor->last_timestamp;
+	if (layout->has_shift && sensor->has_last && sensor->last_shift == shift &&
+	    sensor->last_timestamp < due && span <= 2ULL * conn->interval) {
+		for (int i = 0; i < layout->value_count; i++) {
+			int64_t diff = (int64_t)(int32_t)value[i] - sensor->last_value[i];
+
+			out_value[i] = sensor->last_value[i] +
+				       (int32_t)(diff * (int64_t)(due - sensor->last_timestamp) /
+						 (int64_t)span);
+		}
+		*out_t = due;
+	} else {
+		memcpy(out_value, value, layout->value_count * sizeof(int32_t));
+		*out_t = t;
+	}
+
+	return true;
+}
+
+static void deliver(struct sensing_connection *conn, const void *buf)
+{
+	if (!conn->callback_list || !conn->callback_list->on_data_event) {
+		LOG_WRN("sensor:%s event callback not registered", conn->source->dev->name);
+		return;
+	}
+
+	conn->callback_list->on_data_event(conn, buf, conn->callback_list->context);
+}
+
+static void flush_batch(struct sensing_connection *conn)
+{
+	struct sensing_sensor_value_header *header = conn->batch;
+
+	if (conn->batch_count == 0) {
+		return;
+	}
+
+	header->reading_count = conn->batch_count;
+	conn->batch_count = 0;
+
+	deliver(conn, conn->batch);
+}
+
+static void put_reading(struct sensing_connection *conn, const struct sample_layout *layout,
+			uint64_t t, int8_t shift, const int32_t *value)
+{
+	struct sensing_sensor_value_header *header;
+	union sample_buf one;
+	uint32_t *reading;
+	uint64_t now;
+	uint8_t *buf;
+
+	if (conn->latency != 0 && conn->batch == NULL) {
+		conn->batch = malloc(layout->readings_offset +
+				     CONFIG_SENSING_BATCH_MAX_READINGS * reading_size(layout));
+		if (conn->batch == NULL) {
+			LOG_WRN("sensor:%s no memory for batch", conn->source->dev->name);
+		}
+	}
+
+	if (conn->latency == 0 || conn->batch == NULL) {
+		/* latency was cleared, deliver what is left first */
+		if (conn->batch != NULL) {
+			flush_batch(conn);
+		}
+
+		buf = (uint8_t *)&one;
+		header = (struct sensing_sensor_value_header *)buf;
+		header->base_timestamp = t;
+		header->reading_count = 1;
+		if (layout->has_shift) {
+			buf[layout->shift_offset] = shift;
+		}
+
+		reading = get_reading(buf, layout, 0);
+		reading[0] = 0;
+		memcpy(&reading[1], value, layout->value_count * sizeof(int32_t));
+
+		deliver(conn, buf);
+		return;
+	}
+
+	buf = conn->batch;
+	header = conn->batch;
+
+	/* the readings of a batch share the shift of their values */
+	if (conn->batch_count > 0 && layout->has_shift &&
+	    (int8_t)buf[layout->shift_offset] != shift) {
+		flush_batch(conn);
+	}
+
+	if (conn->batch_count == 0) {
+		header->base_timestamp = t;
+		conn->batch_last = t;
+		/* delivered by then even if the source stops */
+		now = get_us();
+		conn->batch_deadline = conn->latency < EXEC_TIME_OFF - now ?
+				       now + conn->latency : EXEC_TIME_OFF;
+		if (layout->has_shift) {
+			buf[layout->shift_offset] = shift;
+		}
+	}
+
+	/* timestamp deltas are relative to the previous reading */
+	reading = get_reading(buf, layout, conn->batch_count);
+	reading[0] = (uint32_t)(t - conn->batch_last);
+	memcpy(&reading[1], value, layout->value_count * sizeof(int32_t));
+	conn->batch_last = t;
+	conn->batch_count++;
+
+	if (conn->batch_count == CONFIG_SENSING_BATCH_MAX_READINGS ||
+	    t - header->base_timestamp >= conn->latency) {
+		flush_batch(conn);
+	}
+}
+
+/*
+ * Deliver the batches held back for longer than their latency, and return the
+ * time the next one expires, EXEC_TIME_OFF if none. The readings of a source
+ * which stopped or slowed down would otherwise wait for its next sample.
+ */
+static uint64_t flush_expired_batches(uint64_t now)
+{
+	uint64_t next = EXEC_TIME_OFF;
+	struct sensing_connection *conn;
+
+	for_each_sensor(sensor) {
+		for_each_client_conn(sensor, conn) {
+			if (conn->batch_count == 0) {
+				continue;
+			}
+
+			if (conn->batch_deadline <= now) {
+				flush_batch(conn);
+			} else {
+				next = MIN(next, conn->batch_deadline);
+			}
+		}
+	}
+
+	return next;
+}
+
+/* send each reading to clients on the grid of their interval, batched by latency */
+static void send_readings_to_clients(struct sensing_sensor *sensor,
+				     const struct sample_layout *layout,
+				     void *data, uint32_t data_len)
+{
+	const struct sensing_sensor_value_header *header = data;
+	int8_t shift = layout->has_shift ? ((int8_t *)data)[layout->shift_offset] : 0;
+	struct sensing_connection *conn;
+	uint64_t t = header->base_timestamp;
+	int32_t value[3];
+	uint64_t value_t;
+	int count;
+
+	if (data_len < layout->readings_offset) {
+		return;
+	}
+
+	count = MIN(header->reading_count,
+		    (data_len - layout->readings_offset) / reading_size(layout));
+
+	for (int i = 0; i < count; i++) {
+		const uint32_t *reading = get_reading(data, layout, i);
+		/* clients on the same grid point share the rate matched reading */
+		uint32_t shared_interval = 0;
+		uint64_t shared_due = 0;
+		uint64_t shared_next = 0;
+		bool shared_match = false;
+
+		t += reading[0];
+
+		for_each_client_conn(sensor, conn) {
+			if (!is_client_request_data(conn)) {
+				continue;
+			}
+
+			if (conn->interval == shared_interval &&
+			    conn->next_consume_time == shared_due) {
+				conn->next_consume_time = shared_next;
+			} else {
+				shared_interval = conn->interval;
+				shared_due = conn->next_consume_time;
+				shared_match = rate_match(sensor, conn, layout, t, shift,
+							  &reading[1], &value_t, value);
+				shared_next = conn->next_consume_time;
+			}
+
+			if (shared_match) {
+				put_reading(conn, layout, value_t, shift, value);
+			}
+		}
+
+		sensor->last_timestamp = t;
+		sensor->last_shift = shift;
+		memcpy(sensor->last_value, &reading[1], layout->value_count * sizeof(int32_t));
+		sensor->has_last = true;
+	}
+}
+#endif /* CONFIG_SENSING_BATCHING */
+
 STRUCT_SECTION_START_EXTERN(sensing_sensor);
 STRUCT_SECTION_END_EXTERN(sensing_sensor);
 
@@ -91,9 +384,22 @@ static void dispatch_task(void *a, void *b, void *c)
 	}
 
 	while (true) {
+		k_timeout_t timeout = K_FOREVER;
 		struct rtio_cqe cqe;
 
-		rc = rtio_cqe_copy_out(&sensing_rtio_ctx, &cqe, 1, K_FOREVER);
+#ifdef CONFIG_SENSING_BATCHING
+		/* The wait for the next sample doubles as the latency timer of
+		 * the batches, whose data events have to come from this thread.
+		 */
+		uint64_t now = get_us();
+		uint64_t next = flush_expired_batches(now);
+
+		if (next != EXEC_TIME_OFF) {
+			timeout = K_USEC(next - now);
+		}
+#endif
+
+		rc = rtio_cqe_copy_out(&sensing_rtio_ctx, &cqe, 1, timeout);
 		if (rc < 1) {
 			continue;
 		}
@@ -113,7 +419,17 @@ static void dispatch_task(void *a, void *b, void *c)
 		    (uintptr_t)cqe.userdata < (uintptr_t)STRUCT_SECTION_END(sensing_sensor)) {
 			struct sensing_sensor *sensor = cqe.userdata;
 
+#ifdef CONFIG_SENSING_BATCHING
+			const struct sample_layout *layout = get_sample_layout(sensor);
+
+			if (layout != NULL) {
+				send_readings_to_clients(sensor, layout, data, data_len);
+			} else {
+				send_data_to_clients(sensor, data);
+			}
+#else
 			send_data_to_clients(sensor, data);
+#endif
 		}
 
 		rtio_release_buffer(&sensing_rtio_ctx, data, data_len);
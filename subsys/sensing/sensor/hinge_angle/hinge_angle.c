@@ -143,6 +143,11 @@ static void hinge_reporter_on_data_event(sensing_sensor_handle_t handle,
 			return;
 		}
 
+		sample->header.base_timestamp = MAX(data->sample[0].header.base_timestamp,
+						    data->sample[1].header.base_timestamp);
+		sample->header.reading_count = 1;
+		sample->shift = 0;
+		sample->readings[0].timestamp_delta = 0;
 		sample->readings[0].v = calc_hinge_angle(data);
 
 		struct rtio_iodev_sqe *sqe = data->sqe;
@@ -116,6 +116,11 @@ static int set_arbitrate_interval(struct sensing_sensor *sensor, uint32_t interv
 
 	sensor->interval = interval;
 
+#ifdef CONFIG_SENSING_BATCHING
+	/* do not interpolate across a pause in sampling */
+	sensor->has_last = false;
+#endif
+
 	return ret;
 }
 
@@ -181,6 +186,50 @@ static int config_sensitivity(struct sensing_sensor *sensor, int index)
 	return set_arbitrate_sensitivity(sensor, index, sensitivity);
 }
 
+#ifdef CONFIG_SENSING_BATCHING
+static uint64_t arbitrate_latency(struct sensing_sensor *sensor)
+{
+	struct sensing_connection *conn;
+	uint64_t min_latency = UINT64_MAX;
+
+	/* the sensor may batch no longer than its most demanding client */
+	for_each_client_conn(sensor, conn) {
+		if (!is_client_request_data(conn)) {
+			continue;
+		}
+		if (conn->latency < min_latency) {
+			min_latency = conn->latency;
+		}
+	}
+
+	return (min_latency == UINT64_MAX ? 0 : min_latency);
+}
+
+static void config_latency(struct sensing_sensor *sensor)
+{
+	struct sensing_submit_config *config = sensor->iodev->data;
+	uint64_t latency = arbitrate_latency(sensor);
+	struct sensor_value duration = {0};
+	int ret;
+
+	LOG_INF("config latency, sensor:%s, latency:%llu", sensor->dev->name, latency);
+
+	if (latency == sensor->latency) {
+		return;
+	}
+
+	sensor->latency = latency;
+
+	/* hardware batching is optional, the dispatch batches on its own */
+	duration.val1 = k_us_to_ticks_floor32(MIN(latency, UINT32_MAX));
+	ret = sensor_attr_set(sensor->dev, config->chan,
+			SENSOR_ATTR_BATCH_DURATION, &duration);
+	if (ret) {
+		LOG_DBG("%s set attr batch duration failed:%d", sensor->dev->name, ret);
+	}
+}
+#endif /* CONFIG_SENSING_BATCHING */
+
 static int config_sensor(struct sensing_sensor *sensor)
 {
 	int ret;
@@ -191,6 +240,10 @@ static int config_sensor(struct sensing_sensor *sensor)
 		LOG_WRN("sensor:%s config interval error", sensor->dev->name);
 	}
 
+#ifdef CONFIG_SENSING_BATCHING
+	config_latency(sensor);
+#endif
+
 	for (i = 0; i < sensor->sensitivity_count; i++) {
 		ret = config_sensitivity(sensor, i);
 		if (ret) {
@@ -275,6 +328,11 @@ static void init_connection(struct sensing_connection *conn,
 
 	conn->interval = 0;
 	memset(conn->sensitivity, 0x00, sizeof(conn->sensitivity));
+#ifdef CONFIG_SENSING_BATCHING
+	conn->latency = 0;
+	conn->batch = NULL;
+	conn->batch_count = 0;
+#endif
 	/* link connection to its reporter's client_list */
 	sys_slist_append(&conn->source->client_list, &conn->snode);
 }
@@ -382,6 +440,9 @@ int close_sensor(struct sensing_connection **conn)
 
 	save_config_and_notify(tmp_conn->source);
 
+#ifdef CONFIG_SENSING_BATCHING
+	free(tmp_conn->batch);
+#endif
 	free(*conn);
 	*conn = NULL;
 
@@ -440,6 +501,30 @@ int get_interval(struct sensing_connection *conn, uint32_t *interval)
 	return 0;
 }
 
+#ifdef CONFIG_SENSING_BATCHING
+int set_latency(struct sensing_connection *conn, uint64_t latency)
+{
+	__ASSERT(conn && conn->source, "set latency, connection or reporter not be NULL");
+
+	conn->latency = latency;
+
+	LOG_INF("set latency, sensor:%s, conn:%p, latency:%llu",
+		conn->source->dev->name, conn, latency);
+
+	save_config_and_notify(conn->source);
+
+	return 0;
+}
+
+int get_latency(struct sensing_connection *conn, uint64_t *latency)
+{
+	__ASSERT(conn, "get latency, connection not be NULL");
+	*latency = conn->latency;
+
+	return 0;
+}
+#endif /* CONFIG_SENSING_BATCHING */
+
 int set_sensitivity(struct sensing_connection *conn, int8_t index, uint32_t sensitivity)
 {
 	int i;
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "kernel_shell.h"
+
+#include <zephyr/kernel.h>
+
+static void latency_dump(const struct shell *sh,
+			 const struct k_sched_latency_stats *stats)
+{
+	/* Cannot use lld as it's less portable. */
+	shell_print(sh, "\twakeups: %u, max: %u, avg: %u cycles",
+		    stats->count, stats->max,
+		    stats->count != 0U ? (uint32_t)(stats->total / stats->count) : 0U);
+	shell_print(sh, "\tpreemptions: %u, ready: %u cycles",
+		    stats->preemptions, (uint32_t)stats->ready);
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(stats->hist); i++) {
+		if (stats->hist[i] == 0U) {
+			continue;
+		}
+
+		if (i == ARRAY_SIZE(stats->hist) - 1) {
+			shell_print(sh, "\t  >= 2^%-2u: %u", i, stats->hist[i]);
+		} else {
+			shell_print(sh, "\t   < 2^%-2u: %u", i + 1, stats->hist[i]);
+		}
+	}
+}
+
+static int cmd_kernel_sched_stats(const struct shell *sh, size_t argc,
+				  char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	static struct k_sched_stats stats;
+	int err;
+
+	err = k_sched_stats_get(&stats);
+	if (err != 0) {
+		shell_error(sh, "Failed to read scheduler statistics (err %d)", err);
+		return -ENOEXEC;
+	}
+
+	shell_print(sh, "run queue depth: %u, max: %u, avg: %u",
+		    stats.runq.depth, stats.runq.max_depth,
+		    stats.runq.switches != 0U ?
+		    (uint32_t)(stats.runq.depth_sum / stats.runq.switches) : 0U);
+	shell_print(sh, "context switches: %u", stats.runq.switches);
+	shell_print(sh, "IPIs: %u, %u cycles", stats.runq.ipis,
+		    (uint32_t)stats.runq.ipi_cycles);
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(stats.prio); i++) {
+		if ((stats.prio[i].count == 0U) && (stats.prio[i].preemptions == 0U)) {
+			continue;
+		}
+
+		shell_print(sh, "priority %d:", (int)i + K_HIGHEST_THREAD_PRIO);
+		latency_dump(sh, &stats.prio[i]);
+	}
+
+	return 0;
+}
+
+static void shell_sched_thread_dump(const struct k_thread *cthread,
+				    void *user_data)
+{
+	struct k_thread *thread = (struct k_thread *)cthread;
+	const struct shell *sh = (const struct shell *)user_data;
+	struct k_sched_latency_stats stats;
+	const char *tname = k_thread_name_get(thread);
+
+	if (k_thread_sched_latency_get(thread, &stats) != 0) {
+		return;
+	}
+
+	shell_print(sh, "%p %-10s priority: %d", thread, tname ? tname : "NA",
+		    k_thread_priority_get(thread));
+	latency_dump(sh, &stats);
+}
+
+static int cmd_kernel_sched_threads(const struct shell *sh, size_t argc,
+				    char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	k_thread_foreach_unlocked(shell_sched_thread_dump, (void *)sh);
+
+	return 0;
+}
+
+static int cmd_kernel_sched_reset(const struct shell *sh, size_t argc,
+				  char **argv)
+{
+	ARG_UNUSED(sh);
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	k_sched_stats_reset();
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_sched,
+	SHELL_CMD(stats, NULL, "Run queue and per priority latency statistics.",
+		  cmd_kernel_sched_stats),
+	SHELL_COND_CMD(CONFIG_THREAD_MONITOR, threads, NULL,
+		       "Per thread latency statistics.",
+		       cmd_kernel_sched_threads),
+	SHELL_CMD(reset, NULL, "Reset the run queue and per priority statistics.",
+		  cmd_kernel_sched_reset),
+	SHELL_SUBCMD_SET_END
+);
+
+KERNEL_CMD_ADD(sched, &sub_kernel_sched, "Scheduler statistics.", NULL);
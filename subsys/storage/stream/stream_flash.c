@@ -13,6 +13,7 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME, CONFIG_STREAM_FLASH_LOG_LEVEL);
 #include <zephyr/types.h>
 #include <string.h>
 #include <zephyr/drivers/flash.h>
+#include <zephyr/init.h>
 
 #include <zephyr/storage/stream_flash.h>
 
@@ -184,7 +185,8 @@ int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 
 #endif /* CONFIG_STREAM_FLASH_ERASE */
 
-static int flash_sync(struct stream_flash_ctx *ctx)
+/* Write buf_bytes of buf at the current write position */
+static int flash_sync_buf(struct stream_flash_ctx *ctx, uint8_t *buf, size_t buf_bytes)
 {
 	int rc = 0;
 	size_t write_addr = ctx->offset + ctx->bytes_written;
@@ -193,32 +195,32 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 	uint8_t filler;
 
 
-	if (ctx->buf_bytes == 0) {
+	if (buf_bytes == 0) {
 		return 0;
 	}
 
 	if (IS_ENABLED(CONFIG_STREAM_FLASH_ERASE)) {
 
-		rc = stream_flash_erase_to_append(ctx, ctx->buf_bytes);
+		rc = stream_flash_erase_to_append(ctx, buf_bytes);
 		if (rc < 0) {
 			LOG_ERR("stream_flash_forward_erase %d range=0x%08zx",
-				rc, ctx->buf_bytes);
+				rc, buf_bytes);
 			return rc;
 		}
 	}
 
 	fill_length = ctx->write_block_size;
-	if (ctx->buf_bytes % fill_length) {
-		fill_length -= ctx->buf_bytes % fill_length;
+	if (buf_bytes % fill_length) {
+		fill_length -= buf_bytes % fill_length;
 		filler = ctx->erase_value;
 
-		memset(ctx->buf + ctx->buf_bytes, filler, fill_length);
+		memset(buf + buf_bytes, filler, fill_length);
 	} else {
 		fill_length = 0;
 	}
 
-	buf_bytes_aligned = ctx->buf_bytes + fill_length;
-	rc = flash_write(ctx->fdev, write_addr, ctx->buf, buf_bytes_aligned);
+	buf_bytes_aligned = buf_bytes + fill_length;
+	rc = flash_write(ctx->fdev, write_addr, buf, buf_bytes_aligned);
 
 	if (rc != 0) {
 		LOG_ERR("flash_write error %d offset=0x%08zx", rc,
@@ -232,18 +234,17 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 		/* Invert to ensure that caller is able to discover a faulty
 		 * flash_read() even if no error code is returned.
 		 */
-		for (int i = 0; i < ctx->buf_bytes; i++) {
-			ctx->buf[i] = ~ctx->buf[i];
+		for (int i = 0; i < buf_bytes; i++) {
+			buf[i] = ~buf[i];
 		}
 
-		rc = flash_read(ctx->fdev, write_addr, ctx->buf,
-				ctx->buf_bytes);
+		rc = flash_read(ctx->fdev, write_addr, buf, buf_bytes);
 		if (rc != 0) {
 			LOG_ERR("flash read failed: %d", rc);
 			return rc;
 		}
 
-		rc = ctx->callback(ctx->buf, ctx->buf_bytes, write_addr);
+		rc = ctx->callback(buf, buf_bytes, write_addr);
 		if (rc != 0) {
 			LOG_ERR("callback failed: %d", rc);
 			return rc;
@@ -252,12 +253,143 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 
 #endif
 
-	ctx->bytes_written += ctx->buf_bytes;
-	ctx->buf_bytes = 0U;
+	ctx->bytes_written += buf_bytes;
+
+	return rc;
+}
+
+static int flash_sync(struct stream_flash_ctx *ctx)
+{
+	int rc = flash_sync_buf(ctx, ctx->buf, ctx->buf_bytes);
+
+	if (rc == 0) {
+		ctx->buf_bytes = 0U;
+	}
 
 	return rc;
 }
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+static K_THREAD_STACK_DEFINE(stream_flash_workq_stack, CONFIG_STREAM_FLASH_ASYNC_STACK_SIZE);
+static struct k_work_q stream_flash_workq;
+
+static void async_write_handler(struct k_work *work)
+{
+	struct stream_flash_ctx *ctx = CONTAINER_OF(work, struct stream_flash_ctx, async_work);
+	int rc;
+
+	rc = flash_sync_buf(ctx, ctx->async_buf, ctx->async_buf_bytes);
+	if (rc != 0) {
+		ctx->async_result = rc;
+	} else if (IS_ENABLED(CONFIG_STREAM_FLASH_ERASE)) {
+		/* Erase where the buffer being filled goes, while it fills.
+		 * A failure shows again when that buffer is written.
+		 */
+		(void)stream_flash_erase_to_append(ctx, MIN(ctx->buf_len,
+							    ctx->available - ctx->bytes_written));
+	}
+
+	if (ctx->async_cb) {
+		ctx->async_cb(ctx, rc, ctx->async_user_data);
+	}
+}
+
+/* Wait for the write in progress, if any, and return the first error */
+static int async_wait(struct stream_flash_ctx *ctx)
+{
+	struct k_work_sync sync;
+
+	(void)k_work_flush(&ctx->async_work, &sync);
+
+	return ctx->async_result;
+}
+
+/* Hand the full buffer over to the work queue and continue with the spare one */
+static int async_submit(struct stream_flash_ctx *ctx)
+{
+	uint8_t *spare;
+	int rc;
+
+	rc = async_wait(ctx);
+	if (rc != 0) {
+		return rc;
+	}
+
+	spare = ctx->async_buf;
+	ctx->async_buf = ctx->buf;
+	ctx->async_buf_bytes = ctx->buf_bytes;
+	ctx->async_queued += ctx->buf_bytes;
+	ctx->buf = spare;
+	ctx->buf_bytes = 0U;
+
+	rc = k_work_submit_to_queue(&stream_flash_workq, &ctx->async_work);
+
+	return rc < 0 ? rc : 0;
+}
+
+int stream_flash_async_init(struct stream_flash_ctx *ctx, uint8_t *buf,
+			    stream_flash_async_callback_t cb, void *user_data)
+{
+	if (!ctx || !buf) {
+		return -EFAULT;
+	}
+
+	if (ctx->buf_bytes != 0) {
+		return -EBUSY;
+	}
+
+	k_work_init(&ctx->async_work, async_write_handler);
+	ctx->async_cb = cb;
+	ctx->async_user_data = user_data;
+	ctx->async_buf = buf;
+	ctx->async_buf_bytes = 0U;
+	ctx->async_queued = ctx->bytes_written;
+	ctx->async_result = 0;
+	ctx->async_enabled = true;
+
+	return 0;
+}
+
+static int stream_flash_async_workq_init(void)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "stream_flash",
+	};
+
+	k_work_queue_start(&stream_flash_workq, stream_flash_workq_stack,
+			   K_THREAD_STACK_SIZEOF(stream_flash_workq_stack),
+			   CONFIG_STREAM_FLASH_ASYNC_PRIORITY, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(stream_flash_async_workq_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif /* CONFIG_STREAM_FLASH_ASYNC */
+
+/* Write the full buffer, or hand it over to the work queue */
+static int buffer_sync(struct stream_flash_ctx *ctx)
+{
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	if (ctx->async_enabled) {
+		return async_submit(ctx);
+	}
+#endif
+
+	return flash_sync(ctx);
+}
+
+/* Bytes written to flash, or on their way there */
+static size_t bytes_queued(const struct stream_flash_ctx *ctx)
+{
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	if (ctx->async_enabled) {
+		return ctx->async_queued;
+	}
+#endif
+
+	return ctx->bytes_written;
+}
+
 int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *data,
 				size_t len, bool flush)
 {
@@ -269,8 +401,9 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		return -EFAULT;
 	}
 
-	if (ctx->bytes_written + ctx->buf_bytes + len > ctx->available) {
-		return -ENOMEM;
+	if (bytes_queued(ctx) + ctx->buf_bytes + len > ctx->available) {
+		rc = -ENOMEM;
+		goto out;
 	}
 
 	while ((len - processed) >=
@@ -279,10 +412,10 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		       buf_empty_bytes);
 
 		ctx->buf_bytes = ctx->buf_len;
-		rc = flash_sync(ctx);
+		rc = buffer_sync(ctx);
 
 		if (rc != 0) {
-			return rc;
+			goto out;
 		}
 
 		processed += buf_empty_bytes;
@@ -296,9 +429,21 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 	}
 
 	if (flush && ctx->buf_bytes > 0) {
-		rc = flash_sync(ctx);
+		rc = buffer_sync(ctx);
 	}
 
+out:
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	/* Flushed or failed, nothing may be left in progress */
+	if (ctx->async_enabled && (flush || rc != 0)) {
+		int wait_rc = async_wait(ctx);
+
+		if (rc == 0) {
+			rc = wait_rc;
+		}
+	}
+#endif
+
 	return rc;
 }
 
@@ -407,6 +552,9 @@ int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 	ctx->erased_up_to = 0;
 #endif
 	ctx->erase_value = params->erase_value;
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	ctx->async_enabled = false;
+#endif
 
 	/* Inspection is deliberately done once context has been filled in */
 	if (IS_ENABLED(CONFIG_STREAM_FLASH_INSPECT)) {
@@ -14,6 +14,7 @@
 #include <zephyr/net/net_if.h>
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/debug/cpu_load.h>
+#include <tracing_core.h>
 
 static void _get_thread_name(struct k_thread *thread,
 			     ctf_bounded_string_t *name)
@@ -27,12 +28,85 @@ static void _get_thread_name(struct k_thread *thread,
 	}
 }
 
+#if defined(CONFIG_TRACING_CTF_TIMESTAMP) && defined(CONFIG_TRACING_CTF_COMPACT)
+#define CTF_HEADER_EXTENDED 0xFF
+
+/* Timestamp of the last extended header the host received */
+static uint32_t ctf_extended_tstamp;
+static bool ctf_extended_valid;
+
+static void ctf_extended_header_set(uint8_t *epacket, uint32_t tstamp)
+{
+	epacket[0] = CTF_HEADER_EXTENDED;
+	memcpy(&epacket[1], &tstamp, sizeof(tstamp));
+}
+
+void ctf_top_event_emit(uint8_t *epacket, uint32_t length)
+{
+	const uint8_t id = epacket[CTF_EXTENDED_HEADER_SIZE];
+	uint32_t tstamp, drop_num;
+	unsigned int key;
+	uint8_t *header;
+	uint16_t low;
+
+	/*
+	 * Events of per-CPU buffers do not reach the host in the order they
+	 * are emitted, they always carry the full timestamp.
+	 */
+	if (IS_ENABLED(CONFIG_TRACING_BUFFER_PER_CPU)) {
+		ctf_extended_header_set(epacket, k_cyc_to_ns_floor64(k_cycle_get_32()));
+		tracing_format_raw_data(epacket, length);
+		return;
+	}
+
+	key = irq_lock();
+
+	tstamp = k_cyc_to_ns_floor64(k_cycle_get_32());
+
+	/*
+	 * The host rebuilds the timestamp from its low 16 bits as long as
+	 * it increased by less than 2^16 since the previous event it decoded,
+	 * which is guaranteed when it did since the last extended header.
+	 */
+	if (ctf_extended_valid && tstamp - ctf_extended_tstamp <= UINT16_MAX) {
+		low = (uint16_t)tstamp;
+		header = &epacket[CTF_EXTENDED_HEADER_SIZE - sizeof(low)];
+		header[0] = id;
+		memcpy(&header[1], &low, sizeof(low));
+
+		tracing_format_raw_data(header, length - (header - epacket));
+		irq_unlock(key);
+		return;
+	}
+
+	ctf_extended_header_set(epacket, tstamp);
+
+	drop_num = tracing_packet_drop_num_get();
+	tracing_format_raw_data(epacket, length);
+
+	/* Events the tracing layer discards silently or drops */
+	ctf_extended_valid = is_tracing_enabled() &&
+			     !(IS_ENABLED(CONFIG_TRACING_ASYNC) && is_tracing_thread()) &&
+			     drop_num == tracing_packet_drop_num_get();
+	ctf_extended_tstamp = tstamp;
+
+	irq_unlock(key);
+}
+#endif
+
 void sys_trace_k_thread_switched_out(void)
 {
 	ctf_bounded_string_t name = { "unknown" };
 	struct k_thread *thread;
 
 	thread = k_sched_current_thread_query();
+
+	if (IS_ENABLED(CONFIG_TRACING_CTF_COMPACT)) {
+		ctf_top_thread_switched_out_compact((uint32_t)(uintptr_t)thread,
+						    arch_curr_cpu()->id);
+		return;
+	}
+
 	_get_thread_name(thread, &name);
 
 	ctf_top_thread_switched_out((uint32_t)(uintptr_t)thread, name);
@@ -52,6 +126,11 @@ void sys_trace_k_thread_wakeup(struct k_thread *thread)
 {
 	ctf_bounded_string_t name = { "unknown" };
 
+	if (IS_ENABLED(CONFIG_TRACING_CTF_COMPACT)) {
+		ctf_top_thread_wakeup_compact((uint32_t)(uintptr_t)thread);
+		return;
+	}
+
 	_get_thread_name(thread, &name);
 	ctf_top_thread_wakeup((uint32_t)(uintptr_t)thread, name);
 }
@@ -63,6 +142,13 @@ void sys_trace_k_thread_switched_in(void)
 	ctf_bounded_string_t name = { "unknown" };
 
 	thread = k_sched_current_thread_query();
+
+	if (IS_ENABLED(CONFIG_TRACING_CTF_COMPACT)) {
+		ctf_top_thread_switched_in_compact((uint32_t)(uintptr_t)thread,
+						   arch_curr_cpu()->id);
+		return;
+	}
+
 	_get_thread_name(thread, &name);
 
 	ctf_top_thread_switched_in((uint32_t)(uintptr_t)thread, name);
@@ -127,6 +213,11 @@ void sys_trace_k_thread_ready(struct k_thread *thread)
 {
 	ctf_bounded_string_t name = { "unknown" };
 
+	if (IS_ENABLED(CONFIG_TRACING_CTF_COMPACT)) {
+		ctf_top_thread_ready_compact((uint32_t)(uintptr_t)thread);
+		return;
+	}
+
 	_get_thread_name(thread, &name);
 
 	ctf_top_thread_ready((uint32_t)(uintptr_t)thread, name);
@@ -141,6 +232,11 @@ void sys_trace_k_thread_pend(struct k_thread *thread)
 {
 	ctf_bounded_string_t name = { "unknown" };
 
+	if (IS_ENABLED(CONFIG_TRACING_CTF_COMPACT)) {
+		ctf_top_thread_pend_compact((uint32_t)(uintptr_t)thread);
+		return;
+	}
+
 	_get_thread_name(thread, &name);
 	ctf_top_thread_pend((uint32_t)(uintptr_t)thread, name);
 }
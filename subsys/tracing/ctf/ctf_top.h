@@ -49,7 +49,25 @@
 		tracing_format_raw_data(epacket, sizeof(epacket));              \
 	}
 
-#ifdef CONFIG_TRACING_CTF_TIMESTAMP
+#if defined(CONFIG_TRACING_CTF_TIMESTAMP) && defined(CONFIG_TRACING_CTF_COMPACT)
+/*
+ * Room for the extended event header in front of the event id. The header,
+ * see tsdl/event_header_compact, is filled in by ctf_top_event_emit().
+ */
+#define CTF_EXTENDED_HEADER_SIZE 5
+
+#define CTF_EVENT(...)                                                         \
+	{                                                                      \
+		uint8_t epacket[CTF_EXTENDED_HEADER_SIZE                       \
+				MAP(CTF_INTERNAL_FIELD_SIZE, ##__VA_ARGS__)];   \
+		uint8_t *epacket_cursor = &epacket[CTF_EXTENDED_HEADER_SIZE];  \
+									       \
+		MAP(CTF_INTERNAL_FIELD_APPEND, ##__VA_ARGS__)                   \
+		ctf_top_event_emit(epacket, sizeof(epacket));                  \
+	}
+
+void ctf_top_event_emit(uint8_t *epacket, uint32_t length);
+#elif defined(CONFIG_TRACING_CTF_TIMESTAMP)
 #define CTF_EVENT(...)                                                         \
 	{                                                                      \
 		const uint32_t tstamp = k_cyc_to_ns_floor64(k_cycle_get_32()); \
@@ -186,6 +204,11 @@ typedef enum {
 	CTF_EVENT_GPIO_GET_PENDING_INT_EXIT = 0x7C,
 	CTF_EVENT_GPIO_FIRE_CALLBACKS_ENTER = 0x7D,
 	CTF_EVENT_GPIO_FIRE_CALLBACK = 0x7E,
+	CTF_EVENT_THREAD_SWITCHED_OUT_COMPACT = 0x7F,
+	CTF_EVENT_THREAD_SWITCHED_IN_COMPACT = 0x80,
+	CTF_EVENT_THREAD_READY_COMPACT = 0x81,
+	CTF_EVENT_THREAD_PENDING_COMPACT = 0x82,
+	CTF_EVENT_THREAD_WAKEUP_COMPACT = 0x83,
 } ctf_event_t;
 
 typedef struct {
@@ -283,6 +306,42 @@ static inline void ctf_top_thread_wakeup(uint32_t thread_id, ctf_bounded_string_
 		  thread_id, name);
 }
 
+/*
+ * Compact variants of the scheduling events, see CONFIG_TRACING_CTF_COMPACT.
+ * Thread names are only carried by the creation, name set and info events.
+ */
+static inline void ctf_top_thread_switched_out_compact(uint32_t thread_id,
+						       uint8_t cpu)
+{
+	CTF_EVENT(CTF_LITERAL(uint8_t, CTF_EVENT_THREAD_SWITCHED_OUT_COMPACT),
+		  thread_id, cpu);
+}
+
+static inline void ctf_top_thread_switched_in_compact(uint32_t thread_id,
+						      uint8_t cpu)
+{
+	CTF_EVENT(CTF_LITERAL(uint8_t, CTF_EVENT_THREAD_SWITCHED_IN_COMPACT),
+		  thread_id, cpu);
+}
+
+static inline void ctf_top_thread_ready_compact(uint32_t thread_id)
+{
+	CTF_EVENT(CTF_LITERAL(uint8_t, CTF_EVENT_THREAD_READY_COMPACT),
+		  thread_id);
+}
+
+static inline void ctf_top_thread_pend_compact(uint32_t thread_id)
+{
+	CTF_EVENT(CTF_LITERAL(uint8_t, CTF_EVENT_THREAD_PENDING_COMPACT),
+		  thread_id);
+}
+
+static inline void ctf_top_thread_wakeup_compact(uint32_t thread_id)
+{
+	CTF_EVENT(CTF_LITERAL(uint8_t, CTF_EVENT_THREAD_WAKEUP_COMPACT),
+		  thread_id);
+}
+
 static inline void ctf_top_isr_enter(void)
 {
 	CTF_EVENT(CTF_LITERAL(uint8_t, CTF_EVENT_ISR_ENTER));
@@ -75,6 +75,10 @@ uint32_t tracing_buffer_put(uint8_t *data, uint32_t size);
 /**
  * @brief Get address of the first valid data in tracing buffer.
  *
+ * With CONFIG_TRACING_BUFFER_PER_CPU, the buffers of the CPUs are drained
+ * in turn, the packets committed to a buffer are all returned before the
+ * next buffer is looked at.
+ *
  * @param data Pointer to the address. It's set to a location pointing to
  *             the first valid data within the tracing buffer.
  * @param size Requested buffer size (in bytes).
@@ -113,6 +117,45 @@ uint32_t tracing_buffer_get(uint8_t *data, uint32_t size);
  */
 uint32_t tracing_cmd_buffer_alloc(uint8_t **data);
 
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+/**
+ * @brief Get number of bytes committed to a CPU's tracing buffer.
+ *
+ * Only complete packets are ever committed, so draining exactly this
+ * amount never splits a packet.
+ *
+ * @param cpu CPU index.
+ *
+ * @return Number of bytes ready to be read.
+ */
+uint32_t tracing_buffer_cpu_size_get(unsigned int cpu);
+
+/**
+ * @brief Get address of the first valid data in a CPU's tracing buffer.
+ *
+ * @param cpu  CPU index.
+ * @param data Pointer to the address. It's set to a location pointing to
+ *             the first valid data within the tracing buffer.
+ * @param size Requested buffer size (in bytes).
+ *
+ * @return Size of valid buffer which can be smaller than requested
+ *         if there isn't enough valid data or buffer wraps.
+ */
+uint32_t tracing_buffer_cpu_get_claim(unsigned int cpu, uint8_t **data,
+				      uint32_t size);
+
+/**
+ * @brief Indicate number of bytes read from a CPU's claimed buffer.
+ *
+ * @param cpu  CPU index.
+ * @param size Number of bytes read from claimed buffer.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL Given @a size exceeds available data of tracing buffer.
+ */
+int tracing_buffer_cpu_get_finish(unsigned int cpu, uint32_t size);
+#endif /* CONFIG_TRACING_BUFFER_PER_CPU */
+
 #ifdef __cplusplus
 }
 #endif
@@ -14,9 +14,18 @@
 extern "C" {
 #endif
 
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+/* Every CPU owns its tracing buffer: masking local interrupts is enough
+ * and no lock is shared between CPUs.
+ */
+#define TRACING_LOCK()		{ unsigned int key; key = arch_irq_lock()
+
+#define TRACING_UNLOCK()	{ arch_irq_unlock(key); } }
+#else
 #define TRACING_LOCK()		{ int key; key = irq_lock()
 
 #define TRACING_UNLOCK()	{ irq_unlock(key); } }
+#endif
 
 /**
  * @brief Check tracing enabled or not.
@@ -38,6 +47,13 @@ void tracing_buffer_handle(uint8_t *data, uint32_t length);
  */
 void tracing_packet_drop_handle(void);
 
+/**
+ * @brief Get the number of dropped tracing packets.
+ *
+ * @return Number of packets dropped since tracing was initialized.
+ */
+uint32_t tracing_packet_drop_num_get(void);
+
 /**
  * @brief Handle tracing command.
  *
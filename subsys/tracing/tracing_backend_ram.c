@@ -7,6 +7,7 @@
 #include <ctype.h>
 #include <zephyr/kernel.h>
 #include <string.h>
+#include <zephyr/tracing/tracing_ram.h>
 #include <tracing_core.h>
 #include <tracing_buffer.h>
 #include <tracing_backend.h>
@@ -15,6 +16,179 @@ uint8_t ram_tracing[CONFIG_RAM_TRACING_BUFFER_SIZE];
 static uint32_t pos;
 static bool buffer_full;
 
+#ifdef CONFIG_RAM_TRACING_FLIGHT_RECORDER
+/*
+ * In flight recorder mode ram_tracing holds a ring of records, each made of
+ * a header followed by one tracing packet. The oldest records are dropped
+ * to make room for new ones.
+ */
+struct ram_tracing_record {
+	uint16_t length;
+	uint32_t stamp;
+} __packed;
+
+static struct k_spinlock ram_tracing_lock;
+static uint32_t head;
+static uint32_t used;
+static bool dumping;
+
+static void ring_write(uint32_t offset, const void *data, uint32_t length)
+{
+	uint32_t first = MIN(length, CONFIG_RAM_TRACING_BUFFER_SIZE - offset);
+
+	memcpy(ram_tracing + offset, data, first);
+	memcpy(ram_tracing, (const uint8_t *)data + first, length - first);
+}
+
+static void ring_read(uint32_t offset, void *data, uint32_t length)
+{
+	uint32_t first = MIN(length, CONFIG_RAM_TRACING_BUFFER_SIZE - offset);
+
+	memcpy(data, ram_tracing + offset, first);
+	memcpy((uint8_t *)data + first, ram_tracing, length - first);
+}
+
+static inline uint32_t ring_offset(uint32_t offset)
+{
+	return offset % CONFIG_RAM_TRACING_BUFFER_SIZE;
+}
+
+static void tracing_backend_ram_output(
+		const struct tracing_backend *backend,
+		uint8_t *data, uint32_t length)
+{
+	struct ram_tracing_record rec = {
+		.length = length,
+		.stamp = k_cycle_get_32(),
+	};
+	uint32_t needed = sizeof(rec) + length;
+	k_spinlock_key_t key;
+
+	if (needed > CONFIG_RAM_TRACING_BUFFER_SIZE || length > UINT16_MAX) {
+		return;
+	}
+
+	key = k_spin_lock(&ram_tracing_lock);
+
+	if (dumping) {
+		k_spin_unlock(&ram_tracing_lock, key);
+		return;
+	}
+
+	while (CONFIG_RAM_TRACING_BUFFER_SIZE - used < needed) {
+		struct ram_tracing_record oldest;
+
+		ring_read(head, &oldest, sizeof(oldest));
+		head = ring_offset(head + sizeof(oldest) + oldest.length);
+		used -= sizeof(oldest) + oldest.length;
+	}
+
+	pos = ring_offset(head + used);
+	ring_write(pos, &rec, sizeof(rec));
+	ring_write(ring_offset(pos + sizeof(rec)), data, length);
+	used += needed;
+
+	k_spin_unlock(&ram_tracing_lock, key);
+}
+
+int tracing_ram_dump(uint32_t window_ms, tracing_ram_dump_cb_t cb,
+		     void *user_data)
+{
+	uint64_t window = k_ms_to_cyc_ceil64(window_ms);
+	uint32_t now = k_cycle_get_32();
+	uint32_t offset, remaining;
+	k_spinlock_key_t key;
+	int count = 0;
+
+	/* New packets are dropped while dumping, so the records can be
+	 * walked without holding the lock while the callback runs.
+	 */
+	key = k_spin_lock(&ram_tracing_lock);
+	if (dumping) {
+		k_spin_unlock(&ram_tracing_lock, key);
+		return -EBUSY;
+	}
+	dumping = true;
+	offset = head;
+	remaining = used;
+	k_spin_unlock(&ram_tracing_lock, key);
+
+	while (remaining > 0U) {
+		struct ram_tracing_record rec;
+		uint32_t first;
+
+		ring_read(offset, &rec, sizeof(rec));
+		offset = ring_offset(offset + sizeof(rec));
+		remaining -= sizeof(rec) + rec.length;
+
+		if (window_ms == 0U || (now - rec.stamp) <= window) {
+			first = MIN(rec.length,
+				    CONFIG_RAM_TRACING_BUFFER_SIZE - offset);
+			cb(ram_tracing + offset, first, user_data);
+			if (first < rec.length) {
+				cb(ram_tracing, rec.length - first, user_data);
+			}
+			count++;
+		}
+
+		offset = ring_offset(offset + rec.length);
+	}
+
+	key = k_spin_lock(&ram_tracing_lock);
+	dumping = false;
+	k_spin_unlock(&ram_tracing_lock, key);
+
+	return count;
+}
+
+#ifdef CONFIG_RAM_TRACING_SHELL
+#include <zephyr/shell/shell.h>
+
+static void ram_tracing_shell_dump_cb(const uint8_t *data, uint32_t length,
+				      void *user_data)
+{
+	shell_hexdump((const struct shell *)user_data, data, length);
+}
+
+static int cmd_ram_tracing_dump(const struct shell *sh, size_t argc,
+				char **argv)
+{
+	uint32_t window_ms = CONFIG_RAM_TRACING_FLIGHT_RECORDER_WINDOW_MS;
+	int err = 0;
+	int ret;
+
+	if (argc > 1) {
+		window_ms = shell_strtoul(argv[1], 0, &err);
+		if (err != 0) {
+			shell_error(sh, "Invalid window: %s", argv[1]);
+			return err;
+		}
+	}
+
+	ret = tracing_ram_dump(window_ms, ram_tracing_shell_dump_cb,
+			       (void *)sh);
+	if (ret < 0) {
+		shell_error(sh, "Dump failed (%d)", ret);
+		return ret;
+	}
+
+	shell_print(sh, "%d packets", ret);
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_ram_tracing,
+	SHELL_CMD_ARG(dump, NULL,
+		      "Dump the flight recorder as hex CTF stream\n"
+		      "Usage: dump [window_ms] (0: whole buffer)",
+		      cmd_ram_tracing_dump, 1, 1),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(tracing_ram, &sub_ram_tracing,
+		   "RAM tracing backend commands", NULL);
+#endif /* CONFIG_RAM_TRACING_SHELL */
+#else
 static void tracing_backend_ram_output(
 		const struct tracing_backend *backend,
 		uint8_t *data, uint32_t length)
@@ -31,12 +205,17 @@ static void tracing_backend_ram_output(
 	memcpy(ram_tracing + pos, data, length);
 	pos += length;
 }
+#endif /* CONFIG_RAM_TRACING_FLIGHT_RECORDER */
 
 static void tracing_backend_ram_init(void)
 {
 	memset(ram_tracing, 0, CONFIG_RAM_TRACING_BUFFER_SIZE);
 	pos = 0;
 	buffer_full = false;
+#ifdef CONFIG_RAM_TRACING_FLIGHT_RECORDER
+	head = 0;
+	used = 0;
+#endif
 }
 
 const struct tracing_backend_api tracing_backend_ram_api = {
@@ -4,12 +4,66 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/barrier.h>
 #include <zephyr/sys/ring_buffer.h>
+#include <tracing_buffer.h>
 
-static struct ring_buf tracing_ring_buf;
-static uint8_t tracing_buffer[CONFIG_TRACING_BUFFER_SIZE + 1];
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+#define TRACING_BUFFER_NUM CONFIG_MP_MAX_NUM_CPUS
+#else
+#define TRACING_BUFFER_NUM 1
+#endif
+
+static struct ring_buf tracing_ring_buf[TRACING_BUFFER_NUM];
+static uint8_t tracing_buffer[TRACING_BUFFER_NUM][CONFIG_TRACING_BUFFER_SIZE + 1];
 static uint8_t tracing_cmd_buffer[CONFIG_TRACING_CMD_BUFFER_SIZE];
 
+/*
+ * Producers always run with (local) interrupts locked, see TRACING_LOCK(),
+ * so the current CPU cannot change while a buffer is being written.
+ */
+static inline struct ring_buf *tracing_ring_buf_local(void)
+{
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+	return &tracing_ring_buf[arch_curr_cpu()->id];
+#else
+	return &tracing_ring_buf[0];
+#endif
+}
+
+/*
+ * With a buffer per CPU, the tracing thread reads the buffer of another CPU.
+ * The data has to be written before the put index is published, and read
+ * before the get index hands the space back to the producer.
+ */
+static inline void tracing_buffer_fence(void)
+{
+	if (IS_ENABLED(CONFIG_TRACING_BUFFER_PER_CPU)) {
+		barrier_dmem_fence_full();
+	}
+}
+
+/* As ring_buf_get(), with the fence before the space is handed back */
+static uint32_t tracing_ring_buf_get(struct ring_buf *buf, uint8_t *data, uint32_t size)
+{
+	uint32_t total = 0U;
+	uint32_t partial;
+	uint8_t *src;
+
+	do {
+		partial = ring_buf_get_claim(buf, &src, size - total);
+		memcpy(data + total, src, partial);
+		total += partial;
+	} while (partial > 0U && total < size);
+
+	tracing_buffer_fence();
+	(void)ring_buf_get_finish(buf, total);
+
+	return total;
+}
+
 uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
 {
 	*data = &tracing_cmd_buffer[0];
@@ -19,51 +73,178 @@ uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
 
 uint32_t tracing_buffer_put_claim(uint8_t **data, uint32_t size)
 {
-	return ring_buf_put_claim(&tracing_ring_buf, data, size);
+	return ring_buf_put_claim(tracing_ring_buf_local(), data, size);
 }
 
 int tracing_buffer_put_finish(uint32_t size)
 {
-	return ring_buf_put_finish(&tracing_ring_buf, size);
+	/* Publish the data before the new put index */
+	tracing_buffer_fence();
+
+	return ring_buf_put_finish(tracing_ring_buf_local(), size);
 }
 
 uint32_t tracing_buffer_put(uint8_t *data, uint32_t size)
 {
-	return ring_buf_put(&tracing_ring_buf, data, size);
+	struct ring_buf *buf = tracing_ring_buf_local();
+	uint32_t total = 0U;
+	uint32_t partial;
+	uint8_t *dst;
+
+	/* As ring_buf_put(), with the fence before the index is published */
+	do {
+		partial = ring_buf_put_claim(buf, &dst, size - total);
+		memcpy(dst, data + total, partial);
+		total += partial;
+	} while (partial > 0U && total < size);
+
+	tracing_buffer_fence();
+	(void)ring_buf_put_finish(buf, total);
+
+	return total;
+}
+
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+/*
+ * The consumer drains the buffers of the CPUs in turn. It stays on a CPU
+ * until the bytes committed when it got there are read, so that a packet is
+ * never interleaved with the packets of another CPU.
+ */
+static unsigned int tracing_get_cpu;
+static uint32_t tracing_get_left;
+
+static struct ring_buf *tracing_ring_buf_consumer(void)
+{
+	unsigned int cpu;
+
+	if (tracing_get_left > 0U) {
+		return &tracing_ring_buf[tracing_get_cpu];
+	}
+
+	for (unsigned int i = 1; i <= TRACING_BUFFER_NUM; i++) {
+		cpu = (tracing_get_cpu + i) % TRACING_BUFFER_NUM;
+		tracing_get_left = tracing_buffer_cpu_size_get(cpu);
+		if (tracing_get_left > 0U) {
+			tracing_get_cpu = cpu;
+			break;
+		}
+	}
+
+	return &tracing_ring_buf[tracing_get_cpu];
 }
 
 uint32_t tracing_buffer_get_claim(uint8_t **data, uint32_t size)
 {
-	return ring_buf_get_claim(&tracing_ring_buf, data, size);
+	struct ring_buf *buf = tracing_ring_buf_consumer();
+
+	return ring_buf_get_claim(buf, data, MIN(size, tracing_get_left));
 }
 
 int tracing_buffer_get_finish(uint32_t size)
 {
-	return ring_buf_get_finish(&tracing_ring_buf, size);
+	int ret;
+
+	if (size > tracing_get_left) {
+		return -EINVAL;
+	}
+
+	tracing_buffer_fence();
+
+	ret = ring_buf_get_finish(&tracing_ring_buf[tracing_get_cpu], size);
+	if (ret == 0) {
+		tracing_get_left -= size;
+	}
+
+	return ret;
 }
 
 uint32_t tracing_buffer_get(uint8_t *data, uint32_t size)
 {
-	return ring_buf_get(&tracing_ring_buf, data, size);
+	uint32_t total = 0U;
+	uint32_t got;
+
+	while (total < size) {
+		struct ring_buf *buf = tracing_ring_buf_consumer();
+
+		if (tracing_get_left == 0U) {
+			break;
+		}
+
+		got = tracing_ring_buf_get(buf, data + total, MIN(size - total, tracing_get_left));
+		tracing_get_left -= got;
+		total += got;
+	}
+
+	return total;
+}
+#else
+uint32_t tracing_buffer_get_claim(uint8_t **data, uint32_t size)
+{
+	return ring_buf_get_claim(tracing_ring_buf_local(), data, size);
+}
+
+int tracing_buffer_get_finish(uint32_t size)
+{
+	return ring_buf_get_finish(tracing_ring_buf_local(), size);
 }
 
+uint32_t tracing_buffer_get(uint8_t *data, uint32_t size)
+{
+	return tracing_ring_buf_get(tracing_ring_buf_local(), data, size);
+}
+#endif /* CONFIG_TRACING_BUFFER_PER_CPU */
+
 void tracing_buffer_init(void)
 {
-	ring_buf_init(&tracing_ring_buf,
-		      sizeof(tracing_buffer), tracing_buffer);
+	for (int i = 0; i < TRACING_BUFFER_NUM; i++) {
+		ring_buf_init(&tracing_ring_buf[i],
+			      sizeof(tracing_buffer[i]), tracing_buffer[i]);
+	}
 }
 
 bool tracing_buffer_is_empty(void)
 {
-	return ring_buf_is_empty(&tracing_ring_buf);
+	for (int i = 0; i < TRACING_BUFFER_NUM; i++) {
+		if (!ring_buf_is_empty(&tracing_ring_buf[i])) {
+			return false;
+		}
+	}
+
+	return true;
 }
 
 uint32_t tracing_buffer_capacity_get(void)
 {
-	return ring_buf_capacity_get(&tracing_ring_buf);
+	return ring_buf_capacity_get(&tracing_ring_buf[0]);
 }
 
 uint32_t tracing_buffer_space_get(void)
 {
-	return ring_buf_space_get(&tracing_ring_buf);
+	return ring_buf_space_get(tracing_ring_buf_local());
+}
+
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+uint32_t tracing_buffer_cpu_size_get(unsigned int cpu)
+{
+	uint32_t size = ring_buf_size_get(&tracing_ring_buf[cpu]);
+
+	/* Pairs with the barrier in tracing_buffer_put_finish() */
+	barrier_dmem_fence_full();
+
+	return size;
+}
+
+uint32_t tracing_buffer_cpu_get_claim(unsigned int cpu, uint8_t **data,
+				      uint32_t size)
+{
+	return ring_buf_get_claim(&tracing_ring_buf[cpu], data, size);
+}
+
+int tracing_buffer_cpu_get_finish(unsigned int cpu, uint32_t size)
+{
+	/* The data is read before the space is handed back */
+	tracing_buffer_fence();
+
+	return ring_buf_get_finish(&tracing_ring_buf[cpu], size);
 }
+#endif /* CONFIG_TRACING_BUFFER_PER_CPU */
@@ -54,19 +54,51 @@ static K_SEM_DEFINE(tracing_thread_sem, 0, 1);
 static K_THREAD_STACK_DEFINE(tracing_thread_stack,
 			CONFIG_TRACING_THREAD_STACK_SIZE);
 
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+static void tracing_thread_drain_cpus(void)
+{
+	uint8_t *transferring_buf;
+	uint32_t transferring_length, pending;
+
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		/* Output a CPU's pending packets in one go so that packets
+		 * from different CPUs are never interleaved mid-packet.
+		 */
+		pending = tracing_buffer_cpu_size_get(cpu);
+
+		while (pending > 0U) {
+			transferring_length =
+				tracing_buffer_cpu_get_claim(
+						cpu, &transferring_buf,
+						pending);
+			tracing_buffer_handle(transferring_buf,
+					      transferring_length);
+			tracing_buffer_cpu_get_finish(cpu,
+						      transferring_length);
+			pending -= transferring_length;
+		}
+	}
+}
+#endif
+
 static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 {
+#ifndef CONFIG_TRACING_BUFFER_PER_CPU
 	uint8_t *transferring_buf;
 	uint32_t transferring_length, tracing_buffer_max_length;
 
-	tracing_thread_tid = k_current_get();
-
 	tracing_buffer_max_length = tracing_buffer_capacity_get();
+#endif
+
+	tracing_thread_tid = k_current_get();
 
 	while (true) {
 		if (tracing_buffer_is_empty()) {
 			k_sem_take(&tracing_thread_sem, K_FOREVER);
 		} else {
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+			tracing_thread_drain_cpus();
+#else
 			transferring_length =
 				tracing_buffer_get_claim(
 						&transferring_buf,
@@ -74,6 +106,7 @@ static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 			tracing_buffer_handle(transferring_buf,
 					      transferring_length);
 			tracing_buffer_get_finish(transferring_length);
+#endif
 		}
 	}
 }
@@ -160,3 +193,8 @@ void tracing_packet_drop_handle(void)
 {
 	atomic_inc(&tracing_packet_drop_num);
 }
+
+uint32_t tracing_packet_drop_num_get(void)
+{
+	return atomic_get(&tracing_packet_drop_num);
+}
@@ -0,0 +1,407 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the requests per second two CoAP services handle on the loopback
+ * interface, asked by a CoAP client for each service, and the run time of
+ * the server threads while they retransmit confirmable messages nobody
+ * acknowledges.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/coap_client.h>
+#include <zephyr/net/coap_service.h>
+#include <string.h>
+
+#define ITERATIONS CONFIG_BENCHMARK_ITERATIONS
+#define PENDINGS   CONFIG_BENCHMARK_PENDINGS
+#define WINDOW     CONFIG_BENCHMARK_WINDOW
+#define WORKERS    CONFIG_COAP_SERVER_WORKERS
+
+BUILD_ASSERT(PENDINGS <= CONFIG_COAP_SERVICE_PENDING_MESSAGES,
+	     "Each message needs a pending entry");
+
+#define SERVICES  2
+#define SINK_PORT 5700
+
+#define SINK_STACK_SIZE 1024
+#define SINK_PRIORITY   K_PRIO_PREEMPT(7)
+
+/* Retransmitted every 50 to 75 ms */
+#define RETRANSMIT_TIMEOUT 50
+
+static const char payload[] = "bench";
+
+static int bench_get(struct coap_resource *resource, struct coap_packet *request,
+		     struct sockaddr *addr, socklen_t addr_len)
+{
+	uint8_t buf[COAP_TOKEN_MAX_LEN + 16];
+	struct coap_packet response;
+	int ret;
+
+	ret = coap_ack_init(&response, request, buf, sizeof(buf), COAP_RESPONSE_CODE_CONTENT);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = coap_packet_append_payload_marker(&response);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = coap_packet_append_payload(&response, payload, sizeof(payload) - 1);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return coap_resource_send(resource, &response, addr, addr_len, NULL);
+}
+
+static const uint16_t bench_a_port = 5683;
+COAP_SERVICE_DEFINE(bench_a, "127.0.0.1", &bench_a_port, COAP_SERVICE_AUTOSTART);
+
+static const char * const bench_a_path[] = { "bench", NULL };
+COAP_RESOURCE_DEFINE(bench_a_resource, bench_a, {
+	.path = bench_a_path,
+	.get = bench_get,
+});
+
+static const uint16_t bench_b_port = 5684;
+COAP_SERVICE_DEFINE(bench_b, "127.0.0.1", &bench_b_port, COAP_SERVICE_AUTOSTART);
+
+static const char * const bench_b_path[] = { "bench", NULL };
+COAP_RESOURCE_DEFINE(bench_b_resource, bench_b, {
+	.path = bench_b_path,
+	.get = bench_get,
+});
+
+static const struct coap_service *const services[SERVICES] = { &bench_a, &bench_b };
+
+static struct coap_client clients[SERVICES];
+static int client_socks[SERVICES] = { -1, -1 };
+
+/* Requests which can be sent without waiting for a response */
+static K_SEM_DEFINE(window, SERVICES * CONFIG_COAP_CLIENT_MAX_REQUESTS, K_SEM_MAX_LIMIT);
+static atomic_t failures;
+
+K_THREAD_STACK_DEFINE(sink_stack, SINK_STACK_SIZE);
+static struct k_thread sink_thread;
+static int sink_sock = -1;
+static atomic_t received;
+
+static struct sockaddr_in service_addr(const struct coap_service *service)
+{
+	return (struct sockaddr_in){
+		.sin_family = AF_INET,
+		.sin_port = htons(*service->port),
+		.sin_addr = INADDR_LOOPBACK_INIT,
+	};
+}
+
+static void response_cb(int16_t result_code, size_t offset, const uint8_t *data, size_t len,
+			bool last_block, void *user_data)
+{
+	ARG_UNUSED(offset);
+	ARG_UNUSED(user_data);
+
+	if (result_code != COAP_RESPONSE_CODE_CONTENT || len != sizeof(payload) - 1 ||
+	    memcmp(data, payload, len) != 0 || !last_block) {
+		atomic_inc(&failures);
+	}
+
+	k_sem_give(&window);
+}
+
+static int request(int i)
+{
+	static struct coap_client_request req = {
+		.method = COAP_METHOD_GET,
+		.confirmable = true,
+		.path = "bench",
+		.fmt = COAP_CONTENT_FORMAT_TEXT_PLAIN,
+		.cb = response_cb,
+	};
+	struct sockaddr_in addr = service_addr(services[i % SERVICES]);
+	int ret;
+
+	/* The client releases a request once its callback returned */
+	while ((ret = coap_client_req(&clients[i % SERVICES], client_socks[i % SERVICES],
+				      (struct sockaddr *)&addr, &req, NULL)) == -EAGAIN) {
+		k_yield();
+	}
+
+	return ret;
+}
+
+static int open_clients(void)
+{
+	for (int i = 0; i < SERVICES; i++) {
+		client_socks[i] = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+		if (client_socks[i] < 0) {
+			return -errno;
+		}
+
+		if (coap_client_init(&clients[i], NULL) < 0) {
+			return -EIO;
+		}
+	}
+
+	return 0;
+}
+
+/* Sum of the run time of the threads of the CoAP server */
+static void add_server_cycles(const struct k_thread *thread, void *user_data)
+{
+	k_thread_runtime_stats_t stats;
+	const char *name = k_thread_name_get((k_tid_t)thread);
+
+	if (name == NULL || strncmp(name, "coap_server", strlen("coap_server")) != 0) {
+		return;
+	}
+
+	if (k_thread_runtime_stats_get((k_tid_t)thread, &stats) == 0) {
+		*(uint64_t *)user_data += stats.execution_cycles;
+	}
+}
+
+static uint64_t server_cycles(void)
+{
+	uint64_t cycles = 0;
+
+	k_thread_foreach(add_server_cycles, &cycles);
+
+	return cycles;
+}
+
+static int measure_requests(uint32_t *rps, uint32_t *cpu_us)
+{
+	timing_t start, finish;
+	uint64_t cycles;
+	uint64_t ns;
+	int ret = 0;
+
+	cycles = server_cycles();
+	start = timing_counter_get();
+
+	for (int i = 0; i < ITERATIONS && ret == 0; i++) {
+		(void)k_sem_take(&window, K_FOREVER);
+		ret = request(i);
+	}
+
+	/* All the responses */
+	for (int i = 0; i < SERVICES * CONFIG_COAP_CLIENT_MAX_REQUESTS; i++) {
+		if (k_sem_take(&window, K_SECONDS(5)) < 0) {
+			return -ETIMEDOUT;
+		}
+	}
+
+	finish = timing_counter_get();
+	cycles = server_cycles() - cycles;
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (atomic_get(&failures) > 0) {
+		return -EIO;
+	}
+
+	ns = MAX(timing_cycles_to_ns(timing_cycles_get(&start, &finish)), 1);
+	*rps = (uint64_t)ITERATIONS * NSEC_PER_SEC / ns;
+	*cpu_us = k_cyc_to_us_floor64(cycles) * NSEC_PER_SEC / ns;
+
+	return 0;
+}
+
+static void sink(void *p1, void *p2, void *p3)
+{
+	uint8_t buf[64];
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		if (zsock_recv(sink_sock, buf, sizeof(buf), 0) > 0) {
+			atomic_inc(&received);
+		}
+	}
+}
+
+static int start_sink(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SINK_PORT),
+		.sin_addr = INADDR_LOOPBACK_INIT,
+	};
+
+	sink_sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (sink_sock < 0) {
+		return -errno;
+	}
+
+	if (zsock_bind(sink_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		zsock_close(sink_sock);
+		return -errno;
+	}
+
+	k_thread_create(&sink_thread, sink_stack, K_THREAD_STACK_SIZEOF(sink_stack), sink,
+			NULL, NULL, NULL, SINK_PRIORITY, 0, K_NO_WAIT);
+	k_thread_name_set(&sink_thread, "coap_sink");
+
+	return 0;
+}
+
+/* Confirmable messages of the first service to the sink, which never
+ * acknowledges them.
+ */
+static int send_confirmable(void)
+{
+	static const struct coap_transmission_parameters params = {
+		.ack_timeout = RETRANSMIT_TIMEOUT,
+		.coap_backoff_percent = 100,
+		.max_retransmission = UINT8_MAX,
+	};
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SINK_PORT),
+		.sin_addr = INADDR_LOOPBACK_INIT,
+	};
+	uint8_t buf[COAP_TOKEN_MAX_LEN + 16];
+	struct coap_packet cpkt;
+	uint8_t token[COAP_TOKEN_MAX_LEN];
+	int ret;
+
+	for (int i = 0; i < PENDINGS; i++) {
+		memcpy(token, &i, sizeof(i));
+
+		ret = coap_packet_init(&cpkt, buf, sizeof(buf), COAP_VERSION_1, COAP_TYPE_CON,
+				       sizeof(i), token, COAP_RESPONSE_CODE_CONTENT,
+				       coap_next_id());
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = coap_service_send(&bench_a, &cpkt, (struct sockaddr *)&addr, sizeof(addr),
+					&params);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static int measure_retransmit(uint32_t *per_s, uint32_t *cpu_us)
+{
+	uint64_t cycles;
+	int64_t start;
+	int64_t elapsed;
+	int ret;
+
+	ret = send_confirmable();
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* Leave the first transmissions out */
+	k_msleep(RETRANSMIT_TIMEOUT / 2);
+
+	atomic_set(&received, 0);
+	cycles = server_cycles();
+	start = k_uptime_get();
+
+	k_msleep(WINDOW);
+
+	cycles = server_cycles() - cycles;
+	elapsed = MAX(k_uptime_get() - start, 1);
+
+	*per_s = atomic_get(&received) * MSEC_PER_SEC / elapsed;
+	*cpu_us = k_cyc_to_us_floor64(cycles) * MSEC_PER_SEC / elapsed;
+
+	return *per_s > 0 ? 0 : -EIO;
+}
+
+static void report(const char *name, uint32_t per_s, uint32_t cpu_us)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s/%d - per_s:%u, cpu_us:%u\n", name, WORKERS, per_s, cpu_us);
+#else
+	printk("%-10s %d workers: %7u per second, server threads %7u us per second\n", name,
+	       WORKERS, per_s, cpu_us);
+#endif /* CONFIG_BENCHMARK_RECORDING */
+}
+
+static int run(void)
+{
+	uint32_t per_s;
+	uint32_t cpu_us;
+	int ret;
+
+	for (int i = 0; i < SERVICES; i++) {
+		if (coap_service_is_running(services[i]) != 1) {
+			printk("Service %s is not running\n", services[i]->name);
+			return -ENOTCONN;
+		}
+	}
+
+	ret = open_clients();
+	if (ret < 0) {
+		printk("Cannot set up the clients (%d)\n", ret);
+		return ret;
+	}
+
+	ret = measure_requests(&per_s, &cpu_us);
+	if (ret < 0) {
+		printk("requests: %d failures (%d)\n", (int)atomic_get(&failures), ret);
+		return ret;
+	}
+
+	report("requests", per_s, cpu_us);
+
+	ret = start_sink();
+	if (ret < 0) {
+		printk("Cannot start the sink (%d)\n", ret);
+		return ret;
+	}
+
+	ret = measure_retransmit(&per_s, &cpu_us);
+	if (ret < 0) {
+		printk("retransmit: nothing retransmitted (%d)\n", ret);
+		return ret;
+	}
+
+	report("retransmit", per_s, cpu_us);
+
+	return 0;
+}
+
+int main(void)
+{
+	int ret;
+
+	timing_init();
+	timing_start();
+
+	TC_START("CoAP server load");
+
+	/* The services are started by the server thread */
+	k_msleep(100);
+
+	ret = run();
+
+	timing_stop();
+
+	TC_END_REPORT(ret == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
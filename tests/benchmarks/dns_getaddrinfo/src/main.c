@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the latency of getaddrinfo() with a stub DNS server on the
+ * loopback interface, for names the server has to be asked about and for
+ * names found in the DNS resolver cache, with and without an address.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/dns_resolve.h>
+#include <string.h>
+
+#define ITERATIONS CONFIG_BENCHMARK_ITERATIONS
+
+#define SERVER_STACK_SIZE 2048
+#define SERVER_PRIORITY   K_PRIO_COOP(5)
+
+#define DNS_HEADER_LEN 12
+#define DNS_MSG_MAX    512
+#define DNS_TTL        300
+
+#define HOST_NAME    "host.example.com"
+#define MISSING_NAME "nx.example.com"
+
+K_THREAD_STACK_DEFINE(server_stack, SERVER_STACK_SIZE);
+static struct k_thread server_thread;
+static int server_sock = -1;
+
+/* Name compressed as a pointer to the question */
+static const uint8_t rr_name[] = { 0xc0, DNS_HEADER_LEN };
+
+static size_t put_rr(uint8_t *buf, uint16_t type, const uint8_t *rdata, uint16_t rdlength)
+{
+	memcpy(buf, rr_name, sizeof(rr_name));
+	sys_put_be16(type, buf + 2);
+	sys_put_be16(1, buf + 4); /* IN */
+	sys_put_be32(DNS_TTL, buf + 6);
+	sys_put_be16(rdlength, buf + 10);
+	memcpy(buf + 12, rdata, rdlength);
+
+	return 12 + rdlength;
+}
+
+/* An address for HOST_NAME, NXDOMAIN with the SOA record for the others */
+static size_t answer(uint8_t *msg, size_t len)
+{
+	static const uint8_t address[] = { 192, 0, 2, 1 };
+	/* Root MNAME and RNAME, then SERIAL, REFRESH, RETRY, EXPIRE and MINIMUM */
+	static const uint8_t soa[] = {
+		0, 0,
+		0, 0, 0, 1,
+		0, 0, 0x0e, 0x10,
+		0, 0, 0x02, 0x58,
+		0, 0x09, 0x3a, 0x80,
+		0, 0, 0x01, 0x2c,
+	};
+	static const uint8_t host_qname[] = "\x04host\x07" "example\x03" "com";
+	size_t question_end = DNS_HEADER_LEN;
+	bool known;
+
+	while (question_end < len && msg[question_end] != 0) {
+		question_end += msg[question_end] + 1;
+	}
+
+	/* The null label, QTYPE and QCLASS */
+	question_end += 1 + 4;
+	if (question_end > len || question_end + 12 + sizeof(soa) > DNS_MSG_MAX) {
+		return 0;
+	}
+
+	known = question_end - DNS_HEADER_LEN - 4 == sizeof(host_qname) &&
+		memcmp(msg + DNS_HEADER_LEN, host_qname, sizeof(host_qname)) == 0;
+
+	msg[2] = 0x81; /* Response, recursion desired */
+	msg[3] = known ? 0x80 : 0x83; /* Recursion available, NOERROR or NXDOMAIN */
+	sys_put_be16(known ? 1 : 0, msg + 6);
+	sys_put_be16(known ? 0 : 1, msg + 8);
+	sys_put_be16(0, msg + 10);
+
+	if (known) {
+		return question_end + put_rr(msg + question_end, 1, address, sizeof(address));
+	}
+
+	return question_end + put_rr(msg + question_end, 6, soa, sizeof(soa));
+}
+
+static void server(void *p1, void *p2, void *p3)
+{
+	static uint8_t msg[DNS_MSG_MAX];
+	struct sockaddr addr;
+	socklen_t addrlen;
+	ssize_t len;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		addrlen = sizeof(addr);
+		len = zsock_recvfrom(server_sock, msg, sizeof(msg), 0, &addr, &addrlen);
+		if (len < DNS_HEADER_LEN) {
+			continue;
+		}
+
+		len = answer(msg, len);
+		if (len > 0) {
+			(void)zsock_sendto(server_sock, msg, len, 0, &addr, addrlen);
+		}
+	}
+}
+
+static int start_server(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(CONFIG_BENCHMARK_SERVER_PORT),
+		.sin_addr = INADDR_LOOPBACK_INIT,
+	};
+
+	server_sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (server_sock < 0) {
+		return -errno;
+	}
+
+	if (zsock_bind(server_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		zsock_close(server_sock);
+		return -errno;
+	}
+
+	k_thread_create(&server_thread, server_stack, K_THREAD_STACK_SIZEOF(server_stack),
+			server, NULL, NULL, NULL, SERVER_PRIORITY, 0, K_NO_WAIT);
+	k_thread_name_set(&server_thread, "dns_stub");
+
+	return 0;
+}
+
+static int lookup(const char *name, bool flush)
+{
+	static const struct zsock_addrinfo hints = {
+		.ai_family = AF_INET,
+		.ai_socktype = SOCK_DGRAM,
+	};
+	struct zsock_addrinfo *res = NULL;
+	int ret;
+
+	if (flush) {
+		(void)dns_resolve_cache_flush();
+	}
+
+	ret = zsock_getaddrinfo(name, NULL, &hints, &res);
+	if (ret == 0) {
+		zsock_freeaddrinfo(res);
+	}
+
+	return ret;
+}
+
+static int measure(const char *name, bool flush, int expected, uint64_t *ns)
+{
+	timing_t start, finish;
+	int ret;
+
+	/* Fill the cache, the server might also need to be scheduled once */
+	ret = lookup(name, flush);
+	if (ret != expected) {
+		return ret == 0 ? -EIO : ret;
+	}
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		ret = lookup(name, flush);
+		if (ret != expected) {
+			return ret == 0 ? -EIO : ret;
+		}
+	}
+
+	finish = timing_counter_get();
+
+	*ns = timing_cycles_to_ns(timing_cycles_get(&start, &finish)) / ITERATIONS;
+
+	return 0;
+}
+
+static void report(const char *name, uint64_t ns)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s - ns:%u\n", name, (uint32_t)ns);
+#else
+	printk("%-14s: %9u ns per lookup\n", name, (uint32_t)ns);
+#endif /* CONFIG_BENCHMARK_RECORDING */
+}
+
+static int run(void)
+{
+	static const struct {
+		const char *name;
+		const char *host;
+		bool flush;
+		int expected;
+	} cases[] = {
+		{ "server", HOST_NAME, true, 0 },
+		{ "cache", HOST_NAME, false, 0 },
+		{ "nxdomain", MISSING_NAME, true, DNS_EAI_NONAME },
+		{ "nxdomain-cache", MISSING_NAME, false, DNS_EAI_NONAME },
+	};
+	struct dns_resolve_cache_stats stats;
+	uint64_t ns;
+	int ret;
+
+	ret = start_server();
+	if (ret < 0) {
+		printk("Cannot start the DNS server (%d)\n", ret);
+		return ret;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(cases); i++) {
+		ret = measure(cases[i].host, cases[i].flush, cases[i].expected, &ns);
+		if (ret != 0) {
+			printk("%s: lookup of %s failed (%d)\n", cases[i].name, cases[i].host,
+			       ret);
+			return -EIO;
+		}
+
+		report(cases[i].name, ns);
+	}
+
+	if (dns_resolve_cache_stats_get(&stats) == 0) {
+		printk("cache: %u hits, %u negative hits, %u misses\n", stats.hits,
+		       stats.negative_hits, stats.misses);
+	}
+
+	return 0;
+}
+
+int main(void)
+{
+	int ret;
+
+	timing_init();
+	timing_start();
+
+	TC_START("DNS getaddrinfo() latency");
+
+	ret = run();
+
+	timing_stop();
+
+	TC_END_REPORT(ret == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure sequential read and write throughput of ext2 on a RAM backed disk
+ * that takes time for each request, and count the requests.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/drivers/disk.h>
+#include <zephyr/storage/disk_access.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/sys/printk.h>
+#include <string.h>
+
+#define DISK_NAME    "BENCH"
+#define MNT_POINT    "/ext"
+#define FILE_PATH    MNT_POINT "/data"
+#define SECTOR_SIZE  512
+#define SECTOR_COUNT (CONFIG_BENCHMARK_DISK_SIZE * 1024 / SECTOR_SIZE)
+#define FILE_SIZE    (CONFIG_BENCHMARK_FILE_SIZE * 1024)
+#define CHUNK_SIZE   CONFIG_BENCHMARK_CHUNK_SIZE
+
+BUILD_ASSERT((FILE_SIZE % CHUNK_SIZE) == 0);
+
+static uint8_t disk_data[SECTOR_COUNT * SECTOR_SIZE];
+static uint32_t disk_requests;
+
+static uint8_t chunk[CHUNK_SIZE];
+static uint8_t read_back[CHUNK_SIZE];
+
+static struct fs_mount_t mnt = {
+	.type = FS_EXT2,
+	.storage_dev = DISK_NAME,
+	.mnt_point = MNT_POINT,
+	.flags = FS_MOUNT_FLAG_NO_FORMAT,
+};
+
+static void disk_request(uint32_t num_sector)
+{
+	disk_requests++;
+	k_busy_wait(CONFIG_BENCHMARK_REQUEST_TIME_US +
+		    CONFIG_BENCHMARK_SECTOR_TIME_US * num_sector);
+}
+
+static int disk_bench_status(struct disk_info *disk)
+{
+	return DISK_STATUS_OK;
+}
+
+static int disk_bench_read(struct disk_info *disk, uint8_t *buf, uint32_t sector,
+			   uint32_t count)
+{
+	if (sector + count > SECTOR_COUNT) {
+		return -EIO;
+	}
+
+	disk_request(count);
+	memcpy(buf, &disk_data[sector * SECTOR_SIZE], count * SECTOR_SIZE);
+
+	return 0;
+}
+
+static int disk_bench_write(struct disk_info *disk, const uint8_t *buf, uint32_t sector,
+			    uint32_t count)
+{
+	if (sector + count > SECTOR_COUNT) {
+		return -EIO;
+	}
+
+	disk_request(count);
+	memcpy(&disk_data[sector * SECTOR_SIZE], buf, count * SECTOR_SIZE);
+
+	return 0;
+}
+
+static int disk_bench_ioctl(struct disk_info *disk, uint8_t cmd, void *buf)
+{
+	switch (cmd) {
+	case DISK_IOCTL_CTRL_SYNC:
+	case DISK_IOCTL_CTRL_INIT:
+	case DISK_IOCTL_CTRL_DEINIT:
+		break;
+	case DISK_IOCTL_GET_SECTOR_COUNT:
+		*(uint32_t *)buf = SECTOR_COUNT;
+		break;
+	case DISK_IOCTL_GET_SECTOR_SIZE:
+		*(uint32_t *)buf = SECTOR_SIZE;
+		break;
+	case DISK_IOCTL_GET_ERASE_BLOCK_SZ:
+		*(uint32_t *)buf = 1U;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int disk_bench_init(struct disk_info *disk)
+{
+	return disk_bench_ioctl(disk, DISK_IOCTL_CTRL_INIT, NULL);
+}
+
+static const struct disk_operations disk_bench_ops = {
+	.init = disk_bench_init,
+	.status = disk_bench_status,
+	.read = disk_bench_read,
+	.write = disk_bench_write,
+	.ioctl = disk_bench_ioctl,
+};
+
+static struct disk_info disk_bench = {
+	.name = DISK_NAME,
+	.ops = &disk_bench_ops,
+};
+
+static void fill_chunk(size_t offset, uint8_t pass)
+{
+	for (size_t i = 0; i < CHUNK_SIZE; i++) {
+		chunk[i] = (uint8_t)((offset + i) * 31U + pass);
+	}
+}
+
+static int write_file(struct fs_file_t *file, uint8_t pass)
+{
+	ssize_t len;
+	int ret;
+
+	ret = fs_seek(file, 0, FS_SEEK_SET);
+
+	for (size_t offset = 0; (offset < FILE_SIZE) && (ret == 0); offset += CHUNK_SIZE) {
+		fill_chunk(offset, pass);
+
+		len = fs_write(file, chunk, CHUNK_SIZE);
+		if (len != CHUNK_SIZE) {
+			return len < 0 ? len : -ENOSPC;
+		}
+	}
+
+	return ret == 0 ? fs_sync(file) : ret;
+}
+
+static int seq_write(struct fs_file_t *file)
+{
+	return write_file(file, 0);
+}
+
+static int seq_rewrite(struct fs_file_t *file)
+{
+	return write_file(file, 1);
+}
+
+static int seq_read(struct fs_file_t *file)
+{
+	ssize_t len;
+	int ret;
+
+	ret = fs_seek(file, 0, FS_SEEK_SET);
+
+	for (size_t offset = 0; (offset < FILE_SIZE) && (ret == 0); offset += CHUNK_SIZE) {
+		len = fs_read(file, read_back, CHUNK_SIZE);
+		if (len != CHUNK_SIZE) {
+			return len < 0 ? len : -EIO;
+		}
+
+		fill_chunk(offset, 1);
+		if (memcmp(chunk, read_back, CHUNK_SIZE) != 0) {
+			printk("file differs at 0x%zx\n", offset);
+			ret = -EIO;
+		}
+	}
+
+	return ret;
+}
+
+static int measure(const char *op, int (*test)(struct fs_file_t *file), struct fs_file_t *file)
+{
+	timing_t start, finish;
+	uint32_t requests;
+	uint64_t ns;
+	int ret;
+
+	disk_requests = 0;
+	start = timing_counter_get();
+	ret = test(file);
+	finish = timing_counter_get();
+	requests = disk_requests;
+
+	if (ret != 0) {
+		printk("%s failed (%d)\n", op, ret);
+		return ret;
+	}
+
+	ns = timing_cycles_to_ns(timing_cycles_get(&start, &finish));
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s - bytes:%u, requests:%u, us:%u, KiB/s:%u\n", op, FILE_SIZE, requests,
+	       (uint32_t)(ns / NSEC_PER_USEC),
+	       (uint32_t)((uint64_t)FILE_SIZE * NSEC_PER_SEC / 1024 / ns));
+#else
+	printk("%-11s: %7u bytes, %6u requests in %9u us, %6u KiB/s\n", op, FILE_SIZE,
+	       requests, (uint32_t)(ns / NSEC_PER_USEC),
+	       (uint32_t)((uint64_t)FILE_SIZE * NSEC_PER_SEC / 1024 / ns));
+#endif /* CONFIG_BENCHMARK_RECORDING */
+
+	return 0;
+}
+
+static int run(void)
+{
+	struct fs_file_t file;
+	int ret;
+
+	ret = disk_access_register(&disk_bench);
+	if (ret != 0) {
+		printk("registering the disk failed (%d)\n", ret);
+		return ret;
+	}
+
+	ret = fs_mkfs(FS_EXT2, (uintptr_t)DISK_NAME, NULL, 0);
+	if (ret != 0) {
+		printk("formatting failed (%d)\n", ret);
+		return ret;
+	}
+
+	ret = fs_mount(&mnt);
+	if (ret != 0) {
+		printk("mounting failed (%d)\n", ret);
+		return ret;
+	}
+
+	fs_file_t_init(&file);
+	ret = fs_open(&file, FILE_PATH, FS_O_CREATE | FS_O_RDWR);
+	if (ret != 0) {
+		printk("opening the file failed (%d)\n", ret);
+		goto out;
+	}
+
+	ret = measure("seq_write", seq_write, &file);
+	if (ret == 0) {
+		ret = measure("seq_rewrite", seq_rewrite, &file);
+	}
+	if (ret == 0) {
+		ret = measure("seq_read", seq_read, &file);
+	}
+
+	fs_close(&file);
+out:
+	fs_unmount(&mnt);
+
+	return ret;
+}
+
+int main(void)
+{
+	int ret;
+
+	timing_init();
+	timing_start();
+
+	TC_START("Ext2 sequential I/O on a disk with request overhead");
+
+	ret = run();
+
+	timing_stop();
+
+	TC_END_REPORT(ret == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
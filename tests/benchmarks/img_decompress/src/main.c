@@ -0,0 +1,393 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the effective throughput of an image download over a slow link,
+ * written to a simulated flash as it is with flash_img_buffered_write() and
+ * compressed with flash_img_decompress_write(), for images which compress
+ * more or less well.
+ *
+ * The images are made of random runs and of runs repeated from earlier in
+ * the image, as code is, and compressed here with a greedy compressor in the
+ * format chosen by CONFIG_IMG_DECOMPRESS_FORMAT.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/dfu/flash_img.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/sys/printk.h>
+#include <string.h>
+
+#define IMAGE_SIZE   (CONFIG_BENCHMARK_IMAGE_SIZE * 1024)
+#define CHUNK_SIZE   CONFIG_BENCHMARK_CHUNK_SIZE
+#define PARTITION_ID FIXED_PARTITION_ID(slot1_partition)
+#define WINDOW_BITS  CONFIG_IMG_DECOMPRESS_WINDOW_BITS
+#define MAX_DIST     MIN(BIT(WINDOW_BITS), UINT16_MAX)
+#define HASH_BITS    12
+
+#if defined(CONFIG_IMG_DECOMPRESS_LZ4)
+#define FORMAT       "lz4"
+#define LZ4_BLOCK    4096
+#else
+#define FORMAT       "heatshrink"
+#define LOOKAHEAD_BITS 4
+#endif
+
+/* Random data expands a little */
+#define COMPRESSED_SIZE (sizeof(struct flash_img_compressed_header) + IMAGE_SIZE * 9 / 8 + 64)
+
+/* Percentage of the image made of random runs */
+static const uint8_t random_pcts[] = { 100, 50, 25, 10 };
+
+static struct flash_img_context ctx;
+static uint8_t image[IMAGE_SIZE];
+static uint8_t compressed[COMPRESSED_SIZE];
+static uint8_t read_back[CHUNK_SIZE];
+static uint32_t hash_table[BIT(HASH_BITS)];
+
+/* Runs only need to vary, xorshift is plenty */
+static uint32_t random_u32(void)
+{
+	static uint32_t state = 0x12345678U;
+
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+
+	return state;
+}
+
+static void fill_image(uint8_t random_pct)
+{
+	size_t pos = 0;
+
+	while (pos < IMAGE_SIZE) {
+		size_t len = MIN(4 + random_u32() % 29, IMAGE_SIZE - pos);
+
+		if (pos < 64 || (random_u32() % 100) < random_pct) {
+			for (size_t i = 0; i < len; i++) {
+				image[pos + i] = (uint8_t)random_u32();
+			}
+		} else {
+			size_t dist = 1 + random_u32() % MIN(pos, MAX_DIST / 2);
+
+			for (size_t i = 0; i < len; i++) {
+				image[pos + i] = image[pos + i - dist];
+			}
+		}
+
+		pos += len;
+	}
+}
+
+static uint32_t hash(size_t pos, size_t len)
+{
+	uint32_t v = 0;
+
+	for (size_t i = 0; i < len; i++) {
+		v = (v << 8) | image[pos + i];
+	}
+
+	return (v * 2654435761U) >> (32 - HASH_BITS);
+}
+
+/* Longest match for pos at the last position with the same hash, if near enough */
+static size_t find_match(size_t pos, size_t prefix, size_t max_len, size_t *dist)
+{
+	uint32_t h = hash(pos, prefix);
+	size_t cand = hash_table[h];
+	size_t len = 0;
+
+	hash_table[h] = pos + 1;
+
+	if (cand == 0 || pos + 1 - cand > MAX_DIST) {
+		return 0;
+	}
+
+	cand--;
+	while (len < max_len && image[cand + len] == image[pos + len]) {
+		len++;
+	}
+
+	*dist = pos - cand;
+
+	return len;
+}
+
+#if defined(CONFIG_IMG_DECOMPRESS_LZ4)
+#define LZ4_MIN_MATCH     4
+#define LZ4_LAST_LITERALS 5
+#define LZ4_MF_LIMIT      12
+
+static uint8_t *lz4_length(uint8_t *out, size_t len)
+{
+	for (; len >= UINT8_MAX; len -= UINT8_MAX) {
+		*out++ = UINT8_MAX;
+	}
+	*out++ = len;
+
+	return out;
+}
+
+static uint8_t *lz4_sequence(uint8_t *out, size_t lit, size_t lit_len, size_t match_len,
+			     size_t dist)
+{
+	uint8_t *token = out++;
+
+	*token = MIN(lit_len, 15) << 4;
+	if (lit_len >= 15) {
+		out = lz4_length(out, lit_len - 15);
+	}
+
+	memcpy(out, &image[lit], lit_len);
+	out += lit_len;
+
+	if (match_len > 0) {
+		sys_put_le16(dist, out);
+		out += sizeof(uint16_t);
+
+		*token |= MIN(match_len - LZ4_MIN_MATCH, 15);
+		if (match_len - LZ4_MIN_MATCH >= 15) {
+			out = lz4_length(out, match_len - LZ4_MIN_MATCH - 15);
+		}
+	}
+
+	return out;
+}
+
+static uint8_t *compress(uint8_t *out)
+{
+	for (size_t start = 0; start < IMAGE_SIZE; start += LZ4_BLOCK) {
+		size_t end = MIN(start + LZ4_BLOCK, IMAGE_SIZE);
+		size_t anchor = start;
+		size_t pos = start;
+		uint8_t *block = out + sizeof(uint32_t);
+
+		out = block;
+
+		while (pos + LZ4_MF_LIMIT < end) {
+			size_t dist;
+			size_t len = find_match(pos, LZ4_MIN_MATCH, end - LZ4_LAST_LITERALS - pos,
+						&dist);
+
+			if (len < LZ4_MIN_MATCH) {
+				pos++;
+				continue;
+			}
+
+			out = lz4_sequence(out, anchor, pos - anchor, len, dist);
+			pos += len;
+			anchor = pos;
+		}
+
+		out = lz4_sequence(out, anchor, end - anchor, 0, 0);
+		sys_put_le32(out - block, block - sizeof(uint32_t));
+	}
+
+	sys_put_le32(0, out);
+
+	return out + sizeof(uint32_t);
+}
+#else
+struct bit_writer {
+	uint8_t *out;
+	uint8_t bits;
+	uint8_t count;
+};
+
+static void put_bits(struct bit_writer *w, uint32_t value, uint8_t count)
+{
+	while (count-- > 0) {
+		w->bits = (w->bits << 1) | ((value >> count) & 1);
+		if (++w->count == BITS_PER_BYTE) {
+			*w->out++ = w->bits;
+			w->bits = 0;
+			w->count = 0;
+		}
+	}
+}
+
+static uint8_t *compress(uint8_t *out)
+{
+	struct bit_writer w = { .out = out };
+	/* A match is worth it when shorter than the literals it replaces */
+	size_t min_len = (1 + WINDOW_BITS + LOOKAHEAD_BITS) / 9 + 1;
+	size_t pos = 0;
+
+	while (pos < IMAGE_SIZE) {
+		size_t dist;
+		size_t len = 0;
+
+		if (pos + 3 <= IMAGE_SIZE) {
+			len = find_match(pos, 3, MIN(BIT(LOOKAHEAD_BITS), IMAGE_SIZE - pos), &dist);
+		}
+
+		if (len < min_len) {
+			put_bits(&w, 1, 1);
+			put_bits(&w, image[pos], BITS_PER_BYTE);
+			pos++;
+		} else {
+			put_bits(&w, 0, 1);
+			put_bits(&w, dist - 1, WINDOW_BITS);
+			put_bits(&w, len - 1, LOOKAHEAD_BITS);
+			pos += len;
+		}
+	}
+
+	/* Pad the last byte */
+	put_bits(&w, 0, (BITS_PER_BYTE - w.count) % BITS_PER_BYTE);
+
+	return w.out;
+}
+#endif
+
+/* The hash is left out, the image is compared with what has been written instead */
+static size_t compress_image(void)
+{
+	struct flash_img_compressed_header *hdr = (struct flash_img_compressed_header *)compressed;
+	uint8_t *end;
+
+	memset(hash_table, 0, sizeof(hash_table));
+	memset(hdr, 0, sizeof(*hdr));
+
+	hdr->magic = sys_cpu_to_le32(FLASH_IMG_COMPRESSED_MAGIC);
+	hdr->window_bits = WINDOW_BITS;
+	hdr->size = sys_cpu_to_le32(IMAGE_SIZE);
+#if defined(CONFIG_IMG_DECOMPRESS_LZ4)
+	hdr->format = FLASH_IMG_COMPRESSED_LZ4;
+#else
+	hdr->format = FLASH_IMG_COMPRESSED_HEATSHRINK;
+	hdr->lookahead_bits = LOOKAHEAD_BITS;
+#endif
+
+	end = compress(compressed + sizeof(*hdr));
+
+	return end - compressed;
+}
+
+static int verify(void)
+{
+	const struct flash_area *fa;
+	int ret;
+
+	ret = flash_area_open(PARTITION_ID, &fa);
+	if (ret != 0) {
+		return ret;
+	}
+
+	for (size_t offset = 0; (offset < IMAGE_SIZE) && (ret == 0); offset += CHUNK_SIZE) {
+		size_t len = MIN(CHUNK_SIZE, IMAGE_SIZE - offset);
+
+		ret = flash_area_read(fa, offset, read_back, len);
+		if (ret == 0 && memcmp(&image[offset], read_back, len) != 0) {
+			printk("image differs at 0x%zx\n", offset);
+			ret = -EIO;
+		}
+	}
+
+	flash_area_close(fa);
+
+	return ret;
+}
+
+/* Receives data chunk by chunk and writes it, setting us to the time taken */
+static int download(const uint8_t *data, size_t size, bool decompress, uint32_t *us)
+{
+	timing_t start, finish;
+	int ret;
+
+	ret = flash_img_init_id(&ctx, PARTITION_ID);
+	if (ret == 0) {
+		ret = flash_area_flatten(ctx.flash_area, 0, ctx.flash_area->fa_size);
+	}
+	if (ret != 0) {
+		return ret;
+	}
+
+	start = timing_counter_get();
+
+	for (size_t offset = 0; (offset < size) && (ret == 0); offset += CHUNK_SIZE) {
+		size_t len = MIN(CHUNK_SIZE, size - offset);
+		bool last = offset + len == size;
+
+		k_usleep(CONFIG_BENCHMARK_CHUNK_RECV_US);
+
+		if (decompress) {
+			ret = flash_img_decompress_write(&ctx, &data[offset], len, last);
+		} else {
+			ret = flash_img_buffered_write(&ctx, &data[offset], len, last);
+		}
+	}
+
+	finish = timing_counter_get();
+
+	if (ret == 0) {
+		ret = verify();
+	}
+
+	*us = (uint32_t)(timing_cycles_to_ns(timing_cycles_get(&start, &finish)) /
+			 NSEC_PER_USEC);
+
+	return ret;
+}
+
+static int run(uint8_t random_pct)
+{
+	uint32_t raw_us, compressed_us;
+	size_t size;
+	int ret;
+
+	fill_image(random_pct);
+	size = compress_image();
+
+	ret = download(image, IMAGE_SIZE, false, &raw_us);
+	if (ret != 0) {
+		printk("%u%%: writing the image failed (%d)\n", random_pct, ret);
+		return ret;
+	}
+
+	ret = download(compressed, size, true, &compressed_us);
+	if (ret != 0) {
+		printk("%u%%: writing the compressed image failed (%d)\n", random_pct, ret);
+		return ret;
+	}
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s %u%% - bytes:%u, compressed:%u, raw_us:%u, compressed_us:%u\n", FORMAT,
+	       random_pct, IMAGE_SIZE, (uint32_t)size, raw_us, compressed_us);
+#else
+	printk("%-10s %3u%% random: %6u -> %6u bytes (%3u%%), raw %6u KiB/s, compressed %6u KiB/s\n",
+	       FORMAT, random_pct, IMAGE_SIZE, (uint32_t)size, (uint32_t)(size * 100 / IMAGE_SIZE),
+	       (uint32_t)((uint64_t)IMAGE_SIZE * USEC_PER_SEC / 1024 / raw_us),
+	       (uint32_t)((uint64_t)IMAGE_SIZE * USEC_PER_SEC / 1024 / compressed_us));
+#endif /* CONFIG_BENCHMARK_RECORDING */
+
+	return 0;
+}
+
+int main(void)
+{
+	int ret = 0;
+
+	timing_init();
+	timing_start();
+
+	TC_START("Image download, raw vs. compressed");
+
+	for (int i = 0; (i < ARRAY_SIZE(random_pcts)) && (ret == 0); i++) {
+		ret = run(random_pcts[i]);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(ret == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
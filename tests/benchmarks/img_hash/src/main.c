@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the time to write an image with flash_img_buffered_write() and to
+ * verify its SHA-256 hash afterwards, on a simulated flash. Without
+ * CONFIG_IMG_INCREMENTAL_HASH the image is read back whole by
+ * flash_img_check(), with it the hash computed while writing is checked by
+ * flash_img_hash_check().
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/dfu/flash_img.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/sys/printk.h>
+#include <mbedtls/sha256.h>
+
+#define IMAGE_SIZE   (CONFIG_BENCHMARK_IMAGE_SIZE * 1024)
+#define CHUNK_SIZE   CONFIG_BENCHMARK_CHUNK_SIZE
+#define PARTITION_ID FIXED_PARTITION_ID(slot1_partition)
+
+#if defined(CONFIG_IMG_INCREMENTAL_HASH)
+#define MODE "incremental"
+#else
+#define MODE "read_back"
+#endif
+
+static struct flash_img_context ctx;
+static uint8_t chunk[CHUNK_SIZE];
+static uint8_t sha[32];
+
+static void fill_chunk(size_t offset, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		chunk[i] = (uint8_t)((offset + i) * 31U);
+	}
+}
+
+/* The hash the image is sent with, computed from the data itself */
+static int image_hash(void)
+{
+	mbedtls_sha256_context hash;
+	int ret;
+
+	mbedtls_sha256_init(&hash);
+	ret = mbedtls_sha256_starts(&hash, false);
+
+	for (size_t offset = 0; (offset < IMAGE_SIZE) && (ret == 0); offset += CHUNK_SIZE) {
+		size_t len = MIN(CHUNK_SIZE, IMAGE_SIZE - offset);
+
+		fill_chunk(offset, len);
+		ret = mbedtls_sha256_update(&hash, chunk, len);
+	}
+
+	if (ret == 0) {
+		ret = mbedtls_sha256_finish(&hash, sha);
+	}
+	mbedtls_sha256_free(&hash);
+
+	return ret == 0 ? 0 : -EIO;
+}
+
+static int write_image(void)
+{
+	int ret;
+
+	ret = flash_img_init_id(&ctx, PARTITION_ID);
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = flash_area_flatten(ctx.flash_area, 0, ctx.flash_area->fa_size);
+
+	for (size_t offset = 0; (offset < IMAGE_SIZE) && (ret == 0); offset += CHUNK_SIZE) {
+		size_t len = MIN(CHUNK_SIZE, IMAGE_SIZE - offset);
+
+		fill_chunk(offset, len);
+		ret = flash_img_buffered_write(&ctx, chunk, len, offset + len == IMAGE_SIZE);
+	}
+
+	return ret;
+}
+
+static int verify_image(void)
+{
+	struct flash_img_check fic = {
+		.match = sha,
+		.clen = IMAGE_SIZE,
+	};
+
+#if defined(CONFIG_IMG_INCREMENTAL_HASH)
+	return flash_img_hash_check(&ctx, &fic);
+#else
+	return flash_img_check(&ctx, &fic, PARTITION_ID);
+#endif
+}
+
+int main(void)
+{
+	timing_t start, written, verified;
+	uint32_t write_us, verify_us;
+	int ret;
+
+	timing_init();
+	timing_start();
+
+	TC_START("Image hash verification, " MODE);
+
+	ret = image_hash();
+
+	start = timing_counter_get();
+	if (ret == 0) {
+		ret = write_image();
+	}
+	written = timing_counter_get();
+	if (ret == 0) {
+		ret = verify_image();
+	}
+	verified = timing_counter_get();
+
+	timing_stop();
+
+	if (ret != 0) {
+		printk("%s failed (%d)\n", MODE, ret);
+	} else {
+		write_us = (uint32_t)(timing_cycles_to_ns(timing_cycles_get(&start, &written)) /
+				      NSEC_PER_USEC);
+		verify_us = (uint32_t)(timing_cycles_to_ns(timing_cycles_get(&written, &verified)) /
+				       NSEC_PER_USEC);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+		printk("REC: %s - bytes:%u, write_us:%u, verify_us:%u\n", MODE, IMAGE_SIZE,
+		       write_us, verify_us);
+#else
+		printk("%-11s: %6u bytes written in %9u us, verified in %9u us\n", MODE,
+		       IMAGE_SIZE, write_us, verify_us);
+#endif /* CONFIG_BENCHMARK_RECORDING */
+	}
+
+	TC_END_REPORT(ret == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
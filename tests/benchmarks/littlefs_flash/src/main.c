@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure sequential and random read and write throughput of littlefs on a
+ * simulated flash, with flash accessed directly and through the read-ahead
+ * cache and program buffer of the littlefs flash glue.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/littlefs.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/sys/printk.h>
+#include <string.h>
+
+#define MNT_POINT    "/lfs"
+#define FILE_PATH    MNT_POINT "/data"
+#define FILE_SIZE    (CONFIG_BENCHMARK_FILE_SIZE * 1024)
+#define CHUNK_SIZE   CONFIG_BENCHMARK_CHUNK_SIZE
+#define NUM_CHUNKS   (FILE_SIZE / CHUNK_SIZE)
+#define PARTITION_ID FIXED_PARTITION_ID(storage_partition)
+
+BUILD_ASSERT((FILE_SIZE % CHUNK_SIZE) == 0);
+
+FS_LITTLEFS_DECLARE_CACHED_CONFIG(direct, 4, CONFIG_FS_LITTLEFS_READ_SIZE,
+				  CONFIG_FS_LITTLEFS_PROG_SIZE, CONFIG_FS_LITTLEFS_CACHE_SIZE,
+				  CONFIG_FS_LITTLEFS_LOOKAHEAD_SIZE, 0, 0);
+
+FS_LITTLEFS_DECLARE_CACHED_CONFIG(cached, 4, CONFIG_FS_LITTLEFS_READ_SIZE,
+				  CONFIG_FS_LITTLEFS_PROG_SIZE, CONFIG_FS_LITTLEFS_CACHE_SIZE,
+				  CONFIG_FS_LITTLEFS_LOOKAHEAD_SIZE,
+				  CONFIG_BENCHMARK_READ_CACHE_SIZE,
+				  CONFIG_BENCHMARK_PROG_BUFFER_SIZE);
+
+static struct fs_mount_t mnt = {
+	.type = FS_LITTLEFS,
+	.storage_dev = (void *)PARTITION_ID,
+	.mnt_point = MNT_POINT,
+};
+
+static uint8_t chunk[CHUNK_SIZE];
+static uint8_t read_back[CHUNK_SIZE];
+
+/* Offsets only need to vary, xorshift is plenty */
+static size_t random_chunk(void)
+{
+	static uint32_t state = 0x12345678U;
+
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+
+	return (state % NUM_CHUNKS) * CHUNK_SIZE;
+}
+
+static void fill_chunk(size_t offset)
+{
+	for (size_t i = 0; i < CHUNK_SIZE; i++) {
+		chunk[i] = (uint8_t)((offset + i) * 31U);
+	}
+}
+
+static int check_chunk(size_t offset)
+{
+	fill_chunk(offset);
+
+	if (memcmp(chunk, read_back, CHUNK_SIZE) != 0) {
+		printk("file differs at 0x%zx\n", offset);
+		return -EIO;
+	}
+
+	return 0;
+}
+
+static int seq_write(struct fs_file_t *file)
+{
+	ssize_t len;
+
+	for (size_t offset = 0; offset < FILE_SIZE; offset += CHUNK_SIZE) {
+		fill_chunk(offset);
+
+		len = fs_write(file, chunk, CHUNK_SIZE);
+		if (len != CHUNK_SIZE) {
+			return len < 0 ? len : -ENOSPC;
+		}
+	}
+
+	return fs_sync(file);
+}
+
+static int seq_read(struct fs_file_t *file)
+{
+	ssize_t len;
+	int ret;
+
+	ret = fs_seek(file, 0, FS_SEEK_SET);
+
+	for (size_t offset = 0; (offset < FILE_SIZE) && (ret == 0); offset += CHUNK_SIZE) {
+		len = fs_read(file, read_back, CHUNK_SIZE);
+		if (len != CHUNK_SIZE) {
+			return len < 0 ? len : -EIO;
+		}
+
+		ret = check_chunk(offset);
+	}
+
+	return ret;
+}
+
+static int rand_read(struct fs_file_t *file)
+{
+	ssize_t len;
+	int ret = 0;
+
+	for (int i = 0; (i < CONFIG_BENCHMARK_RANDOM_READS) && (ret == 0); i++) {
+		size_t offset = random_chunk();
+
+		ret = fs_seek(file, offset, FS_SEEK_SET);
+		if (ret != 0) {
+			break;
+		}
+
+		len = fs_read(file, read_back, CHUNK_SIZE);
+		if (len != CHUNK_SIZE) {
+			return len < 0 ? len : -EIO;
+		}
+
+		ret = check_chunk(offset);
+	}
+
+	return ret;
+}
+
+/* Rewrites chunks with the same data, so that the file can still be checked */
+static int rand_write(struct fs_file_t *file)
+{
+	ssize_t len;
+	int ret = 0;
+
+	for (int i = 0; (i < CONFIG_BENCHMARK_RANDOM_WRITES) && (ret == 0); i++) {
+		size_t offset = random_chunk();
+
+		ret = fs_seek(file, offset, FS_SEEK_SET);
+		if (ret != 0) {
+			break;
+		}
+
+		fill_chunk(offset);
+
+		len = fs_write(file, chunk, CHUNK_SIZE);
+		if (len != CHUNK_SIZE) {
+			return len < 0 ? len : -ENOSPC;
+		}
+	}
+
+	return ret == 0 ? fs_sync(file) : ret;
+}
+
+static int measure(const char *mode, const char *op, uint32_t bytes,
+		   int (*test)(struct fs_file_t *file), struct fs_file_t *file)
+{
+	timing_t start, finish;
+	uint64_t ns;
+	int ret;
+
+	start = timing_counter_get();
+	ret = test(file);
+	finish = timing_counter_get();
+
+	if (ret != 0) {
+		printk("%s %s failed (%d)\n", mode, op, ret);
+		return ret;
+	}
+
+	ns = timing_cycles_to_ns(timing_cycles_get(&start, &finish));
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s %s - bytes:%u, us:%u, KiB/s:%u\n", mode, op, bytes,
+	       (uint32_t)(ns / NSEC_PER_USEC),
+	       (uint32_t)((uint64_t)bytes * NSEC_PER_SEC / 1024 / ns));
+#else
+	printk("%-6s %-10s: %6u bytes in %9u us, %6u KiB/s\n", mode, op, bytes,
+	       (uint32_t)(ns / NSEC_PER_USEC),
+	       (uint32_t)((uint64_t)bytes * NSEC_PER_SEC / 1024 / ns));
+#endif /* CONFIG_BENCHMARK_RECORDING */
+
+	return 0;
+}
+
+static int wipe(void)
+{
+	const struct flash_area *fa;
+	int ret;
+
+	ret = flash_area_open(PARTITION_ID, &fa);
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = flash_area_flatten(fa, 0, fa->fa_size);
+	flash_area_close(fa);
+
+	return ret;
+}
+
+static int run(const char *mode, struct fs_littlefs *fs)
+{
+	struct fs_file_t file;
+	int ret;
+
+	ret = wipe();
+	if (ret != 0) {
+		printk("%s: wiping the partition failed (%d)\n", mode, ret);
+		return ret;
+	}
+
+	mnt.fs_data = fs;
+	ret = fs_mount(&mnt);
+	if (ret != 0) {
+		printk("%s: mounting failed (%d)\n", mode, ret);
+		return ret;
+	}
+
+	fs_file_t_init(&file);
+	ret = fs_open(&file, FILE_PATH, FS_O_CREATE | FS_O_RDWR);
+	if (ret != 0) {
+		printk("%s: opening the file failed (%d)\n", mode, ret);
+		goto out;
+	}
+
+	ret = measure(mode, "seq_write", FILE_SIZE, seq_write, &file);
+	if (ret == 0) {
+		ret = measure(mode, "seq_read", FILE_SIZE, seq_read, &file);
+	}
+	if (ret == 0) {
+		ret = measure(mode, "rand_read", CONFIG_BENCHMARK_RANDOM_READS * CHUNK_SIZE,
+			      rand_read, &file);
+	}
+	if (ret == 0) {
+		ret = measure(mode, "rand_write", CONFIG_BENCHMARK_RANDOM_WRITES * CHUNK_SIZE,
+			      rand_write, &file);
+	}
+	if (ret == 0) {
+		/* Everything written must read back from flash */
+		ret = seq_read(&file);
+	}
+
+	fs_close(&file);
+out:
+	fs_unmount(&mnt);
+
+	return ret;
+}
+
+int main(void)
+{
+	int ret;
+
+	timing_init();
+	timing_start();
+
+	TC_START("LittleFS on flash, direct vs. cached");
+
+	ret = run("direct", &direct);
+	if (ret == 0) {
+		ret = run("cached", &cached);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(ret == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the messages and the time it takes to notify a server about
+ * observed values which all change in each update interval, with one
+ * notification for each observation against the changes coalesced in SenML
+ * CBOR Send operations.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/net/lwm2m.h>
+#include <string.h>
+
+#include "lwm2m_engine.h"
+#include "lwm2m_object.h"
+
+#define ITERATIONS CONFIG_BENCHMARK_ITERATIONS
+#define OBSERVERS  CONFIG_BENCHMARK_OBSERVERS
+
+BUILD_ASSERT(OBSERVERS <= CONFIG_LWM2M_ENGINE_MAX_OBSERVER,
+	     "Each instance needs an observer");
+
+#define BENCH_OBJ_ID 32769
+#define VALUE_RID    0
+
+struct interval_stats {
+	uint32_t messages;
+	uint32_t bytes;
+};
+
+static struct lwm2m_engine_obj bench_obj;
+static struct lwm2m_engine_obj_field fields[] = {
+	OBJ_FIELD_DATA(VALUE_RID, R, S32),
+};
+
+static struct lwm2m_engine_obj_inst inst[OBSERVERS];
+static struct lwm2m_engine_res res[OBSERVERS];
+static struct lwm2m_engine_res_inst res_inst[OBSERVERS];
+static int32_t values[OBSERVERS];
+
+static struct lwm2m_ctx ctx;
+static struct lwm2m_message msg;
+
+static struct lwm2m_engine_obj_inst *bench_obj_create(uint16_t obj_inst_id)
+{
+	int i = 0, j = 0;
+
+	if (obj_inst_id >= OBSERVERS || inst[obj_inst_id].obj) {
+		return NULL;
+	}
+
+	(void)memset(&res[obj_inst_id], 0, sizeof(res[obj_inst_id]));
+	init_res_instance(&res_inst[obj_inst_id], 1);
+
+	INIT_OBJ_RES_DATA(VALUE_RID, &res[obj_inst_id], i, &res_inst[obj_inst_id], j,
+			  &values[obj_inst_id], sizeof(int32_t));
+
+	inst[obj_inst_id].resources = &res[obj_inst_id];
+	inst[obj_inst_id].resource_count = i;
+
+	return &inst[obj_inst_id];
+}
+
+static void bench_obj_register(void)
+{
+	bench_obj.obj_id = BENCH_OBJ_ID;
+	bench_obj.version_major = 1;
+	bench_obj.version_minor = 0;
+	bench_obj.fields = fields;
+	bench_obj.field_count = ARRAY_SIZE(fields);
+	bench_obj.max_instance_count = OBSERVERS;
+	bench_obj.create_cb = bench_obj_create;
+	lwm2m_register_obj(&bench_obj);
+}
+
+/* What the engine does when a server observes the value of an instance */
+static int observe(uint16_t obj_inst_id)
+{
+	uint8_t token[sizeof(obj_inst_id)];
+	int ret;
+
+	memcpy(token, &obj_inst_id, sizeof(token));
+
+	ret = coap_packet_init(&msg.cpkt, msg.msg_data, sizeof(msg.msg_data), COAP_VERSION_1,
+			       COAP_TYPE_ACK, sizeof(token), token, COAP_RESPONSE_CODE_CONTENT,
+			       obj_inst_id);
+	if (ret < 0) {
+		return ret;
+	}
+
+	msg.ctx = &ctx;
+	msg.path = LWM2M_OBJ(BENCH_OBJ_ID, obj_inst_id, VALUE_RID);
+	msg.out.out_cpkt = &msg.cpkt;
+	msg.token = token;
+	msg.tkl = sizeof(token);
+
+	return lwm2m_engine_observation_handler(&msg, 0, LWM2M_FORMAT_PLAIN_TEXT, false);
+}
+
+static int populate(void)
+{
+	int ret;
+
+	for (int i = 0; i < OBSERVERS; i++) {
+		ret = lwm2m_create_object_inst(&LWM2M_OBJ(BENCH_OBJ_ID, i));
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = observe(i);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+/* What the engine does with an observation once it is notified */
+static void notified(struct observe_node *obs, int64_t timestamp)
+{
+	obs->event_timestamp = engine_observe_shedule_next_event(obs, ctx.srv_obj_inst, timestamp);
+	obs->last_timestamp = timestamp;
+	obs->resource_update = false;
+}
+
+/* Messages are sent and acknowledged at once */
+static void transmit(struct interval_stats *stats)
+{
+	struct lwm2m_message *m;
+	struct observe_node *obs;
+	sys_snode_t *node;
+
+	while ((node = sys_slist_get(&ctx.pending_sends)) != NULL) {
+		m = CONTAINER_OF(node, struct lwm2m_message, node);
+		stats->messages++;
+		stats->bytes += m->cpkt.offset;
+		lwm2m_reset_message(m, true);
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx.observer, obs, node) {
+		obs->active_notify = NULL;
+	}
+}
+
+static int change_all(int round)
+{
+	int ret;
+
+	for (int i = 0; i < OBSERVERS; i++) {
+		ret = lwm2m_set_s32(&LWM2M_OBJ(BENCH_OBJ_ID, i, VALUE_RID), round + i);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static int notify_each(struct interval_stats *stats)
+{
+	int64_t timestamp = k_uptime_get();
+	struct observe_node *obs;
+	int ret;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx.observer, obs, node) {
+		if (!obs->resource_update) {
+			continue;
+		}
+
+		ret = generate_notify_message(&ctx, obs, NULL);
+		if (ret < 0) {
+			return ret;
+		}
+
+		notified(obs, timestamp);
+		transmit(stats);
+	}
+
+	return 0;
+}
+
+static int notify_coalesced(struct interval_stats *stats)
+{
+	struct observe_node *batch[OBSERVERS];
+	int64_t timestamp = k_uptime_get();
+	struct observe_node *obs;
+	int count = 0;
+	int sent;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx.observer, obs, node) {
+		if (obs->resource_update && count < ARRAY_SIZE(batch)) {
+			batch[count++] = obs;
+		}
+	}
+
+	for (int i = 0; i < count; i += sent) {
+		sent = generate_coalesced_notify_message(&ctx, &batch[i], count - i);
+		if (sent <= 0) {
+			return sent < 0 ? sent : -EIO;
+		}
+
+		for (int j = i; j < i + sent; j++) {
+			notified(batch[j], timestamp);
+		}
+
+		transmit(stats);
+	}
+
+	return 0;
+}
+
+static int measure(int (*notify)(struct interval_stats *stats), uint64_t *ns,
+		   struct interval_stats *stats)
+{
+	timing_t start, finish;
+	int ret = 0;
+
+	*stats = (struct interval_stats){ 0 };
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < ITERATIONS && ret == 0; i++) {
+		ret = change_all(i);
+		if (ret == 0) {
+			lwm2m_registry_lock();
+			ret = notify(stats);
+			lwm2m_registry_unlock();
+		}
+	}
+
+	finish = timing_counter_get();
+
+	*ns = timing_cycles_to_ns(timing_cycles_get(&start, &finish)) / ITERATIONS;
+	stats->messages /= ITERATIONS;
+	stats->bytes /= ITERATIONS;
+
+	return ret;
+}
+
+static void report(const char *method, uint64_t ns, const struct interval_stats *stats)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s/%d - ns:%u, msgs:%u, bytes:%u\n", method, OBSERVERS, (uint32_t)ns,
+	       stats->messages, stats->bytes);
+#else
+	printk("%-8s %3d changes: %8u ns, %3u messages, %5u bytes per interval\n", method,
+	       OBSERVERS, (uint32_t)ns, stats->messages, stats->bytes);
+#endif /* CONFIG_BENCHMARK_RECORDING */
+}
+
+static int run(void)
+{
+	struct interval_stats stats;
+	uint64_t ns;
+	int ret;
+
+	lwm2m_engine_context_init(&ctx);
+	bench_obj_register();
+
+	ret = populate();
+	if (ret < 0) {
+		printk("Cannot create %d instances and observers (%d)\n", OBSERVERS, ret);
+		return ret;
+	}
+
+	ret = measure(notify_each, &ns, &stats);
+	if (ret < 0) {
+		printk("notify: cannot build the notifications (%d)\n", ret);
+		return ret;
+	}
+
+	report("notify", ns, &stats);
+
+	ret = measure(notify_coalesced, &ns, &stats);
+	if (ret < 0) {
+		printk("coalesce: cannot build the messages (%d)\n", ret);
+		return ret;
+	}
+
+	report("coalesce", ns, &stats);
+
+	return 0;
+}
+
+int main(void)
+{
+	int ret;
+
+	timing_init();
+	timing_start();
+
+	TC_START("LwM2M notification coalescing");
+
+	ret = run();
+
+	timing_stop();
+
+	TC_END_REPORT(ret == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure how long it takes to read a resource of the LwM2M registry and to
+ * find the observers of a changed resource, as the count of object instances
+ * and of observers grows.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/net/lwm2m.h>
+#include <string.h>
+
+#include "lwm2m_engine.h"
+#include "lwm2m_object.h"
+
+#define ITERATIONS    CONFIG_BENCHMARK_ITERATIONS
+#define MAX_INSTANCES CONFIG_BENCHMARK_MAX_INSTANCES
+#define MIN_INSTANCES 8
+
+BUILD_ASSERT(MAX_INSTANCES <= CONFIG_LWM2M_ENGINE_MAX_OBSERVER,
+	     "Each instance needs an observer");
+
+#define BENCH_OBJ_ID 32769
+
+#define VALUE_RID      0
+#define MIN_VALUE_RID  1
+#define MAX_VALUE_RID  2
+#define RESOURCE_COUNT 3
+
+static struct lwm2m_engine_obj bench_obj;
+static struct lwm2m_engine_obj_field fields[] = {
+	OBJ_FIELD_DATA(VALUE_RID, R, S32),
+	OBJ_FIELD_DATA(MIN_VALUE_RID, R, S32),
+	OBJ_FIELD_DATA(MAX_VALUE_RID, R, S32),
+};
+
+static struct lwm2m_engine_obj_inst inst[MAX_INSTANCES];
+static struct lwm2m_engine_res res[MAX_INSTANCES][RESOURCE_COUNT];
+static struct lwm2m_engine_res_inst res_inst[MAX_INSTANCES][RESOURCE_COUNT];
+static int32_t values[MAX_INSTANCES][RESOURCE_COUNT];
+
+static struct lwm2m_ctx ctx;
+static struct lwm2m_message msg;
+static volatile int32_t sink;
+
+static struct lwm2m_engine_obj_inst *bench_obj_create(uint16_t obj_inst_id)
+{
+	int i = 0, j = 0;
+
+	if (obj_inst_id >= MAX_INSTANCES || inst[obj_inst_id].obj) {
+		return NULL;
+	}
+
+	(void)memset(res[obj_inst_id], 0, sizeof(res[obj_inst_id]));
+	init_res_instance(res_inst[obj_inst_id], ARRAY_SIZE(res_inst[obj_inst_id]));
+
+	for (int rid = 0; rid < RESOURCE_COUNT; rid++) {
+		INIT_OBJ_RES_DATA(rid, res[obj_inst_id], i, res_inst[obj_inst_id], j,
+				  &values[obj_inst_id][rid], sizeof(int32_t));
+	}
+
+	inst[obj_inst_id].resources = res[obj_inst_id];
+	inst[obj_inst_id].resource_count = i;
+
+	return &inst[obj_inst_id];
+}
+
+static void bench_obj_register(void)
+{
+	bench_obj.obj_id = BENCH_OBJ_ID;
+	bench_obj.version_major = 1;
+	bench_obj.version_minor = 0;
+	bench_obj.fields = fields;
+	bench_obj.field_count = ARRAY_SIZE(fields);
+	bench_obj.max_instance_count = MAX_INSTANCES;
+	bench_obj.create_cb = bench_obj_create;
+	lwm2m_register_obj(&bench_obj);
+}
+
+/* What the engine does when a server observes the value of an instance */
+static int observe(uint16_t obj_inst_id)
+{
+	uint8_t token[sizeof(obj_inst_id)];
+	int ret;
+
+	memcpy(token, &obj_inst_id, sizeof(token));
+
+	ret = coap_packet_init(&msg.cpkt, msg.msg_data, sizeof(msg.msg_data), COAP_VERSION_1,
+			       COAP_TYPE_ACK, sizeof(token), token, COAP_RESPONSE_CODE_CONTENT,
+			       obj_inst_id);
+	if (ret < 0) {
+		return ret;
+	}
+
+	msg.ctx = &ctx;
+	msg.path = LWM2M_OBJ(BENCH_OBJ_ID, obj_inst_id, VALUE_RID);
+	msg.out.out_cpkt = &msg.cpkt;
+	msg.token = token;
+	msg.tkl = sizeof(token);
+
+	return lwm2m_engine_observation_handler(&msg, 0, LWM2M_FORMAT_PLAIN_TEXT, false);
+}
+
+/* Instances and their observers up to @p count */
+static int populate(int from, int count)
+{
+	int ret;
+
+	for (int i = from; i < count; i++) {
+		ret = lwm2m_create_object_inst(&LWM2M_OBJ(BENCH_OBJ_ID, i));
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = observe(i);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static int measure_lookup(int count, uint64_t *ns)
+{
+	timing_t start, finish;
+	int32_t value, sum = 0;
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		if (lwm2m_get_s32(&LWM2M_OBJ(BENCH_OBJ_ID, i % count, i % RESOURCE_COUNT),
+				  &value) < 0) {
+			return -EIO;
+		}
+
+		sum += value;
+	}
+
+	finish = timing_counter_get();
+	sink = sum;
+
+	*ns = timing_cycles_to_ns(timing_cycles_get(&start, &finish)) / ITERATIONS;
+
+	return 0;
+}
+
+static int measure_notify(int count, uint64_t *ns)
+{
+	timing_t start, finish;
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		/* One observer for each instance */
+		if (lwm2m_notify_observer(BENCH_OBJ_ID, i % count, VALUE_RID) != 1) {
+			return -EIO;
+		}
+	}
+
+	finish = timing_counter_get();
+
+	*ns = timing_cycles_to_ns(timing_cycles_get(&start, &finish)) / ITERATIONS;
+
+	return 0;
+}
+
+static void report(const char *method, int count, uint64_t ns)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s/%d - ns:%u\n", method, count, (uint32_t)ns);
+#else
+	printk("%-6s %4d instances and observers: %6u ns\n", method, count, (uint32_t)ns);
+#endif /* CONFIG_BENCHMARK_RECORDING */
+}
+
+static int run(void)
+{
+	uint64_t ns;
+	int count = 0;
+	int ret;
+
+	lwm2m_engine_context_init(&ctx);
+	bench_obj_register();
+
+	for (int next = MIN_INSTANCES; count < MAX_INSTANCES; next *= 2) {
+		next = MIN(next, MAX_INSTANCES);
+
+		ret = populate(count, next);
+		if (ret < 0) {
+			printk("Cannot create %d instances and observers (%d)\n", next, ret);
+			return ret;
+		}
+
+		count = next;
+
+		ret = measure_lookup(count, &ns);
+		if (ret < 0) {
+			printk("%d instances: lookup failed\n", count);
+			return ret;
+		}
+
+		report("lookup", count, ns);
+
+		ret = measure_notify(count, &ns);
+		if (ret < 0) {
+			printk("%d instances: observer not found\n", count);
+			return ret;
+		}
+
+		report("notify", count, ns);
+	}
+
+	return 0;
+}
+
+int main(void)
+{
+	int ret;
+
+	timing_init();
+	timing_start();
+
+	TC_START("LwM2M registry lookup");
+
+	ret = run();
+
+	timing_stop();
+
+	TC_END_REPORT(ret == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
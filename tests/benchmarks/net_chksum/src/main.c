@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the copy of a payload into a network buffer followed by the
+ * computation of its checksum, against the checksum computed while the
+ * payload is copied.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/sys/printk.h>
+#include <string.h>
+
+#include "net_private.h"
+
+#define MAX_SIZE   1460
+#define ITERATIONS CONFIG_BENCHMARK_ITERATIONS
+
+static const size_t sizes[] = { 64, 256, 576, 1024, MAX_SIZE };
+
+/* The payload of a packet usually follows headers whose length is not a
+ * multiple of 4, as it would in a network buffer.
+ */
+static const struct {
+	const char *name;
+	size_t offset;
+} alignments[] = {
+	{ "aligned", 0 },
+	{ "unaligned", 2 },
+};
+
+static uint8_t src[MAX_SIZE] __aligned(8);
+static uint8_t dst[MAX_SIZE + 8] __aligned(8);
+static volatile uint16_t sink;
+
+static uint16_t separate(uint8_t *to, const uint8_t *from, size_t len)
+{
+	memcpy(to, from, len);
+
+	return calc_chksum(0, to, len);
+}
+
+static uint16_t fused(uint8_t *to, const uint8_t *from, size_t len)
+{
+	return calc_chksum_copy(0, to, from, len);
+}
+
+static uint64_t measure(uint16_t (*copy)(uint8_t *to, const uint8_t *from, size_t len),
+			uint8_t *to, size_t len)
+{
+	timing_t start, finish;
+	uint16_t sum = 0;
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		sum ^= copy(to, src, len);
+	}
+
+	finish = timing_counter_get();
+	sink = sum;
+
+	return timing_cycles_to_ns(timing_cycles_get(&start, &finish)) / ITERATIONS;
+}
+
+static void report(const char *method, size_t len, const char *align, uint64_t ns)
+{
+	uint32_t mib_per_sec = ns == 0 ? 0 :
+		(uint32_t)((uint64_t)len * NSEC_PER_SEC / ns / (1024 * 1024));
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s/%zu/%s - ns:%u, MiB/s:%u\n", method, len, align, (uint32_t)ns,
+	       mib_per_sec);
+#else
+	printk("%-8s %5zu bytes %-9s: %6u ns, %5u MiB/s\n", method, len, align, (uint32_t)ns,
+	       mib_per_sec);
+#endif /* CONFIG_BENCHMARK_RECORDING */
+}
+
+static int run(void)
+{
+	for (size_t i = 0; i < sizeof(src); i++) {
+		src[i] = (uint8_t)(i * 131U + 7U);
+	}
+
+	for (size_t a = 0; a < ARRAY_SIZE(alignments); a++) {
+		uint8_t *to = dst + alignments[a].offset;
+
+		for (size_t s = 0; s < ARRAY_SIZE(sizes); s++) {
+			size_t len = sizes[s];
+			uint16_t sum = separate(to, src, len);
+
+			if (fused(to, src, len) != sum || memcmp(to, src, len) != 0) {
+				printk("%zu bytes %s: fused copy differs\n", len,
+				       alignments[a].name);
+				return -EIO;
+			}
+
+			report("separate", len, alignments[a].name,
+			       measure(separate, to, len));
+			report("fused", len, alignments[a].name,
+			       measure(fused, to, len));
+		}
+	}
+
+	return 0;
+}
+
+int main(void)
+{
+	int ret;
+
+	timing_init();
+	timing_start();
+
+	TC_START("Checksum computed while copying");
+
+	ret = run();
+
+	timing_stop();
+
+	TC_END_REPORT(ret == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
@@ -0,0 +1,366 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the rate of frames received one at a time by an Ethernet driver,
+ * against frames received in batches from the Ethernet RX poll work queue,
+ * copied or not out of the buffers of the driver.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/socket.h>
+#include <string.h>
+
+#define BURST      CONFIG_BENCHMARK_BURST
+#define ITERATIONS CONFIG_BENCHMARK_ITERATIONS
+
+#define PAYLOAD_LEN 64
+#define LOCAL_PORT  4242
+#define REMOTE_PORT 4243
+
+struct rx_frame {
+	struct net_eth_hdr eth;
+	struct net_ipv4_hdr ipv4;
+	struct net_udp_hdr udp;
+	uint8_t payload[PAYLOAD_LEN];
+} __packed;
+
+struct fake_eth_context {
+	struct net_if *iface;
+	uint8_t mac_addr[6];
+	struct net_eth_napi napi;
+	/* Frames waiting in the simulated ring */
+	atomic_t pending;
+	/* Hand the buffers of the ring over instead of copying them */
+	bool zero_copy;
+	/* Buffers of the simulated ring, holding a received frame */
+	void *ring[BURST];
+	int ring_next;
+};
+
+static struct fake_eth_context fake_eth_context = {
+	.mac_addr = { 0x02, 0x00, 0x5e, 0x00, 0x53, 0x01 },
+};
+
+static const struct in_addr local_addr = { { { 192, 0, 2, 1 } } };
+static const struct in_addr remote_addr = { { { 192, 0, 2, 2 } } };
+
+static struct rx_frame frame;
+
+/* Frames of a burst wait in the socket while the ring is full again */
+NET_ETH_RX_POOL_DEFINE(fake_rx_pool, 2 * BURST, sizeof(struct rx_frame), 4);
+
+static void build_frame(void)
+{
+	static const uint8_t remote_mac[] = { 0x02, 0x00, 0x5e, 0x00, 0x53, 0x02 };
+
+	memcpy(frame.eth.dst.addr, fake_eth_context.mac_addr, sizeof(frame.eth.dst.addr));
+	memcpy(frame.eth.src.addr, remote_mac, sizeof(frame.eth.src.addr));
+	frame.eth.type = htons(NET_ETH_PTYPE_IP);
+
+	frame.ipv4.vhl = 0x45;
+	frame.ipv4.ttl = 64;
+	frame.ipv4.proto = IPPROTO_UDP;
+	sys_put_be16(sizeof(frame) - sizeof(frame.eth), frame.ipv4.len);
+	memcpy(frame.ipv4.src, &remote_addr, sizeof(frame.ipv4.src));
+	memcpy(frame.ipv4.dst, &local_addr, sizeof(frame.ipv4.dst));
+
+	frame.udp.src_port = htons(REMOTE_PORT);
+	frame.udp.dst_port = htons(LOCAL_PORT);
+	frame.udp.len = htons(sizeof(frame.udp) + sizeof(frame.payload));
+
+	for (size_t i = 0; i < sizeof(frame.payload); i++) {
+		frame.payload[i] = (uint8_t)i;
+	}
+}
+
+/* The device would write the frames in the buffers, they are all the same.
+ * The ring takes the first buffers, the others stay in the pool.
+ */
+static void fill_ring(struct fake_eth_context *ctx)
+{
+	void *bufs[2 * BURST];
+	int count = 0;
+
+	net_eth_rx_pool_init(&fake_rx_pool);
+
+	while (count < ARRAY_SIZE(bufs) &&
+	       (bufs[count] = net_eth_rx_pool_get(&fake_rx_pool)) != NULL) {
+		memcpy(bufs[count++], &frame, sizeof(frame));
+	}
+
+	for (int i = 0; i < count; i++) {
+		if (i < BURST) {
+			ctx->ring[i] = bufs[i];
+		} else {
+			net_eth_rx_pool_put(&fake_rx_pool, bufs[i]);
+		}
+	}
+
+	ctx->ring_next = 0;
+}
+
+/* What a driver does with a frame of its ring */
+static struct net_pkt *fake_eth_rx(struct fake_eth_context *ctx)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(ctx->iface, sizeof(frame), AF_UNSPEC, 0,
+					   K_NO_WAIT);
+	if (!pkt) {
+		return NULL;
+	}
+
+	if (net_pkt_write(pkt, &frame, sizeof(frame))) {
+		net_pkt_unref(pkt);
+		return NULL;
+	}
+
+	return pkt;
+}
+
+/* What a driver does with a frame of its ring when it can replace the buffer */
+static struct net_pkt *fake_eth_rx_zero_copy(struct fake_eth_context *ctx)
+{
+	void *buf = ctx->ring[ctx->ring_next];
+	void *new_buf = net_eth_rx_pool_get(&fake_rx_pool);
+	struct net_pkt *pkt;
+
+	if (!new_buf) {
+		return fake_eth_rx(ctx);
+	}
+
+	pkt = net_eth_rx_pool_wrap(&fake_rx_pool, ctx->iface, buf, sizeof(frame),
+				   K_NO_WAIT);
+	if (!pkt) {
+		net_eth_rx_pool_put(&fake_rx_pool, new_buf);
+		return NULL;
+	}
+
+	ctx->ring[ctx->ring_next] = new_buf;
+	ctx->ring_next = (ctx->ring_next + 1) % BURST;
+
+	return pkt;
+}
+
+static int fake_eth_poll(struct net_eth_napi *napi, int budget)
+{
+	struct fake_eth_context *ctx = CONTAINER_OF(napi, struct fake_eth_context, napi);
+	int count = 0;
+
+	while (count < budget && atomic_get(&ctx->pending) > 0) {
+		struct net_pkt *pkt = ctx->zero_copy ? fake_eth_rx_zero_copy(ctx) :
+						       fake_eth_rx(ctx);
+
+		atomic_dec(&ctx->pending);
+		count++;
+
+		if (pkt) {
+			(void)net_eth_napi_receive(napi, pkt);
+		}
+	}
+
+	return count;
+}
+
+static void fake_eth_iface_init(struct net_if *iface)
+{
+	const struct device *dev = net_if_get_device(iface);
+	struct fake_eth_context *ctx = dev->data;
+
+	ctx->iface = iface;
+
+	net_if_set_link_addr(iface, ctx->mac_addr, sizeof(ctx->mac_addr),
+			     NET_LINK_ETHERNET);
+
+	net_eth_napi_init(&ctx->napi, iface, fake_eth_poll);
+
+	ethernet_init(iface);
+}
+
+static enum ethernet_hw_caps fake_eth_caps(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return ETHERNET_HW_RX_CHKSUM_OFFLOAD;
+}
+
+static int fake_eth_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static const struct ethernet_api fake_eth_api = {
+	.iface_api.init = fake_eth_iface_init,
+	.get_capabilities = fake_eth_caps,
+	.send = fake_eth_send,
+};
+
+ETH_NET_DEVICE_INIT(fake_eth, "fake_eth", NULL, NULL, &fake_eth_context, NULL,
+		    CONFIG_ETH_INIT_PRIORITY, &fake_eth_api, NET_ETH_MTU);
+
+static void per_frame(struct fake_eth_context *ctx)
+{
+	for (int i = 0; i < BURST; i++) {
+		struct net_pkt *pkt = fake_eth_rx(ctx);
+
+		if (pkt && net_recv_data(ctx->iface, pkt) < 0) {
+			net_pkt_unref(pkt);
+		}
+	}
+}
+
+static void napi(struct fake_eth_context *ctx)
+{
+	ctx->zero_copy = false;
+	atomic_set(&ctx->pending, BURST);
+	net_eth_napi_schedule(&ctx->napi);
+}
+
+static void napi_zero_copy(struct fake_eth_context *ctx)
+{
+	ctx->zero_copy = true;
+	atomic_set(&ctx->pending, BURST);
+	net_eth_napi_schedule(&ctx->napi);
+}
+
+static int drain(int sock)
+{
+	uint8_t buf[PAYLOAD_LEN];
+
+	for (int i = 0; i < BURST; i++) {
+		if (zsock_recv(sock, buf, sizeof(buf), 0) != sizeof(buf)) {
+			return -EIO;
+		}
+	}
+
+	return 0;
+}
+
+static int measure(void (*receive)(struct fake_eth_context *ctx), int sock,
+		   uint64_t *ns)
+{
+	timing_t start, finish;
+	int ret = 0;
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < ITERATIONS && ret == 0; i++) {
+		receive(&fake_eth_context);
+		ret = drain(sock);
+	}
+
+	finish = timing_counter_get();
+
+	*ns = timing_cycles_to_ns(timing_cycles_get(&start, &finish)) /
+	      ((uint64_t)ITERATIONS * BURST);
+
+	return ret;
+}
+
+static void report(const char *method, uint64_t ns)
+{
+	uint32_t pps = ns == 0 ? 0 : (uint32_t)(NSEC_PER_SEC / ns);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s/%d - ns:%u, pps:%u\n", method, BURST, (uint32_t)ns, pps);
+#else
+	printk("%-9s %3d frames: %6u ns per frame, %8u pps\n", method, BURST,
+	       (uint32_t)ns, pps);
+#endif /* CONFIG_BENCHMARK_RECORDING */
+}
+
+static int run(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(LOCAL_PORT),
+	};
+	struct timeval timeout = { .tv_sec = 1 };
+	uint64_t ns;
+	int sock;
+	int ret;
+
+	if (net_if_ipv4_addr_add(fake_eth_context.iface, (struct in_addr *)&local_addr,
+				 NET_ADDR_MANUAL, 0) == NULL) {
+		printk("Cannot add the IPv4 address\n");
+		return -EINVAL;
+	}
+
+	sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (sock < 0) {
+		return -errno;
+	}
+
+	(void)zsock_setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+	ret = zsock_bind(sock, (struct sockaddr *)&addr, sizeof(addr));
+	if (ret < 0) {
+		ret = -errno;
+		goto out;
+	}
+
+	build_frame();
+	fill_ring(&fake_eth_context);
+
+	ret = measure(per_frame, sock, &ns);
+	if (ret < 0) {
+		printk("per-frame: frames lost\n");
+		goto out;
+	}
+
+	report("per-frame", ns);
+
+	ret = measure(napi, sock, &ns);
+	if (ret < 0) {
+		printk("napi: frames lost\n");
+		goto out;
+	}
+
+	report("napi", ns);
+
+	ret = measure(napi_zero_copy, sock, &ns);
+	if (ret < 0) {
+		printk("napi-zc: frames lost\n");
+		goto out;
+	}
+
+	report("napi-zc", ns);
+
+out:
+	zsock_close(sock);
+
+	return ret;
+}
+
+int main(void)
+{
+	int ret;
+
+	timing_init();
+	timing_start();
+
+	TC_START("Ethernet batched reception");
+
+	ret = run();
+
+	timing_stop();
+
+	TC_END_REPORT(ret == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
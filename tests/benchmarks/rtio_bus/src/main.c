@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the register reads per second issued through RTIO to emulated
+ * I2C and SPI devices, one at a time and in batches.
+ *
+ * One at a time, every read is submitted on its own and waited for. In
+ * batches, the reads are submitted at once, which lets the bus take them
+ * in a single call, and their completions are waited for at once.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/spi.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/sys/printk.h>
+
+#define NUM_OPS   CONFIG_BENCHMARK_OPS
+#define DEPTH     CONFIG_BENCHMARK_DEPTH
+
+/* Burst read of the gyroscope and accelerometer samples of the BMI160 */
+#define REG_DATA  0x0C
+#define REG_READ  BIT(7)
+#define DATA_LEN  12
+
+I2C_DT_IODEV_DEFINE(i2c_iodev, DT_NODELABEL(bmi_i2c));
+SPI_DT_IODEV_DEFINE(spi_iodev, DT_NODELABEL(bmi_spi), SPI_WORD_SET(8) | SPI_TRANSFER_MSB, 0);
+
+/* A register read takes two submissions and produces one completion */
+RTIO_DEFINE(r_bench, 2 * DEPTH, DEPTH);
+
+struct bus {
+	const char *name;
+	struct rtio_iodev *iodev;
+	uint8_t reg;
+};
+
+static const struct bus buses[] = {
+	{ .name = "i2c", .iodev = &i2c_iodev, .reg = REG_DATA },
+	{ .name = "spi", .iodev = &spi_iodev, .reg = REG_DATA | REG_READ },
+};
+
+static uint8_t data[DEPTH][DATA_LEN];
+
+static void reg_read_prep(const struct bus *bus, uint8_t *buf)
+{
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&r_bench);
+
+	rtio_sqe_prep_tiny_write(sqe, bus->iodev, RTIO_PRIO_NORM, &bus->reg, 1, NULL);
+	sqe->flags |= RTIO_SQE_TRANSACTION | RTIO_SQE_NO_RESPONSE;
+
+	sqe = rtio_sqe_acquire(&r_bench);
+	rtio_sqe_prep_read(sqe, bus->iodev, RTIO_PRIO_NORM, buf, DATA_LEN, NULL);
+	sqe->iodev_flags = RTIO_IODEV_I2C_STOP | RTIO_IODEV_I2C_RESTART;
+}
+
+static int run_single(const struct bus *bus)
+{
+	struct rtio_cqe *cqe;
+	int ret = 0;
+
+	for (int i = 0; i < NUM_OPS; i++) {
+		reg_read_prep(bus, data[0]);
+		rtio_submit(&r_bench, 1);
+
+		cqe = rtio_cqe_consume(&r_bench);
+		if (cqe->result < 0) {
+			ret = cqe->result;
+		}
+		rtio_cqe_release(&r_bench, cqe);
+	}
+
+	return ret;
+}
+
+static int run_batched(const struct bus *bus)
+{
+	static struct rtio_cqe cqes[DEPTH];
+	int ret = 0;
+
+	for (int i = 0; i < NUM_OPS; i += DEPTH) {
+		for (int n = 0; n < DEPTH; n++) {
+			reg_read_prep(bus, data[n]);
+		}
+
+		rtio_submit(&r_bench, 0);
+
+		if (rtio_cqe_copy_out(&r_bench, cqes, DEPTH, K_FOREVER) != DEPTH) {
+			return -EIO;
+		}
+
+		for (int n = 0; n < DEPTH; n++) {
+			if (cqes[n].result < 0) {
+				ret = cqes[n].result;
+			}
+		}
+	}
+
+	return ret;
+}
+
+static int measure(const struct bus *bus, const char *mode, int (*run)(const struct bus *bus),
+		   uint32_t depth)
+{
+	timing_t start, finish;
+	uint64_t ns, ops_per_sec;
+	int ret;
+
+	start = timing_counter_get();
+	ret = run(bus);
+	finish = timing_counter_get();
+	ns = MAX(timing_cycles_to_ns(timing_cycles_get(&start, &finish)), 1U);
+
+	if (ret < 0) {
+		printk("%s %s failed (%d)\n", bus->name, mode, ret);
+		return ret;
+	}
+
+	ops_per_sec = ((uint64_t)ROUND_UP(NUM_OPS, depth) * NSEC_PER_SEC) / ns;
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s %s - depth:%u, ops:%u, ops/sec:%u\n", bus->name, mode, depth,
+	       (uint32_t)ROUND_UP(NUM_OPS, depth), (uint32_t)ops_per_sec);
+#else
+	printk("%s %-7s: depth %2u, %6u ops, %8u ops/sec\n", bus->name, mode, depth,
+	       (uint32_t)ROUND_UP(NUM_OPS, depth), (uint32_t)ops_per_sec);
+#endif /* CONFIG_BENCHMARK_RECORDING */
+
+	return 0;
+}
+
+int main(void)
+{
+	int ret = 0;
+
+	timing_init();
+	timing_start();
+
+	TC_START("RTIO register reads per second");
+
+	for (int i = 0; (i < ARRAY_SIZE(buses)) && (ret == 0); i++) {
+		ret = measure(&buses[i], "single", run_single, 1);
+		if (ret == 0) {
+			ret = measure(&buses[i], "batched", run_batched, DEPTH);
+		}
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(ret == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
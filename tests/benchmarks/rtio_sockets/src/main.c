@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Compare receiving from many connections with a thread per connection
+ * and with a single thread driving socket RTIO IO devices.
+ *
+ * The main thread sends the same messages to every connection and closes
+ * them. The readers count the bytes received until each connection is
+ * closed.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_rtio.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/sys/printk.h>
+
+#define NUM_CONNS    CONFIG_BENCHMARK_CONNECTIONS
+#define NUM_MSGS     CONFIG_BENCHMARK_MESSAGES
+#define MSG_SIZE     CONFIG_BENCHMARK_MESSAGE_SIZE
+#define STACK_SIZE   (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define READER_PRIO  K_PRIO_PREEMPT(1)
+
+/* Reads take up to RECV_MAX bytes from the pool, which holds twice what
+ * all the connections can have in flight so that the reader can lag
+ * behind without starving them.
+ */
+#define BLK_SIZE     16
+#define RECV_MAX     (4 * BLK_SIZE)
+#define NUM_BLKS     (2 * NUM_CONNS * RECV_MAX / BLK_SIZE)
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_CONNS, STACK_SIZE);
+static struct k_thread threads[NUM_CONNS];
+
+static int sv[NUM_CONNS][2];
+static uint32_t received[NUM_CONNS];
+
+static struct rtio_iodev iodevs[NUM_CONNS];
+static struct socket_rtio_data iodevs_data[NUM_CONNS];
+RTIO_DEFINE_WITH_MEMPOOL(r_bench, NUM_CONNS, 4 * NUM_CONNS, NUM_BLKS, BLK_SIZE, 4);
+
+static void thread_reader(void *p1, void *p2, void *p3)
+{
+	int conn = POINTER_TO_INT(p1);
+	uint8_t buf[RECV_MAX];
+	ssize_t rc;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while ((rc = zsock_recv(sv[conn][0], buf, sizeof(buf), 0)) > 0) {
+		received[conn] += rc;
+	}
+}
+
+static void rtio_reader(void *p1, void *p2, void *p3)
+{
+	int open = NUM_CONNS;
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+	uint32_t buf_len;
+	uint8_t *buf;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < NUM_CONNS; i++) {
+		socket_rtio_iodev_init(&iodevs[i], &iodevs_data[i], sv[i][0], RECV_MAX);
+
+		sqe = rtio_sqe_acquire(&r_bench);
+		rtio_sqe_prep_read_multishot(sqe, &iodevs[i], RTIO_PRIO_NORM,
+					     INT_TO_POINTER(i));
+	}
+
+	rtio_submit(&r_bench, 0);
+
+	/* Multishot reads end when their connection is closed */
+	while (open > 0) {
+		cqe = rtio_cqe_consume_block(&r_bench);
+
+		if (cqe->result > 0) {
+			received[POINTER_TO_INT(cqe->userdata)] += cqe->result;
+		} else {
+			open--;
+		}
+
+		if (rtio_cqe_get_mempool_buffer(&r_bench, cqe, &buf, &buf_len) == 0) {
+			rtio_release_buffer(&r_bench, buf, buf_len);
+		}
+
+		rtio_cqe_release(&r_bench, cqe);
+	}
+}
+
+static void send_all(void)
+{
+	static uint8_t msg[MSG_SIZE];
+
+	for (int n = 0; n < NUM_MSGS; n++) {
+		for (int i = 0; i < NUM_CONNS; i++) {
+			(void)zsock_send(sv[i][1], msg, sizeof(msg), 0);
+		}
+	}
+
+	for (int i = 0; i < NUM_CONNS; i++) {
+		zsock_close(sv[i][1]);
+	}
+}
+
+static int run(const char *mode, bool use_rtio)
+{
+	int num_threads = use_rtio ? 1 : NUM_CONNS;
+	size_t stack = num_threads * STACK_SIZE;
+	timing_t start, finish;
+	uint32_t cycles;
+	int ret = 0;
+
+	for (int i = 0; i < NUM_CONNS; i++) {
+		if (zsock_socketpair(AF_UNIX, SOCK_STREAM, 0, sv[i]) < 0) {
+			printk("socketpair %d failed (%d)\n", i, errno);
+			return -errno;
+		}
+
+		received[i] = 0U;
+	}
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < num_threads; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE,
+				use_rtio ? rtio_reader : thread_reader,
+				INT_TO_POINTER(i), NULL, NULL, READER_PRIO, 0, K_NO_WAIT);
+	}
+
+	send_all();
+
+	for (int i = 0; i < num_threads; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	finish = timing_counter_get();
+	cycles = (uint32_t)timing_cycles_get(&start, &finish);
+
+	for (int i = 0; i < NUM_CONNS; i++) {
+		if (received[i] != NUM_MSGS * MSG_SIZE) {
+			printk("connection %d received %u of %u bytes\n", i,
+			       received[i], NUM_MSGS * MSG_SIZE);
+			ret = -EIO;
+		}
+
+		zsock_close(sv[i][0]);
+	}
+
+	/* The RTIO reader also relies on the socket service thread */
+	if (use_rtio) {
+		num_threads++;
+		stack += CONFIG_NET_SOCKETS_SERVICE_STACK_SIZE;
+	}
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s - connections:%u, threads:%u, stack:%u bytes, cycles:%u\n",
+	       mode, NUM_CONNS, num_threads, (uint32_t)stack, cycles);
+#else
+	printk("%-20s: %u connections, %2u threads, %6u stack bytes, %10u cycles\n",
+	       mode, NUM_CONNS, num_threads, (uint32_t)stack, cycles);
+#endif /* CONFIG_BENCHMARK_RECORDING */
+
+	return ret;
+}
+
+int main(void)
+{
+	int ret;
+
+	timing_init();
+	timing_start();
+
+	TC_START("Socket receive, thread per connection vs. RTIO");
+	printk("%u messages of %u bytes per connection\n", NUM_MSGS, MSG_SIZE);
+
+	ret = run("thread per connection", false);
+	if (ret == 0) {
+		ret = run("rtio", true);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(ret == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the deadline miss ratio of periodic deadline tasks, optionally
+ * competing with a task that overruns the CPU share it declared.
+ *
+ * With plain EDF, the overrunning task keeps its expired deadline and
+ * starves the periodic tasks. With constant bandwidth servers, its
+ * deadline is postponed every time it uses up its budget.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/sys/printk.h>
+
+#define STACK_SIZE  (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define TASK_PRIO   K_PRIO_PREEMPT(1)
+
+/* Budgets leave this much margin over the execution times, in percent */
+#define BUDGET_MARGIN  25
+
+struct task {
+	const char *name;
+	uint32_t period_ms;
+	uint32_t exec_us;
+	uint32_t jobs;
+	uint32_t misses;
+};
+
+/* 60% of the CPU, plus margins and the overrun task's share: 85% */
+static struct task tasks[] = {
+	{ .name = "task 20ms",  .period_ms = 20,  .exec_us = 4000 },
+	{ .name = "task 50ms",  .period_ms = 50,  .exec_us = 10000 },
+	{ .name = "task 100ms", .period_ms = 100, .exec_us = 20000 },
+};
+
+/* Declares 10% of the CPU, uses all it can get */
+#define OVERRUN_PERIOD_MS  100
+#define OVERRUN_BUDGET_MS  10
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, ARRAY_SIZE(tasks) + 1, STACK_SIZE);
+static struct k_thread threads[ARRAY_SIZE(tasks) + 1];
+
+static volatile bool stop;
+static int64_t start_ms;
+static uint32_t loops_per_ms;
+
+/* Burn CPU time, as opposed to k_busy_wait() which waits wall time */
+static void work(uint32_t loops)
+{
+	for (volatile uint32_t i = 0; i < loops; i++) {
+	}
+}
+
+static void calibrate(void)
+{
+	uint32_t loops = 100000U;
+	uint32_t start = k_cycle_get_32();
+
+	work(loops);
+	loops_per_ms = (uint32_t)(((uint64_t)loops * k_ms_to_cyc_ceil32(1)) /
+				  MAX(k_cycle_get_32() - start, 1U));
+}
+
+static void task_entry(void *p1, void *p2, void *p3)
+{
+	struct task *task = p1;
+	uint32_t loops = (uint32_t)(((uint64_t)task->exec_us * loops_per_ms) / 1000U);
+	int64_t release = start_ms;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!stop) {
+#ifndef CONFIG_SCHED_DEADLINE_CBS
+		/* With a server, the deadline is set one period ahead when
+		 * the task wakes up.
+		 */
+		k_thread_deadline_set(k_current_get(),
+				      k_ms_to_cyc_ceil32(task->period_ms));
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
+		work(loops);
+
+		task->jobs++;
+		if (k_uptime_get() > release + task->period_ms) {
+			task->misses++;
+		}
+
+		release += task->period_ms;
+		k_sleep(K_TIMEOUT_ABS_MS(release));
+	}
+}
+
+static void overrun_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+#ifndef CONFIG_SCHED_DEADLINE_CBS
+	k_thread_deadline_set(k_current_get(),
+			      k_ms_to_cyc_ceil32(OVERRUN_PERIOD_MS));
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
+	while (!stop) {
+		work(loops_per_ms);
+	}
+}
+
+static k_tid_t thread_create(int i, k_thread_entry_t entry, void *arg,
+			     uint32_t budget_us, uint32_t period_ms)
+{
+	k_tid_t tid = k_thread_create(&threads[i], stacks[i], STACK_SIZE, entry,
+				      arg, NULL, NULL, TASK_PRIO, 0, K_FOREVER);
+
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	int ret = k_thread_deadline_budget_set(tid, k_us_to_cyc_ceil32(budget_us),
+					       k_ms_to_cyc_ceil32(period_ms));
+
+	if (ret != 0) {
+		printk("Budget of thread %d not admitted (%d)\n", i, ret);
+	}
+#else
+	ARG_UNUSED(budget_us);
+	ARG_UNUSED(period_ms);
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
+	return tid;
+}
+
+static void report(const struct task *task)
+{
+	uint32_t permille = (task->jobs != 0U) ?
+			    (task->misses * 1000U) / task->jobs : 0U;
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s - jobs:%u, misses:%u, miss ratio:%u.%u %%\n",
+	       task->name, task->jobs, task->misses, permille / 10U,
+	       permille % 10U);
+#else
+	printk("%-12s: %6u jobs, %6u misses, %3u.%u %% missed\n", task->name,
+	       task->jobs, task->misses, permille / 10U, permille % 10U);
+#endif /* CONFIG_BENCHMARK_RECORDING */
+}
+
+int main(void)
+{
+	struct task total = { .name = "all tasks" };
+	int num_threads = ARRAY_SIZE(tasks);
+
+	/* Keep the measurements away from the tasks */
+	k_thread_priority_set(k_current_get(), K_PRIO_COOP(0));
+
+	calibrate();
+
+	for (int i = 0; i < ARRAY_SIZE(tasks); i++) {
+		thread_create(i, task_entry, &tasks[i],
+			      tasks[i].exec_us * (100U + BUDGET_MARGIN) / 100U,
+			      tasks[i].period_ms);
+	}
+
+	if (IS_ENABLED(CONFIG_BENCHMARK_OVERRUN)) {
+		thread_create(num_threads++, overrun_entry, NULL,
+			      OVERRUN_BUDGET_MS * USEC_PER_MSEC, OVERRUN_PERIOD_MS);
+	}
+
+	TC_START("Deadline miss ratio");
+	printk("%u ms, %s%s\n", CONFIG_BENCHMARK_DURATION_MS,
+	       IS_ENABLED(CONFIG_SCHED_DEADLINE_CBS) ? "CBS" : "EDF",
+	       IS_ENABLED(CONFIG_BENCHMARK_OVERRUN) ? ", overrun" : "");
+
+	start_ms = k_uptime_get();
+	for (int i = 0; i < num_threads; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	k_msleep(CONFIG_BENCHMARK_DURATION_MS);
+	stop = true;
+
+	for (int i = 0; i < num_threads; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(tasks); i++) {
+		report(&tasks[i]);
+		total.jobs += tasks[i].jobs;
+		total.misses += tasks[i].misses;
+	}
+
+	report(&total);
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the cost of delivering the readings of an emulated accelerometer to
+ * many clients of the sensing subsystem, with one data event per reading and
+ * with readings batched by latency.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/sensing/sensing.h>
+#include <zephyr/sensing/sensing_datatypes.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/sys/printk.h>
+
+#define NUM_CLIENTS  CONFIG_BENCHMARK_CLIENTS
+#define STACK_SIZE   (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+/* Clients run before the dispatch thread, as applications usually do */
+#define CLIENT_PRIO  (CONFIG_SENSING_DISPATCH_THREAD_PRIORITY - 1)
+
+struct client {
+	sensing_sensor_handle_t handle;
+	struct sensing_callback_list cb;
+	struct k_sem sem;
+	atomic_t readings;
+	uint32_t wakeups;
+	uint32_t interval;
+	uint64_t last_timestamp;
+	bool out_of_order;
+};
+
+static struct client clients[NUM_CLIENTS];
+static struct k_thread threads[NUM_CLIENTS];
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_CLIENTS, STACK_SIZE);
+
+static void on_data_event(sensing_sensor_handle_t handle, const void *buf, void *context)
+{
+	const struct sensing_sensor_value_3d_q31 *sample = buf;
+	struct client *c = context;
+	uint64_t t = sample->header.base_timestamp;
+
+	for (int i = 0; i < sample->header.reading_count; i++) {
+		t += sample->readings[i].timestamp_delta;
+		if (t <= c->last_timestamp) {
+			c->out_of_order = true;
+		}
+		c->last_timestamp = t;
+	}
+
+	atomic_add(&c->readings, sample->header.reading_count);
+	k_sem_give(&c->sem);
+}
+
+static void client_thread(void *p1, void *p2, void *p3)
+{
+	struct client *c = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_take(&c->sem, K_FOREVER);
+		c->wakeups++;
+	}
+}
+
+static int configure(struct client *c, uint32_t interval, uint64_t latency)
+{
+	struct sensing_sensor_config config[2] = {
+		{ .attri = SENSING_SENSOR_ATTRIBUTE_INTERVAL, .interval = interval },
+		{ .attri = SENSING_SENSOR_ATTRIBUTE_LATENCY, .latency = latency },
+	};
+
+	return sensing_set_config(c->handle, config, ARRAY_SIZE(config));
+}
+
+static int run(const char *mode, uint64_t latency)
+{
+	k_thread_runtime_stats_t before, after;
+	uint32_t readings = 0, wakeups = 0;
+	int ret = 0;
+
+	for (int i = 0; i < NUM_CLIENTS; i++) {
+		atomic_clear(&clients[i].readings);
+		clients[i].wakeups = 0;
+		clients[i].last_timestamp = 0;
+		clients[i].out_of_order = false;
+	}
+
+	k_thread_runtime_stats_all_get(&before);
+
+	for (int i = 0; (i < NUM_CLIENTS) && (ret == 0); i++) {
+		ret = configure(&clients[i], clients[i].interval, latency);
+	}
+
+	k_msleep(CONFIG_BENCHMARK_DURATION_MS);
+
+	for (int i = 0; i < NUM_CLIENTS; i++) {
+		ret |= configure(&clients[i], 0, 0);
+	}
+
+	/* let the last readings in flight reach the clients */
+	k_msleep(10);
+
+	k_thread_runtime_stats_all_get(&after);
+
+	if (ret != 0) {
+		printk("%s: configuring the clients failed (%d)\n", mode, ret);
+		return ret;
+	}
+
+	for (int i = 0; i < NUM_CLIENTS; i++) {
+		uint32_t count = atomic_get(&clients[i].readings);
+
+		if (count == 0 || clients[i].out_of_order) {
+			printk("%s: client %d got %u readings%s\n", mode, i, count,
+			       clients[i].out_of_order ? " out of order" : "");
+			ret = -EIO;
+		}
+
+		readings += count;
+		wakeups += clients[i].wakeups;
+	}
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s - clients:%u, readings:%u, wakeups:%u, busy_cycles:%u\n", mode,
+	       NUM_CLIENTS, readings, wakeups,
+	       (uint32_t)(after.total_cycles - before.total_cycles));
+#else
+	printk("%-11s: %2u clients, %7u readings, %7u wakeups, %10u busy cycles\n", mode,
+	       NUM_CLIENTS, readings, wakeups,
+	       (uint32_t)(after.total_cycles - before.total_cycles));
+#endif /* CONFIG_BENCHMARK_RECORDING */
+
+	return ret;
+}
+
+int main(void)
+{
+	const struct device *accel = DEVICE_DT_GET(DT_NODELABEL(accel));
+	int ret = 0;
+
+	TC_START("Sensing dispatch, per reading vs. batched");
+
+	for (int i = 0; (i < NUM_CLIENTS) && (ret == 0); i++) {
+		struct client *c = &clients[i];
+
+		c->interval = CONFIG_BENCHMARK_INTERVAL_US * (1 + i % 2);
+		c->cb.on_data_event = on_data_event;
+		c->cb.context = c;
+		k_sem_init(&c->sem, 0, K_SEM_MAX_LIMIT);
+
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, client_thread, c, NULL, NULL,
+				CLIENT_PRIO, 0, K_NO_WAIT);
+
+		ret = sensing_open_sensor_by_dt(accel, &c->cb, &c->handle);
+		if (ret != 0) {
+			printk("opening the accelerometer failed (%d)\n", ret);
+		}
+	}
+
+	if (ret == 0) {
+		ret = run("per_reading", 0);
+	}
+	if (ret == 0) {
+		ret = run("batched", CONFIG_BENCHMARK_LATENCY_US);
+	}
+
+	TC_END_REPORT(ret == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
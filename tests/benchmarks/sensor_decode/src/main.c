@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the cost of decoding the accelerometer and gyroscope readings of
+ * FIFO buffers of emulated ICM42688 and LSM6DSV16X sensors.
+ *
+ * Frame by frame, the readings are decoded with sensor_decode() into a
+ * struct sensor_three_axis_data. In bulk, they are decoded with
+ * sensor_decode_bulk() into one array per axis. Both must give the same
+ * readings.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/dt-bindings/sensor/icm42688.h>
+#include <zephyr/dt-bindings/sensor/lsm6dsv16x.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/sys/printk.h>
+
+#include "icm42688_decoder.h"
+#include "icm42688_reg.h"
+#include "lsm6dsv16x_decoder.h"
+
+#define NUM_FRAMES  CONFIG_BENCHMARK_FRAMES
+#define NUM_ITER    CONFIG_BENCHMARK_ITERATIONS
+
+/* High resolution ICM42688 packets carry accel, gyro, temperature and timestamp */
+#define ICM42688_PACKET_SIZE  20
+
+/* LSM6DSV16X FIFO words, with the tags from lsm6dsv16x_reg.h of the ST HAL */
+#define LSM6DSV16X_WORD_SIZE  7
+#define LSM6DSV16X_TAG_GY     0x01
+#define LSM6DSV16X_TAG_XL     0x02
+
+static uint8_t icm42688_buf[sizeof(struct icm42688_fifo_data) +
+			    NUM_FRAMES * ICM42688_PACKET_SIZE] __aligned(8);
+
+/* Accel and gyro words are interleaved */
+static uint8_t lsm6dsv16x_buf[sizeof(struct lsm6dsv16x_fifo_data) +
+			      2 * NUM_FRAMES * LSM6DSV16X_WORD_SIZE] __aligned(8);
+
+static uint8_t frames_buf[sizeof(struct sensor_three_axis_data) +
+			  (NUM_FRAMES - 1) * sizeof(struct sensor_three_axis_sample_data)]
+	__aligned(8);
+static q31_t bulk_values[3][NUM_FRAMES];
+static uint32_t bulk_timestamps[NUM_FRAMES];
+
+struct bench {
+	const char *sensor;
+	const char *channel;
+	const struct device *dev;
+	const uint8_t *buf;
+	struct sensor_chan_spec chan;
+};
+
+static const struct bench benches[] = {
+	{ "icm42688", "accel", DEVICE_DT_GET(DT_NODELABEL(icm42688)), icm42688_buf,
+	  { SENSOR_CHAN_ACCEL_XYZ, 0 } },
+	{ "icm42688", "gyro", DEVICE_DT_GET(DT_NODELABEL(icm42688)), icm42688_buf,
+	  { SENSOR_CHAN_GYRO_XYZ, 0 } },
+	{ "lsm6dsv16x", "accel", DEVICE_DT_GET(DT_NODELABEL(lsm6dsv16x)), lsm6dsv16x_buf,
+	  { SENSOR_CHAN_ACCEL_XYZ, 0 } },
+	{ "lsm6dsv16x", "gyro", DEVICE_DT_GET(DT_NODELABEL(lsm6dsv16x)), lsm6dsv16x_buf,
+	  { SENSOR_CHAN_GYRO_XYZ, 0 } },
+};
+
+/* Readings only need to vary, xorshift is plenty */
+static uint8_t random_byte(void)
+{
+	static uint32_t state = 0x12345678U;
+
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+
+	return (uint8_t)state;
+}
+
+static void icm42688_fill(void)
+{
+	struct icm42688_fifo_data *edata = (struct icm42688_fifo_data *)icm42688_buf;
+	uint8_t *pkt = icm42688_buf + sizeof(*edata);
+
+	*edata = (struct icm42688_fifo_data){
+		.header = {
+			.timestamp = NSEC_PER_SEC,
+			.is_fifo = 1,
+			.accel_fs = ICM42688_DT_ACCEL_FS_16,
+			.gyro_fs = ICM42688_DT_GYRO_FS_2000,
+		},
+		.accel_odr = ICM42688_DT_ACCEL_ODR_1000,
+		.gyro_odr = ICM42688_DT_GYRO_ODR_1000,
+		.fifo_count = NUM_FRAMES * ICM42688_PACKET_SIZE,
+	};
+
+	for (int i = 0; i < NUM_FRAMES * ICM42688_PACKET_SIZE; i++) {
+		pkt[i] = random_byte();
+	}
+
+	for (int i = 0; i < NUM_FRAMES; i++) {
+		pkt[i * ICM42688_PACKET_SIZE] = FIFO_HEADER_ACCEL | FIFO_HEADER_GYRO |
+						FIFO_HEADER_20;
+	}
+}
+
+static void lsm6dsv16x_fill(void)
+{
+	struct lsm6dsv16x_fifo_data *edata = (struct lsm6dsv16x_fifo_data *)lsm6dsv16x_buf;
+	uint8_t *word = lsm6dsv16x_buf + sizeof(*edata);
+
+	*edata = (struct lsm6dsv16x_fifo_data){
+		.header = {
+			.timestamp = NSEC_PER_SEC,
+			.is_fifo = 1,
+			.accel_fs = LSM6DSV16X_DT_FS_16G,
+			.gyro_fs = LSM6DSV16X_DT_FS_2000DPS,
+		},
+		.fifo_count = 2 * NUM_FRAMES,
+		.accel_batch_odr = LSM6DSV16X_DT_XL_BATCHED_AT_960Hz,
+		.gyro_batch_odr = LSM6DSV16X_DT_GY_BATCHED_AT_960Hz,
+	};
+
+	for (int i = 0; i < 2 * NUM_FRAMES * LSM6DSV16X_WORD_SIZE; i++) {
+		word[i] = random_byte();
+	}
+
+	for (int i = 0; i < 2 * NUM_FRAMES; i++) {
+		word[i * LSM6DSV16X_WORD_SIZE] =
+			((i % 2) == 0 ? LSM6DSV16X_TAG_XL : LSM6DSV16X_TAG_GY) << 3;
+	}
+}
+
+static int decode_frames(const struct sensor_decoder_api *decoder, const struct bench *bench)
+{
+	struct sensor_decode_context ctx = SENSOR_DECODE_CONTEXT_INIT(
+		decoder, bench->buf, bench->chan.chan_type, bench->chan.chan_idx);
+
+	return sensor_decode(&ctx, frames_buf, NUM_FRAMES);
+}
+
+static int decode_bulk(const struct sensor_decoder_api *decoder, const struct bench *bench)
+{
+	struct sensor_three_axis_bulk_data out = {
+		.capacity = NUM_FRAMES,
+		.timestamp_delta = bulk_timestamps,
+		.values = { bulk_values[0], bulk_values[1], bulk_values[2] },
+	};
+
+	return sensor_decode_bulk(decoder, bench->buf, bench->chan, &out);
+}
+
+static int check(const struct bench *bench, int count)
+{
+	const struct sensor_three_axis_data *frames =
+		(const struct sensor_three_axis_data *)frames_buf;
+
+	for (int i = 0; i < count; i++) {
+		for (int axis = 0; axis < 3; axis++) {
+			if (frames->readings[i].values[axis] != bulk_values[axis][i]) {
+				printk("%s %s reading %d axis %d: %d != %d\n", bench->sensor,
+				       bench->channel, i, axis, frames->readings[i].values[axis],
+				       bulk_values[axis][i]);
+				return -EINVAL;
+			}
+		}
+
+		if (frames->readings[i].timestamp_delta != bulk_timestamps[i]) {
+			printk("%s %s reading %d timestamp: %u != %u\n", bench->sensor,
+			       bench->channel, i, frames->readings[i].timestamp_delta,
+			       bulk_timestamps[i]);
+			return -EINVAL;
+		}
+	}
+
+	return 0;
+}
+
+static int measure(const struct sensor_decoder_api *decoder, const struct bench *bench,
+		   const char *mode,
+		   int (*decode)(const struct sensor_decoder_api *decoder,
+				 const struct bench *bench))
+{
+	timing_t start, finish;
+	uint64_t cycles;
+	uint32_t ns;
+	int count = 0;
+
+	start = timing_counter_get();
+	for (int i = 0; i < NUM_ITER; i++) {
+		count = decode(decoder, bench);
+	}
+	finish = timing_counter_get();
+
+	if (count != NUM_FRAMES) {
+		printk("%s %s %s decoded %d of %u readings\n", bench->sensor, bench->channel,
+		       mode, count, NUM_FRAMES);
+		return -EIO;
+	}
+
+	cycles = timing_cycles_get(&start, &finish);
+	ns = (uint32_t)(timing_cycles_to_ns(cycles) / (NUM_ITER * NUM_FRAMES));
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s %s %s - readings:%u, cycles:%u, ns/reading:%u\n", bench->sensor,
+	       bench->channel, mode, NUM_FRAMES, (uint32_t)cycles, ns);
+#else
+	printk("%-10s %-5s %-6s: %3u readings, %10u cycles, %6u ns/reading\n", bench->sensor,
+	       bench->channel, mode, NUM_FRAMES, (uint32_t)cycles, ns);
+#endif /* CONFIG_BENCHMARK_RECORDING */
+
+	return 0;
+}
+
+int main(void)
+{
+	const struct sensor_decoder_api *decoder;
+	int ret = 0;
+
+	timing_init();
+	timing_start();
+
+	icm42688_fill();
+	lsm6dsv16x_fill();
+
+	TC_START("Sensor FIFO decoding, frame by frame vs. bulk");
+
+	for (int i = 0; (i < ARRAY_SIZE(benches)) && (ret == 0); i++) {
+		ret = sensor_get_decoder(benches[i].dev, &decoder);
+		if (ret != 0) {
+			printk("%s has no decoder (%d)\n", benches[i].sensor, ret);
+			break;
+		}
+
+		ret = measure(decoder, &benches[i], "frames", decode_frames);
+		if (ret == 0) {
+			ret = measure(decoder, &benches[i], "bulk", decode_bulk);
+		}
+		if (ret == 0) {
+			ret = check(&benches[i], NUM_FRAMES);
+		}
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(ret == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the throughput of an image download written to a simulated flash
+ * with slow erases, with stream flash writing synchronously and writing in
+ * the background while the next chunks are received.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/storage/stream_flash.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/sys/printk.h>
+#include <string.h>
+
+#define IMAGE_SIZE  (CONFIG_BENCHMARK_IMAGE_SIZE * 1024)
+#define CHUNK_SIZE  CONFIG_BENCHMARK_CHUNK_SIZE
+/* One page of the qemu_x86 simulated flash */
+#define BUF_LEN     1024
+
+static const struct device *const flash_dev = DEVICE_DT_GET(DT_NODELABEL(sim_flash));
+
+static struct stream_flash_ctx ctx;
+static uint8_t buf[BUF_LEN];
+static uint8_t async_buf[BUF_LEN];
+static uint8_t chunk[CHUNK_SIZE];
+static uint8_t read_back[CHUNK_SIZE];
+
+static void fill_chunk(size_t offset, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		chunk[i] = (uint8_t)((offset + i) * 31U);
+	}
+}
+
+static int verify(void)
+{
+	int ret;
+
+	for (size_t offset = 0; offset < IMAGE_SIZE; offset += CHUNK_SIZE) {
+		size_t len = MIN(CHUNK_SIZE, IMAGE_SIZE - offset);
+
+		ret = flash_read(flash_dev, offset, read_back, len);
+		if (ret != 0) {
+			return ret;
+		}
+
+		fill_chunk(offset, len);
+		if (memcmp(chunk, read_back, len) != 0) {
+			printk("image differs at 0x%zx\n", offset);
+			return -EIO;
+		}
+	}
+
+	return 0;
+}
+
+static int download(const char *mode, bool async)
+{
+	timing_t start, finish;
+	uint64_t ns;
+	int ret;
+
+	ret = stream_flash_init(&ctx, flash_dev, buf, BUF_LEN, 0, IMAGE_SIZE, NULL);
+	if (ret == 0 && async) {
+		ret = stream_flash_async_init(&ctx, async_buf, NULL, NULL);
+	}
+	if (ret != 0) {
+		printk("%s: initializing stream flash failed (%d)\n", mode, ret);
+		return ret;
+	}
+
+	start = timing_counter_get();
+
+	for (size_t offset = 0; (offset < IMAGE_SIZE) && (ret == 0); offset += CHUNK_SIZE) {
+		size_t len = MIN(CHUNK_SIZE, IMAGE_SIZE - offset);
+
+		k_usleep(CONFIG_BENCHMARK_CHUNK_RECV_US);
+		fill_chunk(offset, len);
+
+		ret = stream_flash_buffered_write(&ctx, chunk, len, offset + len == IMAGE_SIZE);
+	}
+
+	finish = timing_counter_get();
+
+	if (ret != 0) {
+		printk("%s: writing the image failed (%d)\n", mode, ret);
+		return ret;
+	}
+
+	ret = verify();
+	if (ret != 0) {
+		return ret;
+	}
+
+	ns = timing_cycles_to_ns(timing_cycles_get(&start, &finish));
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s - bytes:%u, us:%u, KiB/s:%u\n", mode, IMAGE_SIZE,
+	       (uint32_t)(ns / NSEC_PER_USEC),
+	       (uint32_t)((uint64_t)IMAGE_SIZE * NSEC_PER_SEC / 1024 / ns));
+#else
+	printk("%-5s: %7u bytes in %9u us, %6u KiB/s\n", mode, IMAGE_SIZE,
+	       (uint32_t)(ns / NSEC_PER_USEC),
+	       (uint32_t)((uint64_t)IMAGE_SIZE * NSEC_PER_SEC / 1024 / ns));
+#endif /* CONFIG_BENCHMARK_RECORDING */
+
+	return 0;
+}
+
+int main(void)
+{
+	int ret = 0;
+
+	timing_init();
+	timing_start();
+
+	TC_START("Stream flash image download, synchronous vs. asynchronous");
+
+	if (!device_is_ready(flash_dev)) {
+		printk("flash device not ready\n");
+		ret = -ENODEV;
+	}
+
+	if (ret == 0) {
+		ret = download("sync", false);
+	}
+	if (ret == 0) {
+		ret = download("async", true);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(ret == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Compare the TCP congestion control algorithms on loopback links that lose
+ * and delay packets.
+ *
+ * For each algorithm and link, a connection sends the same amount of data to
+ * a server thread, which counts it until the connection is closed.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/loopback.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/net_stats.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/sys/printk.h>
+#include <string.h>
+
+#define SERVER_PORT       4242
+#define TRANSFER_SIZE     (CONFIG_BENCHMARK_TRANSFER_SIZE * 1024)
+#define CHUNK_SIZE        1024
+#define DROP_RATIO        (CONFIG_BENCHMARK_DROP_PERCENT / 100.0f)
+#define DELAY_MS          CONFIG_BENCHMARK_DELAY_MS
+#define SERVER_STACK_SIZE (2048 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define SERVER_PRIO       K_PRIO_PREEMPT(1)
+#define FINISH_TIMEOUT    K_SECONDS(120)
+
+struct link {
+	const char *name;
+	float drop_ratio;
+	uint32_t delay_ms;
+};
+
+static const struct link links[] = {
+	{ "clean", 0.0f, 0 },
+	{ "lossy", DROP_RATIO, 0 },
+	{ "long", 0.0f, DELAY_MS },
+	{ "lossy_long", DROP_RATIO, DELAY_MS },
+};
+
+static const char *const algorithms[] = { "reno", "cubic", "bbr" };
+
+static K_THREAD_STACK_DEFINE(server_stack, SERVER_STACK_SIZE);
+static struct k_thread server_thread;
+static K_SEM_DEFINE(server_done, 0, 1);
+
+static int listen_sock = -1;
+static uint32_t received;
+
+static uint8_t chunk[CHUNK_SIZE];
+
+static void server(void *p1, void *p2, void *p3)
+{
+	uint8_t buf[CHUNK_SIZE];
+	ssize_t rc;
+	int sock;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while ((sock = zsock_accept(listen_sock, NULL, NULL)) >= 0) {
+		received = 0;
+
+		while ((rc = zsock_recv(sock, buf, sizeof(buf), 0)) > 0) {
+			received += rc;
+		}
+
+		zsock_close(sock);
+		k_sem_give(&server_done);
+	}
+}
+
+static int server_start(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+		.sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+	};
+
+	listen_sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (listen_sock < 0) {
+		return -errno;
+	}
+
+	if (zsock_bind(listen_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    zsock_listen(listen_sock, 1) < 0) {
+		return -errno;
+	}
+
+	k_thread_create(&server_thread, server_stack, K_THREAD_STACK_SIZEOF(server_stack),
+			server, NULL, NULL, NULL, SERVER_PRIO, 0, K_NO_WAIT);
+
+	return 0;
+}
+
+static int send_all(int sock)
+{
+	ssize_t rc;
+
+	for (size_t sent = 0; sent < TRANSFER_SIZE; sent += rc) {
+		rc = zsock_send(sock, chunk, MIN(CHUNK_SIZE, TRANSFER_SIZE - sent), 0);
+		if (rc < 0) {
+			return -errno;
+		}
+	}
+
+	return 0;
+}
+
+static int transfer(const char *algorithm, const struct link *link)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+		.sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+	};
+	struct net_stats_tcp before, after;
+	struct tcp_info info = { 0 };
+	socklen_t info_len = sizeof(info);
+	timing_t start, finish;
+	uint32_t ms;
+	int sock;
+	int ret;
+
+	(void)loopback_set_packet_drop_ratio(link->drop_ratio);
+	(void)loopback_set_packet_delay(link->delay_ms);
+
+	sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0) {
+		return -errno;
+	}
+
+	ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, algorithm,
+			       strlen(algorithm));
+	if (ret < 0) {
+		printk("%s is not available (%d)\n", algorithm, errno);
+		ret = -errno;
+		goto out;
+	}
+
+	ret = zsock_connect(sock, (struct sockaddr *)&addr, sizeof(addr));
+	if (ret < 0) {
+		printk("connect failed (%d)\n", errno);
+		ret = -errno;
+		goto out;
+	}
+
+	(void)net_mgmt(NET_REQUEST_STATS_GET_TCP, NULL, &before, sizeof(before));
+
+	start = timing_counter_get();
+
+	ret = send_all(sock);
+	if (ret < 0) {
+		printk("send failed (%d)\n", ret);
+		goto out;
+	}
+
+	/* The window and round trip time reached, before the connection ends */
+	(void)zsock_getsockopt(sock, IPPROTO_TCP, TCP_INFO, &info, &info_len);
+
+	zsock_close(sock);
+	sock = -1;
+
+	if (k_sem_take(&server_done, FINISH_TIMEOUT) != 0) {
+		printk("%s/%s: the transfer did not end\n", algorithm, link->name);
+		return -ETIMEDOUT;
+	}
+
+	finish = timing_counter_get();
+
+	(void)net_mgmt(NET_REQUEST_STATS_GET_TCP, NULL, &after, sizeof(after));
+
+	if (received != TRANSFER_SIZE) {
+		printk("%s/%s: received %u bytes of %u\n", algorithm, link->name,
+		       received, TRANSFER_SIZE);
+		return -EIO;
+	}
+
+	ms = (uint32_t)(timing_cycles_to_ns(timing_cycles_get(&start, &finish)) /
+			NSEC_PER_MSEC);
+	ms = MAX(ms, 1U);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s/%s - bytes:%u, ms:%u, KiB/s:%u, fast_rexmit:%u, rto:%u, cwnd:%u, "
+	       "rtt_us:%u\n", algorithm, link->name, TRANSFER_SIZE, ms,
+	       TRANSFER_SIZE / 1024 * MSEC_PER_SEC / ms,
+	       after.fast_rexmit - before.fast_rexmit, after.rto - before.rto,
+	       info.tcpi_snd_cwnd, info.tcpi_rtt);
+#else
+	printk("%-5s %-10s: %7u bytes in %6u ms, %6u KiB/s, %4u fast rexmit, %3u rto, "
+	       "cwnd %6u, rtt %6u us\n", algorithm, link->name, TRANSFER_SIZE, ms,
+	       TRANSFER_SIZE / 1024 * MSEC_PER_SEC / ms,
+	       after.fast_rexmit - before.fast_rexmit, after.rto - before.rto,
+	       info.tcpi_snd_cwnd, info.tcpi_rtt);
+#endif /* CONFIG_BENCHMARK_RECORDING */
+
+out:
+	if (sock >= 0) {
+		zsock_close(sock);
+	}
+
+	return ret;
+}
+
+static int run(void)
+{
+	int ret;
+
+	for (size_t i = 0; i < sizeof(chunk); i++) {
+		chunk[i] = (uint8_t)i;
+	}
+
+	ret = server_start();
+	if (ret != 0) {
+		printk("starting the server failed (%d)\n", ret);
+		return ret;
+	}
+
+	ARRAY_FOR_EACH(links, i) {
+		ARRAY_FOR_EACH(algorithms, j) {
+			ret = transfer(algorithms[j], &links[i]);
+			if (ret != 0) {
+				goto out;
+			}
+		}
+	}
+
+out:
+	(void)loopback_set_packet_drop_ratio(0.0f);
+	(void)loopback_set_packet_delay(0);
+
+	return ret;
+}
+
+int main(void)
+{
+	int ret;
+
+	timing_init();
+	timing_start();
+
+	TC_START("TCP congestion control on lossy and long loopback links");
+
+	ret = run();
+
+	timing_stop();
+
+	TC_END_REPORT(ret == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
@@ -9,9 +9,11 @@
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/drivers/gpio/gpio_emul.h>
 #include <zephyr/drivers/sensor.h>
+#include <zephyr/dt-bindings/sensor/icm42688.h>
 #include <zephyr/fff.h>
 #include <zephyr/ztest.h>
 
+#include "icm42688_decoder.h"
 #include "icm42688_emul.h"
 #include "icm42688_reg.h"
 
@@ -240,3 +242,78 @@ ZTEST_F(icm42688, test_interrupt)
 	/* Verify the handler was called */
 	zassert_equal(test_interrupt_trigger_handler_fake.call_count, 1);
 }
+
+static void test_decode_bulk_matches_frames(const struct sensor_decoder_api *decoder,
+					    const uint8_t *buf, enum sensor_channel chan,
+					    uint16_t expected)
+{
+	struct sensor_decode_context ctx = SENSOR_DECODE_CONTEXT_INIT(decoder, buf, chan, 0);
+	uint8_t frames_buf[sizeof(struct sensor_three_axis_data) +
+			   3 * sizeof(struct sensor_three_axis_sample_data)] __aligned(8);
+	struct sensor_three_axis_data *frames = (struct sensor_three_axis_data *)frames_buf;
+	q31_t values[3][4];
+	uint32_t timestamps[4];
+	struct sensor_three_axis_bulk_data bulk = {
+		.capacity = ARRAY_SIZE(timestamps),
+		.timestamp_delta = timestamps,
+		.values = { values[0], values[1], values[2] },
+	};
+
+	zassert_equal(expected, sensor_decode(&ctx, frames, 4));
+	zassert_equal(expected,
+		      sensor_decode_bulk(decoder, buf, (struct sensor_chan_spec){chan, 0}, &bulk));
+	zassert_equal(frames->shift, bulk.shift);
+	zassert_equal(frames->header.base_timestamp_ns, bulk.header.base_timestamp_ns);
+
+	for (int i = 0; i < expected; i++) {
+		zassert_equal(frames->readings[i].timestamp_delta, timestamps[i]);
+		zassert_equal(frames->readings[i].x, values[0][i], "reading %d", i);
+		zassert_equal(frames->readings[i].y, values[1][i], "reading %d", i);
+		zassert_equal(frames->readings[i].z, values[2][i], "reading %d", i);
+	}
+}
+
+ZTEST_F(icm42688, test_fifo_decode_bulk)
+{
+	const struct sensor_decoder_api *decoder;
+	uint8_t buf[sizeof(struct icm42688_fifo_data) + 4 * 20];
+	struct icm42688_fifo_data *edata = (struct icm42688_fifo_data *)buf;
+	uint8_t *pkt = buf + sizeof(*edata);
+
+	zassert_ok(sensor_get_decoder(fixture->dev, &decoder));
+
+	*edata = (struct icm42688_fifo_data){
+		.header = {
+			.timestamp = 1000000,
+			.is_fifo = 1,
+		},
+		.accel_odr = ICM42688_DT_ACCEL_ODR_1000,
+		.gyro_odr = ICM42688_DT_GYRO_ODR_1000,
+		.fifo_count = 4 * 20,
+	};
+
+	/* Negative and positive readings in every axis */
+	for (int i = 0; i < 4 * 20; i++) {
+		pkt[i] = (i * 37) ^ ((i & 1) ? 0x80 : 0x00);
+	}
+
+	/* High resolution packets */
+	for (int i = 0; i < 4; i++) {
+		pkt[i * 20] = FIFO_HEADER_ACCEL | FIFO_HEADER_GYRO | FIFO_HEADER_20;
+	}
+	test_decode_bulk_matches_frames(decoder, buf, SENSOR_CHAN_ACCEL_XYZ, 4);
+	test_decode_bulk_matches_frames(decoder, buf, SENSOR_CHAN_GYRO_XYZ, 4);
+
+	/* Low resolution packets */
+	edata->fifo_count = 4 * 16;
+	for (int i = 0; i < 4; i++) {
+		pkt[i * 16] = FIFO_HEADER_ACCEL | FIFO_HEADER_GYRO;
+	}
+	test_decode_bulk_matches_frames(decoder, buf, SENSOR_CHAN_ACCEL_XYZ, 4);
+	test_decode_bulk_matches_frames(decoder, buf, SENSOR_CHAN_GYRO_XYZ, 4);
+
+	/* Mixed layouts fall back to decoding frame by frame */
+	edata->fifo_count = 16 + 20;
+	pkt[16] = FIFO_HEADER_ACCEL | FIFO_HEADER_GYRO | FIFO_HEADER_20;
+	test_decode_bulk_matches_frames(decoder, buf, SENSOR_CHAN_ACCEL_XYZ, 2);
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define NUM_THREADS  3
+#define STACK_SIZE   (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define SPIN_PRIO    K_PRIO_PREEMPT(1)
+#define PERIOD_MS    100
+#define RUN_MS       1000
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_THREADS, STACK_SIZE);
+static struct k_thread threads[NUM_THREADS];
+
+static volatile uint32_t spins[NUM_THREADS];
+static volatile bool stop;
+
+static void spinner(void *p1, void *p2, void *p3)
+{
+	volatile uint32_t *count = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!stop) {
+		(*count)++;
+	}
+}
+
+static k_tid_t spinner_create(int i, uint32_t budget_ms)
+{
+	k_tid_t tid;
+
+	spins[i] = 0U;
+	tid = k_thread_create(&threads[i], stacks[i], STACK_SIZE, spinner,
+			      (void *)&spins[i], NULL, NULL, SPIN_PRIO, 0,
+			      K_FOREVER);
+	zassert_ok(k_thread_deadline_budget_set(tid, k_ms_to_cyc_ceil32(budget_ms),
+						k_ms_to_cyc_ceil32(PERIOD_MS)));
+
+	return tid;
+}
+
+/* Start the spinners, let them compete for the CPU and stop them */
+static void spinners_run(int count)
+{
+	stop = false;
+
+	for (int i = 0; i < count; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	k_msleep(RUN_MS);
+	stop = true;
+
+	for (int i = 0; i < count; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+}
+
+/**
+ * @brief Test that a budgeted thread cannot starve its peers
+ *
+ * Two threads of the same priority spin forever. Without a budget, the
+ * one with the earliest deadline would keep the CPU. With equal budgets,
+ * each of them has to get a fair share.
+ */
+ZTEST(sched_deadline_cbs, test_no_starvation)
+{
+	uint32_t total;
+
+	spinner_create(0, PERIOD_MS / 4);
+	spinner_create(1, PERIOD_MS / 4);
+
+	spinners_run(2);
+
+	total = spins[0] + spins[1];
+	zassert_true(spins[0] > total / 4, "thread 0 starved (%u / %u)",
+		     spins[0], total);
+	zassert_true(spins[1] > total / 4, "thread 1 starved (%u / %u)",
+		     spins[1], total);
+}
+
+/**
+ * @brief Test that CPU time follows the reserved bandwidths
+ *
+ * A thread with a small budget keeps overrunning it, and its deadline
+ * keeps being postponed, so the thread with the larger budget must get
+ * most of the CPU.
+ */
+ZTEST(sched_deadline_cbs, test_bandwidth)
+{
+	spinner_create(0, PERIOD_MS / 10);
+	spinner_create(1, PERIOD_MS / 2);
+
+	spinners_run(2);
+
+	zassert_true(spins[1] > 2 * spins[0], "overrun not contained (%u vs %u)",
+		     spins[0], spins[1]);
+}
+
+/**
+ * @brief Test admission control
+ *
+ * Budgets are only granted while the total utilization stays within the
+ * bound, and released when removed or when the thread exits.
+ */
+ZTEST(sched_deadline_cbs, test_admission)
+{
+	uint32_t period = k_ms_to_cyc_ceil32(PERIOD_MS);
+	k_tid_t tids[NUM_THREADS];
+
+	for (int i = 0; i < NUM_THREADS; i++) {
+		tids[i] = k_thread_create(&threads[i], stacks[i], STACK_SIZE,
+					  spinner, (void *)&spins[i], NULL, NULL,
+					  SPIN_PRIO, 0, K_FOREVER);
+	}
+
+	zassert_equal(k_thread_deadline_budget_set(tids[0], period + 1, period),
+		      -EINVAL);
+	zassert_equal(k_thread_deadline_budget_set(tids[0], 1, 0), -EINVAL);
+
+	zassert_ok(k_thread_deadline_budget_set(tids[0], period / 2, period));
+	zassert_ok(k_thread_deadline_budget_set(tids[1], period / 4, period));
+	zassert_equal(k_thread_deadline_budget_set(tids[2], period / 2, period),
+		      -ENOSPC);
+
+	/* Shrinking a granted budget makes room */
+	zassert_ok(k_thread_deadline_budget_set(tids[0], period / 4, period));
+	zassert_ok(k_thread_deadline_budget_set(tids[2], period / 3, period));
+	zassert_equal(k_thread_deadline_budget_set(tids[0], period / 2, period),
+		      -ENOSPC);
+
+	/* So do removing one and exiting */
+	zassert_ok(k_thread_deadline_budget_set(tids[1], 0, 0));
+	k_thread_abort(tids[2]);
+	zassert_ok(k_thread_deadline_budget_set(tids[0], period, period));
+
+	k_thread_abort(tids[0]);
+	k_thread_abort(tids[1]);
+}
+
+/**
+ * @brief Budgets can be set from user mode
+ *
+ * The syscall checks the thread object like the other thread APIs do.
+ */
+ZTEST_USER(sched_deadline_cbs, test_user_budget)
+{
+	uint32_t period = k_ms_to_cyc_ceil32(PERIOD_MS);
+	k_tid_t self = k_current_get();
+
+	zassert_equal(k_thread_deadline_budget_set(self, period + 1, period), -EINVAL);
+	zassert_ok(k_thread_deadline_budget_set(self, period / 4, period));
+	zassert_ok(k_thread_deadline_budget_set(self, 0, 0));
+}
+
+ZTEST_SUITE(sched_deadline_cbs, NULL, NULL, NULL, NULL, NULL);
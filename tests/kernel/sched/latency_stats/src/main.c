@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define NUM_WAKEUPS  10
+#define STACK_SIZE   (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define WAITER_PRIO  K_PRIO_PREEMPT(0)
+
+static K_THREAD_STACK_DEFINE(waiter_stack, STACK_SIZE);
+static struct k_thread waiter_thread;
+static K_SEM_DEFINE(wakeup_sem, 0, 1);
+
+static void waiter(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < NUM_WAKEUPS; i++) {
+		k_sem_take(&wakeup_sem, K_FOREVER);
+	}
+}
+
+static uint32_t hist_sum(const struct k_sched_latency_stats *stats)
+{
+	uint32_t sum = 0U;
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(stats->hist); i++) {
+		sum += stats->hist[i];
+	}
+
+	return sum;
+}
+
+static int sched_obj_core_query(struct k_obj_core *obj_core, void *data)
+{
+	return k_obj_core_stats_query(obj_core, data,
+				      sizeof(struct k_sched_stats));
+}
+
+/**
+ * @brief Test the scheduling latency statistics
+ *
+ * Wake up a higher priority thread a number of times and check that each
+ * wakeup is accounted for the thread, its priority level and the run
+ * queue, and that the preemptions of the waking thread are counted.
+ */
+ZTEST(sched_latency_stats, test_wakeups)
+{
+	static struct k_sched_stats stats;
+	struct k_sched_latency_stats waiter_stats;
+	struct k_sched_latency_stats main_stats;
+	struct k_sched_latency_stats *prio;
+	struct k_obj_type *type;
+
+	/* Let the waiter preempt the test thread on every wakeup */
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(1));
+
+	k_sched_stats_reset();
+
+	/* The waiter runs right away, and then once per semaphore give */
+	k_thread_create(&waiter_thread, waiter_stack, STACK_SIZE, waiter,
+			NULL, NULL, NULL, WAITER_PRIO, 0, K_NO_WAIT);
+
+	for (int i = 0; i < NUM_WAKEUPS; i++) {
+		k_sem_give(&wakeup_sem);
+	}
+
+	k_thread_join(&waiter_thread, K_FOREVER);
+
+	zassert_ok(k_thread_sched_latency_get(&waiter_thread, &waiter_stats));
+	zassert_equal(waiter_stats.count, NUM_WAKEUPS + 1);
+	zassert_equal(hist_sum(&waiter_stats), waiter_stats.count);
+	zassert_true(waiter_stats.max <= waiter_stats.total);
+	zassert_true(waiter_stats.ready >= waiter_stats.total);
+
+	zassert_ok(k_thread_sched_latency_get(k_current_get(), &main_stats));
+	zassert_true(main_stats.preemptions >= NUM_WAKEUPS + 1);
+
+	zassert_ok(k_sched_stats_get(&stats));
+	prio = &stats.prio[WAITER_PRIO - K_HIGHEST_THREAD_PRIO];
+	zassert_true(prio->count >= NUM_WAKEUPS + 1);
+	zassert_equal(hist_sum(prio), prio->count);
+	zassert_true(stats.runq.switches >= 2 * (NUM_WAKEUPS + 1));
+	zassert_true(stats.runq.max_depth >= 2);
+
+	zassert_equal(k_thread_sched_latency_get(NULL, &waiter_stats), -EINVAL);
+	zassert_equal(k_sched_stats_get(NULL), -EINVAL);
+
+	/* The same statistics are reported through the object core */
+	type = k_obj_type_find(K_OBJ_TYPE_SCHED_ID);
+	zassert_not_null(type);
+	(void)memset(&stats, 0, sizeof(stats));
+	zassert_ok(k_obj_type_walk_unlocked(type, sched_obj_core_query, &stats));
+	prio = &stats.prio[WAITER_PRIO - K_HIGHEST_THREAD_PRIO];
+	zassert_true(prio->count >= NUM_WAKEUPS + 1);
+
+	k_sched_stats_reset();
+	zassert_ok(k_sched_stats_get(&stats));
+	prio = &stats.prio[WAITER_PRIO - K_HIGHEST_THREAD_PRIO];
+	zassert_equal(prio->count, 0);
+}
+
+ZTEST_SUITE(sched_latency_stats, NULL, NULL, NULL, NULL, NULL);
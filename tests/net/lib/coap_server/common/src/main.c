@@ -318,4 +318,66 @@ ZTEST(coap_service, test_COAP_RESOURCE_DEFINE)
 	}
 }
 
+static int observe_request(struct coap_packet *request, uint8_t *buf, size_t len,
+			   uint8_t token, uint32_t observe)
+{
+	int ret;
+
+	ret = coap_packet_init(request, buf, len, COAP_VERSION_1, COAP_TYPE_CON, 1, &token,
+			       COAP_METHOD_GET, coap_next_id());
+	if (ret < 0) {
+		return ret;
+	}
+
+	return coap_append_option_int(request, COAP_OPTION_OBSERVE, observe);
+}
+
+ZTEST(coap_service, test_coap_resource_observers)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(5683),
+		.sin_addr = { { { 192, 0, 2, 1 } } },
+	};
+	struct coap_packet request;
+	uint8_t buf[32];
+	uint8_t token;
+
+	zassert_equal(CONFIG_COAP_SERVICE_OBSERVERS, 3);
+
+	for (token = 1; token <= 3; token++) {
+		zassert_ok(observe_request(&request, buf, sizeof(buf), token, 0));
+		zassert_ok(coap_resource_parse_observe(&resource_2, &request,
+						       (struct sockaddr *)&addr));
+	}
+
+	/* A refresh does not take another observer */
+	zassert_ok(observe_request(&request, buf, sizeof(buf), 2, 0));
+	zassert_ok(coap_resource_parse_observe(&resource_2, &request, (struct sockaddr *)&addr));
+
+	zassert_ok(observe_request(&request, buf, sizeof(buf), 4, 0));
+	zassert_equal(coap_resource_parse_observe(&resource_2, &request,
+						  (struct sockaddr *)&addr), -ENOMEM);
+	zassert_equal(sys_slist_len(&resource_2.observers), 3);
+
+	/* Observers are only removed from their resource */
+	token = 2;
+	zassert_equal(coap_resource_remove_observer_by_token(&resource_3, &token, 1), -ENOENT);
+	zassert_ok(coap_resource_remove_observer_by_token(&resource_2, &token, 1));
+	zassert_equal(coap_resource_remove_observer_by_token(&resource_2, &token, 1), -ENOENT);
+
+	/* Deregistration */
+	zassert_ok(observe_request(&request, buf, sizeof(buf), 1, 1));
+	zassert_equal(coap_resource_parse_observe(&resource_2, &request,
+						  (struct sockaddr *)&addr), 1);
+
+	zassert_ok(coap_resource_remove_observer_by_addr(&resource_2, (struct sockaddr *)&addr));
+	zassert_true(sys_slist_is_empty(&resource_2.observers));
+
+	/* The observers are free again */
+	zassert_ok(observe_request(&request, buf, sizeof(buf), 4, 0));
+	zassert_ok(coap_resource_parse_observe(&resource_2, &request, (struct sockaddr *)&addr));
+	zassert_ok(coap_resource_remove_observer_by_addr(&resource_2, (struct sockaddr *)&addr));
+}
+
 ZTEST_SUITE(coap_service, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,516 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Confirmable messages of a service sent to a peer socket on the loopback
+ * interface: their acknowledgement, their retransmission on the timer wheel
+ * of the server, and the handlers of services run by different workers.
+ */
+
+#include <string.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/coap_service.h>
+
+#define PEER_PORT 5700
+#define PENDINGS  CONFIG_COAP_SERVICE_PENDING_MESSAGES
+#define TURN_MS   (CONFIG_COAP_SERVER_RETRANSMIT_SLOTS * CONFIG_COAP_SERVER_RETRANSMIT_TICK)
+
+/* Retransmissions are never early, at most a tick late */
+#define LATE_MS CONFIG_COAP_SERVER_RETRANSMIT_TICK
+#define WAIT_MS 1000
+
+static K_SEM_DEFINE(block_entered, 0, 1);
+static K_SEM_DEFINE(block_release, 0, 1);
+
+static int ping_get(struct coap_resource *resource, struct coap_packet *request,
+		    struct sockaddr *addr, socklen_t addr_len)
+{
+	ARG_UNUSED(resource);
+	ARG_UNUSED(request);
+	ARG_UNUSED(addr);
+	ARG_UNUSED(addr_len);
+
+	return COAP_RESPONSE_CODE_CONTENT;
+}
+
+/* Holds the worker of its service until the test releases it */
+static int block_get(struct coap_resource *resource, struct coap_packet *request,
+		     struct sockaddr *addr, socklen_t addr_len)
+{
+	ARG_UNUSED(resource);
+	ARG_UNUSED(request);
+	ARG_UNUSED(addr);
+	ARG_UNUSED(addr_len);
+
+	k_sem_give(&block_entered);
+	(void)k_sem_take(&block_release, K_MSEC(WAIT_MS));
+
+	return COAP_RESPONSE_CODE_CONTENT;
+}
+
+/* In the order of their section, so run by the first and the second worker */
+static const uint16_t service_a_port = 5683;
+COAP_SERVICE_DEFINE(service_a, "127.0.0.1", &service_a_port, COAP_SERVICE_AUTOSTART);
+
+static const char * const resource_a_path[] = { "ping", NULL };
+COAP_RESOURCE_DEFINE(resource_a, service_a, {
+	.path = resource_a_path,
+	.get = ping_get,
+});
+
+static const uint16_t service_b_port = 5684;
+COAP_SERVICE_DEFINE(service_b, "127.0.0.1", &service_b_port, COAP_SERVICE_AUTOSTART);
+
+static const char * const resource_b_path[] = { "block", NULL };
+COAP_RESOURCE_DEFINE(resource_b, service_b, {
+	.path = resource_b_path,
+	.get = block_get,
+});
+
+struct message {
+	uint16_t id;
+	uint8_t type;
+	uint8_t code;
+	int32_t time;
+};
+
+static int peer = -1;
+
+/* Time the messages of a test are sent from */
+static int64_t start;
+
+static struct sockaddr_in loopback_addr(uint16_t port)
+{
+	return (struct sockaddr_in){
+		.sin_family = AF_INET,
+		.sin_port = htons(port),
+		.sin_addr = INADDR_LOOPBACK_INIT,
+	};
+}
+
+/* Confirmable message from service_a to the peer */
+static void send_con(uint16_t id, uint32_t ack_timeout, uint16_t backoff_percent,
+		     uint8_t retransmissions)
+{
+	const struct coap_transmission_parameters params = {
+		.ack_timeout = ack_timeout,
+		.coap_backoff_percent = backoff_percent,
+		.max_retransmission = retransmissions,
+	};
+	struct sockaddr_in addr = loopback_addr(PEER_PORT);
+	uint8_t buf[COAP_TOKEN_MAX_LEN + 4U];
+	struct coap_packet cpkt;
+	uint8_t token = (uint8_t)id;
+
+	zassert_ok(coap_packet_init(&cpkt, buf, sizeof(buf), COAP_VERSION_1, COAP_TYPE_CON,
+				    sizeof(token), &token, COAP_RESPONSE_CODE_CONTENT, id));
+	zassert_ok(coap_service_send(&service_a, &cpkt, (struct sockaddr *)&addr, sizeof(addr),
+				     &params));
+}
+
+static void peer_send(uint16_t port, const struct coap_packet *cpkt)
+{
+	struct sockaddr_in addr = loopback_addr(port);
+
+	zassert_equal(zsock_sendto(peer, cpkt->data, cpkt->offset, 0, (struct sockaddr *)&addr,
+				   sizeof(addr)),
+		      cpkt->offset, "Peer cannot send (%d)", errno);
+}
+
+/* Empty ACK or RST of the message id */
+static void peer_reply(uint16_t port, uint8_t type, uint16_t id)
+{
+	uint8_t buf[4];
+	struct coap_packet cpkt;
+
+	zassert_ok(coap_packet_init(&cpkt, buf, sizeof(buf), COAP_VERSION_1, type, 0, NULL,
+				    COAP_CODE_EMPTY, id));
+	peer_send(port, &cpkt);
+}
+
+static void peer_request(uint16_t port, const char *path, uint16_t id)
+{
+	uint8_t buf[32];
+	struct coap_packet cpkt;
+	uint8_t token = (uint8_t)id;
+
+	zassert_ok(coap_packet_init(&cpkt, buf, sizeof(buf), COAP_VERSION_1, COAP_TYPE_CON,
+				    sizeof(token), &token, COAP_METHOD_GET, id));
+	zassert_ok(coap_packet_append_option(&cpkt, COAP_OPTION_URI_PATH,
+					     (const uint8_t *)path, strlen(path)));
+	peer_send(port, &cpkt);
+}
+
+/* Next message received by the peer, -EAGAIN if none within timeout_ms */
+static int peer_recv(struct message *msg, int timeout_ms)
+{
+	struct zsock_pollfd pfd = {
+		.fd = peer,
+		.events = ZSOCK_POLLIN,
+	};
+	uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	struct coap_packet cpkt;
+	ssize_t len;
+	int ret;
+
+	ret = zsock_poll(&pfd, 1, MAX(timeout_ms, 0));
+	if (ret < 0) {
+		return -errno;
+	}
+
+	if (ret == 0) {
+		return -EAGAIN;
+	}
+
+	len = zsock_recv(peer, buf, sizeof(buf), 0);
+	if (len < 0) {
+		return -errno;
+	}
+
+	msg->time = (int32_t)(k_uptime_get() - start);
+
+	ret = coap_packet_parse(&cpkt, buf, len, NULL, 0);
+	if (ret < 0) {
+		return ret;
+	}
+
+	msg->id = coap_header_get_id(&cpkt);
+	msg->type = coap_header_get_type(&cpkt);
+	msg->code = coap_header_get_code(&cpkt);
+
+	return 0;
+}
+
+/* The next message is a transmission of the confirmable message id, sent
+ * at_ms after the start of the test.
+ */
+static void expect_con(uint16_t id, int32_t at_ms)
+{
+	struct message msg;
+
+	zassert_ok(peer_recv(&msg, at_ms + LATE_MS - (int32_t)(k_uptime_get() - start)),
+		   "Message %u not sent at %d ms", id, at_ms);
+	zassert_equal(msg.type, COAP_TYPE_CON, "Type %u of message %u", msg.type, msg.id);
+	zassert_equal(msg.id, id, "Message %u sent instead of %u", msg.id, id);
+	zassert_true(msg.time >= at_ms, "Message %u sent at %d ms, before %d ms", id,
+		     msg.time, at_ms);
+	zassert_true(msg.time <= at_ms + LATE_MS, "Message %u sent at %d ms, after %d ms", id,
+		     msg.time, at_ms);
+}
+
+static void expect_ack(uint16_t id, uint8_t code)
+{
+	struct message msg;
+
+	zassert_ok(peer_recv(&msg, WAIT_MS), "No response to %u", id);
+	zassert_equal(msg.type, COAP_TYPE_ACK, "Type %u of message %u", msg.type, msg.id);
+	zassert_equal(msg.id, id, "Response to %u instead of %u", msg.id, id);
+	zassert_equal(msg.code, code, "Response code %u to %u", msg.code, id);
+}
+
+static void expect_silence(int timeout_ms)
+{
+	struct message msg = { 0 };
+	int ret;
+
+	ret = peer_recv(&msg, timeout_ms);
+	zassert_equal(ret, -EAGAIN, "Message %u received at %d ms (%d)", msg.id, msg.time, ret);
+}
+
+/* The test thread only reads the pending messages while the server does not
+ * run, the thread being cooperative.
+ */
+static bool is_pending(uint16_t id)
+{
+	const struct coap_pending *pending = service_a.data->pending;
+
+	for (size_t i = 0; i < PENDINGS; i++) {
+		if (pending[i].timeout != 0 && pending[i].id == id) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static size_t pending_count(void)
+{
+	return coap_pendings_count(service_a.data->pending, PENDINGS);
+}
+
+static void wait_cleared(uint16_t id)
+{
+	zassert_true(WAIT_FOR(!is_pending(id), WAIT_MS * USEC_PER_MSEC, k_msleep(1)),
+		     "Message %u still pending", id);
+}
+
+static void observe(void)
+{
+	struct sockaddr_in addr = loopback_addr(PEER_PORT);
+	uint8_t buf[16];
+	struct coap_packet request;
+	uint8_t token = 0x42;
+
+	zassert_ok(coap_packet_init(&request, buf, sizeof(buf), COAP_VERSION_1, COAP_TYPE_CON,
+				    sizeof(token), &token, COAP_METHOD_GET, coap_next_id()));
+	zassert_ok(coap_append_option_int(&request, COAP_OPTION_OBSERVE, 0));
+	zassert_ok(coap_resource_parse_observe(&resource_a, &request, (struct sockaddr *)&addr));
+}
+
+ZTEST(coap_server_loopback, test_ack_clears_pending)
+{
+	uint16_t id = coap_next_id();
+
+	send_con(id, 100, 100, 4);
+	expect_con(id, 0);
+
+	/* Not the ID of the pending message */
+	peer_reply(service_a_port, COAP_TYPE_ACK, id + 1);
+	k_msleep(10);
+	zassert_true(is_pending(id), "Cleared by the ACK of another message");
+
+	peer_reply(service_a_port, COAP_TYPE_ACK, id);
+	wait_cleared(id);
+
+	/* Past all the retransmissions */
+	expect_silence(5 * 100 + LATE_MS);
+}
+
+ZTEST(coap_server_loopback, test_ack_rst_same_index)
+{
+	uint16_t id = coap_next_id();
+	/* All in the same bucket of the message ID index */
+	uint16_t ids[] = { id, id + PENDINGS, id + 2 * PENDINGS };
+
+	for (size_t i = 0; i < ARRAY_SIZE(ids); i++) {
+		send_con(ids[i], 500, 100, 2);
+		expect_con(ids[i], 0);
+	}
+
+	peer_reply(service_a_port, COAP_TYPE_ACK, ids[1]);
+	wait_cleared(ids[1]);
+	zassert_true(is_pending(ids[0]) && is_pending(ids[2]), "Other message cleared by ACK");
+
+	peer_reply(service_a_port, COAP_TYPE_RESET, ids[2]);
+	wait_cleared(ids[2]);
+	zassert_true(is_pending(ids[0]), "Other message cleared by RST");
+
+	peer_reply(service_a_port, COAP_TYPE_ACK, ids[0]);
+	wait_cleared(ids[0]);
+	zassert_equal(pending_count(), 0);
+
+	expect_silence(500 + LATE_MS);
+}
+
+ZTEST(coap_server_loopback, test_rst_removes_observer)
+{
+	uint16_t id = coap_next_id();
+
+	observe();
+
+	send_con(id, 500, 100, 2);
+	expect_con(id, 0);
+
+	peer_reply(service_a_port, COAP_TYPE_RESET, id);
+	wait_cleared(id);
+	zassert_true(sys_slist_is_empty(&resource_a.observers), "Observer not removed by RST");
+
+	expect_silence(500 + LATE_MS);
+}
+
+ZTEST(coap_server_loopback, test_retransmit_timeout)
+{
+	/* Timeout doubled on each retransmission */
+	static const int32_t at_ms[] = { 0, 50, 150, 350 };
+	uint16_t id = coap_next_id();
+	int32_t elapsed;
+
+	observe();
+
+	send_con(id, 50, 200, ARRAY_SIZE(at_ms) - 1);
+
+	for (size_t i = 0; i < ARRAY_SIZE(at_ms); i++) {
+		expect_con(id, at_ms[i]);
+	}
+
+	/* Given up once the last retransmission timed out */
+	wait_cleared(id);
+	elapsed = (int32_t)(k_uptime_get() - start);
+	zassert_true(elapsed >= 750, "Given up at %d ms", elapsed);
+	zassert_true(sys_slist_is_empty(&resource_a.observers), "Observer not removed on timeout");
+
+	expect_silence(100);
+}
+
+ZTEST(coap_server_loopback, test_retransmit_order)
+{
+	uint16_t id = coap_next_id();
+
+	/* Sent in another order than they expire */
+	send_con(id, 120, 100, 1);
+	send_con(id + 1, 40, 100, 1);
+	send_con(id + 2, 80, 100, 1);
+
+	expect_con(id, 0);
+	expect_con(id + 1, 0);
+	expect_con(id + 2, 0);
+
+	expect_con(id + 1, 40);
+	expect_con(id + 2, 80);
+	expect_con(id, 120);
+
+	/* The last retransmissions time out without anything sent */
+	zassert_true(WAIT_FOR(pending_count() == 0, WAIT_MS * USEC_PER_MSEC, k_msleep(1)));
+	expect_silence(0);
+}
+
+ZTEST(coap_server_loopback, test_retransmit_turns)
+{
+	uint16_t id = coap_next_id();
+
+	/* Within the first turn of the wheel, more than three turns away and
+	 * exactly four turns away, in the slot of the current tick.
+	 */
+	send_con(id, TURN_MS / 2, 100, 1);
+	send_con(id + 1, 3 * TURN_MS + TURN_MS / 4, 100, 1);
+	send_con(id + 2, 4 * TURN_MS, 100, 1);
+
+	expect_con(id, 0);
+	expect_con(id + 1, 0);
+	expect_con(id + 2, 0);
+
+	/* The later ones are not sent when their slot comes in earlier turns */
+	expect_con(id, TURN_MS / 2);
+	expect_con(id + 1, 3 * TURN_MS + TURN_MS / 4);
+	expect_con(id + 2, 4 * TURN_MS);
+}
+
+ZTEST(coap_server_loopback, test_retransmit_stalled)
+{
+	uint16_t ids[] = { coap_next_id(), coap_next_id(), coap_next_id() };
+	int32_t stall_ms = 2 * TURN_MS + TURN_MS / 2;
+	struct message msg;
+	bool sent[2] = { false, false };
+	size_t i;
+
+	send_con(ids[0], TURN_MS / 2, 100, 1);
+	send_con(ids[1], TURN_MS, 100, 1);
+	send_con(ids[2], 4 * TURN_MS, 100, 1);
+
+	for (i = 0; i < ARRAY_SIZE(ids); i++) {
+		expect_con(ids[i], 0);
+	}
+
+	/* The server does not run for several turns of the wheel */
+	k_sched_lock();
+	k_busy_wait((uint32_t)(stall_ms - (k_uptime_get() - start)) * USEC_PER_MSEC);
+	k_sched_unlock();
+
+	/* Those expired meanwhile are sent at once, in any order */
+	while (!sent[0] || !sent[1]) {
+		zassert_ok(peer_recv(&msg, LATE_MS), "Expired message not sent");
+		zassert_equal(msg.type, COAP_TYPE_CON, "Type %u of message %u", msg.type, msg.id);
+
+		i = msg.id == ids[0] ? 0 : 1;
+		zassert_true(msg.id == ids[i] && i < ARRAY_SIZE(sent), "Message %u sent", msg.id);
+		zassert_false(sent[i], "Message %u sent twice", msg.id);
+		zassert_true(msg.time <= stall_ms + LATE_MS, "Message %u sent at %d ms", msg.id,
+			     msg.time);
+		sent[i] = true;
+	}
+
+	/* The other one still on time */
+	expect_con(ids[2], 4 * TURN_MS);
+}
+
+ZTEST(coap_server_loopback, test_workers_handlers)
+{
+	uint16_t id = coap_next_id();
+
+	if (CONFIG_COAP_SERVER_WORKERS < 2) {
+		ztest_test_skip();
+	}
+
+	send_con(id, 500, 100, 2);
+	expect_con(id, 0);
+
+	/* The handler of service_b holds its worker */
+	peer_request(service_b_port, "block", id + 1);
+	zassert_ok(k_sem_take(&block_entered, K_MSEC(WAIT_MS)), "Handler not called");
+
+	/* Meanwhile the worker of service_a answers requests and ACKs */
+	peer_request(service_a_port, "ping", id + 2);
+	expect_ack(id + 2, COAP_RESPONSE_CODE_CONTENT);
+
+	peer_reply(service_a_port, COAP_TYPE_ACK, id);
+	wait_cleared(id);
+
+	k_sem_give(&block_release);
+	expect_ack(id + 1, COAP_RESPONSE_CODE_CONTENT);
+}
+
+static void *loopback_setup(void)
+{
+	struct sockaddr_in addr = loopback_addr(PEER_PORT);
+
+	peer = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(peer >= 0, "Cannot create peer socket (%d)", errno);
+	zassert_ok(zsock_bind(peer, (struct sockaddr *)&addr, sizeof(addr)),
+		   "Cannot bind peer socket (%d)", errno);
+
+	/* The services are started by the server thread */
+	zassert_true(WAIT_FOR(coap_service_is_running(&service_a) == 1 &&
+			      coap_service_is_running(&service_b) == 1,
+			      WAIT_MS * USEC_PER_MSEC, k_msleep(1)),
+		     "Services not started");
+
+	return NULL;
+}
+
+static void loopback_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	start = k_uptime_get();
+}
+
+static void loopback_after(void *fixture)
+{
+	const struct coap_pending *pending = service_a.data->pending;
+	struct sockaddr_in addr = loopback_addr(PEER_PORT);
+	struct message msg;
+
+	ARG_UNUSED(fixture);
+
+	k_sem_give(&block_release);
+
+	for (size_t i = 0; i < PENDINGS; i++) {
+		if (pending[i].timeout != 0) {
+			peer_reply(service_a_port, COAP_TYPE_ACK, pending[i].id);
+		}
+	}
+
+	zassert_true(WAIT_FOR(pending_count() == 0, WAIT_MS * USEC_PER_MSEC, k_msleep(1)));
+	(void)coap_resource_remove_observer_by_addr(&resource_a, (struct sockaddr *)&addr);
+
+	while (peer_recv(&msg, 10) != -EAGAIN) {
+	}
+
+	k_sem_reset(&block_entered);
+	k_sem_reset(&block_release);
+}
+
+static void loopback_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	zsock_close(peer);
+}
+
+ZTEST_SUITE(coap_server_loopback, NULL, loopback_setup, loopback_before, loopback_after,
+	    loopback_teardown);
@@ -9,12 +9,30 @@
 
 #define TEST_DNS_CACHE_SIZE        12
 #define TEST_DNS_CACHE_DEFAULT_TTL 1
-DNS_CACHE_DEFINE(test_dns_cache, TEST_DNS_CACHE_SIZE);
+
+static char prefetched_query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
+static int prefetch_count;
+static int prefetch_ret;
+
+static int test_prefetch(const char *query, enum dns_query_type type)
+{
+	ARG_UNUSED(type);
+
+	strncpy(prefetched_query, query, sizeof(prefetched_query) - 1);
+	prefetch_count++;
+
+	return prefetch_ret;
+}
+
+DNS_CACHE_DEFINE_PREFETCH(test_dns_cache, TEST_DNS_CACHE_SIZE, test_prefetch);
 
 void clear_cache(void *fixture)
 {
 	ARG_UNUSED(fixture);
 	dns_cache_flush(&test_dns_cache);
+	prefetched_query[0] = '\0';
+	prefetch_count = 0;
+	prefetch_ret = 0;
 }
 
 ZTEST_SUITE(net_dns_cache_test, NULL, NULL, clear_cache, NULL, NULL);
@@ -174,3 +192,155 @@ ZTEST(net_dns_cache_test, test_only_expected_type_returned)
 	zassert_equal(1, dns_cache_find(&test_dns_cache, query, query_type_b, &info_read, 1));
 	zassert_equal(AF_INET6, info_read.ai_family);
 }
+
+ZTEST(net_dns_cache_test, test_least_recently_used_removed)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	struct dns_resolve_cache_stats before, after;
+	enum dns_query_type query_type = DNS_QUERY_TYPE_A;
+	char query[sizeof("host00.example.com")];
+
+	for (size_t i = 0; i < TEST_DNS_CACHE_SIZE; i++) {
+		snprintk(query, sizeof(query), "host%02zu.example.com", i);
+		zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write,
+					 TEST_DNS_CACHE_DEFAULT_TTL),
+			   "Cache entry adding should work.");
+	}
+
+	/* The first one added is used again, the second one gets replaced */
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "host00.example.com", query_type,
+					&info_read, 1));
+	zassert_ok(dns_cache_stats_get(&test_dns_cache, &before));
+	zassert_ok(dns_cache_add(&test_dns_cache, "example.com", &info_write,
+				 TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_ok(dns_cache_stats_get(&test_dns_cache, &after));
+	zassert_equal(before.evictions + 1, after.evictions);
+	zassert_equal(TEST_DNS_CACHE_SIZE, after.entries);
+
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "host00.example.com", query_type,
+					&info_read, 1));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, "host01.example.com", query_type,
+					&info_read, 1));
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "example.com", query_type,
+					&info_read, 1));
+}
+
+ZTEST(net_dns_cache_test, test_negative_entry)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	struct dns_resolve_cache_stats before, after;
+	const char *query = "example.com";
+
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, DNS_QUERY_TYPE_A,
+					  DNS_EAI_NONAME, TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Negative cache entry adding should work.");
+	zassert_ok(dns_cache_stats_get(&test_dns_cache, &before));
+	zassert_equal(DNS_EAI_NONAME, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_A,
+						     &info_read, 1));
+	zassert_equal(0, info_read.ai_family);
+	zassert_equal(0, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_AAAA,
+					&info_read, 1));
+	zassert_ok(dns_cache_stats_get(&test_dns_cache, &after));
+	zassert_equal(before.negative_hits + 1, after.negative_hits);
+	zassert_equal(before.misses + 1, after.misses);
+
+	/* An address replaces the negative answer */
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_equal(1, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_A, &info_read, 1));
+	zassert_equal(AF_INET, info_read.ai_family);
+
+	/* And the other way round */
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, DNS_QUERY_TYPE_A,
+					  DNS_EAI_NODATA, TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Negative cache entry adding should work.");
+	zassert_equal(DNS_EAI_NODATA, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_A,
+						     &info_read, 1));
+
+	k_sleep(K_MSEC(TEST_DNS_CACHE_DEFAULT_TTL * 1000 + 1));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_A, &info_read, 1));
+}
+
+ZTEST(net_dns_cache_test, test_negative_entry_invalid)
+{
+	const char *query = "example.com";
+
+	zassert_equal(-EINVAL, dns_cache_add_negative(&test_dns_cache, query, DNS_QUERY_TYPE_A,
+						      DNS_EAI_FAIL, TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_equal(-EINVAL, dns_cache_add_negative(&test_dns_cache, query, DNS_QUERY_TYPE_A,
+						      DNS_EAI_NONAME, 0));
+}
+
+ZTEST(net_dns_cache_test, test_popular_entry_prefetched)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read[2] = {0};
+	const char *query = "example.com";
+	enum dns_query_type query_type = DNS_QUERY_TYPE_A;
+	uint32_t ttl = TEST_DNS_CACHE_DEFAULT_TTL * 2;
+
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, ttl),
+		   "Cache entry adding should work.");
+
+	for (int i = 0; i < CONFIG_DNS_RESOLVER_CACHE_PREFETCH_HITS; i++) {
+		zassert_equal(1, dns_cache_find(&test_dns_cache, query, query_type, info_read, 2));
+	}
+	zassert_equal(0, prefetch_count, "Entry refreshed too early");
+
+	/* Less than CONFIG_DNS_RESOLVER_CACHE_PREFETCH_PERCENT of the TTL left */
+	k_sleep(K_MSEC(ttl * 10 * (100 - CONFIG_DNS_RESOLVER_CACHE_PREFETCH_PERCENT) + 100));
+	zassert_equal(1, dns_cache_find(&test_dns_cache, query, query_type, info_read, 2));
+	zassert_equal(1, prefetch_count, "Entry not refreshed");
+	zassert_str_equal(query, prefetched_query);
+
+	/* Refreshed only once */
+	zassert_equal(1, dns_cache_find(&test_dns_cache, query, query_type, info_read, 2));
+	zassert_equal(1, prefetch_count);
+
+	/* The answer of the refresh replaces the entry */
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, ttl),
+		   "Cache entry adding should work.");
+	zassert_equal(1, dns_cache_find(&test_dns_cache, query, query_type, info_read, 2));
+}
+
+ZTEST(net_dns_cache_test, test_prefetch_not_started)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read[2] = {0};
+	struct dns_resolve_cache_stats before, after;
+	const char *query = "example.com";
+	enum dns_query_type query_type = DNS_QUERY_TYPE_A;
+	uint32_t ttl = TEST_DNS_CACHE_DEFAULT_TTL * 2;
+
+	zassert_ok(dns_cache_stats_get(&test_dns_cache, &before));
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, ttl),
+		   "Cache entry adding should work.");
+
+	for (int i = 0; i < CONFIG_DNS_RESOLVER_CACHE_PREFETCH_HITS; i++) {
+		zassert_equal(1, dns_cache_find(&test_dns_cache, query, query_type, info_read, 2));
+	}
+
+	k_sleep(K_MSEC(ttl * 10 * (100 - CONFIG_DNS_RESOLVER_CACHE_PREFETCH_PERCENT) + 100));
+
+	/* No room for the refresh, it is not counted */
+	prefetch_ret = -EBUSY;
+	zassert_equal(1, dns_cache_find(&test_dns_cache, query, query_type, info_read, 2));
+	zassert_equal(1, prefetch_count, "Entry not refreshed");
+	zassert_ok(dns_cache_stats_get(&test_dns_cache, &after));
+	zassert_equal(before.prefetches, after.prefetches, "Refresh not started but counted");
+
+	/* Tried again on the next find */
+	prefetch_ret = 0;
+	zassert_equal(1, dns_cache_find(&test_dns_cache, query, query_type, info_read, 2));
+	zassert_equal(2, prefetch_count, "Entry not refreshed again");
+	zassert_ok(dns_cache_stats_get(&test_dns_cache, &after));
+	zassert_equal(before.prefetches + 1, after.prefetches);
+
+	/* A refresh which failed once started is tried again as well */
+	dns_cache_prefetch_done(&test_dns_cache, query, query_type);
+	zassert_equal(1, dns_cache_find(&test_dns_cache, query, query_type, info_read, 2));
+	zassert_equal(3, prefetch_count, "Entry not refreshed after failure");
+}
@@ -955,6 +955,50 @@ ZTEST(net_content_senml_cbor_nomem, test_put_time_nomem)
 	zassert_equal(ret, -ENOMEM, "Invalid error code returned");
 }
 
+ZTEST(net_content_senml_cbor, test_send_direct)
+{
+	struct lwm2m_obj_path_list path_list_buf[TEST_OBJ_RES_MAX_ID];
+	uint8_t expected[sizeof(test_msg.msg_data)];
+	sys_slist_t path_list;
+	sys_slist_t free_list;
+	uint16_t expected_len;
+	int ret;
+
+	test_s8 = INT8_MIN;
+	test_s16 = INT16_MAX;
+	test_s32 = INT32_MIN;
+	test_s64 = INT64_MAX;
+	strcpy(test_string, "test_string");
+	test_float = 0.5;
+	test_bool = true;
+	test_objlnk = (struct lwm2m_objlnk){ .obj_id = 1, .obj_inst = 2 };
+	memset(test_opaque, 0xa5, sizeof(test_opaque));
+	test_time = 1170111600;
+
+	lwm2m_engine_path_list_init(&path_list, &free_list, path_list_buf,
+				    ARRAY_SIZE(path_list_buf));
+
+	for (int i = 0; i < TEST_OBJ_RES_MAX_ID; i++) {
+		ret = lwm2m_engine_add_path_to_list(&path_list, &free_list,
+						    &LWM2M_OBJ(TEST_OBJ_ID, TEST_OBJ_INST_ID, i));
+		zassert_equal(ret, 0, "Cannot add path");
+	}
+
+	/* Same payload as the one of the writer */
+	ret = do_send_op_senml_cbor(&test_msg, &path_list);
+	zassert_equal(ret, 0, "Error reported");
+
+	memcpy(expected, test_msg.msg_data, test_msg.cpkt.offset);
+	expected_len = test_msg.cpkt.offset;
+
+	context_reset();
+
+	ret = do_send_op_senml_cbor_direct(&test_msg, &path_list);
+	zassert_equal(ret, 0, "Error reported");
+	zassert_equal(test_msg.cpkt.offset, expected_len, "Invalid packet offset");
+	zassert_mem_equal(test_msg.msg_data, expected, expected_len, "Invalid payload format");
+}
+
 ZTEST(net_content_senml_cbor, test_get_s32)
 {
 	int ret;
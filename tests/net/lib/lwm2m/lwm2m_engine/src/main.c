@@ -257,6 +257,127 @@ ZTEST(lwm2m_engine, test_check_notifications)
 		      "Next observe event not scheduled");
 }
 
+/* Observation whose pmax expires while a change waits to be coalesced */
+static struct observe_node pmax_obs;
+
+static bool between_periods_custom_fake(struct observe_node *obs, uint16_t srv_obj_inst,
+					const int64_t timestamp)
+{
+	ARG_UNUSED(srv_obj_inst);
+
+	/* pmin of 0 */
+	return obs != &pmax_obs || timestamp < pmax_obs.event_timestamp;
+}
+
+static int generate_notify_message_custom_fake(struct lwm2m_ctx *ctx, struct observe_node *obs,
+					       void *user_data)
+{
+	ARG_UNUSED(ctx);
+	ARG_UNUSED(user_data);
+
+	obs->resource_update = false;
+
+	return 0;
+}
+
+ZTEST(lwm2m_engine, test_check_notifications_pmax_in_coalesce_window)
+{
+	int ret;
+	struct lwm2m_ctx ctx;
+	struct observe_node obs;
+	int64_t now = k_uptime_get();
+
+	(void)memset(&ctx, 0x0, sizeof(ctx));
+	(void)memset(&pmax_obs, 0x0, sizeof(pmax_obs));
+	(void)memset(&obs, 0x0, sizeof(obs));
+
+	ctx.sock_fd = -1;
+	ctx.load_credentials = NULL;
+	ctx.remote_addr.sa_family = AF_INET;
+	sys_slist_init(&ctx.observer);
+
+	/* Changed, with its pmax expiring before the coalescing window ends */
+	pmax_obs.last_timestamp = now;
+	pmax_obs.event_timestamp = now + 500U;
+	pmax_obs.resource_update = true;
+
+	/* Changed, waiting for the end of the window */
+	obs.last_timestamp = now;
+	obs.event_timestamp = now + 1500U;
+	obs.resource_update = true;
+
+	sys_slist_append(&ctx.observer, &pmax_obs.node);
+	sys_slist_append(&ctx.observer, &obs.node);
+
+	engine_observe_between_periods_fake.custom_fake = between_periods_custom_fake;
+	generate_notify_message_fake.custom_fake = generate_notify_message_custom_fake;
+	lwm2m_rd_client_is_registred_fake.return_val = true;
+
+	ret = lwm2m_engine_start(&ctx);
+	zassert_equal(ret, 0);
+
+	/* The observation due to pmax gets a notification of its own */
+	k_sleep(K_MSEC(1000));
+	zassert_equal(generate_notify_message_fake.call_count, 1, "Notify message not generated");
+	zassert_equal_ptr(generate_notify_message_fake.arg1_val, &pmax_obs);
+	zassert_true(obs.resource_update, "Change notified before the end of the window");
+
+	/* The other change is notified at the end of the window, alone */
+	k_sleep(K_MSEC(1000));
+	ret = lwm2m_engine_stop(&ctx);
+	zassert_equal(ret, 0);
+	zassert_equal(generate_notify_message_fake.call_count, 2, "Change not notified");
+	zassert_equal_ptr(generate_notify_message_fake.arg1_history[1], &obs);
+	zassert_false(obs.resource_update);
+}
+
+ZTEST(lwm2m_engine, test_check_notifications_coalesced_on_own_token)
+{
+	int ret;
+	struct lwm2m_ctx ctx;
+	struct observe_node obs[2];
+	int64_t now = k_uptime_get();
+
+	(void)memset(&ctx, 0x0, sizeof(ctx));
+	(void)memset(&pmax_obs, 0x0, sizeof(pmax_obs));
+	(void)memset(obs, 0x0, sizeof(obs));
+
+	ctx.sock_fd = -1;
+	ctx.load_credentials = NULL;
+	ctx.remote_addr.sa_family = AF_INET;
+	sys_slist_init(&ctx.observer);
+
+	/* One change due soon, the other one only at the end of its window */
+	obs[0].last_timestamp = now;
+	obs[0].event_timestamp = now + 500U;
+	obs[0].resource_update = true;
+	obs[1].last_timestamp = now;
+	obs[1].event_timestamp = now + 5000U;
+	obs[1].resource_update = true;
+
+	sys_slist_append(&ctx.observer, &obs[0].node);
+	sys_slist_append(&ctx.observer, &obs[1].node);
+
+	engine_observe_between_periods_fake.custom_fake = between_periods_custom_fake;
+	generate_notify_message_fake.custom_fake = generate_notify_message_custom_fake;
+	lwm2m_rd_client_is_registred_fake.return_val = true;
+
+	ret = lwm2m_engine_start(&ctx);
+	zassert_equal(ret, 0);
+	k_sleep(K_MSEC(1000));
+	ret = lwm2m_engine_stop(&ctx);
+	zassert_equal(ret, 0);
+
+	/* Both are notified together, each one on its own observation */
+	zassert_equal(generate_notify_message_fake.call_count, 2, "Changes not coalesced");
+	zassert_equal_ptr(generate_notify_message_fake.arg1_history[0], &obs[0]);
+	zassert_equal_ptr(generate_notify_message_fake.arg1_history[1], &obs[1]);
+	zassert_false(obs[0].resource_update);
+	zassert_false(obs[1].resource_update);
+	zassert_equal(engine_observe_shedule_next_event_fake.call_count, 2,
+		      "Next observe events not scheduled");
+}
+
 ZTEST(lwm2m_engine, test_push_queued_buffers)
 {
 	int ret;
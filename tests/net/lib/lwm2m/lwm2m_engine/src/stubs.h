@@ -38,6 +38,8 @@ DECLARE_FAKE_VALUE_FUNC(int, generate_notify_message, struct lwm2m_ctx *, struct
 			void *);
 DECLARE_FAKE_VALUE_FUNC(int64_t, engine_observe_shedule_next_event, struct observe_node *, uint16_t,
 			const int64_t);
+DECLARE_FAKE_VALUE_FUNC(bool, engine_observe_between_periods, struct observe_node *, uint16_t,
+			const int64_t);
 DECLARE_FAKE_VALUE_FUNC(int, handle_request, struct coap_packet *, struct lwm2m_message *);
 DECLARE_FAKE_VOID_FUNC(lwm2m_udp_receive, struct lwm2m_ctx *, uint8_t *, uint16_t,
 		       struct sockaddr *);
@@ -74,6 +76,7 @@ DECLARE_FAKE_VALUE_FUNC(bool, coap_block_has_more, struct coap_packet *);
 		FUNC(coap_pending_cycle)                                                           \
 		FUNC(generate_notify_message)                                                      \
 		FUNC(engine_observe_shedule_next_event)                                            \
+		FUNC(engine_observe_between_periods)                                               \
 		FUNC(handle_request)                                                               \
 		FUNC(lwm2m_udp_receive)                                                            \
 		FUNC(lwm2m_rd_client_is_registred)                                                 \
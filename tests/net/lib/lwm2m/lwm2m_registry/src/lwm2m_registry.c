@@ -458,6 +458,50 @@ ZTEST(lwm2m_registry, test_next_engine_obj_inst)
 	zassert_is_null(lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3303, 1)));
 }
 
+ZTEST(lwm2m_registry, test_obj_inst_index)
+{
+	static const uint16_t ids[] = { 3, 0, 1 };
+	struct lwm2m_engine_obj_inst *oi;
+	struct lwm2m_engine_res *res;
+
+	/* Created out of order, with a gap */
+	ARRAY_FOR_EACH(ids, i) {
+		zassert_equal(lwm2m_create_object_inst(&LWM2M_OBJ(3303, ids[i])), 0);
+	}
+
+	ARRAY_FOR_EACH(ids, i) {
+		oi = lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3303, ids[i]));
+		zassert_not_null(oi);
+		zassert_equal(oi->obj_inst_id, ids[i]);
+	}
+
+	zassert_is_null(lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3303, 2)));
+	zassert_equal(next_engine_obj_inst(3303, 0)->obj_inst_id, 1);
+	zassert_equal(next_engine_obj_inst(3303, 1)->obj_inst_id, 3);
+
+	zassert_equal(lwm2m_delete_object_inst(&LWM2M_OBJ(3303, 1)), 0);
+	zassert_is_null(lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3303, 1)));
+	zassert_equal(next_engine_obj_inst(3303, 0)->obj_inst_id, 3);
+
+	zassert_equal(lwm2m_delete_object_inst(&LWM2M_OBJ(3303, 0)), 0);
+	zassert_equal(lwm2m_delete_object_inst(&LWM2M_OBJ(3303, 3)), 0);
+	zassert_is_null(lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3303, 3)));
+
+	/* Resources of the test object are not sorted by id */
+	oi = lwm2m_engine_get_obj_inst(&LWM2M_OBJ(TEST_OBJ_ID, 0));
+	zassert_not_null(oi);
+
+	for (uint16_t res_id = LWM2M_RES_TYPE_OPAQUE; res_id <= LWM2M_RES_TYPE_OBJLNK; res_id++) {
+		res = lwm2m_get_engine_obj_inst_res(oi, res_id);
+		zassert_not_null(res);
+		zassert_equal(res->res_id, res_id);
+		zassert_not_null(lwm2m_get_engine_obj_field(oi->obj, res_id));
+	}
+
+	zassert_is_null(lwm2m_get_engine_obj_inst_res(oi, LWM2M_RES_TYPE_OBJLNK + 1));
+	zassert_is_null(lwm2m_get_engine_obj_field(oi->obj, LWM2M_RES_TYPE_OBJLNK + 1));
+}
+
 ZTEST(lwm2m_registry, test_null_strings)
 {
 	int ret;
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * zperf TCP transfers over the loopback interface, on a clean link and on
+ * links losing and delaying packets. Everything sent must be received.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/zperf.h>
+#include <zephyr/net/loopback.h>
+
+#define SERVER_PORT     5001
+#define PACKET_SIZE     1024
+#define DURATION_MS     2000
+#define FINISH_TIMEOUT  K_SECONDS(60)
+
+static K_SEM_DEFINE(finished_sem, 0, 1);
+static struct zperf_results server_results;
+static bool server_error;
+
+static void server_cb(enum zperf_status status, struct zperf_results *result,
+		      void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	switch (status) {
+	case ZPERF_SESSION_FINISHED:
+		server_results = *result;
+		k_sem_give(&finished_sem);
+		break;
+	case ZPERF_SESSION_ERROR:
+		server_error = true;
+		k_sem_give(&finished_sem);
+		break;
+	default:
+		break;
+	}
+}
+
+static void transfer(float drop_ratio, uint32_t delay_ms)
+{
+	struct zperf_upload_params param = {
+		.duration_ms = DURATION_MS,
+		.packet_size = PACKET_SIZE,
+	};
+	struct sockaddr_in *peer = net_sin(&param.peer_addr);
+	struct zperf_results client_results = { 0 };
+	uint64_t sent;
+	int ret;
+
+	zassert_ok(loopback_set_packet_drop_ratio(drop_ratio));
+	zassert_ok(loopback_set_packet_delay(delay_ms));
+
+	peer->sin_family = AF_INET;
+	peer->sin_port = htons(SERVER_PORT);
+	peer->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	ret = zperf_tcp_upload(&param, &client_results);
+	zassert_ok(ret, "upload failed (%d)", ret);
+
+	zassert_ok(k_sem_take(&finished_sem, FINISH_TIMEOUT),
+		   "server did not see the end of the transfer");
+	zassert_false(server_error, "server error");
+
+	sent = (uint64_t)client_results.nb_packets_sent * client_results.packet_size;
+
+	TC_PRINT("drop %u%%, delay %u ms: %llu bytes in %llu ms, %u packets dropped\n",
+		 (unsigned int)(drop_ratio * 100), delay_ms, server_results.total_len,
+		 server_results.time_in_us / USEC_PER_MSEC,
+		 loopback_get_num_dropped_packets());
+
+	zassert_true(sent > 0, "nothing sent");
+	zassert_equal(server_results.total_len, sent,
+		      "received %llu bytes, sent %llu", server_results.total_len, sent);
+}
+
+ZTEST(zperf_tcp, test_clean_link)
+{
+	transfer(0.0f, 0);
+}
+
+ZTEST(zperf_tcp, test_lossy_link)
+{
+	transfer(0.02f, 0);
+}
+
+ZTEST(zperf_tcp, test_lossy_long_link)
+{
+	transfer(0.02f, 50);
+}
+
+static void *setup(void)
+{
+	struct zperf_download_params param = {
+		.port = SERVER_PORT,
+	};
+
+	param.addr.sa_family = AF_INET;
+
+	zassert_ok(zperf_tcp_download(&param, server_cb, NULL));
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_sem_reset(&finished_sem);
+	server_error = false;
+	memset(&server_results, 0, sizeof(server_results));
+}
+
+static void teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)loopback_set_packet_drop_ratio(0.0f);
+	(void)loopback_set_packet_delay(0);
+	(void)zperf_tcp_download_stop();
+}
+
+ZTEST_SUITE(zperf_tcp, NULL, setup, before, NULL, teardown);
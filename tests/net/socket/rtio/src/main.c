@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_rtio.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/ztest.h>
+
+#define BLK_SIZE  16
+#define RECV_MAX  (2 * BLK_SIZE)
+
+SOCKET_RTIO_IODEV_DEFINE(sock_iodev, RECV_MAX);
+RTIO_DEFINE_WITH_MEMPOOL(r_sock, 4, 4, 8, BLK_SIZE, 4);
+
+static int sv[2];
+
+static const uint8_t msg[] = "Hello, RTIO";
+
+static void before(void *unused)
+{
+	ARG_UNUSED(unused);
+
+	zassert_ok(zsock_socketpair(AF_UNIX, SOCK_STREAM, 0, sv));
+	socket_rtio_iodev_sock_set(&sock_iodev, sv[0]);
+}
+
+static void after(void *unused)
+{
+	ARG_UNUSED(unused);
+
+	(void)socket_rtio_iodev_close(&sock_iodev);
+	if (sv[1] >= 0) {
+		zsock_close(sv[1]);
+	}
+}
+
+static int cqe_result(struct rtio *r)
+{
+	struct rtio_cqe *cqe = rtio_cqe_consume_block(r);
+	int result = cqe->result;
+
+	rtio_cqe_release(r, cqe);
+
+	return result;
+}
+
+/**
+ * @brief Test a read of data already pending on the socket
+ */
+ZTEST(socket_rtio, test_recv_ready)
+{
+	uint8_t buf[sizeof(msg)] = { 0 };
+	struct rtio_sqe *sqe;
+
+	zassert_equal(zsock_send(sv[1], msg, sizeof(msg), 0), sizeof(msg));
+
+	sqe = rtio_sqe_acquire(&r_sock);
+	rtio_sqe_prep_read(sqe, &sock_iodev, RTIO_PRIO_NORM, buf, sizeof(buf), NULL);
+
+	zassert_ok(rtio_submit(&r_sock, 1));
+	zassert_equal(cqe_result(&r_sock), sizeof(msg));
+	zassert_mem_equal(buf, msg, sizeof(msg));
+}
+
+/**
+ * @brief Test a read waiting for data
+ *
+ * The read is polled for, and completes once the peer sends.
+ */
+ZTEST(socket_rtio, test_recv_waiting)
+{
+	uint8_t buf[sizeof(msg)] = { 0 };
+	struct rtio_sqe *sqe;
+
+	sqe = rtio_sqe_acquire(&r_sock);
+	rtio_sqe_prep_read(sqe, &sock_iodev, RTIO_PRIO_NORM, buf, sizeof(buf), NULL);
+
+	zassert_ok(rtio_submit(&r_sock, 0));
+
+	k_msleep(10);
+	zassert_is_null(rtio_cqe_consume(&r_sock), "read completed without data");
+
+	zassert_equal(zsock_send(sv[1], msg, sizeof(msg), 0), sizeof(msg));
+	zassert_equal(cqe_result(&r_sock), sizeof(msg));
+	zassert_mem_equal(buf, msg, sizeof(msg));
+}
+
+/**
+ * @brief Test that a read completes with 0 when the peer closes
+ */
+ZTEST(socket_rtio, test_recv_closed)
+{
+	uint8_t buf[sizeof(msg)];
+	struct rtio_sqe *sqe;
+
+	sqe = rtio_sqe_acquire(&r_sock);
+	rtio_sqe_prep_read(sqe, &sock_iodev, RTIO_PRIO_NORM, buf, sizeof(buf), NULL);
+
+	zassert_ok(rtio_submit(&r_sock, 0));
+
+	k_msleep(10);
+	zsock_close(sv[1]);
+	sv[1] = -1;
+	zassert_equal(cqe_result(&r_sock), 0);
+}
+
+/**
+ * @brief Test a write
+ */
+ZTEST(socket_rtio, test_send)
+{
+	uint8_t buf[sizeof(msg)] = { 0 };
+	struct rtio_sqe *sqe;
+
+	sqe = rtio_sqe_acquire(&r_sock);
+	rtio_sqe_prep_write(sqe, &sock_iodev, RTIO_PRIO_NORM, msg, sizeof(msg), NULL);
+
+	zassert_ok(rtio_submit(&r_sock, 1));
+	zassert_equal(cqe_result(&r_sock), sizeof(msg));
+
+	zassert_equal(zsock_recv(sv[1], buf, sizeof(buf), 0), sizeof(msg));
+	zassert_mem_equal(buf, msg, sizeof(msg));
+}
+
+/**
+ * @brief Test a multishot read from the memory pool
+ *
+ * A single submission receives every message, and ends when the peer
+ * closes the connection.
+ */
+ZTEST(socket_rtio, test_recv_multishot)
+{
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+	uint32_t buf_len;
+	uint8_t *buf;
+
+	sqe = rtio_sqe_acquire(&r_sock);
+	rtio_sqe_prep_read_multishot(sqe, &sock_iodev, RTIO_PRIO_NORM, NULL);
+
+	zassert_ok(rtio_submit(&r_sock, 0));
+
+	for (int i = 0; i < 3; i++) {
+		zassert_equal(zsock_send(sv[1], msg, sizeof(msg), 0), sizeof(msg));
+
+		cqe = rtio_cqe_consume_block(&r_sock);
+		zassert_equal(cqe->result, sizeof(msg));
+		zassert_ok(rtio_cqe_get_mempool_buffer(&r_sock, cqe, &buf, &buf_len));
+		zassert_mem_equal(buf, msg, sizeof(msg));
+		rtio_cqe_release(&r_sock, cqe);
+		rtio_release_buffer(&r_sock, buf, buf_len);
+	}
+
+	zsock_close(sv[1]);
+	sv[1] = -1;
+
+	cqe = rtio_cqe_consume_block(&r_sock);
+	zassert_equal(cqe->result, 0);
+	if (rtio_cqe_get_mempool_buffer(&r_sock, cqe, &buf, &buf_len) == 0) {
+		rtio_release_buffer(&r_sock, buf, buf_len);
+	}
+	rtio_cqe_release(&r_sock, cqe);
+
+	k_msleep(10);
+	zassert_is_null(rtio_cqe_consume(&r_sock), "multishot read did not end");
+}
+
+/**
+ * @brief Test that closing the IO device ends the reads waiting on it
+ */
+ZTEST(socket_rtio, test_recv_close)
+{
+	uint8_t buf[sizeof(msg)];
+	struct rtio_sqe *sqe;
+
+	sqe = rtio_sqe_acquire(&r_sock);
+	rtio_sqe_prep_read(sqe, &sock_iodev, RTIO_PRIO_NORM, buf, sizeof(buf), NULL);
+
+	zassert_ok(rtio_submit(&r_sock, 0));
+
+	k_msleep(10);
+	zassert_ok(socket_rtio_iodev_close(&sock_iodev));
+	zassert_equal(cqe_result(&r_sock), -ECANCELED);
+	zassert_equal(socket_rtio_iodev_close(&sock_iodev), -EBADF);
+}
+
+/**
+ * @brief Test that a canceled read does not take the data sent next
+ */
+ZTEST(socket_rtio, test_recv_cancel)
+{
+	uint8_t buf[sizeof(msg)] = { 0 };
+	uint8_t canceled_buf[sizeof(msg)];
+	struct rtio_sqe *sqe;
+
+	sqe = rtio_sqe_acquire(&r_sock);
+	rtio_sqe_prep_read(sqe, &sock_iodev, RTIO_PRIO_NORM, canceled_buf,
+			   sizeof(canceled_buf), NULL);
+
+	zassert_ok(rtio_submit(&r_sock, 0));
+
+	k_msleep(10);
+	zassert_ok(rtio_sqe_cancel(sqe));
+	zassert_equal(zsock_send(sv[1], msg, sizeof(msg), 0), sizeof(msg));
+	zassert_equal(cqe_result(&r_sock), -ECANCELED);
+
+	sqe = rtio_sqe_acquire(&r_sock);
+	rtio_sqe_prep_read(sqe, &sock_iodev, RTIO_PRIO_NORM, buf, sizeof(buf), NULL);
+
+	zassert_ok(rtio_submit(&r_sock, 1));
+	zassert_equal(cqe_result(&r_sock), sizeof(msg));
+	zassert_mem_equal(buf, msg, sizeof(msg));
+}
+
+ZTEST_SUITE(socket_rtio, NULL, NULL, before, after, NULL);
@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Coalescing of the received TCP segments: which segments are merged and
+ * when the merged ones are handed to the connection.
+ */
+
+#include <string.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "ipv4.h"
+#include "connection.h"
+#include "tcp_internal.h"
+
+#include <zephyr/ztest.h>
+
+#define GRO_SRC_PORT 5001
+#define GRO_DST_PORT 5002
+#define GRO_SEQ      1000U
+#define GRO_LEN      40U
+
+/* NOP, NOP and the timestamps option */
+#define GRO_TS_LEN 12U
+
+static struct in_addr src_addr = { { { 192, 0, 2, 2 } } };
+static struct in_addr dst_addr = { { { 192, 0, 2, 1 } } };
+
+static struct net_if *iface;
+static struct net_conn_handle *handle;
+
+/* Packets handed to the connection */
+static struct net_pkt *delivered[4];
+static size_t delivered_count;
+
+static enum net_verdict gro_conn_cb(struct net_conn *conn, struct net_pkt *pkt,
+				    union net_ip_header *ip_hdr,
+				    union net_proto_header *proto_hdr,
+				    void *user_data)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto_hdr);
+	ARG_UNUSED(user_data);
+
+	zassert_true(delivered_count < ARRAY_SIZE(delivered), "Too many packets");
+	delivered[delivered_count++] = pkt;
+
+	return NET_OK;
+}
+
+/* Received segment of len bytes at seq, with the timestamps option if tsval
+ * is not 0.
+ */
+static struct net_pkt *prepare_segment(uint32_t seq, uint32_t ack, uint8_t flags,
+				       size_t len, uint32_t tsval)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	size_t opts_len = tsval != 0U ? GRO_TS_LEN : 0U;
+	struct net_tcp_hdr *tcp_hdr;
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, sizeof(struct net_tcp_hdr) + opts_len + len,
+					   AF_INET, IPPROTO_TCP, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+
+	zassert_ok(net_ipv4_create(pkt, &src_addr, &dst_addr), "Cannot create IP header");
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+	zassert_not_null(tcp_hdr, "Cannot access TCP header");
+
+	memset(tcp_hdr, 0, sizeof(*tcp_hdr));
+	tcp_hdr->src_port = htons(GRO_SRC_PORT);
+	tcp_hdr->dst_port = htons(GRO_DST_PORT);
+	sys_put_be32(seq, tcp_hdr->seq);
+	sys_put_be32(ack, tcp_hdr->ack);
+	tcp_hdr->offset = ((sizeof(*tcp_hdr) + opts_len) / 4U) << 4;
+	tcp_hdr->flags = flags;
+	sys_put_be16(8192, tcp_hdr->wnd);
+
+	zassert_ok(net_pkt_set_data(pkt, &tcp_access), "Cannot set TCP header");
+
+	if (opts_len > 0) {
+		uint8_t opts[GRO_TS_LEN] = { 0x01, 0x01, 0x08, 0x0a };
+
+		sys_put_be32(tsval, &opts[4]);
+		zassert_ok(net_pkt_write(pkt, opts, sizeof(opts)));
+	}
+
+	for (size_t i = 0; i < len; i++) {
+		zassert_ok(net_pkt_write_u8(pkt, (uint8_t)(seq + i)));
+	}
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_ipv4_finalize(pkt, IPPROTO_TCP), "Cannot finalize packet");
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+}
+
+static struct net_pkt *data_segment(uint32_t seq, uint8_t flags)
+{
+	return prepare_segment(seq, 1, flags, GRO_LEN, 0);
+}
+
+/* The i-th packet handed to the connection carries the data from seq to
+ * seq + len, after TCP options of opts_len bytes.
+ */
+static void check_delivered(size_t i, uint32_t seq, size_t len, uint8_t flags,
+			    size_t opts_len)
+{
+	size_t hdr_len = sizeof(struct net_ipv4_hdr) + sizeof(struct net_tcp_hdr) + opts_len;
+	struct net_tcp_hdr tcp_hdr;
+	struct net_pkt *pkt;
+	uint8_t byte;
+
+	zassert_true(i < delivered_count, "Packet %zu not delivered", i);
+	pkt = delivered[i];
+
+	zassert_equal(net_pkt_get_len(pkt), hdr_len + len, "Packet %zu is %zu bytes",
+		      i, net_pkt_get_len(pkt));
+	zassert_equal(ntohs(NET_IPV4_HDR(pkt)->len), hdr_len + len, "Wrong IPv4 length");
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	zassert_ok(net_pkt_skip(pkt, sizeof(struct net_ipv4_hdr)));
+	zassert_ok(net_pkt_read(pkt, &tcp_hdr, sizeof(tcp_hdr)));
+	zassert_ok(net_pkt_skip(pkt, opts_len));
+
+	zassert_equal(sys_get_be32(tcp_hdr.seq), seq, "Wrong sequence number");
+	zassert_equal(tcp_hdr.flags, flags, "Flags 0x%02x, expected 0x%02x",
+		      tcp_hdr.flags, flags);
+
+	for (size_t j = 0; j < len; j++) {
+		zassert_ok(net_pkt_read_u8(pkt, &byte));
+		zassert_equal(byte, (uint8_t)(seq + j), "Wrong data at %zu", j);
+	}
+}
+
+/* A segment not taken by GRO is handed to the connection by the caller */
+static void receive(struct net_pkt *pkt, bool taken)
+{
+	zassert_equal(net_tcp_gro_receive(pkt), taken, "Segment %s",
+		      taken ? "not taken" : "taken");
+
+	if (!taken) {
+		net_pkt_unref(pkt);
+	}
+}
+
+ZTEST(net_tcp_gro, test_merge_in_order)
+{
+	receive(data_segment(GRO_SEQ, ACK), true);
+	receive(data_segment(GRO_SEQ + GRO_LEN, ACK), true);
+	receive(data_segment(GRO_SEQ + 2 * GRO_LEN, ACK), true);
+
+	zassert_equal(delivered_count, 0, "Segments delivered before the flush");
+
+	net_tcp_gro_flush();
+
+	zassert_equal(delivered_count, 1, "Segments not merged");
+	check_delivered(0, GRO_SEQ, 3 * GRO_LEN, ACK, 0);
+}
+
+ZTEST(net_tcp_gro, test_push_flushes)
+{
+	/* Alone, it is not held */
+	receive(data_segment(GRO_SEQ, ACK | PSH), false);
+	zassert_equal(delivered_count, 0);
+
+	/* Appended, then the merged segments go at once */
+	receive(data_segment(GRO_SEQ, ACK), true);
+	receive(data_segment(GRO_SEQ + GRO_LEN, ACK | PSH), true);
+
+	zassert_equal(delivered_count, 1, "Not flushed on PSH");
+	check_delivered(0, GRO_SEQ, 2 * GRO_LEN, ACK | PSH, 0);
+}
+
+ZTEST(net_tcp_gro, test_out_of_order)
+{
+	/* A gap: the held segments go first, the new one is not taken */
+	receive(data_segment(GRO_SEQ, ACK), true);
+	receive(data_segment(GRO_SEQ + 2 * GRO_LEN, ACK), false);
+
+	zassert_equal(delivered_count, 1, "Held segment not flushed");
+	check_delivered(0, GRO_SEQ, GRO_LEN, ACK, 0);
+
+	/* A retransmission of data already held */
+	receive(data_segment(GRO_SEQ, ACK), true);
+	receive(data_segment(GRO_SEQ, ACK), false);
+
+	zassert_equal(delivered_count, 2, "Held segment not flushed");
+	check_delivered(1, GRO_SEQ, GRO_LEN, ACK, 0);
+}
+
+ZTEST(net_tcp_gro, test_flag_change)
+{
+	/* FIN is never merged */
+	receive(data_segment(GRO_SEQ, ACK), true);
+	receive(data_segment(GRO_SEQ + GRO_LEN, ACK | FIN), false);
+
+	zassert_equal(delivered_count, 1, "Held segment not flushed");
+	check_delivered(0, GRO_SEQ, GRO_LEN, ACK, 0);
+
+	/* Nor a pure ACK */
+	receive(data_segment(GRO_SEQ, ACK), true);
+	receive(prepare_segment(GRO_SEQ + GRO_LEN, 1, ACK, 0, 0), false);
+
+	zassert_equal(delivered_count, 2, "Held segment not flushed");
+	check_delivered(1, GRO_SEQ, GRO_LEN, ACK, 0);
+
+	/* Nor a segment acknowledging more data */
+	receive(data_segment(GRO_SEQ, ACK), true);
+	receive(prepare_segment(GRO_SEQ + GRO_LEN, 2, ACK, GRO_LEN, 0), false);
+
+	zassert_equal(delivered_count, 3, "Held segment not flushed");
+	check_delivered(2, GRO_SEQ, GRO_LEN, ACK, 0);
+}
+
+ZTEST(net_tcp_gro, test_timestamp_mismatch)
+{
+	/* Same timestamps, merged */
+	receive(prepare_segment(GRO_SEQ, 1, ACK, GRO_LEN, 100), true);
+	receive(prepare_segment(GRO_SEQ + GRO_LEN, 1, ACK, GRO_LEN, 100), true);
+
+	/* Newer timestamp, TCP has to see it */
+	receive(prepare_segment(GRO_SEQ + 2 * GRO_LEN, 1, ACK, GRO_LEN, 101), false);
+
+	zassert_equal(delivered_count, 1, "Held segments not flushed");
+	check_delivered(0, GRO_SEQ, 2 * GRO_LEN, ACK, GRO_TS_LEN);
+
+	/* Options appearing */
+	receive(data_segment(GRO_SEQ, ACK), true);
+	receive(prepare_segment(GRO_SEQ + GRO_LEN, 1, ACK, GRO_LEN, 100), false);
+
+	zassert_equal(delivered_count, 2, "Held segment not flushed");
+	check_delivered(1, GRO_SEQ, GRO_LEN, ACK, 0);
+}
+
+static void *gro_setup(void)
+{
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(iface, "Interface not available");
+
+	zassert_ok(net_conn_register(IPPROTO_TCP, AF_INET, NULL, NULL, GRO_SRC_PORT,
+				     GRO_DST_PORT, NULL, gro_conn_cb, NULL, &handle),
+		   "Cannot register connection");
+
+	return NULL;
+}
+
+static void gro_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	net_tcp_gro_flush();
+
+	for (size_t i = 0; i < delivered_count; i++) {
+		net_pkt_unref(delivered[i]);
+	}
+
+	delivered_count = 0;
+}
+
+static void gro_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	net_conn_unregister(handle);
+}
+
+ZTEST_SUITE(net_tcp_gro, NULL, gro_setup, NULL, gro_after, gro_teardown);
@@ -2012,7 +2012,7 @@ ZTEST(net_tcp, test_client_invalid_rst)
 {
 	struct net_context *ctx;
 	struct tcp *conn;
-	uint16_t wnd;
+	uint32_t wnd;
 
 	ctx = create_server_socket(0, 0);
 
@@ -2071,9 +2071,9 @@ struct out_of_order_check_struct {
 static struct out_of_order_check_struct out_of_order_check_list[] = {
 	{ 30, 10, 0, 0}, /* First packet will be out-of-order */
 	{ 20, 12, 0, 0},
-	{ 10,  9, 0, 0}, /* Section with a gap */
-	{ 0,  10, 10, 0},
-	{ 10, 10, 40, 0}, /* First sequence complete */
+	{ 10,  9, 0, 0}, /* Section with a gap, queued */
+	{ 0,  10, 19, 0}, /* Up to the gap */
+	{ 10, 10, 40, 0}, /* Fills the gap, first sequence complete */
 	{ 50,  6, 40, 0},
 	{ 50,  3, 40, 0}, /* Discardable packet */
 	{ 55,  5, 40, 0},
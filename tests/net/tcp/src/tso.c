@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Segmentation of the TCP packets carrying several segments of data, as
+ * done by the network interface before they are given to the device.
+ */
+
+#include <string.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "ipv4.h"
+#include "ipv6.h"
+#include "tcp_internal.h"
+
+#include <zephyr/ztest.h>
+
+/* Segments small enough for the network buffers of the test */
+#define TSO_MSS 100U
+/* Close to wrapping around */
+#define TSO_SEQ 0xfffffff0U
+
+static struct in_addr src_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr dst_addr = { { { 192, 0, 2, 2 } } };
+static struct in6_addr src_addr_v6 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					   0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr dst_addr_v6 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					   0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+
+static struct net_if *iface;
+
+static uint8_t data_byte(size_t offset)
+{
+	return (uint8_t)(offset * 7U + 1U);
+}
+
+/* Packet with len bytes of data, to be cut into segments of mss bytes */
+static struct net_pkt *prepare_tso_pkt(sa_family_t af, uint8_t flags,
+				       size_t len, uint16_t mss)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	struct net_tcp_hdr *tcp_hdr;
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(struct net_tcp_hdr), af,
+					IPPROTO_TCP, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+
+	/* The data does not fit in an MTU sized packet */
+	zassert_ok(net_pkt_alloc_buffer_raw(pkt, len, K_NO_WAIT),
+		   "Cannot allocate data");
+
+	if (af == AF_INET) {
+		ret = net_ipv4_create(pkt, &src_addr, &dst_addr);
+	} else {
+		ret = net_ipv6_create(pkt, &src_addr_v6, &dst_addr_v6);
+	}
+
+	zassert_ok(ret, "Cannot create IP header");
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+	zassert_not_null(tcp_hdr, "Cannot access TCP header");
+
+	memset(tcp_hdr, 0, sizeof(*tcp_hdr));
+	tcp_hdr->src_port = htons(4242);
+	tcp_hdr->dst_port = htons(4243);
+	sys_put_be32(TSO_SEQ, tcp_hdr->seq);
+	sys_put_be32(1, tcp_hdr->ack);
+	tcp_hdr->offset = (sizeof(*tcp_hdr) / 4U) << 4;
+	tcp_hdr->flags = flags;
+	sys_put_be16(8192, tcp_hdr->wnd);
+
+	zassert_ok(net_pkt_set_data(pkt, &tcp_access), "Cannot set TCP header");
+
+	for (size_t i = 0; i < len; i++) {
+		zassert_ok(net_pkt_write_u8(pkt, data_byte(i)), "Cannot write data");
+	}
+
+	net_pkt_set_tso_size(pkt, mss);
+	net_pkt_cursor_init(pkt);
+
+	if (af == AF_INET) {
+		ret = net_ipv4_finalize(pkt, IPPROTO_TCP);
+	} else {
+		ret = net_ipv6_finalize(pkt, IPPROTO_TCP);
+	}
+
+	zassert_ok(ret, "Cannot finalize packet");
+
+	return pkt;
+}
+
+/* Check the segment carries len bytes of data from offset, with the flags */
+static void check_segment(struct net_pkt *seg, sa_family_t af, size_t offset,
+			  size_t len, uint8_t flags)
+{
+	size_t ip_len = af == AF_INET ? sizeof(struct net_ipv4_hdr) :
+					sizeof(struct net_ipv6_hdr);
+	struct net_tcp_hdr tcp_hdr;
+	uint8_t byte;
+
+	zassert_equal(net_pkt_get_len(seg), ip_len + sizeof(tcp_hdr) + len,
+		      "Segment at %zu is %zu bytes", offset, net_pkt_get_len(seg));
+
+	if (af == AF_INET) {
+		zassert_equal(ntohs(NET_IPV4_HDR(seg)->len), net_pkt_get_len(seg),
+			      "Wrong IPv4 length");
+	} else {
+		zassert_equal(ntohs(NET_IPV6_HDR(seg)->len), sizeof(tcp_hdr) + len,
+			      "Wrong IPv6 payload length");
+	}
+
+	net_pkt_cursor_init(seg);
+	net_pkt_set_overwrite(seg, true);
+
+	zassert_ok(net_pkt_skip(seg, ip_len));
+	zassert_ok(net_pkt_read(seg, &tcp_hdr, sizeof(tcp_hdr)));
+
+	zassert_equal(sys_get_be32(tcp_hdr.seq), (uint32_t)(TSO_SEQ + offset),
+		      "Wrong sequence number at %zu", offset);
+	zassert_equal(sys_get_be32(tcp_hdr.ack), 1, "Wrong ack number");
+	zassert_equal(tcp_hdr.flags, flags, "Flags 0x%02x at %zu, expected 0x%02x",
+		      tcp_hdr.flags, offset, flags);
+
+	for (size_t i = 0; i < len; i++) {
+		zassert_ok(net_pkt_read_u8(seg, &byte));
+		zassert_equal(byte, data_byte(offset + i),
+			      "Wrong data at %zu", offset + i);
+	}
+}
+
+/* Cut the packet and check each segment, the flags of the packet being
+ * those of the last segment.
+ */
+static void check_segmentation(sa_family_t af, uint8_t flags, size_t len,
+			       uint16_t mss)
+{
+	struct net_pkt *pkt = prepare_tso_pkt(af, flags, len, mss);
+	size_t count = DIV_ROUND_UP(len, mss);
+	size_t offset = 0;
+	struct net_pkt *seg;
+
+	for (size_t i = 0; i < count; i++) {
+		uint8_t seg_flags = flags;
+		size_t seg_len = MIN(mss, len - offset);
+
+		zassert_ok(net_tcp_tso_segment(pkt, &offset, &seg),
+			   "Cannot cut segment %zu", i);
+		zassert_not_null(seg, "No segment %zu of %zu", i, count);
+
+		if (i < count - 1) {
+			seg_flags &= ~(PSH | FIN);
+		}
+
+		if (i > 0) {
+			seg_flags &= ~CWR;
+		}
+
+		check_segment(seg, af, i * mss, seg_len, seg_flags);
+		net_pkt_unref(seg);
+
+		zassert_equal(offset, i * mss + seg_len, "Offset not moved past segment");
+	}
+
+	zassert_ok(net_tcp_tso_segment(pkt, &offset, &seg));
+	zassert_is_null(seg, "More segments than data");
+
+	net_pkt_unref(pkt);
+}
+
+ZTEST(net_tcp_tso, test_segment_boundaries)
+{
+	/* Partial last segment, then only full segments */
+	check_segmentation(AF_INET, ACK, 3 * TSO_MSS + 50, TSO_MSS);
+	check_segmentation(AF_INET, ACK, 3 * TSO_MSS, TSO_MSS);
+	check_segmentation(AF_INET6, ACK, 2 * TSO_MSS + 1, TSO_MSS);
+	check_segmentation(AF_INET6, ACK, 2 * TSO_MSS, TSO_MSS);
+}
+
+ZTEST(net_tcp_tso, test_mss_split)
+{
+	/* The segment size is the one of the packet, not the MTU */
+	check_segmentation(AF_INET, ACK, 300, 64);
+	check_segmentation(AF_INET, ACK, 300, 299);
+	check_segmentation(AF_INET, ACK, 300, 300);
+	check_segmentation(AF_INET, ACK, 300, 1);
+}
+
+ZTEST(net_tcp_tso, test_last_segment_flags)
+{
+	/* PSH and FIN end up on the last segment only, CWR on the first */
+	check_segmentation(AF_INET, ACK | PSH, 4 * TSO_MSS, TSO_MSS);
+	check_segmentation(AF_INET, ACK | PSH | FIN, 3 * TSO_MSS + 10, TSO_MSS);
+	check_segmentation(AF_INET6, ACK | PSH | CWR, 3 * TSO_MSS, TSO_MSS);
+	check_segmentation(AF_INET6, ACK | PSH | FIN | CWR, 2 * TSO_MSS + 10, TSO_MSS);
+
+	/* A single segment keeps all of them */
+	check_segmentation(AF_INET, ACK | PSH | FIN | CWR, TSO_MSS, TSO_MSS);
+}
+
+static void *tso_setup(void)
+{
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(iface, "Interface not available");
+
+	return NULL;
+}
+
+ZTEST_SUITE(net_tcp_tso, NULL, tso_setup, NULL, NULL, NULL);
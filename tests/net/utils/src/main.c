@@ -29,6 +29,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_UTILS_LOG_LEVEL);
 
 #define NET_LOG_ENABLED 1
 #include "net_private.h"
+#include "ipv4.h"
 
 struct net_addr_test_data {
 	sa_family_t family;
@@ -938,6 +939,136 @@ ZTEST(test_utils_fn, test_ip_checksum)
 	}
 }
 
+static uint8_t copydata[CHECKSUM_TEST_LENGTH + 8];
+
+ZTEST(test_utils_fn, test_ip_checksum_copy)
+{
+#if defined(CONFIG_NET_CHKSUM_COPY)
+	uint16_t sum_got;
+	uint16_t sum_exp;
+
+	for (int i = 0; i < CHECKSUM_TEST_LENGTH; i++) {
+		testdata[i] = (uint8_t)(i + 7) * 31;
+	}
+
+	/* All alignments of the source and of the destination */
+	for (int src_off = 0; src_off < 8; src_off++) {
+		for (int dst_off = 0; dst_off < 8; dst_off++) {
+			for (int length = 0; length < 200; length++) {
+				memset(copydata, 0xa5, sizeof(copydata));
+
+				sum_exp = calc_chksum_ref(length ^ 0x3c5a, testdata + src_off,
+							  length);
+				sum_got = calc_chksum_copy(length ^ 0x3c5a, copydata + dst_off,
+							   testdata + src_off, length);
+
+				zassert_equal(sum_got, sum_exp,
+					      "Checksum mismatch, src %d dst %d length %d",
+					      src_off, dst_off, length);
+				zassert_mem_equal(copydata + dst_off, testdata + src_off, length,
+						  "Copy mismatch, src %d dst %d length %d",
+						  src_off, dst_off, length);
+				zassert_equal(copydata[dst_off + length], 0xa5,
+					      "Copied past the end, length %d", length);
+			}
+		}
+	}
+
+	/* Long enough for the unrolled loops */
+	for (int length = CHECKSUM_TEST_LENGTH - 8; length <= CHECKSUM_TEST_LENGTH - 7;
+	     length++) {
+		sum_exp = calc_chksum_ref(0, testdata + 7, length);
+		sum_got = calc_chksum_copy(0, copydata + 1, testdata + 7, length);
+
+		zassert_equal(sum_got, sum_exp, "Checksum mismatch, length %d", length);
+		zassert_mem_equal(copydata + 1, testdata + 7, length, "Copy mismatch");
+	}
+#else
+	ztest_test_skip();
+#endif
+}
+
+#if defined(CONFIG_NET_CHKSUM_COPY)
+/* Checksum of a UDP packet with the payload, written with or without the
+ * checksum being computed during the copy.
+ */
+static uint16_t udp_pkt_chksum(const uint8_t *data, size_t len, bool copy)
+{
+	static const struct in_addr src = { { { 192, 0, 2, 1 } } };
+	static const struct in_addr dst = { { { 192, 0, 2, 2 } } };
+	struct net_pkt *pkt;
+	uint16_t sum;
+	int ret;
+
+	pkt = net_pkt_alloc_with_buffer(net_if_get_default(), NET_UDPH_LEN + len, AF_INET,
+					IPPROTO_UDP, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate pkt");
+
+	zassert_ok(net_ipv4_create(pkt, &src, &dst), "Cannot create IPv4 header");
+	zassert_ok(net_pkt_memset(pkt, 0, NET_UDPH_LEN), "Cannot write UDP header");
+
+	if (copy) {
+		ret = net_pkt_write_chksum(pkt, data, len);
+	} else {
+		ret = net_pkt_write(pkt, data, len);
+	}
+
+	zassert_ok(ret, "Cannot write payload");
+
+	net_pkt_cursor_init(pkt);
+	sum = net_calc_chksum(pkt, IPPROTO_UDP);
+	net_pkt_unref(pkt);
+
+	return sum;
+}
+#endif
+
+/* Payloads whose sum wraps the accumulators, the carries have to go back
+ * into the sum.
+ */
+ZTEST(test_utils_fn, test_ip_checksum_copy_carry)
+{
+#if defined(CONFIG_NET_CHKSUM_COPY)
+	static const uint8_t fills[][2] = {
+		{ 0xff, 0xff }, { 0xff, 0xfe }, { 0xfe, 0xff }, { 0xff, 0xfd },
+	};
+	static const uint16_t lengths[] = {
+		15, 16, 17, 63, 64, 65, 127, 128, 129, 255, 256, 257, 511, 600,
+	};
+	uint16_t sum_got;
+	uint16_t sum_exp;
+
+	for (int f = 0; f < ARRAY_SIZE(fills); f++) {
+		for (int i = 0; i < CHECKSUM_TEST_LENGTH; i++) {
+			testdata[i] = fills[f][i % 2];
+		}
+
+		for (int src_off = 0; src_off < 4; src_off++) {
+			for (int l = 0; l < ARRAY_SIZE(lengths); l++) {
+				size_t length = lengths[l];
+
+				sum_exp = calc_chksum_ref(0xfffe, testdata + src_off, length);
+				sum_got = calc_chksum_copy(0xfffe, copydata + 1, testdata + src_off,
+							   length);
+
+				zassert_equal(sum_got, sum_exp,
+					      "Checksum mismatch, fill %d src %d length %zu",
+					      f, src_off, length);
+
+				sum_exp = udp_pkt_chksum(testdata + src_off, length, false);
+				sum_got = udp_pkt_chksum(testdata + src_off, length, true);
+
+				zassert_equal(sum_got, sum_exp,
+					      "Packet checksum mismatch, fill %d src %d length %zu",
+					      f, src_off, length);
+			}
+		}
+	}
+#else
+	ztest_test_skip();
+#endif
+}
+
 /* Verify that the net_pkt pointer to the received link layer address
  * is correct.
  */
@@ -8,6 +8,7 @@
 #include <zephyr/ztest.h>
 #include <zephyr/storage/flash_map.h>
 #include <zephyr/dfu/flash_img.h>
+#include <zephyr/sys/byteorder.h>
 
 #define SLOT0_PARTITION		slot0_partition
 #define SLOT1_PARTITION		slot1_partition
@@ -165,4 +166,179 @@ ZTEST(img_util, test_check_flash)
 	flash_area_close(ctx.flash_area);
 }
 
+ZTEST(img_util, test_hash_check)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_IMG_INCREMENTAL_HASH);
+
+#if defined(CONFIG_IMG_INCREMENTAL_HASH)
+	/* Same data as in test_check_flash, written in two parts */
+	uint8_t tst_vec[] = { 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
+			      0x38, 0x39, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66,
+			      0x0a, 0x66, 0x65, 0x64, 0x63, 0x62, 0x61, 0x39,
+			      0x38, 0x37, 0x36, 0x35, 0x34, 0x33, 0x32, 0x31,
+			      0x30, 0x0a };
+	uint8_t tst_sha[] = { 0xc6, 0xb6, 0x7c, 0x46, 0xe7, 0x2e, 0x14, 0x17,
+			      0x49, 0xa4, 0xd2, 0xf1, 0x38, 0x58, 0xb2, 0xa7,
+			      0x54, 0xaf, 0x6d, 0x39, 0x50, 0x6b, 0xd5, 0x41,
+			      0x90, 0xf6, 0x18, 0x1a, 0xe0, 0xc2, 0x7f, 0x98 };
+
+	struct flash_img_check fic = { NULL, sizeof(tst_vec) };
+	struct flash_img_context ctx;
+	int ret;
+
+	ret = flash_img_init_id(&ctx, SLOT1_PARTITION_ID);
+	zassert_true(ret == 0, "Flash img init\n");
+	ret = flash_area_flatten(ctx.flash_area, 0, ctx.flash_area->fa_size);
+	zassert_true(ret == 0, "Flash erase failure (%d)\n", ret);
+	ret = flash_img_buffered_write(&ctx, tst_vec, 16, false);
+	zassert_true(ret == 0, "Flash img buffered write 1\n");
+	ret = flash_img_buffered_write(&ctx, tst_vec + 16, sizeof(tst_vec) - 16, true);
+	zassert_true(ret == 0, "Flash img buffered write 2\n");
+
+	ret = flash_img_hash_check(NULL, &fic);
+	zassert_equal(ret, -EINVAL, "Flash img hash check params 1\n");
+	ret = flash_img_hash_check(&ctx, NULL);
+	zassert_equal(ret, -EINVAL, "Flash img hash check params 2\n");
+	ret = flash_img_hash_check(&ctx, &fic);
+	zassert_equal(ret, -EINVAL, "Flash img hash check fic match\n");
+
+	fic.match = tst_sha;
+	fic.clen = sizeof(tst_vec) - 1;
+	ret = flash_img_hash_check(&ctx, &fic);
+	zassert_equal(ret, -ERANGE, "Flash img hash check fic len\n");
+
+	fic.clen = sizeof(tst_vec);
+	ret = flash_img_hash_check(&ctx, &fic);
+	zassert_equal(ret, 0, "Flash img hash check (%d)\n", ret);
+	/* Must agree with the check reading the image back */
+	ret = flash_img_check(&ctx, &fic, SLOT1_PARTITION_ID);
+	zassert_equal(ret, 0, "Flash img check (%d)\n", ret);
+
+	tst_sha[0] = 0x00;
+	ret = flash_img_hash_check(&ctx, &fic);
+	zassert_equal(ret, -EILSEQ, "Flash img hash check wrong sha\n");
+
+	flash_area_close(ctx.flash_area);
+#endif
+}
+
+ZTEST(img_util, test_decompress)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_IMG_DECOMPRESS);
+
+#if defined(CONFIG_IMG_DECOMPRESS)
+	/* 1 KiB of "Zephyr DFU " repeated, with the last quarter of every
+	 * 128 bytes holding the lowest byte of its offset, compressed by
+	 * scripts/utils/compress_image.py --window-bits 8 --lookahead-bits 4
+	 */
+#if defined(CONFIG_IMG_DECOMPRESS_LZ4)
+	static const uint8_t compressed[] = {
+		0x5a, 0x43, 0x4f, 0x4d, 0x01, 0x08, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x8b, 0x78, 0x3f, 0xf3, 0x23, 0x53, 0x00, 0x89,
+		0x25, 0x42, 0x81, 0xd7, 0x2c, 0x86, 0x6c, 0x4f, 0x9a, 0x00, 0x5d, 0x9f,
+		0x1a, 0xe6, 0x60, 0x77, 0xd1, 0x07, 0xe2, 0x3d, 0xe7, 0x75, 0x54, 0x3b,
+		0xa0, 0x00, 0x00, 0x00, 0xbf, 0x5a, 0x65, 0x70, 0x68, 0x79, 0x72, 0x20,
+		0x44, 0x46, 0x55, 0x20, 0x0b, 0x00, 0x42, 0xff, 0x11, 0x60, 0x61, 0x62,
+		0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x6b, 0x6c, 0x6d, 0x6e,
+		0x6f, 0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a,
+		0x7b, 0x7c, 0x7d, 0x7e, 0x7f, 0x79, 0x00, 0x46, 0x03, 0x0b, 0x00, 0xff,
+		0x11, 0xe0, 0xe1, 0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea,
+		0xeb, 0xec, 0xed, 0xee, 0xef, 0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6,
+		0xf7, 0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff, 0x79, 0x00, 0x46,
+		0x03, 0x0b, 0x00, 0x0f, 0x00, 0x01, 0x0d, 0x0f, 0x79, 0x00, 0x46, 0x03,
+		0x0b, 0x00, 0x0f, 0x00, 0x01, 0x0d, 0x0f, 0x79, 0x00, 0x46, 0x03, 0x0b,
+		0x00, 0x0f, 0x00, 0x01, 0x0d, 0x0f, 0x79, 0x00, 0x46, 0x03, 0x0b, 0x00,
+		0x0f, 0x00, 0x01, 0x0d, 0x0f, 0x79, 0x00, 0x46, 0x03, 0x0b, 0x00, 0x0f,
+		0x00, 0x01, 0x0d, 0x0f, 0x79, 0x00, 0x46, 0x03, 0x0b, 0x00, 0x0f, 0x00,
+		0x01, 0x08, 0x50, 0xfb, 0xfc, 0xfd, 0xfe, 0xff, 0x00, 0x00, 0x00, 0x00,
+	};
+#else
+	static const uint8_t compressed[] = {
+		0x5a, 0x43, 0x4f, 0x4d, 0x02, 0x08, 0x04, 0x00, 0x00, 0x04, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x8b, 0x78, 0x3f, 0xf3, 0x23, 0x53, 0x00, 0x89,
+		0x25, 0x42, 0x81, 0xd7, 0x2c, 0x86, 0x6c, 0x4f, 0x9a, 0x00, 0x5d, 0x9f,
+		0x1a, 0xe6, 0x60, 0x77, 0xd1, 0x07, 0xe2, 0x3d, 0xe7, 0x75, 0x54, 0x3b,
+		0xad, 0x59, 0x6e, 0x16, 0x8b, 0xcd, 0xca, 0x41, 0x44, 0xa3, 0x55, 0x64,
+		0x00, 0xaf, 0x05, 0x78, 0x2b, 0xc1, 0x5e, 0x0a, 0xf0, 0x52, 0x58, 0x2c,
+		0x36, 0x2b, 0x1d, 0x92, 0xcb, 0x66, 0xb3, 0xda, 0x2d, 0x36, 0xab, 0x5d,
+		0xb2, 0xdb, 0x6e, 0xb7, 0xdc, 0x2e, 0x37, 0x2b, 0x9d, 0xd2, 0xeb, 0x76,
+		0xbb, 0xde, 0x2f, 0x37, 0xab, 0xdd, 0xf2, 0xfb, 0x7e, 0xbf, 0x8d, 0xbc,
+		0x15, 0xe0, 0xaf, 0x05, 0x78, 0x2b, 0xc1, 0x5f, 0xe0, 0xf0, 0xf8, 0xbc,
+		0x7e, 0x4f, 0x2f, 0x9b, 0xcf, 0xe8, 0xf4, 0xfa, 0xbd, 0x7e, 0xcf, 0x6f,
+		0xbb, 0xdf, 0xf0, 0xf8, 0xfc, 0xbe, 0x7f, 0x4f, 0xaf, 0xdb, 0xef, 0xf8,
+		0xfc, 0xfe, 0xbf, 0x7f, 0xcf, 0xef, 0xfb, 0xfe, 0x36, 0xf0, 0x57, 0x82,
+		0xbc, 0x15, 0xe0, 0xaf, 0x05, 0x7b, 0xff, 0xdf, 0xfe, 0x36, 0xf0, 0x57,
+		0x82, 0xbc, 0x15, 0xe0, 0xaf, 0x05, 0x7b, 0xff, 0xdf, 0xfe, 0x36, 0xf0,
+		0x57, 0x82, 0xbc, 0x15, 0xe0, 0xaf, 0x05, 0x7b, 0xff, 0xdf, 0xfe, 0x36,
+		0xf0, 0x57, 0x82, 0xbc, 0x15, 0xe0, 0xaf, 0x05, 0x7b, 0xff, 0xdf, 0xfe,
+		0x36, 0xf0, 0x57, 0x82, 0xbc, 0x15, 0xe0, 0xaf, 0x05, 0x7b, 0xff, 0xdf,
+		0xfe, 0x36, 0xf0, 0x57, 0x82, 0xbc, 0x15, 0xe0, 0xaf, 0x05, 0x7b, 0xff,
+		0xdf, 0xfe,
+	};
+#endif
+	static const char text[] = "Zephyr DFU ";
+	static struct flash_img_context ctx;
+	const struct flash_img_compressed_header *hdr;
+	const struct flash_area *fa;
+	uint8_t bad[sizeof(*hdr)];
+	uint8_t temp;
+	size_t i, len;
+	int ret;
+
+	hdr = flash_img_compressed_header(compressed, sizeof(compressed));
+	zassert_not_null(hdr, "Compressed image header\n");
+	zassert_is_null(flash_img_compressed_header(compressed, sizeof(*hdr) - 1),
+			"Short compressed image header\n");
+
+	ret = flash_img_init_id(&ctx, SLOT1_PARTITION_ID);
+	zassert_true(ret == 0, "Flash img init\n");
+	ret = flash_area_flatten(ctx.flash_area, 0, ctx.flash_area->fa_size);
+	zassert_true(ret == 0, "Flash erase failure (%d)\n", ret);
+
+	/* In pieces which do not line up with anything */
+	for (i = 0U; i < sizeof(compressed); i += len) {
+		len = MIN(7U, sizeof(compressed) - i);
+		ret = flash_img_decompress_write(&ctx, &compressed[i], len,
+						 i + len == sizeof(compressed));
+		zassert_equal(ret, 0, "Flash img decompress write (%d)\n", ret);
+	}
+
+	zassert_equal(flash_img_bytes_written(&ctx), sys_le32_to_cpu(hdr->size),
+		      "Decompressed size\n");
+
+	ret = flash_area_open(SLOT1_PARTITION_ID, &fa);
+	zassert_true(ret == 0, "Flash area open\n");
+	for (i = 0U; i < sys_le32_to_cpu(hdr->size); i++) {
+		zassert(flash_area_read(fa, i, &temp, 1) == 0, "pass", "fail");
+		zassert_equal(temp, (i % 128) < 96 ? text[i % 11] : (uint8_t)i,
+			      "Decompressed image differs at %zu\n", i);
+	}
+	flash_area_close(fa);
+
+#if defined(CONFIG_IMG_INCREMENTAL_HASH)
+	struct flash_img_check fic = { hdr->sha256, sys_le32_to_cpu(hdr->size) };
+
+	ret = flash_img_hash_check(&ctx, &fic);
+	zassert_equal(ret, 0, "Flash img hash check (%d)\n", ret);
+#endif
+
+	/* Cut short */
+	ret = flash_img_init_id(&ctx, SLOT1_PARTITION_ID);
+	zassert_true(ret == 0, "Flash img init\n");
+	ret = flash_img_decompress_write(&ctx, compressed, sizeof(compressed) - 1, true);
+	zassert_equal(ret, -EILSEQ, "Truncated image decompressed (%d)\n", ret);
+
+	/* Not compressed */
+	memcpy(bad, compressed, sizeof(bad));
+	bad[0] ^= 0xff;
+	zassert_is_null(flash_img_compressed_header(bad, sizeof(bad)), "Bad magic\n");
+	ret = flash_img_init_id(&ctx, SLOT1_PARTITION_ID);
+	zassert_true(ret == 0, "Flash img init\n");
+	ret = flash_img_decompress_write(&ctx, bad, sizeof(bad), false);
+	zassert_equal(ret, -EILSEQ, "Bad magic accepted (%d)\n", ret);
+
+	flash_area_close(ctx.flash_area);
+#endif
+}
+
 ZTEST_SUITE(img_util, NULL, NULL, NULL, NULL, NULL);
@@ -222,3 +222,88 @@ ZTEST(ext2tests, test_write_big_file_4K)
 	writing_test(&config);
 }
 #endif
+
+#define MULTI_BLOCK_IO_SIZE (20 * 1024)
+
+static uint8_t multi_block_data[MULTI_BLOCK_IO_SIZE];
+static uint8_t multi_block_read_back[MULTI_BLOCK_IO_SIZE];
+
+static void check_read(struct fs_file_t *file, uint32_t offset, uint32_t len)
+{
+	int64_t ret;
+
+	ret = fs_seek(file, offset, FS_SEEK_SET);
+	zassert_equal(ret, 0, "File seek failed (ret=%d)", ret);
+
+	memset(multi_block_read_back, 0xaa, len);
+	ret = fs_read(file, multi_block_read_back, len);
+	zassert_equal(ret, len, "Different number of bytes read %ld (expected %ld)", ret, len);
+	zassert_mem_equal(multi_block_read_back, &multi_block_data[offset], len,
+			  "Wrong data read at %d (%d bytes)", offset, len);
+}
+
+ZTEST(ext2tests, test_multi_block_io)
+{
+	int64_t ret = 0;
+	struct fs_file_t file;
+	struct fs_statvfs sbuf;
+	struct fs_mount_t *mp = &testfs_mnt;
+	static const char *file_path = "/sml/file";
+
+	ret = fs_mkfs(FS_EXT2, (uintptr_t)mp->storage_dev, NULL, 0);
+	zassert_equal(ret, 0, "Failed to mkfs");
+
+	mp->flags = FS_MOUNT_FLAG_NO_FORMAT;
+	ret = fs_mount(mp);
+	zassert_equal(ret, 0, "Mount failed (ret=%d)", ret);
+
+	ret = fs_statvfs(mp->mnt_point, &sbuf);
+	zassert_equal(ret, 0, "Expected success (ret=%d)", ret);
+
+	uint32_t bsize = sbuf.f_bsize;
+
+	/* The file must go past the direct blocks */
+	zassert_true(MULTI_BLOCK_IO_SIZE >= 14 * bsize + 7, "Block size too big (%d)", bsize);
+
+	for (int i = 0; i < MULTI_BLOCK_IO_SIZE; i++) {
+		multi_block_data[i] = (uint8_t)(i * 31 + i / bsize);
+	}
+
+	fs_file_t_init(&file);
+	ret = fs_open(&file, file_path, FS_O_RDWR | FS_O_CREATE);
+	zassert_equal(ret, 0, "File open failed (ret=%d)", ret);
+
+	/* Leave a hole of two blocks, then write past the direct blocks in one call starting
+	 * in the middle of a block.
+	 */
+	memset(multi_block_data, 0, 2 * bsize);
+	ret = fs_seek(&file, 2 * bsize + 100, FS_SEEK_SET);
+	zassert_equal(ret, 0, "File seek failed (ret=%d)", ret);
+
+	ret = fs_write(&file, &multi_block_data[2 * bsize + 100],
+		       MULTI_BLOCK_IO_SIZE - 2 * bsize - 100);
+	zassert_equal(ret, MULTI_BLOCK_IO_SIZE - 2 * bsize - 100,
+		      "Different number of bytes written %ld", ret);
+
+	/* Overwrite blocks that are already allocated */
+	for (int i = 3 * bsize; i < 9 * bsize; i++) {
+		multi_block_data[i] ^= 0xff;
+	}
+	ret = fs_seek(&file, 3 * bsize, FS_SEEK_SET);
+	zassert_equal(ret, 0, "File seek failed (ret=%d)", ret);
+
+	ret = fs_write(&file, &multi_block_data[3 * bsize], 6 * bsize);
+	zassert_equal(ret, 6 * bsize, "Different number of bytes written %ld", ret);
+
+	check_read(&file, 0, MULTI_BLOCK_IO_SIZE);
+	check_read(&file, 1, MULTI_BLOCK_IO_SIZE - 1);
+	check_read(&file, bsize, 13 * bsize);
+	check_read(&file, bsize - 1, 2);
+	check_read(&file, 11 * bsize + 7, 3 * bsize);
+
+	ret = fs_close(&file);
+	zassert_equal(ret, 0, "File close failed (ret=%d)", ret);
+
+	ret = fs_unmount(mp);
+	zassert_equal(ret, 0, "Unmount failed (ret=%d)", ret);
+}
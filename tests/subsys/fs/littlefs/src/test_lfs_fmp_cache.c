@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Flash read-ahead cache and program buffer:
+ * * data programmed but not flushed yet is read back
+ * * a read-ahead overlapping buffered programs does not cache stale data
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include "testfs_tests.h"
+#include "testfs_lfs.h"
+#include <lfs.h>
+
+#include <zephyr/fs/littlefs.h>
+
+#define IO_MAX 64
+
+ZTEST(littlefs, test_lfs_fmp_cache)
+{
+	struct fs_mount_t *mp = &testfs_small_mnt;
+	struct fs_littlefs *fs = mp->fs_data;
+	const struct lfs_config *cfg = &fs->cfg;
+	uint8_t pattern[IO_MAX];
+	uint8_t buf[IO_MAX];
+	lfs_block_t block;
+	lfs_size_t io;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_FS_LITTLEFS_FMP_CACHE);
+
+	zassert_equal(testfs_lfs_wipe_partition(mp), TC_PASS,
+		      "failed to wipe partition");
+	zassert_ok(fs_mount(mp), "mount failed");
+
+	io = MAX(cfg->read_size, cfg->prog_size);
+	zassume_true(io <= IO_MAX, "io size too large");
+	zassume_true((io % cfg->read_size == 0) && (io % cfg->prog_size == 0),
+		     "io sizes not multiple of each other");
+
+#ifdef CONFIG_FS_LITTLEFS_FMP_CACHE
+	zassume_true(fs->fmp_read_cache_size > 3 * io, "read cache too small");
+	zassume_true(fs->fmp_prog_buffer_size > io, "program buffer too small");
+#endif
+
+	for (int i = 0; i < io; i++) {
+		pattern[i] = i + 1;
+	}
+
+	/* The last block is not used by a freshly formatted file system */
+	block = cfg->block_count - 1;
+	zassert_ok(cfg->erase(cfg, block), "erase failed");
+
+	/* Left in the program buffer */
+	zassert_ok(cfg->prog(cfg, block, 2 * io, pattern, io), "prog failed");
+
+	/* Sequential reads, the second one reading ahead over the program */
+	zassert_ok(cfg->read(cfg, block, 0, buf, io), "read failed");
+	zassert_ok(cfg->read(cfg, block, io, buf, io), "read failed");
+
+	memset(buf, 0, sizeof(buf));
+	zassert_ok(cfg->read(cfg, block, 2 * io, buf, io), "read failed");
+	zassert_mem_equal(buf, pattern, io, "programmed data not read back");
+
+	/* Read back from the program buffer before it is flushed */
+	zassert_ok(cfg->prog(cfg, block, 3 * io, pattern, io), "prog failed");
+
+	memset(buf, 0, sizeof(buf));
+	zassert_ok(cfg->read(cfg, block, 3 * io, buf, io), "read failed");
+	zassert_mem_equal(buf, pattern, io, "buffered data not read back");
+
+	zassert_ok(cfg->sync(cfg), "sync failed");
+
+	memset(buf, 0, sizeof(buf));
+	zassert_ok(cfg->read(cfg, block, 2 * io, buf, io), "read failed");
+	zassert_mem_equal(buf, pattern, io, "flushed data not read back");
+
+	zassert_ok(fs_unmount(mp), "unmount failed");
+	zassert_equal(testfs_lfs_wipe_partition(mp), TC_PASS,
+		      "failed to wipe partition");
+}
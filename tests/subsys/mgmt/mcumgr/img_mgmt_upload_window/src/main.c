@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Uploads an image with the image management client to the image management
+ * group of the same device, over the UDP transport on the loopback interface.
+ * Every SMP packet sent is held back by a delay line first, to give the link
+ * a round trip time; with CONFIG_TEST_JITTER_MS, packets overtake each other.
+ * With CONFIG_TEST_LOSS_MS, all packets are dropped for a while, so that the
+ * requests in flight time out and are sent again.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/mgmt/mcumgr/mgmt/mgmt.h>
+#include <zephyr/mgmt/mcumgr/smp/smp.h>
+#include <zephyr/mgmt/mcumgr/smp/smp_client.h>
+#include <zephyr/mgmt/mcumgr/transport/smp.h>
+#include <zephyr/mgmt/mcumgr/grp/img_mgmt/img_mgmt.h>
+#include <zephyr/mgmt/mcumgr/grp/img_mgmt/img_mgmt_client.h>
+#include <bootutil/image.h>
+#include <string.h>
+
+#include <mgmt/mcumgr/transport/smp_internal.h>
+
+#define IMAGE_SIZE         CONFIG_TEST_IMAGE_SIZE
+#define SLOT1_PARTITION_ID FIXED_PARTITION_ID(slot1_partition)
+/* Every packet sent holds an MCUmgr buffer */
+#define DELAY_LINE_LEN     CONFIG_MCUMGR_TRANSPORT_NETBUF_COUNT
+
+struct delayed_packet {
+	struct net_buf *nb;
+	int64_t due;
+};
+
+static struct delayed_packet delay_line[DELAY_LINE_LEN];
+static struct k_work_delayable delay_line_work;
+static int (*udp_output)(struct net_buf *nb);
+static uint32_t packets_sent;
+static uint32_t packets_late;
+static uint32_t packets_lost;
+static int64_t loss_start;
+
+static struct smp_client_object smp_client;
+static struct img_mgmt_client img_client;
+static uint8_t image[IMAGE_SIZE];
+static uint8_t read_back[256];
+
+static void delay_line_schedule(int64_t now)
+{
+	int64_t next = INT64_MAX;
+
+	for (int i = 0; i < DELAY_LINE_LEN; i++) {
+		if (delay_line[i].nb != NULL) {
+			next = MIN(next, delay_line[i].due);
+		}
+	}
+
+	if (next != INT64_MAX) {
+		k_work_reschedule_for_queue(smp_get_wq(), &delay_line_work,
+					    K_MSEC(MAX(next - now, 0)));
+	}
+}
+
+/* Sends the packets due, in the order they become due */
+static void delay_line_handler(struct k_work *work)
+{
+	int64_t now = k_uptime_get();
+	int due;
+
+	ARG_UNUSED(work);
+
+	do {
+		due = -1;
+
+		for (int i = 0; i < DELAY_LINE_LEN; i++) {
+			if (delay_line[i].nb == NULL) {
+				continue;
+			}
+
+			if (delay_line[i].due <= now &&
+			    (due < 0 || delay_line[i].due < delay_line[due].due)) {
+				due = i;
+			}
+		}
+
+		if (due >= 0) {
+			(void)udp_output(delay_line[due].nb);
+			delay_line[due].nb = NULL;
+		}
+	} while (due >= 0);
+
+	delay_line_schedule(now);
+}
+
+/* Takes the place of the UDP transport output, for requests and responses */
+static int delayed_output(struct net_buf *nb)
+{
+	struct sockaddr_in *addr = net_buf_user_data(nb);
+	struct smp_hdr *hdr = (struct smp_hdr *)nb->data;
+	int64_t delay = CONFIG_TEST_LATENCY_MS;
+
+	if (hdr->nh_op == MGMT_OP_READ || hdr->nh_op == MGMT_OP_WRITE) {
+		/* The client leaves the destination to the transport */
+		memset(addr, 0, sizeof(*addr));
+		addr->sin_family = AF_INET;
+		addr->sin_port = htons(CONFIG_MCUMGR_TRANSPORT_UDP_PORT);
+		addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	}
+
+	if (k_uptime_get() >= loss_start &&
+	    k_uptime_get() < loss_start + CONFIG_TEST_LOSS_MS) {
+		packets_lost++;
+		smp_packet_free(nb);
+		return MGMT_ERR_EOK;
+	}
+
+	if ((packets_sent++ % 3) == 0 && CONFIG_TEST_JITTER_MS > 0) {
+		delay += CONFIG_TEST_JITTER_MS;
+		packets_late++;
+	}
+
+	for (int i = 0; i < DELAY_LINE_LEN; i++) {
+		if (delay_line[i].nb == NULL) {
+			delay_line[i].nb = nb;
+			delay_line[i].due = k_uptime_get() + delay;
+			delay_line_schedule(k_uptime_get());
+			return MGMT_ERR_EOK;
+		}
+	}
+
+	smp_packet_free(nb);
+
+	return MGMT_ERR_ENOMEM;
+}
+
+static void *setup(void)
+{
+	struct smp_transport *smpt;
+	struct image_header *hdr = (struct image_header *)image;
+	int rc;
+
+	/* Let the transport open its socket once the loopback interface is up */
+	k_sleep(K_MSEC(100));
+
+	smpt = smp_client_transport_get(SMP_UDP_IPV4_TRANSPORT);
+	zassert_not_null(smpt, "UDP transport not registered");
+
+	k_work_init_delayable(&delay_line_work, delay_line_handler);
+	udp_output = smpt->functions.output;
+	smpt->functions.output = delayed_output;
+
+	rc = smp_client_object_init(&smp_client, SMP_UDP_IPV4_TRANSPORT);
+	zassert_equal(rc, MGMT_ERR_EOK, "SMP client init failed (%d)", rc);
+	img_mgmt_client_init(&img_client, &smp_client, 0, NULL);
+
+	for (int i = 0; i < IMAGE_SIZE; i++) {
+		image[i] = (uint8_t)(i * 31);
+	}
+
+	memset(hdr, 0, sizeof(*hdr));
+	hdr->ih_magic = IMAGE_MAGIC;
+	hdr->ih_hdr_size = sizeof(*hdr);
+	hdr->ih_img_size = IMAGE_SIZE - sizeof(*hdr);
+
+	return NULL;
+}
+
+static void check_slot(void)
+{
+	const struct flash_area *fa;
+	int rc;
+
+	rc = flash_area_open(SLOT1_PARTITION_ID, &fa);
+	zassert_equal(rc, 0, "Opening slot 1 failed (%d)", rc);
+
+	for (size_t off = 0; off < IMAGE_SIZE; off += sizeof(read_back)) {
+		size_t len = MIN(sizeof(read_back), IMAGE_SIZE - off);
+
+		rc = flash_area_read(fa, off, read_back, len);
+		zassert_equal(rc, 0, "Reading slot 1 failed (%d)", rc);
+		zassert_mem_equal(read_back, &image[off], len, "Image differs at 0x%zx", off);
+	}
+
+	flash_area_close(fa);
+}
+
+ZTEST(img_mgmt_upload_window, test_upload)
+{
+	struct mcumgr_image_upload response;
+	size_t offset = 0;
+	int64_t start;
+	int64_t elapsed;
+	int rc;
+
+	rc = img_mgmt_client_upload_init(&img_client, IMAGE_SIZE, 0, NULL);
+	zassert_equal(rc, MGMT_ERR_EOK, "Upload init failed (%d)", rc);
+
+	packets_sent = 0;
+	packets_late = 0;
+	packets_lost = 0;
+	start = k_uptime_get();
+	loss_start = start + CONFIG_TEST_LOSS_START_MS;
+
+	while (offset < IMAGE_SIZE) {
+		rc = img_mgmt_client_upload(&img_client, &image[offset], IMAGE_SIZE - offset,
+					    &response);
+		zassert_equal(rc, MGMT_ERR_EOK, "Upload failed at 0x%zx (%d)", offset, rc);
+		zassert_true(response.image_upload_offset > offset, "Upload stalled at 0x%zx",
+			     offset);
+		offset = response.image_upload_offset;
+	}
+
+	elapsed = k_uptime_delta(&start);
+
+	TC_PRINT("%u bytes in %u ms, %u packets, %u late, %u lost, %d requests in flight\n",
+		 IMAGE_SIZE, (uint32_t)elapsed, packets_sent, packets_late, packets_lost,
+		 CONFIG_MCUMGR_GRP_IMG_CLIENT_UPLOAD_WINDOW);
+
+	zassert_equal(offset, IMAGE_SIZE, "Upload ended at 0x%zx", offset);
+	check_slot();
+
+	if (CONFIG_TEST_LOSS_MS > 0) {
+		zassert_true(packets_lost > 0, "Upload done before packets were dropped");
+	} else if (CONFIG_MCUMGR_GRP_IMG_CLIENT_UPLOAD_WINDOW > 1) {
+		/* Stop-and-wait takes a round trip per request */
+		zassert_true(elapsed < (packets_sent / 2) * 2 * CONFIG_TEST_LATENCY_MS,
+			     "Upload took %u ms, as long as without a window",
+			     (uint32_t)elapsed);
+	}
+}
+
+ZTEST_SUITE(img_mgmt_upload_window, NULL, setup, NULL, NULL, NULL);
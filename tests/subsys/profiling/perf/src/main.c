@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/shell/shell_dummy.h>
+#include <zephyr/ztest.h>
+
+#define WORKLOAD_STACK_SIZE 1024
+#define WORKLOAD_PRIORITY   K_LOWEST_APPLICATION_THREAD_PRIO
+
+static K_THREAD_STACK_DEFINE(workload_stack, WORKLOAD_STACK_SIZE);
+static struct k_thread workload_thread;
+
+/* Spin in a known function so that it shows up in the samples */
+static __noinline void perf_test_hot_loop(void)
+{
+	while (true) {
+		k_busy_wait(100);
+	}
+}
+
+static void workload(void *p1, void *p2, void *p3)
+{
+	perf_test_hot_loop();
+}
+
+static const char *perf_exec(const char *cmd, int expected)
+{
+	const struct shell *sh = shell_backend_dummy_get_ptr();
+	const char *out;
+	size_t size;
+	int ret;
+
+	shell_backend_dummy_clear_output(sh);
+
+	ret = shell_execute_cmd(sh, cmd);
+	zassert_equal(ret, expected, "%s: got %d, expected %d", cmd, ret, expected);
+
+	out = shell_backend_dummy_get_output(sh, &size);
+	zassert_not_null(out);
+
+	return out;
+}
+
+ZTEST(perf, test_collapsed_stacks)
+{
+	const char *out;
+
+	perf_exec("perf clear", 0);
+	perf_exec("perf record 0 1000", 0);
+	perf_exec("perf record 0 1000", -EINPROGRESS);
+
+	k_msleep(200);
+
+	perf_exec("perf stop", 0);
+	/* The stop handler was queued to the system work queue */
+	zassert_true(k_work_queue_drain(&k_sys_work_q, false) >= 0);
+	perf_exec("perf stop", -EALREADY);
+
+	out = perf_exec("perf info", 0);
+	zassert_not_null(strstr(out, "Perf stacks:"), "%s", out);
+	zassert_not_null(strstr(out, "unwinding failed:"), "%s", out);
+
+	out = perf_exec("perf collapsed", 0);
+	zassert_not_null(strstr(out, "perf_workload;"),
+			 "no sample attributed to the workload thread:\n%s", out);
+#ifdef CONFIG_SYMTAB
+	zassert_not_null(strstr(out, ";perf_test_hot_loop"),
+			 "hot function not resolved:\n%s", out);
+#endif
+
+	perf_exec("perf clear", 0);
+	out = perf_exec("perf collapsed", 0);
+	zassert_is_null(strstr(out, "perf_workload;"), "%s", out);
+}
+
+static void *perf_setup(void)
+{
+	k_thread_create(&workload_thread, workload_stack,
+			K_THREAD_STACK_SIZEOF(workload_stack), workload,
+			NULL, NULL, NULL, WORKLOAD_PRIORITY, 0, K_NO_WAIT);
+	k_thread_name_set(&workload_thread, "perf_workload");
+
+	return NULL;
+}
+
+ZTEST_SUITE(perf, NULL, perf_setup, NULL, NULL, NULL);
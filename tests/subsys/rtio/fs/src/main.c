@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <ff.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/fs_rtio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/ztest.h>
+
+#define MNTP       "/RAM:"
+#define TEST_FILE  MNTP "/rtio.bin"
+#define BLK_SIZE   16
+#define READ_MAX   (4 * BLK_SIZE)
+
+static FATFS fat_fs;
+static struct fs_mount_t fatfs_mnt = {
+	.type = FS_FATFS,
+	.mnt_point = MNTP,
+	.fs_data = &fat_fs,
+};
+
+static struct fs_file_t file;
+
+FS_RTIO_IODEV_DEFINE(fs_iodev, &file, READ_MAX);
+RTIO_DEFINE_WITH_MEMPOOL(r_fs, 8, 8, 8, BLK_SIZE, 4);
+
+static const uint8_t data_a[] = "The quick brown ";
+static const uint8_t data_b[] = "fox jumps over the lazy dog";
+
+static void rewind_cb(struct rtio *r, const struct rtio_sqe *sqe, void *arg0)
+{
+	ARG_UNUSED(r);
+	ARG_UNUSED(sqe);
+
+	zassert_ok(fs_seek(arg0, 0, FS_SEEK_SET));
+}
+
+static int cqe_result(struct rtio *r, uint8_t **buf, uint32_t *buf_len)
+{
+	struct rtio_cqe *cqe = rtio_cqe_consume_block(r);
+	int result = cqe->result;
+
+	if (buf != NULL) {
+		zassert_ok(rtio_cqe_get_mempool_buffer(r, cqe, buf, buf_len));
+	}
+
+	rtio_cqe_release(r, cqe);
+
+	return result;
+}
+
+static void before(void *unused)
+{
+	ARG_UNUSED(unused);
+
+	rtio_sqe_drop_all(&r_fs);
+
+	fs_file_t_init(&file);
+	zassert_ok(fs_open(&file, TEST_FILE, FS_O_CREATE | FS_O_RDWR | FS_O_TRUNC));
+}
+
+static void after(void *unused)
+{
+	ARG_UNUSED(unused);
+
+	zassert_ok(fs_close(&file));
+}
+
+static void *setup(void)
+{
+	zassert_ok(fs_mount(&fatfs_mnt));
+
+	return NULL;
+}
+
+/**
+ * @brief Test a chain of writes, a rewind and a read from the memory pool
+ */
+ZTEST(rtio_fs, test_chain)
+{
+	struct rtio_sqe *sqe;
+	uint32_t buf_len;
+	uint8_t *buf;
+
+	sqe = rtio_sqe_acquire(&r_fs);
+	rtio_sqe_prep_write(sqe, &fs_iodev, RTIO_PRIO_NORM, data_a,
+			    sizeof(data_a) - 1, NULL);
+	sqe->flags |= RTIO_SQE_CHAINED;
+
+	sqe = rtio_sqe_acquire(&r_fs);
+	rtio_sqe_prep_write(sqe, &fs_iodev, RTIO_PRIO_NORM, data_b,
+			    sizeof(data_b) - 1, NULL);
+	sqe->flags |= RTIO_SQE_CHAINED;
+
+	sqe = rtio_sqe_acquire(&r_fs);
+	rtio_sqe_prep_callback_no_cqe(sqe, rewind_cb, &file, NULL);
+	sqe->flags |= RTIO_SQE_CHAINED;
+
+	sqe = rtio_sqe_acquire(&r_fs);
+	rtio_sqe_prep_read_with_pool(sqe, &fs_iodev, RTIO_PRIO_NORM, NULL);
+
+	zassert_ok(rtio_submit(&r_fs, 3));
+
+	zassert_equal(cqe_result(&r_fs, NULL, NULL), sizeof(data_a) - 1);
+	zassert_equal(cqe_result(&r_fs, NULL, NULL), sizeof(data_b) - 1);
+
+	/* The pool buffer is up to READ_MAX, the read stops at the end of file */
+	zassert_equal(cqe_result(&r_fs, &buf, &buf_len),
+		      sizeof(data_a) + sizeof(data_b) - 2);
+	zassert_true(buf_len <= READ_MAX);
+	zassert_mem_equal(buf, data_a, sizeof(data_a) - 1);
+	zassert_mem_equal(buf + sizeof(data_a) - 1, data_b, sizeof(data_b) - 1);
+	rtio_release_buffer(&r_fs, buf, buf_len);
+}
+
+/**
+ * @brief Test that a transaction completes with the total transferred
+ */
+ZTEST(rtio_fs, test_transaction)
+{
+	struct rtio_sqe *sqe;
+	struct fs_dirent entry;
+
+	sqe = rtio_sqe_acquire(&r_fs);
+	rtio_sqe_prep_write(sqe, &fs_iodev, RTIO_PRIO_NORM, data_a,
+			    sizeof(data_a) - 1, NULL);
+	sqe->flags |= RTIO_SQE_TRANSACTION;
+
+	sqe = rtio_sqe_acquire(&r_fs);
+	rtio_sqe_prep_write(sqe, &fs_iodev, RTIO_PRIO_NORM, data_b,
+			    sizeof(data_b) - 1, NULL);
+
+	zassert_ok(rtio_submit(&r_fs, 2));
+
+	for (int i = 0; i < 2; i++) {
+		zassert_equal(cqe_result(&r_fs, NULL, NULL),
+			      sizeof(data_a) + sizeof(data_b) - 2);
+	}
+
+	zassert_ok(fs_sync(&file));
+	zassert_ok(fs_stat(TEST_FILE, &entry));
+	zassert_equal(entry.size, sizeof(data_a) + sizeof(data_b) - 2);
+}
+
+/**
+ * @brief Test that unsupported operations fail
+ */
+ZTEST(rtio_fs, test_unsupported)
+{
+	static uint8_t tx[4], rx[4];
+	struct rtio_sqe *sqe;
+
+	sqe = rtio_sqe_acquire(&r_fs);
+	rtio_sqe_prep_transceive(sqe, &fs_iodev, RTIO_PRIO_NORM, tx, rx,
+				 sizeof(tx), NULL);
+
+	zassert_ok(rtio_submit(&r_fs, 1));
+	zassert_equal(cqe_result(&r_fs, NULL, NULL), -ENOTSUP);
+}
+
+ZTEST_SUITE(rtio_fs, NULL, setup, before, after, NULL);
@@ -26,6 +26,9 @@ struct rtio_iodev_test_data {
 	/* Count of submit calls */
 	atomic_t submit_count;
 
+	/* Count of batch submit calls */
+	atomic_t batch_count;
+
 	/* Lock around kicking off next timer */
 	struct k_spinlock lock;
 };
@@ -116,10 +119,32 @@ static void rtio_iodev_test_submit(struct rtio_iodev_sqe *iodev_sqe)
 	rtio_iodev_test_next(data, false);
 }
 
+static void rtio_iodev_test_submit_batch(struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct rtio_iodev *iodev = (struct rtio_iodev *)iodev_sqe->sqe.iodev;
+	struct rtio_iodev_test_data *data = iodev->data;
+	struct rtio_iodev_sqe *next;
+
+	atomic_inc(&data->batch_count);
+
+	do {
+		next = rtio_iodev_sqe_batch_next(iodev_sqe);
+		mpsc_push(&data->io_q, &iodev_sqe->q);
+		iodev_sqe = next;
+	} while (iodev_sqe != NULL);
+
+	rtio_iodev_test_next(data, false);
+}
+
 const struct rtio_iodev_api rtio_iodev_test_api = {
 	.submit = rtio_iodev_test_submit,
 };
 
+const struct rtio_iodev_api rtio_iodev_test_batch_api = {
+	.submit = rtio_iodev_test_submit,
+	.submit_batch = rtio_iodev_test_submit_batch,
+};
+
 void rtio_iodev_test_init(struct rtio_iodev *test)
 {
 	struct rtio_iodev_test_data *data = test->data;
@@ -127,6 +152,8 @@ void rtio_iodev_test_init(struct rtio_iodev *test)
 	mpsc_init(&data->io_q);
 	data->txn_head = NULL;
 	data->txn_curr = NULL;
+	atomic_set(&data->submit_count, 0);
+	atomic_set(&data->batch_count, 0);
 	k_timer_init(&data->timer, rtio_iodev_timer_fn, NULL);
 }
 
@@ -134,6 +161,10 @@ void rtio_iodev_test_init(struct rtio_iodev *test)
 	static struct rtio_iodev_test_data _iodev_data_##name;                                     \
 	RTIO_IODEV_DEFINE(name, &rtio_iodev_test_api, &_iodev_data_##name)
 
+#define RTIO_IODEV_TEST_BATCH_DEFINE(name)                                                         \
+	static struct rtio_iodev_test_data _iodev_data_##name;                                     \
+	RTIO_IODEV_DEFINE(name, &rtio_iodev_test_batch_api, &_iodev_data_##name)
+
 
 
 #endif /* RTIO_IODEV_TEST_H_ */
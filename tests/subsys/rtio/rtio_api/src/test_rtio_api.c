@@ -780,6 +780,74 @@ ZTEST(rtio_api, test_rtio_callback_chaining)
 	test_rtio_callback_chaining_(&r_callback_chaining);
 }
 
+RTIO_DEFINE(r_batch, SQE_POOL_SIZE, CQE_POOL_SIZE);
+RTIO_IODEV_TEST_BATCH_DEFINE(iodev_test_batch);
+RTIO_IODEV_TEST_DEFINE(iodev_test_batch_other);
+
+static void test_rtio_batch_consume_(struct rtio *r, int count)
+{
+	struct rtio_cqe *cqe;
+
+#ifdef CONFIG_RTIO_CONSUME_SEM
+	/* Woken up once for all of the completions */
+	zassert_ok(rtio_cqe_wait(r, count, K_FOREVER));
+	for (int i = 0; i < count; i++) {
+		cqe = rtio_cqe_consume(r);
+		zassert_not_null(cqe, "Expected a valid cqe");
+		zassert_ok(cqe->result, "Result should be ok");
+		rtio_cqe_release(r, cqe);
+	}
+#else
+	for (int i = 0; i < count; i++) {
+		cqe = rtio_cqe_consume_block(r);
+		zassert_ok(cqe->result, "Result should be ok");
+		rtio_cqe_release(r, cqe);
+	}
+#endif
+}
+
+/**
+ * @brief Test batched submissions
+ *
+ * Consecutive submissions to an iodev implementing submit_batch are given
+ * to it at once, submissions to another iodev split the batch.
+ */
+ZTEST(rtio_api, test_rtio_batch)
+{
+	struct rtio_iodev_test_data *data = iodev_test_batch.data;
+	struct rtio_sqe *sqe;
+
+	rtio_iodev_test_init(&iodev_test_batch);
+	rtio_iodev_test_init(&iodev_test_batch_other);
+
+	for (int i = 0; i < 4; i++) {
+		sqe = rtio_sqe_acquire(&r_batch);
+		zassert_not_null(sqe, "Expected a valid sqe");
+		rtio_sqe_prep_nop(sqe, &iodev_test_batch, NULL);
+	}
+
+	zassert_ok(rtio_submit(&r_batch, 0));
+	zassert_equal(atomic_get(&data->batch_count), 1);
+	zassert_equal(atomic_get(&data->submit_count), 0);
+	test_rtio_batch_consume_(&r_batch, 4);
+
+	sqe = rtio_sqe_acquire(&r_batch);
+	rtio_sqe_prep_nop(sqe, &iodev_test_batch, NULL);
+	sqe = rtio_sqe_acquire(&r_batch);
+	rtio_sqe_prep_nop(sqe, &iodev_test_batch_other, NULL);
+	sqe = rtio_sqe_acquire(&r_batch);
+	rtio_sqe_prep_nop(sqe, &iodev_test_batch, NULL);
+
+	zassert_ok(rtio_submit(&r_batch, 0));
+	zassert_equal(atomic_get(&data->batch_count), 3);
+	test_rtio_batch_consume_(&r_batch, 3);
+
+#ifdef CONFIG_RTIO_CONSUME_SEM
+	zassert_equal(rtio_cqe_wait(&r_batch, 1, K_MSEC(20)), -EAGAIN);
+	zassert_equal(rtio_cqe_wait(&r_batch, CQE_POOL_SIZE + 1, K_NO_WAIT), -EINVAL);
+#endif
+}
+
 static void *rtio_api_setup(void)
 {
 #ifdef CONFIG_USERSPACE
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sensing/sensing.h>
+#include <zephyr/sensing/sensing_datatypes.h>
+#include <zephyr/sensing/sensing_sensor_types.h>
+
+#define INTERVAL_US 10000
+#define LATENCY_US  200000
+
+static struct k_sem data_sem;
+static atomic_t events;
+static atomic_t readings;
+
+static void on_data_event(sensing_sensor_handle_t handle, const void *buf, void *context)
+{
+	const struct sensing_sensor_value_3d_q31 *sample = buf;
+
+	ARG_UNUSED(handle);
+	ARG_UNUSED(context);
+
+	atomic_inc(&events);
+	atomic_add(&readings, sample->header.reading_count);
+	k_sem_give(&data_sem);
+}
+
+static struct sensing_callback_list cb_list = {
+	.on_data_event = on_data_event,
+};
+
+static int configure(sensing_sensor_handle_t handle, uint32_t interval, uint64_t latency)
+{
+	struct sensing_sensor_config config[2] = {
+		{ .attri = SENSING_SENSOR_ATTRIBUTE_INTERVAL, .interval = interval },
+		{ .attri = SENSING_SENSOR_ATTRIBUTE_LATENCY, .latency = latency },
+	};
+
+	return sensing_set_config(handle, config, ARRAY_SIZE(config));
+}
+
+/**
+ * @brief Test that a batch is delivered when its source stops
+ *
+ * The readings already batched must not wait for a next sample, which never
+ * comes, but be delivered once the latency expires.
+ */
+ZTEST(sensing_batching, test_source_stops_mid_batch)
+{
+	const struct sensing_sensor_info *info;
+	sensing_sensor_handle_t handle = NULL;
+	int num;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_SENSING_BATCHING);
+
+	zassert_ok(sensing_get_sensors(&num, &info));
+	for (int i = 0; i < num; i++) {
+		if (info[i].type == SENSING_SENSOR_TYPE_MOTION_ACCELEROMETER_3D) {
+			zassert_ok(sensing_open_sensor(&info[i], &cb_list, &handle));
+			break;
+		}
+	}
+	zassert_not_null(handle, "no accelerometer");
+
+	k_sem_init(&data_sem, 0, K_SEM_MAX_LIMIT);
+	atomic_clear(&events);
+	atomic_clear(&readings);
+
+	/* A few readings, far from the latency and the size of a batch */
+	zassert_ok(configure(handle, INTERVAL_US, LATENCY_US));
+	k_usleep(5 * INTERVAL_US);
+	zassert_equal(atomic_get(&events), 0, "batch delivered before its latency");
+
+	/* The source stops, keeping the latency of the client */
+	zassert_ok(configure(handle, 0, LATENCY_US));
+
+	zassert_ok(k_sem_take(&data_sem, K_USEC(2 * LATENCY_US)),
+		   "batch not delivered after the source stopped");
+	zassert_equal(atomic_get(&events), 1);
+	zassert_true(atomic_get(&readings) > 0);
+
+	zassert_ok(sensing_close_sensor(&handle));
+}
+
+ZTEST_SUITE(sensing_batching, NULL, NULL, NULL, NULL, NULL);
@@ -602,6 +602,112 @@ ZTEST(lib_stream_flash, test_stream_flash_progress_clear)
 #endif
 }
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+static uint8_t async_buf[BUF_LEN];
+static atomic_t async_cb_count;
+static int async_cb_result;
+
+static void async_callback(struct stream_flash_ctx *cb_ctx, int result, void *user_data)
+{
+	zassert_equal(cb_ctx, &ctx, "incorrect context");
+	zassert_equal(user_data, async_buf, "incorrect user data");
+
+	async_cb_result = result;
+	atomic_inc(&async_cb_count);
+}
+
+static void init_target_async(void)
+{
+	int rc;
+
+	init_target();
+
+	atomic_clear(&async_cb_count);
+	async_cb_result = 0;
+
+	rc = stream_flash_async_init(&ctx, async_buf, async_callback, async_buf);
+	zassert_equal(rc, 0, "expected success");
+}
+#endif
+
+ZTEST(lib_stream_flash, test_stream_flash_async_init)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_STREAM_FLASH_ASYNC);
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	int rc;
+
+	init_target();
+
+	rc = stream_flash_async_init(NULL, async_buf, NULL, NULL);
+	zassert_equal(rc, -EFAULT, "should fail as ctx is NULL");
+
+	rc = stream_flash_async_init(&ctx, NULL, NULL, NULL);
+	zassert_equal(rc, -EFAULT, "should fail as buffer is NULL");
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, 128, false);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_async_init(&ctx, async_buf, NULL, NULL);
+	zassert_equal(rc, -EBUSY, "should fail as data is buffered");
+#endif
+}
+
+ZTEST(lib_stream_flash, test_stream_flash_async_buffered_write)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_STREAM_FLASH_ASYNC);
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	int rc;
+	size_t len = (page_size * (MAX_NUM_PAGES - 1)) + 128;
+
+	init_target_async();
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, len, false);
+	zassert_equal(rc, 0, "expected success");
+
+	/* The buffered remainder is written and the work queue drained */
+	rc = stream_flash_buffered_write(&ctx, NULL, 0, true);
+	zassert_equal(rc, 0, "expected success");
+
+	zassert_equal(atomic_get(&async_cb_count), DIV_ROUND_UP(len, BUF_LEN),
+		      "expected a callback per buffer");
+	zassert_equal(async_cb_result, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&ctx), len, "expected all bytes written");
+
+	VERIFY_WRITTEN(0, len);
+#endif
+}
+
+ZTEST(lib_stream_flash, test_stream_flash_async_write_error)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_STREAM_FLASH_ASYNC);
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	int rc;
+	struct device fake_dev;
+	struct flash_driver_api fake_api;
+
+	init_target_async();
+
+	fake_dev = *ctx.fdev;
+	fake_api = *(struct flash_driver_api *)ctx.fdev->api;
+	fake_api.write = bad_write;
+	fake_dev.api = &fake_api;
+	ctx.fdev = &fake_dev;
+
+	/* The buffer is written in the background, its failure shows later */
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN, false);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN, true);
+	zassert_equal(rc, -EINVAL, "expected failure from the work queue");
+	zassert_equal(async_cb_result, -EINVAL, "expected failure in callback");
+	zassert_equal(stream_flash_bytes_written(&ctx), 0, "expected nothing written");
+
+	/* The error sticks until the context is initialized again */
+	rc = stream_flash_buffered_write(&ctx, NULL, 0, true);
+	zassert_equal(rc, -EINVAL, "expected failure to be latched");
+#endif
+}
+
 void lib_stream_flash_before(void *data)
 {
 	zassume_true(device_is_ready(fdev), "Device is not ready");